@@ -147,3 +147,8 @@
  */
 #define BOARD_RUMBA32         4203    // RUMBA32 STM32F446 based controller
 #define BOARD_STEVAL_3DP001V1 4206    // STEVAL-3DP001V1 3D PRINTER BOARD
+
+/**
+ * Host build (buildroot/bin/build_native)
+ */
+#define BOARD_NATIVE          9000    // Native x86/Linux build for benchmarks, RAMPS pins
@@ -80,21 +80,51 @@
  */
 #define BAUDRATE_2 250000
 
+/**
+ * Slots of the command buffer (BUFSIZE) reserved to the primary port.
+ * Commands from the secondary port are read only while more slots than this
+ * are free, so a chatty second host or panel can't starve the print stream.
+ * 0 to share the buffer equally.
+ */
+#define SERIAL_PORT_2_HEADROOM 1
+
 /**
  * The number of linear motions that can be in the plan at any give time.
  * THE BLOCK BUFFER SIZE NEEDS TO BE A POWER OF 2 (i.g. 8, 16, 32) because shifts
  * and ors are used to do the ring-buffering.
  * For Arduino DUE setting to 32.
+ * On 32 bit boards with enough RAM 64 or 128 can be used, only the blocks
+ * after the last optimally planned one are replanned for each new move.
  */
 #define BLOCK_BUFFER_SIZE 16
 
+/**
+ * Use fixed point (Q16.16 factors, Q0.32 inverse acceleration) integer math
+ * in the planner trapezoid generator instead of float divisions.
+ * Intended for AVR boards, where the float math limits the segment rate.
+ * M101 T runs it side by side with the float formulas and reports the errors.
+ */
+//#define PLANNER_FIXED_POINT
+
 /**
  * The ASCII buffer for receiving from the serial:
  * For Arduino DUE setting bufsize to 8.
+ * Each slot uses MAX_CMD_SIZE + 2 bytes of RAM, commands are parsed in place.
+ * On 32 bit boards 16 or 32 slots help to ride out host jitter. A power of 2, max 128.
  */
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+/**
+ * Buffer arena (32 bit only)
+ * The planner blocks and the command slots share BUFFER_ARENA_SIZE bytes of RAM,
+ * split at boot by the EEPROM: M225 B<blocks> C<slots>, M500 and restart.
+ * BLOCK_BUFFER_SIZE and BUFSIZE are the factory split and must fit.
+ * M225 reports the split and the bytes it takes.
+ */
+//#define BUFFER_ARENA
+#define BUFFER_ARENA_SIZE 16384
+
 /**
  * Transmission to Host Buffer Size
  * To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
@@ -102,9 +132,20 @@
  * For ADVANCED OK (M105) you need 32 bytes.
  * For debug-echo: 128 bytes for the optimal speed.
  * Other output doesn't need to be that speedy.
+ * With a buffer the bytes are sent by the UART interrupt and the firmware
+ * only waits when the buffer is full.
  * 0, 2, 4, 8, 16, 32, 64, 128, 256
  */
-#define TX_BUFFER_SIZE 0
+#define TX_BUFFER_SIZE 32
+
+/**
+ * Hold back the "ok" replies and send them in one burst before the next
+ * commands are read, or together with the temperature autoreport (M155).
+ * A reply is sent only when the TX buffer has room, so the host chatter
+ * never makes the firmware wait on the UART.
+ * Requires TX_BUFFER_SIZE on AVR and DUE. Not compatible with ADVANCED_OK.
+ */
+//#define HOST_OK_COALESCE
 
 /**
  * Host Receive Buffer Size
@@ -114,6 +155,33 @@
  */
 #define RX_BUFFER_SIZE 128
 
+/**
+ * Arduino DUE only: receive the host serial with the PDC (DMA) into the RX buffer.
+ * The UART interrupt runs once per RX_BUFFER_SIZE bytes instead of once per byte,
+ * so 500000 or 1000000 baud don't steal time from the Stepper ISR.
+ * Bytes are not checked on arrival, EMERGENCY_PARSER and SERIAL_XON_XOFF are not available,
+ * and the host must not send more than RX_BUFFER_SIZE bytes ahead (use ok flow control).
+ */
+//#define SERIAL_RX_DMA
+
+/**
+ * Read the host serial in blocks of up to SERIAL_BULK_READ_SIZE bytes and assemble
+ * the lines from there, instead of asking the port for every single character.
+ * Best with native USB (DUE and SAMD SerialUSB), where data arrives in 64 byte packets.
+ * Uses SERIAL_BULK_READ_SIZE bytes of RAM for each host port. Max 255.
+ */
+//#define SERIAL_BULK_READ
+#define SERIAL_BULK_READ_SIZE 64
+
+/**
+ * On a line number or checksum error only that line is requested again:
+ * the lines already received behind it are not flushed with the RX buffer,
+ * they are dropped quietly until the host is back at the resend point.
+ * Lines repeated from the last SERIAL_RESEND_WINDOW accepted ones are
+ * acknowledged and not executed twice. Power of 2, max 64.
+ */
+//#define SERIAL_RESEND_WINDOW 8
+
 /**
  * Enable to have the controller send XON/XOFF control characters to
  * the host to signal the RX buffer is becoming full.
@@ -152,6 +220,26 @@
  */
 #define KILL_METHOD 0
 
+/**
+ * Fast boot
+ *
+ * Accept commands as soon as the settings are loaded: the SD mount, the restart job
+ * check and the TMC connection test are done in the first idle cycles, one for cycle,
+ * and the boot screen is not shown. The times of the boot phases are reported after.
+ * With EEPROM_SD the SD is mounted in the setup, it holds the settings.
+ */
+//#define FAST_BOOT
+
+/**
+ * Boot timeline
+ *
+ * Take the time of each phase of the setup (HAL, SD mount, EEPROM and heaters, stepper,
+ * devices, LCD, BLTouch, TMC test, MMU2...), also without FAST_BOOT. The timeline is
+ * reported at the end of the boot and kept: M136 reports it again, the end of each phase
+ * in ms from the reset and its length, to find what holds back a restart.
+ */
+//#define BOOT_TIMELINE
+
 /**
  * Some particular clients re-start sending commands only after receiving a 'wait' when there is a bad serial-connection.
  * Milliseconds
@@ -163,15 +251,44 @@
 /**
  * Enable an emergency-command parser to intercept certain commands as they
  * enter the serial receive buffer, so they cannot be blocked.
- * Currently handles M108, M112, M410
+ * Currently handles M108, M112, M410, M524
  */
 //#define EMERGENCY_PARSER
 
+/**
+ * Realtime commands: single bytes above 0x7F, acted on as they arrive,
+ * not queued, so a host can change the speed without waiting for the buffer.
+ *  0x81 Feed hold (the queue is not read, the planned moves end,
+ *       with FEED_HOLD the motion stops at once along the path)    0x82 Resume
+ *  0x90 Feedrate 100%  0x91 +10%  0x92 -10%  0x93 +1%  0x94 -1%
+ *  0x99 Flow 100%      0x9A +10%  0x9B -10%  0x9C +1%  0x9D -1%
+ * The codes of the overrides are the Grbl ones. Bytes of an UTF-8 text are not commands,
+ * other 8-bit text (e.g. Windows-1252 comments) may be taken as commands.
+ * Requires EMERGENCY_PARSER
+ */
+//#define REALTIME_COMMANDS
+
 /**
  * Spend 28 bytes of SRAM to optimize the GCode parser
  */
 //#define FASTER_GCODE_PARSER
 
+/**
+ * Accept compact binary frames for G0 G1 G2 G3 from the host, alongside ASCII.
+ * Parameters are sent as floats with a CRC16, so the firmware skips text parsing.
+ * Reported in M115 as Cap:BINARY_GCODE:1, see src/commands/binary_gcode.h for the frame.
+ * Requires FASTER_GCODE_PARSER
+ */
+//#define BINARY_GCODE_PROTOCOL
+
+/**
+ * Parse G0 G1 G2 G3 when they are queued, from serial or SD, and store the values
+ * as floats, so the handlers read numbers directly and no text is parsed between
+ * planner blocks. Lines with other parameters are kept as text.
+ * Requires FASTER_GCODE_PARSER
+ */
+//#define GCODE_PARSE_ON_ENQUEUE
+
 /**
  * Spend more bytes of SRAM to optimize the GCode execute
  */
@@ -187,6 +304,29 @@
 #define HOST_KEEPALIVE_FEATURE
 // Number of seconds between "busy" messages. Set with M113.
 #define DEFAULT_KEEPALIVE_INTERVAL 2
+
+/**
+ * Answer M105 M27 M31 M119 M155 from the host at once while a long command,
+ * as G28 or G29, holds the queue, instead of after it. Each is acknowledged
+ * with its own "ok", so the host keeps its count.
+ */
+//#define HOST_BUSY_REPORTS
+
+/**
+ * M114 R reports the position of the motors at once, from the step counts of
+ * the stepper, without waiting for the end of the moves. M154 S<seconds> or
+ * P<milliseconds> reports it periodically, so a host can follow the head
+ * during the print (M154 P100 for 10 Hz).
+ */
+//#define REALTIME_POSITION_REPORT
+
+/**
+ * M155 B<milliseconds> sends a binary status frame at that interval: heaters,
+ * fans, position from the step counts, SD progress and buffers, with a CRC16.
+ * Much shorter than the text reports, for monitoring hosts at a high rate.
+ * Reported in M115 as Cap:BINARY_STATUS:1, see src/feature/binary_status/binary_status.h
+ */
+//#define BINARY_STATUS_REPORT
 /***********************************************************************/
 
 
@@ -65,6 +65,27 @@
 #define CNCROUTER_SLOWSTART_STEP 5000     // rpm of every step of the slow start accelleration
 #define CNCROUTER_SLOWSTART_INTERVAL 0.5  // seconds between change of speed 
 
+// Spindle tachometer on CNCROUTER_TACHO_PIN (Add CNCROUTER TACHO PIN in configuration pins)
+// It uses the fan tachometer, so TACHOMETRIC must be enabled; TACHOMETRIC_CAPTURE is used when the pin allows it
+//#define CNCROUTER_TACHO
+#define CNCROUTER_TACHO_PULSES 1          // tacho pulses for revolution of the spindle
+
+// Feed override on the spindle load, it needs CNCROUTER_TACHO and FAST_PWM_CNCROUTER.
+// When the measured rpm falls under the commanded rpm by more than CNCROUTER_FEED_DROP percent
+// the feedrate is lowered by CNCROUTER_FEED_STEP percent every CNCROUTER_FEED_INTERVAL, down to CNCROUTER_FEED_MIN.
+// When the rpm is back within half of the drop the feedrate goes up again to the one set by M220.
+// The new feedrate applies to the moves planned after the change.
+//#define CNCROUTER_FEED_OVERRIDE
+#define CNCROUTER_FEED_DROP 10            // percent of rpm drop where the feed starts to slow
+#define CNCROUTER_FEED_STEP 5             // percent of feedrate for every step
+#define CNCROUTER_FEED_MIN 20             // lowest percent of feedrate
+#define CNCROUTER_FEED_INTERVAL 100       // milliseconds between the steps
+
+// G2/G3 of the XY plane queued as one block for each octant of the circle, traced by the Stepper
+// with an integer circle instead of the chords of ARC_SUPPORT. 32 bit boards, Cartesian only.
+// The speed is the one of the block along the whole arc, within the centripetal acceleration of X and Y.
+//#define CNCROUTER_NATIVE_ARC
+
 // Router have inverted rotation support (not yet supported)
 //#define CNCROUTER_ANTICLOCKWISE
 
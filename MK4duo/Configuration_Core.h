@@ -142,12 +142,43 @@
  *                                                                                       *
  * Enable this feature if all enabled endstop pins are interrupt-capable.                *
  * This will remove the need to poll the interrupt pins, saving many CPU cycles.         *
+ * Always enabled on 32 bit boards: on DUE, STM32 and SAMD51 the endstops are polled as  *
+ * before if some pins have no interrupt line of their own (e.g. PA0 and PB0 on STM32).  *
  *                                                                                       *
  *****************************************************************************************/
 //#define ENDSTOP_INTERRUPTS_FEATURE
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ****************************** Endstop port sampling ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Group the endstop pins by GPIO port at startup and read each port with a single       *
+ * register read, so the cost of checking the endstops doesn't grow with their number    *
+ * (dual/triple endstops, probe, G38). Useful on 32 bit boards, where a single pin read  *
+ * goes through the pin description table. Not compatible with PCF8574 expansion pins.   *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_PORT_SAMPLING
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ **************************** Endstop trigger capture ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Timestamp the endstop edge on entry of the endstop interrupt with the cycle counter   *
+ * and back-interpolate the position of the steps made after the edge, so the latched   *
+ * trigger position doesn't depend on the interrupt latency. Better M48 repeatability    *
+ * and faster probing feedrates.                                                         *
+ * Only for Arduino DUE and STM32, with ENDSTOP_INTERRUPTS_FEATURE.                      *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_TRIGGER_CAPTURE
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ******************************* Z probe Options *****************************************
  *****************************************************************************************
@@ -244,6 +275,16 @@
 #define Z_PROBE_AFTER_PROBING  0  // Z position after probing is done
 #define Z_PROBE_LOW_POINT     -2  // Farthest distance below the trigger-point to go before stopping
 
+// Fast probing of the G29 points (G29 K0 for the normal probing)
+// A single probe at PROBE_FLY_SPEED for each point, the travel to the next point
+// raises only PROBE_FLY_CLEARANCE over the last trigger. Use ENDSTOP_TRIGGER_CAPTURE
+// for the trigger position at speed.
+//#define PROBE_FLY
+#define PROBE_FLY_SPEED      300  // (mm/min) Probing speed
+#define PROBE_FLY_CLEARANCE    2  // (mm) Raise over the last trigger for the travel
+// Inductive or capacitive probe with no contact: raise and travel in one diagonal move
+//#define PROBE_FLY_CONTACTLESS
+
 // For M851 give a range for adjusting the Probe Z Offset
 #define Z_PROBE_OFFSET_RANGE_MIN -50
 #define Z_PROBE_OFFSET_RANGE_MAX  50
@@ -474,12 +515,25 @@
 
 // When the nozzle is off the mesh, this value is used as the Z-Height correction value.
 //#define UBL_Z_RAISE_WHEN_OFF_MESH 2.5
+
+// G29 P1 O<plate> reuses a mesh probed with the same bed temperature, probe Z offset and plate ID
+// after a 3-point check, else it probes and caches the mesh. The cache is in the last mesh slots.
+//#define UBL_MESH_CACHE
+#define UBL_MESH_CACHE_SLOTS         2  // Mesh slots for the cache
+#define UBL_MESH_CACHE_TEMP_DIFF     5  // (C) Bed temperature difference of the same conditions
+#define UBL_MESH_CACHE_TOLERANCE  0.05  // (mm) Largest error of the 3-point check
+#define UBL_MESH_CACHE_MAX_USES     10  // Reuses before the mesh is probed again
 /** END UNIFIED BED LEVELING **/
 
 /** START MESH BED LEVELING or AUTO BED LEVELING LINEAR or AUTO BED LEVELING BILINEAR or UNIFIED BED LEVELING **/
 // Set the number of grid points per dimension
 #define GRID_MAX_POINTS_X 3
 #define GRID_MAX_POINTS_Y 3
+
+// Store the ABL or UBL mesh as int16 micrometres instead of float.
+// Half the RAM and EEPROM, so bigger meshes and more UBL slots fit.
+// Range +/-32.767mm with 0.001mm resolution. Save the mesh again after changing.
+//#define MESH_INT16_STORAGE
 /** END MESH BED LEVELING or AUTO BED LEVELING LINEAR or AUTO BED LEVELING BILINEAR or UNIFIED BED LEVELING **/
 
 /** START AUTO BED LEVELING LINEAR or AUTO BED LEVELING BILINEAR **/
@@ -491,6 +545,15 @@
 //#define ABL_BILINEAR_SUBDIVISION
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
+
+// Keep a table of bilinear coefficients for every grid cell (16 bytes each),
+// so a Z correction is a few multiply-adds without looking at the neighbors.
+//#define ABL_BILINEAR_COEFFICIENTS
+
+// G29 U probes only the grid points under the print area, the others continue the edge of it.
+// The area is given with L R F B, or scanned in the first layer of the SD file being printed.
+//#define ABL_PRINT_AREA
+#define ABL_PRINT_AREA_SCAN 262144  // (bytes) Longest first layer scanned in the SD file
 /** END AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR **/
 
 // Commands to execute at the end of G29 probing.
@@ -629,6 +692,12 @@
 
 // Re-Bump Speed Divisor (Divides the Homing Feedrate)
 #define HOMING_BUMP_DIVISOR {5, 5, 2}
+
+// Fast approach: an axis already homed travels at its max feedrate up to HOMING_FAST_APPROACH_MM
+// from the place where its endstop was hit, only the rest and the bump run at the homing feedrate.
+// The axis must not have lost steps since the last homing: the margin is all it can miss by.
+//#define HOMING_FAST_APPROACH
+#define HOMING_FAST_APPROACH_MM 10
 /*****************************************************************************************/
 
 
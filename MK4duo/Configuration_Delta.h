@@ -81,6 +81,19 @@
 // Subsegment per line 10 - xxx
 #define DELTA_SEGMENTS_PER_LINE 20
 
+// Transform the segments of a move DELTA_BATCH_SIZE at a time, in one pass over
+// arrays of X, Y and Z, instead of one segment per planner call.
+// Makes high DELTA_SEGMENTS_PER_SECOND_PRINT cheaper. Uses about 40 bytes of stack per segment.
+//#define DELTA_BATCH_TRANSFORM
+#define DELTA_BATCH_SIZE 8
+
+// Split moves by the error of the towers instead of by segments per second:
+// the lines are long near the center and short near the edge, so that moving
+// each tower linearly along a line stays within DELTA_SEGMENT_TOLERANCE mm.
+// DELTA_SEGMENTS_PER_SECOND_* and DELTA_SEGMENTS_PER_LINE are not used.
+//#define DELTA_ADAPTIVE_SEGMENTS
+#define DELTA_SEGMENT_TOLERANCE 0.01
+
 // NOTE: All following values for DELTA_* MUST be floating point,
 // so always have a decimal point in them.
 //
@@ -153,7 +166,8 @@
  ******************************** Delta Fast SQRT ****************************************
  *****************************************************************************************
  *                                                                                       *
- * Fast inverse sqrt from Quake III Arena                                                *
+ * Fast inverse sqrt from Quake III Arena, refined to a relative error of 5e-6, in the     *
+ * Transform. Always on with FAST_MATH.                                                  *
  * See: https://en.wikipedia.org/wiki/Fast_inverse_square_root                           *
  *                                                                                       *
  *****************************************************************************************/
@@ -196,12 +210,43 @@
  *                                                                                       *
  * Enable this feature if all enabled endstop pins are interrupt-capable.                *
  * This will remove the need to poll the interrupt pins, saving many CPU cycles.         *
+ * Always enabled on 32 bit boards: on DUE, STM32 and SAMD51 the endstops are polled as  *
+ * before if some pins have no interrupt line of their own (e.g. PA0 and PB0 on STM32).  *
  *                                                                                       *
  *****************************************************************************************/
 //#define ENDSTOP_INTERRUPTS_FEATURE
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ****************************** Endstop port sampling ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Group the endstop pins by GPIO port at startup and read each port with a single       *
+ * register read, so the cost of checking the endstops doesn't grow with their number    *
+ * (dual/triple endstops, probe, G38). Useful on 32 bit boards, where a single pin read  *
+ * goes through the pin description table. Not compatible with PCF8574 expansion pins.   *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_PORT_SAMPLING
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ **************************** Endstop trigger capture ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Timestamp the endstop edge on entry of the endstop interrupt with the cycle counter   *
+ * and back-interpolate the position of the steps made after the edge, so the latched   *
+ * trigger position doesn't depend on the interrupt latency. Better M48 repeatability    *
+ * and faster probing feedrates.                                                         *
+ * Only for Arduino DUE and STM32, with ENDSTOP_INTERRUPTS_FEATURE.                      *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_TRIGGER_CAPTURE
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ******************************* Z probe Options *****************************************
  *****************************************************************************************
@@ -303,6 +348,14 @@
 #define Z_PROBE_AFTER_PROBING  0  // Z position after probing is done
 #define Z_PROBE_LOW_POINT     -2  // Farthest distance below the trigger-point to go before stopping
 
+// Fast probing of the G29 points (G29 K0 for the normal probing)
+// A single probe at PROBE_FLY_SPEED for each point, the travel to the next point
+// raises only PROBE_FLY_CLEARANCE over the last trigger. Use ENDSTOP_TRIGGER_CAPTURE
+// for the trigger position at speed.
+//#define PROBE_FLY
+#define PROBE_FLY_SPEED      300  // (mm/min) Probing speed
+#define PROBE_FLY_CLEARANCE    2  // (mm) Raise over the last trigger for the travel
+
 // For M851 give a range for adjusting the Probe Z Offset
 #define Z_PROBE_OFFSET_RANGE_MIN -50
 #define Z_PROBE_OFFSET_RANGE_MAX  50
@@ -453,6 +506,11 @@
 #define GRID_MAX_POINTS_X 7
 #define GRID_MAX_POINTS_Y 7
 
+// Store the ABL or UBL mesh as int16 micrometres instead of float.
+// Half the RAM and EEPROM, so bigger meshes and more UBL slots fit.
+// Range +/-32.767mm with 0.001mm resolution. Save the mesh again after changing.
+//#define MESH_INT16_STORAGE
+
 // Probe along the Y axis, advancing X after each column
 //#define PROBE_Y_FIRST
 
@@ -462,6 +520,15 @@
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
 
+// Keep a table of bilinear coefficients for every grid cell (16 bytes each),
+// so a Z correction is a few multiply-adds without looking at the neighbors.
+//#define ABL_BILINEAR_COEFFICIENTS
+
+// G29 U probes only the grid points under the print area, the others continue the edge of it.
+// The area is given with L R F B, or scanned in the first layer of the SD file being printed.
+//#define ABL_PRINT_AREA
+#define ABL_PRINT_AREA_SCAN 262144  // (bytes) Longest first layer scanned in the SD file
+
 // Commands to execute at the end of G29 probing.
 // Useful to retract or move the Z probe out of the way.
 //#define Z_PROBE_END_SCRIPT "G1 Z10 F8000\nG1 X10 Y10\nG1 Z0.5"
@@ -474,7 +541,8 @@
  *                                                                                       *
  * Auto Calibration Delta system  G33 command                                            *
  * Three type of the calibration DELTA                                                   *
- *  1) Algorithm of Minor Squares based on DC42 RepRapFirmware 7 points           ~3.2Kb *
+ *  1) Algorithm of Minor Squares based on DC42 RepRapFirmware 7 - 31 points      ~3.2Kb *
+ *     A single probe round, G33 P sets the points (up to 16 on AVR).                    *
  *  2) Algorithm based on LVD-AC(Luc Van Daele) 1 - 7 points + iteration          ~4.5Kb *
  *                                                                                       *
  * To use one of this you must have a PROBE, please define you type probe.               *
@@ -484,7 +552,7 @@
 //#define DELTA_AUTO_CALIBRATION_2
 
 #define DELTA_AUTO_CALIBRATION_1_DEFAULT_FACTOR 6
-#define DELTA_AUTO_CALIBRATION_1_DEFAULT_POINTS 7
+#define DELTA_AUTO_CALIBRATION_1_DEFAULT_POINTS 16
 
 #define DELTA_AUTO_CALIBRATION_2_DEFAULT_POINTS 4
 /*****************************************************************************************/
@@ -611,6 +679,13 @@
 
 // Re-Bump Speed Divisor (Divides the Homing Feedrate)
 #define XYZ_BUMP_DIVISOR 10
+
+// Fast approach: homed towers travel together at the max feedrate up to HOMING_FAST_APPROACH_MM
+// under the lowest endstop, then the homing feedrate finds it. The towers move away from the
+// endstops together and only the slow bump is done one tower at a time.
+// The towers must not have lost steps since the last homing: the margin is all they can miss by.
+//#define HOMING_FAST_APPROACH
+#define HOMING_FAST_APPROACH_MM 10
 /*****************************************************************************************/
 
 
@@ -222,6 +222,11 @@
 // before setting a PWM value.
 //#define FAN_KICKSTART_TIME 200
 
+// M106 and M107 queue the new speed in the planner, so the fan changes
+// when the moves before it are done, with no wait for the moves to finish.
+// M106 S0 is the fan off like M107.
+//#define SYNCHRONOUS_FAN_SPEED
+
 // AUTO FAN - Fans for cooling Hotend or Controller Fan
 // Put number Hotend in fan to automatically turn on/off when the associated
 // hotend temperature is above/below HOTEND AUTO FAN TEMPERATURE.
@@ -240,6 +245,12 @@
 
 // Add Tachometric option for fan ONLY FOR DUE. (Add TACHOMETRIC PIN in configuration pins)
 //#define TACHOMETRIC
+// Measure the tacho period with the timer capture, no interrupt on every edge.
+// Only on the TIOA pins of the free timers (DUE pin 2, 3, 5, 11) or the CH1/CH2
+// pins of a free timer (STM32), the other pins use the interrupt.
+//#define TACHOMETRIC_CAPTURE
+// A running fan with no tacho pulse for this time (ms) is stopped
+#define TACHOMETRIC_STALL_MS 300
 /****************************************************************************/
 
 
@@ -271,6 +282,14 @@
 #define TOOL_CHANGE_FIL_SWAP_PURGE            2  // (mm)
 #define TOOL_CHANGE_FIL_SWAP_RETRACT_SPEED 3000  // (mm/m)
 #define TOOL_CHANGE_FIL_SWAP_PRIME_SPEED    600  // (mm/m)
+
+// Standby and preheat of the hotends on tool change (more than one hotend)
+// On tool change the old hotend goes to its idle temperature (M104 T<n> R<temp>),
+// if one is set, and the new one heats back to its target. While printing, the
+// command queue and the SD read-ahead buffer are scanned for the next T and its
+// hotend heats back TOOL_CHANGE_PREHEAT_LEAD seconds before the estimated change.
+//#define TOOL_CHANGE_PREHEAT
+#define TOOL_CHANGE_PREHEAT_LEAD             30  // (s)
 /***********************************************************************/
 
 
@@ -356,6 +375,10 @@
 #define MIXING_STEPPERS 2
 // Use the Virtual Tool method with M163 and M164
 #define MIXING_VIRTUAL_TOOLS 16
+// Slices of the gradient mix (M166) between start and end Z.
+// The mix of every slice is computed when the gradient is set, a move only looks up its slice.
+// Set it near the layers in the gradient for a change of mix for every layer.
+#define MIXING_GRADIENT_STEPS 32
 /***********************************************************************/
 
 
@@ -452,6 +475,12 @@
 // Enable if the MMU2 has 12V stepper motors (MMU2 Firmware 1.0.2 and up)
 //#define MMU2_MODE_12V
 
+// Tool change with no wait: T returns at once and the MMU swaps the filament while
+// the moves with no extrusion go on, the first E move waits for the swap.
+// The T is sent to the MMU when the E moves of the old filament are done, and
+// the next T in the command queue is started early if nothing extrudes before it.
+//#define MMU2_ASYNC_TOOL_CHANGE
+
 // G-code to execute when MMU2 F.I.N.D.A. probe detects filament runout
 #define MMU2_FILAMENT_RUNOUT_SCRIPT "M600"
 
@@ -463,6 +492,48 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ***************************** Toolboard *******************************
+ ***********************************************************************
+ *                                                                     *
+ * Hotends and extruders on expansion boards (nodes) on a UART bus.    *
+ * The node runs the heater control and the E stepping of its tool:    *
+ * the main board polls it with the target, gets back the temperature  *
+ * and sends the E of each block when the stepper starts it.           *
+ * Set TEMP_SENSOR 12 for the hotends on a node.                       *
+ * See src/feature/toolboard/serial-protocol.md for the frames.        *
+ *                                                                     *
+ ***********************************************************************/
+//#define TOOLBOARD
+
+// Serial port of the bus, full-duplex UART or RS422
+#define TOOLBOARD_SERIAL    2
+#define TOOLBOARD_BAUDRATE  500000
+
+// Node of each tool (hotend and extruder), -1 on the main board
+#define TOOLBOARD_TOOL_NODE { -1, -1, -1, -1, -1, -1 }
+/***********************************************************************/
+
+
+/***********************************************************************
+ *************************** Network bridge ****************************
+ ***********************************************************************
+ *                                                                     *
+ * An ESP32 on SERIAL_PORT_2 gives the HTTP upload and streaming of    *
+ * the jobs. The port talks in frames at BAUDRATE_2 (1000000 or        *
+ * 2000000) and is no more a host port. The uploads are written on SD  *
+ * in whole blocks (SD_UPLOAD_BLOCKS), the lines of a streamed job go  *
+ * in the command queue with credits instead of an ok for each line.   *
+ * See src/feature/netbridge/serial-protocol.md for the frames.        *
+ *                                                                     *
+ ***********************************************************************/
+//#define NET_BRIDGE
+
+// Bytes the bridge may send ahead, at most the RX buffer of the port
+#define NET_BRIDGE_RX_WINDOW 512
+/***********************************************************************/
+
+
 /***********************************************************************
  ********************* Dual Extruder DONDOLO ***************************
  ***********************************************************************
@@ -536,6 +607,29 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ************************************ Thermal throttle ***********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Slow the moves down when the electronics run hot, before the alarm or the shutdown    *
+ * of a driver. Over THERMAL_THROTTLE_MCU_START the feedrate goes down linearly, to      *
+ * THERMAL_THROTTLE_MIN_PERCENT at the MCU alarm temperature (boards with the MCU        *
+ * temperature sensor). With MONITOR_DRIVER_STATUS each check with a TMC driver in       *
+ * over-temperature pre-warning takes THERMAL_THROTTLE_OTPW_STEP off, and it is given    *
+ * back a step every THERMAL_THROTTLE_RECOVER seconds with no warning.                   *
+ * The throttle multiplies the M220 speed factor, that stays the user's setting.         *
+ *                                                                                       *
+ * Uncomment THERMAL THROTTLE to enable this feature                                     *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define THERMAL_THROTTLE
+#define THERMAL_THROTTLE_MCU_START    65  // [C]
+#define THERMAL_THROTTLE_MIN_PERCENT  50  // [%] of the feedrate
+#define THERMAL_THROTTLE_OTPW_STEP    10  // [%] for each check with a driver pre-warning
+#define THERMAL_THROTTLE_RECOVER      10  // [s] for each step given back
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ******************** Extruder Advance Linear Pressure Control ***************************
  *****************************************************************************************
@@ -563,6 +657,18 @@
 // Only parameter for test mode
 #define LIN_ADVANCE_K_START   0
 #define LIN_ADVANCE_K_FACTOR  0.02
+
+// Step the advance in the main Bresenham loop, with no advance ISR.
+// The advance steps take the step events with no extruder step, and an advance
+// step against the extruder step cancels it, so no event has more than one E pulse.
+// The advance follows the step rate of the block up to its max advance steps.
+//#define LIN_ADVANCE_BRESENHAM
+
+// Number of profiles of K and flow for the features of the print (perimeter, infill, bridge...).
+// M900 P<profile> K<factor> F<flow> sets a profile, M900 P<profile> switches to it at the feature
+// changes of the slicer with no wait: the moves already planned keep their K. M900 P0 is back to
+// the K of the extruder and 100% flow. The flow is on the print moves, not on retracts and primes.
+//#define LIN_ADVANCE_PROFILES 3
 /*****************************************************************************************/
 
 
@@ -676,6 +782,14 @@
 // 300ms is a good value but you can try less delay.
 // If the servo can't reach the requested position, increase it.
 #define SERVO_DEACTIVATION_DELAY 300
+
+// Hardware PWM servos (STM32 and SAMD)
+// The pulses come from the PWM of a timer channel of the servo pin, at 50 Hz
+// with the width in µs: no interrupt, no jitter when the stepper ISR is busy.
+// The timer of the pin can't drive other PWM outputs (heaters, fans...).
+// On STM32 a pin with no free timer falls back to the servo timer ISR,
+// on SAMD the servo pins must be on a TCC channel.
+//#define SERVO_HARDWARE_PWM
 /**************************************************************************/
 
 
@@ -782,6 +896,14 @@
 //#define BABYSTEP_ZPROBE_GFX_OVERLAY
 // Reverses the direction of the CW/CCW indicators
 //#define BABYSTEP_ZPROBE_GFX_REVERSE
+
+// Z babysteps are added to the Z of the next planned moves instead of
+// being stepped by the Stepper outside of the moves. The planner limits
+// speed and acceleration of the change, so larger adjustments are safe.
+// The change is applied with the next G-code moves, at most
+// BABYSTEP_PLANNER_MOVE_MM for each move.
+//#define BABYSTEP_PLANNER
+#define BABYSTEP_PLANNER_MOVE_MM 0.05
 /**************************************************************************/
 
 
@@ -803,8 +925,13 @@
  *                                                                        *
  * Note that M207 / M208 / M209 settings are saved to EEPROM.             *
  *                                                                        *
+ * FWRETRACT COMBINED plans the retract and the Z lift as a single move,  *
+ * the same for the lowering and the recover, with no wait for the moves  *
+ * to end: the planner joins them to the travel, no stop at each island.  *
+ *                                                                        *
  **************************************************************************/
 //#define FWRETRACT
+//#define FWRETRACT_COMBINED
 
 #define MIN_AUTORETRACT               0.1 // When auto-retract is on, convert E moves of this length and over
 #define MAX_AUTORETRACT              10.0 // Upper limit for auto-retract conversion
@@ -983,6 +1110,10 @@
 // Set number of iterations to align
 #define Z_STEPPER_ALIGN_ITERATIONS 3
 
+// Correct all the Z steppers in a single move, each one locked after its own steps,
+// instead of one stepper after the other. G34 P0 or P1 overrides it.
+#define Z_STEPPER_ALIGN_PARALLEL true
+
 // Enable to restore leveling setup after operation
 #define RESTORE_LEVELING_AFTER_G34
 
@@ -1052,6 +1183,11 @@
 // If the machine cannot raise the probe fast enough after a trigger, it may enter a fault state.
 //#define BLTOUCH_HIGH_SPEED_MODE
 
+// Send the deploy as the probe starts the travel to the next point and the stow as it raises,
+// the delay of the commands runs in parallel with the moves. The pin is down during the travel,
+// so Z_PROBE_BETWEEN_HEIGHT must clear the stroke of the pin. Not with BLTOUCH_HIGH_SPEED_MODE.
+//#define BLTOUCH_PIPELINED_DEPLOY
+
 // Feature: Switch into SW mode after a deploy. It makes the output pulse longer. Can be useful
 //          in special cases, like noisy or filtered input configurations.
 //#define BLTOUCH_FORCE_SW_MODE
@@ -1141,6 +1277,15 @@
 // large enough to avoid false positives.)
 //#define EXTRUDER_ENCODER_CONTROL
 
+// With EXTRUDER_ENCODER_CONTROL compare the filament moved by the encoder with the
+// E moves of the completed blocks, on the last FILAMENT_MOTION_WINDOW_MM of filament.
+// A ratio of measured to commanded under FILAMENT_MOTION_MIN_RATIO is a jam or an
+// under-extrusion and runs the runout script. Set FILAMENT_RUNOUT_DISTANCE_MM to 0.
+//#define EXTRUDER_ENCODER_MOTION
+#define FILAMENT_MOTION_MM_PER_PULSE  1.5   // Filament moved for each edge of the encoder pin (mm)
+#define FILAMENT_MOTION_WINDOW_MM      20   // (mm)
+#define FILAMENT_MOTION_MIN_RATIO     0.6
+
 // Set true or false should assigned
 #define FIL_RUNOUT_0_LOGIC false
 #define FIL_RUNOUT_1_LOGIC false
@@ -1226,6 +1371,13 @@
 #define POWER_ERROR         0.0     //(%) Ammortize measure error.
 #define POWER_EFFICIENCY  100.0     //(%) The power efficency of the power supply
 
+// The power and the energy come from all the samples of the sensor, every ms (a burst
+// with the PDC of the DUE with ADC_OVERSAMPLING), so the PWM of the heaters is followed.
+// The energy of the job is in M78, in M408 S3 "jobEnergy" and M408 "power" is the load in Watt.
+// Uncomment for a sensor on the mains: the power from the RMS current and POWER_VOLTAGE the mains RMS voltage.
+// Commented for the DC out of the power supply: the power from the mean current.
+//#define POWER_CONSUMPTION_AC
+
 //When using an LCD, uncomment the line below to display the Power consumption sensor data on the last line instead of status. Status will appear for 5 sec.
 //#define POWER_CONSUMPTION_LCD_DISPLAY
 /**************************************************************************/
@@ -1246,6 +1398,11 @@
 #define FLOWMETER_MAXFLOW  6.0      // Liters per minute max
 #define FLOWMETER_MAXFREQ  55       // frequency of pulses at max flow
 
+// Measure the pulse period with the timer capture, no interrupt on every pulse.
+// Only on the TIOA pins of the free timers (DUE pin 2, 3, 5, 11) or the CH1/CH2
+// pins of a free timer (STM32), the other pins use the interrupt.
+//#define FLOWMETER_CAPTURE
+
 // uncomment this to kill print job under the min flow rate, in liters/minute
 //#define MINFLOW_PROTECTION 4
 /**************************************************************************/
@@ -1297,6 +1454,11 @@
  * The new pins are 120 - 121 - 122 - 123 - 124 - 125 - 126 - 127                        *
  * Select the address of your board                                                      *
  *                                                                                       *
+ * The pins are kept in a copy of the port, the idle loop writes the outputs changed     *
+ * with one I2C transfer and reads the inputs with one more. With the INT line of the    *
+ * chip on PCF8574_INT_PIN (Configuration_Pins.h) the inputs are read only when they     *
+ * change, else every 10 ms.                                                             *
+ *                                                                                       *
  *****************************************************************************************/
 //#define PCF8574_EXPANSION_IO
 #define PCF8574_ADDRESS 0x39
@@ -1332,11 +1494,23 @@
 // Init EEPROM automatically on any errors.
 //#define EEPROM_AUTO_INIT
 
+// Keep the values that change often (print statistics, laser lifetime) in an append only
+// journal of this size in bytes at the end of the EEPROM. A change writes a small record,
+// a half of the journal is rewritten only when the other is full. Moves the UBL mesh slots.
+//#define EEPROM_JOURNAL_SIZE 512
+
+// With the journal the print statistics are counted in RAM and saved only at the end of a job,
+// when the printer is idle every STATS_DEFERRED_INTERVAL hours and on a power outage (POWER_CHECK):
+// no write to the EEPROM while printing.
+//#define STATS_DEFERRED_SAVE
+#define STATS_DEFERRED_INTERVAL 24
+
 // Type EEPROM Hardware
 //  Caution!!! The cards that mount the eeprom by default
 //  have already enabled the correct define, do not touch this.
 //#define EEPROM_I2C
 //#define EEPROM_SPI
+//#define EEPROM_SPI_FRAM   // The SPI memory is a FRAM, written with no wait and no page
 //#define EEPROM_SD
 //#define EEPROM_FLASH
 /************************************************************************************************************************/
@@ -1346,23 +1520,22 @@
  *************************************** SDCARD ******************************************
  *****************************************************************************************
  *                                                                                       *
- * The alternative to the SD reader and put a USB Flash reader.                          *
- * Support for USB thumb drives using an Arduino USB Host Shield or                      *
- * equivalent MAX3421E breakout board. The USB thumb drive will appear                   *
- * to MK4duo as an SD card.                                                              *
+ * The alternative to the SD reader is a USB flash drive on the USB host of the MCU.      *
+ * The drive appears to MK4duo as an SD card: print, upload, M20 and M39 as on the SD.   *
+ * It is mounted when plugged in and unmounted when pulled out, a print is aborted.      *
  *                                                                                       *
- * The MAX3421E must be assigned the same pins as the SD card reader, with               *
- * the following pin mapping:                                                            *
+ *  - Arduino DUE: the native USB port, with 5V on its connector (the DUE gives no VBUS).*
+ *  - STM32: the USB OTG FS (PA11 DM, PA12 DP), build with -DUSBHOST for the USB Host    *
+ *    Library of the core.                                                               *
  *                                                                                       *
- *    SCLK, MOSI, MISO --> SCLK, MOSI, MISO                                              *
- *    INT              --> SD_DETECT_PIN                                                 *
- *    SS               --> SDSS                                                          *
+ * The port is no more a serial: SERIAL_PORT_1 must be a UART.                           *
+ * Drives with 512 byte blocks, FAT16 or FAT32.                                          *
  *                                                                                       *
  * define SD support or USB FLASH drive support                                          *
  *                                                                                       *
  *****************************************************************************************/
 //#define SDSUPPORT
-//#define USB_FLASH_DRIVE_SUPPORT (NOT USED FOR NOW!!!)
+//#define USB_FLASH_DRIVE_SUPPORT
 
 // Advanced command M39
 // Info and formatting SD card
@@ -1385,6 +1558,16 @@
 // Use CRC checks and retries on the SD communication.
 //#define SD_CHECK_AND_RETRY
 
+//
+// SD CARD: SDIO
+//
+// Drive the card with the 4 bit SD bus instead of SPI, on boards with the socket wired
+// to it: HSMCI of the SAM3X (MCCK PA19, MCCDA PA20, MCDA0-3 PA21-PA24) or SDIO of the
+// STM32 F4 and SDMMC1 of the STM32 F7 (CK PC12, CMD PD2, D0-D3 PC8-PC11).
+// The SPI speed of the card and its SS_PIN are not used.
+//#define SD_SDIO
+#define SD_SDIO_CLOCK 25000   // kHz of the data transfers, 25000 is the default speed of all cards
+
 //
 // Show extended directory including file length.
 // Don't use this with Pronterface
@@ -1399,6 +1582,68 @@
 // Note: This is always disabled for ULTIPANEL (except ELB_FULL_GRAPHIC_CONTROLLER).
 //#define SD_DETECT_INVERTED
 
+//
+// SD CARD: READ AHEAD
+//
+// Read the printed file SD_READ_AHEAD_BLOCKS blocks of 512 bytes at a time,
+// with one multi block transfer into a buffer of its own, instead of one
+// block at a time through the volume cache shared with the FAT.
+// Uses SD_READ_AHEAD_BLOCKS * 512 bytes of RAM, for 32 bit boards.
+//#define SD_READ_AHEAD
+#define SD_READ_AHEAD_BLOCKS 4
+// Take whole lines from the read ahead buffer, in place, instead of one char at a time.
+// Comments are cut in the same pass. Uses MAX_CMD_SIZE more bytes of RAM.
+//#define SD_READ_LINES
+// Check at the open if the printed file is contiguous on the card, then read the whole
+// blocks of the read ahead by their computed numbers, with no FAT cluster chain lookups.
+//#define SD_READ_CONTIGUOUS
+
+//
+// SD CARD: UPLOAD BUFFER
+//
+// Collect the lines of M28 in a buffer of SD_UPLOAD_BLOCKS blocks of 512 bytes, written
+// with one multi block write when full. Also adds M28 B<bytes> <file>: after its ok the
+// host sends the file as raw bytes, written in a file allocated contiguous at once, with
+// no FAT update. The end is reported with the crc16 of the bytes. Uses its RAM, 32 bit boards.
+//#define SD_UPLOAD_BLOCKS 4
+#define SD_UPLOAD_TIMEOUT 5   // Seconds with no byte that abort a binary upload
+
+//
+// SD CARD: WRITE BEHIND
+//
+// The eeprom.bin of EEPROM_SD and the periodic saves of the restart job are only marked
+// when asked and written in idle time, at most SD_WRITE_BEHIND_BYTES for each idle call.
+// The forced restart saves of pause and abort are still written at once.
+//#define SD_WRITE_BEHIND
+#define SD_WRITE_BEHIND_BYTES 512
+
+//
+// SD CARD: DIRECTORY INDEX
+//
+// Keep the position and a name hash of the first SD_DIR_INDEX entries of the current
+// folder, so the count and a name of the LCD list and M20 are one entry read and not a
+// walk of the folder. Built at the first listing of a folder, cleared by any SD write.
+// Uses 3 bytes of RAM for each entry.
+//#define SD_DIR_INDEX 128
+
+//
+// SD CARD: COMPILED JOB
+//
+// Print files with G0 G1 G2 G3 stored as compact records, the floats the
+// parser would get, mixed with ASCII lines for all the other commands.
+// Write them with scripts/gcode_compile.py and print them with M23/M32 as any file.
+// Requires FASTER_GCODE_PARSER
+//#define SD_COMPILED_JOB
+
+//
+// SD CARD: PRINT TIME ESTIMATE
+//
+// M37 <file> runs the file in simulation with the moves planned as for the print,
+// timed from the trapezoids of the planner and never stepped, so the estimate has
+// the accelerations and the junction speeds and takes the time to read the file.
+// M37 reports the last estimate and M73 with no value the minutes left of it.
+//#define PRINT_TIME_ESTIMATION
+
 #define SD_FINISHED_STEPPERRELEASE true           // if sd support and the file is finished: disable steppers?
 #define SD_FINISHED_RELEASECOMMAND "M84 X Y Z E"  // You might want to keep the z enabled so your bed stays in place.
 
@@ -1429,6 +1674,9 @@
  *  - SDSORT_USES_STACK does the same, but uses a local stack-based buffer.
  *  - SDSORT_CACHE_NAMES will retain the sorted file listing in RAM. (Expensive!)
  *  - SDSORT_DYNAMIC_RAM only uses RAM when the SD menu is visible. (Use with caution!)
+ *  - SDSORT_KEYS sorts folders of any size with small keys, a name prefix and the
+ *    entry position. SDSORT_LIMIT keys are in RAM, a window of the sorted list, and
+ *    a move out of the window is one walk of the folder. Replaces the 4 options above.
  */
 //#define SDCARD_SORT_ALPHA
 
@@ -1442,12 +1690,24 @@
 #define SDSORT_DYNAMIC_RAM false  // Use dynamic allocation (within SD menus). Least expensive option. Set SDSORT_LIMIT before use!
 #define SDSORT_CACHE_VFATS 2      // Maximum number of 13-byte VFAT entries to use for sorting.
                                   // Note: Only affects SCROLL_LONG_FILENAMES with SDSORT_CACHE_NAMES but not SDSORT_DYNAMIC_RAM.
+//#define SDSORT_KEYS             // Sort all the folder, SDSORT_LIMIT keys at a time. Names equal in the prefix keep the folder order.
+#define SDSORT_KEY_LENGTH  8      // Characters of the name in a key. Costs SDSORT_KEY_LENGTH + 3 bytes for each of SDSORT_LIMIT.
 
 // This function enable the firmware write restart file for restart print when power loss
 //#define SD_RESTART_FILE               // Uncomment to enable
 #define SD_RESTART_FILE_SAVE_TIME    1  // Seconds between update
 #define SD_RESTART_FILE_PURGE_LEN   20  // Purge when restart
 #define SD_RESTART_FILE_RETRACT_LEN  1  // Retract when restart
+// Keep the restart file contiguous with this number of 512 bytes blocks, a save is one raw block
+// write, in the next block each time, with no FAT update. The newest valid block is restored.
+//#define SD_RESTART_RAW_SLOTS         2
+
+// SD job queue: the files added with M38 are printed one after the other.
+// The queue is the file "jobqueue" on the card, it is kept after a reset or a power loss.
+// When a job ends the next path is ready, the script runs and the next job starts.
+//  M38 <file> add a file, M38 lists, M38 D<n> removes job n (D0 all), M38 S1 starts the first
+//#define SD_JOB_QUEUE
+#define SD_JOB_QUEUE_SCRIPT "G28 X Y\nM84 E"  // Between the jobs, e.g. a bed eject
 /*****************************************************************************************/
 
 
@@ -1586,6 +1846,16 @@
 #define NEOPIXEL_BRIGHTNESS 127
 // Cycle through colors at startup
 //#define NEOPIXEL_STARTUP_TEST
+// Send the frame with the DMA, the interrupts stay on and the Stepper ISR is
+// never delayed by a long strip. A new frame waits for the end of the one sent.
+// DUE: NEOPIXEL_PIN on a PWM pin (6 to 9).
+// STM32F2/F4/F7: NEOPIXEL_PIN on a channel of a free 16 bit timer, with the
+// stream and channel of the DMA request of that timer channel, from the DMA
+// request table of the reference manual (TIM1_CH1 of the F446: DMA2_Stream1 6).
+// The other pins use the Adafruit driver.
+//#define NEOPIXEL_DMA
+#define NEOPIXEL_DMA_STREAM   DMA2_Stream1
+#define NEOPIXEL_DMA_CHANNEL  DMA_CHANNEL_6
 /**************************************************************************/
 
 
@@ -1668,6 +1938,106 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ********************** Adaptive multistepping *************************
+ ***********************************************************************
+ *                                                                     *
+ * With DOUBLE_QUAD_STEPPING the steps per ISR are chosen from fixed   *
+ * step rate thresholds. This option lowers the thresholds only when   *
+ * the measured stepper ISR load is high, or when the planner runs dry *
+ * while commands are waiting, and raises them back when it is idle.   *
+ *                                                                     *
+ * Load is the stepper ISR time in percent, sampled every 100ms.       *
+ * MAX_BIAS is the max shift of the thresholds (1 = half the rate).    *
+ *                                                                     *
+ ***********************************************************************/
+//#define ADAPTIVE_MULTISTEPPING
+#define ADAPTIVE_MULTISTEPPING_HIGH_LOAD  85
+#define ADAPTIVE_MULTISTEPPING_LOW_LOAD   40
+#define ADAPTIVE_MULTISTEPPING_MAX_BIAS    3
+/***********************************************************************/
+
+
+/***********************************************************************
+ ***************************** Feed hold *******************************
+ ***********************************************************************
+ *                                                                     *
+ * The realtime feed hold byte slows the motion down to a stop along   *
+ * the path, at the acceleration of the block, and the resume byte     *
+ * brings it back to the planned speed. The planned blocks are kept,   *
+ * the position is never lost and the queue is not drained.            *
+ *                                                                     *
+ * Requires REALTIME_COMMANDS. Not compatible with STEP_QUEUE.         *
+ *                                                                     *
+ ***********************************************************************/
+//#define FEED_HOLD
+/***********************************************************************/
+
+
+/***********************************************************************
+ ************************** Step queue mode ****************************
+ ***********************************************************************
+ *                                                                     *
+ * The time of every step of every motor is computed in the main loop  *
+ * from the trapezoid of the block and put in a queue, the stepper ISR *
+ * only takes the next entry and fires its steps. The motors step at   *
+ * their own times and not on the ticks of the Bresenham.              *
+ * Only for 32 bit boards, M130 selects the mode and compares them.    *
+ *                                                                     *
+ * SIZE is the entries in the queue, 4 byte each (power of 2).         *
+ * MIN_INTERVAL is the shortest time between two entries in us, the    *
+ * highest step rate of a motor is 1000000 / MIN_INTERVAL.             *
+ *                                                                     *
+ * Not compatible with LIN_ADVANCE, BEZIER_JERK_CONTROL, INPUT_SHAPING,*
+ * COLOR_MIXING_EXTRUDER, LASER, ENDSTOP_TRIGGER_CAPTURE and           *
+ * Z_LATE_ENABLE.                                                      *
+ *                                                                     *
+ ***********************************************************************/
+//#define STEP_QUEUE
+#define STEP_QUEUE_SIZE          1024
+#define STEP_QUEUE_MIN_INTERVAL     5   // us
+/***********************************************************************/
+
+
+/***********************************************************************
+ ************************** Step coprocessor ***************************
+ ***********************************************************************
+ *                                                                     *
+ * Split mode for the 8 bit boards. The main MCU parses and plans, the *
+ * blocks of the planner are sent on a serial port to a second MCU     *
+ * that runs their trapezoid, the step, dir and endstop pins. The main *
+ * MCU keeps the enable pins, the heaters and the rest.                *
+ * See src/core/stepper/coprocessor/serial-protocol.md for the frames. *
+ *                                                                     *
+ * SLOTS is the blocks queued on the coprocessor.                      *
+ *                                                                     *
+ * Not compatible with LIN_ADVANCE, BEZIER_JERK_CONTROL, INPUT_SHAPING,*
+ * STEP_QUEUE, COLOR_MIXING_EXTRUDER, LASER, BABYSTEPPING, FEED_HOLD,  *
+ * TOOLBOARD, ENDSTOP_TRIGGER_CAPTURE and Z_LATE_ENABLE.               *
+ *                                                                     *
+ ***********************************************************************/
+//#define STEP_COPROCESSOR
+#define STEP_COPROCESSOR_SERIAL       2
+#define STEP_COPROCESSOR_BAUDRATE     1000000
+#define STEP_COPROCESSOR_SLOTS        8
+/***********************************************************************/
+
+
+/**************************************************************************
+ ****************************** Fast math *********************************
+ **************************************************************************
+ *                                                                        *
+ * Approximate sqrt, atan2 and log in the hot paths: the trapezoids, the  *
+ * junction deviation, the delta and SCARA Transform and the thermistors. *
+ * Relative error 5e-6 for the square roots, 2e-6 rad for atan2.          *
+ * A large gain on soft float (AVR, DUE), the FPU boards use VSQRT.       *
+ * The bounds are checked in the host build with: mk4duo_native -m        *
+ *                                                                        *
+ **************************************************************************/
+//#define FAST_MATH
+/**************************************************************************/
+
+
 /**************************************************************************
  ************************* Junction Deviation *****************************
  **************************************************************************
@@ -1689,6 +2059,10 @@
 
 // (mm) Distance from real junction edge
 #define JUNCTION_DEVIATION_MM 0.02
+
+// The arc speed of the junctions of segments shorter than 1 mm is taken from the curve
+// through this many junctions, not from a single pair, for an even speed on curved meshes
+//#define JUNCTION_CURVE_WINDOW 4
 /**************************************************************************/
 
 
@@ -1706,6 +2080,70 @@
 /****************************************************************************/
 
 
+/****************************************************************************
+ ****************************** Input Shaping *******************************
+ ****************************************************************************
+ *                                                                          *
+ * Cancel the ringing of the X and Y axes, every step is split in impulses  *
+ * timed on the ringing frequency of the axis:                              *
+ *  0 ZV  two impulses, the shortest delay (half a ringing period)          *
+ *  1 MZV three impulses, a bit more robust on the frequency                *
+ *  2 EI  three impulses, the most robust, the longest delay (one period)   *
+ * Set the frequency (Hz) and the damping ratio with M593, frequency 0 is   *
+ * no shaping for that axis.                                                *
+ * The queue of the delayed steps limits the step rate of the axis to       *
+ * SHAPING_BUFFER_SIZE steps for the longest delay.                         *
+ * On CORE machines the shapers act on the A and B motors.                  *
+ *                                                                          *
+ ****************************************************************************/
+//#define INPUT_SHAPING
+
+#define SHAPING_FREQ_X  40      // Hz
+#define SHAPING_FREQ_Y  40      // Hz
+#define SHAPING_ZETA_X  0.1     // Damping ratio 0 - 0.99
+#define SHAPING_ZETA_Y  0.1     // Damping ratio 0 - 0.99
+#define SHAPING_TYPE_X  0       // 0 ZV, 1 MZV, 2 EI
+#define SHAPING_TYPE_Y  0       // 0 ZV, 1 MZV, 2 EI
+
+// Steps in the queue of each axis
+#define SHAPING_BUFFER_SIZE 512
+/****************************************************************************/
+
+
+/****************************************************************************
+ ************************** Resonance measurement ***************************
+ ****************************************************************************
+ *                                                                          *
+ * An accelerometer on the toolhead measures the resonances of an axis for  *
+ * the input shaping. M594 moves the axis back and forth at each frequency  *
+ * of a sweep and reports the vibration for each frequency and the peak,    *
+ * with P the samples are also logged on SD in RES_X.CSV or RES_Y.CSV.      *
+ * Only for 32 bit boards.                                                  *
+ *  ADXL345 on I2C, address 0x53 or 0x1D                                    *
+ *  LIS2DW  on I2C, address 0x19 or 0x18, or on SPI with the CS pin in      *
+ *          Configuration_Pins.h (the SPI of the HAL is mode 0, the ADXL345 *
+ *          needs mode 3)                                                   *
+ *                                                                          *
+ ****************************************************************************/
+//#define ACCELEROMETER_ADXL345
+//#define ACCELEROMETER_LIS2DW
+
+//#define ACCELEROMETER_SPI             // LIS2DW only
+#define ACCELEROMETER_I2C_ADDRESS 0x53
+
+// Sample rate of the chip: 400, 800 or 1600 Hz. The FIFO holds 32 samples,
+// the idle loop must read it before it fills, at 800 Hz every 40 ms.
+#define ACCELEROMETER_RATE 800
+
+// Defaults of M594
+#define RESONANCE_FREQ_MIN      5       // Hz
+#define RESONANCE_FREQ_MAX    100       // Hz
+#define RESONANCE_FREQ_STEP     1       // Hz
+#define RESONANCE_ACCEL_PER_HZ 75       // mm/s^2 of the moves for each Hz
+#define RESONANCE_TIME          0.5     // Seconds of moves at each frequency
+/****************************************************************************/
+
+
 /***************************************************************************************
  ******************************** Minimum stepper pulse ********************************
  ***************************************************************************************
@@ -1740,6 +2178,23 @@
 /***************************************************************************************/
 
 
+/***************************************************************************************
+ ********************************** Step pulse batch ***********************************
+ ***************************************************************************************
+ *                                                                                     *
+ * DUE and STM32 only. The step edges of all axes are collected and written with a     *
+ * single store per GPIO port (BSRR on STM32, SODR/CODR on DUE), instead of one pin    *
+ * write for each driver. The dir pins of a new block are written the same way.        *
+ * The drivers of an axis (dual X, dual/triple Z) on one port step on the same store,  *
+ * with no skew between them.                                                          *
+ * Useful with many drivers (dual Z, delta) at high microstepping.                     *
+ * Not compatible with PCF8574_EXPANSION_IO on step pins.                              *
+ *                                                                                     *
+ ***************************************************************************************/
+//#define STEP_PULSE_BATCH
+/***************************************************************************************/
+
+
 /***********************************************************************
  ********************** Direction Stepper Delay ************************
  ***********************************************************************
@@ -1759,6 +2214,34 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ***************** Direction Stepper Delay per driver ******************
+ ***********************************************************************
+ *                                                                     *
+ * DIR setup time of each driver (in ns), for machines with different  *
+ * drivers on the axes (e.g. TMC on XY, external drivers on Z).        *
+ * On a direction change only the DIR pins of the axes that flip are   *
+ * written, and the delay is the longest of their drivers and of       *
+ * DIRECTION_STEPPER_DELAY (M569 D).                                   *
+ *    0 : DIRECTION_STEPPER_DELAY only                                 *
+ *                                                                     *
+ ***********************************************************************/
+#define  X_DIRECTION_DELAY 0
+#define  Y_DIRECTION_DELAY 0
+#define  Z_DIRECTION_DELAY 0
+#define X2_DIRECTION_DELAY 0
+#define Y2_DIRECTION_DELAY 0
+#define Z2_DIRECTION_DELAY 0
+#define Z3_DIRECTION_DELAY 0
+#define E0_DIRECTION_DELAY 0
+#define E1_DIRECTION_DELAY 0
+#define E2_DIRECTION_DELAY 0
+#define E3_DIRECTION_DELAY 0
+#define E4_DIRECTION_DELAY 0
+#define E5_DIRECTION_DELAY 0
+/***********************************************************************/
+
+
 /***********************************************************************
  ********************** Adaptive Step Smoothing ************************
  ***********************************************************************
@@ -1889,12 +2372,23 @@
 #define MM_PER_ARC_SEGMENT  1   // Length of each arc segment
 #define MIN_ARC_SEGMENTS   24   // Minimum number of segments in a complete circle
 #define N_ARC_CORRECTION   25   // Number of intertpolated segments between corrections
+//#define ARC_CHORD_TOLERANCE 0.002 // (mm) Size the segments by the chord error instead of MM_PER_ARC_SEGMENT,
+                                  // large arcs get long segments and small arcs short ones
+#define ARC_SEGMENTS_PER_SEC 50   // With ARC_CHORD_TOLERANCE, most segments per second at the move feedrate
 //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
 //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
 
 // Moves with fewer segments than this will be ignored and joined with the next movement
 #define MIN_STEPS_PER_SEGMENT 6
 
+// Merge the runs of short and nearly collinear moves of dense meshes in one block.
+// A move is held back only while the planner buffer has 3 or more moves. Not for Delta or SCARA.
+//#define SEGMENT_MERGE
+#define SEGMENT_MERGE_SHORT_MM    0.5   // (mm) Only the moves shorter than this are merged
+#define SEGMENT_MERGE_MAX_MM      5.0   // (mm) Longest merged move
+#define SEGMENT_MERGE_TOLERANCE   0.01  // (mm) Max distance of the merged ends from the line of the first move
+#define SEGMENT_MERGE_E_RATIO     0.05  // Max relative difference of the E per mm from the first move
+
 // Uncomment to add the M100 Free Memory Watcher for debug purpose
 //#define M100_FREE_MEMORY_WATCHER
 
@@ -2039,6 +2533,10 @@
                                               //   Set to 0 for manual extrusion.
                                               //   Filament can be extruded repeatedly from the Filament Change menu
                                               //   until extrusion is consistent, and to purge old filament.
+//#define ADVANCED_PAUSE_CONTINUOUS_PURGE     // Purge until the LCD click or M108 instead of PAUSE_PARK_PURGE_LENGTH.
+#define PAUSE_PARK_PURGE_MAX_LENGTH      200  // (mm) Longest continuous purge, if nobody confirms.
+#define PAUSE_PARK_E_SEGMENT               5  // (mm) The load and unload moves are queued in segments of this length,
+                                              //   so the host and the LCD keep running and M410 ends a long move.
 
                                               // Filament Unload does a Retract, Delay, and Purge first:
 #define FILAMENT_UNLOAD_RETRACT_LENGTH    10  // (mm) Unload initial retract length.
@@ -2080,9 +2578,18 @@
  * Type 4 is an extended version of type 2 which may be used to poll for current         *
  * printer statistics.                                                                   *
  * Type 5 reports the current machine configuration.                                     *
+ * F<mask> selects the fields of the status, kept for the next reports:                  *
+ *   1 status, 2 coords, 4 currentTool, 8 params, 16 temps, 32 isr and underrun stats.   *
+ * D1 sends only the fields changed since the last report, "time" is always sent.        *
+ * The text is written to the serial from a buffer, in one write for a short report.     *
  *                                                                                       *
  *****************************************************************************************/
 //#define JSON_OUTPUT
+
+// The file info of M408 (slicer, heights, filament) is read in idle time after the file
+// select, one block at a time. The info of the last JSON_SCAN_CACHE files is kept, a file
+// selected again is not read. Costs 44 bytes of RAM for each file. 0 to disable the cache.
+#define JSON_SCAN_CACHE 4
 /*****************************************************************************************/
 
 
@@ -2128,6 +2635,181 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ********************************* Planner timing stats **********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Measure the time spent by the planner to fill and plan every new block.               *
+ * Use M101 to report last, min, max and average time in microseconds, M101 R to reset.  *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define PLANNER_TIMING_STATS
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ******************************** Planner underrun stats *********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Count the times the Stepper finds the block buffer empty while printing, with no      *
+ * wait asked by the G-code (M400, G28, M109...), and sample the buffer depth and the    *
+ * time queued in the buffer each time a block starts. The minimum depth is also kept    *
+ * for the last layers, a layer is a change of Z of the extruding moves.                 *
+ * Use M132 to report the stats, M132 R to reset. With JSON_OUTPUT the stats are also    *
+ * added to M408.                                                                        *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define PLANNER_UNDERRUN_STATS
+#define PLANNER_UNDERRUN_LAYERS 8   // Layers kept for the report
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ********************************** Planner sleep wait ***********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * While planner.synchronize() waits the end of the moves (M400, G28, M109...), after    *
+ * each idle call sleep the CPU up to the next interrupt (WFI on ARM, idle mode on AVR). *
+ * The stepper ISR at the end of the blocks, the tick and the serial wake it, the idle   *
+ * tasks run again at each wake. No sleep while the serial or the SD has input for the   *
+ * command buffer. Less power and heat of the MCU, the same response.                    *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define PLANNER_SLEEP_WAIT
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ******************************** GCode parser benchmark *********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * M103 parses a canned set of G1 lines and reports the time per line in microseconds,   *
+ * with the parser number scanner and with strtof for comparison.                        *
+ * M103 C<count> sets the number of passes (default 100).                                *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define GCODE_PARSER_BENCHMARK
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ********************************** Motion benchmark *************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * M135 generates a workload of moves from the current position and reports the blocks   *
+ * per second the planner takes in and the time per block: W0 a circle of tiny segments, *
+ * W1 sweeps (split in segments on delta and SCARA), W2 G2 arcs, W3 a raster across the  *
+ * mesh. The moves go through the kinematics and the leveling as G1.                     *
+ * By default they are planned in the planner time warp and never stepped, with L they   *
+ * run on the steppers without extrusion.                                                *
+ * With PLANNER_TIMING_STATS and STEPPER_ISR_PROFILER also planner time and ISR load.    *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define MOTION_BENCHMARK
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ******************************** Stepper ISR profiler ***********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Measure the time spent in each phase of the stepper ISR (pulse, block, advance)       *
+ * and the whole ISR, to know how close the MCU is to saturation.                        *
+ * On DUE and STM32 the DWT cycle counter is used, on AVR and SAMD the stepper           *
+ * timer ticks.                                                                          *
+ * Use M102 to report min, average and max per phase and the ISR duty cycle,             *
+ * M102 R to reset. With JSON_OUTPUT the stats are also added to M408.                   *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define STEPPER_ISR_PROFILER
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ********************************** Idle loop profiler ***********************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Measure the time of each task of the Printer idle loop (LCD, commands, sound,         *
+ * sensors, babystep, TMC monitor, MMU2...) in microseconds, and count the total time    *
+ * of each idle call in a log2 histogram, to find what keeps the planner waiting.        *
+ * Use M131 to report min, average and max per task and the histogram,                   *
+ * M131 R to reset.                                                                      *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define IDLE_PROFILER
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ************************************ Memory profiler ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * At the setup fill the free RAM, between the heap and the stack, with a test byte and  *
+ * keep the lowest stack pointer seen in the stepper ISR and in the tick ISR.            *
+ * Use M134 to report the free memory now and the lowest ever, the stack used by each    *
+ * ISR and the size of the planner, command and serial buffers and of the static pools   *
+ * of drivers, heaters, fans and extruders. M134 R to reset the marks.                   *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define MEMORY_PROFILER
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ************************************* Crash record **************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Keep in a RAM not cleared by a reset the last commands, the blocks of the planner,    *
+ * the last task of the idle loop and when the tick ISR, the stepper ISR and the idle    *
+ * loop last ran (with STEPPER_ISR_PROFILER also the longest stepper ISR).               *
+ * After a watchdog or a reset the record of the run before is reported at the start,    *
+ * and again with M137. A power on leaves no record.                                     *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define CRASH_RECORD
+#define CRASH_RECORD_COMMANDS  4  // Last commands kept
+#define CRASH_RECORD_LENGTH   24  // Characters kept of each command
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ************************************ Idle scheduler *************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Run the tasks of the Printer idle loop from a table, each one with its period and     *
+ * its budget, in the order of their priority. Commands, babystep and sound run at each  *
+ * idle call, the LCD after them, the slow sensors every few ms and the fans, the power  *
+ * and the flowmeter every second, in the main loop and not in the tick interrupt.       *
+ * When the idle call has spent IDLE_SCHEDULER_BUDGET_US the deferrable tasks wait for   *
+ * the next call, never twice in a row.                                                  *
+ * Use M133 to report the runs, the longest run, the overruns of the budget and the      *
+ * deferrals of each task, M133 R to reset.                                              *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define IDLE_SCHEDULER
+#define IDLE_SCHEDULER_BUDGET_US 2000
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ ************************************** RTOS tasks ***************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * DUE and STM32 only. Run the firmware as FreeRTOS tasks. The motion task runs the      *
+ * commands, the planner and the LCD menus as the single loop, the UI task sends the     *
+ * pages of a graphical LCD with software SPI, queued by the motion task. The heaters    *
+ * stay in the HAL tick. A slow display can not delay the planning.                      *
+ * Needs the library FreeRTOS_ARM for DUE or STM32duino FreeRTOS for STM32.              *
+ * The stack sizes are in words, the display queue in messages of up to 16 bytes.        *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define RTOS_TASKS
+#define RTOS_MOTION_STACK   2048
+#define RTOS_UI_STACK        256
+#define RTOS_DISPLAY_QUEUE   192
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  *************************************** Whatchdog ***************************************
  *****************************************************************************************
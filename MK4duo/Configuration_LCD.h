@@ -385,6 +385,13 @@
 
 // For GFX preview visualization enable NEXTION GFX
 //#define NEXTION_GFX
+// Draw the GFX preview at most once every this milliseconds, one line from the last drawn
+// point to the last move end point, so the preview costs the same at any segment rate.
+//#define NEXTION_GFX_FEED_MS 200
+
+// Put all the commands of a status update in a buffer of this size, sent as the serial
+// has room, with no wait in the main loop. Temperatures are sent only when they change.
+//#define NEXTION_BATCH_SIZE 256
 
 // Define name firmware file for Nextion on SD
 #define NEXTION_FIRMWARE_FILE "mk4duo.tft"
@@ -398,7 +405,7 @@
 #define SHOW_BOOTSCREEN
 #define BOOTSCREEN_TIMEOUT  2500
 #define BOOTSCREEN_MKLOGO_HIGH                    // Show a hight MK4duo logo on the Boot Screen (disable it saving 399 bytes of flash)
-//#define BOOTSCREEN_MKLOGO_ANIMATED              // Animated MK4duo logo. Costs ~‭3260 (or ~940) bytes of PROGMEM.
+//#define BOOTSCREEN_MKLOGO_ANIMATED              // Animated MK4duo logo. Costs ~3260 (or ~940) bytes of PROGMEM.
 
 //
 // *** VENDORS PLEASE READ ***
@@ -450,6 +457,14 @@
 // The normal delay is 10µs. Use the lowest value that still gives a reliable display.
 //#define DOGM_SPI_DELAY_US 5
 
+// Redraw the Status Screen only when a value on it has changed.
+// The u8g page loop, drawing and sending all the pages, is skipped when nothing changed.
+//#define STATUS_SCREEN_CHANGE_TRACKING
+
+// ST7920 of the HAL device: keep a copy of the frame (1024 bytes of RAM) and send only
+// the rows changed since the last frame. Not on AVR, the RAM is too little.
+//#define ST7920_FRAME_DIFF
+
 // Swap the CW/CCW indicators in the graphics overlay
 //#define OVERLAY_GFX_REVERSE
 
@@ -525,6 +540,11 @@
 #define ENCODER_10X_STEPS_PER_SEC 75    // If the encoder steps per sec exceeds this value, multiply steps moved x10 to quickly advance the value
 #define ENCODER_100X_STEPS_PER_SEC 160  // If the encoder steps per sec exceeds this value, multiply steps moved x100 to really quickly advance the value
 
+// Read the encoder wheel and the click in the 1 ms tick of the HAL, into a small queue of events
+// for the menus. No step or click is lost while the main loop is busy in a long operation.
+// Only for the wheel and the click on pins (BTN_EN1, BTN_EN2 and BTN_ENC).
+//#define LCD_ENCODER_ISR
+
 // Comment to disable setting feedrate multiplier via encoder
 #define ULTIPANEL_FEEDMULTIPLY
 
@@ -580,6 +600,16 @@
 //#define PROGRESS_MSG_ONCE
 // Add a menu item to test the progress bar:
 //#define LCD_PROGRESS_BAR_TEST
+
+// HD44780 characters are written through a shadow of the display: the ones equal to
+// the shadow are skipped and the cursor is moved only where a run of changed ones breaks.
+// Most useful with the I2C backpacks, where each character is several bus transactions.
+//#define LCD_SHADOW_WRITES
+
+// HD44780 screens are drawn in a shadow buffer, then only the changed characters
+// are sent, at most this number for each idle call. Lower to block the main loop less.
+// The graphical LCDs already send one u8g page for each call.
+//#define LCD_UPDATE_BUDGET_CHARS 8
 /*****************************************************************************************/
 
 
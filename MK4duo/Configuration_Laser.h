@@ -54,14 +54,27 @@
 // Uncomment the following if your laser pwm pin (not the power pin) needs to be inverted.
 //#define LASER_PWM_INVERT
 
+// Scale the power of the continuous firing by the speed of the move, the step rate over the nominal
+// rate of the block, so the corners slowed by the acceleration are not burned darker.
+// The pulsed and the raster modes fire by distance and are already even.
+//#define LASER_DYNAMIC_POWER
+
 // The following defines select which G codes tell the laser to fire. It's OK to uncomment more than one.
 #define LASER_FIRE_SPINDLE    // fire the laser on M3, extinguish on M5
 //#define LASER_FIRE_G1       // fire the laser on a G1 move, extinguish when the move ends
 //#define LASER_FIRE_E        // fire the laser when the E axis moves
 
-// Raster mode enables the laser to etch bitmap data at high speeds. Increases command buffer size substantially.
+// Raster mode enables the laser to etch bitmap data at high speeds.
+// The pixels of the queued moves share a pool of LASER_RASTER_POOL_SIZE bytes,
+// each move takes only the pixels of its line, so the planner buffer can stay deep.
 //#define LASER_RASTER
 #define LASER_MAX_RASTER_LINE 68      // Maximum number of base64 encoded pixels per raster gcode command
+#define LASER_RASTER_POOL_SIZE 1024   // Bytes for the pixels of all the queued raster moves
+// G7 B<pixels>: the raster line comes as raw bytes right after the '\n' of the G7 line,
+// the pixels then their crc16 (CCITT, init 0xFFFF, little endian), from the host or the SD.
+// A checksum error on the serial asks the G7 line again with Resend. No base64 decoding,
+// 3/4 of the bytes of the D parameter.
+//#define LASER_RASTER_BINARY
 #define LASER_RASTER_ASPECT_RATIO 1   // pixels aren't square on most displays, 1.33 == 4:3 aspect ratio. 
 #define LASER_RASTER_MM_PER_PULSE 0.2 // Can be overridden by providing an R value in M649 command : M649 S17 B2 D0 R0.1 F4000
 
@@ -78,6 +78,11 @@
 //#define SPI_ENDSTOPS
 //#define IMPROVE_HOMING_RELIABILITY
 
+// Poll SPI_ENDSTOPS from the 1 ms tick every SPI_ENDSTOPS_POLL_MS instead of from idle(),
+// so the trigger timing doesn't depend on the idle loop and homing can be faster.
+// The poll waits while idle() uses the SPI bus (LCD, thermocouples, driver monitor).
+//#define SPI_ENDSTOPS_POLL_MS 2
+
 // Create a 50/50 square wave step pulse optimal for stepper drivers.
 //#define SQUARE_WAVE_STEPPING
 
@@ -141,6 +146,20 @@
 //#define REPORT_CURRENT_CHANGE
 //#define STOP_ON_ERROR
 
+// TMC2130, TMC2160, TMC5130 and TMC5160 on hardware SPI only
+// Read the status of all the drivers in one SPI transaction, pipelined: the answer
+// to a read comes with the next datagram, so n reads of a driver take n+1 datagrams
+// instead of 2n. Used by MONITOR_DRIVER_STATUS and by the SPI_ENDSTOPS stall check.
+//#define TMC_SPI_BATCH
+
+// Lower the current of all the TMC drivers after a short time without moves.
+// The motors keep holding, so the homing is not lost as with the stepper timeout,
+// and the drivers and the motors run cooler. The run current is written back
+// by the planner before it queues the next block.
+//#define TMC_IDLE_CURRENT
+#define TMC_IDLE_CURRENT_PERCENT  50  // [%] of the run current set with M906
+#define TMC_IDLE_CURRENT_DELAY    10  // [s] without moves
+
 // The driver will switch to spreadCycle when stepper speed is over HYBRID_THRESHOLD.
 // This mode allows for faster movements at the expense of higher noise levels.
 // STEALTHCHOP for axis needs to be enabled.
@@ -76,6 +76,24 @@
 /***********************************************************************************/
 
 
+/***********************************************************************************
+ ******************************** DLP layer cycle **********************************
+ ***********************************************************************************
+ *                                                                                 *
+ * M652 queues all the cycle of a layer in the planner: the settle of the resin,   *
+ * the exposure, the peel (or the tilt) with its pause and the move to the next    *
+ * layer. The ok comes at once and the host sends the next layer while this one    *
+ * runs: the waits are timed by the stepper, not by the host and its serial.       *
+ * The exposure starts with DLP_EXPOSE_PIN high (see Configuration_Pins.h) and the *
+ * host action "//action:expose on", it ends with "//action:expose off".           *
+ *                                                                                 *
+ * Not compatible with STEP_QUEUE and STEP_COPROCESSOR.                            *
+ *                                                                                 *
+ ***********************************************************************************/
+//#define DLP_LAYER_CYCLE
+/***********************************************************************************/
+
+
 /*****************************************************************************************
  ************************* Endstop pullup resistors **************************************
  *****************************************************************************************
@@ -126,12 +144,43 @@
  *                                                                                       *
  * Enable this feature if all enabled endstop pins are interrupt-capable.                *
  * This will remove the need to poll the interrupt pins, saving many CPU cycles.         *
+ * Always enabled on 32 bit boards: on DUE, STM32 and SAMD51 the endstops are polled as  *
+ * before if some pins have no interrupt line of their own (e.g. PA0 and PB0 on STM32).  *
  *                                                                                       *
  *****************************************************************************************/
 //#define ENDSTOP_INTERRUPTS_FEATURE
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ****************************** Endstop port sampling ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Group the endstop pins by GPIO port at startup and read each port with a single       *
+ * register read, so the cost of checking the endstops doesn't grow with their number    *
+ * (dual/triple endstops, probe, G38). Useful on 32 bit boards, where a single pin read  *
+ * goes through the pin description table. Not compatible with PCF8574 expansion pins.   *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_PORT_SAMPLING
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ **************************** Endstop trigger capture ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Timestamp the endstop edge on entry of the endstop interrupt with the cycle counter   *
+ * and back-interpolate the position of the steps made after the edge, so the latched   *
+ * trigger position doesn't depend on the interrupt latency. Better M48 repeatability    *
+ * and faster probing feedrates.                                                         *
+ * Only for Arduino DUE and STM32, with ENDSTOP_INTERRUPTS_FEATURE.                      *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_TRIGGER_CAPTURE
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ********************************** Endstops min or max **********************************
  *****************************************************************************************
@@ -243,6 +243,11 @@
 
 #if ENABLED(CNCROUTER)
   #define CNCROUTER_PIN       NoPin
+  #define CNCROUTER_TACHO_PIN NoPin
+#endif
+
+#if ENABLED(ACCELEROMETER_SPI)
+  #define ACCELEROMETER_CS_PIN  NoPin
 #endif
 
 #if ENABLED(FILAMENT_RUNOUT_SENSOR)
@@ -276,6 +281,10 @@
   #define CASE_LIGHT_PIN      NoPin
 #endif
 
+#if ENABLED(DLP_LAYER_CYCLE)
+  #define DLP_EXPOSE_PIN      NoPin
+#endif
+
 #if ENABLED(DOOR_OPEN_FEATURE)
   #define DOOR_OPEN_PIN       NoPin
 #endif
@@ -299,6 +308,10 @@
   #define NEOPIXEL_PIN        NoPin
 #endif
 
+#if ENABLED(PCF8574_EXPANSION_IO)
+  #define PCF8574_INT_PIN     NoPin
+#endif
+
 #if ENABLED(DHT_SENSOR)
   #define DHT_DATA_PIN        NoPin
 #endif
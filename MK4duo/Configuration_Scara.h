@@ -84,6 +84,11 @@
 // If movement is choppy try lowering this value
 #define SCARA_SEGMENTS_PER_SECOND 100
 
+// Use a polynomial atan2 in the SCARA Transform instead of the libm one.
+// Accurate to 2e-6 rad and much faster on AVR and DUE, so SCARA_SEGMENTS_PER_SECOND can go higher.
+// Always on with FAST_MATH.
+//#define SCARA_FAST_TRIG
+
 // Precise lengths of inner (shoulder) and outer (elbow) support arms
 #define SCARA_LINKAGE_1 200 // mm
 #define SCARA_LINKAGE_2 200 // mm
@@ -148,12 +153,43 @@
  *                                                                                       *
  * Enable this feature if all enabled endstop pins are interrupt-capable.                *
  * This will remove the need to poll the interrupt pins, saving many CPU cycles.         *
+ * Always enabled on 32 bit boards: on DUE, STM32 and SAMD51 the endstops are polled as  *
+ * before if some pins have no interrupt line of their own (e.g. PA0 and PB0 on STM32).  *
  *                                                                                       *
  *****************************************************************************************/
 //#define ENDSTOP_INTERRUPTS_FEATURE
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ****************************** Endstop port sampling ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Group the endstop pins by GPIO port at startup and read each port with a single       *
+ * register read, so the cost of checking the endstops doesn't grow with their number    *
+ * (dual/triple endstops, probe, G38). Useful on 32 bit boards, where a single pin read  *
+ * goes through the pin description table. Not compatible with PCF8574 expansion pins.   *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_PORT_SAMPLING
+/*****************************************************************************************/
+
+
+/*****************************************************************************************
+ **************************** Endstop trigger capture ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Timestamp the endstop edge on entry of the endstop interrupt with the cycle counter   *
+ * and back-interpolate the position of the steps made after the edge, so the latched   *
+ * trigger position doesn't depend on the interrupt latency. Better M48 repeatability    *
+ * and faster probing feedrates.                                                         *
+ * Only for Arduino DUE and STM32, with ENDSTOP_INTERRUPTS_FEATURE.                      *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define ENDSTOP_TRIGGER_CAPTURE
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ******************************* Z probe Options *****************************************
  *****************************************************************************************
@@ -244,6 +280,16 @@
 #define Z_PROBE_AFTER_PROBING  0  // Z position after probing is done
 #define Z_PROBE_LOW_POINT     -2  // Farthest distance below the trigger-point to go before stopping
 
+// Fast probing of the G29 points (G29 K0 for the normal probing)
+// A single probe at PROBE_FLY_SPEED for each point, the travel to the next point
+// raises only PROBE_FLY_CLEARANCE over the last trigger. Use ENDSTOP_TRIGGER_CAPTURE
+// for the trigger position at speed.
+//#define PROBE_FLY
+#define PROBE_FLY_SPEED      300  // (mm/min) Probing speed
+#define PROBE_FLY_CLEARANCE    2  // (mm) Raise over the last trigger for the travel
+// Inductive or capacitive probe with no contact: raise and travel in one diagonal move
+//#define PROBE_FLY_CONTACTLESS
+
 // For M851 give a range for adjusting the Probe Z Offset
 #define Z_PROBE_OFFSET_RANGE_MIN -50
 #define Z_PROBE_OFFSET_RANGE_MAX  50
@@ -453,6 +499,11 @@
 #define GRID_MAX_POINTS_X 7
 #define GRID_MAX_POINTS_Y 7
 
+// Store the ABL or UBL mesh as int16 micrometres instead of float.
+// Half the RAM and EEPROM, so bigger meshes and more UBL slots fit.
+// Range +/-32.767mm with 0.001mm resolution. Save the mesh again after changing.
+//#define MESH_INT16_STORAGE
+
 // The Z probe minimum outer margin (to validate G29 parameters).
 #define MIN_PROBE_EDGE 10
 
@@ -464,6 +515,15 @@
 //#define ABL_BILINEAR_SUBDIVISION
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
+
+// Keep a table of bilinear coefficients for every grid cell (16 bytes each),
+// so a Z correction is a few multiply-adds without looking at the neighbors.
+//#define ABL_BILINEAR_COEFFICIENTS
+
+// G29 U probes only the grid points under the print area, the others continue the edge of it.
+// The area is given with L R F B, or scanned in the first layer of the SD file being printed.
+//#define ABL_PRINT_AREA
+#define ABL_PRINT_AREA_SCAN 262144  // (bytes) Longest first layer scanned in the SD file
 /** END AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR **/
 
 // Commands to execute at the end of G29 probing.
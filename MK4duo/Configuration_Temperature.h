@@ -75,6 +75,7 @@
  *   8 is 100k RS thermistor 198-961 (4.7k pullup)                                                   *
  *   9 User Sensor                                                                                   *
  *  11 DHT probe sensor DHT11, DHT12, DHT21 or DHT22 (ENABLE DHT SENSOR below)                       *
+ *  12 Toolboard, the hotend on a node of the TOOLBOARD bus (Only for hotends)                       *
  *  20 is the PT100 circuit amplifier found in Ultimainboard V2.x and Wanhao D6                      *
  *                                                                                                   *
  *       Use these for Testing or Development purposes. NEVER for production machine.                *
@@ -101,6 +102,32 @@
 // Thermistor series resistor value in Ohms (see on your board)
 #define THERMISTOR_SERIES_RS 4700.0
 
+// Convert thermistors (type 1-9) with a table built from the sensor parameters,
+// rebuilt by M305, instead of LOG and Steinhart-Hart at every reading.
+// 2 bytes per point for each heater. Outside the table the formula is used.
+//#define THERMISTOR_TABLE
+#define THERMISTOR_TABLE_MIN_TEMP   0 // (°C) First point
+#define THERMISTOR_TABLE_STEP       5 // (°C) Between points
+#define THERMISTOR_TABLE_POINTS    64
+
+// Arduino DUE only: the ADC converts the analog inputs continuously and the PDC (DMA)
+// stores the results, so HAL::Tick only adds up one buffer instead of starting and
+// reading every channel. Each reading averages 4^BITS conversions and gains BITS bits
+// of resolution (1-3). The M305 L and O offsets are in the finer ADC units.
+//#define ADC_OVERSAMPLING
+#define ADC_OVERSAMPLING_BITS 2
+
+// Keep the last TEMP_HISTORY_SIZE samples of temperature and PWM of each heater,
+// taken every TEMP_HISTORY_INTERVAL ms (multiple of 100). M156 reports them in one line.
+// 3 bytes per sample for each heater.
+//#define TEMP_HISTORY
+#define TEMP_HISTORY_SIZE     60
+#define TEMP_HISTORY_INTERVAL 1000
+
+// (ms) Time between two reads of the same MAX6675 or MAX31855 thermocouple.
+// The thermocouples are read one per idle call in turn. The MAX6675 needs 220ms for a conversion.
+#define THERMOCOUPLE_SAMPLE_PERIOD 250
+
 // User Sensor
 #define T9_NAME   "User Sensor"
 #define T9_R25    100000.0  // Resistance in Ohms @ 25°C
@@ -129,6 +156,12 @@
 #define TEMP_RESIDENCY_TIME 10  // (seconds)
 #define TEMP_WINDOW     1       // (degC) Window around target to start the residency timer x degC early.
 
+// Heat in background: M109-M190-M191 set the target and return at once, the wait is
+// done before the first command that needs the temperature (a move with E, G10-G11,
+// a tool change, M600, M701-M702). G28, G29 and the travel moves run while heating.
+// M104-M140-M141 with a new target cancel the wait still pending for that heater.
+//#define HEAT_IN_BACKGROUND
+
 // When temperature exceeds max temp, your heater will be switched off.
 // When temperature exceeds max temp, your cooler cannot be activaed.
 // This feature exists to protect your hotend from overheating accidentally,
@@ -247,9 +280,13 @@
 
 #define HOTEND_HYSTERESIS 2       // (degC) range of +/- temperatures considered "close" to the target one
 #define HOTEND_CHECK_INTERVAL 100 // ms between checks in bang-bang control
+#define HOTEND_PID_INTERVAL   100 // ms between PID updates, multiple of 100 (Ki and Kd are per second)
 
 #define PID_AUTOTUNE_MENU // Add PID Autotune to the LCD "Temperature" menu to run M303 and apply the result.
 
+// M303 stops before the last cycle when Ku and Tu change less than this percent between two cycles, 0 to run all the cycles.
+#define PID_AUTOTUNE_CONVERGENCE 5
+
 // this adds an experimental additional term to the heating power, proportional to the extrusion speed.
 // if Kc is chosen well, the additional required power due to increased melting should be compensated.
 //#define PID_ADD_EXTRUSION_RATE
@@ -260,6 +297,24 @@
 #define HOTEND_Ki {07, 07, 07, 07, 07, 07}
 #define HOTEND_Kd {60, 60, 60, 60, 60, 60}
 #define HOTEND_Kc {100, 100, 100, 100, 100, 100} // Heating power = Kc * (e_speed)
+
+/**
+ * Model Predictive Control for the hotends, it replaces the PID of the hotends with UsePid.
+ * A thermal model of heater block and sensor gives the power for the target temperature,
+ * the loss to ambient with the part cooling fan and the heat taken by the filament flow
+ * are compensated before the temperature drops.
+ * Calibrate with M307 S<temp> and save with M500, set the values with M307.
+ */
+//#define HOTEND_MPC
+//                                    {HE0,    HE1,    HE2,    HE3,    HE4,    HE5}
+#define MPC_HEATER_POWER              {40.0,   40.0,   40.0,   40.0,   40.0,   40.0}   // (W) Heater cartridge power
+#define MPC_BLOCK_HEAT_CAPACITY       {16.7,   16.7,   16.7,   16.7,   16.7,   16.7}   // (J/K) Heat block with nozzle and heater
+#define MPC_SENSOR_RESPONSIVENESS     {0.22,   0.22,   0.22,   0.22,   0.22,   0.22}   // (K/s/K) How fast the sensor follows the block
+#define MPC_AMBIENT_XFER_COEFF        {0.068,  0.068,  0.068,  0.068,  0.068,  0.068}  // (W/K) Heat loss to ambient with the part fan off
+#define MPC_AMBIENT_XFER_COEFF_FAN255 {0.097,  0.097,  0.097,  0.097,  0.097,  0.097}  // (W/K) Heat loss to ambient with the part fan at full speed
+#define MPC_FILAMENT_HEAT_CAPACITY    {5.6e-3, 5.6e-3, 5.6e-3, 5.6e-3, 5.6e-3, 5.6e-3} // (J/K/mm) 1.75mm PLA 5.6e-3, 2.85mm PLA 0.0143
+#define MPC_PART_FAN 0                // Fan cooling the part, -1 for none
+#define MPC_AUTOTUNE_TEMP 200         // (degC) Default temperature of M307 S
 /***********************************************************************/
 
 
@@ -279,6 +334,7 @@
 
 #define BED_HYSTERESIS        2 // Only disable heating if T>target+BED HYSTERESIS and enable heating if T<target-BED HYSTERESIS
 #define BED_CHECK_INTERVAL  500 // ms between checks in bang-bang control
+#define BED_PID_INTERVAL   1000 // ms between PID updates, multiple of 100 (Ki and Kd are per second)
 
 //      BED     {BED0,BED1,BED2,BED3}
 #define BED_Kp  {10,10,10,10}
@@ -305,6 +361,7 @@
 
 #define CHAMBER_HYSTERESIS        2 // Only disable heating if T>target+CHAMBER HYSTERESIS and enable heating if T<target-CHAMBER HYSTERESIS
 #define CHAMBER_CHECK_INTERVAL  500 // ms between checks in bang-bang control
+#define CHAMBER_PID_INTERVAL   1000 // ms between PID updates, multiple of 100 (Ki and Kd are per second)
 
 //      CHAMBER     {CHAMBER0,CHAMBER1,CHAMBER2,CHAMBER3}
 #define CHAMBER_Kp  {10,10,10,10}
@@ -329,6 +386,7 @@
 
 #define COOLER_HYSTERESIS        2 // only disable heating if T<target-COOLER_HYSTERESIS and enable heating if T>target+COOLER_HYSTERESIS
 #define COOLER_CHECK_INTERVAL  500 // ms between checks in bang-bang control
+#define COOLER_PID_INTERVAL   1000 // ms between PID updates, multiple of 100 (Ki and Kd are per second)
 
 #define COOLER_Kp  10
 #define COOLER_Ki  1
@@ -350,6 +408,29 @@
 /********************************************************************************/
 
 
+/********************************************************************************
+ ******************************* Power budget ***********************************
+ ********************************************************************************
+ *                                                                              *
+ * The power supply can't run all the heaters at full power. At each cycle of  *
+ * the heaters the power asked by their PWM is shared within the PSU limit:     *
+ * first the heaters holding the target, then the ones still heating, these     *
+ * scaled down together. So the bed can run at full power while the hotends     *
+ * only hold the temperature, with no permanent POWER_DRIVE_MAX limit.          *
+ *                                                                              *
+ * A heater with 0 W is not counted. A throttled heater heats slower, give its  *
+ * WATCH PERIOD some margin.                                                    *
+ *                                                                              *
+ ********************************************************************************/
+//#define POWER_BUDGET
+#define POWER_BUDGET_PSU_WATTS      360                           // (W) Power of the PSU for the heaters
+#define POWER_BUDGET_HOTEND_WATTS   { 40, 40, 40, 40, 40, 40 }    // (W) Power of each hotend at full PWM
+#define POWER_BUDGET_BED_WATTS      { 250, 250, 250, 250 }        // (W) Power of each bed at full PWM
+#define POWER_BUDGET_CHAMBER_WATTS  { 0, 0, 0, 0 }                // (W) Power of each chamber at full PWM
+#define POWER_BUDGET_HOLD_WINDOW    3                             // (°C) Below the target by this at most, a heater is holding
+/********************************************************************************/
+
+
 /**********************************************************************************
  ************************ Thermal runaway protection ******************************
  **********************************************************************************
@@ -105,7 +105,8 @@
 #include "src/lib/timer.h"
 #include "src/lib/enum.h"
 #include "src/lib/restorer.h"
-#include "src/lib/circular_queue.h"
+#include "src/lib/spsc_queue.h"
+#include "src/lib/static_pool.h"
 #include "src/lib/driver_types.h"
 #include "src/lib/duration_t.h"
 #include "src/lib/matrix.h"
@@ -114,6 +115,7 @@
 
 // Platform modules
 #include "src/platform/platform.h"
+#include "src/lib/fastmath.h"
 
 // Core modules
 #include "src/core/utility/utility.h"
@@ -123,7 +125,14 @@
 #include "src/core/nozzle/nozzle.h"
 #include "src/core/fanmanager/fanmanager.h"
 #include "src/core/eeprom/eeprom.h"
+#include "src/core/eeprom/journal.h"
 #include "src/core/printer/printer.h"
+#include "src/core/printer/idle_profiler.h"
+#include "src/core/printer/memory_profiler.h"
+#include "src/core/printer/crash_record.h"
+#include "src/core/printer/buffer_arena.h"
+#include "src/core/printer/scheduler.h"
+#include "src/core/printer/rtos_tasks.h"
 #include "src/core/planner/planner.h"
 #include "src/core/endstop/endstops.h"
 #include "src/core/stepper/stepper.h"
@@ -157,6 +166,7 @@
 #include "src/feature/bezier/bezier.h"
 #include "src/feature/digipot/digipot.h"
 #include "src/feature/emergency_parser/emergency_parser.h"
+#include "src/feature/binary_status/binary_status.h"
 #include "src/feature/probe/probe.h"
 #include "src/feature/bedlevel/bedlevel.h"
 #include "src/feature/babystep/babystep.h"
@@ -176,7 +186,13 @@
 #include "src/feature/cncrouter/cncrouter.h"
 #include "src/feature/mfrc522/mfrc522.h"
 #include "src/feature/pcf8574/pcf8574.h"
+#include "src/feature/accelerometer/accelerometer.h"
 #include "src/feature/rgbled/led.h"
 #include "src/feature/rgbled/led_events.h"
 #include "src/feature/caselight/caselight.h"
+#include "src/feature/thermalthrottle/thermalthrottle.h"
 #include "src/feature/restart/restart.h"
+#include "src/feature/jobqueue/jobqueue.h"
+#include "src/feature/toolboard/toolboard.h"
+#include "src/feature/netbridge/netbridge.h"
+#include "src/feature/dlpcycle/dlpcycle.h"
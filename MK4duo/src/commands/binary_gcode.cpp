@@ -0,0 +1,84 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * binary_gcode.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../MK4duo.h"
+
+#if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+
+bool BinaryGcode::compile(const char * cmd, char * const out) {
+
+  float   value[BINARY_GCODE_FIELDS];
+  uint8_t mask = 0;
+
+  // Skip spaces and N[-0-9]
+  while (*cmd == ' ') ++cmd;
+  if (*cmd == 'N' && NUMERIC_SIGNED(cmd[1])) {
+    cmd += 2;
+    while (NUMERIC(*cmd)) ++cmd;
+    while (*cmd == ' ') ++cmd;
+  }
+
+  // Only G0 G1 G2 G3, no subcodes
+  if (*cmd++ != 'G' || !WITHIN(*cmd, '0', '3')) return false;
+  const uint8_t code = *cmd++ - '0';
+  if (*cmd != ' ' && *cmd != '*' && *cmd != '\0') return false;
+
+  for (;;) {
+
+    while (*cmd == ' ') ++cmd;
+    if (*cmd == '\0' || *cmd == '*') break;
+
+    // Every parameter must be one of the fields, once, with a value
+    const char letter = *cmd++;
+    uint8_t f = 0;
+    while (f < BINARY_GCODE_FIELDS && field_letter(f) != letter) f++;
+    if (f == BINARY_GCODE_FIELDS || TEST(mask, f) || !GCodeParser::valid_float(cmd)) return false;
+
+    value[f] = GCodeParser::scan_float(cmd);
+    SBI(mask, f);
+
+    // Skip the number
+    if (*cmd == '-' || *cmd == '+') ++cmd;
+    while (NUMERIC(*cmd) || *cmd == '.') ++cmd;
+  }
+
+  // Sync, code, mask, then the values in field order
+  out[0] = BINARY_GCODE_SYNC;
+  out[1] = code;
+  out[2] = mask;
+  char *p = &out[3];
+  for (uint8_t f = 0; f < BINARY_GCODE_FIELDS; f++) {
+    if (!TEST(mask, f)) continue;
+    memcpy(p, &value[f], sizeof(float));
+    p += sizeof(float);
+  }
+
+  return true;
+}
+
+#endif // ENABLED(GCODE_PARSE_ON_ENQUEUE)
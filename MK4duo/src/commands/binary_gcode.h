@@ -0,0 +1,112 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * binary_gcode.h - Compact representation of motion commands
+ *
+ * G0 G1 G2 G3 can be queued as a compact command instead of text:
+ *   uint8  0xA5   sync
+ *   uint8  code   G code number, 0 to 3
+ *   uint8  mask   fields present, bit 0 to 7 = X Y Z E F I J R
+ *   float  value  one for each bit set in mask, in bit order
+ * GCodeParser::parse_binary() fills the parameters from it, without text parsing.
+ *
+ * BINARY_GCODE_PROTOCOL receives the command from the host as a frame, little endian:
+ *   uint8  0xA5   sync, only recognized at the start of a line
+ *   int32  N      line number, checked like the ASCII N
+ *   uint8  code   G code number, 0 to 3
+ *   uint8  mask   fields present
+ *   float  value  one for each bit set in mask, in bit order
+ *   uint16 crc    CRC16-CCITT (init 0xFFFF) of N, code, mask and values
+ * Every frame is answered with "ok" or "Resend:" as for ASCII lines,
+ * so hosts can mix frames and ASCII lines on the same port.
+ *
+ * GCODE_PARSE_ON_ENQUEUE converts ASCII G0 G1 G2 G3 lines when they are queued.
+ *
+ * SD_COMPILED_JOB prints files where the compact commands are stored as they are,
+ * mixed with ASCII lines for everything else (scripts/gcode_compile.py writes them).
+ * A record starting with the sync byte is a compact command, its size comes from the mask.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if HAS_COMPACT_GCODE
+
+#define BINARY_GCODE_SYNC     0xA5
+#define BINARY_GCODE_MAX_CODE 3   // G0 to G3
+#define BINARY_GCODE_FIELDS   8
+#define BINARY_GCODE_HEADER   7   // sync + N + code + mask
+#define BINARY_GCODE_MAX_SIZE (BINARY_GCODE_HEADER + (BINARY_GCODE_FIELDS) * sizeof(float) + 2)
+
+class BinaryGcode {
+
+  public: /** Public Function */
+
+    FORCE_INLINE static char field_letter(const uint8_t f) {
+      return pgm_read_byte(&PSTR("XYZEFIJR")[f]);
+    }
+
+    FORCE_INLINE static uint8_t field_count(const uint8_t mask) {
+      uint8_t count = 0;
+      for (uint8_t m = mask; m; m &= m - 1) count++;
+      return count;
+    }
+
+    FORCE_INLINE static bool is_compact(const char * const cmd) {
+      return uint8_t(cmd[0]) == BINARY_GCODE_SYNC;
+    }
+
+    // Bytes of a compact command: sync, code, mask, values
+    FORCE_INLINE static uint8_t compact_size(const uint8_t mask) {
+      return 3 + field_count(mask) * sizeof(float);
+    }
+
+    #if ENABLED(BINARY_GCODE_PROTOCOL)
+
+      FORCE_INLINE static uint8_t frame_size(const uint8_t mask) {
+        return BINARY_GCODE_HEADER + field_count(mask) * sizeof(float) + 2;
+      }
+
+      static uint16_t crc16(const uint8_t *data, uint8_t len) {
+        uint16_t crc = 0xFFFF;
+        while (len--) {
+          crc ^= uint16_t(*data++) << 8;
+          for (uint8_t b = 0; b < 8; b++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+        return crc;
+      }
+
+    #endif
+
+    #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+      /**
+       * Convert an ASCII G0 G1 G2 G3 line to the compact command
+       * Return false, leaving out untouched, if the line needs the text parser
+       */
+      static bool compile(const char * cmd, char * const out);
+    #endif
+
+};
+
+#endif // HAS_COMPACT_GCODE
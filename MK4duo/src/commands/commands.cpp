@@ -32,7 +32,11 @@
 Commands commands;
 
 /** Public Parameters */
-Circular_Queue<gcode_t, BUFSIZE> Commands::buffer_ring;
+#if ENABLED(BUFFER_ARENA)
+  SPSC_Queue<gcode_t, 0> Commands::buffer_ring;
+#else
+  SPSC_Queue<gcode_t, BUFSIZE> Commands::buffer_ring;
+#endif
 
 long Commands::gcode_last_N = 0;
 
@@ -41,16 +45,43 @@ long Commands::gcode_N = 0;
 
 int Commands::serial_count[NUM_SERIAL] = { 0 };
 
+#if ENABLED(SERIAL_RESEND_WINDOW)
+  bool    Commands::resend_requested = false;
+  uint8_t Commands::resend_checksum[SERIAL_RESEND_WINDOW] = { 0 };
+#endif
+
+#if ENABLED(SERIAL_BULK_READ)
+  char    Commands::bulk_buffer[NUM_SERIAL][SERIAL_BULK_READ_SIZE];
+  uint8_t Commands::bulk_index[NUM_SERIAL] = { 0 },
+          Commands::bulk_count[NUM_SERIAL] = { 0 };
+#endif
+
+#if ENABLED(HOST_OK_COALESCE)
+  uint8_t Commands::ok_pending[NUM_SERIAL] = { 0 };
+#endif
+
+#if ENABLED(HOST_BUSY_REPORTS)
+  bool Commands::processing = false;
+#endif
+
 PGM_P Commands::injected_commands_P = nullptr;
 
 /** Public Function */
 void Commands::flush_and_request_resend() {
+  #if ENABLED(HOST_OK_COALESCE)
+    // The held replies belong to the lines before the resend, the host
+    // counts them for its window, all go first even if the UART waits
+    flush_ok(true);
+  #endif
   SERIAL_FLUSH();
   SERIAL_LV(RESEND, gcode_last_N + 1);
   ok_to_send();
 }
 
 void Commands::get_available() {
+  #if ENABLED(HOST_OK_COALESCE)
+    flush_ok();
+  #endif
   if (buffer_ring.isFull()) return;
   get_serial();
   #if HAS_SD_SUPPORT
@@ -58,8 +89,40 @@ void Commands::get_available() {
   #endif
 }
 
+#if ENABLED(PLANNER_SLEEP_WAIT)
+
+  bool Commands::input_pending() {
+    if (buffer_ring.isFull()) return false;
+    return serial_data_available() || IS_SD_PRINTING();
+  }
+
+#endif
+
+#if ENABLED(HOST_OK_COALESCE)
+
+  void Commands::flush_ok(const bool wait/*=false*/) {
+    LOOP_L_N(p, NUM_SERIAL) {
+      uint8_t n = ok_pending[p];
+      if (!n) continue;
+      // "ok\n" is 3 bytes, send what fits now and keep the rest for the next call
+      if (!wait) NOMORE(n, Com::serialAvailableForWrite(p) / 3);
+      if (!n) continue;
+      ok_pending[p] -= n;
+      SERIAL_PORT(p);
+      while (n--) { SERIAL_STR(OK); SERIAL_EOL(); }
+      SERIAL_PORT(-1);
+    }
+  }
+
+#endif
+
 void Commands::advance_queue() {
 
+  #if ENABLED(REALTIME_COMMANDS)
+    // Feed hold, the planned moves end, the commands wait
+    if (emergency_parser.feed_hold) return;
+  #endif
+
   // Process immediate commands
   if (process_injected()) return;
 
@@ -69,7 +132,7 @@ void Commands::advance_queue() {
   #if HAS_SD_SUPPORT
 
     if (card.isSaving()) {
-      gcode_t command = buffer_ring.peek();
+      gcode_t &command = buffer_ring.peek();
       if (is_M29(command.gcode)) {
         // M29 closes the file
         card.finishWrite();
@@ -100,12 +163,15 @@ void Commands::advance_queue() {
   #endif // !HAS_SD_SUPPORT
 
   // The buffer_ring may be reset by a command handler or by code invoked by idle() within a handler
-  buffer_ring.dequeue();
+  buffer_ring.discard();
 
 }
 
 void Commands::clear_queue() {
   buffer_ring.clear();
+  #if ENABLED(LASER_RASTER_BINARY)
+    laser.raster_stream_clear();
+  #endif
 }
 
 void Commands::inject_P(PGM_P const pgcode) {
@@ -138,7 +204,7 @@ void Commands::process_now_P(PGM_P pgcode) {
     const size_t len = delim ?
       delim - pgcode : strlen_P(pgcode);              // Get the command length
     char cmd[len + 1];                                // Allocate a stack buffer
-    strncpy_P(cmd, pgcode, len);                      // Copy the command to the stack
+    memcpy_P(cmd, pgcode, len);                       // Copy the command to the stack
     cmd[len] = '\0';                                  // End with a nul
     parser.parse(cmd);                                // Parse the command
     process_parsed(false);                            // Process it
@@ -181,7 +247,7 @@ void Commands::get_destination() {
   }
 
   #if HAS_SD_RESTART
-    if (restart.enabled && IS_SD_PRINTING() && (seen.e || seen.z)) restart.save_job();
+    if (restart.enabled && IS_SD_PRINTING() && !printer.debugSimulation() && (seen.e || seen.z)) restart.save_job();
   #endif
 
   if (parser.linearval('F') > 0)
@@ -202,7 +268,9 @@ void Commands::get_destination() {
     gcode_M165();
   #endif
 
-  #if HAS_NEXTION_LCD && ENABLED(NEXTION_GFX)
+  #if HAS_NEXTION_LCD && ENABLED(NEXTION_GFX_FEED_MS)
+    nexlcd.gfx_feed(mechanics.destination, (seen.x || seen.y) && seen.e);
+  #elif HAS_NEXTION_LCD && ENABLED(NEXTION_GFX)
     if ((seen.x || seen.y) && seen.e)
       nexlcd.gfx_line_to(mechanics.destination);
     else
@@ -268,23 +336,30 @@ Heater* Commands::get_target_heater() {
 /** Private Function */
 void Commands::ok_to_send() {
 
-  gcode_t tmp = buffer_ring.peek();
+  const gcode_t &tmp = buffer_ring.peek();
 
   if (tmp.s_port < 0 || !tmp.send_ok) return;
 
+  #if ENABLED(HOST_OK_COALESCE)
+    if (ok_pending[tmp.s_port] < 255) {
+      ok_pending[tmp.s_port]++;
+      return;
+    }
+  #endif
+
   SERIAL_PORT(tmp.s_port);
   SERIAL_STR(OK);
 
   #if ENABLED(ADVANCED_OK)
-    char* p = tmp.gcode;
+    const char* p = tmp.gcode;
     if (*p == 'N') {
       SERIAL_CHR(' ');
       SERIAL_CHR(*p++);
       while (NUMERIC_SIGNED(*p))
         SERIAL_CHR(*p++);
     }
-    SERIAL_MV(" P", BLOCK_BUFFER_SIZE - planner.moves_planned() - 1);
-    SERIAL_MV(" B", BUFSIZE - buffer_ring.count());
+    SERIAL_MV(" P", planner.moves_free());
+    SERIAL_MV(" B", buffer_ring.size() - buffer_ring.count());
   #endif
 
   SERIAL_EOL();
@@ -296,6 +371,17 @@ void Commands::get_serial() {
   static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
   static bool serial_comment_mode[NUM_SERIAL] = { false };
 
+  #if ENABLED(BINARY_GCODE_PROTOCOL)
+    static uint8_t binary_size[NUM_SERIAL] = { 0 };   // Bytes expected for the binary frame, 0 for ASCII
+  #endif
+
+  #if ENABLED(LASER_RASTER_BINARY)
+    static uint16_t raster_size[NUM_SERIAL]   = { 0 },  // Bytes of the raster line after G7 B, crc included
+                    raster_count[NUM_SERIAL]  = { 0 },
+                    raster_crc[NUM_SERIAL];
+    static bool     raster_numbered[NUM_SERIAL];        // The G7 line had N, a bad line asks it again
+  #endif
+
   #if HAS_DOOR_OPEN
     if (READ(DOOR_OPEN_PIN) != endstops.isLogic(DOOR_OPEN)) {
       PRINTER_KEEPALIVE(DoorOpen);
@@ -307,27 +393,108 @@ void Commands::get_serial() {
   // send "wait" to indicate MK4duo is still waiting.
   #if NO_TIMEOUTS > 0
     static long_timer_t last_command_timer;
-    if (buffer_ring.isEmpty() && !Com::serialDataAvailable() && last_command_timer.expired(NO_TIMEOUTS)) {
+    if (buffer_ring.isEmpty() && !serial_data_available() && last_command_timer.expired(NO_TIMEOUTS)) {
       SERIAL_STR(WT);
       SERIAL_EOL();
     }
   #endif
 
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    if (card.isUploading()) card.upload_check_timeout();
+  #endif
+
   /**
    * Loop while serial characters are incoming and the buffer_ring is not full
    */
-  while (!buffer_ring.isFull() && Com::serialDataAvailable()) {
+  while (!buffer_ring.isFull() && serial_data_available()) {
+
+    #if NUM_SERIAL > 1
+      bool received = false;
+    #endif
 
     for (uint8_t i = 0; i < NUM_SERIAL; ++i) {
 
       int c;
 
+      #if NUM_SERIAL > 1
+        // The secondary port is read only while the buffer has headroom for the primary one
+        if (i && buffer_ring.count() >= buffer_ring.size() - SERIAL_PORT_2_HEADROOM) continue;
+      #endif
+
       printer.max_inactivity_timer.start();
 
-      if ((c = Com::serialRead(i)) < 0) continue;
+      if ((c = serial_read(i)) < 0) continue;
+
+      #if NUM_SERIAL > 1
+        received = true;
+      #endif
+
+      #if ENABLED(SD_UPLOAD_BLOCKS)
+        // The bytes of M28 B go in the file
+        if (card.isUploading()
+          #if ENABLED(NET_BRIDGE)
+            && !netbridge.uploading
+          #endif
+        ) {
+          card.upload_put(uint8_t(c));
+          continue;
+        }
+      #endif
 
       char serial_char = c;
 
+      #if ENABLED(LASER_RASTER_BINARY)
+        /**
+         * The raw raster line of a G7 B, the line is queued
+         * when the pixels and their crc16 are all here and good
+         */
+        if (raster_size[i]) {
+          const uint16_t pixels = raster_size[i] - 2;
+          const uint8_t b = c;
+          const uint16_t n = raster_count[i]++;
+          if (n < pixels) {
+            if (n < LASER_MAX_RASTER_LINE) laser.raster_stream_slot()[n] = b;
+            crc16(&raster_crc[i], &b, 1);
+          }
+          else if (n == pixels)
+            raster_crc[i] ^= b;
+          else {
+            raster_crc[i] ^= uint16_t(b) << 8;
+            raster_size[i] = 0;
+            if (raster_crc[i]) {
+              if (raster_numbered[i]) gcode_last_N--;
+              gcode_line_error(PSTR("Raster " MSG_HOST_ERR_CHECKSUM_MISMATCH), i);
+              return;
+            }
+            laser.raster_stream_push(MIN(pixels, uint16_t(LASER_MAX_RASTER_LINE)));
+            enqueue(serial_line_buffer[i], true, i);
+          }
+          continue;
+        }
+      #endif
+
+      #if ENABLED(BINARY_GCODE_PROTOCOL)
+        /**
+         * A sync byte at the start of a line begins a binary frame,
+         * collect it by size, newlines are data here
+         */
+        if (binary_size[i] || (!serial_count[i] && uint8_t(c) == BINARY_GCODE_SYNC)) {
+          serial_line_buffer[i][serial_count[i]++] = serial_char;
+          if (serial_count[i] == BINARY_GCODE_HEADER)
+            binary_size[i] = BinaryGcode::frame_size(uint8_t(serial_line_buffer[i][BINARY_GCODE_HEADER - 1]));
+          else if (!binary_size[i])
+            binary_size[i] = BINARY_GCODE_HEADER;
+          if (serial_count[i] == binary_size[i]) {
+            binary_size[i] = serial_count[i] = 0;
+            if (!binary_frame((uint8_t*)serial_line_buffer[i], i)) return;
+            #if NO_TIMEOUTS > 0
+              last_command_timer.start();
+            #endif
+          }
+          continue;
+        }
+      #endif
+
       /**
        * If the character ends the line
        */
@@ -357,6 +524,10 @@ void Commands::get_serial() {
 
           gcode_N = strtol(npos + 1, nullptr, 10);
 
+          #if ENABLED(SERIAL_RESEND_WINDOW)
+            if (!M110 && gcode_N != gcode_last_N + 1 && resend_skip_line(command, i)) continue;
+          #endif
+
           if (gcode_N != gcode_last_N + 1 && !M110) {
             gcode_line_error(PSTR(MSG_HOST_ERR_LINE_NO), i);
             return;
@@ -370,6 +541,10 @@ void Commands::get_serial() {
               gcode_line_error(PSTR(MSG_HOST_ERR_CHECKSUM_MISMATCH), i);
               return;
             }
+            #if ENABLED(SERIAL_RESEND_WINDOW)
+              resend_checksum[gcode_N & (SERIAL_RESEND_WINDOW - 1)] = checksum;
+              resend_requested = false;
+            #endif
           }
           else {
             gcode_line_error(PSTR(MSG_HOST_ERR_NO_CHECKSUM), i);
@@ -423,6 +598,23 @@ void Commands::get_serial() {
           last_command_timer.start();
         #endif
 
+        #if ENABLED(HOST_BUSY_REPORTS)
+          // A report asked while a command runs is answered now, out of the queue
+          if (processing && busy_report(command, i)) continue;
+        #endif
+
+        #if ENABLED(LASER_RASTER_BINARY)
+          // The raw raster line comes first, then the G7 is queued
+          const int16_t pixels = raster_frame_size(command);
+          if (pixels >= 0) {
+            raster_size[i] = pixels + 2;
+            raster_count[i] = 0;
+            raster_crc[i] = 0xFFFF;
+            raster_numbered[i] = npos != nullptr;
+            continue;
+          }
+        #endif
+
         // Add the command to the buffer_ring
         enqueue(serial_line_buffer[i], true, i);
       }
@@ -432,7 +624,7 @@ void Commands::get_serial() {
       }
       else if (serial_char == '\\') { // Handle escapes
         // if we have one more character, copy it over
-        if ((c = Com::serialRead(i)) >= 0 && !serial_comment_mode[i])
+        if ((c = serial_read(i)) >= 0 && !serial_comment_mode[i])
           serial_line_buffer[i][serial_count[i]++] = (char)c;
       }
       else { // its not a newline, carriage return or escape char
@@ -440,16 +632,88 @@ void Commands::get_serial() {
         else if (!serial_comment_mode[i]) serial_line_buffer[i][serial_count[i]++] = serial_char;
       }
     } // for NUM_SERIAL
+
+    #if NUM_SERIAL > 1
+      if (!received) break; // Only held back data is left
+    #endif
   }
 }
 
+#if ENABLED(SERIAL_BULK_READ)
+
+  int Commands::serial_read(const uint8_t index) {
+    if (bulk_index[index] >= bulk_count[index]) {
+      // Buffer used up, get all that the port has, up to a full packet
+      bulk_index[index] = 0;
+      bulk_count[index] = Com::serialReadBytes(index, bulk_buffer[index], SERIAL_BULK_READ_SIZE);
+      if (!bulk_count[index]) return -1;
+    }
+    return uint8_t(bulk_buffer[index][bulk_index[index]++]);
+  }
+
+  bool Commands::serial_data_available() {
+    LOOP_L_N(i, NUM_SERIAL) if (bulk_index[i] < bulk_count[i]) return true;
+    return Com::serialDataAvailable();
+  }
+
+#endif
+
 #if HAS_SD_SUPPORT
 
+  bool Commands::sd_file_finished() {
+
+    #if ENABLED(PRINT_TIME_ESTIMATION)
+      const bool estimate = planner.time_warp;
+    #endif
+
+    #if ENABLED(SD_JOB_QUEUE)
+      #if ENABLED(PRINT_TIME_ESTIMATION)
+        if (!estimate)
+      #endif
+          jobqueue.prepare_next();  // While the last moves run
+    #endif
+
+    card.printingHasFinished();
+
+    if (IS_SD_PRINTING()) return true;
+
+    #if ENABLED(PRINT_TIME_ESTIMATION)
+      if (estimate) return false;
+    #endif
+
+    SERIAL_EM(MSG_HOST_FILE_PRINTED);
+
+    #if ENABLED(SD_JOB_QUEUE)
+      if (jobqueue.print_finished()) return false;  // The next job starts, no wait for the user
+    #endif
+    #if ENABLED(PRINTER_EVENT_LEDS)
+      LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
+      leds.set_green();
+      #if HAS_RESUME_CONTINUE
+        inject_P(PSTR("M0 S"
+          #if HAS_LCD
+            "1800"
+          #else
+            "60"
+          #endif
+        ));
+      #else
+        HAL::delayMilliseconds(2000);
+        leds.set_off();
+      #endif
+    #endif // ENABLED(PRINTER_EVENT_LEDS)
+
+    return false;
+  }
+
   void Commands::get_sdcard() {
 
-    static char sd_line_buffer[MAX_CMD_SIZE];
-    static bool stop_buffering = false,
-                sd_comment_mode = false;
+    static bool stop_buffering = false;
+
+    #if DISABLED(SD_READ_LINES)
+      static char sd_line_buffer[MAX_CMD_SIZE];
+      static bool sd_comment_mode = false;
+    #endif
 
     if (!IS_SD_PRINTING()) return;
 
@@ -469,83 +733,264 @@ void Commands::get_serial() {
 
     if (buffer_ring.isEmpty()) stop_buffering = false;
 
-    uint16_t sd_count = 0;
-    bool card_eof = card.eof();
-    while (!buffer_ring.isFull() && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
-      char sd_char = (char)n;
-      card_eof = card.eof();
-      printer.max_inactivity_timer.start();
-      if (card_eof || n == -1
-          || sd_char == '\n'  || sd_char == '\r'
-          || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
-      ) {
-        if (card_eof) {
+    #if ENABLED(SD_READ_LINES)
 
-          card.printingHasFinished();
+      while (!buffer_ring.isFull() && !card.eof() && !stop_buffering) {
 
-          if (IS_SD_PRINTING())
-            sd_count = 0; // If a sub-file was printing, continue from call point
-          else {
-            SERIAL_EM(MSG_HOST_FILE_PRINTED);
-            #if ENABLED(PRINTER_EVENT_LEDS)
-              LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
-              leds.set_green();
-              #if HAS_RESUME_CONTINUE
-                inject_P(PSTR("M0 S"
-                  #if HAS_LCD
-                    "1800"
-                  #else
-                    "60"
-                  #endif
-                ));
-              #else
-                HAL::delayMilliseconds(2000);
-                leds.set_off();
-              #endif
-            #endif // ENABLED(PRINTER_EVENT_LEDS)
+        #if ENABLED(SD_COMPILED_JOB)
+          if (card.peek() == BINARY_GCODE_SYNC) {
+            card.get();
+            if (get_sd_compact()) continue;
+            break;
           }
-        }
-        else if (n == -1) {
+        #endif
+
+        char term;
+        const char * const line = card.get_line(term);
+        printer.max_inactivity_timer.start();
+
+        if (!line) {
           SERIAL_LM(ER, MSG_HOST_SD_ERR_READ);
+          break;
         }
-        if (sd_char == '#') stop_buffering = true;
 
-        sd_comment_mode = false; // for new command
+        if (term == '#') stop_buffering = true;
+
+        if (card.eof() && sd_file_finished()) continue; // If a sub-file was printing, continue from call point
 
         // Skip empty lines and comments
-        if (!sd_count) continue;
+        if (!*line) continue;
 
-        sd_line_buffer[sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
+        #if ENABLED(LASER_RASTER_BINARY)
+          const int16_t pixels = raster_frame_size(line);
+          if (pixels >= 0 && !get_sd_raster(pixels)) continue;
+        #endif
 
-        enqueue(sd_line_buffer, false, -2); // Port -2 for SD non answer and no send ok.
+        enqueue(line, false, -2); // Port -2 for SD non answer and no send ok.
 
         #if HAS_SD_RESTART
           restart.cmd_sdpos = card.getIndex();
         #endif
+      }
+
+    #else
+
+      uint16_t sd_count = 0;
+      bool card_eof = card.eof();
+      while (!buffer_ring.isFull() && !card_eof && !stop_buffering) {
+        const int16_t n = card.get();
+        char sd_char = (char)n;
+        card_eof = card.eof();
+        printer.max_inactivity_timer.start();
+
+        #if ENABLED(SD_COMPILED_JOB)
+          if (n == BINARY_GCODE_SYNC && !sd_count && !sd_comment_mode) {
+            if (!get_sd_compact()) break;
+            card_eof = card.eof();
+            continue;
+          }
+        #endif
+        if (card_eof || n == -1
+            || sd_char == '\n'  || sd_char == '\r'
+            || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
+        ) {
+          if (card_eof) {
+            if (sd_file_finished()) sd_count = 0; // If a sub-file was printing, continue from call point
+          }
+          else if (n == -1) {
+            SERIAL_LM(ER, MSG_HOST_SD_ERR_READ);
+          }
+          if (sd_char == '#') stop_buffering = true;
+
+          sd_comment_mode = false; // for new command
+
+          // Skip empty lines and comments
+          if (!sd_count) continue;
+
+          sd_line_buffer[sd_count] = '\0'; // terminate string
+          sd_count = 0; // clear sd line buffer
+
+          #if ENABLED(LASER_RASTER_BINARY)
+            const int16_t pixels = raster_frame_size(sd_line_buffer);
+            if (pixels >= 0 && (card_eof || !get_sd_raster(pixels))) continue;
+            card_eof = card.eof();
+          #endif
+
+          enqueue(sd_line_buffer, false, -2); // Port -2 for SD non answer and no send ok.
 
+          #if HAS_SD_RESTART
+            restart.cmd_sdpos = card.getIndex();
+          #endif
+
+        }
+        else if (sd_count >= MAX_CMD_SIZE - 1) {
+          /**
+           * Keep fetching, but ignore normal characters beyond the max length
+           * The command will be injected when EOL is reached
+           */
+        }
+        else {
+          if (sd_char == ';') sd_comment_mode = true;
+          if (!sd_comment_mode) sd_line_buffer[sd_count++] = sd_char;
+        }
       }
-      else if (sd_count >= MAX_CMD_SIZE - 1) {
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
+
+    #endif
+
+    printer.progress = card.percentDone();
+  }
+
+#endif // HAS_SD_SUPPORT
+
+#if ENABLED(SD_COMPILED_JOB)
+
+  /**
+   * Queue a compact record of a compiled job, after its sync byte.
+   * Return false on a read error.
+   */
+  bool Commands::get_sd_compact() {
+    char cmd[MAX_CMD_SIZE];
+    printer.max_inactivity_timer.start();
+    if (!card.get_compact(cmd)) {
+      SERIAL_LM(ER, MSG_HOST_SD_ERR_READ);
+      return false;
+    }
+    enqueue_compact(cmd, false, -2); // Port -2 for SD non answer and no send ok.
+    #if HAS_SD_RESTART
+      restart.cmd_sdpos = card.getIndex() + 1;
+    #endif
+    return true;
+  }
+
+#endif
+
+#if ENABLED(LASER_RASTER_BINARY)
+
+  int16_t Commands::raster_frame_size(const char * command) {
+    const char *p = command;
+    if (*p == 'N') {
+      while (*p && *p != ' ') p++;
+      while (*p == ' ') p++;
+    }
+    if (p[0] != 'G' || p[1] != '7' || NUMERIC(p[2])) return -1;
+    // Up to the checksum, the comment or the base64 data
+    for (p += 2; *p && *p != '*' && *p != ';' && *p != 'D'; p++)
+      if (*p == 'B' && NUMERIC(p[1])) return NOMORE(atoi(p + 1), 0x7FFD);
+    return -1;
+  }
+
+  #if HAS_SD_SUPPORT
+
+    /**
+     * The raw raster line after a G7 B line of the printed file
+     * Return false, with the line not queued, for a read or checksum error
+     */
+    bool Commands::get_sd_raster(const uint16_t pixels) {
+      uint8_t * const slot = laser.raster_stream_slot();
+      uint16_t crc = 0xFFFF;
+      for (uint16_t n = 0; n < pixels + 2; n++) {
+        const int16_t c = card.get();
+        if (c < 0) {
+          SERIAL_LM(ER, MSG_HOST_SD_ERR_READ);
+          return false;
+        }
+        const uint8_t b = c;
+        if (n < pixels) {
+          if (n < LASER_MAX_RASTER_LINE) slot[n] = b;
+          crc16(&crc, &b, 1);
+        }
+        else
+          crc ^= n == pixels ? b : uint16_t(b) << 8;
       }
-      else {
-        if (sd_char == ';') sd_comment_mode = true;
-        if (!sd_comment_mode) sd_line_buffer[sd_count++] = sd_char;
+      if (crc) {
+        SERIAL_LM(ER, "Raster line checksum mismatch on SD, line skipped");
+        return false;
       }
+      laser.raster_stream_push(MIN(pixels, uint16_t(LASER_MAX_RASTER_LINE)));
+      return true;
     }
 
-    printer.progress = card.percentDone();
+  #endif
+
+#endif
+
+#if ENABLED(HOST_BUSY_REPORTS)
+
+  /**
+   * While a command of the buffer runs, G28 G29 or any other that waits for the
+   * moves, the host keeps asking for temperatures and status. Run those reports
+   * now, on the parser of the running command, that is restored after.
+   * Return true if the line was a report and is done.
+   */
+  bool Commands::busy_report(char * command, const int8_t port) {
+
+    // Skip the line number
+    char *p = command;
+    if (*p == 'N') {
+      while (*p && *p != ' ') p++;
+      while (*p == ' ') p++;
+    }
+
+    if (*p != 'M') return false;
+
+    switch (strtol(p + 1, nullptr, 10)) {
+      #if ENABLED(CODE_M27)
+        case 27:
+      #endif
+      #if ENABLED(CODE_M31)
+        case 31:
+      #endif
+      #if ENABLED(CODE_M119)
+        case 119:
+      #endif
+      #if ENABLED(CODE_M154)
+        case 154:
+      #endif
+      #if ENABLED(CODE_M155)
+        case 155:
+      #endif
+      case 105: break;
+      default: return false;
+    }
+
+    const int8_t saved_port = Com::serial_port_index;
+    char * const saved_cmd = parser.command_ptr;      // Save the parser state
+
+    SERIAL_PORT(port);
+    parser.parse(command);
+    process_parsed(false);
+    if (parser.codenum != 105) {                      // M105 sends its own "ok"
+      SERIAL_STR(OK);
+      SERIAL_EOL();
+    }
+
+    parser.parse(saved_cmd);                          // Restore the parser state
+    SERIAL_PORT(saved_port);
+    return true;
   }
 
-#endif // HAS_SD_SUPPORT
+#endif
 
 void Commands::process_next() {
 
-  gcode_t cmd = buffer_ring.peek();
+  // Parse in place, the slot stays owned by the queue until advance_queue() discards it
+  gcode_t &cmd = buffer_ring.peek();
+
+  #if HAS_COMPACT_GCODE
+    if (BinaryGcode::is_compact(cmd.gcode)) {
+      parser.parse_binary(cmd.gcode);
+      #if ENABLED(CRASH_RECORD)
+        crashRecord.command(parser.command_ptr);
+      #endif
+      if (printer.debugEcho()) {
+        SERIAL_PORT(cmd.s_port);
+        SERIAL_LT(ECHO, parser.command_ptr);
+      }
+      printer.reset_move_timer(); // Keep steppers powered
+      process_parsed();
+      return;
+    }
+  #endif
 
   if (printer.debugEcho()) {
     SERIAL_PORT(cmd.s_port);
@@ -554,16 +999,28 @@ void Commands::process_next() {
 
   printer.reset_move_timer(); // Keep steppers powered
 
+  #if ENABLED(CRASH_RECORD)
+    crashRecord.command(cmd.gcode);
+  #endif
+
   // Parse the next command in the buffer_ring
   parser.parse(cmd.gcode);
+
+  #if ENABLED(HOST_BUSY_REPORTS)
+    processing = true;
+  #endif
+
   process_parsed();
 
+  #if ENABLED(HOST_BUSY_REPORTS)
+    processing = false;
+  #endif
+
 }
 
 void Commands::unknown_error() {
   #if NUM_SERIAL > 1
-    gcode_t tmp = buffer_ring.peek();
-    SERIAL_PORT(tmp.s_port);
+    SERIAL_PORT(buffer_ring.peek().s_port);
   #endif
   SERIAL_SMV(ECHO, MSG_HOST_UNKNOWN_COMMAND, parser.command_ptr);
   SERIAL_CHR('"');
@@ -576,12 +1033,55 @@ void Commands::gcode_line_error(PGM_P const err, const int8_t port) {
   SERIAL_STR(ER);
   SERIAL_STR(err);
   SERIAL_EV(gcode_last_N);
-  while (Com::serialRead(port) != -1);
-  flush_and_request_resend();
+  #if ENABLED(SERIAL_RESEND_WINDOW)
+    // The lines behind this one are kept, resend_skip_line() drops them until the host is back here
+    resend_requested = true;
+    SERIAL_LV(RESEND, gcode_last_N + 1);
+    ok_to_send();
+  #else
+    while (serial_read(port) != -1);
+    flush_and_request_resend();
+  #endif
   serial_count[port] = 0;
   SERIAL_PORT(-1);
 }
 
+#if ENABLED(SERIAL_RESEND_WINDOW)
+
+  /**
+   * Check a line out of sequence against the resend window:
+   *  - After a resend request, the lines the host had already sent past the
+   *    bad one will come again, so they are dropped without a new request.
+   *  - A line accepted in the last SERIAL_RESEND_WINDOW lines, repeated by the
+   *    host and with the same checksum, is acknowledged and not queued again.
+   * Return true if the line was dropped.
+   */
+  bool Commands::resend_skip_line(const char * command, const int8_t port) {
+
+    if (resend_requested && gcode_N > gcode_last_N + 1) {
+      // Nothing, the host is sending it again
+    }
+    else if (gcode_N <= gcode_last_N && gcode_last_N - gcode_N < SERIAL_RESEND_WINDOW) {
+      const char * const apos = strrchr(command, '*');
+      if (!apos) return false;
+      uint8_t checksum = 0, count = uint8_t(apos - command);
+      while (count) checksum ^= command[--count];
+      if (strtol(apos + 1, nullptr, 10) != checksum || resend_checksum[gcode_N & (SERIAL_RESEND_WINDOW - 1)] != checksum)
+        return false;
+    }
+    else
+      return false;
+
+    // Keep the ok count of the host
+    SERIAL_PORT(port);
+    SERIAL_STR(OK);
+    SERIAL_EOL();
+    SERIAL_PORT(-1);
+    return true;
+  }
+
+#endif
+
 bool Commands::enqueue_one(const char * cmd) {
 
   if (*cmd == 0 || *cmd == '\n' || *cmd == '\r')
@@ -598,18 +1098,108 @@ bool Commands::enqueue_one(const char * cmd) {
 }
 
 bool Commands::enqueue(const char * cmd, bool say_ok/*=false*/, int8_t port/*=-2*/) {
-  if (*cmd == ';' || buffer_ring.isFull()) return false;
-  gcode_t temp_cmd;
-  strcpy(temp_cmd.gcode, cmd);
-  temp_cmd.s_port = port;
-  temp_cmd.send_ok = say_ok;
+  if (*cmd == ';') return false;
+  gcode_t * const slot = buffer_ring.reserve();
+  if (!slot) return false;
+  #if ENABLED(GCODE_PARSE_ON_ENQUEUE)
+    // Motion commands are parsed here, the rest is kept as text
+    if (
+      #if HAS_SD_SUPPORT
+        card.isSaving() ||
+      #endif
+      !BinaryGcode::compile(cmd, slot->gcode)
+    )
+  #endif
+  strcpy(slot->gcode, cmd);
+  slot->s_port = port;
+  slot->send_ok = say_ok;
   #if HAS_SD_RESTART
     restart.set_sdpos();
   #endif
-  buffer_ring.enqueue(temp_cmd);
+  buffer_ring.commit();
   return true;
 }
 
+#if HAS_COMPACT_GCODE
+
+  bool Commands::enqueue_compact(const char * cmd, const bool say_ok, const int8_t port) {
+    gcode_t * const slot = buffer_ring.reserve();
+    if (!slot) return false;
+    memcpy(slot->gcode, cmd, BinaryGcode::compact_size(uint8_t(cmd[2])));
+    slot->s_port = port;
+    slot->send_ok = say_ok;
+    #if HAS_SD_RESTART
+      restart.set_sdpos();
+    #endif
+    buffer_ring.commit();
+    return true;
+  }
+
+#endif
+
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+
+  bool Commands::binary_frame(uint8_t * const frame, const int8_t port) {
+
+    // No slot for the frame, the host sends it again, N is not taken
+    if (buffer_ring.isFull()) {
+      gcode_line_error(PSTR(MSG_HOST_ERR_BINARY_FULL), port);
+      return false;
+    }
+
+    const uint8_t mask  = frame[BINARY_GCODE_HEADER - 1],
+                  size  = BinaryGcode::frame_size(mask);
+
+    uint16_t crc;
+    memcpy(&crc, &frame[size - 2], sizeof(crc));
+    memcpy(&gcode_N, &frame[1], sizeof(int32_t));
+
+    if (BinaryGcode::crc16(&frame[1], size - 3) != crc) {
+      gcode_line_error(PSTR(MSG_HOST_ERR_CHECKSUM_MISMATCH), port);
+      return false;
+    }
+
+    if (gcode_N != gcode_last_N + 1) {
+      gcode_line_error(PSTR(MSG_HOST_ERR_LINE_NO), port);
+      return false;
+    }
+
+    // The compact format has only G0 to G3, never dispatch another code
+    if (frame[BINARY_GCODE_HEADER - 2] > BINARY_GCODE_MAX_CODE) {
+      gcode_line_error(PSTR(MSG_HOST_ERR_BINARY_CODE), port);
+      return false;
+    }
+
+    gcode_last_N = gcode_N;
+
+    // Movement commands alert when stopped
+    if (printer.isStopped()) {
+      SERIAL_LM(ER, MSG_HOST_ERR_STOPPED);
+      LCD_MESSAGEPGM(MSG_STOPPED);
+    }
+
+    #if HAS_SD_SUPPORT
+      // Binary commands can't be written to a file
+      if (card.isSaving()) {
+        SERIAL_PORT(port);
+        SERIAL_LM(ER, "Binary G-code is not allowed while writing to SD");
+        SERIAL_PORT(-1);
+        return true;
+      }
+    #endif
+
+    // Queue as sync, code, mask, values: the sync goes over the last byte of N
+    frame[BINARY_GCODE_HEADER - 3] = BINARY_GCODE_SYNC;
+    if (!enqueue_compact((const char*)&frame[BINARY_GCODE_HEADER - 3], true, port)) {
+      gcode_last_N--;
+      gcode_line_error(PSTR(MSG_HOST_ERR_BINARY_FULL), port);
+      return false;
+    }
+    return true;
+  }
+
+#endif // ENABLED(BINARY_GCODE_PROTOCOL)
+
 bool Commands::process_injected() {
 
   if (injected_commands_P == nullptr) return false;
@@ -645,10 +1235,39 @@ bool Commands::process_injected() {
   #define EXECUTE_G0_G1(NUM) gcode_G0_G1()
 #endif
 
+#if ENABLED(HEAT_IN_BACKGROUND)
+
+  bool Commands::needs_temperature() {
+    switch (parser.command_letter) {
+      case 'G': switch (parser.codenum) {
+        case 0: case 1: case 2: case 3: case 5:
+          return parser.seen('E');                      // Extruding moves only, travel goes on
+        case 10: case 11:
+          return true;                                  // Retract and recover
+        default: return false;
+      }
+      case 'M': switch (parser.codenum) {
+        case 600: case 701: case 702:
+          return true;                                  // Filament change, load and unload
+        default: return false;
+      }
+      case 'T':
+        return true;                                    // A tool change can purge
+      default: return false;
+    }
+  }
+
+#endif
+
 void Commands::process_parsed(const bool say_ok/*=true*/) {
 
   PRINTER_KEEPALIVE(InHandler);
 
+  #if ENABLED(HEAT_IN_BACKGROUND)
+    // The waits of M109-M190-M191 are done here, before the first command needs them
+    if (tempManager.deferred_waits && needs_temperature()) tempManager.wait_deferred();
+  #endif
+
   #if ENABLED(FASTER_GCODE_EXECUTE) || ENABLED(ARDUINO_ARCH_SAM)
 
     // Handle a known G, M, or T
@@ -656,46 +1275,31 @@ void Commands::process_parsed(const bool say_ok/*=true*/) {
 
       case 'G': {
         const uint16_t code_num = parser.codenum;
-        G_CODE_TYPE start   = 0,
-                    middle  = 0,
-                    end     = COUNT(GCode_Table) - 1;
 
         if (code_num <= 1) { // Execute directly the most common Gcodes
           EXECUTE_G0_G1(code_num);
         }
-        else if (WITHIN(code_num, GCode_Table[start].code, GCode_Table[end].code)) {
-          while (start <= end) {
-            middle = (start + end) >> 1;
-            if (GCode_Table[middle].code == code_num) {
-              GCode_Table[middle].command(); // Command found, execute it
-              break;
-            }
-            else if (GCode_Table[middle].code < code_num)
-              start = middle + 1;
-            else
-              end = middle - 1;
-          }
+        else if (code_num < GCODE_INDEX_SIZE) {
+          const code_index_t idx = CODE_INDEX_READ(GCode_Index, code_num);
+          if (idx != CODE_INDEX_NONE) GCode_Table[idx].command(); // Command found, execute it
         }
       }
       break;
 
       case 'M': {
         const uint16_t code_num = parser.codenum;
-        M_CODE_TYPE start   = 0,
-                    middle  = 0,
-                    end     = COUNT(MCode_Table) - 1;
-
-        if (WITHIN(code_num, MCode_Table[start].code, MCode_Table[end].code)) {
-          while (start <= end) {
-            middle = (start + end) >> 1;
-            if (MCode_Table[middle].code == code_num) {
-              MCode_Table[middle].command(); // Command found, execute it
+
+        if (code_num < MCODE_INDEX_SIZE) {
+          const code_index_t idx = CODE_INDEX_READ(MCode_Index, code_num);
+          if (idx != CODE_INDEX_NONE) MCode_Table[idx].command(); // Command found, execute it
+        }
+        else {
+          // Few codes over the index, search them from the end of the table
+          for (M_CODE_TYPE i = COUNT(MCode_Table); i-- && MCode_Table[i].code >= MCODE_INDEX_SIZE;) {
+            if (MCode_Table[i].code == code_num) {
+              MCode_Table[i].command(); // Command found, execute it
               break;
             }
-            else if (MCode_Table[middle].code < code_num)
-              start = middle + 1;
-            else
-              end = middle - 1;
           }
         }
 
@@ -27,6 +27,7 @@
  * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
  */
 
+#include "binary_gcode.h"
 #include "parser.h"
 
 struct gcode_t {
@@ -47,14 +48,18 @@ class Commands {
 
     /**
      * GCode Command Buffer Ring
-     * A simple ring buffer of BUFSIZE command strings.
+     * A single producer single consumer ring of BUFSIZE command strings.
      *
      * Commands are copied into this buffer by the command injectors
      * (immediate, serial, sd card) and they are processed sequentially by
      * the main loop. The process_next function parses the next
      * command and hands off execution to individual handler functions.
      */
-    static Circular_Queue<gcode_t, BUFSIZE> buffer_ring;
+    #if ENABLED(BUFFER_ARENA)
+      static SPSC_Queue<gcode_t, 0> buffer_ring;        // Slots in the buffer arena, set at boot
+    #else
+      static SPSC_Queue<gcode_t, BUFSIZE> buffer_ring;
+    #endif
 
     /**
      * GCode line number handling. Hosts may opt to include line numbers when
@@ -69,6 +74,25 @@ class Commands {
 
     static int serial_count[NUM_SERIAL];
 
+    #if ENABLED(SERIAL_RESEND_WINDOW)
+      static bool     resend_requested;                       // A Resend was sent, the host is rewinding
+      static uint8_t  resend_checksum[SERIAL_RESEND_WINDOW];  // Checksums of the last accepted lines
+    #endif
+
+    #if ENABLED(SERIAL_BULK_READ)
+      static char     bulk_buffer[NUM_SERIAL][SERIAL_BULK_READ_SIZE];
+      static uint8_t  bulk_index[NUM_SERIAL],
+                      bulk_count[NUM_SERIAL];
+    #endif
+
+    #if ENABLED(HOST_OK_COALESCE)
+      static uint8_t ok_pending[NUM_SERIAL];
+    #endif
+
+    #if ENABLED(HOST_BUSY_REPORTS)
+      static bool processing;                                 // A command of the buffer is running
+    #endif
+
     /**
      * Next Injected Command pointer. Nullptr if no commands are being injected.
      * Used by MK4duo internally to ensure that commands initiated from within
@@ -92,6 +116,23 @@ class Commands {
      */
     static void get_available();
 
+    /**
+     * Is there input that get_available() can take now, from the serial
+     * or from the SD? With no interrupt for these the CPU must not sleep.
+     */
+    #if ENABLED(PLANNER_SLEEP_WAIT)
+      static bool input_pending();
+    #endif
+
+    /**
+     * Send the "ok" replies held back by ok_to_send() in one burst,
+     * only if the TX ring can take them without waiting for the UART,
+     * or all of them with wait.
+     */
+    #if ENABLED(HOST_OK_COALESCE)
+      static void flush_ok(const bool wait=false);
+    #endif
+
     /**
      * Get the next command in the buffer_ring, optionally log it to SD, then dispatch it
      */
@@ -119,6 +160,12 @@ class Commands {
      */
     static void enqueue_now_P(PGM_P const pgcode);
 
+    /**
+     * Enqueue a line of a job streamed by an other source, with no ok.
+     * False with the queue full or for a comment.
+     */
+    static inline bool enqueue_job_line(const char * cmd) { return enqueue(cmd); }
+
     /**
      * Run a series of commands, bypassing the command queue to allow
      * G-code "macros" to be called from within other G-code handlers.
@@ -166,6 +213,8 @@ class Commands {
      *   N<int>  Line number of the command, if any
      *   P<int>  Planner space remaining
      *   B<int>  Block queue space remaining
+     *
+     * With HOST_OK_COALESCE the reply is only counted here and sent by flush_ok()
      */
     static void ok_to_send();
 
@@ -176,6 +225,18 @@ class Commands {
      */
     static void get_serial();
 
+    /**
+     * Serial input for get_serial(). With SERIAL_BULK_READ whole packets
+     * are read from the port and handed out one char at a time.
+     */
+    #if ENABLED(SERIAL_BULK_READ)
+      static int serial_read(const uint8_t index);
+      static bool serial_data_available();
+    #else
+      FORCE_INLINE static int serial_read(const uint8_t index) { return Com::serialRead(index); }
+      FORCE_INLINE static bool serial_data_available() { return Com::serialDataAvailable(); }
+    #endif
+
     /**
      * Get commands from the SD Card until the command buffer is full
      * or until the end of the file is reached. The special character '#'
@@ -183,6 +244,16 @@ class Commands {
      */
     #if HAS_SD_SUPPORT
       static void get_sdcard();
+
+      /**
+       * The end of the printed file was read. Close it and report the print done,
+       * return true if a sub-file was printing, and the calling file goes on.
+       */
+      static bool sd_file_finished();
+
+      #if ENABLED(SD_COMPILED_JOB)
+        static bool get_sd_compact();
+      #endif
     #endif
 
     /**
@@ -195,6 +266,14 @@ class Commands {
 
     static void gcode_line_error(PGM_P const err, const int8_t tmp_port);
 
+    #if ENABLED(SERIAL_RESEND_WINDOW)
+      static bool resend_skip_line(const char * command, const int8_t port);
+    #endif
+
+    #if ENABLED(HOST_BUSY_REPORTS)
+      static bool busy_report(char * command, const int8_t port);
+    #endif
+
     /**
      * Enqueue with Serial Echo
      * Return true on success
@@ -208,6 +287,33 @@ class Commands {
      */
     static bool enqueue(const char * cmd, bool say_ok=false, int8_t port=-2);
 
+    #if HAS_COMPACT_GCODE
+      /**
+       * Copy a compact command into the main command buffer.
+       * Return false for a full buffer.
+       */
+      static bool enqueue_compact(const char * cmd, const bool say_ok, const int8_t port);
+    #endif
+
+    #if ENABLED(LASER_RASTER_BINARY)
+      /**
+       * Pixels of the raw raster line after a G7 B line, -1 for any other line
+       */
+      static int16_t raster_frame_size(const char * command);
+
+      #if HAS_SD_SUPPORT
+        static bool get_sd_raster(const uint16_t pixels);
+      #endif
+    #endif
+
+    #if ENABLED(BINARY_GCODE_PROTOCOL)
+      /**
+       * Check a complete binary frame and queue it as a binary command
+       * Return false if the frame was rejected and a resend requested
+       */
+      static bool binary_frame(uint8_t * const frame, const int8_t port);
+    #endif
+
     /**
      * Process the next "immediate" command
      */
@@ -218,6 +324,13 @@ class Commands {
      */
     static void process_parsed(const bool say_ok=true);
 
+    #if ENABLED(HEAT_IN_BACKGROUND)
+      /**
+       * The parsed command needs the temperatures of M109-M190-M191
+       */
+      static bool needs_temperature();
+    #endif
+
     /**
      * Search M29 command
      */
@@ -90,6 +90,9 @@
  *
  *  Z  Supply an additional Z probe offset
  *
+ *  U  With ABL_PRINT_AREA probe only the grid points under the print area,
+ *     L R F B set the area. Without them the first layer of the SD print is scanned.
+ *
  * Extra parameters with PROBE_MANUALLY:
  *
  *  To do manual probing simply repeat G29 until the procedure is complete.
@@ -114,6 +117,8 @@
  *     Include "E" to engage/disengage the Z probe for each sample.
  *     There's no extra effect if you have a fixed Z probe.
  *
+ *  K  With PROBE_FLY, K0 for the normal probing of each point
+ *
  */
 inline void gcode_G29() {
 
@@ -189,6 +194,11 @@ inline void gcode_G29() {
                         probe_position_rb,
                         gridSpacing = { 0, 0 };
 
+    #if ENABLED(ABL_PRINT_AREA)
+      xy_int8_t area_min = { 0, 0 },                                    // Grid points probed
+                area_max = { GRID_MAX_POINTS_X - 1, GRID_MAX_POINTS_Y - 1 };
+    #endif
+
     #if ENABLED(AUTO_BED_LEVELING_LINEAR)
       ABL_VAR bool        do_topography_map;
       ABL_VAR xy_uint8_t  abl_grid_points;
@@ -283,9 +293,7 @@ inline void gcode_G29() {
         if (WITHIN(i, 0, GRID_MAX_POINTS_X - 1) && WITHIN(j, 0, GRID_MAX_POINTS_Y)) {
           bedlevel.set_bed_leveling_enabled(false);
           abl.z_values[i][j] = rz;
-          #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-            abl.virt_interpolate();
-          #endif
+          abl.refresh_bed_level();
           bedlevel.restore_bed_leveling_state();
           mechanics.report_position();
         }
@@ -353,13 +361,20 @@ inline void gcode_G29() {
                     y_min = probe.min_y(), y_max = probe.max_y();
       #endif
 
+      // With U the limits are the print area, the grid stays the full one
+      #if ENABLED(ABL_PRINT_AREA)
+        const bool print_area = parser.boolval('U');
+      #else
+        constexpr bool print_area = false;
+      #endif
+
       probe_position_lf.set(
-        parser.seenval('L') ? NATIVE_X_POSITION(parser.value_linear_units()) : LEFT_PROBE_BED_POSITION,
-        parser.seenval('F') ? NATIVE_Y_POSITION(parser.value_linear_units()) : FRONT_PROBE_BED_POSITION
+        !print_area && parser.seenval('L') ? NATIVE_X_POSITION(parser.value_linear_units()) : LEFT_PROBE_BED_POSITION,
+        !print_area && parser.seenval('F') ? NATIVE_Y_POSITION(parser.value_linear_units()) : FRONT_PROBE_BED_POSITION
       );
       probe_position_rb.set(
-        parser.seenval('R') ? NATIVE_X_POSITION(parser.value_linear_units()) : RIGHT_PROBE_BED_POSITION,
-        parser.seenval('B') ? NATIVE_Y_POSITION(parser.value_linear_units()) : BACK_PROBE_BED_POSITION
+        !print_area && parser.seenval('R') ? NATIVE_X_POSITION(parser.value_linear_units()) : RIGHT_PROBE_BED_POSITION,
+        !print_area && parser.seenval('B') ? NATIVE_Y_POSITION(parser.value_linear_units()) : BACK_PROBE_BED_POSITION
       );
 
       if (
@@ -381,6 +396,41 @@ inline void gcode_G29() {
       gridSpacing.set((probe_position_rb.x - probe_position_lf.x) / (abl_grid_points.x - 1),
                       (probe_position_rb.y - probe_position_lf.y) / (abl_grid_points.y - 1));
 
+      #if ENABLED(ABL_PRINT_AREA)
+        if (print_area) {
+          xy_pos_t area_lf, area_rb;
+          if (parser.seen('L') && parser.seen('R') && parser.seen('F') && parser.seen('B')) {
+            area_lf.set(parser.linearval('L'), parser.linearval('F'));
+            area_rb.set(parser.linearval('R'), parser.linearval('B'));
+          }
+          else if (!card.first_layer_area(area_lf, area_rb)) {
+            SERIAL_EM("? (U) needs L,R,F,B or a first layer in the SD print.");
+            return;
+          }
+
+          // The grid cells under the area, so all their corners get probed
+          area_min.set(
+            constrain(FLOOR((NATIVE_X_POSITION(area_lf.x) - probe_position_lf.x) / gridSpacing.x), 0, GRID_MAX_POINTS_X - 1),
+            constrain(FLOOR((NATIVE_Y_POSITION(area_lf.y) - probe_position_lf.y) / gridSpacing.y), 0, GRID_MAX_POINTS_Y - 1)
+          );
+          area_max.set(
+            constrain(CEIL((NATIVE_X_POSITION(area_rb.x) - probe_position_lf.x) / gridSpacing.x), 0, GRID_MAX_POINTS_X - 1),
+            constrain(CEIL((NATIVE_Y_POSITION(area_rb.y) - probe_position_lf.y) / gridSpacing.y), 0, GRID_MAX_POINTS_Y - 1)
+          );
+
+          if (verbose_level > 0) {
+            SERIAL_MV("Print area X", area_lf.x, 1);
+            SERIAL_MV(":", area_rb.x, 1);
+            SERIAL_MV(" Y", area_lf.y, 1);
+            SERIAL_MV(":", area_rb.y, 1);
+            SERIAL_MV(" points X", int(area_min.x));
+            SERIAL_MV("-", int(area_max.x));
+            SERIAL_MV(" Y", int(area_min.y));
+            SERIAL_EMV("-", int(area_max.y));
+          }
+        }
+      #endif
+
     #endif // ABL_GRID
 
     if (verbose_level > 0) {
@@ -594,7 +644,7 @@ inline void gcode_G29() {
         if (!dryrun) {
           vector_3 planeNormal = vector_3::cross(points[0] - points[1], points[2] - points[1]).get_normal();
           if (planeNormal.z < 0) planeNormal *= -1;
-          bedlevel.matrix = matrix_3x3::create_look_at(planeNormal);
+          bedlevel.set_matrix(matrix_3x3::create_look_at(planeNormal));
 
           // Can't re-enable (on error) until the new grid is written
           bedlevel.flag.leveling_previous = false;
@@ -606,7 +656,11 @@ inline void gcode_G29() {
 
   #else // !PROBE_MANUALLY
   {
-    const ProbePtRaiseEnum raise_after = parser.boolval('E') ? PROBE_PT_STOW : PROBE_PT_RAISE;
+    const ProbePtRaiseEnum raise_after = parser.boolval('E') ? PROBE_PT_STOW
+      #if ENABLED(PROBE_FLY)
+        : parser.boolval('K', true) ? PROBE_PT_FLY
+      #endif
+      : PROBE_PT_RAISE;
 
     measured_z = 0.0;
 
@@ -653,6 +707,14 @@ inline void gcode_G29() {
             if (!mechanics.position_is_reachable_by_probe(probePos)) continue;
           #endif
 
+          #if ENABLED(ABL_PRINT_AREA)
+            // Out of the print area, filled in at the end
+            if (!WITHIN(meshCount.x, area_min.x, area_max.x) || !WITHIN(meshCount.y, area_min.y, area_max.y)) {
+              abl.z_values[meshCount.x][meshCount.y] = NAN;
+              continue;
+            }
+          #endif
+
           if (verbose_level) {
             SERIAL_MV("Probing mesh point ", int(pt_index));
             SERIAL_MV("/", int(GRID_MAX_POINTS));
@@ -710,7 +772,7 @@ inline void gcode_G29() {
       if (!dryrun && !isnan(measured_z)) {
         vector_3 planeNormal = vector_3::cross(points[0] - points[1], points[2] - points[1]).get_normal();
         if (planeNormal.z < 0) planeNormal *= -1;
-        bedlevel.matrix = matrix_3x3::create_look_at(planeNormal);
+        bedlevel.set_matrix(matrix_3x3::create_look_at(planeNormal));
 
         // Can't re-enable (on error) until the new grid is written
         bedlevel.flag.leveling_previous = false;
@@ -749,6 +811,15 @@ inline void gcode_G29() {
   if (!isnan(measured_z)) {
     #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
 
+      #if ENABLED(ABL_PRINT_AREA)
+        // Continue the edge of the print area, the extrapolation walks out of the
+        // grid center and would build on unprobed points with an area off center
+        if (!dryrun)
+          LOOP_L_N(x, GRID_MAX_POINTS_X) LOOP_L_N(y, GRID_MAX_POINTS_Y)
+            if (isnan(float(abl.z_values[x][y])))
+              abl.z_values[x][y] = abl.z_values[constrain(x, area_min.x, area_max.x)][constrain(y, area_min.y, area_max.y)];
+      #endif
+
       if (!dryrun) abl.extrapolate_unprobed_bed_level();
       abl.print_bilinear_leveling_grid();
 
@@ -790,9 +861,9 @@ inline void gcode_G29() {
 
       // Create the matrix but don't correct the position yet
       if (!dryrun) {
-        bedlevel.matrix = matrix_3x3::create_look_at(
+        bedlevel.set_matrix(matrix_3x3::create_look_at(
           vector_3(-plane_equation_coefficients.a, -plane_equation_coefficients.b, 1) // We can eleminate the '-' here and up above
-        );
+        ));
       }
 
       // Show the Topography map if enabled
@@ -748,8 +748,12 @@ inline void gcode_G26() {
 
         recover_filament(mechanics.destination);
 
-        REMEMBER(fr, mechanics.feedrate_mm_s, PLANNER_XY_FEEDRATE() / 10.0);
-        plan_arc(endpoint, arc_offset, false);  // Draw a counter-clockwise arc
+        // Draw a counter-clockwise arc at the feedrate of the lines, the segments
+        // stream into the planner as the chord tolerance sizes them
+        REMEMBER(fr, mechanics.feedrate_mm_s, G26_XY_FEEDRATE);
+        REMEMBER(pct, mechanics.feedrate_percentage, 100);
+        plan_arc(endpoint, arc_offset, false);
+        RESTORE(pct);
         RESTORE(fr);
         mechanics.destination = mechanics.position;
 
@@ -797,7 +801,6 @@ inline void gcode_G26() {
           #endif
 
           print_line_from_here_to_there(p, q);
-          SERIAL_FLUSH();   // Prevent host M105 buffer overrun.
         }
 
       #endif // !ARC_SUPPORT
@@ -822,6 +825,9 @@ LEAVE:
 
   move_to(mechanics.destination, 0); // Move back to the starting position
 
+  // The pattern was only queued, wait for it before giving back the LCD and the heaters
+  planner.synchronize();
+
   #if HAS_LCD_MENU
     lcdui.release();   // Give back control of the LCD Panel!
   #endif
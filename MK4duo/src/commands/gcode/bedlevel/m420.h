@@ -150,8 +150,8 @@ inline void gcode_M420() {
             for (uint8_t x = GRID_MAX_POINTS_X; x--;)
               for (uint8_t y = GRID_MAX_POINTS_Y; y--;)
                 Z_VALUES(x, y) -= zmean;
-            #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-              abl.virt_interpolate();
+            #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+              abl.refresh_bed_level();
             #endif
           }
 
@@ -56,7 +56,7 @@ inline void gcode_M421() {
   else if (!WITHIN(ij.x, 0, GRID_MAX_POINTS_X - 1) || !WITHIN(ij.y, 0, GRID_MAX_POINTS_Y - 1))
     SERIAL_LM(ER, MSG_HOST_ERR_MESH_XY);
   else
-    ubl.z_values[ij.x][ij.y] = hasN ? NAN : parser.value_linear_units() + (hasQ ? ubl.z_values[ij.x][ij.y] : 0);
+    ubl.z_values[ij.x][ij.y] = hasN ? NAN : parser.value_linear_units() + (hasQ ? float(ubl.z_values[ij.x][ij.y]) : 0);
 }
 
 #endif // ENABLED(MESH_BED_LEVELING)
@@ -79,6 +79,7 @@ inline void set_all_z_lock(const bool lock) {
  *   I<iterations>
  *   T<accuracy>
  *   A<amplification>
+ *   P<bool>  Parallel, correct all the Z steppers in a single move (default Z_STEPPER_ALIGN_PARALLEL)
  */
 inline void gcode_G34() {
 
@@ -113,6 +114,8 @@ inline void gcode_G34() {
 
     const ProbePtRaiseEnum raise_after = parser.boolval('E') ? PROBE_PT_STOW : PROBE_PT_RAISE;
 
+    const bool parallel = parser.boolval('P', Z_STEPPER_ALIGN_PARALLEL);
+
     // Wait for planner moves to finish!
     planner.synchronize();
 
@@ -132,8 +135,8 @@ inline void gcode_G34() {
       mechanics.extruder_duplication_enabled = false;
     #endif
 
-    #if HAS_BLTOUCH && ENABLED(BLTOUCH_HIGH_SPEED_MODE)
-      // In BLTOUCH HS mode, the probe travels in a deployed state.
+    #if HAS_BLTOUCH && (ENABLED(BLTOUCH_HIGH_SPEED_MODE) || ENABLED(BLTOUCH_PIPELINED_DEPLOY))
+      // In BLTOUCH HS or pipelined mode, the probe travels in a deployed state.
       // Users of G34 might have a badly misaligned bed, so raise Z by the
       // length of the deployed pin (BLTOUCH stroke < 7mm)
       #define Z_BASIC_CLEARANCE Z_PROBE_BETWEEN_HEIGHT + 7.0f
@@ -254,6 +257,8 @@ inline void gcode_G34() {
 
       bool success_break = true;
 
+      float z_align_moves[Z_STEPPER_COUNT] = { 0 };
+
       // Correct stepper offsets and re-iterate
       for (uint8_t zstepper = 0; zstepper < Z_STEPPER_COUNT; ++zstepper) {
         // Calculate current stepper move
@@ -283,6 +288,10 @@ inline void gcode_G34() {
           DEBUG_EMV(" corrected by ", z_align_move);
         }
 
+        z_align_moves[zstepper] = amplification * z_align_move;
+
+        if (parallel) continue;
+
         // Lock all steppers except one
         set_all_z_lock(true);
         switch (zstepper) {
@@ -294,7 +303,34 @@ inline void gcode_G34() {
         }
 
         // Do a move to correct part of the misalignment for the current stepper
-        mechanics.do_blocking_move_to_z(amplification * z_align_move + mechanics.position.z);
+        mechanics.do_blocking_move_to_z(z_align_moves[zstepper] + mechanics.position.z);
+      }
+
+      if (parallel && !err_break) {
+        // A single move as long as the largest correction, each stepper is locked after its own steps.
+        // The corrections are all from the lowest point, so all in the same direction.
+        uint8_t longest = 0;
+        for (uint8_t zstepper = 1; zstepper < Z_STEPPER_COUNT; ++zstepper)
+          if (ABS(z_align_moves[zstepper]) > ABS(z_align_moves[longest])) longest = zstepper;
+
+        for (uint8_t zstepper = 0; zstepper < Z_STEPPER_COUNT; ++zstepper) {
+          const uint32_t steps = LROUND(ABS(z_align_moves[zstepper]) * mechanics.data.axis_steps_per_mm.z);
+          // The longest follows the whole move
+          stepper.set_z_align_steps(zstepper, zstepper == longest ? 0 : steps);
+          const bool lock = !steps;
+          switch (zstepper) {
+            case 0: stepper.set_z_lock(lock); break;
+            case 1: stepper.set_z2_lock(lock); break;
+            #if ENABLED(Z_THREE_STEPPER_DRIVERS)
+              case 2: stepper.set_z3_lock(lock); break;
+            #endif
+          }
+        }
+
+        mechanics.do_blocking_move_to_z(z_align_moves[longest] + mechanics.position.z);
+
+        for (uint8_t zstepper = 0; zstepper < Z_STEPPER_COUNT; ++zstepper)
+          stepper.set_z_align_steps(zstepper, 0);
       }
 
       // Back to normal stepper operations
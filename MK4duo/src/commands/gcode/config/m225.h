@@ -0,0 +1,65 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(BUFFER_ARENA)
+
+#define CODE_M225
+
+/**
+ * M225: Set the split of the buffer arena
+ *
+ *  B<blocks>     Planner blocks, a power of 2 from 8 to 128
+ *  C<commands>   Command slots, a power of 2 from 2 to 128
+ *
+ * The queues are sized at boot: save with M500 and restart.
+ */
+inline void gcode_M225() {
+
+  #if DISABLED(DISABLE_M503)
+    // No arguments? Show M225 report.
+    if (!parser.seen("BC")) {
+      bufferArena.print_M225();
+      return;
+    }
+  #endif
+
+  const uint8_t blocks   = parser.byteval('B', bufferArena.data.blocks),
+                commands = parser.byteval('C', bufferArena.data.commands);
+
+  if (!bufferArena.valid(blocks, commands)) {
+    SERIAL_LM(ER, "M225 split not valid or larger than the arena");
+    return;
+  }
+
+  bufferArena.data.blocks   = blocks;
+  bufferArena.data.commands = commands;
+  SERIAL_LM(ECHO, "M225 saved with M500, at the next boot");
+
+}
+
+#endif // ENABLED(BUFFER_ARENA)
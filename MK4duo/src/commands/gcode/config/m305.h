@@ -62,10 +62,10 @@ inline void gcode_M305() {
           return;
         }
       #endif
+      dhtsensor.init();
       dhtsensor.data.pin = parser.intval('P', DHT_DATA_PIN);
       if (parser.seen('S'))
         dhtsensor.change_type(DHTEnum(parser.value_int()));
-      dhtsensor.init();
       return;
     }
   #endif
@@ -133,6 +133,9 @@ inline void gcode_M305() {
   }
 
   act->data.sensor.CalcDerivedParameters();
+  #if ENABLED(THERMISTOR_TABLE)
+    act->sensor_table.build(act->data.sensor);
+  #endif
 
 }
 
@@ -71,7 +71,7 @@ inline void gcode_M306() {
   act->data.pid.Max       = parser.intval('C', act->data.pid.Max);
   act->data.temp.min      = parser.intval('L', act->data.temp.min);
   act->data.temp.max      = parser.intval('O', act->data.temp.max);
-  act->data.freq          = MIN(parser.intval('F', act->data.freq), MAX_PWM_FREQUENCY);
+  act->data.freq          = MIN(parser.ushortval('F', act->data.freq), MAX_PWM_FREQUENCY);
 
   NOMORE(act->data.pid.drive.max, act->data.pid.Max);
 
@@ -0,0 +1,89 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(HOTEND_MPC)
+
+#define CODE_M307
+
+/**
+ * M307: Set or calibrate the hotend Model Predictive Control
+ *
+ *   H[heaters]   0-5 Hotend
+ *
+ *    P[float]    Heater power (W)
+ *    C[float]    Block heat capacity (J/K)
+ *    R[float]    Sensor responsiveness (K/s/K)
+ *    A[float]    Ambient heat transfer coefficient with the part fan off (W/K)
+ *    F[float]    Ambient heat transfer coefficient with the part fan at full speed (W/K)
+ *    E[float]    Filament heat capacity per mm (J/K/mm)
+ *
+ *    S[temp]     Run the autotune up to this temperature (default MPC_AUTOTUNE_TEMP)
+ *    U[bool]     with a non-zero value will store the autotune result into EEPROM
+ */
+inline void gcode_M307() {
+
+  Heater * const act = commands.get_target_heater();
+
+  if (!act || act->type != IS_HOTEND) return;
+
+  if (parser.seen('S')) {
+    const int16_t target = parser.celsiusval('S', MPC_AUTOTUNE_TEMP);
+    if (target > act->data.temp.max - 10) {
+      SERIAL_EM(MSG_HOST_PID_TEMP_TOO_HIGH);
+      return;
+    }
+    SERIAL_EM(MSG_HOST_MPC_AUTOTUNE_START);
+    lcdui.reset_alert_level();
+    act->MPC_autotune(target, parser.boolval('U'));
+    return;
+  }
+
+  #if DISABLED(DISABLE_M503)
+    // No arguments? Show M307 report.
+    if (!parser.seen("PCRAFE")) {
+      act->print_M307();
+      return;
+    }
+  #endif
+
+  mpc_data_t &mpc = act->data.mpc;
+
+  if (parser.seen('P')) mpc.heater_power = parser.value_float();
+  if (parser.seen('C')) mpc.block_heat_capacity = parser.value_float();
+  if (parser.seen('R')) mpc.sensor_responsiveness = parser.value_float();
+  if (parser.seen('A')) {
+    const float fan255 = mpc.ambient_xfer_coeff_fan0 + mpc.fan255_adjustment;
+    mpc.ambient_xfer_coeff_fan0 = parser.value_float();
+    mpc.fan255_adjustment = fan255 - mpc.ambient_xfer_coeff_fan0;
+  }
+  if (parser.seen('F')) mpc.fan255_adjustment = parser.value_float() - mpc.ambient_xfer_coeff_fan0;
+  if (parser.seen('E')) mpc.filament_heat_capacity_permm = parser.value_float();
+
+}
+
+#endif // HOTEND_MPC
@@ -0,0 +1,70 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(INPUT_SHAPING)
+
+#define CODE_M593
+
+/**
+ * M593: Set the input shaping of X and Y
+ *
+ *  X Y       Axes to set, both with no axis
+ *  T<type>   0 ZV, 1 MZV, 2 EI
+ *  F<Hz>     Ringing frequency, 0 is no shaping
+ *  D<zeta>   Damping ratio (0 - 0.99)
+ *
+ * The moves in the planner end before the values change.
+ */
+inline void gcode_M593() {
+
+  #if DISABLED(DISABLE_M503)
+    // No arguments? Show M593 report.
+    if (!parser.seen("TFD")) {
+      shaping.print_M593();
+      return;
+    }
+  #endif
+
+  const bool  seen_x  = parser.seen('X'),
+              seen_y  = parser.seen('Y'),
+              all     = !seen_x && !seen_y;
+
+  planner.synchronize();
+
+  LOOP_XY(i) {
+    if (!all && !(i == X_AXIS ? seen_x : seen_y)) continue;
+    if (parser.seenval('T')) shaping.data.type[i] = constrain(parser.value_int(), 0, SHAPER_COUNT - 1);
+    if (parser.seenval('F')) shaping.data.frequency[i] = MAX(parser.value_float(), 0.0f);
+    if (parser.seenval('D')) shaping.data.zeta[i] = constrain(parser.value_float(), 0.0f, 0.99f);
+  }
+
+  shaping.refresh();
+
+}
+
+#endif // ENABLED(INPUT_SHAPING)
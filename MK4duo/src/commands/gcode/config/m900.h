@@ -36,25 +36,55 @@
  *  T<tools>    Set extruder
  *  K<factor>   Set advance K factor
  *  S<bool>     Set Test Linear Advance
+ *
+ *  With LIN_ADVANCE_PROFILES:
+ *  P<profile>  Switch to the profile, 0 for the K of the extruder
+ *  P<profile> K<factor> F<flow>  Set the K and the flow percentage of the profile
+ *
+ *  The moves already in the planner keep their K, no wait for them.
  */
 inline void gcode_M900() {
 
   if (commands.get_target_tool(900)) return;
 
   #if DISABLED(DISABLE_M503)
-    // No arguments? Show M218 report.
+    // No arguments? Show M900 report.
     if (parser.seen_any()) {
       toolManager.print_M900();
       return;
     }
   #endif
 
+  #if ENABLED(LIN_ADVANCE_PROFILES)
+    if (parser.seenval('P')) {
+      const uint8_t p = parser.value_byte();
+      if (p > LIN_ADVANCE_PROFILES) {
+        SERIAL_EM("?P value out of range (0-" STRINGIFY(LIN_ADVANCE_PROFILES) ").");
+        return;
+      }
+      if (!parser.seen('K') && !parser.seen('F')) {
+        toolManager.set_advance_profile(p);
+        return;
+      }
+      if (!p) return;
+      advance_profile_t &profile = toolManager.advance_profile[p - 1];
+      if (parser.seenval('K')) {
+        const float newK = parser.value_float();
+        if (WITHIN(newK, 0, 10))
+          profile.K = newK;
+        else
+          SERIAL_EM("?K value out of range (0-10).");
+      }
+      if (parser.seenval('F')) profile.flow_percentage = constrain(parser.value_int(), 10, 999);
+      if (p == toolManager.advance_profile_active) toolManager.set_advance_profile(p);
+      return;
+    }
+  #endif
+
   if (parser.seenval('K')) {
     const float newK = parser.value_float();
-    if (WITHIN(newK, 0, 10)) {
-      planner.synchronize();
+    if (WITHIN(newK, 0, 10))
       extruders[toolManager.extruder.target]->data.advance_K = newK;
-    }
     else
       SERIAL_EM("?K value out of range (0-10).");
   }
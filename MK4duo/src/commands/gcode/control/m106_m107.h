@@ -41,6 +41,7 @@
  *  L<int>    Min Speed
  *  X<int>    Max Speed
  *  I<bool>   Inverted pin output
+ *  R<rpm>    Hold the RPM with the tachometer, R0 back to the S speed
  */
 inline void gcode_M106() {
 
@@ -72,17 +73,33 @@ inline void gcode_M106() {
   fan->data.speed_limit.max     = parser.byteval('X', fan->data.speed_limit.max);
   fan->data.trigger_temperature = parser.ushortval('T', fan->data.trigger_temperature);
 
-  fan->set_speed(new_speed);
+  #if ENABLED(SYNCHRONOUS_FAN_SPEED)
+    planner.buffer_sync_fan(f, new_speed);
+  #else
+    fan->set_speed(new_speed);
+  #endif
+
+  #if ENABLED(TACHOMETRIC)
+    if (parser.seen('R'))
+      fan->set_rpm_target(fan->data.tacho.pin > 0 ? parser.value_ushort() : 0);
+    else if (parser.seen('S'))
+      fan->set_rpm_target(0);
+  #endif
 
   #if ENABLED(DUAL_X_CARRIAGE) && MAX_FAN > 1
     // Check for Clone fan
-    if (f == 0 && mechanics.dxc_is_duplicating() && TEST(fans[1]->data.auto_monitor, 6))
-      fans[1]->set_speed(new_speed);
+    if (f == 0 && mechanics.dxc_is_duplicating() && TEST(fans[1]->data.auto_monitor, 6)) {
+      #if ENABLED(SYNCHRONOUS_FAN_SPEED)
+        planner.buffer_sync_fan(1, new_speed);
+      #else
+        fans[1]->set_speed(new_speed);
+      #endif
+    }
   #endif
 
   #if DISABLED(DISABLE_M503)
     // No arguments? Show M106 report.
-    if (!parser.seen("SUIHLXFT")) fanManager.print_M106(f);
+    if (!parser.seen("SUIHLXFTR")) fanManager.print_M106(f);
   #endif
 
 }
@@ -93,5 +110,12 @@ inline void gcode_M106() {
 inline void gcode_M107() {
   uint8_t f = 0;
   if (printer.debugSimulation() || !fanManager.get_target_fan(f)) return;
-  fans[f]->speed = 0;
+  #if ENABLED(SYNCHRONOUS_FAN_SPEED)
+    planner.buffer_sync_fan(f, 0);
+  #else
+    fans[f]->speed = 0;
+  #endif
+  #if ENABLED(TACHOMETRIC)
+    fans[f]->set_rpm_target(0);
+  #endif
 }
@@ -30,6 +30,68 @@
 
 #define CODE_M1000
 
-inline void gcode_M1000() { parser.debug(); }
+/**
+ * M1000: Debug GCode parser
+ *  Print how this command is parsed
+ *    B<count>  Benchmark: parse and dispatch a canned set of lines count times (default 100),
+ *              with the motion suppressed as in simulation, and report the time per line
+ */
+inline void gcode_M1000() {
+
+  if (!parser.seen('B')) {
+    parser.debug();
+    return;
+  }
+
+  static const char bench_lines[][40] PROGMEM = {
+    "G1 X103.452 Y87.201 Z0.3 E4.51232",
+    "G1 X104.119 Y87.988 E4.53817 F1800",
+    "M104 S205",
+    #if ENABLED(ARC_SUPPORT)
+      "G2 X110.5 Y92.75 I3.19 J2.38 E4.6"
+    #endif
+  };
+
+  const uint16_t passes = parser.ushortval('B', 100);
+  if (!passes) return;
+
+  planner.synchronize();
+
+  const xyze_pos_t  saved_position  = mechanics.position;
+  const uint8_t     saved_relative  = mechanics.axis_relative_modes,
+                    saved_debug     = printer.debug_flag.all;
+
+  // The flag, not setDebugLevel, so the heaters are left as they are
+  printer.debug_flag.simulation = true;
+  mechanics.axis_relative_modes = 0;
+
+  uint32_t elapsed[COUNT(bench_lines)] = { 0 };
+  char line[40];
+
+  for (uint16_t n = 0; n < passes; n++) {
+    LOOP_L_N(l, COUNT(bench_lines)) {
+      strcpy_P(line, bench_lines[l]);
+      const uint32_t start = micros();
+      commands.process_now(line);
+      elapsed[l] += micros() - start;
+    }
+  }
+
+  printer.debug_flag.all = saved_debug;
+  mechanics.axis_relative_modes = saved_relative;
+  mechanics.position = saved_position;
+  mechanics.sync_plan_position();
+
+  uint32_t total = 0;
+  LOOP_L_N(l, COUNT(bench_lines)) {
+    strcpy_P(line, bench_lines[l]);
+    SERIAL_SMV(ECHO, "us/line:", float(elapsed[l]) / passes, 2);
+    SERIAL_EMT(" ", line);
+    total += elapsed[l];
+  }
+  SERIAL_SMV(ECHO, "lines:", uint32_t(passes) * COUNT(bench_lines));
+  SERIAL_EMV(" us/line:", float(total) / (uint32_t(passes) * COUNT(bench_lines)), 2);
+
+}
 
 #endif // DEBUG_GCODE_PARSER
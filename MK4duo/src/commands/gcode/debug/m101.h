@@ -0,0 +1,55 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(PLANNER_TIMING_STATS) || ENABLED(PLANNER_FIXED_POINT)
+
+#define CODE_M101
+
+/**
+ * M101: Planner debug
+ *
+ *  With PLANNER_TIMING_STATS report the time spent by the planner to fill and plan each block
+ *    R   Reset the statistics
+ *
+ *  With PLANNER_FIXED_POINT
+ *    T   Run the fixed point trapezoid generator side by side with the float reference
+ */
+inline void gcode_M101() {
+
+  #if ENABLED(PLANNER_TIMING_STATS)
+    planner.report_timing();
+    if (parser.seen('R')) planner.timing.reset();
+  #endif
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+    if (parser.seen('T')) planner.fixed_point_accuracy_test();
+  #endif
+
+}
+
+#endif // PLANNER_TIMING_STATS || PLANNER_FIXED_POINT
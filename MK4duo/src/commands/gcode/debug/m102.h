@@ -0,0 +1,44 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEPPER_ISR_PROFILER)
+
+#define CODE_M102
+
+/**
+ * M102: Stepper ISR profiler
+ *
+ *  Report min, average and max time of each stepper ISR phase and the ISR duty cycle
+ *    R   Reset the statistics
+ */
+inline void gcode_M102() {
+  isrProfiler.print();
+  if (parser.seen('R')) isrProfiler.reset();
+}
+
+#endif // STEPPER_ISR_PROFILER
@@ -0,0 +1,78 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(GCODE_PARSER_BENCHMARK)
+
+#define CODE_M103
+
+/**
+ * M103: GCode parser benchmark
+ *
+ *  Parse a canned set of G1 lines and fetch all their values,
+ *  once with the parser scanner and once with strtof.
+ *    C   Number of passes (default 100)
+ */
+inline void gcode_M103() {
+
+  static const char bench_lines[][40] PROGMEM = {
+    "G1 X103.452 Y87.201 E4.51232",
+    "G1 X104.119 Y87.988 E4.53817",
+    "G1 F1800 X110.5 Y92.75 Z0.3 E5.01",
+    "G1 X-12.875 Y-0.0625 E0.125",
+    "G1 X98.1234 Y123.4567 Z12.3 E123.45678 F4800"
+  };
+
+  const uint16_t passes = parser.ushortval('C', 100);
+  const uint16_t lines  = passes * COUNT(bench_lines);
+  char line[40];
+  volatile float sum = 0;   // Keep the values alive
+
+  for (uint8_t mode = 0; mode < 2; mode++) {
+    const uint32_t start = micros();
+    for (uint16_t n = 0; n < passes; n++) {
+      for (uint8_t l = 0; l < COUNT(bench_lines); l++) {
+        strcpy_P(line, bench_lines[l]);
+        parser.parse(line);
+        LOOP_XYZE(i) {
+          if (parser.seenval(axis_codes[i]))
+            sum += mode ? strtof(strchr(parser.command_ptr, axis_codes[i]) + 1, nullptr) : parser.value_float();
+        }
+        if (parser.seenval('F'))
+          sum += mode ? strtof(strchr(parser.command_ptr, 'F') + 1, nullptr) : parser.value_float();
+      }
+    }
+    const uint32_t elapsed = micros() - start;
+    SERIAL_SM(ECHO, mode ? "strtof" : "scanner");
+    SERIAL_MV(" lines:", lines);
+    SERIAL_MV(" us/line:", float(elapsed) / lines, 2);
+    SERIAL_EOL();
+  }
+
+}
+
+#endif // GCODE_PARSER_BENCHMARK
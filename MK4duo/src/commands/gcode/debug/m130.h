@@ -0,0 +1,168 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEP_QUEUE)
+
+#define CODE_M130
+
+#if !IS_KINEMATIC
+
+  /**
+   * Move to dest, the time of the steps is taken in the middle of the move where the speed is the feedrate
+   */
+  inline float step_queue_bench_move(const xyze_pos_t &dest, const feedrate_t fr_mm_s, const AxisEnum axis) {
+
+    const float start = mechanics.position[axis],
+                span  = dest[axis] - start;
+    float duty = 0;
+    bool started = false;
+
+    LOOP_XYZE(i) stepQueue.step_time[i].reset();
+
+    planner.buffer_line(dest, fr_mm_s, toolManager.extruder.active);
+
+    while (planner.has_blocks_queued()) {
+      const float done = (planner.get_axis_position_mm(axis) - start) / span;
+      if (!started && done >= 0.25f) {
+        #if ENABLED(STEPPER_ISR_PROFILER)
+          isrProfiler.reset();
+        #endif
+        stepQueue.timing = started = true;
+      }
+      else if (stepQueue.timing && done >= 0.75f) {
+        stepQueue.timing = false;
+        #if ENABLED(STEPPER_ISR_PROFILER)
+          duty = isrProfiler.duty_cycle();
+        #endif
+      }
+      printer.idle();
+    }
+
+    stepQueue.timing = false;
+    return duty;
+  }
+
+  inline void step_queue_bench_print(PGM_P const mode, const float duty) {
+
+    constexpr float us_per_cycle = 1000000.0f / float(HAL_CYCLE_COUNTER_RATE);
+
+    LOOP_XY(i) {
+      const step_timing_t &st = stepQueue.step_time[i];
+      SERIAL_STR(ECHO);
+      SERIAL_STR(mode);
+      SERIAL_CHR(' ');
+      SERIAL_CHR(axis_codes[i]);
+      SERIAL_MV(" steps:", st.count);
+      if (st.count > 2) {
+        SERIAL_MV(" max_rate:", uint32_t((HAL_CYCLE_COUNTER_RATE) / st.min));
+        SERIAL_MV(" jitter_avg(us):", st.jitter_sum * us_per_cycle / (st.count - 2), 3);
+        SERIAL_MV(" jitter_max(us):", st.jitter_max * us_per_cycle, 3);
+      }
+      SERIAL_EOL();
+    }
+
+    #if ENABLED(STEPPER_ISR_PROFILER)
+      SERIAL_STR(ECHO);
+      SERIAL_STR(mode);
+      SERIAL_EMV(" isr_duty(%):", duty, 2);
+    #else
+      UNUSED(duty);
+    #endif
+  }
+
+#endif // !IS_KINEMATIC
+
+/**
+ * M130: Step queue mode
+ *
+ *  S<bool>   Step queue on (1) or Bresenham ISR (0), the moves are finished first
+ *  R         Reset the queue statistics
+ *  B         Benchmark, the same move in both modes, not on the kinematic machines:
+ *    X<mm>     Length of the move along X (default 50)
+ *    Y<mm>     Length of the move along Y (default 20)
+ *    F<mm/s>   Feedrate of the move (default 100)
+ *
+ * The benchmark takes the time of the X and Y steps in the middle half of the
+ * move and reports for each mode the highest step rate, the mean and the max
+ * change of the interval between two steps of a motor (the jitter, at constant
+ * speed it is all timing error) and the ISR duty cycle with STEPPER_ISR_PROFILER.
+ * The move goes back to the start after each mode.
+ */
+inline void gcode_M130() {
+
+  if (parser.seen('S')) stepQueue.set_enabled(parser.value_bool());
+  if (parser.seen('R')) stepQueue.reset_stats();
+
+  #if !IS_KINEMATIC
+
+    if (parser.seen('B')) {
+
+      if (mechanics.axis_unhomed_error(_BV(X_AXIS) | _BV(Y_AXIS))) return;
+
+      const float       dx    = parser.floatval('X', 50),
+                        dy    = parser.floatval('Y', 20);
+      const feedrate_t  fr    = parser.floatval('F', 100);
+
+      if ((!dx && !dy) || fr <= 0) {
+        SERIAL_LM(ER, "M130 needs a move X or Y and F > 0");
+        return;
+      }
+
+      xyze_pos_t dest = mechanics.position;
+      dest.x += dx;
+      dest.y += dy;
+      if (!WITHIN(dest.x, endstops.soft_endstop.min.x, endstops.soft_endstop.max.x)
+        || !WITHIN(dest.y, endstops.soft_endstop.min.y, endstops.soft_endstop.max.y)
+      ) {
+        SERIAL_LM(ER, "M130 no room for the move");
+        return;
+      }
+
+      const AxisEnum  axis        = ABS(dx) >= ABS(dy) ? X_AXIS : Y_AXIS;
+      const bool      was_enabled = stepQueue.enabled;
+
+      stepQueue.reset_stats();
+
+      LOOP_L_N(mode, 2) {
+        stepQueue.set_enabled(mode);
+        const float duty = step_queue_bench_move(dest, fr, axis);
+        step_queue_bench_print(mode ? PSTR("queue") : PSTR("bresenham"), duty);
+        planner.buffer_line(mechanics.position, fr, toolManager.extruder.active);
+        planner.synchronize();
+      }
+
+      stepQueue.set_enabled(was_enabled);
+    }
+
+  #endif // !IS_KINEMATIC
+
+  stepQueue.print_stats();
+
+}
+
+#endif // STEP_QUEUE
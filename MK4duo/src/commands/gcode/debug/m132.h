@@ -0,0 +1,45 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(PLANNER_UNDERRUN_STATS)
+
+#define CODE_M132
+
+/**
+ * M132: Planner underrun stats
+ *
+ *  Report the underruns of the block buffer while printing, the least depth and
+ *  the time queued in the buffer, for all the print and for the last layers
+ *    R   Reset the statistics
+ */
+inline void gcode_M132() {
+  planner.report_underrun();
+  if (parser.seen('R')) planner.underrun_reset();
+}
+
+#endif // PLANNER_UNDERRUN_STATS
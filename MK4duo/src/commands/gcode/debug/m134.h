@@ -0,0 +1,45 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(MEMORY_PROFILER)
+
+#define CODE_M134
+
+/**
+ * M134: Memory profile
+ *
+ *  Report the free memory, now and the lowest ever, the stack used
+ *  by each ISR and the size of the buffers and of the static pools
+ *    R   Reset the ISR stack marks and paint again the free memory
+ */
+inline void gcode_M134() {
+  memoryProfiler.print();
+  if (parser.seen('R')) memoryProfiler.paint();
+}
+
+#endif // MEMORY_PROFILER
@@ -0,0 +1,218 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(MOTION_BENCHMARK)
+
+#define CODE_M135
+
+#if ENABLED(ARC_SUPPORT)
+  void plan_arc(const xyze_pos_t &cart, const ab_float_t &offset, const uint8_t clockwise);
+#endif
+
+/**
+ * A move of the benchmark, as a G1 with its kinematics and leveling
+ */
+inline void motion_bench_line(const float rx, const float ry) {
+  mechanics.destination = mechanics.position;
+  mechanics.destination.x = rx;
+  mechanics.destination.y = ry;
+  mechanics.prepare_move_to_destination();
+}
+
+/**
+ * M135: Motion benchmark
+ *
+ *  W<workload> The moves, from the current position (default 0)
+ *                0 Circle of C tiny segments (default 500)
+ *                1 Sweeps, C lines along the sides of the square of side 2R, alternating X and Y
+ *                  (default 20), the kinematic machines split them in segments
+ *                2 Arcs, C full circles of radius R as G2 (default 5, requires ARC_SUPPORT)
+ *                3 Raster, C rows of C segments over the square of side 2R (default 20),
+ *                  across the cells of the mesh with the leveling on
+ *  R<mm>       Radius of the circle and of the arcs, half side of the square (default 20)
+ *  F<mm/s>     Feedrate (default 100)
+ *  L           Run the moves with the steppers, without extrusion. Without L the moves
+ *              are planned in the planner time warp and never stepped.
+ *
+ * Report the blocks queued, the segments per second the planner takes in, the time
+ * per block, the time of the moves by their trapezoids and the leveling state.
+ * With PLANNER_TIMING_STATS also the time of the planner alone, with STEPPER_ISR_PROFILER
+ * and L the ISR duty cycle.
+ */
+inline void gcode_M135() {
+
+  const uint8_t     workload  = parser.byteval('W');
+  const float       radius    = parser.floatval('R', 20);
+  const feedrate_t  fr        = parser.floatval('F', 100);
+  const bool        live      = parser.seen('L');
+
+  static const uint16_t default_count[] PROGMEM = { 500, 20, 5, 20 };
+  if (workload >= COUNT(default_count) || radius <= 0 || fr <= 0) {
+    SERIAL_LM(ER, "M135 needs W0-3, R > 0 and F > 0");
+    return;
+  }
+  #if DISABLED(ARC_SUPPORT)
+    if (workload == 2) {
+      SERIAL_LM(ER, "M135 W2 requires ARC_SUPPORT");
+      return;
+    }
+  #endif
+
+  const uint16_t count = parser.ushortval('C', pgm_read_word(&default_count[workload]));
+  if (count < 2) {
+    SERIAL_LM(ER, "M135 needs C > 1");
+    return;
+  }
+
+  planner.synchronize();
+
+  const xyze_pos_t start = mechanics.position;
+
+  // The circle and the arcs have the start on the left, the square is centered on it
+  if (live) {
+    if (mechanics.axis_unhomed_error(_BV(X_AXIS) | _BV(Y_AXIS))) return;
+    const float cx = workload == 0 || workload == 2 ? start.x + radius : start.x;
+    if (!mechanics.position_is_reachable(cx - radius, start.y - radius)
+      || !mechanics.position_is_reachable(cx + radius, start.y + radius)
+      || !mechanics.position_is_reachable(cx - radius, start.y + radius)
+      || !mechanics.position_is_reachable(cx + radius, start.y - radius)
+    ) {
+      SERIAL_LM(ER, "M135 moves out of reach");
+      return;
+    }
+  }
+
+  const feedrate_t  old_feedrate    = mechanics.feedrate_mm_s;
+  const int16_t     old_percentage  = mechanics.feedrate_percentage;
+  mechanics.feedrate_mm_s = fr;
+  mechanics.feedrate_percentage = 100;
+
+  if (!live) planner.time_warp_start();
+
+  #if ENABLED(PLANNER_TIMING_STATS)
+    planner.timing.reset();
+  #endif
+  #if ENABLED(STEPPER_ISR_PROFILER)
+    isrProfiler.reset();
+  #endif
+
+  planner.block_count = 0;
+  const uint32_t start_us = micros();
+
+  switch (workload) {
+
+    case 0: {
+      const float cx = start.x + radius;
+      for (uint16_t i = 1; i <= count; i++) {
+        const float a = RADIANS(180.0f + 360.0f * i / count);
+        motion_bench_line(cx + radius * cos(a), start.y + radius * sin(a));
+      }
+    } break;
+
+    case 1:
+      motion_bench_line(start.x - radius, start.y - radius);
+      for (uint16_t i = 0; i < count; i++) {
+        if (TEST(i, 0))
+          motion_bench_line(mechanics.position.x, TEST(i, 1) ? start.y - radius : start.y + radius);
+        else
+          motion_bench_line(TEST(i, 1) ? start.x - radius : start.x + radius, mechanics.position.y);
+      }
+      break;
+
+    #if ENABLED(ARC_SUPPORT)
+      case 2: {
+        const ab_float_t offset = { radius, 0 };
+        for (uint16_t i = 0; i < count; i++) plan_arc(mechanics.position, offset, true);
+      } break;
+    #endif
+
+    case 3: {
+      const float step = 2.0f * radius / count;
+      motion_bench_line(start.x - radius, start.y - radius);
+      for (uint16_t row = 0; row < count; row++) {
+        const float y = start.y - radius + step * row;
+        if (row) motion_bench_line(mechanics.position.x, y);
+        for (uint16_t i = 1; i <= count; i++)
+          motion_bench_line(TEST(row, 0) ? start.x + radius - step * i : start.x - radius + step * i, y);
+      }
+    } break;
+
+    default: break;
+  }
+
+  // The time to take in the moves, till the last one is queued
+  const uint32_t elapsed_us = micros() - start_us,
+                 blocks     = planner.block_count;
+
+  planner.synchronize();
+
+  #if ENABLED(STEPPER_ISR_PROFILER)
+    const float duty = isrProfiler.duty_cycle();
+  #endif
+
+  const float motion_s = live ? (micros() - start_us) * 0.000001f : planner.time_warp_stop();
+
+  mechanics.feedrate_percentage = old_percentage;
+
+  // Back to the start
+  if (live) {
+    mechanics.destination = start;
+    mechanics.prepare_move_to_destination();
+    planner.synchronize();
+  }
+  else {
+    mechanics.position = start;
+    mechanics.sync_plan_position();
+  }
+  mechanics.feedrate_mm_s = old_feedrate;
+
+  SERIAL_SMV(ECHO, "Motion benchmark W", int(workload));
+  SERIAL_STR(live ? PSTR(" live") : PSTR(" simulation"));
+  SERIAL_MV(" blocks:", blocks);
+  SERIAL_MV(" time(ms):", elapsed_us / 1000UL);
+  if (elapsed_us) SERIAL_MV(" segments/s:", uint32_t(blocks * 1000000.0f / elapsed_us));
+  if (blocks) SERIAL_MV(" us/block:", float(elapsed_us) / blocks, 1);
+  SERIAL_MV(" motion(s):", motion_s, 1);
+  #if HAS_LEVELING
+    SERIAL_MV(" leveling:", int(bedlevel.flag.leveling_active));
+  #endif
+  SERIAL_EOL();
+
+  #if ENABLED(PLANNER_TIMING_STATS)
+    planner.report_timing();
+  #endif
+
+  #if ENABLED(STEPPER_ISR_PROFILER)
+    if (live) {
+      SERIAL_SM(ECHO, "Motion benchmark");
+      SERIAL_EMV(" isr_duty(%):", duty, 2);
+    }
+  #endif
+
+}
+
+#endif // MOTION_BENCHMARK
@@ -68,7 +68,7 @@ static void ac_cleanup() {
 }
 
 // Homed height
-float homed_height;
+static float homed_height;
 static void calc_homed_height() {
   const float tempHeight = mechanics.data.diagonal_rod;		// any sensible height will do here, probably even zero
   abc_pos_t cartesian;
@@ -126,152 +126,106 @@ static void Adjust(const uint8_t numFactors, const float v[]) {
 
 }
 
-// Compute the derivative of height with respect to a parameter at the specified motor endpoints.
+// A dense probe set: the center, an outer ring on the probe radius and, from 10 points,
+// an inner ring on half of it with a third of the points
+#if ENABLED(__AVR__)
+  constexpr uint8_t MaxCalibrationPoints = 16;
+#else
+  constexpr uint8_t MaxCalibrationPoints = 31;
+#endif
+constexpr uint8_t MaxnumFactors   = 7,
+                  MaxIterations   = 4;      // Newton-Raphson iterations on the probed data
+constexpr float   MinImprovement  = 0.001f; // mm of rms error to try another iteration
+
+typedef FixedMatrix<float, MaxCalibrationPoints, MaxnumFactors> derivative_matrix_t;
+
+// Compute the derivatives of height with respect to a parameter at all the motor endpoints.
 // 'deriv' indicates the parameter as follows:
 // 0, 1, 2 = X, Y, Z tower endstop adjustments
 // 3 = delta radius
 // 4 = X tower correction
 // 5 = Y tower correction
 // 6 = data.diagonal_rod rod length
-// 7, 8 = X tilt, Y tilt. We scale these by the printable radius to get sensible values in the range -1..1
-static float compute_derivative(const uint16_t deriv, const abc_pos_t &hpos) {
+// The geometry is perturbed once for all the points, not for each of them.
+static void compute_derivatives(const uint8_t deriv, const abc_pos_t hpos[], const uint8_t points, derivative_matrix_t &matrix) {
   constexpr float perturb = 0.2;      // perturbation amount in mm or degrees
-  float zHi = 0.0f,
-        zLo = 0.0f;
-  abc_float_t newPos  = { 0.0f, 0.0f, 0.0f };
-
-  switch (deriv) {
-    case 0:
-    case 1:
-    case 2:
-      // Endstop corrections
-      mechanics.InverseTransform((deriv == 0) ? hpos.a + perturb : hpos.a, (deriv == 1) ? hpos.b + perturb : hpos.b, (deriv == 2) ? hpos.c + perturb : hpos.c, newPos);
-      zHi = newPos.c;
-      mechanics.InverseTransform((deriv == 0) ? hpos.a - perturb : hpos.a, (deriv == 1) ? hpos.b - perturb : hpos.b, (deriv == 2) ? hpos.c - perturb : hpos.c, newPos);
-      zLo = newPos.c;
-      break;
-
-    case 3: {
-      const float old_delta_radius = mechanics.data.radius;
-
-      // Calc High parameters
-      mechanics.data.radius += perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta Radius
-      mechanics.data.radius = old_delta_radius;
-
-      // Calc Low parameters
-      mechanics.data.radius -= perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
-
-      // Reset Delta Radius
-      mechanics.data.radius = old_delta_radius;
-      break;
-    }
-
-    case 4: {
-      const float old_delta_tower_angle_adj = mechanics.data.tower_angle_adj.a;
-
-      // Calc High parameters
-      mechanics.data.tower_angle_adj.a += perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta tower Alpha angle adj 
-      mechanics.data.tower_angle_adj.a = old_delta_tower_angle_adj;
-
-      // Calc Low parameters
-      mechanics.data.tower_angle_adj.a -= perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
-
-      // Reset Delta tower Alpha angle adj 
-      mechanics.data.tower_angle_adj.a = old_delta_tower_angle_adj;
-      break;
-    }
-
-    case 5: {
-      const float old_delta_tower_angle_adj = mechanics.data.tower_angle_adj.b;
-
-      // Calc High parameters
-      mechanics.data.tower_angle_adj.b += perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta tower Beta angle adj 
-      mechanics.data.tower_angle_adj.b = old_delta_tower_angle_adj;
-
-      // Calc Low parameters
-      mechanics.data.tower_angle_adj.b -= perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
-
-      // Reset Delta tower Beta angle adj 
-      mechanics.data.tower_angle_adj.b = old_delta_tower_angle_adj;
-      break;
+  xyz_pos_t newPos;
+
+  if (deriv < 3) {
+    // Endstop corrections
+    for (uint8_t i = 0; i < points; i++) {
+      abc_pos_t pos = hpos[i];
+      pos[deriv] += perturb;
+      mechanics.InverseTransform(pos, newPos);
+      const float zHi = newPos.z;
+      pos[deriv] -= 2.0f * perturb;
+      mechanics.InverseTransform(pos, newPos);
+      matrix(i, deriv) = (zHi - newPos.z) / (2.0f * perturb);
     }
+    return;
+  }
 
-    case 6: {
-      const float old_delta_diagonal_rod = mechanics.data.diagonal_rod;
-
-      // Calc High parameters
-      mechanics.data.diagonal_rod += perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zHi = newPos.c;
-
-      // Reset Delta Diagonal Rod
-      mechanics.data.diagonal_rod = old_delta_diagonal_rod;
+  float &param = deriv == 3 ? mechanics.data.radius
+               : deriv == 4 ? mechanics.data.tower_angle_adj.a
+               : deriv == 5 ? mechanics.data.tower_angle_adj.b
+               :              mechanics.data.diagonal_rod;
+  const float old_param = param;
 
-      // Calc Low parameters
-      mechanics.data.diagonal_rod -= perturb;
-      mechanics.recalc_delta_settings();
-      mechanics.InverseTransform(hpos, newPos);
-      zLo = newPos.c;
+  // Calc High parameters
+  param = old_param + perturb;
+  mechanics.recalc_delta_settings();
+  for (uint8_t i = 0; i < points; i++) {
+    mechanics.InverseTransform(hpos[i], newPos);
+    matrix(i, deriv) = newPos.z;
+  }
 
-      // Reset Delta Diagonal Rod
-      mechanics.data.diagonal_rod = old_delta_diagonal_rod;
-      break;
-    }
+  // Calc Low parameters
+  param = old_param - perturb;
+  mechanics.recalc_delta_settings();
+  for (uint8_t i = 0; i < points; i++) {
+    mechanics.InverseTransform(hpos[i], newPos);
+    matrix(i, deriv) = (matrix(i, deriv) - newPos.z) / (2.0f * perturb);
   }
 
+  // Reset the parameter
+  param = old_param;
   mechanics.recalc_delta_settings();
+}
 
-  return (zHi - zLo) / (2.0f * perturb);
+// Probe the points of a ring, false on a failed probe
+static bool probe_ring(xyz_pos_t points[], const uint8_t count, const float radius) {
+  for (uint8_t i = 0; i < count; i++) {
+    const float a = (2 * M_PI * i) / float(count);
+    points[i].x = radius * SIN(a);
+    points[i].y = radius * COS(a);
+    points[i].z = calibration_probe(points[i]);
+    if (isnan(points[i].z)) return false;
+  }
+  return true;
 }
 
 /**
- * Delta AutoCalibration Algorithm of Minor Squares based on DC42 RepRapFirmware 7 points
+ * Delta AutoCalibration Algorithm of Minor Squares based on DC42 RepRapFirmware
+ * A single round of probing, the parameters are fitted by least squares with
+ * Newton-Raphson iterations on the probed data.
  * Usage:
- *    G33 <Fn> <Pn> <Q>
+ *    G33 <Fn> <Pn> <D>
  *      F = Num Factors 3 or 4 or 6 or 7
  *        The input vector contains the following parameters in this order:
  *          X, Y and Z endstop adjustments
  *          Delta radius
  *          X tower position adjustment and Y tower position adjustment
  *          Diagonal rod length adjustment
- *      P = Num probe points 7 or 10
+ *      P = Num probe points 7 to 31 (16 on AVR), more points a better fit
+ *      D = Debug, print the matrices and the residuals
  */
 inline void gcode_G33() {
 
-  constexpr uint8_t MaxCalibrationPoints  = 10,
-                NperifericalPoints    = 6,
-                NinternalPoints       = 3,
-                MaxnumFactors         = 7;
-
   uint8_t iteration = 0;
 
   float   initialSumOfSquares,
-          expectedRmsError;
+          expectedRmsError,
+          previousRmsError;
 
   xyz_pos_t BedProbePoints[MaxCalibrationPoints];
 
@@ -283,9 +237,10 @@ inline void gcode_G33() {
     return;
   }
 
-  uint8_t probe_points  = parser.intval('P', DELTA_AUTO_CALIBRATION_1_DEFAULT_POINTS);
-  if (probe_points <= 7) probe_points = 7;
-  else probe_points = 10;
+  const uint8_t probe_points  = constrain(parser.intval('P', DELTA_AUTO_CALIBRATION_1_DEFAULT_POINTS), 7, MaxCalibrationPoints),
+                ring_points   = probe_points - 1,
+                inner_points  = ring_points < 9 ? 0 : ring_points / 3,
+                outer_points  = ring_points - inner_points;
 
   const bool g33_debug = parser.boolval('D');
 
@@ -304,22 +259,8 @@ inline void gcode_G33() {
 
   calc_homed_height();
 
-  for (uint8_t probe_index = 0; probe_index < NperifericalPoints; probe_index++) {
-    BedProbePoints[probe_index].x = mechanics.data.probe_radius * SIN((2 * M_PI * probe_index) / float(NperifericalPoints));
-    BedProbePoints[probe_index].y = mechanics.data.probe_radius * COS((2 * M_PI * probe_index) / float(NperifericalPoints));
-    BedProbePoints[probe_index].z = calibration_probe(BedProbePoints[probe_index]);
-    if (isnan(BedProbePoints[probe_index].z)) return ac_cleanup();
-  }
-
-  if (probe_points == 10) {
-    for (uint8_t index = 0; index < NinternalPoints; index++) {
-      const uint8_t probe_index = index + NperifericalPoints;
-      BedProbePoints[probe_index].x = (mechanics.data.probe_radius / 2) * SIN((2 * M_PI * index) / float(NinternalPoints));
-      BedProbePoints[probe_index].y = (mechanics.data.probe_radius / 2) * COS((2 * M_PI * index) / float(NinternalPoints));
-      BedProbePoints[probe_index].z = calibration_probe(BedProbePoints[probe_index]);
-      if (isnan(BedProbePoints[probe_index].z)) return ac_cleanup();
-    }
-  }
+  if (!probe_ring(BedProbePoints, outer_points, mechanics.data.probe_radius)) return ac_cleanup();
+  if (!probe_ring(&BedProbePoints[outer_points], inner_points, mechanics.data.probe_radius / 2)) return ac_cleanup();
 
   BedProbePoints[probe_points - 1].x = 0.0f;
   BedProbePoints[probe_points - 1].y = 0.0f;
@@ -329,7 +270,7 @@ inline void gcode_G33() {
   // convert data.endstop_adj;
   Convert_endstop_adj();
 
-  abc_float_t probeMotorPositions[MaxCalibrationPoints];
+  abc_pos_t probeMotorPositions[MaxCalibrationPoints];
   float corrections[MaxCalibrationPoints];
 
   initialSumOfSquares = 0.0;
@@ -337,24 +278,24 @@ inline void gcode_G33() {
   // Transform the probing points to motor endpoints and store them in a matrix, so that we can do multiple iterations using the same data
   for (uint8_t i = 0; i < probe_points; ++i) {
     corrections[i] = 0.0;
-    abc_float_t machinePos = { BedProbePoints[i].x, BedProbePoints[i].y, 0.0f };
+    const xyz_pos_t machinePos = { BedProbePoints[i].x, BedProbePoints[i].y, 0.0f };
     mechanics.Transform(machinePos);
     probeMotorPositions[i] = mechanics.delta;
     initialSumOfSquares += sq(BedProbePoints[i].z);
   }
 
-  // Do 1 or more Newton-Raphson iterations
+  expectedRmsError = SQRT(initialSumOfSquares / probe_points);
+
+  // Do Newton-Raphson iterations until the fit stops improving
   do {
 
-    // Build a Nx9 matrix of derivatives
-    FixedMatrix<float, MaxCalibrationPoints, MaxnumFactors> derivativeMatrix;
+    previousRmsError = expectedRmsError;
 
-    for (uint8_t i = 0; i < probe_points; i++) {
-      for (uint8_t j = 0; j < numFactors; j++) {
-        derivativeMatrix(i, j) =
-          compute_derivative(j, probeMotorPositions[i]);
-      }
-    }
+    // Build a Nx7 matrix of derivatives
+    derivative_matrix_t derivativeMatrix;
+
+    for (uint8_t j = 0; j < numFactors; j++)
+      compute_derivatives(j, probeMotorPositions, probe_points, derivativeMatrix);
 
     // Debug Derivative matrix
     if (g33_debug) {
@@ -396,13 +337,14 @@ inline void gcode_G33() {
     }
 
     if (!normalMatrix.GaussJordan(numFactors, numFactors + 1)) {
-			SERIAL_EM("Unable to calculate calibration parameters. Please reduce probe radius.");
-			return;
-		}
+      SERIAL_EM("Unable to calculate calibration parameters. Please reduce probe radius.");
+      Convert_endstop_adj();
+      return ac_cleanup();
+    }
 
     float solution[numFactors];
     for (uint8_t i = 0; i < numFactors; ++i)
-			solution[i] = normalMatrix(i, numFactors);
+      solution[i] = normalMatrix(i, numFactors);
 
     // Debug Solved matrix, solution and residuals
     if (g33_debug) {
@@ -451,7 +393,7 @@ inline void gcode_G33() {
     expectedRmsError = SQRT((float)(sumOfSquares / probe_points));
 
     ++iteration;
-  } while (iteration < 2);
+  } while (iteration < MaxIterations && previousRmsError - expectedRmsError > MinImprovement);
 
   // convert data.endstop_adj;
   Convert_endstop_adj();
@@ -460,6 +402,8 @@ inline void gcode_G33() {
   SERIAL_MV(" factors using ", probe_points);
   SERIAL_MV(" points, deviation before ", SQRT(initialSumOfSquares / probe_points), 4);
   SERIAL_MV(" after ", expectedRmsError, 4);
+  SERIAL_MV(" in ", iteration);
+  SERIAL_MSG(" iterations");
   SERIAL_EOL();
 
   mechanics.recalc_delta_settings();
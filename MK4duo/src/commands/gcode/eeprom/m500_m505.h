@@ -35,13 +35,25 @@
 
 /**
  * M500: Store settings in EEPROM
+ *
+ *  S<section>  Store only one section, if the layout is unchanged:
+ *              0 mechanics, 1 temperature, 2 leveling, 3 general, 4 TMC
+ *
+ *  Without S only the sections changed are written.
  */
 inline void gcode_M500() {
   #if NUM_SERIAL > 1
-    gcode_t tmp = commands.buffer_ring.peek();
-    SERIAL_PORT(tmp.s_port);
+    SERIAL_PORT(commands.buffer_ring.peek().s_port);
+  #endif
+  #if HAS_EEPROM
+    if (parser.seen('S')) {
+      const uint8_t s = parser.value_byte();
+      if (s < EEPROM_SECTION_COUNT) (void)eeprom.store(_BV(s));
+      else SERIAL_LM(ER, "Invalid section");
+    }
+    else
   #endif
-  (void)eeprom.store();
+      (void)eeprom.store();
   SERIAL_PORT(-1);
 }
 
@@ -50,8 +62,7 @@ inline void gcode_M500() {
  */
 inline void gcode_M501() {
   #if NUM_SERIAL > 1
-    gcode_t tmp = commands.buffer_ring.peek();
-    SERIAL_PORT(tmp.s_port);
+    SERIAL_PORT(commands.buffer_ring.peek().s_port);
   #endif
   (void)eeprom.load();
   SERIAL_PORT(-1);
@@ -62,8 +73,7 @@ inline void gcode_M501() {
  */
 inline void gcode_M502() {
   #if NUM_SERIAL > 1
-    gcode_t tmp = commands.buffer_ring.peek();
-    SERIAL_PORT(tmp.s_port);
+    SERIAL_PORT(commands.buffer_ring.peek().s_port);
   #endif
   (void)eeprom.reset();
   SERIAL_PORT(-1);
@@ -74,8 +84,7 @@ inline void gcode_M502() {
  */
 inline void gcode_M503() {
   #if NUM_SERIAL > 1
-    gcode_t tmp = commands.buffer_ring.peek();
-    SERIAL_PORT(tmp.s_port);
+    SERIAL_PORT(commands.buffer_ring.peek().s_port);
   #endif
   (void)eeprom.Print_Settings();
   SERIAL_PORT(-1);
@@ -0,0 +1,191 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if HAS_ACCELEROMETER
+
+#define CODE_M594
+
+/**
+ * Moves of the axis to start + dist and back at the frequency, with the
+ * acceleration of the frequency for the whole move: the acceleration is a
+ * square wave of the frequency. Return the vibration measured.
+ */
+inline float resonance_moves(const AxisEnum axis, const float freq, const float accel, const float dist_sign, const float seconds) {
+
+  const float t_ramp  = 0.25f / freq,           // Accelerate and decelerate, a quarter of period each
+              dist    = accel * sq(t_ramp) * dist_sign,
+              speed   = accel * t_ramp;
+  const uint16_t cycles = MAX(2, LROUND(freq * seconds));
+
+  mechanics.data.travel_acceleration = accel;
+
+  accelerometer.mark(freq);
+
+  xyze_pos_t dest = mechanics.position;
+  const float start = dest[axis];
+  LOOP_L_N(c, cycles) {
+    dest[axis] = start + dist;
+    planner.buffer_line(dest, speed, toolManager.extruder.active);
+    dest[axis] = start;
+    planner.buffer_line(dest, speed, toolManager.extruder.active);
+  }
+  planner.synchronize();
+  accelerometer.spin();
+
+  return accelerometer.vibration();
+}
+
+/**
+ * M594: Resonance measurement with the accelerometer
+ *
+ *  X or Y      Axis to measure, one for each command. With no axis report a sample.
+ *  F<Hz>       Lowest frequency of the sweep (default RESONANCE_FREQ_MIN)
+ *  T<Hz>       Highest frequency of the sweep (default RESONANCE_FREQ_MAX)
+ *  I<Hz>       Frequency step (default RESONANCE_FREQ_STEP)
+ *  A<mm/s^2>   Acceleration for each Hz (default RESONANCE_ACCEL_PER_HZ)
+ *  S<s>        Seconds of moves at each frequency (default RESONANCE_TIME)
+ *  P           Log the samples on SD in RES_X.CSV or RES_Y.CSV
+ *  U           Use the peak as the input shaping frequency of the axis
+ *
+ * The axis moves back and forth at each frequency, the acceleration is
+ * limited to the max acceleration of the axis. The vibration is the RMS
+ * acceleration of the toolhead, the gain the vibration for 1 mm/s^2 of the
+ * moves. The peak of the gain is the resonance of the axis.
+ */
+inline void gcode_M594() {
+
+  if (!accelerometer.ready) {
+    SERIAL_LM(ER, "Accelerometer not found");
+    return;
+  }
+
+  AxisEnum axis = NO_AXIS;
+  LOOP_XY(i) if (parser.seen(axis_codes[i])) { axis = AxisEnum(i); break; }
+
+  if (axis == NO_AXIS) {
+    xyz_float_t acc;
+    const millis_l timeout = millis() + 100;
+    while (!accelerometer.read(acc) && PENDING(millis(), timeout)) printer.idle();
+    SERIAL_MV("Accelerometer X:", acc.x, 0);
+    SERIAL_MV(" Y:", acc.y, 0);
+    SERIAL_EMV(" Z:", acc.z, 0);
+    return;
+  }
+
+  if (mechanics.axis_unhomed_error(_BV(axis))) return;
+
+  const float f_min     = parser.floatval('F', RESONANCE_FREQ_MIN),
+              f_max     = parser.floatval('T', RESONANCE_FREQ_MAX),
+              f_step    = parser.floatval('I', RESONANCE_FREQ_STEP),
+              accel_hz  = parser.floatval('A', RESONANCE_ACCEL_PER_HZ),
+              seconds   = parser.floatval('S', RESONANCE_TIME),
+              accel_max = mechanics.data.max_acceleration_mm_per_s2[axis];
+
+  if (f_min <= 0 || f_max < f_min || f_step <= 0 || accel_hz <= 0 || f_max * 2 >= ACCELEROMETER_RATE) {
+    SERIAL_LM(ER, "M594 needs 0 < F <= T < half the sample rate, I > 0 and A > 0");
+    return;
+  }
+
+  // The longest move is at the lowest frequency, move where there is room
+  float dist_sign = 1;
+  #if !MECH(DELTA)
+    const float dist_max = MIN(accel_hz * f_min, accel_max) * sq(0.25f / f_min);
+    if (mechanics.position[axis] + dist_max > endstops.soft_endstop.max[axis]) dist_sign = -1;
+    if (mechanics.position[axis] - dist_max < endstops.soft_endstop.min[axis] && dist_sign < 0) {
+      SERIAL_LM(ER, "M594 no room for the moves");
+      return;
+    }
+  #endif
+
+  planner.synchronize();
+
+  // Nothing that changes the moves
+  const float     old_accel       = mechanics.data.travel_acceleration;
+  const uint32_t  old_min_segment = mechanics.data.min_segment_time_us;
+  mechanics.data.min_segment_time_us = 0;
+  #if HAS_CLASSIC_JERK
+    const float old_jerk = mechanics.data.max_jerk[axis];
+    mechanics.data.max_jerk[axis] = 0;
+  #endif
+  #if ENABLED(INPUT_SHAPING)
+    const float old_shaping = shaping.data.frequency[axis];
+    shaping.data.frequency[axis] = 0;
+    shaping.refresh();
+  #endif
+
+  char log_name[] = "RES_X.CSV";
+  log_name[4] = axis_codes[axis];
+  accelerometer.start(parser.seen('P') ? log_name : nullptr);
+
+  SERIAL_MSG("M594 ");
+  SERIAL_CHR(axis_codes[axis]);
+  SERIAL_EM(" resonance start");
+
+  float peak_freq = 0, peak_gain = 0;
+  for (float f = f_min; f <= f_max + 0.001f; f += f_step) {
+    const float accel = MIN(accel_hz * f, accel_max),
+                vibration = resonance_moves(axis, f, accel, dist_sign, seconds),
+                gain = vibration / accel;
+    SERIAL_MV(" freq:", f, 1);
+    SERIAL_MV(" vibration:", vibration, 0);
+    SERIAL_EMV(" gain:", gain, 3);
+    if (gain > peak_gain) { peak_gain = gain; peak_freq = f; }
+    if (!printer.isRunning()) break;
+  }
+
+  accelerometer.stop();
+
+  mechanics.data.travel_acceleration = old_accel;
+  mechanics.data.min_segment_time_us = old_min_segment;
+  #if HAS_CLASSIC_JERK
+    mechanics.data.max_jerk[axis] = old_jerk;
+  #endif
+
+  const bool apply = parser.seen('U');
+  #if ENABLED(INPUT_SHAPING)
+    shaping.data.frequency[axis] = apply ? peak_freq : old_shaping;
+    shaping.refresh();
+  #endif
+
+  SERIAL_MSG("M594 ");
+  SERIAL_CHR(axis_codes[axis]);
+  SERIAL_MV(" resonance peak at ", peak_freq, 1);
+  SERIAL_EM(" Hz");
+  SERIAL_MSG("M593 ");
+  SERIAL_CHR(axis_codes[axis]);
+  SERIAL_MV(" F", peak_freq, 1);
+  SERIAL_EOL();
+  #if ENABLED(INPUT_SHAPING)
+    if (!apply) SERIAL_EM("Use U to apply the value");
+  #else
+    UNUSED(apply);
+  #endif
+
+}
+
+#endif // HAS_ACCELEROMETER
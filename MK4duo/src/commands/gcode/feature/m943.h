@@ -0,0 +1,229 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if HAS_TMCX1XX && ENABLED(HYBRID_THRESHOLD) && !IS_KINEMATIC
+
+#define CODE_M943
+
+/**
+ * Drivers of an axis with stealthChop, the first one is sampled
+ */
+inline uint8_t tmc_tune_drivers(const AxisEnum axis, Driver* drv[3]) {
+  uint8_t n = 0;
+  switch (axis) {
+    case X_AXIS:
+      #if AXIS_HAS_STEALTHCHOP(X)
+        drv[n++] = driver.x;
+      #endif
+      #if AXIS_HAS_STEALTHCHOP(X2)
+        drv[n++] = driver.x2;
+      #endif
+      break;
+    case Y_AXIS:
+      #if AXIS_HAS_STEALTHCHOP(Y)
+        drv[n++] = driver.y;
+      #endif
+      #if AXIS_HAS_STEALTHCHOP(Y2)
+        drv[n++] = driver.y2;
+      #endif
+      break;
+    case Z_AXIS:
+      #if AXIS_HAS_STEALTHCHOP(Z)
+        drv[n++] = driver.z;
+      #endif
+      #if AXIS_HAS_STEALTHCHOP(Z2)
+        drv[n++] = driver.z2;
+      #endif
+      #if AXIS_HAS_STEALTHCHOP(Z3)
+        drv[n++] = driver.z3;
+      #endif
+      break;
+    default: break;
+  }
+  return n;
+}
+
+/**
+ * Move the axis by dist and back, sampling the driver while it moves:
+ *  stealthChop: the highest PWM_SCALE_SUM, 255 is the supply voltage limit
+ *  spreadCycle: the mean SG_RESULT, lower is more load and 0 is a stall
+ */
+inline uint16_t tmc_tune_move(Driver* drv, const AxisEnum axis, const float dist, const feedrate_t fr_mm_s, const bool stealth) {
+  constexpr uint8_t   STST_bp       = 31;
+  constexpr uint16_t  SG_RESULT_bm  = 0x3FF;
+
+  xyze_pos_t dest = mechanics.position;
+  dest[axis] += dist;
+  planner.buffer_line(dest, fr_mm_s, toolManager.extruder.active);
+  dest[axis] -= dist;
+  planner.buffer_line(dest, fr_mm_s, toolManager.extruder.active);
+
+  uint16_t pwm_max = 0, samples = 0;
+  uint32_t sg_sum = 0;
+
+  while (planner.has_blocks_queued()) {
+    const uint32_t ds = drv->tmc->DRV_STATUS();
+    if (!TEST32(ds, STST_bp)) {
+      if (stealth)
+        NOLESS(pwm_max, uint16_t(drv->tmc->PWM_SCALE() & 0xFF));
+      else if (samples < 0xFFFF) {
+        sg_sum += ds & SG_RESULT_bm;
+        samples++;
+      }
+    }
+    printer.idle();
+  }
+
+  return stealth ? pwm_max : (samples ? uint16_t(sg_sum / samples) : 0);
+}
+
+/**
+ * M943: TMC automatic tuning of the hybrid threshold and the current of an axis
+ *
+ *  X Y or Z  Axis to tune, one for each command
+ *  S<mm/s>   Lowest speed of the sweep (default 10)
+ *  F<mm/s>   Highest speed of the sweep (default the axis max feedrate)
+ *  P<count>  Speeds in the sweep (2-20, default 10)
+ *  D<mm>     Length of the moves (default 20)
+ *  L<sg>     Lowest mean SG_RESULT still safe in spreadCycle (default 100)
+ *  U         Use the found values
+ *
+ * The axis moves D mm and back at each speed of the sweep:
+ *  - In stealthChop with no hybrid threshold. The threshold is the highest speed
+ *    before PWM_SCALE_SUM reaches the voltage limit, where stealthChop loses torque.
+ *  - In spreadCycle at the highest speed, with the current lowered 10% at a time
+ *    down to 50%. The lowest current that keeps the mean SG_RESULT over L is kept.
+ * The result is printed as M913 and M906 commands.
+ */
+inline void gcode_M943() {
+
+  constexpr uint8_t pwm_limit = 248;
+
+  AxisEnum axis = NO_AXIS;
+  LOOP_XYZ(i) if (parser.seen(axis_codes[i])) { axis = AxisEnum(i); break; }
+  if (axis == NO_AXIS) {
+    SERIAL_LM(ER, "M943 needs an axis X, Y or Z");
+    return;
+  }
+
+  Driver* drv[3];
+  const uint8_t drv_count = tmc_tune_drivers(axis, drv);
+  if (!drv_count) return;
+
+  if (mechanics.axis_unhomed_error(_BV(axis))) return;
+
+  const float     v_min   = parser.floatval('S', 10),
+                  v_max   = parser.floatval('F', mechanics.data.max_feedrate_mm_s[axis]);
+  const uint8_t   steps   = constrain(parser.intval('P', 10), 2, 20);
+  const uint16_t  sg_low  = parser.ushortval('L', 100);
+  float           dist    = parser.floatval('D', 20);
+
+  if (v_min <= 0 || v_max <= v_min) {
+    SERIAL_LM(ER, "M943 needs 0 < S < F");
+    return;
+  }
+
+  // Move where there is room
+  if (mechanics.position[axis] + dist > mechanics.data.base_pos.max[axis]) dist = -dist;
+  if (mechanics.position[axis] + dist < mechanics.data.base_pos.min[axis]) {
+    SERIAL_LM(ER, "M943 no room for the moves");
+    return;
+  }
+
+  MKTMC* const tmc_main = drv[0]->tmc;
+  const uint32_t  old_thrs      = tmc_main->get_pwm_thrs(),
+                  old_coolthrs  = tmc_main->TCOOLTHRS();
+  const uint16_t  old_current   = tmc_main->getMilliamps();
+
+  SERIAL_MSG("M943 ");
+  SERIAL_CHR(axis_codes[axis]);
+  SERIAL_EM(" tuning start");
+
+  // stealthChop at all the speeds
+  LOOP_L_N(d, drv_count) {
+    drv[d]->tmc->en_pwm_mode(true);
+    drv[d]->tmc->TPWMTHRS(0);
+  }
+
+  float thrs = v_min;
+  bool saturated = false;
+  LOOP_L_N(s, steps) {
+    const float v = v_min + (v_max - v_min) * s / (steps - 1);
+    const uint16_t pwm = tmc_tune_move(drv[0], axis, dist, v, true);
+    SERIAL_MV(" speed:", v, 1);
+    SERIAL_EMV(" pwm_scale:", pwm);
+    if (pwm >= pwm_limit) { saturated = true; break; }
+    thrs = v;
+  }
+  if (!saturated) thrs = v_max;
+
+  // spreadCycle with StallGuard readings, at the highest speed
+  LOOP_L_N(d, drv_count) {
+    drv[d]->tmc->en_pwm_mode(false);
+    drv[d]->tmc->TCOOLTHRS(0xFFFFF);
+  }
+
+  uint16_t current = old_current;
+  for (uint8_t pct = 100; pct >= 50; pct -= 10) {
+    const uint16_t mA = uint32_t(old_current) * pct / 100;
+    LOOP_L_N(d, drv_count) drv[d]->tmc->rms_current(mA);
+    const uint16_t sg = tmc_tune_move(drv[0], axis, dist, v_max, false);
+    SERIAL_MV(" current:", mA);
+    SERIAL_EMV(" sg_result:", sg);
+    if (sg < sg_low) {
+      if (pct == 100) SERIAL_EM(" Load too high at the full current, current not lowered");
+      break;
+    }
+    current = mA;
+  }
+
+  const bool apply = parser.seen('U');
+
+  // Restore the stepping mode and set the values
+  LOOP_L_N(d, drv_count) {
+    MKTMC* const tmc = drv[d]->tmc;
+    tmc->TCOOLTHRS(old_coolthrs);
+    tmc->refresh_stepping_mode();
+    tmc->set_pwm_thrs(apply ? uint32_t(thrs) : old_thrs);
+    tmc->rms_current(apply ? current : old_current);
+  }
+
+  SERIAL_MSG("M943 ");
+  SERIAL_CHR(axis_codes[axis]);
+  SERIAL_EM(" tuning finished");
+  SERIAL_MSG("M913 ");
+  SERIAL_CHR(axis_codes[axis]);
+  SERIAL_EV(int(thrs));
+  SERIAL_MSG("M906 ");
+  SERIAL_CHR(axis_codes[axis]);
+  SERIAL_EV(current);
+  if (!apply) SERIAL_EM("Use U to apply the values");
+
+}
+
+#endif // HAS_TMCX1XX && HYBRID_THRESHOLD && !IS_KINEMATIC
@@ -36,6 +36,7 @@
  *  X[float] Sets the hysteresis distance on X (0 to disable)
  *  Y[float] Sets the hysteresis distance on Y (0 to disable)
  *  Z[float] Sets the hysteresis distance on Z (0 to disable)
+ *  S[float] Sets the smoothing distance, the correction spread along it (0 for all at once)
  *
  */
 inline void gcode_M99() {
@@ -48,6 +49,9 @@ inline void gcode_M99() {
   if (parser.seen('F'))
     hysteresis.data.correction = MAX(0, MIN(1.0, parser.value_float()));
 
+  if (parser.seen('S'))
+    hysteresis.data.smoothing_mm = MAX(0, parser.value_float());
+
   SERIAL_MSG("Hysteresis correction is ");
   if (hysteresis.data.correction == 0) SERIAL_MSG("in");
   SERIAL_EM("active:");
@@ -59,6 +63,7 @@ inline void gcode_M99() {
   SERIAL_MV(" Y", hysteresis.data.mm[Y_AXIS]);
   SERIAL_MV(" Z", hysteresis.data.mm[Z_AXIS]);
   SERIAL_EOL();
+  SERIAL_EMV("  Smoothing Distance (mm): S", hysteresis.data.smoothing_mm);
 
 }
 
@@ -60,15 +60,18 @@
 #include "config/m221.h"                  // Set extrusion percentage
 #include "config/m222.h"                  // Set density
 #include "config/m223_m224.h"             // Set Logic or Pullup filrunout
+#include "config/m225.h"                  // Set the buffer arena split
 #include "config/m228.h"                  // Set Set axis min/max travel
 #include "config/m301.h"                  // Set PID parameters Heater
 #include "config/m302.h"                  // Allow cold extrudes
 #include "config/m305.h"                  // Set thermistor and ADC parameters
 #include "config/m306.h"                  // Set Heaters
+#include "config/m307.h"                  // Set or calibrate the hotend MPC
 #include "config/m352.h"                  // Set Driver pins and logic
 #include "config/m353.h"                  // Set Number total driver extruder
 #include "config/m563.h"                  // Set Tools heater assignment
 #include "config/m575.h"                  // Change serial baud rate
+#include "config/m593.h"                  // Set input shaping
 #include "config/m595.h"                  // Set AD595 offset & Gain
 #include "config/m569.h"                  // Set Stepper Direction
 #include "config/m900.h"                  // Set and/or Get advance K factor
@@ -99,6 +102,17 @@
 
 // Debug Commands
 #include "debug/m43.h"
+#include "debug/m101.h"                   // Planner timing stats
+#include "debug/m102.h"                   // Stepper ISR profiler
+#include "debug/m103.h"                   // GCode parser benchmark
+#include "debug/m130.h"                   // Step queue mode and benchmark
+#include "debug/m131.h"                   // Idle loop profiler
+#include "debug/m132.h"                   // Planner underrun stats
+#include "debug/m133.h"                   // Idle scheduler
+#include "debug/m134.h"                   // Memory profile
+#include "debug/m135.h"                   // Motion benchmark
+#include "debug/m136.h"                   // Boot timeline
+#include "debug/m137.h"                   // Crash record
 #include "debug/m44_pre_table.h"          // Debug Code Info
 #include "debug/m1000.h"                   // Debug GCODE Parser
 
@@ -126,10 +140,12 @@
 #include "feature/m603.h"                 // Configure filament change
 #include "feature/m701_m702.h"            // Load / Unload filament
 #include "feature/m413.h"                 // Restart Job
+#include "feature/m594.h"                 // Resonance measurement
 #include "feature/m800.h"                 // Restart Job
 #include "feature/m911_m915.h"            // Set TRINAMIC driver
 #include "feature/m930_m939.h"            // Set TRINAMIC driver
 #include "feature/m940_m942.h"            // Set TRINAMIC driver
+#include "feature/m943.h"                 // TRINAMIC hybrid threshold and current tuning
 #include "feature/m922.h"                 // TMC DEBUG
 
 // Geometry Commands
@@ -144,6 +160,7 @@
 #include "host/m111.h"
 #include "host/m113.h"
 #include "host/m114.h"
+#include "host/m154.h"                    // Auto report the position
 #include "host/m115.h"
 #include "host/m118.h"
 #include "host/m119.h"                    // Endstop status print
@@ -226,6 +243,8 @@
 #include "sdcard/m30.h"
 #include "sdcard/m32.h"
 #include "sdcard/m34.h"
+#include "sdcard/m37.h"
+#include "sdcard/m38.h"
 #include "sdcard/m39.h"
 #include "sdcard/m524.h"
 
@@ -251,6 +270,7 @@
 #include "temperature/m141.h"
 #include "temperature/m142.h"
 #include "temperature/m155.h"
+#include "temperature/m156.h"             // Report the temperature history
 #include "temperature/m190.h"
 #include "temperature/m191.h"
 #include "temperature/m192.h"
@@ -269,6 +289,7 @@
   // Table for G and M code
   #include "table_gcode.h"
   #include "table_mcode.h"
+  #include "table_index.h"
 
   // Include m44 post define table for debugging
   #include "debug/m44_post_table.h"
@@ -65,6 +65,7 @@ inline void gcode_G92() {
               }
               else {
                 mechanics.position_shift[i] += d;       // Other axes simply offset the coordinate space
+                mechanics.update_workspace_offset((AxisEnum)i);
                 endstops.update_software_endstops((AxisEnum)i);
               }
             #endif
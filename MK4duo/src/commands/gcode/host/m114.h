@@ -30,9 +30,20 @@
 
 /**
  * M114: Report current position to host
+ *
+ *  D - Detail of the position
+ *  R - Position of the motors now, from the step counts, no wait for the moves
+ *  S - Step counts too
  */
 inline void gcode_M114() {
 
+  #if ENABLED(REALTIME_POSITION_REPORT)
+    if (parser.seen('R')) {
+      mechanics.report_realtime_position();
+      return;
+    }
+  #endif
+
   if (parser.seen('D')) {
     mechanics.report_position_detail();
     return;
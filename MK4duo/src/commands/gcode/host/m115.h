@@ -59,6 +59,20 @@ inline void gcode_M115() {
   // AUTOREPORT_TEMP (M155)
   SERIAL_CAP("AUTOREPORT_TEMP:1");
 
+  // BINARY_STATUS (M155 B)
+  #if ENABLED(BINARY_STATUS_REPORT)
+    SERIAL_CAP("BINARY_STATUS:1");
+  #else
+    SERIAL_CAP("BINARY_STATUS:0");
+  #endif
+
+  // AUTOREPORT_POS (M154)
+  #if ENABLED(REALTIME_POSITION_REPORT)
+    SERIAL_CAP("AUTOREPORT_POS:1");
+  #else
+    SERIAL_CAP("AUTOREPORT_POS:0");
+  #endif
+
   // PROGRESS (M530 S L, M531 <file>, M532 X L)
   SERIAL_CAP("PROGRESS:1");
 
@@ -116,6 +130,13 @@ inline void gcode_M115() {
     SERIAL_CAP("EMERGENCY_PARSER:0");
   #endif
 
+  // BINARY_GCODE (binary G0 G1 G2 G3 frames)
+  #if ENABLED(BINARY_GCODE_PROTOCOL)
+    SERIAL_CAP("BINARY_GCODE:1");
+  #else
+    SERIAL_CAP("BINARY_GCODE:0");
+  #endif
+
   // CHAMBER_TEMPERATURE (M141, M191)
   #if HAS_CHAMBERS
     SERIAL_CAP("CHAMBER_TEMPERATURE:1");
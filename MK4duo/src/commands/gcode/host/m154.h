@@ -0,0 +1,54 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(REALTIME_POSITION_REPORT)
+
+#define CODE_M154
+
+/**
+ * M154: Auto report the position from the step counts, as M114 R
+ *
+ *  S<seconds>      - Interval in seconds
+ *  P<milliseconds> - Interval in milliseconds, for hosts that follow the head
+ *  S0 or P0 disable the report
+ */
+inline void gcode_M154() {
+
+  if (parser.seenval('P'))
+    printer.autoreport_position_ms = MIN(parser.value_ulong(), 60000UL);
+  else if (parser.seenval('S'))
+    printer.autoreport_position_ms = MIN(parser.value_ulong(), 60UL) * 1000UL;
+  else {
+    SERIAL_EMV("Position report (ms): ", printer.autoreport_position_ms);
+    return;
+  }
+
+  printer.autoreport_position_timer.start();
+}
+
+#endif // REALTIME_POSITION_REPORT
@@ -30,254 +30,346 @@
 
   #define CODE_M408
 
-  char GetStatusCharacter(){
-    return  print_job_counter.isRunning() ? 'P'   // Printing
-          : print_job_counter.isPaused()  ? 'A'   // Paused / Stopped
-          :                                 'I';  // Idle
+  #if ENABLED(__AVR__)
+    #define M408_BUFFER_SIZE  96
+  #else
+    #define M408_BUFFER_SIZE 512
+  #endif
+
+  // The fields of the status, bits of M408 F
+  enum M408FieldEnum : uint8_t {
+    M408_STATUS, M408_COORDS, M408_TOOL, M408_PARAMS, M408_TEMPS, M408_STATS,
+    M408_FIELDS
+  };
+
+  /**
+   * The JSON text goes in a buffer, written to the serial when full and at the end,
+   * a short report is a single write
+   */
+  static char     m408_buffer[M408_BUFFER_SIZE];
+  static uint16_t m408_len    = 0;
+  static bool     m408_first  = true;                 // No comma before the next key or item
+  static uint8_t  m408_fields = _BV(M408_FIELDS) - 1; // M408 F
+  static uint16_t m408_crc[M408_FIELDS] = { 0 };      // Of the values last sent, for M408 D1
+
+  static void m408_flush() {
+    if (m408_len) SERIAL_OUT(write, (const uint8_t*)m408_buffer, m408_len);
+    m408_len = 0;
+  }
+
+  static void m408_chr(const char c) {
+    if (m408_len >= M408_BUFFER_SIZE) m408_flush();
+    m408_buffer[m408_len++] = c;
+  }
+
+  static void m408_txt(const char *s)   { while (*s) m408_chr(*s++); }
+  static void m408_msg(PGM_P s)         { for (char c; (c = pgm_read_byte(s)); s++) m408_chr(c); }
+  static void m408_int(const int32_t v) { char s[12]; m408_txt(ltoa(v, s, 10)); }
+  static void m408_float(const float v, const uint8_t digits=2) { char s[16]; m408_txt(dtostrf(v, 1, digits, s)); }
+
+  static void m408_item() { if (!m408_first) m408_chr(','); m408_first = false; }
+  static void m408_key(PGM_P key) { m408_item(); m408_chr('"'); m408_msg(key); m408_msg(PSTR("\":")); }
+  static void m408_open(const char c)  { m408_chr(c); m408_first = true; }
+  static void m408_close(const char c) { m408_chr(c); m408_first = false; }
+
+  static void m408_string(PGM_P key, PGM_P value) {
+    m408_key(key); m408_chr('"'); m408_msg(value); m408_chr('"');
   }
 
   /**
-   * M408: JSON STATUS OUTPUT
+   * True if the field is asked and, for a delta report, its values changed from the last report
    */
-  inline void gcode_M408() {
-    bool firstOccurrence;
-    uint8_t type = 0;
+  static bool m408_send(const M408FieldEnum f, const uint16_t crc, const bool delta) {
+    if (!TEST(m408_fields, f) || (delta && m408_crc[f] == crc)) return false;
+    m408_crc[f] = crc;
+    return true;
+  }
+
+  static uint16_t m408_hash(const void * const data, const uint16_t len, uint16_t crc=0xFFFF) {
+    crc16(&crc, data, len);
+    return crc;
+  }
 
-    if (parser.seen('S')) type = parser.value_byte();
+  char GetStatusCharacter() {
+    return  print_job_counter.isRunning() ? 'P'   // Printing
+          : print_job_counter.isPaused()  ? 'A'   // Paused / Stopped
+          :                                 'I';  // Idle
+  }
 
-    char ch = GetStatusCharacter();
-    SERIAL_MSG("{\"status\":\"");
-    SERIAL_CHR(ch);
+  static void m408_status(const bool delta) {
 
-    SERIAL_MSG("\",\"coords\": {\"axesHomed\":[");
-    if (mechanics.isHomedAll())
-      SERIAL_MSG("1, 1, 1");
-    else
-      SERIAL_MSG("0, 0, 0");
+    const char ch = GetStatusCharacter();
+    if (m408_send(M408_STATUS, m408_hash(&ch, 1), delta)) {
+      m408_key(PSTR("status"));
+      m408_chr('"'); m408_chr(ch); m408_chr('"');
+    }
 
-    SERIAL_MV("],\"extr\":[", mechanics.position.e);
-    SERIAL_MV("],\"xyz\":[", mechanics.position.x); // X AXIS
-    SERIAL_MV(",", mechanics.position.y);           // Y AXIS
-    SERIAL_MV(",", mechanics.position.z);           // Z AXIS
+    const bool homed = mechanics.isHomedAll();
+    if (m408_send(M408_COORDS, m408_hash(&mechanics.position, sizeof(mechanics.position), m408_hash(&homed, 1)), delta)) {
+      m408_key(PSTR("coords"));
+      m408_open('{');
+        m408_key(PSTR("axesHomed"));
+        m408_msg(homed ? PSTR("[1,1,1]") : PSTR("[0,0,0]"));
+        m408_key(PSTR("extr"));
+        m408_open('['); m408_item(); m408_float(mechanics.position.e); m408_close(']');
+        m408_key(PSTR("xyz"));
+        m408_open('[');
+          LOOP_XYZ(i) { m408_item(); m408_float(mechanics.position[i]); }
+        m408_close(']');
+      m408_close('}');
+    }
 
-    SERIAL_MV("]},\"currentTool\":", toolManager.extruder.active);
+    const uint8_t tool = toolManager.extruder.active;
+    if (m408_send(M408_TOOL, m408_hash(&tool, 1), delta)) {
+      m408_key(PSTR("currentTool"));
+      m408_int(tool);
+    }
 
+    uint16_t crc = m408_hash(&mechanics.feedrate_percentage, sizeof(mechanics.feedrate_percentage));
     #if HAS_POWER_SWITCH
-      SERIAL_MSG(",\"params\": {\"atxPower\":");
-      SERIAL_CHR(powerManager.is_on() ? '1' : '0');
-    #else
-      SERIAL_MSG(",\"params\": {\"NormPower\":");
+      const bool power = powerManager.is_on();
+      crc = m408_hash(&power, 1, crc);
     #endif
-
     #if HAS_FAN
-      SERIAL_MSG(",\"fanPercent\":[");
-      SERIAL_VAL(fans[0]->speed);
+      const uint8_t fan_speed = fanManager.data.fans ? fans[0]->speed : 0;
+      crc = m408_hash(&fan_speed, 1, crc);
     #endif
-
-    SERIAL_MV("],\"speedFactor\":", mechanics.feedrate_percentage);
-
-    SERIAL_MSG(",\"extrFactors\":[");
-    firstOccurrence = true;
-    LOOP_EXTRUDER() {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_VAL(extruders[e]->flow_percentage);
-      firstOccurrence = false;
+    LOOP_EXTRUDER() crc = m408_hash(&extruders[e]->flow_percentage, sizeof(extruders[e]->flow_percentage), crc);
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      const int16_t watt = int16_t(powerManager.consumption_meas);
+      crc = m408_hash(&watt, sizeof(watt), crc);
+    #endif
+    if (m408_send(M408_PARAMS, crc, delta)) {
+      m408_key(PSTR("params"));
+      m408_open('{');
+        #if HAS_POWER_SWITCH
+          m408_key(PSTR("atxPower"));
+          m408_chr(power ? '1' : '0');
+        #endif
+        #if HAS_FAN
+          m408_key(PSTR("fanPercent"));
+          m408_open('['); m408_item(); m408_int(fan_speed); m408_close(']');
+        #endif
+        #if HAS_POWER_CONSUMPTION_SENSOR
+          m408_key(PSTR("power"));
+          m408_int(watt);
+        #endif
+        m408_key(PSTR("speedFactor"));
+        m408_int(mechanics.feedrate_percentage);
+        m408_key(PSTR("extrFactors"));
+        m408_open('[');
+          LOOP_EXTRUDER() { m408_item(); m408_int(extruders[e]->flow_percentage); }
+        m408_close(']');
+      m408_close('}');
     }
-    SERIAL_EM("]},");
 
-    SERIAL_MSG("\"temps\": {");
+    // The temperatures as sent, with one decimal
+    crc = 0xFFFF;
     #if HAS_BEDS
-      SERIAL_MV("\"bed\": {\"current\":", beds[0]->deg_current(), 1);
-      SERIAL_MV(",\"active\":", beds[0]->deg_target());
-      SERIAL_MSG(",\"state\":");
-      SERIAL_CHR(beds[0]->deg_target() > 0 ? '2' : '1');
-      SERIAL_MSG("},");
+      const bool has_bed = tempManager.heater.beds;
+      const int16_t bed_temp[2] = {
+        has_bed ? int16_t(beds[0]->current_temperature * 10.0f) : int16_t(0),
+        has_bed ? beds[0]->deg_target() : int16_t(0)
+      };
+      crc = m408_hash(bed_temp, sizeof(bed_temp), crc);
     #endif
-    SERIAL_MSG("\"heads\": {\"current\":[");
-    firstOccurrence = true;
-    for (int8_t h = 0; h < HOTENDS; h++) {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_VAL(hotends[h]->deg_current(), 1);
-      firstOccurrence = false;
-    }
-    SERIAL_MSG("],\"active\":[");
-    firstOccurrence = true;
     LOOP_HOTEND() {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_VAL(hotends[h]->deg_target());
-      firstOccurrence = false;
+      const int16_t temp[2] = { int16_t(hotends[h]->current_temperature * 10.0f), hotends[h]->deg_target() };
+      crc = m408_hash(temp, sizeof(temp), crc);
     }
-    SERIAL_MSG("],\"state\":[");
-    firstOccurrence = true;
-    LOOP_HOTEND() {
-      if (!firstOccurrence) SERIAL_CHR(',');
-      SERIAL_CHR(hotends[h]->deg_target() > HOTEND_AUTO_FAN_TEMPERATURE ? '2' : '1');
-      firstOccurrence = false;
+    if (m408_send(M408_TEMPS, crc, delta)) {
+      m408_key(PSTR("temps"));
+      m408_open('{');
+        #if HAS_BEDS
+          if (has_bed) {
+            m408_key(PSTR("bed"));
+            m408_open('{');
+              m408_key(PSTR("current")); m408_float(bed_temp[0] * 0.1f, 1);
+              m408_key(PSTR("active"));  m408_int(bed_temp[1]);
+              m408_key(PSTR("state"));   m408_chr(bed_temp[1] > 0 ? '2' : '1');
+            m408_close('}');
+          }
+        #endif
+        m408_key(PSTR("heads"));
+        m408_open('{');
+          m408_key(PSTR("current"));
+          m408_open('[');
+            LOOP_HOTEND() { m408_item(); m408_float(hotends[h]->current_temperature, 1); }
+          m408_close(']');
+          m408_key(PSTR("active"));
+          m408_open('[');
+            LOOP_HOTEND() { m408_item(); m408_int(hotends[h]->deg_target()); }
+          m408_close(']');
+          m408_key(PSTR("state"));
+          m408_open('[');
+            LOOP_HOTEND() { m408_item(); m408_chr(hotends[h]->deg_target() > 0 ? '2' : '1'); }
+          m408_close(']');
+        m408_close('}');
+      m408_close('}');
+    }
+
+    // Always sent, the time of the report
+    m408_key(PSTR("time"));
+    m408_int(HAL::timeInMilliseconds());
+
+    if (TEST(m408_fields, M408_STATS)) {
+      #if ENABLED(STEPPER_ISR_PROFILER) || ENABLED(PLANNER_UNDERRUN_STATS)
+        m408_flush();   // These are printed, with their leading comma
+      #endif
+      #if ENABLED(STEPPER_ISR_PROFILER)
+        isrProfiler.print_json();
+      #endif
+      #if ENABLED(PLANNER_UNDERRUN_STATS)
+        planner.print_underrun_json();
+      #endif
     }
+  }
+
+  static void m408_tools() {
+    m408_string(PSTR("geometry"),
+      #if MECH(CARTESIAN)
+        PSTR("cartesian")
+      #elif MECH(COREXY)
+        PSTR("corexy")
+      #elif MECH(COREYX)
+        PSTR("coreyx")
+      #elif MECH(COREXZ)
+        PSTR("corexz")
+      #elif MECH(COREZX)
+        PSTR("corezx")
+      #elif MECH(DELTA)
+        PSTR("delta")
+      #else
+        PSTR("other")
+      #endif
+    );
+    m408_string(PSTR("name"), PSTR(CUSTOM_MACHINE_NAME));
+    m408_key(PSTR("tools"));
+    m408_open('[');
+      LOOP_EXTRUDER() {
+        m408_item();
+        m408_open('{');
+          m408_key(PSTR("number"));  m408_int(e + 1);
+          m408_key(PSTR("hotends"));
+          m408_open('['); m408_item(); m408_int(extruders[e]->get_hotend() + 1); m408_close(']');
+          m408_key(PSTR("drives"));
+          m408_open('['); m408_item(); m408_int(extruders[e]->get_driver()); m408_close(']');
+        m408_close('}');
+      }
+    m408_close(']');
+  }
+
+  static void m408_job() {
+    m408_key(PSTR("currentLayer"));
+    #if HAS_SD_SUPPORT
+      m408_int(IS_SD_PRINTING() && card.layerHeight > 0 ? int(mechanics.position.z / card.layerHeight) : 0);
+    #else
+      m408_int(-1);
+    #endif
+    m408_key(PSTR("extrRaw"));
+    m408_open('[');
+      LOOP_EXTRUDER() { m408_item(); m408_float(mechanics.position.e * extruders[e]->flow_percentage * 0.01f); }
+    m408_close(']');
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      m408_key(PSTR("jobEnergy"));
+      m408_float(powerManager.job_energy(), 3);
+    #endif
+    #if HAS_SD_SUPPORT
+      if (IS_SD_PRINTING()) {
+        const float fraction = card.fileSize < 2000000
+          ? float(card.sdpos) / float(card.fileSize)
+          : float(card.sdpos >> 8) / float(card.fileSize >> 8);
+        m408_key(PSTR("fractionPrinted"));
+        m408_float(floorf(fraction * 1000) / 1000, 3);
+      }
+      m408_key(PSTR("firstLayerHeight"));
+      m408_float(IS_SD_PRINTING() ? card.firstlayerHeight : 0.0f);
+    #else
+      m408_key(PSTR("firstLayerHeight"));
+      m408_chr('0');
+    #endif
+  }
+
+  static void m408_config() {
+    m408_key(PSTR("axisMins"));
+    m408_open('[');
+      m408_item(); m408_int(X_MIN_BED);
+      m408_item(); m408_int(Y_MIN_BED);
+      m408_item(); m408_int(Z_MIN_BED);
+    m408_close(']');
+    m408_key(PSTR("axisMaxes"));
+    m408_open('[');
+      m408_item(); m408_int(X_MAX_BED);
+      m408_item(); m408_int(Y_MAX_BED);
+      m408_item(); m408_int(Z_MAX_BED);
+    m408_close(']');
+    m408_key(PSTR("accelerations"));
+    m408_open('[');
+      LOOP_XYZ(i) { m408_item(); m408_int(mechanics.data.max_acceleration_mm_per_s2[i]); }
+      LOOP_EXTRUDER() { m408_item(); m408_int(extruders[e]->data.max_acceleration_mm_per_s2); }
+    m408_close(']');
+    m408_string(PSTR("firmwareElectronics"),
+      #if MB(RAMPS_13_HFB) || MB(RAMPS_13_HHB) || MB(RAMPS_13_HFF) || MB(RAMPS_13_HHF) || MB(RAMPS_13_HHH)
+        PSTR("RAMPS")
+      #elif MB(ALLIGATOR_R2)
+        PSTR("ALLIGATOR_R2")
+      #elif MB(ALLIGATOR_R3)
+        PSTR("ALLIGATOR_R3")
+      #elif MB(RADDS) || MB(RAMPS_FD_V1) || MB(RAMPS_FD_V2) || MB(SMART_RAMPS) || MB(RAMPS4DUE)
+        PSTR("Arduino due")
+      #elif MB(ULTRATRONICS)
+        PSTR("ULTRATRONICS")
+      #elif ENABLED(__AVR__)
+        PSTR("AVR")
+      #else
+        PSTR("ARM")
+      #endif
+    );
+    m408_string(PSTR("firmwareName"), PSTR(FIRMWARE_NAME));
+    m408_string(PSTR("firmwareVersion"), PSTR(SHORT_BUILD_VERSION));
+    m408_string(PSTR("firmwareDate"), PSTR(STRING_REVISION_DATE));
+    m408_key(PSTR("minFeedrates"));
+    m408_open('[');
+      LOOP_XYZ(i) { m408_item(); m408_chr('0'); }
+      LOOP_EXTRUDER() { m408_item(); m408_chr('0'); }
+    m408_close(']');
+    m408_key(PSTR("maxFeedrates"));
+    m408_open('[');
+      LOOP_XYZ(i) { m408_item(); m408_float(mechanics.data.max_feedrate_mm_s[i]); }
+      LOOP_EXTRUDER() { m408_item(); m408_float(extruders[e]->data.max_feedrate_mm_s); }
+    m408_close(']');
+  }
+
+  /**
+   * M408: JSON STATUS OUTPUT
+   *
+   *  S<type>   0 and 1 status, 2 with the tools, 3 with the job, 4 and 5 with the configuration
+   *  F<mask>   Fields of the status, kept for the next reports (default all):
+   *            1 status, 2 coords, 4 currentTool, 8 params, 16 temps, 32 isr and underrun stats
+   *  D<bool>   Delta, only the fields changed since the last report ("time" is always sent)
+   */
+  inline void gcode_M408() {
+
+    const uint8_t type = parser.byteval('S');
+    if (parser.seenval('F')) m408_fields = parser.value_byte() & (_BV(M408_FIELDS) - 1);
+    const bool delta = parser.boolval('D');
 
-    SERIAL_MV("]}},\"time\":", HAL::timeInMilliseconds());
+    m408_len = 0;
+    m408_open('{');
+
+    m408_status(delta);
 
     switch (type) {
-      case 0:
-      case 1:
-        break;
-      case 2:
-        SERIAL_EM(",");
-        SERIAL_MSG("\"coldExtrudeTemp\":0,\"coldRetractTemp\":0.0,\"geometry\":\"");
-        #if MECH(CARTESIAN)
-          SERIAL_MSG("cartesian");
-        #elif MECH(COREXY)
-          SERIAL_MSG("corexy");
-        #elif MECH(COREYX)
-          SERIAL_MSG("coreyx");
-        #elif MECH(COREXZ)
-          SERIAL_MSG("corexz");
-        #elif MECH(COREZX)
-          SERIAL_MSG("corezx");
-        #elif MECH(DELTA)
-          SERIAL_MSG("delta");
-        #endif
-        SERIAL_MSG("\",\"name\":\"");
-        SERIAL_MSG(CUSTOM_MACHINE_NAME);
-        SERIAL_MSG("\",\"tools\":[");
-        firstOccurrence = true;
-        LOOP_EXTRUDER() {
-          if (!firstOccurrence) SERIAL_CHR(',');
-          SERIAL_MV("{\"number\":", i + 1);
-          #if HOTENDS > 1
-            SERIAL_MV(",\"hotends\":[", i + 1);
-            SERIAL_MSG("],");
-          #else
-            SERIAL_MSG(",\"hotends\":[1],");
-          #endif
-          if (driver.e[i]) {
-            SERIAL_MV("\"drives\":[", i);
-            SERIAL_MSG("]");
-          }
-          SERIAL_MSG("}");
-          firstOccurrence = false;
-        }
-        break;
-      case 3:
-        SERIAL_EM(",");
-        SERIAL_MSG("\"printer.currentLayer\":");
-        #if HAS_SD_SUPPORT
-          if (IS_SD_PRINTING() && card.layerHeight > 0) { // ONLY CAN TELL WHEN SD IS PRINTING
-            SERIAL_VAL((int) (mechanics.position.z / card.layerHeight));
-          }
-          else SERIAL_VAL(0);
-        #else
-          SERIAL_VAL(-1);
-        #endif
-        SERIAL_MSG(",\"extrRaw\":[");
-        firstOccurrence = true;
-        LOOP_EXTRUDER() {
-          if (!firstOccurrence) SERIAL_CHR(',');
-          SERIAL_VAL(mechanics.position.e * toolManager.flow_percentage[e]);
-          firstOccurrence = false;
-        }
-        SERIAL_MSG("],");
-        #if HAS_SD_SUPPORT
-          if (IS_SD_PRINTING()) {
-            SERIAL_MSG("\"fractionPrinted\":");
-            float fractionprinted;
-            if (card.fileSize < 2000000) {
-              fractionprinted = (float)card.sdpos / (float)card.fileSize;
-            }
-            else fractionprinted = (float)(card.sdpos >> 8) / (float)(card.fileSize >> 8);
-            SERIAL_VAL((float) floorf(fractionprinted * 1000) / 1000);
-            SERIAL_CHR(',');
-          }
-        #endif
-        SERIAL_MSG("\"firstLayerHeight\":");
-        #if HAS_SD_SUPPORT
-          if (IS_SD_PRINTING()) SERIAL_VAL(card.firstlayerHeight);
-          else SERIAL_MSG("0");
-        #else
-          SERIAL_MSG("0");
-        #endif
-        break;
+      case 2: m408_tools();   break;
+      case 3: m408_job();     break;
       case 4:
-      case 5:
-        SERIAL_EM(",");
-        SERIAL_MSG("\"axisMins\":[");
-        SERIAL_VAL((int) X_MIN_BED);
-        SERIAL_CHR(',');
-        SERIAL_VAL((int) Y_MIN_BED);
-        SERIAL_CHR(',');
-        SERIAL_VAL((int) Z_MIN_BED);
-        SERIAL_MSG("],\"axisMaxes\":[");
-        SERIAL_VAL((int) X_MAX_BED);
-        SERIAL_CHR(',');
-        SERIAL_VAL((int) Y_MAX_BED);
-        SERIAL_CHR(',');
-        SERIAL_VAL((int) Z_MAX_BED);
-        SERIAL_MSG("],\"planner.accelerations\":[");
-        SERIAL_VAL(mechanics.data.max_acceleration_mm_per_s2.x);
-        SERIAL_CHR(',');
-        SERIAL_VAL(mechanics.data.max_acceleration_mm_per_s2.y);
-        SERIAL_CHR(',');
-        SERIAL_VAL(mechanics.data.max_acceleration_mm_per_s2.z);
-        LOOP_EXTRUDER() {
-          SERIAL_CHR(',');
-          SERIAL_VAL(extruders[e]->data.max_acceleration_mm_per_s2);
-        }
-        SERIAL_MSG("],");
-
-        #if MB(ALLIGATOR_R2) || MB(ALLIGATOR_R3)
-          SERIAL_MSG("\"currents\":[");
-          SERIAL_VAL(driver.x->data.ma);
-          SERIAL_CHR(',');
-          SERIAL_VAL(driver.y->data.ma);
-          SERIAL_CHR(',');
-          SERIAL_VAL(driver.z->data.ma);
-          LOOP_DRV_EXT() {
-            SERIAL_CHR(',');
-            SERIAL_VAL(driver.e[d]->data.ma);
-          }
-          SERIAL_EM("],");
-        #endif
-
-        SERIAL_MSG("\"firmwareElectronics\":\"");
-        #if MB(RAMPS_13_HFB) || MB(RAMPS_13_HHB) || MB(RAMPS_13_HFF) || MB(RAMPS_13_HHF) || MB(RAMPS_13_HHH)
-          SERIAL_MSG("RAMPS");
-        #elif MB(ALLIGATOR_R2)
-          SERIAL_MSG("ALLIGATOR_R2");
-        #elif MB(ALLIGATOR_R3)
-          SERIAL_MSG("ALLIGATOR_R3");
-        #elif MB(RADDS) || MB(RAMPS_FD_V1) || MB(RAMPS_FD_V2) || MB(SMART_RAMPS) || MB(RAMPS4DUE)
-          SERIAL_MSG("Arduino due");
-        #elif MB(ULTRATRONICS)
-          SERIAL_MSG("ULTRATRONICS");
-        #else
-          SERIAL_MSG("AVR");
-        #endif
-        SERIAL_MSG("\",\"firmwareName\":\"");
-        SERIAL_MSG(FIRMWARE_NAME);
-        SERIAL_MSG(",\"firmwareVersion\":\"");
-        SERIAL_MSG(SHORT_BUILD_VERSION);
-        SERIAL_MSG("\",\"firmwareDate\":\"");
-        SERIAL_MSG(STRING_REVISION_DATE);
-
-        SERIAL_MSG("\",\"minFeedrates\":[0,0,0");
-        LOOP_EXTRUDER() {
-          SERIAL_MSG(",0");
-        }
-        SERIAL_MSG("],\"maxFeedrates\":[");
-        SERIAL_VAL(mechanics.data.max_feedrate_mm_s.x);
-        SERIAL_CHR(',');
-        SERIAL_VAL(mechanics.data.max_feedrate_mm_s.y);
-        SERIAL_CHR(',');
-        SERIAL_VAL(mechanics.data.max_feedrate_mm_s.z);
-        LOOP_EXTRUDER()
-          SERIAL_CHR(',');
-          SERIAL_VAL(extruders[e]->data.max_feedrate_mm_s);
-        }
-        SERIAL_CHR(']');
-        break;
+      case 5: m408_config();  break;
+      default: break;
     }
-    SERIAL_CHR('}');
-    SERIAL_EOL();
+
+    m408_close('}');
+    m408_chr('\n');
+    m408_flush();
   }
 
 #endif // ENABLED(JSON_OUTPUT)
@@ -31,6 +31,17 @@
 
 void gcode_M73_M532() {
 
+  #if ENABLED(PRINT_TIME_ESTIMATION)
+    // No value, report the progress and the minutes left of the estimate of M37
+    if (!parser.seen('P') && !parser.seen('X') && !parser.seen('L')) {
+      const uint32_t elapsed = print_job_counter.duration(),
+                     left    = card.estimated_time > elapsed ? card.estimated_time - elapsed : 0;
+      SERIAL_MV("M73 P", int(printer.progress));
+      SERIAL_EMV(" R", int(CEIL(left / 60.0f)));
+      return;
+    }
+  #endif
+
   if (parser.seen('P') || parser.seen('X')) {
     printer.progress = parser.value_byte();
     NOMORE(printer.progress, 100);
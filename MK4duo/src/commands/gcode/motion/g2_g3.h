@@ -41,6 +41,10 @@
  * Arcs should only be made relatively large (over 5mm), as larger arcs with
  * larger segments will tend to be more efficient. Your slicer should have
  * options for G2/G3 arc generation. In future these options may be GCode tunable.
+ *
+ * With ARC_CHORD_TOLERANCE the segment length is the longest chord that is off
+ * the arc by ARC_CHORD_TOLERANCE at most, sqrt(8 * radius * tolerance), but not
+ * shorter than the feedrate over ARC_SEGMENTS_PER_SEC.
  */
 void plan_arc(
   const xyze_pos_t &cart,   // Destination position
@@ -96,8 +100,20 @@ void plan_arc(
               mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
   if (mm_of_travel < 0.001f) return;
 
-  uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
-  if (segments == 0) segments = 1;
+  const feedrate_t fr_mm_s = MMS_SCALED(mechanics.feedrate_mm_s);
+
+  #if ENABLED(ARC_CHORD_TOLERANCE)
+    // The sagitta of a chord c is about c^2 / (8 * radius)
+    float seg_length = SQRT(8.0f * radius * (ARC_CHORD_TOLERANCE));
+    NOLESS(seg_length, fr_mm_s * (1.0f / (ARC_SEGMENTS_PER_SEC)));
+    uint16_t segments = FLOOR(mm_of_travel / seg_length);
+    NOLESS(segments, min_segments);
+    seg_length = mm_of_travel / segments;
+  #else
+    constexpr float seg_length = MM_PER_ARC_SEGMENT;
+    uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
+    if (segments == 0) segments = 1;
+  #endif
 
   /**
    * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -139,10 +155,38 @@ void plan_arc(
   // Initialize the extruder axis
   raw[E_AXIS] = mechanics.position.e;
 
-  const feedrate_t fr_mm_s = MMS_SCALED(mechanics.feedrate_mm_s);
-
   #if ENABLED(SCARA_FEEDRATE_SCALING)
-    const float inv_duration = fr_mm_s / MM_PER_ARC_SEGMENT;
+    const float inv_duration = fr_mm_s / seg_length;
+  #endif
+
+  #if !IS_KINEMATIC
+    /**
+     * Without leveling the only modifiers are the retract and the babystep offset,
+     * the same for the whole arc, so the chords go straight to buffer_segment()
+     * with their offset added, as apply_modifiers() does for the last chord.
+     */
+    #if HAS_LEVELING
+      const bool direct = !bedlevel.flag.leveling_active;
+    #else
+      constexpr bool direct = true;
+    #endif
+    xyze_float_t shift{0.0f};
+    #if ENABLED(FWRETRACT)
+      planner.apply_retract(shift);
+    #endif
+    #if ENABLED(BABYSTEP_PLANNER)
+      shift.z += babystep.z_offset;
+    #endif
+
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      // On a router the Stepper can trace the arc itself, without the chords
+      if (direct && p_axis == X_AXIS
+        && planner.buffer_arc(mechanics.position + shift, cart + shift, xy_pos_t({ center_P, center_Q }), angular_travel, fr_mm_s, toolManager.extruder.active)
+      ) {
+        mechanics.position = cart;
+        return;
+      }
+    #endif
   #endif
 
   short_timer_t next_idle_timer(millis());
@@ -192,11 +236,18 @@ void plan_arc(
 
     endstops.apply_motion_limits(raw);
 
+    #if !IS_KINEMATIC
+      if (direct) {
+        if (!planner.buffer_segment(raw + shift, fr_mm_s, toolManager.extruder.active, seg_length)) break;
+        continue;
+      }
+    #endif
+
     #if HAS_LEVELING && !PLANNER_LEVELING
       bedlevel.apply_leveling(raw);
     #endif
 
-    if (!planner.buffer_line(raw, fr_mm_s, toolManager.extruder.active, MM_PER_ARC_SEGMENT
+    if (!planner.buffer_line(raw, fr_mm_s, toolManager.extruder.active, seg_length
       #if ENABLED(SCARA_FEEDRATE_SCALING)
         , inv_duration
       #endif
@@ -216,7 +267,7 @@ void plan_arc(
     bedlevel.apply_leveling(raw);
   #endif
 
-  planner.buffer_line(raw, fr_mm_s, toolManager.extruder.active, MM_PER_ARC_SEGMENT
+  planner.buffer_line(raw, fr_mm_s, toolManager.extruder.active, seg_length
     #if ENABLED(SCARA_FEEDRATE_SCALING)
       , inv_duration
     #endif
@@ -36,6 +36,9 @@ inline void gcode_G4() {
   if (parser.seenval('P')) dwell_ms = parser.value_millis();              // milliseconds to wait
   if (parser.seenval('S')) dwell_ms = parser.value_millis_from_seconds(); // seconds to wait
   planner.synchronize();
+  #if HAS_TIME_WARP
+    if (planner.time_warp) { planner.time_warp_dwell(dwell_ms); return; }
+  #endif
   if (!lcdui.has_status()) LCD_MESSAGEPGM(MSG_DWELL);
   printer.safe_delay(dwell_ms);
 }
@@ -30,6 +30,15 @@
 
   #define CODE_G7
 
+  /**
+   * G7: Raster line
+   *
+   *  L<len>    Length of the base64 data of D
+   *  $<dir>    Direction, with a line feed
+   *  @<dir>    Direction, with a line feed unless LASER_RASTER_MANUAL_Y_FEED
+   *  D<data>   The pixels in base64
+   *  B<count>  The pixels as raw bytes after the line, with LASER_RASTER_BINARY
+   */
   inline void gcode_G7() {
 
     if (parser.seenval('L')) laser.raster_raw_length = parser.value_int();
@@ -60,6 +69,15 @@
       #endif
     }
 
+    #if ENABLED(LASER_RASTER_BINARY)
+      if (parser.seen('B')) {
+        if (!laser.raster_stream_pop()) {
+          SERIAL_LM(ER, "G7 B with no raster line");
+          return;
+        }
+      }
+      else
+    #endif
     if (parser.seen('D')) laser.raster_num_pixels = base64_decode(laser.raster_data, parser.string_arg + 1, laser.raster_raw_length);
 
     switch (laser.raster_direction) {
@@ -38,6 +38,9 @@
 
   #define CODE_M650
   #define CODE_M651
+  #if ENABLED(DLP_LAYER_CYCLE)
+    #define CODE_M652
+  #endif
   #define CODE_M653
   #define CODE_M654
   #define CODE_M655
@@ -59,6 +62,10 @@
     // an M654 command via manual GCode before running a new print job. If not, then the platform is currently tilted, and
     // your print job is going to go poorly.
     tilted = false;
+
+    #if ENABLED(DLP_LAYER_CYCLE)
+      dlpcycle.set_peel(peel_distance, peel_speed, retract_speed, peel_pause, tilt_distance, layer_thickness);
+    #endif
   }
 
   // M651: Run peel move and return back to start.
@@ -75,6 +82,26 @@
     planner.synchronize();
   }
 
+  #if ENABLED(DLP_LAYER_CYCLE)
+
+    /**
+     * M652: Queue the cycle of the layer at the current Z, the ok comes at once
+     *
+     *  E<ms> Exposure time
+     *  S<ms> Settle time of the resin before the exposure, kept for the next layers
+     *  O<ms> Exposure triggered that much before the end of the settle, kept for the next layers
+     *  T     Tilt instead of the peel
+     *
+     * Then the peel (M650 D S P) or the tilt (M650 T R P) and the move to the next layer (M650 H).
+     */
+    inline void gcode_M652() {
+      if (parser.seenval('S')) dlpcycle.settle_time = parser.value_millis();
+      if (parser.seenval('O')) dlpcycle.overlap_time = parser.value_millis();
+      dlpcycle.queue_layer(parser.seenval('E') ? parser.value_millis() : 0, parser.seen('T'));
+    }
+
+  #endif
+
   // M653: Execute tilt move
   inline void gcode_M653() {
     // Double tilts are not allowed.
@@ -33,8 +33,26 @@
 
 /**
  * M28: Start SD Write
+ *
+ *  M28 <file>            The next lines go in the file, up to M29
+ *  M28 B<bytes> <file>   The next bytes of the serial go in the file, with SD_UPLOAD_BLOCKS
  */
-inline void gcode_M28() { card.startWrite(parser.string_arg, false); }
+inline void gcode_M28() {
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    const char * const arg = parser.string_arg;
+    if (arg && arg[0] == 'B' && NUMERIC(arg[1])) {
+      char *name;
+      const uint32_t size = strtoul(arg + 1, &name, 10);
+      while (*name == ' ') name++;
+      if (size && *name)
+        card.startUpload(name, size);
+      else
+        SERIAL_LM(ER, "M28 B needs a size and a file name");
+      return;
+    }
+  #endif
+  card.startWrite(parser.string_arg, false);
+}
 
 /**
  * M29: Stop SD Write
@@ -0,0 +1,53 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if HAS_SD_SUPPORT && ENABLED(PRINT_TIME_ESTIMATION)
+
+#define CODE_M37
+
+/**
+ * M37: Print time estimate of a file
+ *
+ *  M37 <file>  Run the file in simulation, the planner times the moves
+ *              and the time is reported at the end of the file
+ *  M37         Report the time of the last estimated file
+ *
+ * Heaters, fans and homing are skipped as in M111 S128, so waits for
+ * temperature and homing moves are not in the time.
+ */
+inline void gcode_M37() {
+  if (!card.isMounted()) return;
+
+  char* name = parser.string_arg;
+  if (name && *name)
+    card.estimateFile(name);
+  else
+    SERIAL_LMV(ECHO, "Print time estimate seconds: ", card.estimated_time);
+}
+
+#endif // HAS_SD_SUPPORT && PRINT_TIME_ESTIMATION
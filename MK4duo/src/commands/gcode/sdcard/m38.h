@@ -0,0 +1,60 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if HAS_SD_SUPPORT && ENABLED(SD_JOB_QUEUE)
+
+#define CODE_M38
+
+/**
+ * M38: SD job queue
+ *
+ *  M38 <file>  Add the file, a path from the root, at the end of the queue
+ *  M38         List the queue
+ *  M38 D<n>    Remove the job n, 1 is the first. D0 clears the queue
+ *  M38 S1      Print the queue from the first job
+ *
+ * At the end of each job SD_JOB_QUEUE_SCRIPT runs and the next job starts.
+ */
+inline void gcode_M38() {
+  if (!card.isMounted()) return;
+
+  if (parser.seenval('D'))
+    jobqueue.remove(parser.value_byte());
+  else if (parser.seenval('S')) {
+    if (parser.value_bool()) jobqueue.start();
+  }
+  else {
+    char* name = parser.string_arg;
+    if (name && *name)
+      jobqueue.add(name);
+    else
+      jobqueue.list();
+  }
+}
+
+#endif // HAS_SD_SUPPORT && SD_JOB_QUEUE
@@ -73,8 +73,7 @@
    * M406: Turn off filament sensor for control
    */
   inline void gcode_M406() {
-    filament_sensor = false;
-    toolManager.calculate_volumetric_multipliers();   // Restore correct 'volumetric_multiplier' value
+    filament_sensor = false;    // The next blocks take the nominal width
   }
 
   /**
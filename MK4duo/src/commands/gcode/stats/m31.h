@@ -32,7 +32,7 @@
  * M31: Get the time since the start of SD Print
  */
 inline void gcode_M31() {
-  char buffer[21];
+  char buffer[22];
   duration_t(print_job_counter.duration()).toString(buffer);
   lcdui.set_status(buffer);
   SERIAL_LMT(ECHO, "Print time: ", buffer);
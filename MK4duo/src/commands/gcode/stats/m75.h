@@ -31,4 +31,4 @@
 /**
  * M75: Start print timer
  */
-inline void gcode_M75() { print_job_counter.start(); }
+inline void gcode_M75() { if (!printer.debugSimulation()) print_job_counter.start(); }
@@ -0,0 +1,79 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * table_index.h
+ *
+ * Direct index from the code number to its entry in GCode_Table and MCode_Table,
+ * built by the compiler from the same sorted tables. Dispatch is a lookup and a
+ * call, codes above the index (M1000, M9999) fall back to a short search.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(__AVR__)
+  typedef uint8_t code_index_t;
+  #define CODE_INDEX_NONE   0xFF
+  #define CODE_INDEX_READ(A,C) pgm_read_byte(&A[C])
+#else
+  typedef uint16_t code_index_t;
+  #define CODE_INDEX_NONE   0xFFFF
+  #define CODE_INDEX_READ(A,C) A[C]
+#endif
+
+#define GCODE_INDEX_SIZE  100   // G0 - G99
+#define MCODE_INDEX_SIZE  1000  // M0 - M999
+
+static_assert(COUNT(GCode_Table) < CODE_INDEX_NONE && COUNT(MCode_Table) < CODE_INDEX_NONE, "Too many G or M codes for the dispatch index.");
+
+// Binary search, at compile time, in the sorted tables
+constexpr code_index_t gcode_search(const uint16_t code, const int16_t lo, const int16_t hi) {
+  return lo > hi ? CODE_INDEX_NONE
+       : GCode_Table[(lo + hi) >> 1].code == code ? code_index_t((lo + hi) >> 1)
+       : GCode_Table[(lo + hi) >> 1].code < code  ? gcode_search(code, ((lo + hi) >> 1) + 1, hi)
+       :                                            gcode_search(code, lo, ((lo + hi) >> 1) - 1);
+}
+constexpr code_index_t mcode_search(const uint16_t code, const int16_t lo, const int16_t hi) {
+  return lo > hi ? CODE_INDEX_NONE
+       : MCode_Table[(lo + hi) >> 1].code == code ? code_index_t((lo + hi) >> 1)
+       : MCode_Table[(lo + hi) >> 1].code < code  ? mcode_search(code, ((lo + hi) >> 1) + 1, hi)
+       :                                            mcode_search(code, lo, ((lo + hi) >> 1) - 1);
+}
+
+#define _GIDX1(C)     gcode_search(C, 0, COUNT(GCode_Table) - 1)
+#define _MIDX1(C)     mcode_search(C, 0, COUNT(MCode_Table) - 1)
+#define _IDX10(T,C)   T(C), T((C) + 1), T((C) + 2), T((C) + 3), T((C) + 4), T((C) + 5), T((C) + 6), T((C) + 7), T((C) + 8), T((C) + 9)
+#define _IDX100(T,C)  _IDX10(T,C), _IDX10(T,(C) + 10), _IDX10(T,(C) + 20), _IDX10(T,(C) + 30), _IDX10(T,(C) + 40), \
+                      _IDX10(T,(C) + 50), _IDX10(T,(C) + 60), _IDX10(T,(C) + 70), _IDX10(T,(C) + 80), _IDX10(T,(C) + 90)
+
+const code_index_t GCode_Index[GCODE_INDEX_SIZE] PROGMEM = {
+  _IDX100(_GIDX1, 0)
+};
+
+const code_index_t MCode_Index[MCODE_INDEX_SIZE] PROGMEM = {
+  _IDX100(_MIDX1,   0), _IDX100(_MIDX1, 100), _IDX100(_MIDX1, 200), _IDX100(_MIDX1, 300), _IDX100(_MIDX1, 400),
+  _IDX100(_MIDX1, 500), _IDX100(_MIDX1, 600), _IDX100(_MIDX1, 700), _IDX100(_MIDX1, 800), _IDX100(_MIDX1, 900)
+};
+
+#undef _GIDX1
+#undef _MIDX1
+#undef _IDX10
+#undef _IDX100
@@ -66,7 +66,11 @@ inline void gcode_M109() {
     planner.autotemp_M104_M109();
   #endif
 
-  hotends[toolManager.target_hotend()]->wait_for_target(no_wait_for_cooling);
+  #if ENABLED(HEAT_IN_BACKGROUND)
+    hotends[toolManager.target_hotend()]->defer_wait(no_wait_for_cooling);
+  #else
+    hotends[toolManager.target_hotend()]->wait_for_target(no_wait_for_cooling);
+  #endif
 }
 
 #endif // HAS_TEMP_HOTEND
@@ -31,5 +31,12 @@
 /**
  * M155: S<1/0> Enable/disable auto report temperatures.
  *       When enabled firmware will report temperatures every second.
+ *       B<ms> Binary status frame every B milliseconds, B0 to stop (BINARY_STATUS_REPORT)
  */
-inline void gcode_M155() { printer.setAutoreportTemp(parser.boolval('S')); }
+inline void gcode_M155() {
+  #if ENABLED(BINARY_STATUS_REPORT)
+    if (parser.seenval('B')) binary_status.set_interval(parser.value_ushort());
+    if (!parser.seen('S')) return;
+  #endif
+  printer.setAutoreportTemp(parser.boolval('S'));
+}
@@ -0,0 +1,73 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(TEMP_HISTORY)
+
+#define CODE_M156
+
+/**
+ * M156: Report the temperature history of a heater
+ *
+ *   H[heaters]   0-5 Hotend, -1 BED, -2 CHAMBER, -3 COOLER
+ *
+ *    T[int]      0-3 For Select Beds, Chambers or Coolers (default 0)
+ *
+ *    S[int]      Report only the newest samples (default all)
+ *    R[bool]     Clear the history after the report
+ *
+ * One line, oldest sample first. Each sample is the temperature in 1/8 degC
+ * as a signed hex word followed by the PWM as a hex byte:
+ *   History H0 I1000 N2:0640FF064880
+ */
+inline void gcode_M156() {
+
+  Heater * const act = commands.get_target_heater();
+
+  if (!act) return;
+
+  temp_history_t &history = act->history;
+
+  const uint8_t count = MIN(parser.byteval('S', history.count), history.count);
+
+  SERIAL_MV("History H", int(act->type == IS_HOTEND ? act->data.ID : -act->type));
+  if (act->type != IS_HOTEND) SERIAL_MV(" T", int(act->data.ID));
+  SERIAL_MV(" I", int(TEMP_HISTORY_INTERVAL));
+  SERIAL_MV(" N", int(count));
+  SERIAL_CHR(':');
+  for (uint8_t i = history.count - count; i < history.count; i++) {
+    const uint8_t r = history.index(i);
+    print_hex_word(history.temp[r]);
+    print_hex_byte(history.pwm[r]);
+  }
+  SERIAL_EOL();
+
+  if (parser.boolval('R')) history.reset();
+
+}
+
+#endif // TEMP_HISTORY
@@ -46,7 +46,11 @@ inline void gcode_M190() {
 
     lcdui.set_status_P(beds[b]->isHeating() ? GET_TEXT(MSG_BED_HEATING) : GET_TEXT(MSG_BED_COOLING));
 
-    beds[b]->wait_for_target(no_wait_for_cooling);
+    #if ENABLED(HEAT_IN_BACKGROUND)
+      beds[b]->defer_wait(no_wait_for_cooling);
+    #else
+      beds[b]->wait_for_target(no_wait_for_cooling);
+    #endif
   }
 }
 
@@ -46,7 +46,11 @@ inline void gcode_M191() {
 
     lcdui.set_status_P(chambers[c]->isHeating() ? GET_TEXT(MSG_CHAMBER_HEATING) : GET_TEXT(MSG_CHAMBER_COOLING));
 
-    chambers[c]->wait_for_target(no_wait_for_cooling);
+    #if ENABLED(HEAT_IN_BACKGROUND)
+      chambers[c]->defer_wait(no_wait_for_cooling);
+    #else
+      chambers[c]->wait_for_target(no_wait_for_cooling);
+    #endif
   }
 }
 
@@ -39,7 +39,7 @@
  *
  *    S[temp]     sets the target temperature. (default target temperature = 150C)
  *    C[cycles]   minimum 3 (default 5)
- *    R[method]   0-3 (default 0)
+ *    R[method]   0-4 relay methods, 5 step response (default 0)
  *    U[bool]     with a non-zero value will apply the result to current settings
  *
  */
@@ -75,7 +75,8 @@ inline void gcode_M303() {
   NOLESS(cycle, 3);
   NOMORE(cycle, 20);
 
-  NOMORE(method, 4);
+  // The step response needs a heating
+  NOMORE(method, act->type == IS_COOLER ? 4 : 5);
 
   SERIAL_MV(" Temp:", target);
   SERIAL_MV(" Cycles:", cycle);
@@ -40,6 +40,7 @@
  *   T?   Gcode to extrude shouldn't have to follow. Load to extruder wheels is done automatically.
  *   Tx   Same as T?, but nozzle doesn't have to be preheated. Tc requires a preheated nozzle to finish filament load.
  *   Tc   Load to nozzle after filament was prepared by Tc and nozzle is already heated.
+ *   With MMU2_ASYNC_TOOL_CHANGE T[n] returns at once, the first E move waits for the swap.
  */
 inline void gcode_T(const uint8_t tool_id) {
 
@@ -50,6 +50,13 @@ uint16_t GCodeParser::codenum;
   uint8_t GCodeParser::subcode;
 #endif
 
+#if HAS_COMPACT_GCODE
+  bool  GCodeParser::binary_mode;
+  float GCodeParser::binary_value,
+        GCodeParser::binary_args[BINARY_GCODE_FIELDS];
+  char  GCodeParser::binary_command[4] = "G0";
+#endif
+
 #if ENABLED(FASTER_GCODE_PARSER)
   // Optimized Parameters
   uint32_t  GCodeParser::codebits;  // found bits
@@ -78,7 +85,91 @@ void GCodeParser::reset() {
     codebits = 0;                     // No codes yet
     //ZERO(param);                    // No parameters (should be safe to comment out this line)
   #endif
+  #if HAS_COMPACT_GCODE
+    binary_mode = false;              // Text command
+  #endif
+}
+
+#if HAS_COMPACT_GCODE
+
+  /**
+   * Queued binary command: sync, code, mask, then one float
+   * for each bit set in mask (see binary_gcode.h)
+   */
+  void GCodeParser::parse_binary(const char * p) {
+
+    reset();
+
+    binary_mode = true;
+    command_letter = 'G';
+    codenum = uint8_t(p[1]);
+    binary_command[1] = '0' + codenum;
+    command_ptr = binary_command;
+
+    const uint8_t mask = uint8_t(p[2]);
+    p += 3;
+    for (uint8_t f = 0, i = 0; f < BINARY_GCODE_FIELDS; f++) {
+      if (!TEST(mask, f)) continue;
+      memcpy(&binary_args[i], p, sizeof(float));
+      p += sizeof(float);
+      const uint8_t ind = LETTER_BIT(BinaryGcode::field_letter(f));
+      SBI32(codebits, ind);
+      param[ind] = i++;
+    }
+
+  }
+
+#endif // HAS_COMPACT_GCODE
+/**
+ * Integer and fractional parts are accumulated as integers,
+ * up to 9 digits each, then scaled by a power of ten.
+ */
+float GCodeParser::scan_float(const char *p) {
+
+  static const float pow10[] PROGMEM = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f };
+
+  const bool neg = (*p == '-');
+  if (neg || *p == '+') ++p;
+
+  // Integer part, digits beyond the 9th only scale
+  uint32_t  ipart   = 0;
+  uint8_t   digits  = 0,
+            scale   = 0;
+  for (; NUMERIC(*p); ++p) {
+    if (digits < 9) {
+      ipart = ipart * 10 + (*p - '0');
+      if (ipart) ++digits;
+    }
+    else
+      ++scale;
+  }
+
+  float value = ipart;
+  if (scale) value *= pgm_read_float(&pow10[MIN(scale, 9)]);
+
+  // Fractional part, digits beyond the 9th are dropped
+  if (*p == '.') {
+    uint32_t fpart = 0;
+    digits = 0;
+    for (++p; NUMERIC(*p); ++p)
+      if (digits < 9) {
+        fpart = fpart * 10 + (*p - '0');
+        ++digits;
+      }
+    if (fpart) value += float(fpart) / pgm_read_float(&pow10[digits]);
+  }
+
+  return neg ? -value : value;
 }
+
+int32_t GCodeParser::scan_long(const char *p) {
+  const bool neg = (*p == '-');
+  if (neg || *p == '+') ++p;
+  uint32_t value = 0;
+  for (; NUMERIC(*p); ++p) value = value * 10 + (*p - '0');
+  return neg ? -int32_t(value) : int32_t(value);
+}
+
 // Populate all fields by parsing a single line of GCode
 // 58 bytes of SRAM are used to speed up seen/value
 void GCodeParser::parse(char *p) {
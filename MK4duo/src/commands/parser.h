@@ -70,6 +70,13 @@ class GCodeParser {
 
     static char *value_ptr;       // Set by seen, used to fetch the value
 
+    #if HAS_COMPACT_GCODE
+      static bool   binary_mode;                        // Command comes from a compact command
+      static float  binary_value,                       // Set by seen, used to fetch the value
+                    binary_args[BINARY_GCODE_FIELDS];   // Values from the compact command, indexed by param
+      static char   binary_command[4];                  // "Gn", so the command can be echoed
+    #endif
+
     #if ENABLED(FASTER_GCODE_PARSER)
       static uint32_t codebits;   // Parameters pre-scanned
       static uint8_t param[26];   // For A-Z, offsets into command args
@@ -124,6 +131,13 @@ class GCodeParser {
         const uint8_t ind = LETTER_BIT(c);
         if (ind >= COUNT(param)) return false; // Only A-Z
         const bool b = TEST32(codebits, ind);
+        #if HAS_COMPACT_GCODE
+          if (b && binary_mode) {
+            binary_value = binary_args[param[ind]];
+            value_ptr = command_ptr;  // Any non-null pointer, compact fields always have a value
+            return b;
+          }
+        #endif
         if (b) {
           char * const ptr = command_ptr + param[ind];
           value_ptr = param[ind] && valid_float(ptr) ? ptr : nullptr;
@@ -196,35 +210,41 @@ class GCodeParser {
     // This uses 54 bytes of SRAM to speed up seen/value
     static void parse(char * p);
 
+    #if HAS_COMPACT_GCODE
+      // Populate all fields from a queued binary command, without text parsing
+      static void parse_binary(const char * p);
+    #endif
+
     // Code value pointer was set
     FORCE_INLINE static bool has_value() { return value_ptr != nullptr; }
 
     // Seen a parameter with a value
     static inline bool seenval(const char c) { return seen(c) && has_value(); }
 
-    // Float removes 'E' to prevent scientific notation interpretation
+    /**
+     * Decimal scanners for G-code numbers: [-+]?[0-9]*.?[0-9]*
+     * No exponent, since 'E' is an axis, no locale, no inf/nan.
+     * They stop at the first other character.
+     */
+    static float    scan_float(const char *p);
+    static int32_t  scan_long(const char *p);
+
+    // Float stops at 'E', no scientific notation interpretation
     static inline float value_float() {
-      if (value_ptr) {
-        char *e = value_ptr;
-        for (;;) {
-          const char c = *e;
-          if (c == '\0' || c == ' ') break;
-          if (c == 'E' || c == 'e') {
-            *e = '\0';
-            const float ret = strtof(value_ptr, nullptr);
-            *e = c;
-            return ret;
-          }
-          ++e;
-        }
-        return strtof(value_ptr, nullptr);
-      }
-      return 0;
+      #if HAS_COMPACT_GCODE
+        if (binary_mode) return binary_value;
+      #endif
+      return value_ptr ? scan_float(value_ptr) : 0;
     }
 
     // Code value as a long or ulong
-    static inline int32_t   value_long()  { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-    static inline uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+    #if HAS_COMPACT_GCODE
+      static inline int32_t   value_long()  { return binary_mode ? int32_t(binary_value)  : value_ptr ? scan_long(value_ptr) : 0L; }
+      static inline uint32_t  value_ulong() { return binary_mode ? uint32_t(binary_value) : value_ptr ? uint32_t(scan_long(value_ptr)) : 0UL; }
+    #else
+      static inline int32_t   value_long()  { return value_ptr ? scan_long(value_ptr) : 0L; }
+      static inline uint32_t  value_ulong() { return value_ptr ? uint32_t(scan_long(value_ptr)) : 0UL; }
+    #endif
 
     // Code value for use as time
     static inline millis_l  value_millis()              { return value_ulong(); }
@@ -311,6 +311,9 @@
   #endif
 #endif
 
+// Shadow of the characters of an HD44780
+#define HAS_LCD_SHADOW (HAS_CHARACTER_LCD && (ENABLED(LCD_SHADOW_WRITES) || ENABLED(LCD_UPDATE_BUDGET_CHARS)))
+
 /**
  * Stepper
  */
@@ -318,6 +321,47 @@
   #define DOUBLE_QUAD_STEPPING true
 #endif
 
+// DIR setup time of the drivers (ns), 0 if the configuration has none
+#if DISABLED(X_DIRECTION_DELAY)
+  #define X_DIRECTION_DELAY 0
+#endif
+#if DISABLED(Y_DIRECTION_DELAY)
+  #define Y_DIRECTION_DELAY 0
+#endif
+#if DISABLED(Z_DIRECTION_DELAY)
+  #define Z_DIRECTION_DELAY 0
+#endif
+#if DISABLED(X2_DIRECTION_DELAY)
+  #define X2_DIRECTION_DELAY 0
+#endif
+#if DISABLED(Y2_DIRECTION_DELAY)
+  #define Y2_DIRECTION_DELAY 0
+#endif
+#if DISABLED(Z2_DIRECTION_DELAY)
+  #define Z2_DIRECTION_DELAY 0
+#endif
+#if DISABLED(Z3_DIRECTION_DELAY)
+  #define Z3_DIRECTION_DELAY 0
+#endif
+#if DISABLED(E0_DIRECTION_DELAY)
+  #define E0_DIRECTION_DELAY 0
+#endif
+#if DISABLED(E1_DIRECTION_DELAY)
+  #define E1_DIRECTION_DELAY 0
+#endif
+#if DISABLED(E2_DIRECTION_DELAY)
+  #define E2_DIRECTION_DELAY 0
+#endif
+#if DISABLED(E3_DIRECTION_DELAY)
+  #define E3_DIRECTION_DELAY 0
+#endif
+#if DISABLED(E4_DIRECTION_DELAY)
+  #define E4_DIRECTION_DELAY 0
+#endif
+#if DISABLED(E5_DIRECTION_DELAY)
+  #define E5_DIRECTION_DELAY 0
+#endif
+
 // MS1 MS2 Stepper Driver Microstepping mode table
 #define MICROSTEP1 LOW,LOW
 #define MICROSTEP2 HIGH,LOW
@@ -551,6 +595,9 @@
 #define HAS_HEATER_CHAMBER3 (TEMP_SENSOR_CHAMBER3 != 0 && PIN_EXISTS(HEATER_CHAMBER3))
 #define HAS_HEATER_COOLER   (TEMP_SENSOR_COOLER != 0 && PIN_EXISTS(HEATER_COOLER))
 
+// Timer capture of a pulse period, no interrupt for each pulse
+#define HAS_TACHO_CAPTURE   (ENABLED(TACHOMETRIC_CAPTURE) || ENABLED(FLOWMETER_CAPTURE))
+
 // Fans
 #define HAS_FAN0            (PIN_EXISTS(FAN0))
 #define HAS_FAN1            (PIN_EXISTS(FAN1))
@@ -658,6 +705,7 @@
 #define HAS_EEPROM_I2C      (ENABLED(EEPROM_SETTINGS) && ENABLED(EEPROM_I2C))
 #define HAS_EEPROM_SD       (ENABLED(EEPROM_SETTINGS) && ENABLED(EEPROM_SD) && ENABLED(SDSUPPORT))
 #define HAS_EEPROM_FLASH    (ENABLED(EEPROM_SETTINGS) && ENABLED(EEPROM_FLASH))
+#define HAS_EEPROM_PAGED    (HAS_EEPROM_I2C || HAS_EEPROM_SPI)  // External chip, with the page cache
 #define HAS_EEPROM          (ENABLED(EEPROM_SETTINGS))  // Do not touch, AVR have not define anyone EEPROM.
 
 // GAME MENU
@@ -700,10 +748,19 @@
   #define SDSORT_CACHE_NAMES false
   #define SDSORT_DYNAMIC_RAM false
 #endif
+#if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_KEYS)
+  // The keys replace the name buffers
+  #undef SDSORT_USES_RAM
+  #undef SDSORT_USES_STACK
+  #undef SDSORT_CACHE_NAMES
+  #undef SDSORT_DYNAMIC_RAM
+#endif
 #if ENABLED(SDCARD_SORT_ALPHA)
   #define HAS_FOLDER_SORTING  (FOLDER_SORTING || ENABLED(SDSORT_GCODE))
 #endif
 #define HAS_SD_RESTART        (HAS_SD_SUPPORT && ENABLED(SD_RESTART_FILE))
+#define HAS_TIME_WARP         (ENABLED(PRINT_TIME_ESTIMATION) || ENABLED(MOTION_BENCHMARK))
+#define HAS_BOOT_TIMELINE     (ENABLED(FAST_BOOT) || ENABLED(BOOT_TIMELINE))
 
 // Other
 #define HAS_Z_PROBE_SLED      (ENABLED(Z_PROBE_SLED) && PIN_EXISTS(SLED))
@@ -843,6 +900,16 @@
 #define HAS_CLASSIC_E_JERK      (DISABLED(LIN_ADVANCE) || DISABLED(JUNCTION_DEVIATION))
 #define HAS_LINEAR_E_JERK       (ENABLED(LIN_ADVANCE) && ENABLED(JUNCTION_DEVIATION))
 
+/**
+ * Linear Advance with its own ISR or in the main Bresenham
+ */
+#define HAS_LIN_ADVANCE_ISR     (ENABLED(LIN_ADVANCE) && DISABLED(LIN_ADVANCE_BRESENHAM))
+
+/**
+ * Accelerometer for the resonance measurement
+ */
+#define HAS_ACCELEROMETER       (ENABLED(ACCELEROMETER_ADXL345) || ENABLED(ACCELEROMETER_LIS2DW))
+
 /**
  * Set granular options based on the specific type of leveling
  */
@@ -856,7 +923,7 @@
 #define HAS_MESH                (ENABLED(AUTO_BED_LEVELING_BILINEAR) || ENABLED(AUTO_BED_LEVELING_UBL) || ENABLED(MESH_BED_LEVELING))
 #define PLANNER_LEVELING        (HAS_LEVELING && DISABLED(AUTO_BED_LEVELING_UBL))
 #define HAS_PROBING_PROCEDURE   (HAS_ABL_OR_UBL || ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST))
-#define HAS_POSITION_MODIFIERS  (ENABLED(FWRETRACT) || HAS_LEVELING)
+#define HAS_POSITION_MODIFIERS  (ENABLED(FWRETRACT) || HAS_LEVELING || ENABLED(BABYSTEP_PLANNER))
 
 #if ENABLED(AUTO_BED_LEVELING_UBL)
   #undef LCD_BED_LEVELING
@@ -867,6 +934,21 @@
  */
 #define HAS_POSITION_FLOAT      (ENABLED(LIN_ADVANCE) || ENABLED(SCARA_FEEDRATE_SCALING))
 
+/**
+ * Block buffer runtime, for the LCD and the underrun stats
+ */
+#define HAS_BLOCK_BUFFER_RUNTIME  (HAS_SPI_LCD || ENABLED(PLANNER_UNDERRUN_STATS))
+
+/**
+ * Most command slots, the tables by slot are sized on it.
+ * With the buffer arena the slots are set at boot, up to 128.
+ */
+#if ENABLED(BUFFER_ARENA)
+  #define BUFSIZE_MAX 128
+#else
+  #define BUFSIZE_MAX BUFSIZE
+#endif
+
 /**
  * Bed Probing rectangular bounds
  * These can be further constrained in code for Delta and SCARA
@@ -1203,6 +1285,10 @@
 // Add commands that need sub-codes to this list
 #define USE_GCODE_SUBCODES (ENABLED(G38_PROBE_TARGET) || HAS_SD_RESTART)
 
+// Motion commands queued in compact form
+#define HAS_COMPACT_GCODE (ENABLED(BINARY_GCODE_PROTOCOL) || ENABLED(GCODE_PARSE_ON_ENQUEUE) || ENABLED(SD_COMPILED_JOB))
+#define HAS_REALTIME_POSITION (ENABLED(REALTIME_POSITION_REPORT) || ENABLED(BINARY_STATUS_REPORT))
+
 // HAS RESTART and MIN_Z_HEIGHT_FOR_HOMING
 #if HAS_SD_RESTART && ENABLED(MIN_Z_HEIGHT_FOR_HOMING)
   #undef MIN_Z_HEIGHT_FOR_HOMING
@@ -55,24 +55,33 @@
  * Keep this data structure up to date so
  * EEPROM size is known at compile time!
  */
-#define EEPROM_VERSION "MKV79"
+#define EEPROM_VERSION "MKV81"
 #define EEPROM_OFFSET 100
 
+/**
+ * Section versions, bump one when the fields of its section change:
+ * the other sections are kept. EEPROM_VERSION only for the headers.
+ */
+#define EEPROM_MECHANICS_VERSION    1
+#define EEPROM_TEMPERATURE_VERSION  1
+#define EEPROM_LEVELING_VERSION     1
+#define EEPROM_GENERAL_VERSION      1
+#define EEPROM_TMC_VERSION          1
+
 typedef struct EepromDataStruct {
 
-  char      version[6];   // MKVnn\0
-  uint16_t  crc;          // Data Checksum
+  char      version[6];   // MKVnn\0, the layout of the headers
 
   //
-  // ToolManager data
+  // Section mechanics
   //
-  tool_data_t       tool_data;
-  extruder_data_t   extruder_data[MAX_EXTRUDER];
+  eeprom_section_t  mechanics_header;
 
   //
-  // TempManager data
+  // ToolManager data
   //
-  temp_data_t       temp_data;
+  tool_data_t       tool_data;
+  extruder_data_t   extruder_data[MAX_EXTRUDER];
 
   //
   // Mechanics data
@@ -101,9 +110,28 @@ typedef struct EepromDataStruct {
   nozzle_data_t     nozzle_data;
 
   //
-  // Sound data
+  // Hysteresis Feature
   //
-  sound_data_t      sound_data;
+  #if ENABLED(HYSTERESIS_FEATURE)
+    hysteresis_data_t hysteresis_data;
+  #endif
+
+  //
+  // Input shaping
+  //
+  #if ENABLED(INPUT_SHAPING)
+    shaping_data_t    shaping_data;
+  #endif
+
+  //
+  // Section temperature
+  //
+  eeprom_section_t  temperature_header;
+
+  //
+  // TempManager data
+  //
+  temp_data_t       temp_data;
 
   //
   // Heaters data
@@ -135,18 +163,9 @@ typedef struct EepromDataStruct {
   #endif
 
   //
-  // Filament Runout data
-  //
-  #if HAS_FILAMENT_SENSOR
-    filament_data_t filrunout_data;
-  #endif
-
-  //
-  // Power Check data
+  // Section leveling
   //
-  #if HAS_POWER_CHECK
-    power_data_t    power_data;
-  #endif
+  eeprom_section_t  leveling_header;
 
   //
   // Z fade height
@@ -177,7 +196,7 @@ typedef struct EepromDataStruct {
                     grid_max_y;
     xy_pos_t        bilinear_grid_spacing,
                     bilinear_start;
-    float           z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+    bed_mesh_t      z_values;
   #endif
 
   //
@@ -195,6 +214,30 @@ typedef struct EepromDataStruct {
     probe_data_t    probe_data;
   #endif
 
+  //
+  // Section general
+  //
+  eeprom_section_t  general_header;
+
+  //
+  // Sound data
+  //
+  sound_data_t      sound_data;
+
+  //
+  // Filament Runout data
+  //
+  #if HAS_FILAMENT_SENSOR
+    filament_data_t filrunout_data;
+  #endif
+
+  //
+  // Power Check data
+  //
+  #if HAS_POWER_CHECK
+    power_data_t    power_data;
+  #endif
+
   //
   // LCD Language
   //
@@ -264,12 +307,17 @@ typedef struct EepromDataStruct {
   #endif
 
   //
-  // Hysteresis Feature
+  // Buffer arena
   //
-  #if ENABLED(HYSTERESIS_FEATURE)
-    hysteresis_data_t hysteresis_data;
+  #if ENABLED(BUFFER_ARENA)
+    arena_data_t      arena_data;
   #endif
 
+  //
+  // Section tmc
+  //
+  eeprom_section_t  tmc_header;
+
   //
   // Trinamic
   //
@@ -290,6 +338,7 @@ typedef struct EepromDataStruct {
 EEPROM eeprom;
 
 uint16_t EEPROM::datasize() { return sizeof(eepromDataStruct); }
+uint16_t EEPROM::data_end() { return EEPROM_OFFSET + datasize(); }
 
 /**
  * Post-process after Retrieve or Reset
@@ -312,12 +361,18 @@ void EEPROM::post_process() {
 
   tempManager.init();
 
+  BOOT_PHASE("heaters");
+
   fanManager.init();
 
   #if HAS_DHT
     dhtsensor.init();
   #endif
 
+  #if ABL_PLANAR
+    bedlevel.refresh_plane();
+  #endif
+
   #if ENABLED(VOLUMETRIC_EXTRUSION)
     toolManager.calculate_volumetric_multipliers();
   #else
@@ -325,6 +380,10 @@ void EEPROM::post_process() {
   #endif
 
   // Software endstops depend on home_offset
+  #if ENABLED(WORKSPACE_OFFSETS)
+    LOOP_XYZ(i) mechanics.update_workspace_offset((AxisEnum)i);
+  #endif
+
   LOOP_XYZ(i) endstops.update_software_endstops((AxisEnum)i);
 
   #if HAS_LEVELING && ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
@@ -339,6 +398,10 @@ void EEPROM::post_process() {
     fwretract.refresh_autoretract();
   #endif
 
+  #if ENABLED(INPUT_SHAPING)
+    shaping.refresh();
+  #endif
+
   #if ENABLED(JUNCTION_DEVIATION) && ENABLED(LIN_ADVANCE)
     mechanics.recalculate_max_e_jerk();
   #endif
@@ -368,7 +431,8 @@ void EEPROM::post_process() {
 #if HAS_EEPROM
 
   #define EEPROM_SKIP(VAR)        eeprom_index += sizeof(VAR)
-  #define EEPROM_WRITE(VAR)       memorystore.write_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc)
+  #define EEPROM_WRITE(VAR)       do{ if (flag.dry) { crc16(&working_crc, &VAR, sizeof(VAR)); EEPROM_SKIP(VAR); } \
+                                      else memorystore.write_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc); }while(0)
   #define EEPROM_READ_ALWAYS(VAR) memorystore.read_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc)
   #define EEPROM_READ(VAR)        memorystore.read_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc, !flag.validating)
 
@@ -376,16 +440,35 @@ void EEPROM::post_process() {
     #define EEPROM_ASSERT(TST,ERR) do{ if (!(TST)) { SERIAL_LM(ER, ERR); flag.error = true; } }while(0)
     #define EEPROM_TEST(FIELD) \
       EEPROM_ASSERT( \
-        flag.error || eeprom_index == offsetof(eepromDataStruct, FIELD) + EEPROM_OFFSET, \
+        flag.dry || flag.error || eeprom_index == offsetof(eepromDataStruct, FIELD) + EEPROM_OFFSET, \
         "Field " STRINGIFY(FIELD) " mismatch." \
       )
   #else
     #define EEPROM_TEST(FIELD)    NOOP
   #endif
 
+  #define LOOP_EEPROM_SECTION(S)  for (uint8_t S = 0; S < EEPROM_SECTION_COUNT; S++)
+
   const char version[6] = EEPROM_VERSION;
 
-  eeprom_flag_t EEPROM::flag;
+  const uint8_t section_version[EEPROM_SECTION_COUNT] PROGMEM = {
+    EEPROM_MECHANICS_VERSION, EEPROM_TEMPERATURE_VERSION, EEPROM_LEVELING_VERSION,
+    EEPROM_GENERAL_VERSION, EEPROM_TMC_VERSION
+  };
+
+  #if ENABLED(EEPROM_CHITCHAT)
+    const char section_name[EEPROM_SECTION_COUNT][12] PROGMEM = {
+      "mechanics", "temperature", "leveling", "general", "tmc"
+    };
+  #endif
+
+  inline bool same_section(const eeprom_section_t &a, const eeprom_section_t &b) {
+    return a.version == b.version && a.size == b.size && a.crc == b.crc;
+  }
+
+  eeprom_flag_t     EEPROM::flag;
+  eeprom_section_t  EEPROM::section[EEPROM_SECTION_COUNT];
+  int               EEPROM::section_pos[EEPROM_SECTION_COUNT];
 
   bool EEPROM::size_error(const uint16_t size) {
     if (size != datasize()) {
@@ -397,24 +480,36 @@ void EEPROM::post_process() {
     return false;
   }
 
+  /**
+   * The header a section has with the data in RAM: size and crc
+   * from a write that only counts
+   */
+  eeprom_section_t EEPROM::section_now(const EepromSectionEnum s) {
+    int eeprom_index = 0;
+    uint16_t working_crc = 0;
+    flag.dry = true;
+    write_section(s, eeprom_index, working_crc);
+    flag.dry = false;
+    eeprom_section_t now;
+    now.version = pgm_read_byte(&section_version[s]);
+    now.size    = eeprom_index;
+    now.crc     = working_crc;
+    return now;
+  }
+
   /**
    * M500 - Store Configuration
+   *
+   * A section is written only if its data, its version or its place changed.
+   * The header of each section goes last, a write cut by a reset spoils that section only.
+   * sections: the bits of the sections that may be written, with the others
+   *           only a store that moves none of them is done.
    */
-  bool EEPROM::store() {
+  bool EEPROM::store(const uint8_t sections/*=EEPROM_SECTION_ALL*/) {
 
-    char ver[6]           = "ERROR";
     uint16_t working_crc  = 0;
     int eeprom_index      = EEPROM_OFFSET;
-
-    driver_data_t driver_data[MAX_DRIVER_XYZ] = { { NoPin, NoPin, NoPin }, false };
-    driver_data_t driver_e_data[MAX_DRIVER_E] = { { NoPin, NoPin, NoPin }, false };
-
-    extruder_data_t extruder_data[MAX_EXTRUDER];
-    heater_data_t   hotend_data[MAX_HOTEND];
-    heater_data_t   bed_data[MAX_BED];
-    heater_data_t   chamber_data[MAX_CHAMBER];
-    heater_data_t   cooler_data[MAX_COOLER];
-    fan_data_t      fan_data[MAX_FAN];
+    uint8_t written       = 0;
 
     if (memorystore.access_start()) {
       SERIAL_EM("No EEPROM.");
@@ -423,14 +518,100 @@ void EEPROM::post_process() {
 
     flag.error = false;
 
-    #if HAS_EEPROM_FLASH
-      EEPROM_SKIP(ver);       // Flash doesn't allow rewriting without erase
-    #else
-      EEPROM_WRITE(ver);      // invalidate data first
+    EEPROM_SKIP(version);   // Written at the end
+
+    LOOP_EEPROM_SECTION(s) {
+      const EepromSectionEnum es = (EepromSectionEnum)s;
+      const int header_pos = eeprom_index;
+      const eeprom_section_t now = section_now(es);
+
+      eeprom_index = header_pos + sizeof(eeprom_section_t) + now.size;
+
+      if (section_pos[s] == header_pos && same_section(section[s], now)) continue;
+
+      if (!TEST(sections, s)) {
+        // Left as it is, only if it stays where it was
+        if (section_pos[s] == header_pos && section[s].version == now.version && section[s].size == now.size) continue;
+        SERIAL_LM(ER, "EEPROM layout changed, store all with M500");
+        flag.error = true;
+        break;
+      }
+
+      #if !HAS_EEPROM_FLASH   // Flash doesn't allow rewriting without erase
+        eeprom_index = header_pos;
+        const eeprom_section_t invalid = { 0, 0, 0 };
+        EEPROM_WRITE(invalid);
+      #endif
+
+      eeprom_index = header_pos + sizeof(eeprom_section_t);
+      working_crc = 0;
+      write_section(es, eeprom_index, working_crc);
+
+      eeprom_index = header_pos;
+      EEPROM_WRITE(now);
+      eeprom_index += now.size;
+
+      section[s] = now;
+      section_pos[s] = header_pos;
+      SBI(written, s);
+    }
+
+    //
+    // Validate Data Size and write the EEPROM header
+    //
+    if (!flag.error) {
+      const uint16_t eeprom_size = eeprom_index - (EEPROM_OFFSET);
+
+      eeprom_index = EEPROM_OFFSET;
+      EEPROM_WRITE(version);
+
+      // Report storage size
+      #if ENABLED(EEPROM_CHITCHAT)
+        SERIAL_SMV(ECHO, "Settings Stored (", eeprom_size);
+        SERIAL_MSG(" bytes; written");
+        if (!written) SERIAL_MSG(" none");
+        LOOP_EEPROM_SECTION(s) if (TEST(written, s)) { SERIAL_CHR(' '); SERIAL_STR(section_name[s]); }
+        SERIAL_EM(")");
+      #endif
+
+      flag.error |= size_error(eeprom_size);
+    }
+
+    //
+    // UBL Mesh
+    //
+    #if ENABLED(AUTO_BED_LEVELING_UBL)
+      if (ubl.storage_slot >= 0)
+        store_mesh(ubl.storage_slot);
     #endif
-    EEPROM_SKIP(working_crc); // Skip the checksum slot
 
-    working_crc = 0; // clear before first "real data"
+    flag.error |= memorystore.access_write();
+
+    sound.feedback(!flag.error);
+
+    return !flag.error;
+  }
+
+  void EEPROM::write_section(const EepromSectionEnum s, int &eeprom_index, uint16_t &working_crc) {
+    switch (s) {
+      case EEPROM_SECTION_MECHANICS:   write_mechanics(eeprom_index, working_crc);   break;
+      case EEPROM_SECTION_TEMPERATURE: write_temperature(eeprom_index, working_crc); break;
+      case EEPROM_SECTION_LEVELING:    write_leveling(eeprom_index, working_crc);    break;
+      case EEPROM_SECTION_GENERAL:     write_general(eeprom_index, working_crc);     break;
+      case EEPROM_SECTION_TMC:         write_tmc(eeprom_index, working_crc);         break;
+      default: break;
+    }
+  }
+
+  void EEPROM::write_mechanics(int &eeprom_index, uint16_t &working_crc) {
+
+    driver_data_t driver_data[MAX_DRIVER_XYZ] = { { NoPin, NoPin, NoPin }, false };
+    driver_data_t driver_e_data[MAX_DRIVER_E] = { { NoPin, NoPin, NoPin }, false };
+
+    extruder_data_t extruder_data[MAX_EXTRUDER];
+
+    // The slots without an object go zeroed, the crc of a section must depend on its data only
+    ZERO(extruder_data);
 
     //
     // ToolManager data
@@ -441,11 +622,6 @@ void EEPROM::post_process() {
     EEPROM_WRITE(extruder_data);
 
     //
-    // TempManager data
-    //
-    EEPROM_TEST(temp_data);
-    EEPROM_WRITE(tempManager.heater);
-
     // Mechanics data
     //
     EEPROM_TEST(mechanics_data);
@@ -479,10 +655,41 @@ void EEPROM::post_process() {
     EEPROM_WRITE(nozzle.data);
 
     //
-    // Sound
+    // Hysteresis Feature
     //
-    EEPROM_TEST(sound_data);
-    EEPROM_WRITE(sound.data);
+    #if ENABLED(HYSTERESIS_FEATURE)
+      EEPROM_WRITE(hysteresis.data);
+    #endif
+
+    //
+    // Input shaping
+    //
+    #if ENABLED(INPUT_SHAPING)
+      EEPROM_WRITE(shaping.data);
+    #endif
+
+  }
+
+  void EEPROM::write_temperature(int &eeprom_index, uint16_t &working_crc) {
+
+    heater_data_t   hotend_data[MAX_HOTEND];
+    heater_data_t   bed_data[MAX_BED];
+    heater_data_t   chamber_data[MAX_CHAMBER];
+    heater_data_t   cooler_data[MAX_COOLER];
+    fan_data_t      fan_data[MAX_FAN];
+
+    // Zeroed as the extruders in write_mechanics()
+    ZERO(hotend_data);
+    ZERO(bed_data);
+    ZERO(chamber_data);
+    ZERO(cooler_data);
+    ZERO(fan_data);
+
+    //
+    // TempManager data
+    //
+    EEPROM_TEST(temp_data);
+    EEPROM_WRITE(tempManager.heater);
 
     //
     // Heaters data
@@ -520,19 +727,9 @@ void EEPROM::post_process() {
       EEPROM_WRITE(dhtsensor.data);
     #endif
 
-    //
-    // Filament Runout data
-    //
-    #if HAS_FILAMENT_SENSOR
-      EEPROM_WRITE(filamentrunout.sensor.data);
-    #endif
+  }
 
-    //
-    // PowerManager data
-    //
-    #if HAS_POWER_CHECK
-      EEPROM_WRITE(powerManager.data);
-    #endif
+  void EEPROM::write_leveling(int &eeprom_index, uint16_t &working_crc) {
 
     //
     // Z fade height
@@ -592,6 +789,30 @@ void EEPROM::post_process() {
       EEPROM_WRITE(probe.data);
     #endif
 
+  }
+
+  void EEPROM::write_general(int &eeprom_index, uint16_t &working_crc) {
+
+    //
+    // Sound
+    //
+    EEPROM_TEST(sound_data);
+    EEPROM_WRITE(sound.data);
+
+    //
+    // Filament Runout data
+    //
+    #if HAS_FILAMENT_SENSOR
+      EEPROM_WRITE(filamentrunout.sensor.data);
+    #endif
+
+    //
+    // PowerManager data
+    //
+    #if HAS_POWER_CHECK
+      EEPROM_WRITE(powerManager.data);
+    #endif
+
     //
     // LCD Language
     //
@@ -663,12 +884,16 @@ void EEPROM::post_process() {
     #endif
 
     //
-    // Hysteresis Feature
+    // Buffer arena
     //
-    #if ENABLED(HYSTERESIS_FEATURE)
-      EEPROM_WRITE(hysteresis.data);
+    #if ENABLED(BUFFER_ARENA)
+      EEPROM_WRITE(bufferArena.data);
     #endif
 
+  }
+
+  void EEPROM::write_tmc(int &eeprom_index, uint16_t &working_crc) {
+
     //
     // Save Trinamic Driver Configuration, and placeholder values
     //
@@ -683,6 +908,11 @@ void EEPROM::post_process() {
       bool      tmc_stealth_enabled[MAX_DRIVER_XYZ],
                 tmc_stealth_enabled_e[MAX_DRIVER_E];
 
+      ZERO(tmc_stepper_current);    ZERO(tmc_stepper_current_e);
+      ZERO(tmc_stepper_microstep);  ZERO(tmc_stepper_microstep_e);
+      ZERO(tmc_hybrid_threshold);   ZERO(tmc_hybrid_threshold_e);
+      ZERO(tmc_stealth_enabled);    ZERO(tmc_stealth_enabled_e);
+
       LOOP_DRV_ALL_XYZ() {
         Driver* drv = driver[d];
         if (drv && drv->tmc) {
@@ -738,42 +968,6 @@ void EEPROM::post_process() {
 
     #endif // HAS_TRINAMIC
 
-    //
-    // Validate CRC and Data Size
-    //
-    if (!flag.error) {
-      const uint16_t  eeprom_size = eeprom_index - (EEPROM_OFFSET),
-                      final_crc = working_crc;
-
-      // Write the EEPROM header
-      eeprom_index = EEPROM_OFFSET;
-
-      EEPROM_WRITE(version);
-      EEPROM_WRITE(final_crc);
-
-      // Report storage size
-      #if ENABLED(EEPROM_CHITCHAT)
-        SERIAL_SMV(ECHO, "Settings Stored (", eeprom_size);
-        SERIAL_MV(" bytes; crc ", final_crc);
-        SERIAL_EM(")");
-      #endif
-
-      flag.error |= size_error(eeprom_size);
-    }
-
-    //
-    // UBL Mesh
-    //
-    #if ENABLED(AUTO_BED_LEVELING_UBL)
-      if (ubl.storage_slot >= 0)
-        store_mesh(ubl.storage_slot);
-    #endif
-
-    flag.error |= memorystore.access_write();
-
-    sound.feedback(!flag.error);
-
-    return !flag.error;
   }
 
   /**
@@ -796,32 +990,26 @@ void EEPROM::post_process() {
 
   /**
    * M501 - Load Configuration
+   *
+   * Each section is checked by its header and crc and then read. A section
+   * of another version or size, or spoiled, gets the factory settings alone.
+   * The sections equal to the RAM since the last load or store are skipped.
    */
   bool EEPROM::_load() {
 
-    uint16_t  working_crc = 0,
-              stored_crc  = 0;
+    uint16_t  working_crc = 0;
     char      stored_ver[6];
 
-    driver_data_t driver_data[MAX_DRIVER_XYZ] = { { NoPin, NoPin, NoPin }, false };
-    driver_data_t driver_e_data[MAX_DRIVER_E] = { { NoPin, NoPin, NoPin }, false };
-
-    extruder_data_t extruder_data[MAX_EXTRUDER];
-    heater_data_t   hotend_data[MAX_HOTEND];
-    heater_data_t   bed_data[MAX_BED];
-    heater_data_t   chamber_data[MAX_CHAMBER];
-    heater_data_t   cooler_data[MAX_COOLER];
-    fan_data_t      fan_data[MAX_FAN];
-
-    int eeprom_index = EEPROM_OFFSET;
+    int eeprom_index = EEPROM_OFFSET;
 
     if (memorystore.access_start()) {
       SERIAL_EM("No EEPROM.");
       return false;
     }
 
+    flag.error = false;
+
     EEPROM_READ_ALWAYS(stored_ver);
-    EEPROM_READ_ALWAYS(stored_crc);
 
     if (strncmp(version, stored_ver, 5) != 0) {
       if (stored_ver[0] != 'M') {
@@ -835,444 +1023,534 @@ void EEPROM::post_process() {
         SERIAL_EM(" MK4duo=" EEPROM_VERSION ")");
       #endif
       flag.error = true;
+      if (!flag.validating) reset();
     }
     else {
 
-      working_crc = 0; // Init to 0. Accumulated by EEPROM_READ
+      const bool validating = flag.validating;
+
+      LOOP_EEPROM_SECTION(s) {
+        const EepromSectionEnum es = (EepromSectionEnum)s;
+        const int header_pos = eeprom_index;
+        const eeprom_section_t now = section_now(es);
+
+        eeprom_section_t stored;
+        EEPROM_READ_ALWAYS(stored);
+        const int data_pos = eeprom_index;
+
+        bool ok = stored.version == now.version && stored.size == now.size;
+
+        // The stored data is the one in RAM
+        const bool same = ok && section_pos[s] == header_pos && same_section(section[s], stored)
+                       && stored.crc == now.crc;
+
+        if (ok && !same) {
+          flag.validating = true;
+          working_crc = 0;
+          read_section(es, eeprom_index, working_crc);
+          flag.validating = validating;
+          ok = working_crc == stored.crc;
+          if (ok && !validating) {
+            eeprom_index = data_pos;
+            working_crc = 0;
+            read_section(es, eeprom_index, working_crc);
+          }
+        }
 
-      //
-      // ToolManager data
-      //
-      EEPROM_READ(toolManager.extruder);
-      EEPROM_READ(extruder_data);
-      if (!flag.validating) {
-        toolManager.create_object();
-        LOOP_EXTRUDER() if (extruders[e]) extruders[e]->data = extruder_data[e];
+        if (ok) {
+          section[s] = stored;
+          section_pos[s] = header_pos;
+        }
+        else {
+          flag.error = true;
+          section[s].version = 0;
+          if (!validating) reset_section(es);
+          #if ENABLED(EEPROM_CHITCHAT)
+            SERIAL_SM(ECHO, "EEPROM section ");
+            SERIAL_STR(section_name[s]);
+            if (stored.version != now.version)  SERIAL_MSG(" version mismatch");
+            else if (stored.size != now.size)   SERIAL_MSG(" size mismatch");
+            else                                SERIAL_MSG(" CRC mismatch");
+            SERIAL_EM(validating ? "" : ", factory settings");
+          #endif
+        }
+
+        // The next section, by the size of the stored one if it has a header
+        eeprom_index = data_pos + (stored.version && data_pos + stored.size < int(memorystore.capacity()) ? stored.size : now.size);
       }
 
-      //
-      // TempManager data
-      //
-      EEPROM_READ(tempManager.heater);
-      if (!flag.validating) tempManager.create_object();
+      #if ENABLED(EEPROM_CHITCHAT)
+        if (!validating && !flag.error) {
+          SERIAL_ST(ECHO, version);
+          SERIAL_MV(" Stored settings retrieved (", eeprom_index - (EEPROM_OFFSET));
+          SERIAL_EM(" bytes)");
+        }
+      #endif
 
-      //
-      // Mechanics data
-      //
-      EEPROM_READ(mechanics.data);
+      if (!validating) post_process();
 
-      //
-      // Stepper data
-      //
-      EEPROM_READ(stepper.data);
+      #if ENABLED(AUTO_BED_LEVELING_UBL)
+        if (!flag.validating) {
 
-      //
-      // Driver data
-      //
-      EEPROM_READ(driver_data);
-      EEPROM_READ(driver_e_data);
-      if (!flag.validating) {
-        stepper.create_driver();  // Create driver stepper
-        LOOP_DRV_ALL_XYZ()  if (driver[d])    driver[d]->data   = driver_data[d];
-        LOOP_DRV_EXT()      if (driver.e[d])  driver.e[d]->data = driver_e_data[d];
-      }
+          ubl.report_state();
 
-      //
-      // Endstops data
-      //
-      EEPROM_READ(endstops.data);
+          if (!ubl.sanity_check()) {
+            SERIAL_EOL();
+            #if ENABLED(EEPROM_CHITCHAT)
+              ubl.echo_name();
+              SERIAL_EM(" initialized.");
+            #endif
+          }
+          else {
+            flag.error = true;
+            #if ENABLED(EEPROM_CHITCHAT)
+              SERIAL_MSG("?Can't enable ");
+              ubl.echo_name();
+              SERIAL_EM(".");
+            #endif
+            ubl.reset();
+          }
 
-      //
-      // Nozzle data
-      //
-      EEPROM_READ(nozzle.data);
+          if (ubl.storage_slot >= 0) {
+            load_mesh(ubl.storage_slot);
+            #if ENABLED(EEPROM_CHITCHAT)
+              SERIAL_MV("Mesh ", ubl.storage_slot);
+              SERIAL_EM(" loaded from storage.");
+            #endif
+          }
+          else {
+            ubl.reset();
+            #if ENABLED(EEPROM_CHITCHAT)
+              SERIAL_EM("UBL System reset()");
+            #endif
+          }
+        }
+      #endif
 
-      //
-      // Sound
-      //
-      EEPROM_READ(sound.data);
+    }
 
-      //
-      // Heaters data
-      //
+    #if ENABLED(EEPROM_CHITCHAT) && DISABLED(DISABLE_M503)
+      if (!flag.validating) Print_Settings();
+    #endif
+
+    if (flag.validating) sound.feedback(!flag.error);
+
+    return !flag.error;
+  }
+
+  void EEPROM::read_section(const EepromSectionEnum s, int &eeprom_index, uint16_t &working_crc) {
+    switch (s) {
+      case EEPROM_SECTION_MECHANICS:   read_mechanics(eeprom_index, working_crc);   break;
+      case EEPROM_SECTION_TEMPERATURE: read_temperature(eeprom_index, working_crc); break;
+      case EEPROM_SECTION_LEVELING:    read_leveling(eeprom_index, working_crc);    break;
+      case EEPROM_SECTION_GENERAL:     read_general(eeprom_index, working_crc);     break;
+      case EEPROM_SECTION_TMC:         read_tmc(eeprom_index, working_crc);         break;
+      default: break;
+    }
+  }
+
+  void EEPROM::read_mechanics(int &eeprom_index, uint16_t &working_crc) {
+
+    driver_data_t driver_data[MAX_DRIVER_XYZ] = { { NoPin, NoPin, NoPin }, false };
+    driver_data_t driver_e_data[MAX_DRIVER_E] = { { NoPin, NoPin, NoPin }, false };
+
+    extruder_data_t extruder_data[MAX_EXTRUDER];
+
+    //
+    // ToolManager data
+    //
+    EEPROM_READ(toolManager.extruder);
+    EEPROM_READ(extruder_data);
+    if (!flag.validating) {
+      toolManager.create_object();
+      LOOP_EXTRUDER() if (extruders[e]) extruders[e]->data = extruder_data[e];
+    }
+
+    //
+    // Mechanics data
+    //
+    EEPROM_READ(mechanics.data);
+
+    //
+    // Stepper data
+    //
+    EEPROM_READ(stepper.data);
+
+    //
+    // Driver data
+    //
+    EEPROM_READ(driver_data);
+    EEPROM_READ(driver_e_data);
+    if (!flag.validating) {
+      stepper.create_driver();  // Create driver stepper
+      LOOP_DRV_ALL_XYZ()  if (driver[d])    driver[d]->data   = driver_data[d];
+      LOOP_DRV_EXT()      if (driver.e[d])  driver.e[d]->data = driver_e_data[d];
+    }
+
+    //
+    // Endstops data
+    //
+    EEPROM_READ(endstops.data);
+
+    //
+    // Nozzle data
+    //
+    EEPROM_READ(nozzle.data);
+
+    //
+    // Hysteresis Feature
+    //
+    #if ENABLED(HYSTERESIS_FEATURE)
+      EEPROM_READ(hysteresis.data);
+    #endif
+
+    //
+    // Input shaping
+    //
+    #if ENABLED(INPUT_SHAPING)
+      EEPROM_READ(shaping.data);
+    #endif
+
+  }
+
+  void EEPROM::read_temperature(int &eeprom_index, uint16_t &working_crc) {
+
+    heater_data_t   hotend_data[MAX_HOTEND];
+    heater_data_t   bed_data[MAX_BED];
+    heater_data_t   chamber_data[MAX_CHAMBER];
+    heater_data_t   cooler_data[MAX_COOLER];
+    fan_data_t      fan_data[MAX_FAN];
+
+    //
+    // TempManager data
+    //
+    EEPROM_READ(tempManager.heater);
+    if (!flag.validating) tempManager.create_object();
+
+    //
+    // Heaters data
+    //
+    #if HAS_HOTENDS
+      EEPROM_READ(hotend_data);
+    #endif
+    #if HAS_BEDS
+      EEPROM_READ(bed_data);
+    #endif
+    #if HAS_CHAMBERS
+      EEPROM_READ(chamber_data);
+    #endif
+    #if HAS_COOLERS
+      EEPROM_READ(cooler_data);
+    #endif
+    if (!flag.validating) {
       #if HAS_HOTENDS
-        EEPROM_READ(hotend_data);
+        LOOP_HOTEND()   if (hotends[h])   hotends[h]->data  = hotend_data[h];
       #endif
       #if HAS_BEDS
-        EEPROM_READ(bed_data);
+        LOOP_BED()      if (beds[h])      beds[h]->data     = bed_data[h];
       #endif
       #if HAS_CHAMBERS
-        EEPROM_READ(chamber_data);
+        LOOP_CHAMBER()  if (chambers[h])  chambers[h]->data = chamber_data[h];
       #endif
       #if HAS_COOLERS
-        EEPROM_READ(cooler_data);
+        LOOP_COOLER()   if (coolers[h])   coolers[h]->data  = cooler_data[h];
       #endif
-      if (!flag.validating) {
-        #if HAS_HOTENDS
-          LOOP_HOTEND()   if (hotends[h])   hotends[h]->data  = hotend_data[h];
-        #endif
-        #if HAS_BEDS
-          LOOP_BED()      if (beds[h])      beds[h]->data     = bed_data[h];
-        #endif
-        #if HAS_CHAMBERS
-          LOOP_CHAMBER()  if (chambers[h])  chambers[h]->data = chamber_data[h];
-        #endif
-        #if HAS_COOLERS
-          LOOP_COOLER()   if (coolers[h])   coolers[h]->data  = cooler_data[h];
-        #endif
-      }
+    }
 
-      //
-      // Fans data
-      //
-      EEPROM_READ(fanManager.data);
-      EEPROM_READ(fan_data);
-      if (!flag.validating) {
-        fanManager.create_object();
-        LOOP_FAN() if (fans[f]) fans[f]->data = fan_data[f];
-      }
+    //
+    // Fans data
+    //
+    EEPROM_READ(fanManager.data);
+    EEPROM_READ(fan_data);
+    if (!flag.validating) {
+      fanManager.create_object();
+      LOOP_FAN() if (fans[f]) fans[f]->data = fan_data[f];
+    }
 
-      //
-      // DHT sensor data
-      //
-      #if HAS_DHT
-        EEPROM_READ(dhtsensor.data);
-      #endif
+    //
+    // DHT sensor data
+    //
+    #if HAS_DHT
+      EEPROM_READ(dhtsensor.data);
+    #endif
 
-      //
-      // Filament Runout data
-      //
-      #if HAS_FILAMENT_SENSOR
-        EEPROM_READ(filamentrunout.sensor.data);
-      #endif
+  }
 
-      //
-      // PowerManager data
-      //
-      #if HAS_POWER_CHECK
-        EEPROM_READ(powerManager.data);
-      #endif
+  void EEPROM::read_leveling(int &eeprom_index, uint16_t &working_crc) {
 
-      //
-      // Z fade height
-      //
-      #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-        EEPROM_READ(new_z_fade_height);
-      #endif
+    //
+    // Z fade height
+    //
+    #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+      EEPROM_READ(new_z_fade_height);
+    #endif
 
-      //
-      // Mesh Bed Leveling
-      //
-      #if ENABLED(MESH_BED_LEVELING)
-        EEPROM_READ(mbl.data);
-      #endif // MESH_BED_LEVELING
+    //
+    // Mesh Bed Leveling
+    //
+    #if ENABLED(MESH_BED_LEVELING)
+      EEPROM_READ(mbl.data);
+    #endif // MESH_BED_LEVELING
 
-      //
-      // Planar Bed Leveling matrix
-      //
-      #if ABL_PLANAR
-        EEPROM_READ(bedlevel.matrix);
-      #endif
+    //
+    // Planar Bed Leveling matrix
+    //
+    #if ABL_PLANAR
+      EEPROM_READ(bedlevel.matrix);
+    #endif
 
-      //
-      // Bilinear Auto Bed Leveling
-      //
-      #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
-        uint8_t grid_max_x, grid_max_y;
-        EEPROM_READ_ALWAYS(grid_max_x);
-        EEPROM_READ_ALWAYS(grid_max_y);
-        if (grid_max_x == GRID_MAX_POINTS_X && grid_max_y == GRID_MAX_POINTS_Y) {
-          if (!flag.validating) bedlevel.set_bed_leveling_enabled(false);
-          EEPROM_READ(abl.bilinear_grid_spacing);
-          EEPROM_READ(abl.bilinear_start);
-          EEPROM_READ(abl.z_values);
-        }
-        else { // EEPROM data is stale
-          // Skip past disabled (or stale) Bilinear Grid data
-          int bgs[2], bs[2];
-          EEPROM_READ(bgs);
-          EEPROM_READ(bs);
-          float dummy = 0;
-          for (uint16_t q = grid_max_x * grid_max_y; q--;) EEPROM_READ(dummy);
-        }
-      #endif // AUTO_BED_LEVELING_BILINEAR
+    //
+    // Bilinear Auto Bed Leveling
+    //
+    #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+      uint8_t grid_max_x, grid_max_y;
+      EEPROM_READ_ALWAYS(grid_max_x);
+      EEPROM_READ_ALWAYS(grid_max_y);
+      if (grid_max_x == GRID_MAX_POINTS_X && grid_max_y == GRID_MAX_POINTS_Y) {
+        if (!flag.validating) bedlevel.set_bed_leveling_enabled(false);
+        EEPROM_READ(abl.bilinear_grid_spacing);
+        EEPROM_READ(abl.bilinear_start);
+        EEPROM_READ(abl.z_values);
+      }
+      else { // EEPROM data is stale
+        // Skip past disabled (or stale) Bilinear Grid data
+        int bgs[2], bs[2];
+        EEPROM_READ(bgs);
+        EEPROM_READ(bs);
+        mesh_z_t dummy;
+        for (uint16_t q = grid_max_x * grid_max_y; q--;) EEPROM_READ(dummy);
+      }
+    #endif // AUTO_BED_LEVELING_BILINEAR
 
-      //
-      // Universal Bed Leveling
-      //
-      #if ENABLED(AUTO_BED_LEVELING_UBL)
-        bool bedlevel_leveling_active;
-        EEPROM_READ(bedlevel_leveling_active);
-        EEPROM_READ(ubl.storage_slot);
-        if (!flag.validating)
-          bedlevel.flag.leveling_active = bedlevel_leveling_active;
-      #endif
+    //
+    // Universal Bed Leveling
+    //
+    #if ENABLED(AUTO_BED_LEVELING_UBL)
+      bool bedlevel_leveling_active;
+      EEPROM_READ(bedlevel_leveling_active);
+      EEPROM_READ(ubl.storage_slot);
+      if (!flag.validating)
+        bedlevel.flag.leveling_active = bedlevel_leveling_active;
+    #endif
 
-      //
-      // Probe data
-      //
-      #if HAS_BED_PROBE
-        EEPROM_READ(probe.data);
-      #endif
+    //
+    // Probe data
+    //
+    #if HAS_BED_PROBE
+      EEPROM_READ(probe.data);
+    #endif
 
-      //
-      // LCD Language
-      //
-      #if HAS_LCD
-        EEPROM_READ(lcdui.lang);
-      #endif
+  }
 
-      //
-      // LCD menu
-      //
-      #if HAS_LCD_MENU
-        #if HAS_HOTENDS
-          EEPROM_READ(lcdui.preheat_hotend_temp);
-        #endif
-        #if HAS_BEDS
-          EEPROM_READ(lcdui.preheat_bed_temp);
-        #endif
-        #if HAS_CHAMBERS
-          EEPROM_READ(lcdui.preheat_chamber_temp);
-        #endif
-        #if HAS_FAN
-          EEPROM_READ(lcdui.preheat_fan_speed);
-        #endif
-      #endif
+  void EEPROM::read_general(int &eeprom_index, uint16_t &working_crc) {
 
-      //
-      // LCD contrast
-      //
-      #if HAS_LCD_CONTRAST
-        EEPROM_READ(lcdui.contrast);
-      #endif
+    //
+    // Sound
+    //
+    EEPROM_READ(sound.data);
+
+    //
+    // Filament Runout data
+    //
+    #if HAS_FILAMENT_SENSOR
+      EEPROM_READ(filamentrunout.sensor.data);
+    #endif
+
+    //
+    // PowerManager data
+    //
+    #if HAS_POWER_CHECK
+      EEPROM_READ(powerManager.data);
+    #endif
+
+    //
+    // LCD Language
+    //
+    #if HAS_LCD
+      EEPROM_READ(lcdui.lang);
+    #endif
 
-      //
-      // SD Restart
-      //
-      #if HAS_SD_RESTART
-        EEPROM_READ(restart.enabled);
+    //
+    // LCD menu
+    //
+    #if HAS_LCD_MENU
+      #if HAS_HOTENDS
+        EEPROM_READ(lcdui.preheat_hotend_temp);
       #endif
-
-      //
-      // Servo angles
-      //
-      #if HAS_SERVOS
-        LOOP_SERVO() EEPROM_READ(servo[s].angle);
+      #if HAS_BEDS
+        EEPROM_READ(lcdui.preheat_bed_temp);
       #endif
-
-      //
-      // BLTOUCH
-      //
-      #if HAS_BLTOUCH
-        EEPROM_READ(bltouch.last_mode);
+      #if HAS_CHAMBERS
+        EEPROM_READ(lcdui.preheat_chamber_temp);
       #endif
-
-      //
-      // Firmware Retraction
-      //
-      #if ENABLED(FWRETRACT)
-        EEPROM_READ(fwretract.data);
-        EEPROM_READ(fwretract.autoretract_enabled);
+      #if HAS_FAN
+        EEPROM_READ(lcdui.preheat_fan_speed);
       #endif
+    #endif
 
-      //
-      // IDLE oozing
-      //
-      #if ENABLED(IDLE_OOZING_PREVENT)
-        EEPROM_READ(printer.IDLE_OOZING_enabled);
-      #endif
+    //
+    // LCD contrast
+    //
+    #if HAS_LCD_CONTRAST
+      EEPROM_READ(lcdui.contrast);
+    #endif
 
-      //
-      // Hysteresis Feature
-      //
-      #if ENABLED(HYSTERESIS_FEATURE)
-        EEPROM_READ(hysteresis.data);
-      #endif
+    //
+    // SD Restart
+    //
+    #if HAS_SD_RESTART
+      EEPROM_READ(restart.enabled);
+    #endif
 
-      if (!flag.validating) stepper.reset_drivers();
+    //
+    // Servo angles
+    //
+    #if HAS_SERVOS
+      LOOP_SERVO() EEPROM_READ(servo[s].angle);
+    #endif
 
-      //
-      // Trinamic Stepper data
-      //
-      #if HAS_TRINAMIC
-
-        uint16_t  tmc_stepper_current[MAX_DRIVER_XYZ],
-                  tmc_stepper_current_e[MAX_DRIVER_E],
-                  tmc_stepper_microstep[MAX_DRIVER_XYZ],
-                  tmc_stepper_microstep_e[MAX_DRIVER_E];
-        uint32_t  tmc_hybrid_threshold[MAX_DRIVER_XYZ],
-                  tmc_hybrid_threshold_e[MAX_DRIVER_E];
-        bool      tmc_stealth_enabled[MAX_DRIVER_XYZ],
-                  tmc_stealth_enabled_e[MAX_DRIVER_E];
-
-        EEPROM_READ(tmc_stepper_current);
-        EEPROM_READ(tmc_stepper_current_e);
-        EEPROM_READ(tmc_stepper_microstep);
-        EEPROM_READ(tmc_stepper_microstep_e);
-        EEPROM_READ(tmc_hybrid_threshold);
-        EEPROM_READ(tmc_hybrid_threshold_e);
-        EEPROM_READ(tmc_stealth_enabled);
-        EEPROM_READ(tmc_stealth_enabled_e);
+    //
+    // BLTOUCH
+    //
+    #if HAS_BLTOUCH
+      EEPROM_READ(bltouch.last_mode);
+    #endif
 
-        if (!flag.validating) {
-          LOOP_DRV_ALL_XYZ() {
-            Driver* drv = driver[d];
-            if (drv && drv->tmc) {
-              drv->tmc->rms_current(tmc_stepper_current[d]);
-              drv->tmc->microsteps(tmc_stepper_microstep[d]);
-              #if ENABLED(HYBRID_THRESHOLD)
-                drv->tmc->set_pwm_thrs(tmc_hybrid_threshold[d]);
-              #endif
-              #if TMC_HAS_STEALTHCHOP
-                drv->tmc->stealthChop_enabled = tmc_stealth_enabled[d];
-                drv->tmc->refresh_stepping_mode();
-              #endif
-            }
-          }
-          LOOP_DRV_EXT() {
-            Driver* drv = driver.e[d];
-            if (drv && drv->tmc) {
-              drv->tmc->rms_current(tmc_stepper_current_e[d]);
-              drv->tmc->microsteps(tmc_stepper_microstep_e[d]);
-              #if ENABLED(HYBRID_THRESHOLD)
-                drv->tmc->set_pwm_thrs_e(tmc_hybrid_threshold_e[d]);
-              #endif
-              #if TMC_HAS_STEALTHCHOP
-                drv->tmc->stealthChop_enabled = tmc_stealth_enabled_e[d];
-                drv->tmc->refresh_stepping_mode();
-              #endif
-            }
-          }
-        }
+    //
+    // Firmware Retraction
+    //
+    #if ENABLED(FWRETRACT)
+      EEPROM_READ(fwretract.data);
+      EEPROM_READ(fwretract.autoretract_enabled);
+    #endif
 
-        /*
-         * TMC2130 Sensorless homing threshold.
-         * X and X2 use the same value
-         * Y and Y2 use the same value
-         * Z, Z2 and Z3 use the same value
-         */
-        int16_t tmc_sgt[XYZ];
-        EEPROM_READ(tmc_sgt);
-        #if HAS_SENSORLESS
-          if (!flag.validating) {
-            #if ENABLED(X_STALL_SENSITIVITY)
-              #if AXIS_HAS_STALLGUARD(X)
-                driver.x->tmc->homing_threshold(tmc_sgt[X_AXIS]);
-              #endif
-              #if AXIS_HAS_STALLGUARD(X2)
-                driver.x2->tmc->homing_threshold(tmc_sgt[X_AXIS]);
-              #endif
-            #endif
-            #if ENABLED(Y_STALL_SENSITIVITY)
-              #if AXIS_HAS_STALLGUARD(Y)
-                driver.y->tmc->homing_threshold(tmc_sgt[Y_AXIS]);
-              #endif
-              #if AXIS_HAS_STALLGUARD(Y2)
-                driver.y2->tmc->homing_threshold(tmc_sgt[Y_AXIS]);
-              #endif
-            #endif
-            #if ENABLED(Z_STALL_SENSITIVITY)
-              #if AXIS_HAS_STALLGUARD(Z)
-                driver.z->tmc->homing_threshold(tmc_sgt[Z_AXIS]);
-              #endif
-              #if AXIS_HAS_STALLGUARD(Z2)
-                driver.z2->tmc->homing_threshold(tmc_sgt[Z_AXIS]);
-              #endif
-              #if AXIS_HAS_STALLGUARD(Z3)
-                driver.z3->tmc->homing_threshold(tmc_sgt[Z_AXIS]);
-              #endif
-            #endif
-          }
-        #endif
+    //
+    // IDLE oozing
+    //
+    #if ENABLED(IDLE_OOZING_PREVENT)
+      EEPROM_READ(printer.IDLE_OOZING_enabled);
+    #endif
 
-      #endif // HAS_TRINAMIC
+    //
+    // Buffer arena
+    //
+    #if ENABLED(BUFFER_ARENA)
+      EEPROM_READ(bufferArena.data);
+    #endif
 
-      flag.error = size_error(eeprom_index - (EEPROM_OFFSET));
-      if (flag.error) {
-        #if ENABLED(EEPROM_CHITCHAT)
-          SERIAL_MV("Index: ", int(eeprom_index - (EEPROM_OFFSET)));
-          SERIAL_MV(" Size: ", datasize());
-          SERIAL_EOL();
-        #endif
-      }
-      else if (working_crc != stored_crc) {
-        flag.error = true;
-        #if ENABLED(EEPROM_CHITCHAT)
-          SERIAL_SMV(ER, "EEPROM CRC mismatch - (stored) ", stored_crc);
-          SERIAL_MV(" != ", working_crc);
-          SERIAL_EM(" (calculated)!");
-        #endif
-      }
-      else if (!flag.validating) {
-        #if ENABLED(EEPROM_CHITCHAT)
-          SERIAL_ST(ECHO, version);
-          SERIAL_MV(" Stored settings retrieved (", eeprom_index - (EEPROM_OFFSET));
-          SERIAL_MV(" bytes; crc ", (uint32_t)working_crc);
-          SERIAL_EM(")");
-        #endif
-      }
+  }
 
-      if (!flag.validating && !flag.error) post_process();
+  void EEPROM::read_tmc(int &eeprom_index, uint16_t &working_crc) {
 
-      #if ENABLED(AUTO_BED_LEVELING_UBL)
+    if (!flag.validating) stepper.reset_drivers();
 
-        if (!flag.validating) {
+    //
+    // Trinamic Stepper data
+    //
+    #if HAS_TRINAMIC
 
-          ubl.report_state();
+      uint16_t  tmc_stepper_current[MAX_DRIVER_XYZ],
+                tmc_stepper_current_e[MAX_DRIVER_E],
+                tmc_stepper_microstep[MAX_DRIVER_XYZ],
+                tmc_stepper_microstep_e[MAX_DRIVER_E];
+      uint32_t  tmc_hybrid_threshold[MAX_DRIVER_XYZ],
+                tmc_hybrid_threshold_e[MAX_DRIVER_E];
+      bool      tmc_stealth_enabled[MAX_DRIVER_XYZ],
+                tmc_stealth_enabled_e[MAX_DRIVER_E];
 
-          if (!ubl.sanity_check()) {
-            SERIAL_EOL();
-            #if ENABLED(EEPROM_CHITCHAT)
-              ubl.echo_name();
-              SERIAL_EM(" initialized.");
+      EEPROM_READ(tmc_stepper_current);
+      EEPROM_READ(tmc_stepper_current_e);
+      EEPROM_READ(tmc_stepper_microstep);
+      EEPROM_READ(tmc_stepper_microstep_e);
+      EEPROM_READ(tmc_hybrid_threshold);
+      EEPROM_READ(tmc_hybrid_threshold_e);
+      EEPROM_READ(tmc_stealth_enabled);
+      EEPROM_READ(tmc_stealth_enabled_e);
+
+      if (!flag.validating) {
+        LOOP_DRV_ALL_XYZ() {
+          Driver* drv = driver[d];
+          if (drv && drv->tmc) {
+            drv->tmc->rms_current(tmc_stepper_current[d]);
+            drv->tmc->microsteps(tmc_stepper_microstep[d]);
+            #if ENABLED(HYBRID_THRESHOLD)
+              drv->tmc->set_pwm_thrs(tmc_hybrid_threshold[d]);
+            #endif
+            #if TMC_HAS_STEALTHCHOP
+              drv->tmc->stealthChop_enabled = tmc_stealth_enabled[d];
+              drv->tmc->refresh_stepping_mode();
             #endif
           }
-          else {
-            flag.error = true;
-            #if ENABLED(EEPROM_CHITCHAT)
-              SERIAL_MSG("?Can't enable ");
-              ubl.echo_name();
-              SERIAL_EM(".");
+        }
+        LOOP_DRV_EXT() {
+          Driver* drv = driver.e[d];
+          if (drv && drv->tmc) {
+            drv->tmc->rms_current(tmc_stepper_current_e[d]);
+            drv->tmc->microsteps(tmc_stepper_microstep_e[d]);
+            #if ENABLED(HYBRID_THRESHOLD)
+              drv->tmc->set_pwm_thrs_e(tmc_hybrid_threshold_e[d]);
+            #endif
+            #if TMC_HAS_STEALTHCHOP
+              drv->tmc->stealthChop_enabled = tmc_stealth_enabled_e[d];
+              drv->tmc->refresh_stepping_mode();
             #endif
-            ubl.reset();
           }
+        }
+      }
 
-          if (ubl.storage_slot >= 0) {
-            load_mesh(ubl.storage_slot);
-            #if ENABLED(EEPROM_CHITCHAT)
-              SERIAL_MV("Mesh ", ubl.storage_slot);
-              SERIAL_EM(" loaded from storage.");
+      /*
+       * TMC2130 Sensorless homing threshold.
+       * X and X2 use the same value
+       * Y and Y2 use the same value
+       * Z, Z2 and Z3 use the same value
+       */
+      int16_t tmc_sgt[XYZ];
+      EEPROM_READ(tmc_sgt);
+      #if HAS_SENSORLESS
+        if (!flag.validating) {
+          #if ENABLED(X_STALL_SENSITIVITY)
+            #if AXIS_HAS_STALLGUARD(X)
+              driver.x->tmc->homing_threshold(tmc_sgt[X_AXIS]);
             #endif
-          }
-          else {
-            ubl.reset();
-            #if ENABLED(EEPROM_CHITCHAT)
-              SERIAL_EM("UBL System reset()");
+            #if AXIS_HAS_STALLGUARD(X2)
+              driver.x2->tmc->homing_threshold(tmc_sgt[X_AXIS]);
             #endif
-          }
+          #endif
+          #if ENABLED(Y_STALL_SENSITIVITY)
+            #if AXIS_HAS_STALLGUARD(Y)
+              driver.y->tmc->homing_threshold(tmc_sgt[Y_AXIS]);
+            #endif
+            #if AXIS_HAS_STALLGUARD(Y2)
+              driver.y2->tmc->homing_threshold(tmc_sgt[Y_AXIS]);
+            #endif
+          #endif
+          #if ENABLED(Z_STALL_SENSITIVITY)
+            #if AXIS_HAS_STALLGUARD(Z)
+              driver.z->tmc->homing_threshold(tmc_sgt[Z_AXIS]);
+            #endif
+            #if AXIS_HAS_STALLGUARD(Z2)
+              driver.z2->tmc->homing_threshold(tmc_sgt[Z_AXIS]);
+            #endif
+            #if AXIS_HAS_STALLGUARD(Z3)
+              driver.z3->tmc->homing_threshold(tmc_sgt[Z_AXIS]);
+            #endif
+          #endif
         }
       #endif
 
-    }
-
-    #if ENABLED(EEPROM_CHITCHAT) && DISABLED(DISABLE_M503)
-      if (!flag.validating) Print_Settings();
-    #endif
-
-    if (flag.validating) sound.feedback(!flag.error);
+    #endif // HAS_TRINAMIC
 
-    return !flag.error;
   }
 
   bool EEPROM::load() {
-    if (validate()) return _load();
-    reset();
+    const bool success = _load();
     #if ENABLED(EEPROM_AUTO_INIT)
-      (void)store();
-      SERIAL_EM("EEPROM Initialized");
+      if (!success) {
+        (void)store();
+        SERIAL_EM("EEPROM Initialized");
+      }
     #endif
-    return false;
+    return success;
   }
 
   bool EEPROM::validate() {
@@ -1294,22 +1572,37 @@ void EEPROM::post_process() {
       void ubl_invalid_slot(const int) { }
     #endif
 
-    const uint16_t EEPROM::meshes_end = memorystore.capacity() - 129;
+    #if ENABLED(EEPROM_JOURNAL_SIZE)
+      const uint16_t EEPROM::meshes_end = memorystore.capacity() - 129 - (EEPROM_JOURNAL_SIZE);
+    #else
+      const uint16_t EEPROM::meshes_end = memorystore.capacity() - 129;
+    #endif
 
     uint16_t EEPROM::meshes_start_index() {
       return (datasize() + EEPROM_OFFSET + 32) & 0xFFF8;  // Pad the end of configuration data so it can float up
                                                           // or down a little bit without disrupting the mesh data
     }
 
+    // With the mesh cache each slot ends with its tag
+    #if ENABLED(UBL_MESH_CACHE)
+      constexpr uint16_t mesh_slot_size = sizeof(ubl.z_values) + sizeof(mesh_tag_t);
+    #else
+      constexpr uint16_t mesh_slot_size = sizeof(ubl.z_values);
+    #endif
+
     uint16_t EEPROM::calc_num_meshes() {
-      return (meshes_end - meshes_start_index()) / sizeof(ubl.z_values);
+      return (meshes_end - meshes_start_index()) / mesh_slot_size;
     }
 
     int EEPROM::mesh_slot_offset(const int8_t slot) {
-      return meshes_end - (slot + 1) * sizeof(ubl.z_values);
+      return meshes_end - (slot + 1) * mesh_slot_size;
     }
 
-    void EEPROM::store_mesh(const int8_t slot) {
+    #if ENABLED(UBL_MESH_CACHE)
+      void EEPROM::store_mesh(const int8_t slot, mesh_tag_t * const tag/*=NULL*/) {
+    #else
+      void EEPROM::store_mesh(const int8_t slot) {
+    #endif
 
       const int16_t a = calc_num_meshes();
       if (!WITHIN(slot, 0, a - 1)) {
@@ -1328,9 +1621,21 @@ void EEPROM::post_process() {
       if (status) SERIAL_MSG("?Unable to save mesh data.\n");
       else        DEBUG_EMV("Mesh saved in slot ", slot);
 
+      #if ENABLED(UBL_MESH_CACHE)
+        // A mesh stored by hand clears the tag of the slot
+        mesh_tag_t blank = { false };
+        mesh_tag_t * const t = tag ? tag : &blank;
+        t->crc = crc;
+        write_mesh_tag(slot, *t);
+      #endif
+
     }
 
-    void EEPROM::load_mesh(const int8_t slot, void * const into/*=NULL*/) {
+    #if ENABLED(UBL_MESH_CACHE)
+      void EEPROM::load_mesh(const int8_t slot, void * const into/*=NULL*/, uint16_t * const crc_out/*=NULL*/) {
+    #else
+      void EEPROM::load_mesh(const int8_t slot, void * const into/*=NULL*/) {
+    #endif
 
       const int16_t a = calc_num_meshes();
 
@@ -1348,56 +1653,104 @@ void EEPROM::post_process() {
       if (status) SERIAL_MSG("?Unable to load mesh data.\n");
       else        DEBUG_EMV("Mesh loaded from slot ", slot);
 
+      #if ENABLED(UBL_MESH_CACHE)
+        if (crc_out) *crc_out = crc;
+      #endif
+
     }
 
+    #if ENABLED(UBL_MESH_CACHE)
+
+      bool EEPROM::read_mesh_tag(const int8_t slot, mesh_tag_t &tag) {
+        if (!WITHIN(slot, 0, calc_num_meshes() - 1)) return false;
+        int pos = mesh_slot_offset(slot) + sizeof(ubl.z_values);
+        uint16_t crc = 0;
+        return !memorystore.read_data(pos, (uint8_t*)&tag, sizeof(tag), &crc) && tag.tagged;
+      }
+
+      void EEPROM::write_mesh_tag(const int8_t slot, const mesh_tag_t &tag) {
+        if (!WITHIN(slot, 0, calc_num_meshes() - 1)) return;
+        int pos = mesh_slot_offset(slot) + sizeof(ubl.z_values);
+        uint16_t crc = 0;
+        if (memorystore.write_data(pos, (const uint8_t*)&tag, sizeof(tag), &crc))
+          SERIAL_MSG("?Unable to save mesh tag.\n");
+      }
+
+    #endif
+
   #endif // AUTO_BED_LEVELING_UBL
 
 #else // !HAS_EEPROM
 
   bool eeprom_disabled() { SERIAL_LM(ER, "EEPROM disabled"); return false; }
-  bool EEPROM::store() { return eeprom_disabled(); }
+  bool EEPROM::store(const uint8_t) { return eeprom_disabled(); }
   void EEPROM::clear() { (void)eeprom_disabled(); }
 
 #endif // HAS_EEPROM
 
 /**
- * M502 - Reset Configuration
+ * Factory parameters of one section
  */
-void EEPROM::reset() {
-
-  #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-    new_z_fade_height = 0.0f;
-  #endif
-
-  // Call Printer Factory parameters
-  printer.factory_parameters();
+void EEPROM::reset_section(const EepromSectionEnum s) {
+  switch (s) {
+    case EEPROM_SECTION_MECHANICS:   reset_mechanics();   break;
+    case EEPROM_SECTION_TEMPERATURE: reset_temperature(); break;
+    case EEPROM_SECTION_LEVELING:    reset_leveling();    break;
+    case EEPROM_SECTION_GENERAL:     reset_general();     break;
+    case EEPROM_SECTION_TMC:         reset_tmc();         break;
+    default: break;
+  }
+}
 
-  // Call Stepper Factory parameters
-  stepper.factory_parameters();
+void EEPROM::reset_mechanics() {
 
   // Call Tools Factory parameters
   toolManager.factory_parameters();
 
-  // Call Temperature Factory parameters
-  tempManager.factory_parameters();
-
-  // Call Fans Factory parameters
-  fanManager.factory_parameters();
-
   // Call Mechanic Factory parameters
   mechanics.factory_parameters();
 
   // Call Planner Factory parameters
   planner.factory_parameters();
 
+  // Call Stepper Factory parameters
+  stepper.factory_parameters();
+
   // Call Endstop Factory parameters
   endstops.factory_parameters();
 
   // Call Nozzle Factory parameters
   nozzle.factory_parameters();
 
-  // Call Sound Factory parameters
-  sound.factory_parameters();
+  #if ENABLED(HYSTERESIS_FEATURE)
+    hysteresis.factory_parameters();
+  #endif
+
+  #if ENABLED(INPUT_SHAPING)
+    shaping.factory_parameters();
+  #endif
+
+}
+
+void EEPROM::reset_temperature() {
+
+  // Call Temperature Factory parameters
+  tempManager.factory_parameters();
+
+  // Call Fans Factory parameters
+  fanManager.factory_parameters();
+
+  #if HAS_DHT
+    dhtsensor.factory_parameters();
+  #endif
+
+}
+
+void EEPROM::reset_leveling() {
+
+  #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+    new_z_fade_height = 0.0f;
+  #endif
 
   #if HAS_LEVELING
     bedlevel.factory_parameters();
@@ -1411,6 +1764,13 @@ void EEPROM::reset() {
     probe.factory_parameters();
   #endif
 
+}
+
+void EEPROM::reset_general() {
+
+  // Call Sound Factory parameters
+  sound.factory_parameters();
+
   #if HAS_LCD
     lcdui.factory_parameters();
   #endif
@@ -1431,18 +1791,34 @@ void EEPROM::reset() {
     powerManager.factory_parameters();
   #endif
 
-  #if HAS_DHT
-    dhtsensor.factory_parameters();
-  #endif
-
   #if ENABLED(FWRETRACT)
     fwretract.factory_parameters();
   #endif
 
-  #if ENABLED(HYSTERESIS_FEATURE)
-    hysteresis.factory_parameters();
+  #if ENABLED(BUFFER_ARENA)
+    bufferArena.factory_parameters();
+  #endif
+
+}
+
+void EEPROM::reset_tmc() {
+
+  #if HAS_TRINAMIC
+    tmc.factory_parameters();
   #endif
 
+}
+
+/**
+ * M502 - Reset Configuration
+ */
+void EEPROM::reset() {
+
+  // Call Printer Factory parameters
+  printer.factory_parameters();
+
+  LOOP_L_N(s, EEPROM_SECTION_COUNT) reset_section((EepromSectionEnum)s);
+
   post_process();
 
   SERIAL_LM(ECHO, "Factory Settings Loaded");
@@ -1522,6 +1898,9 @@ void EEPROM::reset() {
         hotends[h]->print_M305();
         hotends[h]->print_M306();
         hotends[h]->print_M301();
+        #if ENABLED(HOTEND_MPC)
+          hotends[h]->print_M307();
+        #endif
       }
     #endif
     #if HAS_BEDS
@@ -1670,7 +2049,7 @@ void EEPROM::reset() {
             for (uint8_t px = 0; px < GRID_MAX_POINTS_X; px++) {
               SERIAL_SMV(CFG, "  G29 W I", (int)px);
               SERIAL_MV(" J", (int)py);
-              SERIAL_MV(" Z", LINEAR_UNIT(abl.z_values[px][py]), 5);
+              SERIAL_MV(" Z", LINEAR_UNIT(float(abl.z_values[px][py])), 5);
               SERIAL_EOL();
             }
           }
@@ -1805,6 +2184,20 @@ void EEPROM::reset() {
       hysteresis.print_M99();
     #endif
 
+    /**
+     * Input shaping
+     */
+    #if ENABLED(INPUT_SHAPING)
+      shaping.print_M593();
+    #endif
+
+    /**
+     * Buffer arena
+     */
+    #if ENABLED(BUFFER_ARENA)
+      bufferArena.print_M225();
+    #endif
+
     /**
      * Advanced Pause filament load & unload lengths
      */
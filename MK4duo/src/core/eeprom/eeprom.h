@@ -26,7 +26,7 @@ union eeprom_flag_t {
   struct {
     bool  error       : 1;
     bool  validating  : 1;
-    bool  bit_2       : 1;
+    bool  dry         : 1;
     bool  bit_3       : 1;
     bool  bit_4       : 1;
     bool  bit_5       : 1;
@@ -36,6 +36,38 @@ union eeprom_flag_t {
   eeprom_flag_t() { all = false; }
 };
 
+// Sections of the EEPROM, each with its own version and CRC
+enum EepromSectionEnum : uint8_t {
+  EEPROM_SECTION_MECHANICS,
+  EEPROM_SECTION_TEMPERATURE,
+  EEPROM_SECTION_LEVELING,
+  EEPROM_SECTION_GENERAL,
+  EEPROM_SECTION_TMC,
+  EEPROM_SECTION_COUNT
+};
+
+#define EEPROM_SECTION_ALL  (_BV(EEPROM_SECTION_COUNT) - 1)
+
+// Stored before the data of each section
+typedef struct {
+  uint8_t   version;  // 0 for a section spoiled or being written
+  uint16_t  size,     // Of the data
+            crc;      // Of the data
+} eeprom_section_t;
+
+#if ENABLED(UBL_MESH_CACHE)
+  // Conditions a mesh slot was probed in
+  typedef struct {
+    bool      tagged;     // False for a mesh stored by hand
+    uint16_t  crc,        // Of the mesh data
+              stamp;      // Order of the stores, the lowest is replaced first
+    int16_t   bed_temp;
+    float     z_offset;
+    uint32_t  plate_id;
+    uint8_t   uses;       // Reuses since the probing
+  } mesh_tag_t;
+#endif
+
 class EEPROM {
 
   public: /** Constructor */
@@ -47,7 +79,10 @@ class EEPROM {
     #if HAS_EEPROM
 
       static eeprom_flag_t flag;
- 
+
+      static eeprom_section_t section[EEPROM_SECTION_COUNT];  // Headers in the EEPROM as last loaded or stored
+      static int              section_pos[EEPROM_SECTION_COUNT];
+
       #if ENABLED(AUTO_BED_LEVELING_UBL)  // Eventually make these available if any leveling system
                                           // That can store is enabled
         static const uint16_t meshes_end; // 128 is a placeholder for the size of the MAT; the MAT will always
@@ -74,10 +109,11 @@ class EEPROM {
     }
 
     static uint16_t datasize();
+    static uint16_t data_end();
 
     static void reset();
     static void clear();      // Clear EEPROM and reset
-    static bool store();      // Return 'true' if data was stored ok
+    static bool store(const uint8_t sections=EEPROM_SECTION_ALL); // Return 'true' if data was stored ok
 
     #if HAS_EEPROM
 
@@ -90,8 +126,15 @@ class EEPROM {
         FORCE_INLINE static uint16_t  meshes_end_index() { return meshes_end; }
         static uint16_t calc_num_meshes();
         static int mesh_slot_offset(const int8_t slot);
-        static void store_mesh(const int8_t slot);
-        static void load_mesh(const int8_t slot, void * const into=NULL);
+        #if ENABLED(UBL_MESH_CACHE)
+          static void store_mesh(const int8_t slot, mesh_tag_t * const tag=NULL);
+          static void load_mesh(const int8_t slot, void * const into=NULL, uint16_t * const crc_out=NULL);
+          static bool read_mesh_tag(const int8_t slot, mesh_tag_t &tag);
+          static void write_mesh_tag(const int8_t slot, const mesh_tag_t &tag);
+        #else
+          static void store_mesh(const int8_t slot);
+          static void load_mesh(const int8_t slot, void * const into=NULL);
+        #endif
       #endif
 
     #else
@@ -109,11 +152,30 @@ class EEPROM {
   private: /** Private Function */
 
     static void post_process();
+    static void reset_section(const EepromSectionEnum s);
+    static void reset_mechanics();
+    static void reset_temperature();
+    static void reset_leveling();
+    static void reset_general();
+    static void reset_tmc();
 
     #if HAS_EEPROM
 
       static bool _load();
       static bool size_error(const uint16_t size);
+      static eeprom_section_t section_now(const EepromSectionEnum s);
+      static void write_section(const EepromSectionEnum s, int &eeprom_index, uint16_t &working_crc);
+      static void read_section(const EepromSectionEnum s, int &eeprom_index, uint16_t &working_crc);
+      static void write_mechanics(int &eeprom_index, uint16_t &working_crc);
+      static void write_temperature(int &eeprom_index, uint16_t &working_crc);
+      static void write_leveling(int &eeprom_index, uint16_t &working_crc);
+      static void write_general(int &eeprom_index, uint16_t &working_crc);
+      static void write_tmc(int &eeprom_index, uint16_t &working_crc);
+      static void read_mechanics(int &eeprom_index, uint16_t &working_crc);
+      static void read_temperature(int &eeprom_index, uint16_t &working_crc);
+      static void read_leveling(int &eeprom_index, uint16_t &working_crc);
+      static void read_general(int &eeprom_index, uint16_t &working_crc);
+      static void read_tmc(int &eeprom_index, uint16_t &working_crc);
 
     #endif
 
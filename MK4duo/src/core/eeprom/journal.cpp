@@ -0,0 +1,215 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * journal.cpp
+ *
+ * Append only journal at the end of the EEPROM for the values that change often
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(EEPROM_JOURNAL_SIZE)
+
+Journal journal;
+
+constexpr uint8_t JOURNAL_ERASED  = 0xFF,
+                  JOURNAL_RECORD  = 4;    // Key, size and crc16 of a record
+
+/** Private Parameters */
+uint16_t  Journal::start              = 0,
+          Journal::head               = 0,
+          Journal::last[JOURNAL_KEYS] = { 0 };
+uint8_t   Journal::active             = 0,
+          Journal::sequence           = 0;
+bool      Journal::ready              = false,
+          Journal::needs_compact      = false;
+
+inline uint8_t next_sequence(const uint8_t s) { return s >= JOURNAL_ERASED - 1 ? 0 : s + 1; }
+
+/** Public Function */
+void Journal::init() {
+
+  start = memorystore.capacity() - 1 - (EEPROM_JOURNAL_SIZE);
+  if (start < eeprom.data_end()) {
+    SERIAL_LM(ER, "EEPROM journal over the settings, disabled.");
+    return;
+  }
+
+  memorystore.access_start();
+
+  const uint8_t s0 = read_byte(half_start(0)),
+                s1 = read_byte(half_start(1));
+
+  if (s0 == JOURNAL_ERASED && s1 == JOURNAL_ERASED) {
+    // New journal
+    active = sequence = 0;
+    erase(0);
+    memorystore.write_data(half_start(0), &sequence, 1);
+    memorystore.access_write();
+  }
+  else {
+    active = (s0 != JOURNAL_ERASED && (s1 == JOURNAL_ERASED || s0 == next_sequence(s1))) ? 0 : 1;
+    sequence = active ? s1 : s0;
+    if (s0 != JOURNAL_ERASED && s1 != JOURNAL_ERASED) {
+      // A reset during the compaction, the old half is still marked
+      memorystore.write_data(half_start(active ^ 1), &JOURNAL_ERASED, 1);
+      memorystore.access_write();
+    }
+  }
+
+  scan();
+  ready = true;
+}
+
+bool Journal::read(const JournalKeyEnum key, void *data, const uint8_t size) {
+  if (!ready || key >= JOURNAL_KEYS || !last[key]) return false;
+  const int pos = half_start(active) + last[key];
+  if (read_byte(pos + 1) != size) return false;
+  memorystore.read_data(pos + 2, (uint8_t*)data, size);
+  return true;
+}
+
+bool Journal::write(const JournalKeyEnum key, const void *data, const uint8_t size) {
+  if (!ready || key >= JOURNAL_KEYS) return false;
+
+  const uint8_t * const value = (const uint8_t*)data;
+
+  // The same value of the last record, nothing to write
+  if (last[key]) {
+    const int pos = half_start(active) + last[key];
+    if (read_byte(pos + 1) == size) {
+      uint8_t i = 0;
+      while (i < size && read_byte(pos + 2 + i) == value[i]) i++;
+      if (i == size) return true;
+    }
+  }
+
+  if (needs_compact || head + JOURNAL_RECORD + size > half_size()) compact();
+  if (head + JOURNAL_RECORD + size > half_size()) {
+    SERIAL_LM(ER, "EEPROM journal full.");
+    return false;
+  }
+
+  const uint8_t k = key;
+  uint16_t crc = 0;
+  crc16(&crc, &k, 1);
+  crc16(&crc, &size, 1);
+  crc16(&crc, value, size);
+
+  // The key last, the record is valid only when it is all written
+  const int pos = half_start(active) + head;
+  memorystore.write_data(pos + 1, &size, 1);
+  memorystore.write_data(pos + 2, value, size);
+  memorystore.write_data(pos + 2 + size, (const uint8_t*)&crc, sizeof(crc));
+  memorystore.write_data(pos, &k, 1);
+  memorystore.access_write();
+
+  last[key] = head;
+  head += JOURNAL_RECORD + size;
+  return true;
+}
+
+/** Private Function */
+uint8_t Journal::read_byte(const int pos) {
+  uint8_t value = JOURNAL_ERASED;
+  memorystore.read_data(pos, &value, 1);
+  return value;
+}
+
+void Journal::erase(const uint8_t h) {
+  const int pos = half_start(h);
+  for (uint16_t i = 1; i < half_size(); i++)
+    memorystore.write_data(pos + i, &JOURNAL_ERASED, 1);
+}
+
+/**
+ * Find the last record of each key and the end of the records
+ */
+void Journal::scan() {
+  ZERO(last);
+  needs_compact = false;
+
+  const int base = half_start(active);
+  uint16_t offset = 1;
+
+  while (offset + JOURNAL_RECORD <= half_size()) {
+    const uint8_t key = read_byte(base + offset);
+    if (key == JOURNAL_ERASED) break;
+
+    const uint8_t size = read_byte(base + offset + 1);
+    if (offset + JOURNAL_RECORD + size > half_size()) {
+      needs_compact = true;
+      break;
+    }
+
+    int pos = base + offset;
+    uint16_t crc = 0, record_crc = 0;
+    uint8_t value;
+    for (uint8_t i = 0; i < size + 2; i++) memorystore.read_data(pos, &value, 1, &crc);
+    memorystore.read_data(pos, (uint8_t*)&record_crc, sizeof(record_crc));
+    if (crc != record_crc) {
+      needs_compact = true;
+      break;
+    }
+
+    if (key < JOURNAL_KEYS) last[key] = offset;
+    offset += JOURNAL_RECORD + size;
+  }
+
+  head = offset;
+}
+
+/**
+ * Copy the last record of each key in the other half, then switch to it
+ */
+void Journal::compact() {
+  const uint8_t other = active ^ 1;
+  const int     from  = half_start(active),
+                to    = half_start(other);
+
+  erase(other);
+
+  uint16_t offset = 1;
+  LOOP_L_N(k, JOURNAL_KEYS) {
+    if (!last[k]) continue;
+    const uint8_t length = JOURNAL_RECORD + read_byte(from + last[k] + 1);
+    LOOP_L_N(i, length) {
+      const uint8_t value = read_byte(from + last[k] + i);
+      memorystore.write_data(to + offset + i, &value, 1);
+    }
+    last[k] = offset;
+    offset += length;
+  }
+
+  // The new half is valid only when it is all written
+  sequence = next_sequence(sequence);
+  memorystore.write_data(to, &sequence, 1);
+  memorystore.write_data(from, &JOURNAL_ERASED, 1);
+  memorystore.access_write();
+
+  active = other;
+  head = offset;
+  needs_compact = false;
+}
+
+#endif // EEPROM_JOURNAL_SIZE
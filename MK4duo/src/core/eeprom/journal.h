@@ -0,0 +1,91 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * journal.h
+ *
+ * Append only journal at the end of the EEPROM for the values that change often.
+ *
+ * The journal has two halves, the first byte of a half is its sequence number,
+ * only one half is active. A change is a record added after the last one:
+ *
+ *   key, size, data[size], crc16 of key size and data
+ *
+ * The key is written last, an erased key (0xFF) is the end of the records, so a
+ * record cut by a reset is never read. When the active half is full the last
+ * record of each key is copied in the other half, that becomes the active one.
+ */
+
+#if ENABLED(EEPROM_JOURNAL_SIZE)
+
+enum JournalKeyEnum : uint8_t {
+  JOURNAL_STATS,
+  JOURNAL_LASER_LIFETIME,
+  JOURNAL_KEYS
+};
+
+class Journal {
+
+  public: /** Constructor */
+
+    Journal() {}
+
+  private: /** Private Parameters */
+
+    static uint16_t start,              // First byte of the journal
+                    head,               // Offset of the next record in the active half
+                    last[JOURNAL_KEYS]; // Offset of the last record of each key, 0 = none
+    static uint8_t  active,             // Active half
+                    sequence;           // Sequence of the active half
+    static bool     ready,
+                    needs_compact;
+
+  public: /** Public Function */
+
+    static void init();
+
+    /**
+     * Read the last value of a key, return false if it is not in the journal
+     */
+    static bool read(const JournalKeyEnum key, void *data, const uint8_t size);
+
+    /**
+     * Add a record if the value changed, return false on error
+     */
+    static bool write(const JournalKeyEnum key, const void *data, const uint8_t size);
+
+  private: /** Private Function */
+
+    static inline uint16_t half_size() { return (EEPROM_JOURNAL_SIZE) / 2; }
+    static inline int half_start(const uint8_t h) { return start + h * half_size(); }
+
+    static uint8_t read_byte(const int pos);
+    static void erase(const uint8_t h);
+    static void scan();
+    static void compact();
+
+};
+
+extern Journal journal;
+
+#endif // EEPROM_JOURNAL_SIZE
@@ -27,6 +27,22 @@
  * Test configuration values for errors at compile-time.
  */
 
+#if ENABLED(EEPROM_JOURNAL_SIZE)
+  #if DISABLED(EEPROM_SETTINGS)
+    #error "DEPENDENCY ERROR: EEPROM_JOURNAL_SIZE requires EEPROM_SETTINGS."
+  #elif EEPROM_JOURNAL_SIZE < 128 || EEPROM_JOURNAL_SIZE > 2048 || EEPROM_JOURNAL_SIZE % 2
+    #error "DEPENDENCY ERROR: EEPROM_JOURNAL_SIZE must be even and from 128 to 2048."
+  #endif
+#endif
+
+#if ENABLED(STATS_DEFERRED_SAVE)
+  #if DISABLED(EEPROM_JOURNAL_SIZE)
+    #error "DEPENDENCY ERROR: STATS_DEFERRED_SAVE requires EEPROM_JOURNAL_SIZE."
+  #elif !defined(STATS_DEFERRED_INTERVAL) || STATS_DEFERRED_INTERVAL < 1 || STATS_DEFERRED_INTERVAL > 720
+    #error "DEPENDENCY ERROR: STATS_DEFERRED_INTERVAL must be from 1 to 720 hours."
+  #endif
+#endif
+
 #if ENABLED(__AVR__)
 
   #if ENABLED(EEPROM_SD)
@@ -41,6 +57,12 @@
 
   #if ENABLED(EEPROM_SETTINGS) && DISABLED(EEPROM_I2C) && DISABLED(EEPROM_SPI) && DISABLED(EEPROM_SD) && DISABLED(EEPROM_FLASH)
     #error "DEPENDENCY ERROR: EEPROM_SETTINGS requires EEPROM_I2C or EEPROM_SPI or EEPROM_SD or EEPROM_FLASH."
+  #elif ENABLED(EEPROM_I2C) && ENABLED(EEPROM_SPI)
+    #error "DEPENDENCY ERROR: EEPROM_I2C or EEPROM_SPI can be set."
+  #endif
+
+  #if ENABLED(EEPROM_SPI_FRAM) && DISABLED(EEPROM_SPI)
+    #error "DEPENDENCY ERROR: EEPROM_SPI_FRAM requires EEPROM_SPI."
   #endif
 
 #endif
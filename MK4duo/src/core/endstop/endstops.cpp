@@ -48,10 +48,17 @@ uint16_t Endstops::live_state = 0;
 #if ENABLED(SPI_ENDSTOPS)
   tmc_spi_flag_t Endstops::tmc_spi_homing;
 #endif
+#if ENABLED(SPI_ENDSTOPS_POLL_MS)
+  volatile bool Endstops::spi_bus_hold = false;
+#endif
 
 /** Private Parameters */
 volatile uint8_t Endstops::hit_state = 0;
 
+#if ENABLED(ENDSTOP_PORT_SAMPLING)
+  PortSampler<16> Endstops::port_sampler;
+#endif
+
 /** Public Function */
 void Endstops::init() {
 
@@ -111,6 +118,10 @@ void Endstops::init() {
     SET_INPUT(DOOR_OPEN_PIN);
   #endif
 
+  #if ENABLED(ENDSTOP_PORT_SAMPLING)
+    setup_port_sampler();
+  #endif
+
   #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
     setup_interrupts();
   #endif
@@ -389,7 +400,13 @@ void Endstops::Tick() {
     run_monitor();  // report changes in endstop status
   #endif
 
-  #if DISABLED(ENDSTOP_INTERRUPTS_FEATURE)
+  #if ENABLED(SPI_ENDSTOPS_POLL_MS)
+    tmc_spi_homing_poll();
+  #endif
+
+  #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
+    if (flag.Polling) update();
+  #else
     update();
   #endif
 }
@@ -399,7 +416,14 @@ void Endstops::update() {
 
   if (!abort_enabled()) return;
 
-  #define UPDATE_ENDSTOP_BIT(AXIS, MINMAX)  SET_BIT_TO(live_state, _ENDSTOP(AXIS, MINMAX), (READ(_ENDSTOP_PIN(AXIS, MINMAX)) != isLogic(AXIS ##_## MINMAX)))
+  #if ENABLED(ENDSTOP_PORT_SAMPLING)
+    // All the endstops with one read for each port, then the logic with a single xor
+    const uint16_t sampled = port_sampler.used();
+    live_state = (live_state & ~sampled) | ((port_sampler.sample() ^ data.logic_flag) & sampled);
+    #define UPDATE_ENDSTOP_BIT(AXIS, MINMAX)  NOOP
+  #else
+    #define UPDATE_ENDSTOP_BIT(AXIS, MINMAX)  SET_BIT_TO(live_state, _ENDSTOP(AXIS, MINMAX), (READ(_ENDSTOP_PIN(AXIS, MINMAX)) != isLogic(AXIS ##_## MINMAX)))
+  #endif
   #define COPY_LIVE_STATE(SRC_BIT, DST_BIT) SET_BIT_TO(live_state, DST_BIT, TEST(live_state, SRC_BIT))
 
   #if ENABLED(G38_PROBE_TARGET) && HAS_Z_PROBE_PIN && !(CORE_IS_XY || CORE_IS_XZ)
@@ -962,31 +986,91 @@ void Endstops::update_software_endstops(const AxisEnum axis) {
 
     bool hit = false;
 
-    #if X_SPI_SENSORLESS
-      if (tmc_spi_homing.x && driver.x->tmc->test_stall_status()) {
-        SBI(live_state, X_STOP);
-        hit = true;
-      }
-    #endif
+    #if ENABLED(TMC_SPI_BATCH)
 
-    #if Y_SPI_SENSORLESS
-      if (tmc_spi_homing.y && driver.y->tmc->test_stall_status()) {
-        SBI(live_state, Y_STOP);
-        hit = true;
-      }
-    #endif
+      // The homing drivers in one SPI transaction, 4 pipelined reads of DRV_STATUS each
+      static constexpr uint8_t addr[] = { TMC_REG_DRV_STATUS, TMC_REG_DRV_STATUS, TMC_REG_DRV_STATUS, TMC_REG_DRV_STATUS };
+      MKTMC* tmc_list[3];
+      uint8_t stop_bit[3], n = 0;
 
-    #if Z_SPI_SENSORLESS
-      if (tmc_spi_homing.z && driver.z->tmc->test_stall_status()) {
-        SBI(live_state, Z_STOP);
-        hit = true;
+      #if X_SPI_SENSORLESS
+        if (tmc_spi_homing.x) { tmc_list[n] = driver.x->tmc; stop_bit[n++] = X_STOP; }
+      #endif
+      #if Y_SPI_SENSORLESS
+        if (tmc_spi_homing.y) { tmc_list[n] = driver.y->tmc; stop_bit[n++] = Y_STOP; }
+      #endif
+      #if Z_SPI_SENSORLESS
+        if (tmc_spi_homing.z) { tmc_list[n] = driver.z->tmc; stop_bit[n++] = Z_STOP; }
+      #endif
+
+      if (!n) return false;
+
+      uint32_t data[COUNT(tmc_list) * COUNT(addr)];
+      tmc.spi_batch_read(tmc_list, n, addr, COUNT(addr), data);
+
+      LOOP_L_N(i, n) {
+        LOOP_L_N(r, COUNT(addr)) {
+          if (TEST32(data[i * COUNT(addr) + r], TMC_STALL_GUARD_bp)) {
+            SBI(live_state, stop_bit[i]);
+            hit = true;
+            break;
+          }
+        }
       }
-    #endif
+
+    #else
+
+      #if X_SPI_SENSORLESS
+        if (tmc_spi_homing.x && driver.x->tmc->test_stall_status()) {
+          SBI(live_state, X_STOP);
+          hit = true;
+        }
+      #endif
+
+      #if Y_SPI_SENSORLESS
+        if (tmc_spi_homing.y && driver.y->tmc->test_stall_status()) {
+          SBI(live_state, Y_STOP);
+          hit = true;
+        }
+      #endif
+
+      #if Z_SPI_SENSORLESS
+        if (tmc_spi_homing.z && driver.z->tmc->test_stall_status()) {
+          SBI(live_state, Z_STOP);
+          hit = true;
+        }
+      #endif
+
+    #endif // TMC_SPI_BATCH
 
     return hit;
 
   }
 
+  #if ENABLED(SPI_ENDSTOPS_POLL_MS)
+
+    /**
+     * StallGuard poll from the 1 ms tick, at a fixed rate independent of idle().
+     * The flags are set after the drivers are configured and cleared before they
+     * are restored, so outside of them the bus is free of the main loop's writes.
+     */
+    void Endstops::tmc_spi_homing_poll() {
+      static uint8_t poll_ms = 0;
+
+      if (!tmc_spi_homing.any || spi_bus_hold) return;
+
+      #if ENABLED(IMPROVE_HOMING_RELIABILITY)
+        if (PENDING(millis(), tmc.sg_guard_period)) return;
+      #endif
+
+      if (++poll_ms < (SPI_ENDSTOPS_POLL_MS)) return;
+      poll_ms = 0;
+
+      tmc_spi_homing_check();
+    }
+
+  #endif // SPI_ENDSTOPS_POLL_MS
+
   void Endstops::clear_state() {
     #if X_SPI_SENSORLESS
       CBI(live_state, X_STOP);
@@ -1013,6 +1097,72 @@ void Endstops::resync() {
   #endif
 }
 
+#if ENABLED(ENDSTOP_PORT_SAMPLING)
+
+  /**
+   * Group the endstops checked by update() by GPIO port,
+   * the same set that update() would read one by one.
+   */
+  void Endstops::setup_port_sampler() {
+
+    #define ADD_PORT_SAMPLER(AXIS, MINMAX) port_sampler.add(PORT_INPUT(_ENDSTOP_PIN(AXIS, MINMAX)), PORT_MASK(_ENDSTOP_PIN(AXIS, MINMAX)), _ENDSTOP(AXIS, MINMAX))
+
+    port_sampler.reset();
+
+    #if HAS_X_MIN && !X_SPI_SENSORLESS
+      ADD_PORT_SAMPLER(X, MIN);
+      #if ENABLED(X_TWO_ENDSTOPS) && HAS_X2_MIN
+        ADD_PORT_SAMPLER(X2, MIN);
+      #endif
+    #endif
+    #if HAS_X_MAX && !X_SPI_SENSORLESS
+      ADD_PORT_SAMPLER(X, MAX);
+      #if ENABLED(X_TWO_ENDSTOPS) && HAS_X2_MAX
+        ADD_PORT_SAMPLER(X2, MAX);
+      #endif
+    #endif
+
+    #if HAS_Y_MIN && !Y_SPI_SENSORLESS
+      ADD_PORT_SAMPLER(Y, MIN);
+      #if ENABLED(Y_TWO_ENDSTOPS) && HAS_Y2_MIN
+        ADD_PORT_SAMPLER(Y2, MIN);
+      #endif
+    #endif
+    #if HAS_Y_MAX && !Y_SPI_SENSORLESS
+      ADD_PORT_SAMPLER(Y, MAX);
+      #if ENABLED(Y_TWO_ENDSTOPS) && HAS_Y2_MAX
+        ADD_PORT_SAMPLER(Y2, MAX);
+      #endif
+    #endif
+
+    #if HAS_Z_MIN && !Z_SPI_SENSORLESS
+      ADD_PORT_SAMPLER(Z, MIN);
+      #if (ENABLED(Z_TWO_ENDSTOPS) || ENABLED(Z_THREE_ENDSTOPS)) && HAS_Z2_MIN
+        ADD_PORT_SAMPLER(Z2, MIN);
+      #endif
+      #if ENABLED(Z_THREE_ENDSTOPS) && HAS_Z3_MIN
+        ADD_PORT_SAMPLER(Z3, MIN);
+      #endif
+    #endif
+    #if HAS_Z_MAX && !Z_SPI_SENSORLESS
+      ADD_PORT_SAMPLER(Z, MAX);
+      #if (ENABLED(Z_TWO_ENDSTOPS) || ENABLED(Z_THREE_ENDSTOPS)) && HAS_Z2_MAX
+        ADD_PORT_SAMPLER(Z2, MAX);
+      #endif
+      #if ENABLED(Z_THREE_ENDSTOPS) && HAS_Z3_MAX
+        ADD_PORT_SAMPLER(Z3, MAX);
+      #endif
+    #endif
+
+    // The probe is sampled even if only G38 checks it, the bit is tested only when needed
+    #if HAS_Z_PROBE_PIN && (HAS_BED_PROBE || (ENABLED(G38_PROBE_TARGET) && !(CORE_IS_XY || CORE_IS_XZ)))
+      ADD_PORT_SAMPLER(Z, PROBE);
+    #endif
+
+  }
+
+#endif // ENDSTOP_PORT_SAMPLING
+
 #if ENABLED(PINS_DEBUGGING)
 
   void Endstops::run_monitor() {
@@ -32,7 +32,7 @@ struct endstop_flag_t {
   bool  ProbeEnabled    : 1;
   bool  G38EndstopHit   : 1;
   bool  MonitorEnabled  : 1;
-  bool  bit6            : 1;
+  bool  Polling         : 1;  // Endstop interrupts not available on the pins
   bool  bit7            : 1;
 };
 
@@ -67,6 +67,12 @@ struct endstop_data_t {
   #endif
 };
 
+#if ENABLED(SPI_ENDSTOPS_POLL_MS)
+  #define SPI_ENDSTOPS_HOLD(V) (endstops.spi_bus_hold = V)
+#else
+  #define SPI_ENDSTOPS_HOLD(V) NOOP
+#endif
+
 class Endstops {
 
   public: /** Constructor */
@@ -91,10 +97,18 @@ class Endstops {
       static tmc_spi_flag_t tmc_spi_homing;
     #endif
 
+    #if ENABLED(SPI_ENDSTOPS_POLL_MS)
+      static volatile bool spi_bus_hold;  // The main loop is using the SPI bus, the tick poll waits
+    #endif
+
   private: /** Private Parameters */
 
     static volatile uint8_t hit_state; // use X_MIN, Y_MIN, Z_MIN and Z_PROBE as BIT value
 
+    #if ENABLED(ENDSTOP_PORT_SAMPLING)
+      static PortSampler<16> port_sampler;
+    #endif
+
   public: /** Public Function */
 
     /**
@@ -158,6 +172,11 @@ class Endstops {
     // Clear endstops state
     FORCE_INLINE static void hit_on_purpose() { hit_state = 0; }
 
+    #if ENABLED(STEP_COPROCESSOR)
+      // Endstops hit on the coprocessor
+      FORCE_INLINE static void coprocessor_hit(const uint8_t hit) { hit_state |= hit; }
+    #endif
+
     FORCE_INLINE static void setLogic(const EndstopEnum endstop, const bool logic) {
       SET_BIT_TO(data.logic_flag, endstop, logic);
     }
@@ -226,6 +245,10 @@ class Endstops {
       static void clear_state();
     #endif
 
+    #if ENABLED(SPI_ENDSTOPS_POLL_MS)
+      static void tmc_spi_homing_poll();
+    #endif
+
   private: /** Private Function */
 
     /**
@@ -233,6 +256,10 @@ class Endstops {
      */
     static void resync();
 
+    #if ENABLED(ENDSTOP_PORT_SAMPLING)
+      static void setup_port_sampler();
+    #endif
+
     #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
       static void setup_interrupts(void);
     #endif
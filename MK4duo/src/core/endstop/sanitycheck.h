@@ -42,3 +42,15 @@
 #if ENABLED(Z_THREE_ENDSTOPS) && DISABLED(Z_THREE_STEPPER_DRIVERS)
   #error "DEPENDENCY ERROR: Z_THREE_ENDSTOPS requires Z_THREE_STEPPER_DRIVERS"
 #endif
+
+#if ENABLED(ENDSTOP_PORT_SAMPLING) && ENABLED(PCF8574_EXPANSION_IO)
+  #error "DEPENDENCY ERROR: ENDSTOP_PORT_SAMPLING is incompatible with PCF8574_EXPANSION_IO."
+#endif
+
+#if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+  #if DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_STM32)
+    #error "DEPENDENCY ERROR: ENDSTOP_TRIGGER_CAPTURE is only available on Arduino DUE and STM32."
+  #elif DISABLED(ENDSTOP_INTERRUPTS_FEATURE)
+    #error "DEPENDENCY ERROR: ENDSTOP_TRIGGER_CAPTURE requires ENDSTOP_INTERRUPTS_FEATURE."
+  #endif
+#endif
@@ -40,11 +40,13 @@ void Fan::init() {
   scaled_speed        = 128;
   kickstart           = 0;
   pwm_soft_pos        = 0;
+  pwm_hw_pin          = NoPin;
 
   setIdle(false);
 
   #if ENABLED(TACHOMETRIC)
     data.tacho.init(data.ID);
+    set_rpm_target(0);
   #endif
 
   if (printer.isRunning()) return; // All running not reinitialize
@@ -81,8 +83,13 @@ void Fan::set_output_pwm() {
   const uint8_t new_speed = isHWinvert() ? 255 - actual_speed() : actual_speed();
 
   if (data.pin > NoPin) {
-    if (USEABLE_HARDWARE_PWM(data.pin))
-      HAL::analogWrite(data.pin, new_speed, fanManager.data.frequency);
+    if (hardware_pwm()) {
+      // Timer keeps the duty, write only the changes
+      if (new_speed != pwm_hw_value) {
+        pwm_hw_value = new_speed;
+        HAL::analogWrite(data.pin, new_speed, fanManager.data.frequency);
+      }
+    }
     else {
       #if ENABLED(SOFTWARE_PDM)
         const uint8_t carry = pwm_soft_pos + new_speed;
@@ -101,6 +108,20 @@ void Fan::set_output_pwm() {
 
 }
 
+/**
+ * Ask the HAL for a timer channel when the pin or the frequency changes,
+ * without a free channel the fan use the soft PWM.
+ */
+bool Fan::hardware_pwm() {
+  if (data.pin != pwm_hw_pin || fanManager.data.frequency != pwm_hw_freq) {
+    pwm_hw_pin    = data.pin;
+    pwm_hw_freq   = fanManager.data.frequency;
+    pwm_hw_value  = -1;
+    pwm_hw        = HAL::claim_hardware_pwm(data.pin, pwm_hw_freq);
+  }
+  return pwm_hw;
+}
+
 void Fan::spin() {
 
   static short_timer_t controller_fan_timer;
@@ -143,10 +164,57 @@ void Fan::spin() {
 
   }
 
+  #if ENABLED(TACHOMETRIC)
+    if (data.tacho.spin(actual_speed() && !kickstart))
+      SERIAL_LMV(ER, "Fan stalled: ", int(data.ID));
+    if (rpm_target && !isIdle()) rpm_control();
+  #endif
+
   speed = speed ? constrain(speed, data.speed_limit.min, data.speed_limit.max) : 0;
 
 }
 
+#if ENABLED(TACHOMETRIC)
+
+  void Fan::set_rpm_target(const uint16_t rpm) {
+    rpm_target      = rpm;
+    rpm_last        = 0;
+    rpm_last_speed  = 0;
+    rpm_slope       = 0;
+  }
+
+  /**
+   * RPM mode, the speed follow the tacho to hold rpm_target.
+   * The slope RPM/speed comes from the last two readings, so the
+   * step fits the curve of the fan. Half the error for each spin.
+   */
+  void Fan::rpm_control() {
+
+    const uint16_t rpm = data.tacho.rpm;
+
+    // Stopped, start it at full speed
+    if (rpm == 0 || speed == 0) {
+      speed = data.speed_limit.max;
+      rpm_slope = 0;
+      return;
+    }
+
+    const int16_t dspeed = int16_t(speed) - rpm_last_speed;
+    if (ABS(dspeed) >= 4) {
+      const float slope = float(int32_t(rpm) - rpm_last) / dspeed;
+      if (slope > 0) rpm_slope = slope;
+    }
+    if (rpm_slope <= 0) rpm_slope = float(rpm) / speed;
+
+    rpm_last        = rpm;
+    rpm_last_speed  = speed;
+
+    const int16_t step = constrain(LROUND((int32_t(rpm_target) - rpm) / (2 * rpm_slope)), -32, 32);
+    speed = constrain(int16_t(speed) + step, data.speed_limit.min, data.speed_limit.max);
+  }
+
+#endif // ENABLED(TACHOMETRIC)
+
 #if ENABLED(TACHOMETRIC)
   void tacho_interrupt0() { fans[0]->data.tacho.interrupt(); }
   #if FAN_COUNT > 1
@@ -79,6 +79,18 @@ class Fan {
 
     uint8_t     pwm_soft_pos;
 
+    #if ENABLED(TACHOMETRIC)
+      uint16_t  rpm_target,       // RPM mode when not 0
+                rpm_last;
+      uint8_t   rpm_last_speed;
+      float     rpm_slope;        // RPM for unit of speed
+    #endif
+
+    pin_t       pwm_hw_pin;
+    uint16_t    pwm_hw_freq;
+    int16_t     pwm_hw_value;
+    bool        pwm_hw;
+
   public: /** Public Function */
 
     void init();
@@ -87,6 +99,12 @@ class Fan {
     void set_output_pwm();
     void spin();
 
+    bool hardware_pwm();
+
+    #if ENABLED(TACHOMETRIC)
+      void set_rpm_target(const uint16_t rpm);
+    #endif
+
     inline uint8_t actual_speed() { return ((kickstart ? data.speed_limit.max : speed) * scaled_speed) >> 7; }
     inline uint8_t percent()      { return ui8topercent(actual_speed()); }
 
@@ -108,6 +126,12 @@ class Fan {
     }
     FORCE_INLINE bool isIdle() { return data.flag.Idle; }
 
+  private: /** Private Function */
+
+    #if ENABLED(TACHOMETRIC)
+      void rpm_control();
+    #endif
+
 };
 
 #if HAS_FAN
@@ -73,39 +73,82 @@ struct tacho_data_t {
 
   public: /** Public Parameters */
 
-    pin_t   pin;
+    pin_t     pin;
+    uint16_t  rpm;                    // updated by spin()
 
   private: /** Private Parameters */
 
     static constexpr uint32_t MaxInterruptCount = 32;  // number of tacho interrupts that we average over
 
+    #if ENABLED(TACHOMETRIC_CAPTURE)
+      bool capture;                   // the timer capture measure the period, no interrupt
+    #endif
+
+    bool  was_running,
+          stalled;
+
     uint32_t InterruptCount;          // accessed only in ISR, so no need to declare it volatile
     volatile millis_l LastResetTime,  // time (microseconds) at which we last reset the interrupt count, accessed inside and outside ISR
                       Interval;       // written by ISR, read outside the ISR
 
   public: /** Public Function */
 
-    void init(const uint8_t index) {
+    void init(const uint8_t index) { init(tacho_table[index].function); }
+
+    void init(void (* isr) ()) {
+      rpm = 0;
+      was_running = stalled = false;
       if (pin > 0) {
+        #if ENABLED(TACHOMETRIC_CAPTURE)
+          capture = HAL::tacho_capture_init(pin);
+          if (capture) return;
+        #endif
         HAL::pinMode(pin, INPUT_PULLUP);
-        attachInterrupt(digitalPinToInterrupt(pin), tacho_table[index].function, FALLING);
+        attachInterrupt(digitalPinToInterrupt(pin), isr, FALLING);
       }
     }
 
     void interrupt() {
       ++InterruptCount;
       if (InterruptCount == MaxInterruptCount) {
-        const uint32_t now = HAL_timer_get_current_count(STEPPER_TIMER_NUM);
+        const uint32_t now = micros();
         Interval = now - LastResetTime;
         LastResetTime = now;
         InterruptCount = 0;
       }
     }
 
+    // Two pulses for revolution
     uint32_t GetRPM() {
-      return (Interval != 0 && HAL_timer_get_current_count(STEPPER_TIMER_NUM) - LastResetTime < 3 * STEPPER_CLOCK_RATE)
-        ? (STEPPER_CLOCK_RATE * MaxInterruptCount) / (2 * Interval)
+      return (Interval != 0 && micros() - LastResetTime < 3000000UL)
+        ? (60000000UL / 2 * MaxInterruptCount) / Interval
         : 0;
     }
 
+    /**
+     * Update rpm, return true when the fan running has just stalled
+     */
+    bool spin(const bool running) {
+      if (pin <= 0) return false;
+
+      #if ENABLED(TACHOMETRIC_CAPTURE)
+        if (capture) {
+          constexpr uint32_t stall_ticks = (HAL_TACHO_CAPTURE_RATE / 1000UL) * (TACHOMETRIC_STALL_MS);
+          uint32_t period, age;
+          HAL::tacho_capture_read(pin, period, age);
+          // Two pulses for revolution, no pulse for the stall time is a stopped fan
+          rpm = (period && age < stall_ticks) ? (30UL * (HAL_TACHO_CAPTURE_RATE)) / period : 0;
+        }
+        else
+      #endif
+          rpm = GetRPM();
+
+      // Running from the last spin too, so the fan has had the time to start
+      const bool stall = running && was_running && rpm == 0,
+                 new_stall = stall && !stalled;
+      was_running = running;
+      stalled = stall;
+      return new_stall;
+    }
+
 };
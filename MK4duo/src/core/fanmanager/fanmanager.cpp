@@ -38,6 +38,9 @@ fans_data_t FanManager::data;
   uint8_t FanManager::pwm_soft_count = 0;
 #endif
 
+// The fans, in the static RAM
+static StaticPool<Fan, MAX_FAN> fan_pool;
+
 /** Public Function */
 void FanManager::init() { LOOP_FAN() if (fans[f]) fans[f]->init(); }
 
@@ -46,7 +49,7 @@ void FanManager::spin() { LOOP_FAN() if (fans[f]) fans[f]->spin(); }
 void FanManager::create_object() {
   LOOP_FAN() {
     if (!fans[f]) {
-      fans[f] = new Fan();
+      fans[f] = fan_pool.create(f);
       SERIAL_LMV(ECHO, "Create Fan", int(f));
       fans_factory_parameters(f);
     }
@@ -68,8 +71,7 @@ void FanManager::change_number_fan(const uint8_t f) {
   else if (data.fans > f) {
     for (uint8_t ff = f; ff < MAX_FAN; ff++) {
       if (fans[ff]) {
-        delete (fans[ff]);
-        fans[ff] = nullptr;
+        fan_pool.destroy(fans[ff]);
         SERIAL_LMV(ECHO, "Delete Fan", int(ff));
       }
     }
@@ -47,3 +47,17 @@
 #if DISABLED(HOTEND_AUTO_FAN_MIN_SPEED)
   #error "DEPENDENCY ERROR: Missing setting HOTEND_AUTO_FAN_MIN_SPEED."
 #endif
+
+#if ENABLED(TACHOMETRIC_CAPTURE)
+  #if DISABLED(TACHOMETRIC)
+    #error "DEPENDENCY ERROR: TACHOMETRIC_CAPTURE requires TACHOMETRIC."
+  #elif DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_STM32)
+    #error "DEPENDENCY ERROR: TACHOMETRIC_CAPTURE is only available on Arduino DUE and STM32."
+  #elif DISABLED(TACHOMETRIC_STALL_MS)
+    #error "DEPENDENCY ERROR: Missing setting TACHOMETRIC_STALL_MS."
+  #endif
+#endif
+
+#if ENABLED(SYNCHRONOUS_FAN_SPEED) && !HAS_FAN
+  #error "DEPENDENCY ERROR: SYNCHRONOUS_FAN_SPEED requires a fan."
+#endif
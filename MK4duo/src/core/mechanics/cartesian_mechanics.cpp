@@ -177,6 +177,9 @@ void Cartesian_Mechanics::home(uint8_t axis_bits/*=0*/) {
 
   if (printer.debugSimulation()) {
     LOOP_XYZ(axis) set_axis_is_at_home((AxisEnum)axis);
+    #if HAS_TIME_WARP
+      if (planner.time_warp) sync_plan_position();
+    #endif
     #if HAS_NEXTION_LCD && ENABLED(NEXTION_GFX)
       nextion_gfx_clear();
     #endif
@@ -473,6 +476,7 @@ void Cartesian_Mechanics::do_homing_move(const AxisEnum axis, const float distan
  *
  * When a mesh-based leveling system is active, moves are segmented
  * according to the configuration of the leveling system.
+ * With MESH_STEPPER_CORRECTION the stepper follows the mesh, no segments.
  *
  * Returns true if position[] was set to destination[]
  */
@@ -487,7 +491,7 @@ bool Cartesian_Mechanics::prepare_move_to_destination_mech_specific() {
       laser.status = LASER_OFF;
   #endif
 
-  #if HAS_MESH
+  #if HAS_MESH && DISABLED(MESH_STEPPER_CORRECTION)
     if (bedlevel.flag.leveling_active && bedlevel.leveling_active_at_z(destination.z)) {
       #if ENABLED(AUTO_BED_LEVELING_UBL)
         ubl.line_to_destination_cartesian(scaled_fr_mm_s, toolManager.extruder.active);
@@ -507,7 +511,7 @@ bool Cartesian_Mechanics::prepare_move_to_destination_mech_specific() {
         }
       #endif
     }
-  #endif // HAS_MESH
+  #endif // HAS_MESH && !MESH_STEPPER_CORRECTION
 
   planner.buffer_line(destination, scaled_fr_mm_s, toolManager.extruder.active);
   return false;
@@ -532,6 +536,7 @@ void Cartesian_Mechanics::set_axis_is_at_home(const AxisEnum axis) {
 
   #if ENABLED(WORKSPACE_OFFSETS)
     position_shift[axis] = 0;
+    update_workspace_offset(axis);
     endstops.update_software_endstops(axis);
   #endif
 
@@ -561,6 +566,10 @@ void Cartesian_Mechanics::set_axis_is_at_home(const AxisEnum axis) {
     babystep.reset_total(axis);
   #endif
 
+  #if ENABLED(BABYSTEP_PLANNER)
+    if (axis == Z_AXIS) babystep.planner_reset();
+  #endif
+
   if (printer.debugFeature()) {
     #if ENABLED(WORKSPACE_OFFSETS)
       DEBUG_MC("> data.home_offset[", axis_codes[axis]);
@@ -578,6 +587,7 @@ float Cartesian_Mechanics::axis_home_pos(const AxisEnum axis) {
     case X_AXIS: return x_home_pos(); break;
     case Y_AXIS: return y_home_pos(); break;
     case Z_AXIS: return z_home_pos(); break;
+    default: return 0;
   }
 }
 
@@ -920,6 +930,10 @@ void Cartesian_Mechanics::homeaxis(const AxisEnum axis) {
     if (axis == Z_AXIS && bltouch.deploy()) return; // The initial DEPLOY
   #endif
 
+  #if ENABLED(HOMING_FAST_APPROACH)
+    homing_fast_approach(axis, axis_home_dir);
+  #endif
+
   do_homing_move(axis, 1.5f * data.base_pos.max[axis] * axis_home_dir);
 
   #if HOMING_Z_WITH_PROBE && HAS_BLTOUCH && DISABLED(BLTOUCH_HIGH_SPEED_MODE)
@@ -1069,6 +1083,37 @@ void Cartesian_Mechanics::homeaxis(const AxisEnum axis) {
 
 }
 
+#if ENABLED(HOMING_FAST_APPROACH)
+
+  /**
+   * An axis already homed travels at its max feedrate up to HOMING_FAST_APPROACH_MM
+   * from the place where its endstop was hit, the homing move does the rest.
+   * The endstops are on: an endstop found before only ends the travel.
+   */
+  void Cartesian_Mechanics::homing_fast_approach(const AxisEnum axis, const int axis_home_dir) {
+
+    if (!isAxisHomed(axis)) return;
+
+    #if HOMING_Z_WITH_PROBE
+      if (axis == Z_AXIS) return;   // The probe moves at the probing feedrates only
+    #endif
+    #if ENABLED(DUAL_X_CARRIAGE)
+      if (axis == X_AXIS) return;   // The home of X depends on the carriage
+    #endif
+
+    const float travel = (axis_home_pos(axis) - planner.get_axis_position_mm(axis)) * axis_home_dir - (HOMING_FAST_APPROACH_MM);
+    if (travel <= 0) return;
+
+    if (printer.debugFeature()) DEBUG_EMV("Home 0 Travel:", travel);
+
+    abce_pos_t target = { planner.get_axis_position_mm(A_AXIS), planner.get_axis_position_mm(B_AXIS), planner.get_axis_position_mm(C_AXIS), planner.get_axis_position_mm(E_AXIS) };
+    target[axis] += travel * axis_home_dir;
+    planner.buffer_segment(target, data.max_feedrate_mm_s[axis], toolManager.extruder.active);
+    planner.synchronize();
+  }
+
+#endif
+
 #if ENABLED(QUICK_HOME)
 
   void Cartesian_Mechanics::quick_home_xy() {
@@ -165,6 +165,9 @@ void Core_Mechanics::home(uint8_t axis_bits/*=0*/) {
 
   if (printer.debugSimulation()) {
     LOOP_XYZ(axis) set_axis_is_at_home((AxisEnum)axis);
+    #if HAS_TIME_WARP
+      if (planner.time_warp) sync_plan_position();
+    #endif
     #if HAS_NEXTION_LCD && ENABLED(NEXTION_GFX)
       nextion_gfx_clear();
     #endif
@@ -459,6 +462,7 @@ void Core_Mechanics::set_axis_is_at_home(const AxisEnum axis) {
 
   #if ENABLED(WORKSPACE_OFFSETS)
     position_shift[axis] = 0;
+    update_workspace_offset(axis);
     endstops.update_software_endstops(axis);
   #endif
 
@@ -481,6 +485,10 @@ void Core_Mechanics::set_axis_is_at_home(const AxisEnum axis) {
     babystep.reset_total(axis);
   #endif
 
+  #if ENABLED(BABYSTEP_PLANNER)
+    if (axis == Z_AXIS) babystep.planner_reset();
+  #endif
+
   if (printer.debugFeature()) {
     #if ENABLED(WORKSPACE_OFFSETS)
       DEBUG_MC("> data.home_offset[", axis_codes[axis]);
@@ -498,7 +506,7 @@ float Core_Mechanics::axis_home_pos(const AxisEnum axis) {
     case X_AXIS: return x_home_pos(); break;
     case Y_AXIS: return y_home_pos(); break;
     case Z_AXIS: return z_home_pos(); break;
-    default: break;
+    default: return 0;
   }
 }
 
@@ -742,6 +750,10 @@ void Core_Mechanics::homeaxis(const AxisEnum axis) {
     if (axis == Z_AXIS && bltouch.deploy()) return; // The initial DEPLOY
   #endif
 
+  #if ENABLED(HOMING_FAST_APPROACH)
+    homing_fast_approach(axis, get_homedir(axis));
+  #endif
+
   do_homing_move(axis, 1.5f * data.base_pos.max[axis] * get_homedir(axis));
 
   #if HOMING_Z_WITH_PROBE && HAS_BLTOUCH && DISABLED(BLTOUCH_HIGH_SPEED_MODE)
@@ -891,6 +903,34 @@ void Core_Mechanics::homeaxis(const AxisEnum axis) {
 
 }
 
+#if ENABLED(HOMING_FAST_APPROACH)
+
+  /**
+   * An axis already homed travels at its max feedrate up to HOMING_FAST_APPROACH_MM
+   * from the place where its endstop was hit, the homing move does the rest.
+   * The endstops are on: an endstop found before only ends the travel.
+   */
+  void Core_Mechanics::homing_fast_approach(const AxisEnum axis, const int axis_home_dir) {
+
+    if (!isAxisHomed(axis)) return;
+
+    #if HOMING_Z_WITH_PROBE
+      if (axis == Z_AXIS) return;   // The probe moves at the probing feedrates only
+    #endif
+
+    const float travel = (axis_home_pos(axis) - planner.get_axis_position_mm(axis)) * axis_home_dir - (HOMING_FAST_APPROACH_MM);
+    if (travel <= 0) return;
+
+    if (printer.debugFeature()) DEBUG_EMV("Home 0 Travel:", travel);
+
+    abce_pos_t target = { planner.get_axis_position_mm(A_AXIS), planner.get_axis_position_mm(B_AXIS), planner.get_axis_position_mm(C_AXIS), planner.get_axis_position_mm(E_AXIS) };
+    target[axis] += travel * axis_home_dir;
+    planner.buffer_segment(target, data.max_feedrate_mm_s[axis], toolManager.extruder.active);
+    planner.synchronize();
+  }
+
+#endif
+
 #if ENABLED(QUICK_HOME)
 
   void Core_Mechanics::quick_home_xy() {
@@ -182,6 +182,10 @@ class Core_Mechanics: public Mechanics {
      */
     static void homeaxis(const AxisEnum axis);
 
+    #if ENABLED(HOMING_FAST_APPROACH)
+      static void homing_fast_approach(const AxisEnum axis, const int axis_home_dir);
+    #endif
+
     #if ENABLED(QUICK_HOME)
       static void quick_home_xy();
     #endif
@@ -32,8 +32,8 @@
 
 Delta_Mechanics mechanics;
 
-#if ENABLED(DELTA_FAST_SQRT) && ENABLED(__AVR__)
-  #define _SQRT(n) (1.0f / Q_rsqrt(n))
+#if ENABLED(DELTA_FAST_SQRT) || ENABLED(FAST_MATH)
+  #define _SQRT(n) fast_sqrt(n)
 #else
   #define _SQRT(n) SQRT(n)
 #endif
@@ -155,16 +155,25 @@ void Delta_Mechanics::get_cartesian_from_steppers() {
     // No E move either? Game over.
     if (UNEAR_ZERO(cartesian_distance)) return true;
 
-    // Minimum number of seconds to move the given distance
-    const float seconds = cartesian_distance / _feedrate_mm_s;
+    #if ENABLED(DELTA_ADAPTIVE_SEGMENTS)
 
-    // The number of segments-per-second times the duration
-    // gives the number of segments we should produce
-    const uint16_t sps = difference.e ? data.segments_per_second_print : data.segments_per_second_move;
-    const uint16_t segments = MAX(1U, sps * seconds);
+      // The number of lines that keeps the towers within DELTA_SEGMENT_TOLERANCE
+      uint16_t numLines = segments_for_tolerance(xy_pos_t(position), xy_pos_t(destination));
 
-    // Now compute the number of lines needed
-    uint16_t numLines = (segments + data.segments_per_line - 1) / data.segments_per_line;
+    #else
+
+      // Minimum number of seconds to move the given distance
+      const float seconds = cartesian_distance / _feedrate_mm_s;
+
+      // The number of segments-per-second times the duration
+      // gives the number of segments we should produce
+      const uint16_t sps = difference.e ? data.segments_per_second_print : data.segments_per_second_move;
+      const uint16_t segments = MAX(1U, sps * seconds);
+
+      // Now compute the number of lines needed
+      uint16_t numLines = (segments + data.segments_per_line - 1) / data.segments_per_line;
+
+    #endif
 
     // The approximate length of each segment
     const float         inv_numLines = 1.0f / float(numLines),
@@ -183,18 +192,62 @@ void Delta_Mechanics::get_cartesian_from_steppers() {
     // Get the current position as starting point
     xyze_pos_t raw = position;
 
-    // Calculate and execute the segments
-    while (--numLines) {
+    #if ENABLED(DELTA_BATCH_TRANSFORM)
 
-      static short_timer_t next_idle_timer(millis());
-      if (next_idle_timer.expired(200)) printer.idle();
+      // Calculate the segments DELTA_BATCH_SIZE at a time, then execute them
+      xyze_pos_t  cart[DELTA_BATCH_SIZE];
+      float       bx[DELTA_BATCH_SIZE], by[DELTA_BATCH_SIZE], bz[DELTA_BATCH_SIZE], be[DELTA_BATCH_SIZE],
+                  ha[DELTA_BATCH_SIZE], hb[DELTA_BATCH_SIZE], hc[DELTA_BATCH_SIZE];
 
-      raw += segment_distance;
+      bool stopped = false;
+      for (uint16_t left = numLines - 1; left && !stopped;) {
 
-      if (!planner.buffer_line(raw, _feedrate_mm_s, toolManager.extruder.active, cartesian_segment_mm))
-        break;
+        static short_timer_t next_idle_timer(millis());
+        if (next_idle_timer.expired(200)) printer.idle();
 
-    }
+        const uint8_t n = MIN(left, uint16_t(DELTA_BATCH_SIZE));
+        left -= n;
+
+        LOOP_L_N(i, n) {
+          raw += segment_distance;
+          cart[i] = raw;
+          #if HAS_POSITION_MODIFIERS
+            xyze_pos_t mod = raw;
+            planner.apply_modifiers(mod);
+          #else
+            const xyze_pos_t &mod = raw;
+          #endif
+          bx[i] = mod.x; by[i] = mod.y; bz[i] = mod.z; be[i] = mod.e;
+        }
+
+        Transform(n, bx, by, bz, ha, hb, hc);
+
+        LOOP_L_N(i, n) {
+          const abce_pos_t machine = { ha[i], hb[i], hc[i], be[i] };
+          if (!planner.buffer_line_kinematic(cart[i], machine, _feedrate_mm_s, toolManager.extruder.active, cartesian_segment_mm)) {
+            stopped = true;
+            break;
+          }
+        }
+
+      }
+
+    #else
+
+      // Calculate and execute the segments
+      while (--numLines) {
+
+        static short_timer_t next_idle_timer(millis());
+        if (next_idle_timer.expired(200)) printer.idle();
+
+        raw += segment_distance;
+
+        if (!planner.buffer_line(raw, _feedrate_mm_s, toolManager.extruder.active, cartesian_segment_mm))
+          break;
+
+      }
+
+    #endif
 
     planner.buffer_line(destination, _feedrate_mm_s, toolManager.extruder.active, cartesian_segment_mm);
 
@@ -379,6 +432,68 @@ void Delta_Mechanics::Transform(const xyz_pos_t &raw) {
 
 }
 
+#if ENABLED(DELTA_BATCH_TRANSFORM)
+
+  /**
+   * Delta Transform of n points, given as arrays of X Y Z, into the arrays of
+   * tower heights. The hotend offset and the tower constants are loaded once,
+   * and every output is a plain loop the compiler can unroll or vectorize.
+   */
+  void Delta_Mechanics::Transform(const uint8_t n, const float * const rx, const float * const ry, const float * const rz, float * const ha, float * const hb, float * const hc) {
+
+    const xyz_pos_t &offset = nozzle.data.hotend_offset[toolManager.active_hotend()];
+    float dx[DELTA_BATCH_SIZE], dy[DELTA_BATCH_SIZE];
+
+    // Delta hotend offsets must be applied in Cartesian space
+    LOOP_L_N(i, n) {
+      dx[i] = rx[i] - offset.x;
+      dy[i] = ry[i] - offset.y;
+    }
+
+    const float d2a = D2.a, xa = towerX.a, ya = towerY.a,
+                d2b = D2.b, xb = towerX.b, yb = towerY.b,
+                d2c = D2.c, xc = towerX.c, yc = towerY.c;
+
+    LOOP_L_N(i, n) ha[i] = rz[i] + _SQRT(d2a - sq(dx[i] - xa) - sq(dy[i] - ya));
+    LOOP_L_N(i, n) hb[i] = rz[i] + _SQRT(d2b - sq(dx[i] - xb) - sq(dy[i] - yb));
+    LOOP_L_N(i, n) hc[i] = rz[i] + _SQRT(d2c - sq(dx[i] - xc) - sq(dy[i] - yc));
+
+  }
+
+#endif
+
+#if ENABLED(DELTA_ADAPTIVE_SEGMENTS)
+
+  /**
+   * Number of lines for a straight move from start to end, so that moving each
+   * tower linearly along a line is off the real path by DELTA_SEGMENT_TOLERANCE at most.
+   *
+   * A tower height is h = z + sqrt(q), with q = D2 - r^2 and r the XY distance of
+   * the nozzle from the tower. Along the move |h''| <= D2 / q^(3/2) per mm of XY
+   * travel, and a chord of length L is off the curve by L^2 / 8 * |h''| at most.
+   * q is lowest at one of the ends, as r^2 is convex along the line, so the
+   * worst tower at the worst end gives the line length for the whole move.
+   * Z is linear in h, so only the XY travel counts.
+   */
+  uint16_t Delta_Mechanics::segments_for_tolerance(const xy_pos_t &start, const xy_pos_t &end) {
+
+    const xyz_pos_t &offset = nozzle.data.hotend_offset[toolManager.active_hotend()];
+    const xy_pos_t s = start - offset, e = end - offset;
+
+    float worst = 0.0f;
+    LOOP_ABC(t) {
+      const float q = MIN(D2[t] - sq(s.x - towerX[t]) - sq(s.y - towerY[t]),
+                          D2[t] - sq(e.x - towerX[t]) - sq(e.y - towerY[t]));
+      if (q <= 0.0f) return 1;  // Out of reach, no point in splitting
+      NOLESS(worst, D2[t] / (q * SQRT(q)));
+    }
+
+    const float lines = SQRT(sq(e.x - s.x) + sq(e.y - s.y)) * SQRT(worst * (1.0f / (8.0f * (DELTA_SEGMENT_TOLERANCE))));
+    return lines < 1.0f ? 1 : lines > 65535.0f ? 65535 : uint16_t(CEIL(lines));
+  }
+
+#endif
+
 void Delta_Mechanics::recalc_delta_settings() {
 
   // Get a minimum radius for clamping
@@ -429,6 +544,9 @@ void Delta_Mechanics::home(const bool report/*=true*/) {
 
   if (printer.debugSimulation()) {
     LOOP_XYZ(axis) set_axis_is_at_home((AxisEnum)axis);
+    #if HAS_TIME_WARP
+      if (planner.time_warp) sync_plan_position();
+    #endif
     #if HAS_NEXTION_LCD && ENABLED(NEXTION_GFX)
       nextion_gfx_clear();
     #endif
@@ -480,11 +598,31 @@ void Delta_Mechanics::home(const bool report/*=true*/) {
 
   if (printer.debugFeature()) DEBUG_POS(">>> home", position);
 
+  #if ENABLED(HOMING_FAST_APPROACH)
+    // Homed: the carriages can travel together up to HOMING_FAST_APPROACH_MM under the lowest endstop
+    float fast_travel = 0;
+    if (isHomedAll()) {
+      Transform(xyz_pos_t({ 0, 0, data.height }));  // The carriages at home, under the endstops by endstop_adj
+      fast_travel = 1.5f * data.height;
+      LOOP_XYZ(i) NOMORE(fast_travel, delta[i] - MIN(data.endstop_adj[i], 0) - planner.get_axis_position_mm((AxisEnum)i));
+      fast_travel -= HOMING_FAST_APPROACH_MM;
+    }
+  #endif
+
   // Init the current position of all carriages to 0,0,0
   position.reset();
   destination.reset();
   sync_plan_position();
 
+  #if ENABLED(HOMING_FAST_APPROACH)
+    if (fast_travel > 0) {
+      if (printer.debugFeature()) DEBUG_EMV("Home 0 Travel:", fast_travel);
+      destination.z = fast_travel;
+      planner.buffer_line(destination, data.max_feedrate_mm_s.z, toolManager.extruder.active);
+      planner.synchronize();
+    }
+  #endif
+
   // Disable stealthChop if used. Enable diag1 pin on driver.
   #if ENABLED(SENSORLESS_HOMING)
     sensorless_flag_t stealth_states;
@@ -493,7 +631,7 @@ void Delta_Mechanics::home(const bool report/*=true*/) {
     stealth_states.z = tmc.enable_stallguard(driver.z);
     #if ENABLED(SPI_ENDSTOPS)
       endstops.clear_state();
-      endstops.tmc_spi_homing.any = true;
+      endstops.tmc_spi_homing.x = endstops.tmc_spi_homing.y = endstops.tmc_spi_homing.z = true;
     #endif
   #endif
 
@@ -504,11 +642,14 @@ void Delta_Mechanics::home(const bool report/*=true*/) {
 
   // Re-enable stealthChop if used. Disable diag1 pin on driver.
   #if ENABLED(SENSORLESS_HOMING)
+    #if ENABLED(SPI_ENDSTOPS)
+      // Stop the SPI poll before the drivers are written
+      endstops.tmc_spi_homing.any = false;
+    #endif
     tmc.disable_stallguard(driver.x, stealth_states.x);
     tmc.disable_stallguard(driver.y, stealth_states.y);
     tmc.disable_stallguard(driver.z, stealth_states.z);
     #if ENABLED(SPI_ENDSTOPS)
-      endstops.tmc_spi_homing.any = false;
       endstops.clear_state();
     #endif
     destination.z -= 5;
@@ -520,9 +661,13 @@ void Delta_Mechanics::home(const bool report/*=true*/) {
 
   // At least one carriage has reached the top.
   // Now re-home each carriage separately.
-  homeaxis(A_AXIS);
-  homeaxis(B_AXIS);
-  homeaxis(C_AXIS);
+  #if ENABLED(HOMING_FAST_APPROACH)
+    home_towers_bump();
+  #else
+    homeaxis(A_AXIS);
+    homeaxis(B_AXIS);
+    homeaxis(C_AXIS);
+  #endif
 
   // Set all carriages to their home positions
   // Do this here all at once for Delta, because
@@ -685,6 +830,10 @@ void Delta_Mechanics::set_axis_is_at_home(const AxisEnum axis) {
     babystep.reset_total(axis);
   #endif
 
+  #if ENABLED(BABYSTEP_PLANNER)
+    if (axis == Z_AXIS) babystep.planner_reset();
+  #endif
+
   if (printer.debugFeature()) {
     DEBUG_POS("", position);
     DEBUG_MC("<<< set_axis_is_at_home(", axis_codes[axis]);
@@ -927,6 +1076,64 @@ void Delta_Mechanics::homeaxis(const AxisEnum axis) {
 
 }
 
+#if ENABLED(HOMING_FAST_APPROACH)
+
+  /**
+   * All the carriages move away from the endstops together, then each one
+   * bumps its endstop. The bump travels also the gap left by the first
+   * tower to hit, as the towers were not homed one at a time before.
+   */
+  void Delta_Mechanics::home_towers_bump() {
+
+    const float bump = home_bump_mm.z;
+
+    if (!bump) {
+      homeaxis(A_AXIS);
+      homeaxis(B_AXIS);
+      homeaxis(C_AXIS);
+      return;
+    }
+
+    if (printer.debugFeature()) DEBUG_EM("Move Away:");
+
+    abce_pos_t target = { planner.get_axis_position_mm(A_AXIS), planner.get_axis_position_mm(B_AXIS), planner.get_axis_position_mm(C_AXIS), planner.get_axis_position_mm(E_AXIS) };
+    target.a -= bump;
+    target.b -= bump;
+    target.c -= bump;
+
+    #if ENABLED(JUNCTION_DEVIATION)
+      const xyze_pos_t delta_mm_cart{0};
+    #endif
+
+    planner.buffer_segment(target
+      #if ENABLED(JUNCTION_DEVIATION)
+        , delta_mm_cart
+      #endif
+      , homing_feedrate_mm_s.z, toolManager.extruder.active
+    );
+    planner.synchronize();
+
+    LOOP_XYZ(i) {
+      const AxisEnum axis = (AxisEnum)i;
+
+      if (printer.debugFeature()) DEBUG_EM("Home 2 Slow:");
+      do_homing_move(axis, 1.5f * data.height, get_homing_bump_feedrate(axis));
+
+      // retrace by the amount specified in data.endstop_adj + additional 0.1mm in order to have minimum steps
+      if (data.endstop_adj[axis] < 0) {
+        if (printer.debugFeature()) DEBUG_EM("endstop_adj:");
+        do_homing_move(axis, data.endstop_adj[axis] - (MIN_STEPS_PER_SEGMENT + 1) * steps_to_mm[axis]);
+      }
+    }
+
+    #if ENABLED(FWRETRACT)
+      fwretract.current_hop = 0.0f;
+    #endif
+
+  }
+
+#endif
+
 /**
  * Buffer a fast move without interpolation. Set position to destination
  */
@@ -954,26 +1161,4 @@ void Delta_Mechanics::Set_clip_start_height() {
   delta_clip_start_height = data.height - ABS(distance - delta.a);
 }
 
-#if ENABLED(DELTA_FAST_SQRT) && ENABLED(__AVR__)
-
-  /**
-   * Fast inverse SQRT from Quake III Arena
-   * See: https://en.wikipedia.org/wiki/Fast_inverse_square_root
-   */
-  float Delta_Mechanics::Q_rsqrt(float number) {
-    long i;
-    float x2, y;
-    const float threehalfs = 1.5f;
-    x2 = number * 0.5f;
-    y  = number;
-    i  = * ( long * ) &y;                         // evil floating point bit level hacking
-    i  = 0x5F3759DF - ( i >> 1 );
-    y  = * ( float * ) &i;
-    y  = y * ( threehalfs - ( x2 * y * y ) );     // 1st iteration
-    // y  = y * ( threehalfs - ( x2 * y * y ) );  // 2nd iteration, this can be removed
-    return y;
-  }
-
-#endif
-
 #endif // MECH(DELTA)
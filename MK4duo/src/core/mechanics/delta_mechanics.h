@@ -149,6 +149,9 @@ class Delta_Mechanics : public Mechanics {
     static void InverseTransform(const float Ha, const float Hb, const float Hc, xyz_pos_t &cartesian);
     FORCE_INLINE static void InverseTransform(const abc_pos_t &pos, xyz_pos_t &cartesian) { InverseTransform(pos.a, pos.b, pos.c, cartesian); }
     static void Transform(const xyz_pos_t &raw);
+    #if ENABLED(DELTA_BATCH_TRANSFORM)
+      static void Transform(const uint8_t n, const float * const rx, const float * const ry, const float * const rz, float * const ha, float * const hb, float * const hc);
+    #endif
     static void recalc_delta_settings();
 
     /**
@@ -219,6 +222,10 @@ class Delta_Mechanics : public Mechanics {
      */
     static void homeaxis(const AxisEnum axis);
 
+    #if ENABLED(HOMING_FAST_APPROACH)
+      static void home_towers_bump();
+    #endif
+
     /**
      * Buffer a fast move without interpolation. Set position to destination
      */
@@ -230,8 +237,8 @@ class Delta_Mechanics : public Mechanics {
      */
     static void Set_clip_start_height();
 
-    #if ENABLED(DELTA_FAST_SQRT) && ENABLED(__AVR__)
-      static float Q_rsqrt(float number);
+    #if ENABLED(DELTA_ADAPTIVE_SEGMENTS)
+      static uint16_t segments_for_tolerance(const xy_pos_t &start, const xy_pos_t &end);
     #endif
 
 };
@@ -104,11 +104,7 @@ void Mechanics::set_position_from_steppers_for_axis(const AxisEnum axis) {
 
   #if HAS_POSITION_MODIFIERS
     xyze_pos_t pos = { cartesian_position.x, cartesian_position.y, cartesian_position.z, position.e };
-    planner.unapply_modifiers(pos
-      #if HAS_LEVELING
-        , true
-      #endif
-    );
+    planner.unapply_modifiers<true>(pos);
     xyze_pos_t &cartesian_position = pos;
   #endif
 
@@ -147,7 +143,19 @@ void Mechanics::prepare_move_to_destination() {
     if (mechanics.dual_x_carriage_unpark()) return;
   #endif
 
-  if (!printer.debugSimulation()) { // Simulation Mode no movement
+  #if ENABLED(BABYSTEP_PLANNER)
+    babystep.planner_step();
+  #endif
+
+  #if ENABLED(PLANNER_UNDERRUN_STATS)
+    if (destination.e > position.e) planner.underrun_layer(destination.z);
+  #endif
+
+  if (!printer.debugSimulation() // Simulation Mode no movement
+    #if HAS_TIME_WARP
+      || planner.time_warp
+    #endif
+  ) {
     if (
       #if UBL_DELTA
         ubl.line_to_destination_segmented(MMS_SCALED(feedrate_mm_s))
@@ -218,6 +226,55 @@ void Mechanics::report_position() {
   //stepper.report_positions();
 }
 
+#if HAS_REALTIME_POSITION
+
+  void Mechanics::get_realtime_position(xyze_pos_t &lpos) {
+
+    xyze_long_t steps;
+    stepper.get_positions(steps);
+
+    xyz_float_t axis_steps = { float(steps.x), float(steps.y), float(steps.z) };
+    #if IS_CORE
+      // As Planner::get_axis_position_mm
+      axis_steps[CORE_AXIS_1] = 0.5f * (steps[CORE_AXIS_1] + steps[CORE_AXIS_2]);
+      axis_steps[CORE_AXIS_2] = 0.5f * CORESIGN(steps[CORE_AXIS_1] - steps[CORE_AXIS_2]);
+    #endif
+
+    xyz_pos_t pos = axis_steps * steps_to_mm;
+
+    #if MECH(DELTA)
+      const abc_pos_t towers = pos;
+      mechanics.InverseTransform(towers, pos);
+    #elif IS_SCARA
+      float cartesian[XYZ];
+      mechanics.InverseTransform(pos.x, pos.y, cartesian);
+      pos.x = cartesian[X_AXIS];
+      pos.y = cartesian[Y_AXIS];
+    #endif
+
+    #if HAS_LEVELING
+      bedlevel.unapply_leveling(pos);
+    #endif
+
+    lpos = pos.asLogical();
+    lpos.e = steps.e * extruders[toolManager.extruder.active]->steps_to_mm;
+  }
+
+#endif
+
+#if ENABLED(REALTIME_POSITION_REPORT)
+
+  void Mechanics::report_realtime_position() {
+    xyze_pos_t lpos;
+    get_realtime_position(lpos);
+    SERIAL_MV( "X:", lpos.x);
+    SERIAL_MV(" Y:", lpos.y);
+    SERIAL_MV(" Z:", lpos.z);
+    SERIAL_EMV(" E:", lpos.e);
+  }
+
+#endif
+
 void Mechanics::report_xyz(const xyz_pos_t &pos, const uint8_t precision/*=3*/) {
   char str[12];
   for (uint8_t i = X_AXIS; i <= Z_AXIS; i++) {
@@ -292,7 +349,7 @@ bool Mechanics::axis_unhomed_error(uint8_t axis_bits/*=0x07*/) {
     workspace_offset[axis] = mechanics.data.home_offset[axis] + position_shift[axis];
     if (printer.debugFeature()) {
       DEBUG_MT("For ", axis_codes[axis]);
-      DEBUG_MV(" axis:\n home_offset = ", home_offset[axis]);
+      DEBUG_MV(" axis:\n home_offset = ", mechanics.data.home_offset[axis]);
       DEBUG_EMV("\n position_shift = ", position_shift[axis]);
     }
   }
@@ -404,6 +461,11 @@ bool Mechanics::axis_unhomed_error(uint8_t axis_bits/*=0x07*/) {
    */
   void Mechanics::stop_sensorless_homing_per_axis(const AxisEnum axis, sensorless_flag_t enable_stealth) {
 
+    #if ENABLED(SPI_ENDSTOPS)
+      // Stop the SPI poll before the drivers are written
+      endstops.tmc_spi_homing.any = false;
+    #endif
+
     switch (axis) {
       default: break;
       #if X_HAS_SENSORLESS
@@ -450,7 +512,6 @@ bool Mechanics::axis_unhomed_error(uint8_t axis_bits/*=0x07*/) {
 
     #if ENABLED(SPI_ENDSTOPS)
       endstops.clear_state();
-      endstops.tmc_spi_homing.any = false;
     #endif
 
   }
@@ -187,7 +187,8 @@ class Mechanics {
       // The distance that XYZ has been offset by G92. Reset by G28.
       static xyz_pos_t position_shift;
 
-      // The above two are combined to save on computes
+      // M206 home offset and G92 shift combined, the only offset the moves add.
+      // Refreshed by update_workspace_offset() when one of the two changes.
       static xyz_pos_t workspace_offset;
     #endif
 
@@ -295,6 +296,17 @@ class Mechanics {
      */
     static void report_position();
 
+    #if HAS_REALTIME_POSITION
+      /**
+       * Logical position from the step counts, without waiting for the moves
+       */
+      static void get_realtime_position(xyze_pos_t &lpos);
+    #endif
+
+    #if ENABLED(REALTIME_POSITION_REPORT)
+      static void report_realtime_position();
+    #endif
+
     FORCE_INLINE static void report_xyz(const xyze_pos_t &pos) { report_xyze(pos, 3); }
 
     static uint8_t axis_need_homing(uint8_t axis_bits=0x07);
@@ -353,6 +365,15 @@ class Mechanics {
 
 };
 
+#if ENABLED(WORKSPACE_OFFSETS)
+  inline void toLogical(xy_pos_t &raw)    { raw += Mechanics::workspace_offset; }
+  inline void toLogical(xyz_pos_t &raw)   { raw += Mechanics::workspace_offset; }
+  inline void toLogical(xyze_pos_t &raw)  { raw += Mechanics::workspace_offset; }
+  inline void toNative(xy_pos_t &raw)     { raw -= Mechanics::workspace_offset; }
+  inline void toNative(xyz_pos_t &raw)    { raw -= Mechanics::workspace_offset; }
+  inline void toNative(xyze_pos_t &raw)   { raw -= Mechanics::workspace_offset; }
+#endif
+
 #if MECH(CARTESIAN)
   #include "cartesian_mechanics.h"
 #elif IS_CORE
@@ -61,6 +61,14 @@
   #error "DEPENDENCY ERROR: Missing setting HOMING_BUMP_DIVISOR."
 #endif
 
+#if ENABLED(HOMING_FAST_APPROACH)
+  #if IS_SCARA
+    #error "DEPENDENCY ERROR: HOMING_FAST_APPROACH is not supported for SCARA."
+  #elif DISABLED(HOMING_FAST_APPROACH_MM) || HOMING_FAST_APPROACH_MM <= 0
+    #error "DEPENDENCY ERROR: HOMING_FAST_APPROACH_MM must be greater than 0."
+  #endif
+#endif
+
 // Home direction
 #if DISABLED(X_HOME_DIR)
   #error "DEPENDENCY ERROR: Missing setting X_HOME_DIR."
@@ -242,6 +250,25 @@
 #if DISABLED(N_ARC_CORRECTION)
   #error "DEPENDENCY ERROR: Missing setting N_ARC_CORRECTION."
 #endif
+#if ENABLED(JUNCTION_CURVE_WINDOW)
+  #if DISABLED(JUNCTION_DEVIATION)
+    #error "DEPENDENCY ERROR: JUNCTION_CURVE_WINDOW requires JUNCTION_DEVIATION."
+  #elif JUNCTION_CURVE_WINDOW < 2 || JUNCTION_CURVE_WINDOW > 16
+    #error "DEPENDENCY ERROR: JUNCTION_CURVE_WINDOW must be between 2 and 16."
+  #endif
+#endif
+#if ENABLED(SEGMENT_MERGE)
+  #if IS_KINEMATIC
+    #error "DEPENDENCY ERROR: SEGMENT_MERGE is not compatible with DELTA or SCARA."
+  #elif ENABLED(LASER)
+    #error "DEPENDENCY ERROR: SEGMENT_MERGE is not compatible with LASER."
+  #elif DISABLED(SEGMENT_MERGE_SHORT_MM) || DISABLED(SEGMENT_MERGE_MAX_MM) || DISABLED(SEGMENT_MERGE_TOLERANCE) || DISABLED(SEGMENT_MERGE_E_RATIO)
+    #error "DEPENDENCY ERROR: SEGMENT_MERGE requires SEGMENT_MERGE_SHORT_MM, SEGMENT_MERGE_MAX_MM, SEGMENT_MERGE_TOLERANCE and SEGMENT_MERGE_E_RATIO."
+  #endif
+#endif
+#if ENABLED(ARC_CHORD_TOLERANCE) && DISABLED(ARC_SEGMENTS_PER_SEC)
+  #error "DEPENDENCY ERROR: Missing setting ARC_SEGMENTS_PER_SEC."
+#endif
 #if DISABLED(DEFAULT_AXIS_STEPS_PER_UNIT)
   #error "DEPENDENCY ERROR: Missing setting DEFAULT_AXIS_STEPS_PER_UNIT."
 #endif
@@ -342,6 +369,16 @@
     "DEPENDENCY ERROR: LIN_ADVANCE_K must be a value from 0 to 10."
   );
 #endif
+#if ENABLED(LIN_ADVANCE_BRESENHAM) && DISABLED(LIN_ADVANCE)
+  #error "DEPENDENCY ERROR: LIN_ADVANCE_BRESENHAM requires LIN_ADVANCE."
+#endif
+#if ENABLED(LIN_ADVANCE_PROFILES)
+  #if DISABLED(LIN_ADVANCE)
+    #error "DEPENDENCY ERROR: LIN_ADVANCE_PROFILES requires LIN_ADVANCE."
+  #elif !WITHIN(LIN_ADVANCE_PROFILES, 1, 8)
+    #error "DEPENDENCY ERROR: LIN_ADVANCE_PROFILES must be from 1 to 8."
+  #endif
+#endif
 
 // Z late enable
 #if MECH(COREXZ) && ENABLED(Z_LATE_ENABLE)
@@ -501,6 +538,16 @@
     #error "DEPENDENCY ERROR: TWO ENDSTOPS for Delta is imposible"
   #endif
 
+  /**
+   * BATCH TRANSFORM
+   */
+  #if ENABLED(DELTA_BATCH_TRANSFORM) && !WITHIN(DELTA_BATCH_SIZE, 2, 32)
+    #error "DEPENDENCY ERROR: DELTA_BATCH_SIZE must be from 2 to 32."
+  #endif
+  #if ENABLED(DELTA_ADAPTIVE_SEGMENTS) && DISABLED(DELTA_SEGMENT_TOLERANCE)
+    #error "DEPENDENCY ERROR: Missing setting DELTA_SEGMENT_TOLERANCE."
+  #endif
+
 #endif // MECH(DELTA)
 
 // Scara settings
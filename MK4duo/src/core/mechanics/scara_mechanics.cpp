@@ -30,6 +30,18 @@
 
 #if IS_SCARA
 
+// The polynomial atan2 of fastmath.h: off by 2e-6 rad at most, under 1 micron
+// at the end of 400 mm of arms, for a fraction of the time of atan2f on soft float.
+#if ENABLED(SCARA_FAST_TRIG) || ENABLED(FAST_MATH)
+
+  #define _ATAN2(y, x) fast_atan2(y, x)
+
+#else
+
+  #define _ATAN2(y, x) ATAN2(y, x)
+
+#endif
+
 Scara_Mechanics mechanics;
 
 /** Public Parameters */
@@ -353,10 +365,10 @@ void Scara_Mechanics::Transform(const float raw[XYZ]) {
   SK2 = L2 * S2;
 
   // Angle of Arm1 is the difference between Center-to-End angle and the Center-to-Elbow
-  THETA = ATAN2(SK1, SK2) - ATAN2(sx, sy);
+  THETA = _ATAN2(SK1, SK2) - _ATAN2(sx, sy);
 
   // Angle of Arm2
-  PSI = ATAN2(S2, C2);
+  PSI = _ATAN2(S2, C2);
 
   delta[A_AXIS] = DEGREES(THETA);        // theta is support arm angle
   delta[B_AXIS] = DEGREES(THETA + PSI);  // equal to sub arm angle (inverted motor)
@@ -385,6 +397,9 @@ void Scara_Mechanics::home() {
 
   if (printer.debugSimulation()) {
     LOOP_XYZ(axis) set_axis_is_at_home((AxisEnum)axis);
+    #if HAS_TIME_WARP
+      if (planner.time_warp) sync_plan_position();
+    #endif
     return;
   }
 
@@ -556,6 +571,10 @@ void Scara_Mechanics::set_axis_is_at_home(const AxisEnum axis) {
 
   setAxisHomed(axis, true);
 
+  #if ENABLED(BABYSTEP_PLANNER)
+    if (axis == Z_AXIS) babystep.planner_reset();
+  #endif
+
   #if MECH(MORGAN_SCARA)
 
     /**
@@ -125,7 +125,7 @@ void Nozzle::factory_parameters() {
 
     #if MECH(DELTA)
       if (mechanics.position.z > mechanics.delta_clip_start_height)
-        mechanics.do_blocking_move_to_z(mechanics.delta_clip_start_height);
+        move_to(mechanics.position.x, mechanics.position.y, mechanics.delta_clip_start_height);
     #endif
 
     switch (pattern) {
@@ -133,6 +133,9 @@ void Nozzle::factory_parameters() {
       case 2:   circle(start, end, strokes, radius);  break;
       default:  stroke(start, end, strokes);
     }
+
+    // The pattern was only queued
+    planner.synchronize();
   }
 
 #endif // ENABLED(NOZZLE_CLEAN_FEATURE)
@@ -144,25 +147,63 @@ void Nozzle::factory_parameters() {
     const float fr_xy = NOZZLE_PARK_XY_FEEDRATE;
     const float fr_z  = NOZZLE_PARK_Z_FEEDRATE;
 
+    float park_z;
     switch (z_action) {
       case 1: // force Z-park height
-        mechanics.do_blocking_move_to_z(park_p.z, fr_z);
+        park_z = park_p.z;
         break;
 
       case 2: // Raise by Z-park height
-        mechanics.do_blocking_move_to_z(MIN(mechanics.position.z + park_p.z, Z_MAX_BED), fr_z);
+        park_z = MIN(mechanics.position.z + park_p.z, Z_MAX_BED);
         break;
 
       default: // Raise to Z-park height if lower
-        mechanics.do_blocking_move_to_z(MAX(park_p.z, mechanics.position.z), fr_z);
+        park_z = MAX(park_p.z, mechanics.position.z);
     }
 
-    mechanics.do_blocking_move_to_xy(park_p.x, park_p.y, fr_xy);
+    // Z first, then XY, queued as one stream
+    move_to(mechanics.position.x, mechanics.position.y, park_z, fr_xy, fr_z);
+    move_to(park_p.x, park_p.y, park_z, fr_xy, fr_z);
+    planner.synchronize();
   }
 
 #endif // ENABLED(NOZZLE_PARK_FEATURE)
 
 /** Private Function */
+#if ENABLED(NOZZLE_CLEAN_FEATURE) || ENABLED(NOZZLE_PARK_FEATURE)
+
+  /**
+   * Queue a move, Z raised first and lowered last like do_blocking_move_to,
+   * but without waiting: the planner blends the corners of the sequence.
+   */
+  void Nozzle::move_to(const float rx, const float ry, const float rz, const feedrate_t fr_xy/*=0.0f*/, const feedrate_t fr_z/*=0.0f*/) {
+
+    #if IS_KINEMATIC
+      if (!mechanics.position_is_reachable(rx, ry)) return;
+    #endif
+
+    const feedrate_t z_feedrate = fr_z ? fr_z : mechanics.homing_feedrate_mm_s.z;
+
+    mechanics.destination = mechanics.position;
+
+    if (rz > mechanics.position.z) {
+      mechanics.destination.z = rz;
+      mechanics.prepare_internal_move_to_destination(z_feedrate);
+    }
+
+    if (rx != mechanics.position.x || ry != mechanics.position.y) {
+      mechanics.destination.set(rx, ry);
+      mechanics.prepare_internal_move_to_destination(fr_xy ? fr_xy : feedrate_t(XY_PROBE_FEEDRATE_MM_S));
+    }
+
+    if (rz < mechanics.position.z) {
+      mechanics.destination.z = rz;
+      mechanics.prepare_internal_move_to_destination(z_feedrate);
+    }
+  }
+
+#endif
+
 #if ENABLED(NOZZLE_CLEAN_FEATURE)
 
   void Nozzle::stroke(const xyz_pos_t &start, const xyz_pos_t &end, const uint8_t &strokes) {
@@ -174,20 +215,20 @@ void Nozzle::factory_parameters() {
 
     // Move to the starting point
     #if ENABLED(NOZZLE_CLEAN_NO_Z)
-      mechanics.do_blocking_move_to_xy(start.x, start.y);
+      move_to(start.x, start.y, mechanics.position.z);
     #else
-      mechanics.do_blocking_move_to(start.x, start.y, start.z);
+      move_to(start.x, start.y, start.z);
     #endif
 
     // Start the stroke pattern
     for (uint8_t i = 0; i < (strokes >>1); i++) {
-      mechanics.do_blocking_move_to_xy(end.x, end.y);
-      mechanics.do_blocking_move_to_xy(start.x, start.y);
+      move_xy(end.x, end.y);
+      move_xy(start.x, start.y);
     }
 
     #if ENABLED(NOZZLE_CLEAN_GOBACK)
       // Move the nozzle to the initial point
-      mechanics.do_blocking_move_to(initial);
+      move_to(initial.x, initial.y, initial.z);
     #endif
   }
 
@@ -204,9 +245,9 @@ void Nozzle::factory_parameters() {
     #endif
 
     #if ENABLED(NOZZLE_CLEAN_NO_Z)
-      mechanics.do_blocking_move_to_xy(start.x, start.y);
+      move_to(start.x, start.y, mechanics.position.z);
     #else
-      mechanics.do_blocking_move_to(start.x, start.y, start.z);
+      move_to(start.x, start.y, start.z);
     #endif
 
     const uint8_t zigs = objects << 1;
@@ -218,23 +259,23 @@ void Nozzle::factory_parameters() {
       for (int8_t i = 0; i < zigs; i++) {
         side = (i & 1) ? &end : &start;
         if (horiz)
-          mechanics.do_blocking_move_to_xy(start.x + i * P, side->y);
+          move_xy(start.x + i * P, side->y);
         else
-          mechanics.do_blocking_move_to_xy(side->x, start.y + i * P);
+          move_xy(side->x, start.y + i * P);
       }
 
       for (int8_t i = zigs; i >= 0; i--) {
         side = (i & 1) ? &end : &start;
         if (horiz)
-          mechanics.do_blocking_move_to_xy(start.x + i * P, side->y);
+          move_xy(start.x + i * P, side->y);
         else
-          mechanics.do_blocking_move_to_xy(side->x, start.y + i * P);
+          move_xy(side->x, start.y + i * P);
       }
     }
 
     #if ENABLED(NOZZLE_CLEAN_GOBACK)
       // Move the nozzle to the initial point
-      mechanics.do_blocking_move_to(initial);
+      move_to(initial.x, initial.y, initial.z);
     #endif
   }
 
@@ -248,14 +289,14 @@ void Nozzle::factory_parameters() {
     #endif
 
     #if ENABLED(NOZZLE_CLEAN_NO_Z)
-      mechanics.do_blocking_move_to_xy(start.x, start.y);
+      move_to(start.x, start.y, mechanics.position.z);
     #else
-      mechanics.do_blocking_move_to(start.x, start.y, start.z);
+      move_to(start.x, start.y, start.z);
     #endif
 
     for (uint8_t s = 0; s < strokes; s++) {
       for (uint8_t i = 0; i < NOZZLE_CLEAN_CIRCLE_FN; i++) {
-        mechanics.do_blocking_move_to_xy(
+        move_xy(
           middle.x + SIN((RADIANS(360) / NOZZLE_CLEAN_CIRCLE_FN) * i) * radius,
           middle.y + COS((RADIANS(360) / NOZZLE_CLEAN_CIRCLE_FN) * i) * radius
         );
@@ -263,11 +304,11 @@ void Nozzle::factory_parameters() {
     }
 
     // Let's be safe
-    mechanics.do_blocking_move_to_xy(start.x, start.y);
+    move_xy(start.x, start.y);
 
     #if ENABLED(NOZZLE_CLEAN_GOBACK)
       // Move the nozzle to the initial point
-      mechanics.do_blocking_move_to(initial);
+      move_to(initial.x, initial.y, initial.z);
     #endif
   }
 
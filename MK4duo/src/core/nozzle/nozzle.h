@@ -72,6 +72,17 @@ class Nozzle {
 
   private: /** Private Function */
 
+    #if ENABLED(NOZZLE_CLEAN_FEATURE) || ENABLED(NOZZLE_PARK_FEATURE)
+
+      /**
+       * @brief Queue a move of the sequence
+       * @details The moves of park and clean are queued, then synchronized once
+       */
+      static void move_to(const float rx, const float ry, const float rz, const feedrate_t fr_xy=0.0f, const feedrate_t fr_z=0.0f);
+      static inline void move_xy(const float rx, const float ry) { move_to(rx, ry, mechanics.position.z); }
+
+    #endif
+
     #if ENABLED(NOZZLE_CLEAN_FEATURE)
 
       /**
@@ -68,12 +68,25 @@
 // less movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100
 
+// Minimal step rate of the trapezoid generator (Otherwise the timer will overflow.)
+#define MINIMAL_STEP_RATE 120
+
+// Direction bit of a step delta: the sign bit moved to the axis bit, no branch
+FORCE_INLINE static constexpr uint8_t dir_bit(const int32_t d, const uint8_t axis) {
+  return uint8_t(uint32_t(d) >> 31) << axis;
+}
+
 Planner planner;
 
 /**
  * A ring buffer of moves described in steps
  */
-block_t           Planner::block_buffer[BLOCK_BUFFER_SIZE];
+#if ENABLED(BUFFER_ARENA)
+  block_t         *Planner::block_buffer = nullptr;
+  uint8_t         Planner::block_buffer_mask = 0;
+#else
+  block_t         Planner::block_buffer[BLOCK_BUFFER_SIZE];
+#endif
 volatile uint8_t  Planner::block_buffer_head    = 0,
                   Planner::block_buffer_nonbusy = 0,
                   Planner::block_buffer_planned = 0,
@@ -121,10 +134,74 @@ float Planner::previous_nominal_speed_sqr = 0.0;
   bool Planner::abort_on_endstop_hit = false;
 #endif
 
-#if HAS_SPI_LCD
+#if HAS_BLOCK_BUFFER_RUNTIME
   volatile uint32_t Planner::block_buffer_runtime_us = 0;
 #endif
 
+#if ENABLED(PLANNER_TIMING_STATS)
+  planner_timing_t Planner::timing;
+#endif
+
+#if ENABLED(PLANNER_UNDERRUN_STATS)
+  planner_underrun_t Planner::underrun;
+#endif
+
+#if ENABLED(SEGMENT_MERGE)
+  planner_merge_t Planner::merge;
+#endif
+
+#if ENABLED(CNCROUTER_NATIVE_ARC)
+  const planner_arc_t *Planner::arc_fill = nullptr;
+#endif
+
+#if HAS_TIME_WARP
+  bool      Planner::time_warp  = false;
+  uint32_t  Planner::warp_s     = 0,
+            Planner::warp_us    = 0;
+#endif
+
+#if ENABLED(MOTION_BENCHMARK)
+  uint32_t  Planner::block_count  = 0;
+#endif
+
+#if ENABLED(JUNCTION_CURVE_WINDOW)
+
+  /**
+   * The last junctions of small segments
+   */
+  static struct {
+    uint8_t count,                              // Junctions in the window, without the last one
+            index;                              // Slot of the next junction
+    float   mm[JUNCTION_CURVE_WINDOW - 1],      // Length of the segment after the junction
+            turn[JUNCTION_CURVE_WINDOW - 1];    // Turn angle of the junction
+  } curve;
+
+  /**
+   * Radius of the curve through the window of the last junctions, for the
+   * arc speed of a junction of a small segment. A single pair of segments
+   * of an uneven mesh, or of a path rounded to the steps, gives a radius and
+   * a speed jumping from a junction to the next. A junction turning more than
+   * twice the mean of the window, a real corner, keeps its own radius.
+   */
+  static float junction_curve_radius(const uint8_t count, const float &millimeters, const float &turn) {
+
+    float sum_mm = millimeters, sum_turn = turn;
+    for (uint8_t i = 0, s = curve.index; i < count; i++) {
+      s = (s ? s : JUNCTION_CURVE_WINDOW - 1) - 1;
+      sum_mm += curve.mm[s];
+      sum_turn += curve.turn[s];
+    }
+
+    curve.mm[curve.index] = millimeters;
+    curve.turn[curve.index] = turn;
+    if (++curve.index == JUNCTION_CURVE_WINDOW - 1) curve.index = 0;
+    curve.count = MIN(count + 1, JUNCTION_CURVE_WINDOW - 1);
+
+    return (turn * (count + 1) > 2.0f * sum_turn) ? millimeters / turn : sum_mm / sum_turn;
+  }
+
+#endif
+
 /**
  * Class and Instance Methods
  */
@@ -141,9 +218,19 @@ void Planner::init() {
   previous_nominal_speed_sqr = 0.0f;
   #if ABL_PLANAR
     bedlevel.matrix.set_to_identity();
+    bedlevel.refresh_plane();
   #endif
   clear_block_buffer();
   delay_before_delivering = 0;
+  #if ENABLED(SEGMENT_MERGE)
+    merge.pending = merge.valid = false;
+  #endif
+  #if ENABLED(PLANNER_TIMING_STATS)
+    timing.reset();
+  #endif
+  #if ENABLED(PLANNER_UNDERRUN_STATS)
+    underrun_reset();
+  #endif
 }
 
 #if ENABLED(BEZIER_JERK_CONTROL)
@@ -680,7 +767,7 @@ void Planner::init() {
     for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
       block_t* block = &block_buffer[b];
       if (block->steps.x || block->steps.y || block->steps.z) {
-        float se = (float)block->steps.e / block->step_event_count * SQRT(block->nominal_speed_sqr); // mm/sec;
+        float se = (float)block->steps.e / block->step_event_count * block->nominal_speed; // mm/sec;
         NOLESS(high, se);
       }
     }
@@ -694,6 +781,201 @@ void Planner::init() {
 
 #endif // HAS_TEMP_HOTEND && ENABLED(AUTOTEMP)
 
+#if ENABLED(PLANNER_TIMING_STATS)
+
+  void Planner::report_timing() {
+    SERIAL_SM(ECHO, "Planner time (us)");
+    if (timing.count) {
+      SERIAL_MV(" last:", timing.last_us);
+      SERIAL_MV(" min:", timing.min_us);
+      SERIAL_MV(" max:", timing.max_us);
+      SERIAL_MV(" avg:", timing.total_us / timing.count);
+    }
+    SERIAL_EMV(" blocks:", timing.count);
+  }
+
+#endif // PLANNER_TIMING_STATS
+
+#if ENABLED(PLANNER_UNDERRUN_STATS)
+
+  void Planner::underrun_reset() {
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+    underrun.underruns = underrun.samples = underrun.runtime_total_ms = 0;
+    underrun.runtime_min_ms = underrun.layer_runtime_min_ms = 0xFFFF;
+    underrun.depth_min = underrun.layer_depth_min = 0xFF;
+    underrun.layer = 0;
+    underrun.layer_z = NAN;
+    memset(underrun.last_depth_min, 0xFF, sizeof(underrun.last_depth_min));
+    memset(underrun.last_runtime_min_ms, 0xFF, sizeof(underrun.last_runtime_min_ms));
+
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+  }
+
+  /**
+   * A new layer when an extruding move has a new Z.
+   * The minimums of the layer done go to the list of the last layers.
+   */
+  void Planner::underrun_layer(const float &z) {
+    if (!print_job_counter.isRunning() || z == underrun.layer_z) return;
+    underrun.layer_z = z;
+
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+    if (underrun.layer) {
+      for (uint8_t l = PLANNER_UNDERRUN_LAYERS - 1; l > 0; l--) {
+        underrun.last_depth_min[l]      = underrun.last_depth_min[l - 1];
+        underrun.last_runtime_min_ms[l] = underrun.last_runtime_min_ms[l - 1];
+      }
+      underrun.last_depth_min[0]      = underrun.layer_depth_min;
+      underrun.last_runtime_min_ms[0] = underrun.layer_runtime_min_ms;
+    }
+    underrun.layer++;
+    underrun.layer_depth_min = 0xFF;
+    underrun.layer_runtime_min_ms = 0xFFFF;
+
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+  }
+
+  void Planner::report_underrun() {
+    SERIAL_SMV(ECHO, "Planner underruns:", underrun.underruns);
+    if (underrun.samples) {
+      SERIAL_MV(" depth min:", underrun.depth_min);
+      SERIAL_MV(" queued (ms) min:", underrun.runtime_min_ms);
+      SERIAL_MV(" avg:", underrun.runtime_total_ms / underrun.samples);
+    }
+    SERIAL_MV(" now:", block_buffer_runtime());
+    SERIAL_EMV(" blocks:", underrun.samples);
+
+    // Current layer first, then the last layers
+    for (uint8_t l = 0; l <= PLANNER_UNDERRUN_LAYERS && l < underrun.layer; l++) {
+      const uint8_t   depth = l ? underrun.last_depth_min[l - 1] : underrun.layer_depth_min;
+      const uint16_t  ms    = l ? underrun.last_runtime_min_ms[l - 1] : underrun.layer_runtime_min_ms;
+      SERIAL_SMV(ECHO, " Layer ", underrun.layer - l);
+      if (depth == 0xFF)
+        SERIAL_EM(" no blocks");
+      else {
+        SERIAL_MV(" depth min:", depth);
+        SERIAL_EMV(" queued (ms) min:", ms);
+      }
+    }
+  }
+
+  void Planner::print_underrun_json() {
+    SERIAL_MV(",\"underrun\":{\"count\":", underrun.underruns);
+    SERIAL_MV(",\"depthMin\":", underrun.samples ? underrun.depth_min : 0);
+    SERIAL_MV(",\"queuedMin\":", underrun.samples ? underrun.runtime_min_ms : 0);
+    SERIAL_MV(",\"queuedAvg\":", underrun.samples ? underrun.runtime_total_ms / underrun.samples : 0);
+    SERIAL_MV(",\"layer\":", underrun.layer);
+    SERIAL_MSG(",\"layerDepthMin\":[");
+    for (uint8_t l = 0; l <= PLANNER_UNDERRUN_LAYERS && l < underrun.layer; l++) {
+      const uint8_t depth = l ? underrun.last_depth_min[l - 1] : underrun.layer_depth_min;
+      if (l) SERIAL_CHR(',');
+      SERIAL_VAL(depth == 0xFF ? -1 : int16_t(depth));
+    }
+    SERIAL_MSG("]}");
+  }
+
+  /**
+   * Sample the buffer when the Stepper takes a block
+   * Called from the Stepper ISR
+   */
+  void Planner::underrun_sample(const uint8_t depth) {
+    underrun.running = true;
+    if (!print_job_counter.isRunning()) return;
+
+    const uint16_t ms = MIN(block_buffer_runtime_us >> 10, 0xFFFFUL);
+    if (underrun.depth_min > depth)             underrun.depth_min = depth;
+    if (underrun.layer_depth_min > depth)       underrun.layer_depth_min = depth;
+    if (underrun.runtime_min_ms > ms)           underrun.runtime_min_ms = ms;
+    if (underrun.layer_runtime_min_ms > ms)     underrun.layer_runtime_min_ms = ms;
+
+    // Halve the sums before an overflow, the average stays
+    if (underrun.runtime_total_ms > 0x7FFFFFFFUL) {
+      underrun.runtime_total_ms >>= 1;
+      underrun.samples >>= 1;
+    }
+    underrun.runtime_total_ms += ms;
+    underrun.samples++;
+  }
+
+  /**
+   * The Stepper found the buffer empty after a block.
+   * Not an underrun if the G-code asked to wait.
+   * Called from the Stepper ISR
+   */
+  void Planner::underrun_empty() {
+    underrun.running = false;
+    if (print_job_counter.isRunning() && !underrun.draining && !printer.isWaitForHeatUp() && !printer.isWaitForUser())
+      underrun.underruns++;
+  }
+
+#endif // PLANNER_UNDERRUN_STATS
+
+#if ENABLED(PLANNER_FIXED_POINT)
+
+  /**
+   * Run the fixed point trapezoid generator side by side with the
+   * float formulas over a grid of block shapes and report the
+   * largest differences, in steps and steps/s.
+   */
+  void Planner::fixed_point_accuracy_test() {
+
+    static const uint32_t test_steps[] PROGMEM = { 20, 200, 2000, 20000 },
+                          test_rates[] PROGMEM = { 500, 4000, 16000, 40000 },
+                          test_accel[] PROGMEM = { 300, 3000, 30000, 300000 };
+    static const float    test_factors[] = { 0.0f, 0.25f, 0.7f, 1.0f };
+
+    block_t test_block;
+    uint32_t max_err_steps = 0, max_err_rate = 0, tests = 0;
+
+    for (uint8_t s = 0; s < COUNT(test_steps); s++)
+     for (uint8_t r = 0; r < COUNT(test_rates); r++)
+      for (uint8_t a = 0; a < COUNT(test_accel); a++)
+       for (uint8_t en = 0; en < COUNT(test_factors); en++)
+        for (uint8_t ex = 0; ex < COUNT(test_factors); ex++) {
+
+          const uint32_t step_event_count = pgm_read_dword(&test_steps[s]),
+                         nominal_rate     = pgm_read_dword(&test_rates[r]),
+                         accel            = pgm_read_dword(&test_accel[a]);
+
+          memset(&test_block, 0, sizeof(block_t));
+          test_block.step_event_count = step_event_count;
+          test_block.nominal_rate = nominal_rate;
+          test_block.acceleration_steps_per_s2 = accel;
+          test_block.inverse_accel_steps_q32 = 0xFFFFFFFFUL / (2UL * accel);
+          calculate_trapezoid_for_block(&test_block, test_factors[en], test_factors[ex]);
+
+          // Float reference
+          uint32_t initial_rate = CEIL(test_factors[en] * nominal_rate),
+                   final_rate   = CEIL(test_factors[ex] * nominal_rate);
+          NOLESS(initial_rate, uint32_t(MINIMAL_STEP_RATE));
+          NOLESS(final_rate,   uint32_t(MINIMAL_STEP_RATE));
+          const float accelerate_steps = MAX(CEIL(estimate_acceleration_distance(initial_rate, nominal_rate, accel)), 0),
+                      decelerate_steps = MAX(FLOOR(estimate_acceleration_distance(nominal_rate, final_rate, -float(accel))), 0);
+          uint32_t accelerate_until = accelerate_steps,
+                   decelerate_after = step_event_count - decelerate_steps;
+          if (accelerate_steps + decelerate_steps > step_event_count) {
+            const float steps = CEIL(intersection_distance(initial_rate, final_rate, accel, step_event_count));
+            accelerate_until = decelerate_after = MIN(uint32_t(MAX(steps, 0)), step_event_count);
+          }
+
+          NOLESS(max_err_steps, uint32_t(ABS(int32_t(accelerate_until - test_block.accelerate_until))));
+          NOLESS(max_err_steps, uint32_t(ABS(int32_t(decelerate_after - test_block.decelerate_after))));
+          NOLESS(max_err_rate,  uint32_t(ABS(int32_t(initial_rate - test_block.initial_rate))));
+          NOLESS(max_err_rate,  uint32_t(ABS(int32_t(final_rate - test_block.final_rate))));
+          tests++;
+        }
+
+    SERIAL_SMV(ECHO, "Fixed point trapezoid tests:", tests);
+    SERIAL_MV(" max step error:", max_err_steps);
+    SERIAL_EMV(" max rate error:", max_err_rate);
+  }
+
+#endif // PLANNER_FIXED_POINT
+
 /**
  * Manage Axis, paste pressure, etc.
  */
@@ -786,11 +1068,8 @@ void Planner::check_axes_activity() {
 
 #if HAS_POSITION_MODIFIERS
 
-  void Planner::apply_modifiers(xyze_pos_t &pos
-    #if HAS_LEVELING
-      , bool leveling
-    #endif
-  ) {
+  template<bool leveling>
+  void Planner::apply_modifiers(xyze_pos_t &pos) {
     #if HAS_LEVELING
       if (leveling)
         bedlevel.apply_leveling(pos);
@@ -798,13 +1077,16 @@ void Planner::check_axes_activity() {
     #if ENABLED(FWRETRACT)
       apply_retract(pos);
     #endif
+    #if ENABLED(BABYSTEP_PLANNER)
+      pos.z += babystep.z_offset;
+    #endif
   }
 
-  void Planner::unapply_modifiers(xyze_pos_t &pos
-    #if HAS_LEVELING
-      , bool leveling
+  template<bool leveling>
+  void Planner::unapply_modifiers(xyze_pos_t &pos) {
+    #if ENABLED(BABYSTEP_PLANNER)
+      pos.z -= babystep.z_offset;
     #endif
-  ) {
     #if ENABLED(FWRETRACT)
       unapply_retract(pos);
     #endif
@@ -814,8 +1096,71 @@ void Planner::check_axes_activity() {
     #endif
   }
 
+  template void Planner::apply_modifiers<true>(xyze_pos_t &pos);
+  template void Planner::apply_modifiers<false>(xyze_pos_t &pos);
+  template void Planner::unapply_modifiers<true>(xyze_pos_t &pos);
+  template void Planner::unapply_modifiers<false>(xyze_pos_t &pos);
+
 #endif // HAS_POSITION_MODIFIERS
 
+#if HAS_TIME_WARP
+
+  void Planner::time_warp_start() {
+    synchronize();
+    warp_s = warp_us = 0;
+    time_warp = true;
+  }
+
+  uint32_t Planner::time_warp_stop() {
+    synchronize();
+    time_warp = false;
+    return warp_s + (warp_us + 500000UL) / 1000000UL;
+  }
+
+  void Planner::time_warp_dwell(const millis_l ms) {
+    warp_s += ms / 1000UL;
+    warp_us += (ms % 1000UL) * 1000UL;
+  }
+
+  /**
+   * Time the oldest block from its trapezoid, as the Stepper would run it, and drop it
+   */
+  void Planner::time_warp_block() {
+    block_t * const block = &block_buffer[block_buffer_tail];
+
+    if (!TEST(block->flag, BLOCK_BIT_SYNC_POSITION) && block->step_event_count && block->nominal_rate) {
+      const float acc = block->acceleration_steps_per_s2,
+                  v_i = block->initial_rate,
+                  v_f = block->final_rate;
+      const uint32_t acc_steps = block->accelerate_until,
+                     dec_steps = block->step_event_count - block->decelerate_after;
+      float t;
+      if (acc > 0) {
+        const float v_acc = FAST_SQRT(sq(v_i) + 2.0f * acc * acc_steps),  // Rate at the end of the acceleration
+                    v_dec = FAST_SQRT(sq(v_f) + 2.0f * acc * dec_steps);  // Rate at the start of the deceleration
+        t = (v_acc - v_i) / acc + (v_dec - v_f) / acc
+          + float(block->decelerate_after - acc_steps) / block->nominal_rate;
+      }
+      else
+        t = float(block->step_event_count) / block->nominal_rate;
+
+      warp_us += LROUND(t * 1000000.0f);
+    }
+
+    while (warp_us >= 1000000UL) { warp_us -= 1000000UL; warp_s++; }
+
+    #if HAS_BLOCK_BUFFER_RUNTIME
+      block_buffer_runtime_us -= block->segment_time_us;
+    #endif
+
+    block_buffer_nonbusy = next_block_index(block_buffer_tail);
+    if (block_buffer_tail == block_buffer_planned)
+      block_buffer_planned = block_buffer_nonbusy;
+    discard_current_block();
+  }
+
+#endif // HAS_TIME_WARP
+
 void Planner::quick_stop() {
 
   // Remove all the queued blocks. Note that this function is NOT
@@ -829,15 +1174,39 @@ void Planner::quick_stop() {
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
 
+  #if ENABLED(SEGMENT_MERGE)
+    // And the move held back
+    merge.pending = merge.valid = false;
+  #endif
+
+  #if ENABLED(STEP_QUEUE)
+    // And the steps of the dropped blocks
+    stepQueue.flush();
+  #endif
+
+  #if ENABLED(TOOLBOARD)
+    // And the E segments on the nodes
+    toolboard.reset_segments();
+  #endif
+
+  #if ENABLED(STEP_COPROCESSOR)
+    // And the segments on the coprocessor
+    coprocessor.flush();
+  #endif
+
   // And restart the block delay for the first movement - As the queue was
   // forced to empty, there is no risk the ISR could touch this variable.
   delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
 
-  #if HAS_SPI_LCD
+  #if HAS_BLOCK_BUFFER_RUNTIME
     // Clear the accumulated runtime
     clear_block_buffer_runtime();
   #endif
 
+  #if ENABLED(PLANNER_UNDERRUN_STATS)
+    underrun.running = false;   // Not an underrun
+  #endif
+
   // Make sure to drop any attempt of queuing moves for at least 1 seconds
   cleaning_buffer_flag = true;
 
@@ -849,6 +1218,49 @@ void Planner::quick_stop() {
 
 }
 
+#if ENABLED(STEP_QUEUE) || ENABLED(STEP_COPROCESSOR)
+
+  block_t* Planner::get_queue_block(const uint8_t index) {
+
+    if (index == block_buffer_head) return nullptr;
+
+    #if HAS_TIME_WARP
+      if (time_warp) return nullptr;
+    #endif
+
+    // The delay of the first move, a tick each ms as the Stepper ISR polling an empty queue
+    if (delay_before_delivering) {
+      static millis_s last_ms = 0;
+      const millis_s now = millis();
+      if (now != last_ms) {
+        last_ms = now;
+        --delay_before_delivering;
+      }
+      if (BLOCK_MOD(block_buffer_head - index) < 3 && delay_before_delivering) return nullptr;
+      delay_before_delivering = 0;
+    }
+
+    block_t * const block = &block_buffer[index];
+
+    // No trapezoid calculated? Don't execute yet.
+    if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
+
+    #if HAS_BLOCK_BUFFER_RUNTIME
+      block_buffer_runtime_us -= block->segment_time_us;
+    #endif
+
+    // As this block is busy, advance the nonbusy block pointer
+    block_buffer_nonbusy = next_block_index(index);
+
+    // Push block_buffer_planned pointer, if encountered.
+    if (index == block_buffer_planned)
+      block_buffer_planned = block_buffer_nonbusy;
+
+    return block;
+  }
+
+#endif // STEP_QUEUE || STEP_COPROCESSOR
+
 void Planner::endstop_triggered(const AxisEnum axis) {
   // Record stepper position and discard the current block
   stepper.endstop_triggered(axis);
@@ -895,14 +1307,38 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 
   #endif
 
-  return axis_steps * mechanics.steps_to_mm[axis];
+  // The E steps are of the active extruder
+  return axis_steps * (axis == E_AXIS ? extruders[toolManager.extruder.active]->steps_to_mm : mechanics.steps_to_mm[axis]);
 }
 
 void Planner::synchronize() {
-  while (has_blocks_queued() || cleaning_buffer_flag) {
+  #if ENABLED(SEGMENT_MERGE)
+    merge_flush();
+  #endif
+  #if HAS_TIME_WARP
+    while (time_warp && has_blocks_queued()) time_warp_block();
+  #endif
+  #if ENABLED(PLANNER_UNDERRUN_STATS)
+    underrun.draining = true;
+  #endif
+  while (has_blocks_queued() || cleaning_buffer_flag
+    #if ENABLED(INPUT_SHAPING)
+      || shaping.pending()
+    #endif
+    #if ENABLED(STEP_COPROCESSOR)
+      || coprocessor.pending()
+    #endif
+  ) {
     printer.idle();
     PRINTER_KEEPALIVE(InProcess);
+    #if ENABLED(PLANNER_SLEEP_WAIT)
+      // Nothing to read, sleep up to the next interrupt: stepper, tick or serial
+      if (has_blocks_queued() && !commands.input_pending()) HAL::waitForInterrupt();
+    #endif
   }
+  #if ENABLED(PLANNER_UNDERRUN_STATS)
+    underrun.draining = false;
+  #endif
 }
 
 void Planner::finish_and_disable() {
@@ -936,10 +1372,18 @@ bool Planner::buffer_steps(const xyze_long_t &target
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_flag) return false;
 
+  #if ENABLED(TMC_IDLE_CURRENT)
+    tmc.run_current();
+  #endif
+
   // Wait for the next available block
   uint8_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
 
+  #if ENABLED(PLANNER_TIMING_STATS)
+    const uint32_t plan_start_us = micros();
+  #endif
+
   // Fill the block with the specified movement
   if (!fill_block(block, false, target
     #if HAS_POSITION_FLOAT
@@ -968,9 +1412,17 @@ bool Planner::buffer_steps(const xyze_long_t &target
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  #if ENABLED(MOTION_BENCHMARK)
+    block_count++;
+  #endif
+
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
 
+  #if ENABLED(PLANNER_TIMING_STATS)
+    timing.update(micros() - plan_start_us);
+  #endif
+
   // Movement successfully queued!
   return true;
 }
@@ -1040,45 +1492,42 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     }
   #endif // PREVENT_COLD_EXTRUSION || PREVENT_LENGTHY_EXTRUDE
 
-  #if CORE_IS_XY
-    long da = dx + CORE_FACTOR * dy;
-    long db = dx - CORE_FACTOR * dy;
-  #elif CORE_IS_XZ
-    long da = dx + CORE_FACTOR * dz;
-    long dc = dx - CORE_FACTOR * dz;
-  #elif CORE_IS_YZ
-    long db = dy + CORE_FACTOR * dz;
-    long dc = dy - CORE_FACTOR * dz;
+  /**
+   * Head deltas and motor deltas. On the Core machines CORE_AXIS_1, CORE_AXIS_2
+   * and NORMAL_AXIS are constants, the indexing compiles to fixed fields and the
+   * same code serves CoreXY, CoreXZ and CoreYZ.
+   */
+  const xyz_long_t dh = { dx, dy, dz };
+  #if IS_CORE
+    abc_long_t dm;
+    dm[NORMAL_AXIS] = dh[NORMAL_AXIS];
+    dm[CORE_AXIS_1] = dh[CORE_AXIS_1] + CORE_FACTOR * dh[CORE_AXIS_2];
+    dm[CORE_AXIS_2] = CORESIGN(dh[CORE_AXIS_1] - CORE_FACTOR * dh[CORE_AXIS_2]);
+  #else
+    const abc_long_t &dm = dh;
   #endif
 
   // Compute direction bit for this block
-  uint8_t dirb = 0;
-  #if CORE_IS_XY
-    if (dx < 0) SBI(dirb, X_HEAD);            // Save the real Nozzle (head) direction in X Axis
-    if (dy < 0) SBI(dirb, Y_HEAD);            // ...and Y
-    if (dz < 0) SBI(dirb, Z_AXIS);
-    if (da < 0) SBI(dirb, A_AXIS);            // Motor A direction
-    if (CORESIGN(db) < 0) SBI(dirb, B_AXIS);  // Motor B direction
-  #elif CORE_IS_XZ
-    if (dx < 0) SBI(dirb, X_HEAD);            // Save the real Nozzle (head) direction in X Axis
-    if (dy < 0) SBI(dirb, Y_AXIS);
-    if (dz < 0) SBI(dirb, Z_HEAD);            // ...and Z
-    if (da < 0) SBI(dirb, A_AXIS);            // Motor A direction
-    if (CORESIGN(dc) < 0) SBI(dirb, C_AXIS);  // Motor C direction
-  #elif CORE_IS_YZ
-    if (dx < 0) SBI(dirb, X_AXIS);
-    if (dy < 0) SBI(dirb, Y_HEAD);            // Save the real Nozzle (head) direction in Y Axis
-    if (dz < 0) SBI(dirb, Z_HEAD);            // ...and Z
-    if (db < 0) SBI(dirb, B_AXIS);            // Motor B direction
-    if (CORESIGN(dc) < 0) SBI(dirb, C_AXIS);  // Motor C direction
+  #if IS_CORE
+    const uint8_t dirb  = dir_bit(dh[CORE_AXIS_1], X_HEAD + CORE_AXIS_1)  // Save the real Nozzle (head) direction
+                        | dir_bit(dh[CORE_AXIS_2], X_HEAD + CORE_AXIS_2)  // ...of both core axes
+                        | dir_bit(dm[NORMAL_AXIS], NORMAL_AXIS)
+                        | dir_bit(dm[CORE_AXIS_1], CORE_AXIS_1)           // Motor directions
+                        | dir_bit(dm[CORE_AXIS_2], CORE_AXIS_2)
+                        | dir_bit(de, E_AXIS);
   #else
-    if (dx < 0) SBI(dirb, X_AXIS);
-    if (dy < 0) SBI(dirb, Y_AXIS);
-    if (dz < 0) SBI(dirb, Z_AXIS);
+    const uint8_t dirb  = dir_bit(dx, X_AXIS) | dir_bit(dy, Y_AXIS) | dir_bit(dz, Z_AXIS) | dir_bit(de, E_AXIS);
   #endif
-  if (de < 0) SBI(dirb, E_AXIS);
 
-  const float esteps_float = de * extruders[extruder]->e_factor;
+  #if ENABLED(FILAMENT_WIDTH_SENSOR)
+    float esteps_float = de * extruders[extruder]->e_factor * (extruder == FILAMENT_SENSOR_EXTRUDER_NUM ? filwidth_block_factor() : 1.0f);
+  #else
+    float esteps_float = de * extruders[extruder]->e_factor;
+  #endif
+  #if ENABLED(LIN_ADVANCE_PROFILES)
+    // The flow of the feature on the print moves, not on the retracts and the primes
+    if (dx || dy || dz) esteps_float *= toolManager.profile_flow;
+  #endif
   const uint32_t esteps = ABS(esteps_float) + 0.5;
 
   // Clear all flags, including the "busy" bit
@@ -1089,19 +1538,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
   // Number of steps for each axis
   // See http://www.corexy.com/theory.html
-  #if CORE_IS_XY
-    // corexy planning
-    block->steps.set(ABS(da), ABS(db), ABS(dz));
-  #elif CORE_IS_XZ
-    // corexz planning
-    block->steps.set(ABS(da), ABS(dy), ABS(dc));
-  #elif CORE_IS_YZ
-    // coreyz planning
-    block->steps.set(ABS(dx), ABS(db), ABS(dc));
-  #else
-    // default non-h-bot planning
-    block->steps.set(ABS(dx), ABS(dy), ABS(dz));
-  #endif
+  block->steps.set(ABS(dm.a), ABS(dm.b), ABS(dm.c));
 
   /**
    * This part of the code calculates the total length of the movement.
@@ -1115,25 +1552,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     struct DeltaMM : abce_float_t {
       xyz_pos_t head;
     } delta_mm;
-    #if CORE_IS_XY
-      delta_mm.head.x = dx * mechanics.steps_to_mm.a;
-      delta_mm.head.y = dy * mechanics.steps_to_mm.b;
-      delta_mm.z      = dz * mechanics.steps_to_mm.z;
-      delta_mm.a      = da * mechanics.steps_to_mm.a;
-      delta_mm.b      = CORESIGN(db) * mechanics.steps_to_mm.b;
-    #elif CORE_IS_XZ
-      delta_mm.head.x = dx * mechanics.steps_to_mm.a;
-      delta_mm.y      = dy * mechanics.steps_to_mm.y;
-      delta_mm.head.z = dz * mechanics.steps_to_mm.c;
-      delta_mm.a      = da * mechanics.steps_to_mm.a;
-      delta_mm.c      = CORESIGN(dc) * mechanics.steps_to_mm.c;
-    #elif CORE_IS_YZ
-      delta_mm.x      = dx * mechanics.steps_to_mm.x;
-      delta_mm.head.y = dy * mechanics.steps_to_mm.b;
-      delta_mm.head.z = dz * mechanics.steps_to_mm.c;
-      delta_mm.b      = db * mechanics.steps_to_mm.b;
-      delta_mm.c      = CORESIGN(dc) * mechanics.steps_to_mm.c;
-    #endif
+    delta_mm.head[CORE_AXIS_1]  = dh[CORE_AXIS_1] * mechanics.steps_to_mm[CORE_AXIS_1];
+    delta_mm.head[CORE_AXIS_2]  = dh[CORE_AXIS_2] * mechanics.steps_to_mm[CORE_AXIS_2];
+    delta_mm[NORMAL_AXIS]       = dm[NORMAL_AXIS] * mechanics.steps_to_mm[NORMAL_AXIS];
+    delta_mm[CORE_AXIS_1]       = dm[CORE_AXIS_1] * mechanics.steps_to_mm[CORE_AXIS_1];
+    delta_mm[CORE_AXIS_2]       = dm[CORE_AXIS_2] * mechanics.steps_to_mm[CORE_AXIS_2];
   #else
     xyze_float_t delta_mm;
     delta_mm.x        = dx * mechanics.steps_to_mm.x;
@@ -1142,7 +1565,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   #endif
   delta_mm.e = esteps_float * extruders[extruder]->steps_to_mm;
 
-  if (block->steps.x < MIN_STEPS_PER_SEGMENT && block->steps.y < MIN_STEPS_PER_SEGMENT && block->steps.z < MIN_STEPS_PER_SEGMENT) {
+  if (block->steps.x < MIN_STEPS_PER_SEGMENT && block->steps.y < MIN_STEPS_PER_SEGMENT && block->steps.z < MIN_STEPS_PER_SEGMENT && esteps) {
     block->millimeters = ABS(delta_mm.e);
   }
   else {
@@ -1150,12 +1573,8 @@ bool Planner::fill_block(block_t * const block, bool split_move,
       block->millimeters = millimeters;
     else
       block->millimeters = SQRT(
-        #if CORE_IS_XY
-          sq(delta_mm.head.x) + sq(delta_mm.head.y) + sq(delta_mm.z)
-        #elif CORE_IS_XZ
-          sq(delta_mm.head.x) + sq(delta_mm.y) + sq(delta_mm.head.z)
-        #elif CORE_IS_YZ
-          sq(delta_mm.x) + sq(delta_mm.head.y) + sq(delta_mm.head.z)
+        #if IS_CORE
+          sq(delta_mm.head[CORE_AXIS_1]) + sq(delta_mm.head[CORE_AXIS_2]) + sq(delta_mm[NORMAL_AXIS])
         #else
           sq(delta_mm.x) + sq(delta_mm.y) + sq(delta_mm.z)
         #endif
@@ -1167,15 +1586,32 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
   }
 
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
+    /**
+     * On an arc the speed of each axis goes with the other coordinate, the
+     * limits of the axes are taken at the end where it is the highest. The
+     * unit tangents at the ends, scaled to the XY part, are for the junctions.
+     */
+    xy_float_t arc_entry{0.0f}, arc_exit{0.0f};
+    if (arc_fill) {
+      const planner_arc_t &arc = *arc_fill;
+      const float k = arc.dir * arc.travel * mechanics.steps_to_mm.x / block->millimeters;
+      arc_entry.set(-arc.start.y * k, arc.start.x * k);
+      arc_exit.set(-arc.end.y * k, arc.end.x * k);
+      delta_mm.x = block->millimeters * MAX(ABS(arc_entry.x), ABS(arc_exit.x));
+      delta_mm.y = block->millimeters * MAX(ABS(arc_entry.y), ABS(arc_exit.y));
+    }
+  #endif
+
   block->steps.e = esteps;
   block->step_event_count = MAX(block->steps.x, block->steps.y, block->steps.z, esteps);
 
   // Bail if this is a zero-length block
   if (printer.mode == PRINTER_MODE_FFF && block->step_event_count < MIN_STEPS_PER_SEGMENT) return false;
 
-  // For a mixing extruder, get a magnified step_event_count for each
+  // For a mixing extruder, the step weights of the mixing steppers
   #if ENABLED(COLOR_MIXING_EXTRUDER)
-    mixer.populate_block(block->b_color);
+    mixer.populate_block(block->b_weight);
   #endif
 
   #if ENABLED(BARICUDA)
@@ -1236,14 +1672,14 @@ bool Planner::fill_block(block_t * const block, bool split_move,
           if (g_uc_extruder_last_move[e] > 0) g_uc_extruder_last_move[e]--;
           if (e == extruder) {
             stepper.enable_E(e);
-            g_uc_extruder_last_move[e] = (BLOCK_BUFFER_SIZE) * 2;
+            g_uc_extruder_last_move[e] = block_buffer_size() * 2;
           }
           else
             if (!g_uc_extruder_last_move[e]) stepper.disable_E(e);
           #if ENABLED(DUAL_X_CARRIAGE)
             if (e == 0 && mechanics.extruder_duplication_enabled) {
               stepper.enable_E(1);
-              g_uc_extruder_last_move[1] = (BLOCK_BUFFER_SIZE) * 2;
+              g_uc_extruder_last_move[1] = block_buffer_size() * 2;
             }
           #endif
         }
@@ -1322,10 +1758,15 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     // When operating in PULSED or RASTER modes, laser pulsing must operate in sync with movement.
     // Calculate steps between laser firings (steps_l) and consider that when determining largest
     // interval between steps for X, Y, Z, E, L to feed to the motion control code.
+    #if ENABLED(LASER_RASTER)
+      block->laser_raster_len = 0;
+    #endif
     if (laser.mode == RASTER || laser.mode == PULSED) {
       block->steps_l = ABS(block->millimeters * laser.ppm);
       #if ENABLED(LASER_RASTER)
-        for (uint8_t i = 0; i < LASER_MAX_RASTER_LINE; i++) {
+        const uint16_t raster_len = laser.mode == RASTER ? constrain(laser.raster_num_pixels, 0, LASER_MAX_RASTER_LINE) : 0;
+        unsigned char * const raster_data = raster_len ? &laser.raster_pool[laser.raster_pool_take(raster_len)] : nullptr;
+        for (uint16_t i = 0; i < raster_len; i++) {
           // Scale the image intensity based on the raster power.
           // 100% power on a pixel basis is 255, convert back to 255 = 100.
           #if ENABLED(LASER_REMAP_INTENSITY)
@@ -1341,7 +1782,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
             if (NewValue <= LASER_REMAP_INTENSITY) NewValue = 0;
           #endif
 
-          block->laser_raster_data[i] = NewValue;
+          raster_data[i] = NewValue;
+        }
+        if (raster_len) {
+          block->laser_raster_index = raster_data - laser.raster_pool;
+          block->laser_raster_len = raster_len;
         }
       #endif
     }
@@ -1365,25 +1810,25 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   const uint8_t moves_queued = nonbusy_moves_planned();
 
   // Slow down when the buffer starts to empty, rather than wait at the corner for a buffer refill
-  #if ENABLED(SLOWDOWN) || HAS_SPI_LCD || ENABLED(XY_FREQUENCY_LIMIT)
+  #if ENABLED(SLOWDOWN) || HAS_BLOCK_BUFFER_RUNTIME || ENABLED(XY_FREQUENCY_LIMIT)
     // Segment time im micro seconds
     uint32_t segment_time_us = LROUND(1000000.0f / inverse_secs);
   #endif
 
   #if ENABLED(SLOWDOWN)
-    if (WITHIN(moves_queued, 2, (BLOCK_BUFFER_SIZE) / 2 - 1)) {
+    if (WITHIN(moves_queued, 2, block_buffer_size() / 2 - 1)) {
       if (segment_time_us < mechanics.data.min_segment_time_us) {
         // buffer is draining, add extra time.  The amount of time added increases if the buffer is still emptied more.
         const uint32_t nst = segment_time_us + LROUND(2 * (mechanics.data.min_segment_time_us - segment_time_us) / moves_queued);
         inverse_secs = 1000000.0f / nst;
-        #if ENABLED(XY_FREQUENCY_LIMIT) || HAS_SPI_LCD
+        #if ENABLED(XY_FREQUENCY_LIMIT) || HAS_BLOCK_BUFFER_RUNTIME
           segment_time_us = nst;
         #endif
       }
     }
   #endif
 
-  #if HAS_SPI_LCD
+  #if HAS_BLOCK_BUFFER_RUNTIME
     // Disable stepper ISR
     const bool isr_enabled = STEPPER_ISR_ENABLED();
     if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
@@ -1443,9 +1888,26 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     }
     else {
       if (cs > mechanics.data.max_feedrate_mm_s[i]) NOMORE(speed_factor, mechanics.data.max_feedrate_mm_s[i] / cs);
+      #if ENABLED(INPUT_SHAPING)
+        // The shaping queue holds the steps of the last echo delay
+        if (i < XY && shaping.axis[i].enabled) {
+          const float max_fr = float(shaping.axis[i].max_rate) / mechanics.data.axis_steps_per_mm[i];
+          if (cs > max_fr) NOMORE(speed_factor, max_fr / cs);
+        }
+      #endif
     }
   }
 
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
+    // The centripetal acceleration at the nominal speed within the one of X and Y
+    if (arc_fill) {
+      const float max_speed_sqr = arc_fill->radius * mechanics.steps_to_mm.x
+                                * MIN(mechanics.data.max_acceleration_mm_per_s2.x, mechanics.data.max_acceleration_mm_per_s2.y);
+      if (block->nominal_speed_sqr * sq(speed_factor) > max_speed_sqr)
+        speed_factor = SQRT(max_speed_sqr / block->nominal_speed_sqr);
+    }
+  #endif
+
   // Max segment time in Âµs.
   #if ENABLED(XY_FREQUENCY_LIMIT)
 
@@ -1491,9 +1953,18 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     block->nominal_speed_sqr = block->nominal_speed_sqr * sq(speed_factor);
   }
 
+  #if ENABLED(LASER_DYNAMIC_POWER)
+    block->laser_power_factor = uint32_t(block->laser_intensity * 65536.0f / block->nominal_rate);
+  #endif
+
   // Compute and limit the acceleration rate for the trapezoid generator.
   const float steps_per_mm = block->step_event_count * inverse_millimeters;
   uint32_t accel;
+
+  #if ENABLED(LIN_ADVANCE)
+    // The K is fixed in the block, a new K or profile is for the next moves only
+    const float advance_K = toolManager.advance_K(extruder);
+  #endif
   if (!block->steps.x && !block->steps.y && !block->steps.z) {
     // convert to: acceleration steps/sec^2
     accel = CEIL(extruders[extruder]->data.retract_acceleration * steps_per_mm);
@@ -1519,11 +1990,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
        * de > 0             : Extruder is running forward (e.g., for "Wipe while retracting" (Slic3r) or "Combing" (Cura) moves)
        */
       block->use_advance_lead =  esteps
-                              && extruders[extruder]->data.advance_K
+                              && advance_K
                               && de > 0;
 
       if (block->use_advance_lead) {
-        block->e_D_ratio = (target_float.e - position_float.e) /
+        const float e_D_ratio = (target_float.e - position_float.e) /
           #if IS_KINEMATIC
             block->millimeters
           #else
@@ -1535,10 +2006,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
         // Check for unusual high e_D ratio to detect if a retract move was combined with the last print move due to min. steps per segment. Never execute this with advance!
         // This assumes no one will use a retract length of 0mm < retr_length < ~0.2mm and no one will print 100mm wide lines using 3mm filament or 35mm wide lines using 1.75mm filament.
-        if (block->e_D_ratio > 3.0f)
+        if (e_D_ratio > 3.0f)
           block->use_advance_lead = false;
         else {
-          const uint32_t max_accel_steps_per_s2 = extruders[extruder]->data.max_jerk / (extruders[extruder]->data.advance_K * block->e_D_ratio) * steps_per_mm;
+          block->adv_comp = advance_K * e_D_ratio * extruders[extruder]->data.axis_steps_per_mm;
+          const uint32_t max_accel_steps_per_s2 = extruders[extruder]->data.max_jerk / (advance_K * e_D_ratio) * steps_per_mm;
           if (printer.debugFeature() && accel > max_accel_steps_per_s2) DEBUG_EM("Acceleration limited.");
           NOMORE(accel, max_accel_steps_per_s2);
         }
@@ -1573,14 +2045,24 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   }
   block->acceleration_steps_per_s2 = accel;
   block->acceleration = accel / steps_per_mm;
+
+  // Cache the derived quantities used over and over by the planner kernels
+  block->nominal_speed          = FAST_SQRT(block->nominal_speed_sqr);
+  block->inverse_nominal_speed  = 1.0f / block->nominal_speed;
+  block->accel_distance_x2      = 2.0f * block->acceleration * block->millimeters;
+  #if ENABLED(PLANNER_FIXED_POINT)
+    block->inverse_accel_steps_q32 = accel ? 0xFFFFFFFFUL / (2UL * accel) : 0;
+  #else
+    block->inverse_accel_steps_x2 = accel ? 0.5f / accel : 0.0f;
+  #endif
   #if DISABLED(BEZIER_JERK_CONTROL)
     block->acceleration_rate = (uint32_t)(accel * (4096.0f * 4096.0f / (STEPPER_TIMER_RATE)));
   #endif
   #if ENABLED(LIN_ADVANCE)
     if (block->use_advance_lead) {
-      block->advance_speed = (STEPPER_TIMER_RATE) / (extruders[extruder]->data.advance_K * block->e_D_ratio * block->acceleration * extruders[extruder]->data.axis_steps_per_mm);
+      block->advance_speed = (STEPPER_TIMER_RATE) / (block->adv_comp * block->acceleration);
       if (printer.debugFeature()) {
-        if (extruders[extruder]->data.advance_K * block->e_D_ratio * block->acceleration * 2 < SQRT(block->nominal_speed_sqr) * block->e_D_ratio)
+        if (advance_K * block->acceleration * 2 < block->nominal_speed)
           DEBUG_EM("More than 2 steps per eISR loop executed.");
         if (block->advance_speed < 200)
           DEBUG_EM("eISR running at > 10kHz.");
@@ -1601,6 +2083,13 @@ bool Planner::fill_block(block_t * const block, bool split_move,
       xyze_float_t unit_vec = delta_mm * inverse_millimeters;
     #endif
 
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      if (arc_fill) {
+        unit_vec.x = arc_entry.x;
+        unit_vec.y = arc_entry.y;
+      }
+    #endif
+
     #if IS_CORE
       /**
        * On CoreXY the length of the vector [A,B] is SQRT(2) times the length of the head movement vector [X,Y].
@@ -1610,6 +2099,12 @@ bool Planner::fill_block(block_t * const block, bool split_move,
       normalize_junction_vector(unit_vec);
     #endif
 
+    #if ENABLED(JUNCTION_CURVE_WINDOW)
+      // The window goes on only with a junction of a small segment
+      const uint8_t curve_count = curve.count;
+      curve.count = 0;
+    #endif
+
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed_sqr)) {
       // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
@@ -1631,7 +2126,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
         normalize_junction_vector(junction_unit_vec);
 
         const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
-                    sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
+                    sin_theta_d2 = FAST_SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
 
         vmax_junction_sqr = (junction_acceleration * mechanics.data.junction_deviation_mm * sin_theta_d2) / (1.0f - sin_theta_d2);
         if (block->millimeters < 1) {
@@ -1641,7 +2136,11 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
           // If angle is greater than 135 degrees (octagon), find speed for approximate arc
           if (junction_theta > RADIANS(135)) {
-            const float limit_sqr = block->millimeters / (RADIANS(180) - junction_theta) * junction_acceleration;
+            #if ENABLED(JUNCTION_CURVE_WINDOW)
+              const float limit_sqr = junction_curve_radius(curve_count, block->millimeters, RADIANS(180) - junction_theta) * junction_acceleration;
+            #else
+              const float limit_sqr = block->millimeters / (RADIANS(180) - junction_theta) * junction_acceleration;
+            #endif
             NOMORE(vmax_junction_sqr, limit_sqr);
           }
         }
@@ -1655,11 +2154,27 @@ bool Planner::fill_block(block_t * const block, bool split_move,
 
     previous_unit_vec = unit_vec;
 
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      // The next junction is with the end of the arc
+      if (arc_fill) {
+        previous_unit_vec.x = arc_exit.x;
+        previous_unit_vec.y = arc_exit.y;
+      }
+    #endif
+
   #endif // ENABLED(JUNCTION_DEVIATION)
 
   #if HAS_CLASSIC_JERK
 
-    const float nominal_speed = SQRT(block->nominal_speed_sqr);
+    const float nominal_speed = block->nominal_speed;
+
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      // The speed of the axes at the start of the arc
+      if (arc_fill) {
+        current_speed.x = arc_entry.x * nominal_speed;
+        current_speed.y = arc_entry.y * nominal_speed;
+      }
+    #endif
 
     // Exit speed limited by a jerk to full halt of a previous last segment
     static float previous_safe_speed;
@@ -1757,7 +2272,7 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   block->max_entry_speed_sqr = vmax_junction_sqr;
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
-  const float v_allowable_sqr = max_allowable_speed_sqr(-block->acceleration, sq(MINIMUM_PLANNER_SPEED), block->millimeters);
+  const float v_allowable_sqr = max_allowable_speed_sqr(block, sq(MINIMUM_PLANNER_SPEED));
 
   // If we are trying to add a split block, start with the
   // max. allowed speed to avoid an interrupted first move.
@@ -1776,6 +2291,12 @@ bool Planner::fill_block(block_t * const block, bool split_move,
   // Update previous path unit_vector and nominal speed
   previous_speed = current_speed;
   previous_nominal_speed_sqr = block->nominal_speed_sqr;
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
+    if (arc_fill) {
+      previous_speed.x = arc_exit.x * block->nominal_speed;
+      previous_speed.y = arc_exit.y * block->nominal_speed;
+    }
+  #endif
 
   // Update the position
   position = target;
@@ -1791,6 +2312,10 @@ bool Planner::fill_block(block_t * const block, bool split_move,
     block->sdpos = restart.get_sdpos();
   #endif
 
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
+    if (arc_fill) fill_arc(block);
+  #endif
+
   // Movement was accepted
   return true;
 
@@ -1801,6 +2326,10 @@ bool Planner::fill_block(block_t * const block, bool split_move,
  * Add a block to the buffer that just updates the position
  */
 void Planner::buffer_sync_block() {
+  #if ENABLED(SEGMENT_MERGE)
+    merge_flush();
+  #endif
+
   // Wait for the next available block
   uint8_t next_buffer_head;
   block_t * const block = get_next_free_block(next_buffer_head);
@@ -1808,6 +2337,80 @@ void Planner::buffer_sync_block() {
   // Clear block
   memset(block, 0, sizeof(block_t));
 
+  commit_sync_block(block, next_buffer_head);
+}
+
+#if ENABLED(SYNCHRONOUS_FAN_SPEED)
+
+  /**
+   * Planner::buffer_sync_fan
+   * A sync block carrying a fan speed, the stepper set it in order with the moves
+   */
+  void Planner::buffer_sync_fan(const uint8_t f, const uint8_t speed) {
+    #if ENABLED(SEGMENT_MERGE)
+      merge_flush();
+    #endif
+
+    uint8_t next_buffer_head;
+    block_t * const block = get_next_free_block(next_buffer_head);
+
+    memset(block, 0, sizeof(block_t));
+
+    block->sync_fan       = f + 1;
+    block->sync_fan_speed = speed;
+
+    commit_sync_block(block, next_buffer_head);
+  }
+
+#endif
+
+#if ENABLED(DLP_LAYER_CYCLE)
+
+  /**
+   * Planner::buffer_sync_dwell
+   * Sync blocks carrying a wait, the stepper holds each one for its time
+   */
+  void Planner::buffer_sync_dwell(millis_l ms) {
+    #if ENABLED(SEGMENT_MERGE)
+      merge_flush();
+    #endif
+
+    while (ms) {
+      uint8_t next_buffer_head;
+      block_t * const block = get_next_free_block(next_buffer_head);
+
+      memset(block, 0, sizeof(block_t));
+
+      block->sync_dwell = MIN(ms, millis_l(UINT16_MAX));
+      ms -= block->sync_dwell;
+
+      commit_sync_block(block, next_buffer_head);
+    }
+  }
+
+  /**
+   * Planner::buffer_sync_expose
+   * A sync block carrying the exposure, the stepper switches it in order with the moves
+   */
+  void Planner::buffer_sync_expose(const bool on) {
+    #if ENABLED(SEGMENT_MERGE)
+      merge_flush();
+    #endif
+
+    uint8_t next_buffer_head;
+    block_t * const block = get_next_free_block(next_buffer_head);
+
+    memset(block, 0, sizeof(block_t));
+
+    block->sync_expose = on ? DLP_EXPOSE_ON : DLP_EXPOSE_OFF;
+
+    commit_sync_block(block, next_buffer_head);
+  }
+
+#endif
+
+void Planner::commit_sync_block(block_t * const block, const uint8_t next_buffer_head) {
+
   block->flag = BLOCK_FLAG_SYNC_POSITION;
 
   block->position = position;
@@ -1849,6 +2452,11 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_flag) return false;
 
+  #if ENABLED(SEGMENT_MERGE)
+    // The move held back goes first
+    merge_flush();
+  #endif
+
   // The target position of the tool in absolute steps
   // Calculate target position in absolute steps
   const abce_long_t target = {
@@ -1863,7 +2471,11 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
   #endif
 
   // DRYRUN or Simulation prevents E moves from taking place
-  if (printer.debugDryrun() || printer.debugSimulation()) {
+  if (printer.debugDryrun() || (printer.debugSimulation()
+    #if HAS_TIME_WARP
+      && !time_warp
+    #endif
+  )) {
     position.e = target.e;
     #if HAS_POSITION_FLOAT
       position_float.e = e;
@@ -1899,7 +2511,16 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
   //*/
 
   // Simulation Mode no movement
-  if (printer.debugSimulation()) position = target;
+  if (printer.debugSimulation()
+    #if HAS_TIME_WARP
+      && !time_warp
+    #endif
+  ) position = target;
+
+  #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+    // The filament of the tool change must be at the extruder gears before an E move
+    if (target.e != position.e) mmu2.wait_tool_change();
+  #endif
 
   // Queue the movement
   if (!buffer_steps(target
@@ -1938,49 +2559,347 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
 
   #if IS_KINEMATIC
 
+    mechanics.Transform(raw);
+
+    const xyze_pos_t cart = { rx, ry, rz, e };
+    const abce_pos_t machine = { mechanics.delta.a, mechanics.delta.b, mechanics.delta.c, raw.e };
+    return buffer_line_kinematic(cart, machine, fr_mm_s, extruder, millimeters);
+
+  #elif ENABLED(SEGMENT_MERGE)
+
+    return merge_line(raw, fr_mm_s, extruder, millimeters);
+
+  #else
+
+    return buffer_segment(raw, fr_mm_s, extruder, millimeters);
+
+  #endif
+
+}
+
+#if ENABLED(CNCROUTER_NATIVE_ARC)
+
+  #define ARC_DIAGONAL_MARGIN 2   // (steps) Points nearer a diagonal have no major axis
+  #define ARC_MIN_RADIUS      32  // (steps)
+
+  /**
+   * The coordinate >= 0 of the integer point nearest the circle r2, for the other one u.
+   * The two candidates can't be at the same distance: 2 * w is even, 2 * m^2 + 2 * m + 1 odd.
+   */
+  static int32_t arc_other(const int64_t r2, const int32_t u) {
+    const int64_t w = r2 - int64_t(u) * u;
+    if (w <= 0) return 0;
+    int64_t m = int64_t(SQRT(float(w)));
+    while (m * m > w) --m;
+    while ((m + 1) * (m + 1) <= w) ++m;
+    return int32_t(w - m * m > (m + 1) * (m + 1) - w ? m + 1 : m);
+  }
+
+  /**
+   * The axis stepping at each event from the point p: X where the arc is
+   * nearer the Y axis, Y where it's nearer the X axis, none near a diagonal.
+   */
+  static AxisEnum arc_major(const xy_long_t &p) {
+    const int32_t d = ABS(p.y) - ABS(p.x);
+    return d >= ARC_DIAGONAL_MARGIN ? X_AXIS : d <= -(ARC_DIAGONAL_MARGIN) ? Y_AXIS : NO_AXIS;
+  }
+
+  /**
+   * Planner::buffer_arc
+   */
+  bool Planner::buffer_arc(const xyze_pos_t &start, const xyze_pos_t &target, const xy_pos_t &center, const float &travel, const feedrate_t &fr_mm_s, const uint8_t extruder) {
+
+    // The circle of the Stepper has the same steps in X and Y, without the simulation paths of buffer_segment()
+    const float spmm = mechanics.data.axis_steps_per_mm.x;
+    if (printer.mode != PRINTER_MODE_CNC || spmm != mechanics.data.axis_steps_per_mm.y
+      || printer.debugSimulation() || printer.debugDryrun() || !travel
+    ) return false;
+
+    #if ENABLED(LASER)
+      if (laser.mode != CONTINUOUS) return false;
+    #endif
+
+    // If we are cleaning, do not accept queuing of movements
+    if (cleaning_buffer_flag) return false;
+
+    #if ENABLED(SEGMENT_MERGE)
+      // The move held back goes first
+      merge_flush();
+    #endif
+
+    // The ends in steps from the center, the circle is the one of the start
+    const xy_long_t c = { int32_t(FLOOR(center.x * spmm + 0.5f)), int32_t(FLOOR(center.y * spmm + 0.5f)) },
+                    s = { position.x - c.x, position.y - c.y },
+                    t = { int32_t(FLOOR(target.x * spmm + 0.5f)) - c.x, int32_t(FLOOR(target.y * spmm + 0.5f)) - c.y };
+    const int64_t r2 = sq(int64_t(s.x)) + sq(int64_t(s.y));
+    if (r2 < sq(int64_t(ARC_MIN_RADIUS)) || arc_major(s) == NO_AXIS) return false;
+
+    const int8_t dir = travel > 0 ? 1 : -1;
+
+    // The points on the axes and the two sides of the diagonals
+    const int32_t m0 = arc_other(r2, 0);
+    int32_t ud = int32_t(SQRT(float(r2) * 0.5f));
+    while (ud > 0 && arc_other(r2, ud) - ud < ARC_DIAGONAL_MARGIN) --ud;
+    while (arc_other(r2, ud + 1) - (ud + 1) >= ARC_DIAGONAL_MARGIN) ++ud;
+    const int32_t vd = arc_other(r2, ud);
+
+    // The ends of the pieces, with the part of the travel for Z and E
+    xy_long_t point[ARC_MAX_POINTS];
+    float     part[ARC_MAX_POINTS];
+    bool      is_arc[ARC_MAX_POINTS];
+    uint8_t   n = 0;
+    auto add_point = [&](const int32_t x, const int32_t y, const float p, const bool a) {
+      if (n >= ARC_MAX_POINTS) return false;
+      point[n].set(x, y); part[n] = p; is_arc[n] = a;
+      n++;
+      return true;
+    };
+
+    // The octants crossed, in units of 45 degrees
+    const float a0 = ATAN2(float(s.y), float(s.x)) * (1.0f / RADIANS(45)),
+                a1 = a0 + travel * (1.0f / RADIANS(45));
+    for (int16_t k = dir > 0 ? int16_t(FLOOR(a0)) + 1 : int16_t(CEIL(a0)) - 1; dir > 0 ? k < a1 : k > a1; k += dir) {
+      const uint8_t o = k & 7;
+      const float p = (k - a0) / (a1 - a0);
+      if (!TEST(o, 0)) {
+        constexpr int8_t ox[4] = { 1, 0, -1, 0 }, oy[4] = { 0, 1, 0, -1 };
+        if (!add_point(ox[o >> 1] * m0, oy[o >> 1] * m0, p, true)) return false;
+      }
+      else {
+        const int8_t qx = (o == 1 || o == 7) ? 1 : -1,
+                     qy = (o == 1 || o == 3) ? 1 : -1;
+        // The arc ends on the side of its major axis, a line goes over the diagonal
+        if (((o == 1 || o == 5) != (dir < 0))) {
+          if (!add_point(qx * vd, qy * ud, p, true) || !add_point(qx * ud, qy * vd, p, false)) return false;
+        }
+        else if (!add_point(qx * ud, qy * vd, p, true) || !add_point(qx * vd, qy * ud, p, false)) return false;
+      }
+    }
+
+    // The last arc ends at the major coordinate of the target, a line goes to it if it's off the circle
+    const xy_long_t &last = n ? point[n - 1] : s;
+    const AxisEnum major = arc_major(last);
+    xy_long_t e;
+    int8_t forward;
+    if (major == X_AXIS) {
+      e.set(t.x, (last.y < 0 ? -1 : 1) * arc_other(r2, t.x));
+      forward = last.y < 0 ? dir : -dir;
+    }
+    else {
+      e.set((last.x < 0 ? -1 : 1) * arc_other(r2, t.y), t.y);
+      forward = last.x < 0 ? -dir : dir;
+    }
+    if (major == NO_AXIS || arc_major(e) != major || sq(int64_t(t[major])) >= r2
+      || (e[major] - last[major]) * forward < 0
+    ) return false;
+    if (e != last && !add_point(e.x, e.y, 1.0f, true)) return false;
+    if (t != e && !add_point(t.x, t.y, 1.0f, false)) return false;
+
+    // The targets of the pieces in steps, Z and E in line with the angle
+    const float espmm = extruders[extruder]->data.axis_steps_per_mm;
+    xyze_long_t step[ARC_MAX_POINTS];
+    xyze_pos_t  pos[ARC_MAX_POINTS];
+    for (uint8_t i = 0; i < n; i++) {
+      pos[i].set(center.x + point[i].x * mechanics.steps_to_mm.x, center.y + point[i].y * mechanics.steps_to_mm.y,
+                 start.z + part[i] * (target.z - start.z), start.e + part[i] * (target.e - start.e));
+      if (part[i] == 1.0f) { pos[i].z = target.z; pos[i].e = target.e; }
+
+      // Only the ends of the octants can be the extremes of X and Y
+      xyz_pos_t limited = pos[i];
+      endstops.apply_motion_limits(limited);
+      if (limited != xyz_pos_t(pos[i])) return false;
+
+      step[i].set(c.x + point[i].x, c.y + point[i].y,
+                  int32_t(FLOOR(pos[i].z * mechanics.data.axis_steps_per_mm.z + 0.5f)),
+                  int32_t(FLOOR(pos[i].e * espmm + 0.5f)));
+
+      // On an arc Z and E have one Bresenham step at most for each event
+      if (is_arc[i]) {
+        const xyze_long_t &from = i ? step[i - 1] : position;
+        const AxisEnum m = arc_major(i ? point[i - 1] : s);
+        const int32_t events = ABS(step[i][m] - from[m]);
+        if (ABS(step[i].z - from.z) > events || ABS(step[i].e - from.e) > events) return false;
+      }
+    }
+
+    // Queue the pieces
+    const float radius = SQRT(float(r2));
+    planner_arc_t arc;
+    arc.r2 = r2;
+    arc.radius = radius;
+    arc.dir = dir;
+    for (uint8_t i = 0; i < n; i++) {
+      const xy_long_t &from = i ? point[i - 1] : s;
+      if (step[i] == (i ? step[i - 1] : xyze_long_t(position))) continue;
+      float millimeters = 0.0f;
+      if (is_arc[i]) {
+        arc.start = from;
+        arc.end = point[i];
+        arc.major = arc_major(from);
+        arc.travel = ATAN2(ABS(float(from.x) * point[i].y - float(from.y) * point[i].x), float(from.x) * point[i].x + float(from.y) * point[i].y);
+        millimeters = HYPOT(arc.travel * radius * mechanics.steps_to_mm.x, pos[i].z - (i ? pos[i - 1].z : start.z));
+        arc_fill = &arc;
+      }
+      const bool queued = buffer_steps(step[i]
+        #if HAS_POSITION_FLOAT
+          , pos[i]
+        #endif
+        , fr_mm_s, extruder, millimeters
+      );
+      arc_fill = nullptr;
+      if (!queued) break;
+    }
+
+    stepper.wake_up();
+    return true;
+  }
+
+  /**
+   * Planner::fill_arc
+   *
+   * The circle tracer of the Stepper for the octant arc_fill
+   */
+  void Planner::fill_arc(block_t * const block) {
+    const planner_arc_t &arc = *arc_fill;
+    const AxisEnum other = arc.major == X_AXIS ? Y_AXIS : X_AXIS;
+    const int32_t u0 = arc.start[arc.major], u1 = arc.end[arc.major],
+                  v0 = arc.start[other], v1 = arc.end[other];
+    block->arc_f = int32_t(sq(int64_t(arc.start.x)) + sq(int64_t(arc.start.y)) - arc.r2);
+    block->arc_a = (u1 > u0 ? 2 : -2) * u0 + 1;
+    block->arc_b = (v1 < v0 ? -2 : 2) * v0 + 1;
+    block->arc_scale = LROUND(512.0f * block->step_event_count / arc.travel);
+    SBI(block->flag, BLOCK_BIT_ARC);
+    if (arc.major == Y_AXIS) SBI(block->flag, BLOCK_BIT_ARC_Y);
+  }
+
+#endif // CNCROUTER_NATIVE_ARC
+
+#if ENABLED(SEGMENT_MERGE)
+
+  /**
+   * Planner::merge_line
+   *
+   * Dense meshes give runs of tiny moves on nearly the same line. While the
+   * buffer has enough moves, a short move is held back and the next ones are
+   * added to it if they have the same feedrate and E per mm of the first and
+   * their end is within SEGMENT_MERGE_TOLERANCE from the line of the first.
+   * The merged points are so within twice the tolerance from the merged move.
+   *
+   *  target      - target position in mm, modifiers applied
+   *  fr_mm_s     - (target) speed of the move (mm/s)
+   *  extruder    - target extruder
+   *  millimeters - the length of the movement, if known
+   */
+  bool Planner::merge_line(const xyze_pos_t &target, const feedrate_t &fr_mm_s, const uint8_t extruder, const float &millimeters) {
+
+    if (merge.valid && !cleaning_buffer_flag) {
+
+      const xyz_float_t dist = { target.x - merge.end.x, target.y - merge.end.y, target.z - merge.end.z };
+      const float mm = SQRT(sq(dist.x) + sq(dist.y) + sq(dist.z));
+
+      if (mm > 0.0f && mm < SEGMENT_MERGE_SHORT_MM) {
+
+        const float e_per_mm = (target.e - merge.end.e) / mm;
+
+        if (merge.pending) {
+          if (extruder == merge.extruder && fr_mm_s == merge.fr_mm_s
+            && ABS(e_per_mm - merge.e_per_mm) <= (SEGMENT_MERGE_E_RATIO) * ABS(merge.e_per_mm)
+          ) {
+            const xyz_float_t run = { target.x - merge.start.x, target.y - merge.start.y, target.z - merge.start.z };
+            const float along = run.x * merge.dir.x + run.y * merge.dir.y + run.z * merge.dir.z;
+            if (along >= merge.along && along <= SEGMENT_MERGE_MAX_MM
+              && sq(run.x) + sq(run.y) + sq(run.z) - sq(along) <= sq(SEGMENT_MERGE_TOLERANCE)
+            ) {
+              merge.end = target;
+              merge.along = along;
+              return true;
+            }
+          }
+          merge_flush();
+        }
+
+        // A new run, if the buffer can wait for the next move
+        if (moves_planned() >= SEGMENT_MERGE_MIN_MOVES) {
+          const float inv_mm = 1.0f / mm;
+          merge.start     = merge.end;
+          merge.end       = target;
+          merge.dir.set(dist.x * inv_mm, dist.y * inv_mm, dist.z * inv_mm);
+          merge.along     = mm;
+          merge.e_per_mm  = e_per_mm;
+          merge.fr_mm_s   = fr_mm_s;
+          merge.extruder  = extruder;
+          merge.pending   = merge.valid = true;
+          return true;
+        }
+
+      }
+
+    }
+
+    if (!buffer_segment(target, fr_mm_s, extruder, millimeters)) return false;
+
+    merge.end = target;
+    merge.valid = true;
+    return true;
+  }
+
+  void Planner::merge_flush() {
+    if (merge.pending) {
+      merge.pending = false;
+      buffer_segment(merge.end, merge.fr_mm_s, merge.extruder);
+    }
+    merge.valid = false;
+  }
+
+#endif
+
+#if IS_KINEMATIC
+
+  /**
+   * Add a new linear movement to the buffer, with the kinematics already applied.
+   *
+   *  cart        - target position in mm, before modifiers and kinematics
+   *  machine     - the same target in machine units, modifiers and kinematics applied
+   *  fr_mm_s     - (target) speed of the move (mm/s)
+   *  extruder    - target extruder
+   *  millimeters - the length of the movement, if known
+   */
+  bool Planner::buffer_line_kinematic(const xyze_pos_t &cart, const abce_pos_t &machine, const feedrate_t &fr_mm_s, const uint8_t extruder, const float millimeters/*=0.0*/) {
+
     #if ENABLED(JUNCTION_DEVIATION)
-      const xyze_pos_t delta_mm_cart = {
-        rx - position_cart.x, ry - position_cart.y,
-        rz - position_cart.z, e  - position_cart.e
-      };
+      const xyze_pos_t delta_mm_cart = cart - position_cart;
     #else
-      const xyz_pos_t delta_mm_cart = { rx - position_cart.x, ry - position_cart.y, rz - position_cart.z };
+      const xyz_pos_t delta_mm_cart = { cart.x - position_cart.x, cart.y - position_cart.y, cart.z - position_cart.z };
     #endif
 
     float mm = millimeters;
     if (mm == 0.0)
       mm = (delta_mm_cart.x != 0.0 || delta_mm_cart.y != 0.0) ? SQRT(sq(delta_mm_cart.x) + sq(delta_mm_cart.y) + sq(delta_mm_cart.z)) : ABS(delta_mm_cart.z);
 
-    mechanics.Transform(raw);
-
     #if ENABLED(SCARA_FEEDRATE_SCALING)
       // For SCARA scale the feed rate from mm/s to degrees/s
       // i.e., Complete the angular vector in the given time.
       const float duration_recip = inv_duration ? inv_duration : fr_mm_s / mm,
-                  feedrate = HYPOT(delta.a - position_float.a, delta.b - position_float.b) * duration_recip;
+                  feedrate = HYPOT(machine.a - position_float.a, machine.b - position_float.b) * duration_recip;
     #else
       const float feedrate = fr_mm_s;
     #endif
 
-    if (buffer_segment(mechanics.delta.a, mechanics.delta.b, mechanics.delta.c, raw.e
+    if (buffer_segment(machine
       #if ENABLED(JUNCTION_DEVIATION)
         , delta_mm_cart
       #endif
       , feedrate, extruder, mm
     )) {
-      position_cart.set(rx, ry, rz, e);
+      position_cart = cart;
       return true;
     }
     else
       return false;
 
-  #else
-
-    return buffer_segment(raw, fr_mm_s, extruder, millimeters);
-
-  #endif
+  }
 
-}
+#endif
 
 /**
  * Directly set the planner ABC position (and stepper positions)
@@ -1990,6 +2909,10 @@ bool Planner::buffer_line(const float &rx, const float &ry, const float &rz, con
  */
 void Planner::set_machine_position_mm(const float &a, const float &b, const float &c, const float &e) {
 
+  #if ENABLED(SEGMENT_MERGE)
+    merge_flush();
+  #endif
+
   position.set( static_cast<int32_t>(FLOOR(a * mechanics.data.axis_steps_per_mm.a + 0.5f)),
                 static_cast<int32_t>(FLOOR(b * mechanics.data.axis_steps_per_mm.b + 0.5f)),
                 static_cast<int32_t>(FLOOR(c * mechanics.data.axis_steps_per_mm.c + 0.5f)),
@@ -2014,11 +2937,7 @@ void Planner::set_position_mm(const float &rx, const float &ry, const float &rz,
   xyze_pos_t raw = { rx, ry, rz, e };
 
   #if HAS_POSITION_MODIFIERS
-    apply_modifiers(raw
-      #if HAS_LEVELING
-        , true
-      #endif
-    );
+    apply_modifiers<true>(raw);
   #endif
 
   #if IS_KINEMATIC
@@ -2032,6 +2951,10 @@ void Planner::set_position_mm(const float &rx, const float &ry, const float &rz,
 
 void Planner::set_e_position_mm(const float &e) {
 
+  #if ENABLED(SEGMENT_MERGE)
+    merge_flush();
+  #endif
+
   #if ENABLED(FWRETRACT)
     float e_new = e - fwretract.current_retract[toolManager.extruder.active];
   #else
@@ -2110,48 +3033,102 @@ void Planner::refresh_positioning() {
  * is not and will not use the block while we modify it, so it is safe to
  * alter it's values.
  */
-#define MINIMAL_STEP_RATE 120
 
 void Planner::calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor) {
 
-  uint32_t initial_rate = CEIL(entry_factor * block->nominal_rate),
-           final_rate   = CEIL(exit_factor  * block->nominal_rate); // (steps per second)
+  #if ENABLED(PLANNER_FIXED_POINT)
+    // Entry and exit factors as Q16.16, rates rounded up like the float version
+    uint32_t initial_rate = fixed_mul_q16_ceil(block->nominal_rate, float_to_q16(entry_factor)),
+             final_rate   = fixed_mul_q16_ceil(block->nominal_rate, float_to_q16(exit_factor)); // (steps per second)
+  #else
+    uint32_t initial_rate = CEIL(entry_factor * block->nominal_rate),
+             final_rate   = CEIL(exit_factor  * block->nominal_rate); // (steps per second)
+  #endif
 
   // Limit minimal step rate (Otherwise the timer will overflow.)
   NOLESS(initial_rate,  uint32_t(MINIMAL_STEP_RATE));
   NOLESS(final_rate,    uint32_t(MINIMAL_STEP_RATE));
 
+  const int32_t accel = block->acceleration_steps_per_s2;
+
   #if ENABLED(BEZIER_JERK_CONTROL)
-    uint32_t cruise_rate = initial_rate;
+    // If we have some plateau time, the cruise rate will be the nominal rate
+    uint32_t cruise_rate = block->nominal_rate;
+    // Otherwise, we won't reach the cruising rate. Let's calculate the speed we will reach
+    #define NO_CRUISE_RATE() cruise_rate = final_speed(initial_rate, accel, accelerate_steps)
+  #else
+    #define NO_CRUISE_RATE() NOOP
   #endif
 
-  const int32_t accel = block->acceleration_steps_per_s2;
+  uint32_t  accelerate_steps,               // Steps required for acceleration, deceleration to/from nominal rate
+            decelerate_steps;
+  int32_t   plateau_steps;                  // Steps between acceleration and deceleration, if any
+
+  #if ENABLED(PLANNER_FIXED_POINT)
+
+    const uint32_t nominal_rate = block->nominal_rate;
+
+    // Squared rates must fit in 32 bit, faster blocks can't be run by AVR anyway
+    if (nominal_rate <= 0xFFFFUL) {
+
+      const uint32_t  inverse_accel_q32 = block->inverse_accel_steps_q32,
+                      nominal_rate_sqr  = nominal_rate * nominal_rate,
+                      initial_rate_sqr  = initial_rate * initial_rate,
+                      final_rate_sqr    = final_rate * final_rate;
+
+      accelerate_steps = nominal_rate > initial_rate ? fixed_mul_q32_ceil(nominal_rate_sqr - initial_rate_sqr, inverse_accel_q32) : 0;
+      decelerate_steps = nominal_rate > final_rate   ? fixed_mul_q32(nominal_rate_sqr - final_rate_sqr, inverse_accel_q32) : 0;
+      plateau_steps    = block->step_event_count - accelerate_steps - decelerate_steps;
+
+      // No cruising, same as intersection_distance(): (d + (final^2 - initial^2) / (2 * accel)) / 2
+      if (plateau_steps < 0) {
+        const int32_t accelerate_steps_x2 = int32_t(block->step_event_count) + (final_rate > initial_rate
+          ?  int32_t(fixed_mul_q32(final_rate_sqr - initial_rate_sqr, inverse_accel_q32))
+          : -int32_t(fixed_mul_q32(initial_rate_sqr - final_rate_sqr, inverse_accel_q32))
+        );
+        accelerate_steps = MIN(uint32_t(accelerate_steps_x2 > 0 ? (accelerate_steps_x2 + 1) >> 1 : 0), block->step_event_count);
+        plateau_steps = 0;
+        NO_CRUISE_RATE();
+      }
+
+    }
+    else {
+      accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, nominal_rate, accel));
+      decelerate_steps = FLOOR(estimate_acceleration_distance(nominal_rate, final_rate, -accel));
+      plateau_steps    = block->step_event_count - accelerate_steps - decelerate_steps;
+      if (plateau_steps < 0) {
+        const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
+        accelerate_steps = MIN(uint32_t(MAX(accelerate_steps_float, 0)), block->step_event_count);
+        plateau_steps = 0;
+        NO_CRUISE_RATE();
+      }
+    }
+
+  #else
+
+    const float inverse_accel_x2 = block->inverse_accel_steps_x2,
+                nominal_rate_sqr = sq(float(block->nominal_rate));
+
+    accelerate_steps = CEIL((nominal_rate_sqr - sq(float(initial_rate))) * inverse_accel_x2);
+    decelerate_steps = FLOOR((nominal_rate_sqr - sq(float(final_rate))) * inverse_accel_x2);
+    plateau_steps    = block->step_event_count - accelerate_steps - decelerate_steps;
+
+    // Does accelerate_steps + decelerate_steps exceed step_event_count?
+    // Then we can't possibly reach the nominal rate, there will be no cruising.
+    // Use intersection_distance() to calculate accel / braking time in order to
+    // reach the final_rate exactly at the end of this block.
+    if (plateau_steps < 0) {
+      // Same as intersection_distance(), using the cached inverse acceleration
+      const float accelerate_steps_float = CEIL((accel * 2.0f * block->step_event_count - sq(float(initial_rate)) + sq(float(final_rate))) * 0.5f * inverse_accel_x2);
+      accelerate_steps = MIN(uint32_t(MAX(accelerate_steps_float, 0)), block->step_event_count);
+      plateau_steps = 0;
+      NO_CRUISE_RATE();
+    }
 
-            // Steps required for acceleration, deceleration to/from nominal rate
-  uint32_t  accelerate_steps = CEIL(estimate_acceleration_distance(initial_rate, block->nominal_rate, accel)),
-            decelerate_steps = FLOOR(estimate_acceleration_distance(block->nominal_rate, final_rate, -accel));
-            // Steps between acceleration and deceleration, if any
-  int32_t   plateau_steps = block->step_event_count - accelerate_steps - decelerate_steps;
-
-  // Does accelerate_steps + decelerate_steps exceed step_event_count?
-  // Then we can't possibly reach the nominal rate, there will be no cruising.
-  // Use intersection_distance() to calculate accel / braking time in order to
-  // reach the final_rate exactly at the end of this block.
-  if (plateau_steps < 0) {
-    const float accelerate_steps_float = CEIL(intersection_distance(initial_rate, final_rate, accel, block->step_event_count));
-    accelerate_steps = MIN(uint32_t(MAX(accelerate_steps_float, 0)), block->step_event_count);
-    plateau_steps = 0;
-
-    #if ENABLED(BEZIER_JERK_CONTROL)
-      // We won't reach the cruising rate. Let's calculate the speed we will reach
-      cruise_rate = final_speed(initial_rate, accel, accelerate_steps);
-    #endif
-  }
-  #if ENABLED(BEZIER_JERK_CONTROL)
-    else // We have some plateau time, so the cruise rate will be the nominal rate
-      cruise_rate = block->nominal_rate;
   #endif
 
+  #undef NO_CRUISE_RATE
+
   #if ENABLED(BEZIER_JERK_CONTROL)
     // Jerk controlled speed requires to express speed versus time, NOT steps
     uint32_t  acceleration_time = ((float)(cruise_rate - initial_rate) / accel) * (STEPPER_TIMER_RATE),
@@ -2169,8 +3146,14 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
   #if ENABLED(BEZIER_JERK_CONTROL)
     block->acceleration_time = acceleration_time;
     block->deceleration_time = deceleration_time;
-    block->acceleration_time_inverse = acceleration_time_inverse;
-    block->deceleration_time_inverse = deceleration_time_inverse;
+    #if ENABLED(__AVR__)
+      block->acceleration_time_inverse = acceleration_time_inverse;
+      block->deceleration_time_inverse = deceleration_time_inverse;
+    #else
+      // The Stepper ISR only evaluates the curves
+      block->bezier_accel.set(initial_rate, cruise_rate, acceleration_time_inverse);
+      block->bezier_decel.set(cruise_rate, final_rate, deceleration_time_inverse);
+    #endif
     block->cruise_rate = cruise_rate;
   #endif
   block->final_rate = final_rate;
@@ -2263,7 +3246,7 @@ void Planner::reverse_pass_kernel(block_t* const current_block, const block_t* c
 
       const float new_entry_speed_sqr = TEST(current_block->flag, BLOCK_BIT_NOMINAL_LENGTH)
         ? max_entry_speed_sqr
-        : MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-current_block->acceleration, next_block ? next_block->entry_speed_sqr : sq(MINIMUM_PLANNER_SPEED), current_block->millimeters));
+        : MIN(max_entry_speed_sqr, max_allowable_speed_sqr(current_block, next_block ? next_block->entry_speed_sqr : sq(MINIMUM_PLANNER_SPEED)));
       if (current_block->entry_speed_sqr != new_entry_speed_sqr) {
 
         // Need to recalculate the block speed - Mark it now, so the stepper
@@ -2301,7 +3284,7 @@ void Planner::forward_pass_kernel(const block_t* const previous_block, block_t*
       previous_block->entry_speed_sqr < current_block->entry_speed_sqr) {
 
       // Compute the maximum allowable speed
-      const float new_entry_speed_sqr = max_allowable_speed_sqr(-previous_block->acceleration, previous_block->entry_speed_sqr, previous_block->millimeters);
+      const float new_entry_speed_sqr = max_allowable_speed_sqr(previous_block, previous_block->entry_speed_sqr);
 
       // If true, current block is full-acceleration and we can move the planned pointer forward.
       if (new_entry_speed_sqr < current_block->entry_speed_sqr) {
@@ -2433,14 +3416,25 @@ void Planner::forward_pass() {
 }
 
 /**
- * Recalculate the trapezoid speed profiles for all blocks in the plan
+ * Recalculate the trapezoid speed profiles for the blocks in the plan
  * according to the entry_factor for each junction. Must be called by
  * recalculate() after updating the blocks.
+ *
+ * The blocks before 'planned_index' (the optimally planned block when
+ * recalculate() was entered) can't have their entry or exit speeds changed
+ * by the reverse and forward passes, so their trapezoids are already final
+ * and the scan starts from there instead of from the tail. This keeps the
+ * cost of a new block independent from BLOCK_BUFFER_SIZE.
  */
-void Planner::recalculate_trapezoids() {
+void Planner::recalculate_trapezoids(const uint8_t planned_index) {
+
+  const uint8_t tail_index  = block_buffer_tail;
+  uint8_t head_block_index  = block_buffer_head,
+          block_index       = tail_index;
 
-  uint8_t block_index       = block_buffer_tail,
-          head_block_index  = block_buffer_head;
+  // Start from the planned block, unless the Stepper ISR already went past it
+  if (BLOCK_MOD(planned_index - tail_index) < BLOCK_MOD(head_block_index - tail_index))
+    block_index = planned_index;
 
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
@@ -2460,7 +3454,7 @@ void Planner::recalculate_trapezoids() {
     head_block_index = prev_index;
   };
 
-  // Go from the tail (currently executed block) to the first block, without including it)
+  // Go from the start block (the planned or currently executed block) to the first block, without including it)
   block_t *current_block  = nullptr,
           *next_block     = nullptr;
   float   current_entry_speed = 0.0,
@@ -2472,7 +3466,7 @@ void Planner::recalculate_trapezoids() {
 
     // Skip sync blocks
     if (!TEST(next_block->flag, BLOCK_BIT_SYNC_POSITION)) {
-      next_entry_speed = SQRT(next_block->entry_speed_sqr);
+      next_entry_speed = FAST_SQRT(next_block->entry_speed_sqr);
 
       if (current_block) {
         // Recalculate if current block entry or exit junction speed has changed.
@@ -2490,14 +3484,13 @@ void Planner::recalculate_trapezoids() {
             // Block is not BUSY, we won the race against the Stepper ISR:
 
             // NOTE: Entry and exit factors always > 0 by all previous logic operations.
-            const float current_nominal_speed = SQRT(current_block->nominal_speed_sqr),
-                        nomr = 1.0f / current_nominal_speed;
+            const float nomr = current_block->inverse_nominal_speed;
             calculate_trapezoid_for_block(current_block, current_entry_speed * nomr, next_entry_speed * nomr);
             #if ENABLED(LIN_ADVANCE)
               if (current_block->use_advance_lead) {
-                const float comp = current_block->e_D_ratio * extruders[toolManager.extruder.active]->data.advance_K * extruders[toolManager.extruder.active]->data.axis_steps_per_mm;
-                current_block->max_adv_steps = current_nominal_speed * comp;
-                current_block->final_adv_steps = next_entry_speed * comp;
+                const float current_nominal_speed = current_block->nominal_speed;
+                current_block->max_adv_steps = current_nominal_speed * current_block->adv_comp;
+                current_block->final_adv_steps = next_entry_speed * current_block->adv_comp;
               }
             #endif
           }
@@ -2529,14 +3522,13 @@ void Planner::recalculate_trapezoids() {
     if (!stepper.is_block_busy(current_block)) {
       // Block is not BUSY, we won the race against the Stepper ISR:
 
-      const float next_nominal_speed = SQRT(next_block->nominal_speed_sqr),
-                  nomr = 1.0f / next_nominal_speed;
+      const float nomr = next_block->inverse_nominal_speed;
       calculate_trapezoid_for_block(next_block, next_entry_speed * nomr, (MINIMUM_PLANNER_SPEED) * nomr);
       #if ENABLED(LIN_ADVANCE)
         if (next_block->use_advance_lead) {
-          const float comp = next_block->e_D_ratio * extruders[toolManager.extruder.active]->data.advance_K * extruders[toolManager.extruder.active]->data.axis_steps_per_mm;
-          next_block->max_adv_steps = next_nominal_speed * comp;
-          next_block->final_adv_steps = (MINIMUM_PLANNER_SPEED) * comp;
+          const float next_nominal_speed = next_block->nominal_speed;
+          next_block->max_adv_steps = next_nominal_speed * next_block->adv_comp;
+          next_block->final_adv_steps = (MINIMUM_PLANNER_SPEED) * next_block->adv_comp;
         }
       #endif
     }
@@ -2552,11 +3544,14 @@ void Planner::recalculate() {
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
 
+  // Stable frontier: the trapezoids before this block can't be changed by this replan
+  const uint8_t planned_index = block_buffer_planned;
+
   // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
+  if (block_index != planned_index) {
     reverse_pass();
     forward_pass();
   }
 
-  recalculate_trapezoids();
+  recalculate_trapezoids(planned_index);
 }
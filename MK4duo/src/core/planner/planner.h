@@ -30,6 +30,29 @@
  * Copyright (c) 2009-2011 Simen Svale Skogsrud
  */
 
+#if ENABLED(BEZIER_JERK_CONTROL) && DISABLED(__AVR__)
+
+  /**
+   * Coefficients of the Bezier speed curve of an acceleration or deceleration phase.
+   * On 32 bit the planner computes them with the trapezoid, the Stepper ISR only
+   * evaluates the curve. AVR computes its reduced precision ones in the ISR.
+   */
+  struct bezier_coeff_t {
+    int32_t   A, B, C;                      // Q24.7, see the comments of Stepper::_eval_bezier_curve()
+    uint32_t  F,                            // Initial rate scaled by 128
+              AV;                           // 2^32 / duration of the phase in timer ticks
+
+    FORCE_INLINE void set(const int32_t v0, const int32_t v1, const uint32_t av) {
+      A =  768 * (v1 - v0);
+      B = 1920 * (v0 - v1);
+      C = 1280 * (v1 - v0);
+      F =  128 * v0;
+      AV = av;
+    }
+  };
+
+#endif
+
 /**
  * struct block_t
  *
@@ -41,14 +64,40 @@
  */
 typedef struct block_t {
 
+  /**
+   * The fields are ordered from the hot to the cold ones: first the
+   * flags and the bytes, packed together, then all the data read by
+   * the Stepper ISR, then the values used only by the planner and last
+   * the optional payloads. On 32 bit the grouped bytes save the padding.
+   */
+
   volatile uint8_t flag;                    // Block flags (See BlockFlagEnum enum above) - Modified by ISR and main thread!
 
-  // Fields used by the motion planner to manage acceleration
-  float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
-        entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
-        max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
-        millimeters,                        // The total travel of this block in mm
-        acceleration;                       // acceleration mm/sec^2
+  uint8_t direction_bits,                   // The direction bit set for this block
+          active_extruder;                  // The extruder to move (if E move)
+
+  #if ENABLED(LIN_ADVANCE)
+    bool use_advance_lead;
+  #endif
+
+  #if ENABLED(LASER)
+    uint8_t laser_mode;                     // CONTINUOUS, PULSED, RASTER
+    bool    laser_status;                   // LASER_OFF, LASER_ON
+  #endif
+
+  #if ENABLED(BARICUDA)
+    uint8_t valve_pressure, e_to_p_pressure;
+  #endif
+
+  #if ENABLED(SYNCHRONOUS_FAN_SPEED)
+    uint8_t sync_fan,                       // Fan index + 1 to set when this sync block is executed, 0 for none
+            sync_fan_speed;                 // New speed of the fan
+  #endif
+
+  #if ENABLED(DLP_LAYER_CYCLE)
+    uint16_t sync_dwell;                    // Milliseconds the stepper holds this sync block
+    uint8_t  sync_expose;                   // DLPExposeEnum, the exposure started or ended by this sync block
+  #endif
 
   // Data used by all move blocks
   union {
@@ -60,10 +109,11 @@ typedef struct block_t {
 
   uint32_t step_event_count;                // The number of step events required to complete this block
 
-  uint8_t active_extruder;                  // The extruder to move (if E move)
-
-  #if ENABLED(COLOR_MIXING_EXTRUDER)
-    mixer_color_t b_color[MIXING_STEPPERS]; // Normalized color for the mixing steppers
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
+    int32_t   arc_f,                        // x^2 + y^2 - r^2 of the start, in steps from the center
+              arc_a,                        // The change of arc_f for a step of the major axis, 2 * s * u + 1
+              arc_b;                        // The same for a step of the other axis
+    uint32_t  arc_scale;                    // Q8 scale of the interval over |arc_b - 1|, see Stepper::arc_interval()
   #endif
 
   // Settings for the trapezoid generator
@@ -73,57 +123,177 @@ typedef struct block_t {
   #if ENABLED(BEZIER_JERK_CONTROL)
     uint32_t  cruise_rate,                  // The actual cruise rate to use, between end of the acceleration phase and start of deceleration phase
               acceleration_time,            // Acceleration time and deceleration time in STEP timer counts
-              deceleration_time,
-              acceleration_time_inverse,    // Inverse of acceleration and deceleration periods, expressed as integer. Scale depends on CPU being used
-              deceleration_time_inverse;
+              deceleration_time;
+    #if ENABLED(__AVR__)
+      uint32_t  acceleration_time_inverse,  // Inverse of acceleration and deceleration periods, expressed as integer
+                deceleration_time_inverse;
+    #else
+      bezier_coeff_t  bezier_accel,         // Speed curves of the acceleration and deceleration phases
+                      bezier_decel;
+    #endif
   #else
     uint32_t  acceleration_rate;            // The acceleration rate used for acceleration calculation
   #endif
 
-  uint8_t direction_bits;                   // The direction bit set for this block
+  uint32_t  nominal_rate,                   // The nominal step rate for this block in step_events/sec
+            initial_rate,                   // The jerk-adjusted step rate at start of block
+            final_rate,                     // The minimal rate at exit
+            acceleration_steps_per_s2;      // acceleration steps/sec^2
 
   // Advance extrusion
   #if ENABLED(LIN_ADVANCE)
-    bool      use_advance_lead;
     uint16_t  advance_speed,                // STEP timer value for extruder speed offset ISR
               max_adv_steps,                // max. advance steps to get cruising speed pressure (not always nominal_speed!)
               final_adv_steps;              // advance steps due to exit speed
-    float     e_D_ratio;
-  #endif
-
-  uint32_t  nominal_rate,                   // The nominal step rate for this block in step_events/sec
-            initial_rate,                   // The jerk-adjusted step rate at start of block
-            final_rate,                     // The minimal rate at exit
-            acceleration_steps_per_s2;      // acceleration steps/sec^2
-
-  #if ENABLED(BARICUDA)
-    uint8_t valve_pressure, e_to_p_pressure;
+    float     adv_comp;                     // K * e/D ratio * E steps/mm, with the K of the block when planned
   #endif
 
-  #if HAS_SPI_LCD
-    uint32_t segment_time_us;
+  #if ENABLED(COLOR_MIXING_EXTRUDER)
+    mixer_weight_t b_weight[MIXING_STEPPERS]; // Step weights for the mixing steppers
   #endif
 
   #if ENABLED(LASER)
-    uint8_t   laser_mode;       // CONTINUOUS, PULSED, RASTER
-    bool      laser_status;     // LASER_OFF, LASER_ON
-    float     laser_ppm,        // pulses per millimeter, for pulsed and raster firing modes
-              laser_intensity;  // Laser firing instensity in clock cycles for the PWM timer
-    uint32_t  laser_duration,   // Laser firing duration in microseconds, for pulsed and raster firing modes
-              steps_l;          // Step count between firings of the laser, for pulsed firing mode
+    float     laser_ppm,                    // pulses per millimeter, for pulsed and raster firing modes
+              laser_intensity;              // Laser firing instensity in clock cycles for the PWM timer
+    uint32_t  laser_duration,               // Laser firing duration in microseconds, for pulsed and raster firing modes
+              steps_l;                      // Step count between firings of the laser, for pulsed firing mode
+
+    #if ENABLED(LASER_DYNAMIC_POWER)
+      uint32_t laser_power_factor;          // laser_intensity / nominal_rate, Q16, the power at a step rate is one multiply
+    #endif
 
     #if ENABLED(LASER_RASTER)
-      unsigned char laser_raster_data[LASER_MAX_RASTER_LINE];
+      uint16_t  laser_raster_index,         // First pixel of the block in the laser raster pool
+                laser_raster_len;           // Pixels of the block, 0 for none
     #endif
   #endif
 
+  // Fields used by the motion planner to manage acceleration
+  float nominal_speed_sqr,                  // The nominal speed for this block in (mm/sec)^2
+        entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
+        max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
+        millimeters,                        // The total travel of this block in mm
+        acceleration;                       // acceleration mm/sec^2
+
+  // Derived quantities, computed once by fill_block() and reused by the planner kernels
+  float nominal_speed,                      // The nominal speed for this block in mm/sec
+        inverse_nominal_speed,              // 1 / nominal_speed, used to get the trapezoid entry/exit factors
+        accel_distance_x2;                  // 2 * acceleration * millimeters in (mm/sec)^2
+  #if ENABLED(PLANNER_FIXED_POINT)
+    uint32_t inverse_accel_steps_q32;       // 1 / (2 * acceleration_steps_per_s2) as Q0.32
+  #else
+    float inverse_accel_steps_x2;           // 1 / (2 * acceleration_steps_per_s2)
+  #endif
+
+  #if HAS_BLOCK_BUFFER_RUNTIME
+    uint32_t segment_time_us;
+  #endif
+
   #if HAS_SD_RESTART
     uint32_t sdpos;
   #endif
 
 } block_t;
 
-#define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
+#if ENABLED(BUFFER_ARENA)
+  #define BLOCK_MOD(n) ((n)&Planner::block_buffer_mask)
+#else
+  #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
+#endif
+
+#if ENABLED(PLANNER_TIMING_STATS)
+  /**
+   * struct planner_timing_t
+   *
+   * Time spent by buffer_steps() to fill and plan a block, in microseconds.
+   */
+  typedef struct {
+    uint32_t  last_us,
+              min_us,
+              max_us,
+              total_us,
+              count;
+    void reset() { last_us = max_us = total_us = count = 0; min_us = 0xFFFFFFFFUL; }
+    void update(const uint32_t us) {
+      last_us = us;
+      NOLESS(max_us, us);
+      NOMORE(min_us, us);
+      total_us += us;
+      count++;
+    }
+  } planner_timing_t;
+#endif
+
+#if ENABLED(PLANNER_UNDERRUN_STATS)
+  /**
+   * struct planner_underrun_t
+   *
+   * Block buffer use while printing. The depth and the queued time are
+   * sampled by the Stepper ISR when it takes a block, the layers are
+   * counted as they are queued.
+   */
+  typedef struct {
+    volatile uint32_t underruns,                        // Buffer found empty, no wait asked
+                      samples,
+                      runtime_total_ms;
+    volatile uint16_t runtime_min_ms,                   // Least time queued after the block taken
+                      layer_runtime_min_ms;
+    volatile uint8_t  depth_min,                        // Least blocks queued after the block taken
+                      layer_depth_min;
+    volatile bool     running,                          // The Stepper has a block
+                      draining;                         // synchronize() empties the buffer
+    uint16_t          layer;                            // Layers since the reset
+    float             layer_z;
+    uint8_t           last_depth_min[PLANNER_UNDERRUN_LAYERS];
+    uint16_t          last_runtime_min_ms[PLANNER_UNDERRUN_LAYERS];
+  } planner_underrun_t;
+#endif
+
+#if ENABLED(SEGMENT_MERGE)
+
+  // Moves in the buffer needed to hold back a merged move
+  #define SEGMENT_MERGE_MIN_MOVES 3
+
+  /**
+   * struct planner_merge_t
+   *
+   * A run of short moves along the line of its first move, with the
+   * same feedrate and E per mm, held back and queued as a single move.
+   */
+  typedef struct {
+    bool        pending,                                // A merged move waits for the next one
+                valid;                                  // end is the target of the last move
+    uint8_t     extruder;
+    feedrate_t  fr_mm_s;
+    xyze_pos_t  start,                                  // The start of the run
+                end;                                    // The end of the last move, queued or pending
+    xyz_float_t dir;                                    // Unit vector of the first move
+    float       along,                                  // Distance of end from start along dir
+                e_per_mm;                               // E of the first move per mm
+  } planner_merge_t;
+#endif
+
+#if ENABLED(CNCROUTER_NATIVE_ARC)
+
+  // Most points of an arc: two for each diagonal, one for each axis, the end and the target
+  #define ARC_MAX_POINTS 24
+
+  /**
+   * struct planner_arc_t
+   *
+   * An octant of an arc for fill_block(), in steps from the center.
+   * The major axis steps at each event, the other one when it brings
+   * the point nearer the integer circle of radius^2 = r2.
+   */
+  typedef struct {
+    xy_long_t start, end;
+    int64_t   r2;
+    float     radius,                                   // (steps)
+              travel;                                   // Angle of the block (radians), positive
+    int8_t    dir;                                      // 1 counterclockwise, -1 clockwise
+    AxisEnum  major;
+  } planner_arc_t;
+#endif
 
 class Planner {
 
@@ -146,7 +316,12 @@ class Planner {
      *  Writer of head is Planner::buffer_segment().
      *  Reader of tail is Stepper::isr(). Always consider tail busy / read-only
      */
-    static block_t          block_buffer[BLOCK_BUFFER_SIZE];
+    #if ENABLED(BUFFER_ARENA)
+      static block_t        *block_buffer;            // The blocks in the buffer arena, set at boot
+      static uint8_t        block_buffer_mask;        // Blocks - 1
+    #else
+      static block_t        block_buffer[BLOCK_BUFFER_SIZE];
+    #endif
     static volatile uint8_t block_buffer_head,        // Index of the next block to be pushed
                             block_buffer_nonbusy,     // Index of the first non busy block
                             block_buffer_planned,     // Index of the optimally planned block
@@ -167,8 +342,32 @@ class Planner {
       static bool abort_on_endstop_hit;
     #endif
 
+    #if ENABLED(PLANNER_TIMING_STATS)
+      static planner_timing_t timing;
+    #endif
+
+    #if ENABLED(PLANNER_UNDERRUN_STATS)
+      static planner_underrun_t underrun;
+    #endif
+
+    #if HAS_TIME_WARP
+      static bool time_warp;                          // Blocks are timed and dropped, not stepped
+    #endif
+
+    #if ENABLED(MOTION_BENCHMARK)
+      static uint32_t block_count;                    // Blocks queued, for the motion benchmark
+    #endif
+
   private: /** Private Parameters */
 
+    #if ENABLED(SEGMENT_MERGE)
+      static planner_merge_t merge;
+    #endif
+
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      static const planner_arc_t *arc_fill;           // The octant of the block in fill_block(), nullptr for a line
+    #endif
+
     /**
      * The current position of the tool in absolute steps
      * Recalculated if any data.axis_steps_per_mm are changed by gcode
@@ -206,10 +405,14 @@ class Planner {
       static xy_ulong_t axis_segment_time_us[3];
     #endif
 
-    #if HAS_SPI_LCD
+    #if HAS_BLOCK_BUFFER_RUNTIME
       volatile static uint32_t block_buffer_runtime_us; // Theoretical block buffer runtime in µs
     #endif
 
+    #if HAS_TIME_WARP
+      static uint32_t warp_s, warp_us;                // Time of the dropped blocks
+    #endif
+
   public: /** Public Function */
 
     static void init();
@@ -235,27 +438,28 @@ class Planner {
 
     #if HAS_POSITION_MODIFIERS
 
-      static void apply_modifiers(xyze_float_t &pos
-        #if HAS_LEVELING
-          , bool leveling =
-          #if PLANNER_LEVELING
-            true
-          #else
-            false
-          #endif
+      /**
+       * Leveling, retract and babystep offsets of a position.
+       * The leveling switch is a template parameter: every call site
+       * gets its own copy with the unused steps compiled out.
+       */
+      template<bool leveling=
+        #if PLANNER_LEVELING
+          true
+        #else
+          false
         #endif
-      );
-
-      static void unapply_modifiers(xyze_float_t &pos
-        #if HAS_LEVELING
-          , bool leveling =
-          #if PLANNER_LEVELING
-            true
-          #else
-            false
-          #endif
+      >
+      static void apply_modifiers(xyze_float_t &pos);
+
+      template<bool leveling=
+        #if PLANNER_LEVELING
+          true
+        #else
+          false
         #endif
-      );
+      >
+      static void unapply_modifiers(xyze_float_t &pos);
 
     #endif // HAS_POSITION_MODIFIERS
 
@@ -282,7 +486,16 @@ class Planner {
     /**
      * Get count of movement slots free
      */
-    FORCE_INLINE static uint8_t moves_free() { return BLOCK_BUFFER_SIZE - 1 - moves_planned(); }
+    FORCE_INLINE static uint8_t moves_free() { return block_buffer_size() - 1 - moves_planned(); }
+
+    /**
+     * Get the blocks of the ring buffer
+     */
+    #if ENABLED(BUFFER_ARENA)
+      FORCE_INLINE static uint8_t block_buffer_size() { return block_buffer_mask + 1; }
+    #else
+      static constexpr uint8_t block_buffer_size() { return BLOCK_BUFFER_SIZE; }
+    #endif
 
     /**
      * Planner::get_next_free_block
@@ -293,7 +506,12 @@ class Planner {
      */
     FORCE_INLINE static block_t* get_next_free_block(uint8_t &next_buffer_head, const uint8_t count=1) {
       // Wait until there are enough slots free
-      while (moves_free() < count) { printer.idle(); }
+      while (moves_free() < count) {
+        #if HAS_TIME_WARP
+          if (time_warp) { time_warp_block(); continue; }
+        #endif
+        printer.idle();
+      }
 
       // Return the first available block
       next_buffer_head = next_block_index(block_buffer_head);
@@ -352,6 +570,30 @@ class Planner {
      */
     static void buffer_sync_block();
 
+    #if ENABLED(SYNCHRONOUS_FAN_SPEED)
+      /**
+       * Planner::buffer_sync_fan
+       * Add a sync block that sets the speed of a fan
+       * when the moves queued before it are done
+       */
+      static void buffer_sync_fan(const uint8_t f, const uint8_t speed);
+    #endif
+
+    #if ENABLED(DLP_LAYER_CYCLE)
+      /**
+       * Planner::buffer_sync_dwell
+       * Add the sync blocks that hold the stepper for ms,
+       * a wait in order with the moves, without a synchronize
+       */
+      static void buffer_sync_dwell(millis_l ms);
+
+      /**
+       * Planner::buffer_sync_expose
+       * Add a sync block that starts or ends the exposure of a DLP layer
+       */
+      static void buffer_sync_expose(const bool on);
+    #endif
+
     /**
      * Planner::buffer_segment
      *
@@ -398,6 +640,38 @@ class Planner {
      */
     static bool buffer_line(const float &rx, const float &ry, const float &rz, const float &e, const feedrate_t &fr_mm_s, const uint8_t extruder, const float millimeters=0.0);
 
+    #if IS_KINEMATIC
+      /**
+       * Planner::buffer_line_kinematic
+       *
+       * As buffer_line, for a target already translated to machine units
+       * by the caller, so runs of segments can be transformed in batches.
+       *
+       *  cart        - target position in mm, before modifiers and kinematics
+       *  machine     - the same target with modifiers and kinematics applied
+       */
+      static bool buffer_line_kinematic(const xyze_pos_t &cart, const abce_pos_t &machine, const feedrate_t &fr_mm_s, const uint8_t extruder, const float millimeters=0.0);
+    #endif
+
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      /**
+       * Planner::buffer_arc
+       *
+       * Add an arc of the XY plane as one block for each octant of the circle,
+       * traced by the Stepper on the integer circle of the start point. The
+       * points near the diagonals are joined by a line of a few steps, and a
+       * last line goes to the target if it is off the circle.
+       *
+       *  start, target - the ends in mm, modifiers applied
+       *  center        - the center of the arc in mm
+       *  travel        - the angle of the arc, positive counterclockwise
+       *
+       * Returns false, with nothing queued, if the arc can't be traced so:
+       * the caller splits it in lines.
+       */
+      static bool buffer_arc(const xyze_pos_t &start, const xyze_pos_t &target, const xy_pos_t &center, const float &travel, const feedrate_t &fr_mm_s, const uint8_t extruder);
+    #endif
+
     FORCE_INLINE static bool buffer_line(const xyze_float_t &cart, const feedrate_t &fr_mm_s, const uint8_t extruder, const float millimeters=0.0
       #if ENABLED(SCARA_FEEDRATE_SCALING)
         , const float &inv_duration=0.0
@@ -497,6 +771,10 @@ class Planner {
      */
     static block_t* get_current_block() {
 
+      #if HAS_TIME_WARP
+        if (time_warp) return nullptr;
+      #endif
+
       // Get the number of moves in the planner queue so far
       const uint8_t nr_moves = moves_planned();
 
@@ -518,10 +796,14 @@ class Planner {
         // No trapezoid calculated? Don't execute yet.
         if (TEST(block->flag, BLOCK_BIT_RECALCULATE)) return nullptr;
 
-        #if HAS_SPI_LCD
+        #if HAS_BLOCK_BUFFER_RUNTIME
           block_buffer_runtime_us -= block->segment_time_us; // We can't be sure how long an active block will take, so don't count it.
         #endif
 
+        #if ENABLED(PLANNER_UNDERRUN_STATS)
+          underrun_sample(nr_moves - 1);
+        #endif
+
         // As this block is busy, advance the nonbusy block pointer
         block_buffer_nonbusy = next_block_index(block_buffer_tail);
 
@@ -534,14 +816,27 @@ class Planner {
       }
 
       // The queue became empty
-      #if HAS_SPI_LCD
+      #if HAS_BLOCK_BUFFER_RUNTIME
         clear_block_buffer_runtime(); // paranoia. Buffer is empty now - so reset accumulated time to zero.
       #endif
 
+      #if ENABLED(PLANNER_UNDERRUN_STATS)
+        if (underrun.running) underrun_empty();
+      #endif
+
       return nullptr;
     }
 
-    #if HAS_SPI_LCD
+    #if ENABLED(STEP_QUEUE) || ENABLED(STEP_COPROCESSOR)
+      /**
+       * The block at index for the step queue or the coprocessor. nullptr if it is not ready.
+       * This also marks the block as busy.
+       * Called from the main loop.
+       */
+      static block_t* get_queue_block(const uint8_t index);
+    #endif
+
+    #if HAS_BLOCK_BUFFER_RUNTIME
 
       static uint16_t block_buffer_runtime() {
         #if ENABLED(__AVR__)
@@ -583,7 +878,44 @@ class Planner {
         #endif
       }
 
-    #endif // HAS_SPI_LCD
+    #endif // HAS_BLOCK_BUFFER_RUNTIME
+
+    #if ENABLED(PLANNER_TIMING_STATS)
+      static void report_timing();
+    #endif
+
+    #if ENABLED(PLANNER_UNDERRUN_STATS)
+      static void underrun_reset();
+      static void underrun_layer(const float &z);   // Z of an extruding move
+      static void report_underrun();
+      static void print_underrun_json();
+    #endif
+
+    #if HAS_TIME_WARP
+      /**
+       * Time warp: the blocks are planned as for a print, then timed from
+       * their trapezoid and dropped when the buffer is full, never stepped.
+       */
+      static void time_warp_start();
+      static uint32_t time_warp_stop();               // The time in seconds
+      static void time_warp_dwell(const millis_l ms);
+    #endif
+
+    #if ENABLED(PLANNER_FIXED_POINT)
+      static void fixed_point_accuracy_test();
+    #endif
+
+    #if ENABLED(SEGMENT_MERGE)
+      /**
+       * Queue the merged move, if any. The next move starts a new run.
+       */
+      static void merge_flush();
+
+      /**
+       * The merged move can't wait any more with a short buffer
+       */
+      FORCE_INLINE static void merge_check() { if (merge.pending && moves_planned() < SEGMENT_MERGE_MIN_MOVES) merge_flush(); }
+    #endif
 
     #if HAS_TEMP_HOTEND && ENABLED(AUTOTEMP)
       static float autotemp_min, autotemp_max, autotemp_factor;
@@ -594,11 +926,34 @@ class Planner {
 
   private: /** Private Function */
 
+    #if HAS_TIME_WARP
+      static void time_warp_block();
+    #endif
+
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      static void fill_arc(block_t * const block);
+    #endif
+
+    #if ENABLED(SEGMENT_MERGE)
+      static bool merge_line(const xyze_pos_t &target, const feedrate_t &fr_mm_s, const uint8_t extruder, const float &millimeters);
+    #endif
+
+    #if ENABLED(PLANNER_UNDERRUN_STATS)
+      // Called from the Stepper ISR
+      static void underrun_sample(const uint8_t depth);
+      static void underrun_empty();
+    #endif
+
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static constexpr uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
-    static constexpr uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    FORCE_INLINE static uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
+    FORCE_INLINE static uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
+
+    /**
+     * Set a cleared block as sync block and queue it
+     */
+    static void commit_sync_block(block_t * const block, const uint8_t next_buffer_head);
 
     /**
      * Calculate the distance (not time) it takes to accelerate
@@ -631,6 +986,13 @@ class Planner {
       return target_velocity_sqr - 2 * accel * distance;
     }
 
+    /**
+     * Same as above, deceleration over the whole block, using the cached accel_distance_x2
+     */
+    FORCE_INLINE static float max_allowable_speed_sqr(const block_t * const block, const float &target_velocity_sqr) {
+      return target_velocity_sqr + block->accel_distance_x2;
+    }
+
     #if ENABLED(BEZIER_JERK_CONTROL)
       /**
        * Calculate the speed reached given initial speed, acceleration and distance
@@ -640,6 +1002,44 @@ class Planner {
       }
     #endif
 
+    #if ENABLED(PLANNER_FIXED_POINT)
+      /**
+       * Q16.16 and Q0.32 helpers for the fixed point trapezoid generator
+       */
+      FORCE_INLINE static uint32_t float_to_q16(const float &f) { return uint32_t(f * 65536.0f); }
+      #if ENABLED(__AVR__)
+        /**
+         * On AVR a 64 bit product is a library call of many 8x8 MULs,
+         * here four 16x16 products, each a few MULs, do the same:
+         * v * q = hh << 32 + (hl + lh) << 16 + ll
+         */
+        FORCE_INLINE static uint32_t fixed_mul_q16_ceil(const uint32_t v, const uint32_t q16) {
+          const uint16_t vh = v >> 16, vl = v, qh = q16 >> 16, ql = q16;
+          const uint32_t ll = (uint32_t)vl * ql;
+          return (((uint32_t)vh * qh) << 16) + (uint32_t)vh * ql + (uint32_t)vl * qh + (ll >> 16) + ((uint16_t)ll ? 1 : 0);
+        }
+        // The high 32 bits of v * q, inexact if the low 32 bits are not zero
+        FORCE_INLINE static uint32_t fixed_mul_h32(const uint32_t v, const uint32_t q, bool &inexact) {
+          const uint16_t vh = v >> 16, vl = v, qh = q >> 16, ql = q;
+          const uint32_t ll  = (uint32_t)vl * ql,
+                         lh  = (uint32_t)vl * qh,
+                         mid = (uint32_t)vh * ql + (ll >> 16) + lh; // Its carry is 1 << 48 of the product
+          inexact = (uint16_t)mid || (uint16_t)ll;
+          return (uint32_t)vh * qh + (mid >> 16) + (mid < lh ? 0x10000UL : 0);
+        }
+        FORCE_INLINE static uint32_t fixed_mul_q32(const uint32_t v, const uint32_t q32) { bool inexact; return fixed_mul_h32(v, q32, inexact); }
+        FORCE_INLINE static uint32_t fixed_mul_q32_ceil(const uint32_t v, const uint32_t q32) {
+          bool inexact;
+          const uint32_t r = fixed_mul_h32(v, q32, inexact);
+          return inexact ? r + 1 : r;
+        }
+      #else
+        FORCE_INLINE static uint32_t fixed_mul_q16_ceil(const uint32_t v, const uint32_t q16) { return uint32_t(((uint64_t)v * q16 + 0xFFFFUL) >> 16); }
+        FORCE_INLINE static uint32_t fixed_mul_q32(const uint32_t v, const uint32_t q32) { return uint32_t(((uint64_t)v * q32) >> 32); }
+        FORCE_INLINE static uint32_t fixed_mul_q32_ceil(const uint32_t v, const uint32_t q32) { return uint32_t(((uint64_t)v * q32 + 0xFFFFFFFFUL) >> 32); }
+      #endif
+    #endif
+
     static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
 
     static void reverse_pass_kernel(block_t* const current_block, const block_t* const next_block);
@@ -648,7 +1048,7 @@ class Planner {
     static void reverse_pass();
     static void forward_pass();
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const uint8_t planned_index);
 
     static void recalculate();
 
@@ -657,7 +1057,7 @@ class Planner {
       FORCE_INLINE static void normalize_junction_vector(xyze_float_t &vector) {
         float magnitude_sq = 0;
         LOOP_XYZE(axis) if (vector[axis]) magnitude_sq += sq(vector[axis]);
-        vector *= RSQRT(magnitude_sq);
+        vector *= FAST_RSQRT(magnitude_sq);
       }
 
       FORCE_INLINE static float limit_value_by_axis_maximum(const float &max_value, xyze_float_t &unit_vec) {
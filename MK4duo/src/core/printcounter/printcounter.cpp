@@ -24,7 +24,11 @@
 
 #define STATS_EEPROM_ADDRESS  0x32
 #define STATS_UPDATE_INTERVAL   10
-#define STATS_SAVE_INTERVAL   3600
+#if ENABLED(STATS_DEFERRED_SAVE)
+  #define STATS_SAVE_INTERVAL (3600UL * (STATS_DEFERRED_INTERVAL))
+#else
+  #define STATS_SAVE_INTERVAL   3600
+#endif
 
 // Service times
 #if ENABLED(SERVICE_TIME_1)
@@ -81,7 +85,9 @@ void PrintCounter::initStats() {
     data.consumptionHour = 0;
   #endif
 
-  #if HAS_EEPROM
+  #if ENABLED(EEPROM_JOURNAL_SIZE)
+    journal.write(JOURNAL_STATS, &data, sizeof(data));
+  #elif HAS_EEPROM
     memorystore.write_data(address, (uint8_t*)&statistics_version, sizeof(statistics_version));
     memorystore.write_data(address + sizeof(statistics_version), (uint8_t*)&data, sizeof(data));
     memorystore.access_write();
@@ -89,7 +95,7 @@ void PrintCounter::initStats() {
 }
 
 void PrintCounter::showStats() {
-  char buffer[21];
+  char buffer[22];
 
   SERIAL_MSG(MSG_HOST_STATS);
 
@@ -125,6 +131,7 @@ void PrintCounter::showStats() {
   #if HAS_POWER_CONSUMPTION_SENSOR
     SERIAL_MSG(MSG_HOST_STATS);
     SERIAL_MV("Watt/h consumed:", data.consumptionHour);
+    SERIAL_MV(" Wh, Last job:", powerManager.job_energy(), 3);
     SERIAL_EM(" Wh");
   #endif
 
@@ -137,16 +144,22 @@ void PrintCounter::loadStats() {
 
   #if HAS_EEPROM
 
-    // Check if the EEPROM block is initialized
-    char value[3];
+    // The journal has the last values, the EEPROM block the ones before the journal
+    #if ENABLED(EEPROM_JOURNAL_SIZE)
+      if (!journal.read(JOURNAL_STATS, &data, sizeof(data)))
+    #endif
+    {
+      // Check if the EEPROM block is initialized
+      char value[3];
 
-    memorystore.access_start();
-    memorystore.read_data(address, (uint8_t*)&value, sizeof(value));
+      memorystore.access_start();
+      memorystore.read_data(address, (uint8_t*)&value, sizeof(value));
 
-    if (strncmp(statistics_version, value, 2) != 0)
-      initStats();
-    else
-      memorystore.read_data(address + sizeof(statistics_version), (uint8_t*)&data, sizeof(printStatistics));
+      if (strncmp(statistics_version, value, 2) != 0)
+        initStats();
+      else
+        memorystore.read_data(address + sizeof(statistics_version), (uint8_t*)&data, sizeof(printStatistics));
+    }
 
   #endif
 
@@ -182,7 +195,10 @@ void PrintCounter::saveStats() {
   // Refuses to save data is object is not loaded
   if (!printer.IsStatisticsLoaded()) return;
 
-  #if HAS_EEPROM
+  #if ENABLED(EEPROM_JOURNAL_SIZE)
+    // Only a record with the struct
+    journal.write(JOURNAL_STATS, &data, sizeof(data));
+  #elif HAS_EEPROM
     // Saves the struct to EEPROM
     memorystore.write_data(address + sizeof(statistics_version), (uint8_t*)&data, sizeof(data));
     memorystore.access_write();
@@ -214,8 +230,18 @@ void PrintCounter::tick() {
     #endif
   }
 
-  if (eeprom_next_timer.expired((STATS_SAVE_INTERVAL) * 1000UL))
-    saveStats();
+  #if ENABLED(STATS_DEFERRED_SAVE)
+    // Never while printing, the end of the job saves them
+    static bool save_pending = false;
+    if (eeprom_next_timer.expired((STATS_SAVE_INTERVAL) * 1000UL)) save_pending = true;
+    if (save_pending && !isRunning()) {
+      save_pending = false;
+      saveStats();
+    }
+  #else
+    if (eeprom_next_timer.expired((STATS_SAVE_INTERVAL) * 1000UL))
+      saveStats();
+  #endif
 
 }
 
@@ -272,14 +298,13 @@ bool PrintCounter::start() {
 
   bool paused = isPaused();
 
-  #if HAS_POWER_CONSUMPTION_SENSOR
-    powerManager.startpower = data.consumptionHour;
-  #endif
-
   if (watch::start()) {
     if (!paused) {
       data.totalPrints++;
       lastDuration = 0;
+      #if HAS_POWER_CONSUMPTION_SENSOR
+        powerManager.job_reset();
+      #endif
     }
     return true;
   }
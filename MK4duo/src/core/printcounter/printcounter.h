@@ -96,7 +96,8 @@ class PrintCounter: public Watch {
 
     /**
      * @brief Saves the Print Statistics
-     * @details Saves the statistics to EEPROM
+     * @details Saves the statistics to EEPROM, with STATS_DEFERRED_SAVE
+     * only at the end of a job, on power outage and at long intervals.
      */
     static void saveStats();
 
@@ -0,0 +1,95 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * buffer_arena.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(BUFFER_ARENA)
+
+BufferArena bufferArena;
+
+/** Public Parameters */
+arena_data_t BufferArena::data;
+
+/** Private Parameters */
+static uint8_t arena[BUFFER_ARENA_SIZE] __attribute__((aligned(8)));
+
+static_assert(BLOCK_BUFFER_SIZE * sizeof(block_t) + BUFSIZE * sizeof(gcode_t) <= BUFFER_ARENA_SIZE,
+              "BUFFER_ARENA_SIZE is too small for BLOCK_BUFFER_SIZE and BUFSIZE.");
+
+/** Public Function */
+void BufferArena::factory_parameters() {
+  data.blocks   = BLOCK_BUFFER_SIZE;
+  data.commands = BUFSIZE;
+}
+
+void BufferArena::apply() {
+  if (!valid(data.blocks, data.commands)) factory_parameters();
+
+  block_t * const blocks = (block_t*)arena;
+  gcode_t * const slots = (gcode_t*)(arena + data.blocks * sizeof(block_t));
+
+  memset(blocks, 0, data.blocks * sizeof(block_t));
+  for (uint8_t s = 0; s < data.commands; s++) slots[s] = gcode_t();
+
+  planner.block_buffer = blocks;
+  planner.block_buffer_mask = data.blocks - 1;
+  planner.clear_block_buffer();
+  commands.buffer_ring.attach(slots, data.commands);
+}
+
+bool BufferArena::valid(const uint8_t blocks, const uint8_t commands) {
+  constexpr uint8_t blocks_min =
+    #if ENABLED(STEP_COPROCESSOR)
+      MAX(8, STEP_COPROCESSOR_SLOTS + 1)
+    #else
+      8
+    #endif
+  ;
+  constexpr uint8_t commands_min =
+    #if ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 >= -1
+      MAX(2, SERIAL_PORT_2_HEADROOM + 1)
+    #else
+      2
+    #endif
+  ;
+  return WITHIN(blocks, blocks_min, 128) && IS_POWER_OF_2(blocks)
+      && WITHIN(commands, commands_min, 128) && IS_POWER_OF_2(commands)
+      && blocks * sizeof(block_t) + commands * sizeof(gcode_t) <= BUFFER_ARENA_SIZE;
+}
+
+void BufferArena::print_M225() {
+  SERIAL_LM(CFG, "Buffer arena: B<planner blocks> C<command slots>, at the next boot");
+  SERIAL_SMV(CFG, "  M225 B", int(data.blocks));
+  SERIAL_MV(" C", int(data.commands));
+  SERIAL_MV(" ; now B", int(planner.block_buffer_size()));
+  SERIAL_MV(" C", int(commands.buffer_ring.size()));
+  SERIAL_MV(", ", int(data.blocks * sizeof(block_t) + data.commands * sizeof(gcode_t)));
+  SERIAL_EMV(" of ", int(BUFFER_ARENA_SIZE));
+}
+
+#endif // ENABLED(BUFFER_ARENA)
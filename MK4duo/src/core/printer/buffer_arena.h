@@ -0,0 +1,73 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * buffer_arena.h
+ *
+ * One block of RAM shared by the planner blocks and the command slots. The split
+ * is stored in EEPROM (M225) and set at boot, before the queues are used:
+ * more slots for a host stream, more blocks for the tiny segments of a SD job.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(BUFFER_ARENA)
+
+// Struct Buffer arena data
+typedef struct {
+  uint8_t blocks,     // Planner blocks, a power of 2
+          commands;   // Command slots, a power of 2
+} arena_data_t;
+
+class BufferArena {
+
+  public: /** Constructor */
+
+    BufferArena() {}
+
+  public: /** Public Parameters */
+
+    static arena_data_t data;     // Split for the next boot
+
+  public: /** Public Function */
+
+    static void factory_parameters();
+
+    /**
+     * Hand the arena to the planner and the command buffer with the split of data.
+     * Only at boot, with the queues empty and the stepper stopped.
+     */
+    static void apply();
+
+    /**
+     * The split is two powers of 2 that fit in the arena
+     */
+    static bool valid(const uint8_t blocks, const uint8_t commands);
+
+    static void print_M225();
+
+};
+
+extern BufferArena bufferArena;
+
+#endif // ENABLED(BUFFER_ARENA)
@@ -0,0 +1,98 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * crash_record.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(CRASH_RECORD)
+
+// Out of the .bss: the startup code does not clear it, a reset keeps it
+#if ENABLED(ARDUINO_ARCH_NATIVE)
+  #define CRASH_NOINIT
+#else
+  #define CRASH_NOINIT __attribute__((section(".noinit")))
+#endif
+
+// A new layout is a new magic, the record of another build is not read
+#define CRASH_MAGIC (0x4D4B4352UL ^ sizeof(crash_record_t))
+
+CrashRecord crashRecord;
+
+/** Public Parameters */
+crash_record_t CrashRecord::data CRASH_NOINIT;
+crash_record_t CrashRecord::last;
+bool           CrashRecord::has_last = false;
+
+/** Public Function */
+void CrashRecord::init() {
+  has_last = data.magic == CRASH_MAGIC;
+  if (has_last) {
+    last = data;
+    // The texts of the RAM of a power on may have no end
+    for (uint8_t c = 0; c < CRASH_RECORD_COMMANDS; c++)
+      last.command[c][CRASH_RECORD_LENGTH - 1] = '\0';
+  }
+  memset(&data, 0, sizeof(data));
+  data.magic      = CRASH_MAGIC;
+  data.idle_task  = IDLE_TASK_COUNT;
+}
+
+void CrashRecord::tick() {
+  data.tick_ms    = millis();
+  data.block_tail = planner.block_buffer_tail;
+  data.block_head = planner.block_buffer_head;
+  #if ENABLED(STEPPER_ISR_PROFILER)
+    data.isr_max  = isrProfiler.phase[ISR_TOTAL].max;
+  #endif
+}
+
+void CrashRecord::print() {
+  if (!has_last) {
+    SERIAL_LM(ECHO, "No crash record");
+    return;
+  }
+  SERIAL_LM(ECHO, "Crash record of the run before the reset:");
+  SERIAL_LMV(ECHO, " Uptime (ms):", last.tick_ms);
+  SERIAL_SMV(ECHO, " Last stepper ISR (ms):", last.stepper_ms);
+  SERIAL_EMV(" Last idle end (ms):", last.idle_ms);
+  #if ENABLED(STEPPER_ISR_PROFILER)
+    SERIAL_SMV(ECHO, " Longest stepper ISR (cycles):", last.isr_max);
+    SERIAL_EMV(" Rate (Hz):", uint32_t(HAL_CYCLE_COUNTER_RATE));
+  #endif
+  SERIAL_SMV(ECHO, " Block busy:", last.block_tail);
+  SERIAL_EMV(" Next:", last.block_head);
+  SERIAL_SM(ECHO, " Idle task:");
+  SERIAL_STR(idle_task_name(IdleTaskEnum(last.idle_task)));
+  SERIAL_EOL();
+  SERIAL_LM(ECHO, " Last commands:");
+  for (uint8_t c = 0; c < CRASH_RECORD_COMMANDS; c++) {
+    const char * const cmd = last.command[(last.command_index + c) % (CRASH_RECORD_COMMANDS)];
+    if (*cmd) SERIAL_LT(ECHO, cmd);
+  }
+}
+
+#endif // ENABLED(CRASH_RECORD)
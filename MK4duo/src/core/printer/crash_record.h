@@ -0,0 +1,100 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * crash_record.h
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(CRASH_RECORD)
+
+// Struct crash record, in RAM not cleared by a reset
+typedef struct {
+  uint32_t  magic;
+  millis_l  tick_ms,                    // Last run of the tick ISR, the uptime
+            stepper_ms,                 // Last run of the stepper ISR
+            idle_ms;                    // Last end of an idle call
+  uint32_t  isr_max;                    // Longest stepper ISR (STEPPER_ISR_PROFILER)
+  uint8_t   block_tail,                 // Blocks of the planner: busy and next
+            block_head,
+            idle_task,                  // Last task of the idle loop entered
+            command_index;              // Next slot of the command ring
+  char      command[CRASH_RECORD_COMMANDS][CRASH_RECORD_LENGTH];
+} crash_record_t;
+
+class CrashRecord {
+
+  public: /** Constructor */
+
+    CrashRecord() {}
+
+  public: /** Public Parameters */
+
+    static crash_record_t data,         // The record of this run
+                          last;         // The record left by the run before the reset
+
+    static bool           has_last;
+
+  public: /** Public Function */
+
+    /**
+     * At the setup: keep the record of the run before, if the RAM has held it
+     * (a watchdog or a reset, not a power on), report it and start a new one
+     */
+    static void init();
+
+    /**
+     * Called at the dispatch of each command, keeps the last ones
+     */
+    FORCE_INLINE static void command(const char * const cmd) {
+      strncpy(data.command[data.command_index], cmd, CRASH_RECORD_LENGTH - 1);
+      if (++data.command_index >= CRASH_RECORD_COMMANDS) data.command_index = 0;
+    }
+
+    /**
+     * Called from the tick ISR: the uptime, the blocks and the ISR time
+     */
+    static void tick();
+
+    FORCE_INLINE static void stepper()                  { data.stepper_ms = data.tick_ms; }
+    FORCE_INLINE static void idle_end()                 { data.idle_ms = data.tick_ms; }
+    FORCE_INLINE static void idle_task(const uint8_t t) { data.idle_task = t; }
+
+    static void print();
+
+};
+
+extern CrashRecord crashRecord;
+
+#define CRASH_RECORD_TICK()     crashRecord.tick()
+#define CRASH_RECORD_STEPPER()  crashRecord.stepper()
+#define CRASH_RECORD_TASK(T)    crashRecord.idle_task(T)
+
+#else
+
+#define CRASH_RECORD_TICK()     NOOP
+#define CRASH_RECORD_STEPPER()  NOOP
+#define CRASH_RECORD_TASK(T)    NOOP
+
+#endif // ENABLED(CRASH_RECORD)
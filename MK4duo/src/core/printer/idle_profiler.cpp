@@ -0,0 +1,113 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * idle_profiler.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(IDLE_PROFILER)
+
+IdleProfiler idleProfiler;
+
+/** Public Parameters */
+idle_task_t IdleProfiler::task[IDLE_TASK_COUNT];
+uint32_t    IdleProfiler::histogram[IDLE_HISTOGRAM_BINS] = { 0 };
+
+/** Private Parameters */
+uint32_t  IdleProfiler::start_us  = 0;
+uint8_t   IdleProfiler::nesting   = 0;
+
+/** Public Function */
+void IdleProfiler::reset() {
+  for (uint8_t t = 0; t < IDLE_TASK_COUNT; t++) {
+    task[t].min = 0xFFFFFFFFUL;
+    task[t].max = task[t].total = task[t].count = 0;
+  }
+  ZERO(histogram);
+}
+
+void IdleProfiler::end() {
+  if (nesting-- != 1) return;
+  const uint32_t us = micros() - start_us;
+  add(task[IDLE_TOTAL], us);
+  uint8_t bin = 0;
+  for (uint32_t v = us >> 1; v && bin < IDLE_HISTOGRAM_BINS - 1; v >>= 1) bin++;
+  histogram[bin]++;
+}
+
+void IdleProfiler::print() {
+  SERIAL_LM(ECHO, "Idle profile (us):");
+  for (uint8_t t = 0; t < IDLE_TASK_COUNT; t++) {
+    if (!task[t].count) continue;
+    SERIAL_STR(ECHO);
+    SERIAL_STR(idle_task_name(IdleTaskEnum(t)));
+    SERIAL_MV(" min:", task[t].min);
+    SERIAL_MV(" avg:", task[t].total / task[t].count);
+    SERIAL_MV(" max:", task[t].max);
+    SERIAL_EMV(" count:", task[t].count);
+  }
+  SERIAL_LM(ECHO, "Idle latency histogram (us:count):");
+  for (uint8_t b = 0; b < IDLE_HISTOGRAM_BINS; b++) {
+    if (!histogram[b]) continue;
+    SERIAL_SMV(ECHO, " <", 2UL << b);
+    SERIAL_EMV(":", histogram[b]);
+  }
+}
+
+/** Private Function */
+void IdleProfiler::add(idle_task_t &t, const uint32_t us) {
+  NOMORE(t.min, us);
+  NOLESS(t.max, us);
+  // Halve the sums before an overflow, the average stays
+  if (t.total > 0x7FFFFFFFUL) { t.total >>= 1; t.count >>= 1; }
+  t.total += us;
+  t.count++;
+}
+
+#endif // ENABLED(IDLE_PROFILER)
+
+#if ENABLED(IDLE_PROFILER) || ENABLED(CRASH_RECORD)
+
+PGM_P idle_task_name(const IdleTaskEnum t) {
+  switch (t) {
+    case IDLE_LCD:      return PSTR("LCD");
+    case IDLE_COMMANDS: return PSTR("Commands");
+    case IDLE_SAFETY:   return PSTR("Safety");
+    case IDLE_SOUND:    return PSTR("Sound");
+    case IDLE_SENSORS:  return PSTR("Sensors");
+    case IDLE_CNC:      return PSTR("CNC");
+    case IDLE_RUNOUT:   return PSTR("Runout");
+    case IDLE_RFID:     return PSTR("RFID");
+    case IDLE_BABYSTEP: return PSTR("Babystep");
+    case IDLE_STEPPERS: return PSTR("Steppers");
+    case IDLE_TMC:      return PSTR("TMC");
+    case IDLE_MMU2:     return PSTR("MMU2");
+    case IDLE_TOTAL:    return PSTR("Total");
+    default:            return PSTR("None");
+  }
+}
+
+#endif // ENABLED(IDLE_PROFILER) || ENABLED(CRASH_RECORD)
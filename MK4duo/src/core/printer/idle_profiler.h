@@ -0,0 +1,121 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * idle_profiler.h
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(IDLE_PROFILER) || ENABLED(CRASH_RECORD)
+
+enum IdleTaskEnum : uint8_t {
+  IDLE_LCD,
+  IDLE_COMMANDS,
+  IDLE_SAFETY,
+  IDLE_SOUND,
+  IDLE_SENSORS,
+  IDLE_CNC,
+  IDLE_RUNOUT,
+  IDLE_RFID,
+  IDLE_BABYSTEP,
+  IDLE_STEPPERS,
+  IDLE_TMC,
+  IDLE_MMU2,
+  IDLE_TOTAL,
+  IDLE_TASK_COUNT
+};
+
+PGM_P idle_task_name(const IdleTaskEnum t);
+
+#endif
+
+#if ENABLED(IDLE_PROFILER)
+
+#define IDLE_HISTOGRAM_BINS 20  // Bin n counts the idle calls from 2^n to 2^(n+1)-1 us
+
+// Struct idle task statistics, in microseconds
+typedef struct {
+  uint32_t  min,
+            max,
+            total,
+            count;
+} idle_task_t;
+
+class IdleProfiler {
+
+  public: /** Constructor */
+
+    IdleProfiler() {}
+
+  public: /** Public Parameters */
+
+    static idle_task_t  task[IDLE_TASK_COUNT];
+    static uint32_t     histogram[IDLE_HISTOGRAM_BINS];
+
+  private: /** Private Parameters */
+
+    static uint32_t start_us;
+    static uint8_t  nesting;
+
+  public: /** Public Function */
+
+    static void reset();
+
+    /**
+     * Start and end of an idle call, only the outer call is profiled
+     * when idle() is called again from one of its tasks
+     */
+    FORCE_INLINE static void begin() { if (!nesting++) start_us = micros(); }
+    static void end();
+
+    /**
+     * Add a sample for the task, from the start time to now
+     */
+    FORCE_INLINE static void record(const IdleTaskEnum t, const uint32_t start) {
+      if (nesting == 1) add(task[t], micros() - start);
+    }
+
+    static void print();
+
+  private: /** Private Function */
+
+    static void add(idle_task_t &t, const uint32_t us);
+
+};
+
+extern IdleProfiler idleProfiler;
+
+#define IDLE_PROFILE_BEGIN()      idleProfiler.begin()
+#define IDLE_PROFILE_FINISH()     idleProfiler.end()
+#define IDLE_PROFILE_START(T,V)   CRASH_RECORD_TASK(T); const uint32_t V = micros()
+#define IDLE_PROFILE_END(T,V)     idleProfiler.record(T, V)
+
+#else
+
+#define IDLE_PROFILE_BEGIN()      NOOP
+#define IDLE_PROFILE_FINISH()     NOOP
+#define IDLE_PROFILE_START(T,V)   CRASH_RECORD_TASK(T)
+#define IDLE_PROFILE_END(T,V)     NOOP
+
+#endif // ENABLED(IDLE_PROFILER)
@@ -0,0 +1,141 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * memory_profiler.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(MEMORY_PROFILER)
+
+#define MEMORY_TEST_BYTE    ((char)0xA5)
+#define MEMORY_PAINT_GUARD  128     // Bytes left under the stack pointer of paint()
+
+#if ENABLED(__AVR__)
+  extern char __bss_end, *__brkval;
+#elif DISABLED(ARDUINO_ARCH_NATIVE)
+  extern "C" char* _sbrk(int incr);
+#endif
+
+MemoryProfiler memoryProfiler;
+
+/** Public Parameters */
+char * volatile MemoryProfiler::isr_sp_min[MEM_ISR_COUNT];
+
+/** Private Parameters */
+char  *MemoryProfiler::stack_top    = nullptr,
+      *MemoryProfiler::paint_start  = nullptr;
+
+/** Public Function */
+void MemoryProfiler::paint() {
+  char sp;
+  stack_top = &sp;
+
+  DISABLE_ISRS();
+  for (uint8_t i = 0; i < MEM_ISR_COUNT; i++) isr_sp_min[i] = stack_top;
+  #if DISABLED(ARDUINO_ARCH_NATIVE)
+    // No call in the loop, it must not write its own frame
+    paint_start = heap_end();
+    for (char *p = paint_start; p < stack_top - MEMORY_PAINT_GUARD; p++) *p = MEMORY_TEST_BYTE;
+  #endif
+  ENABLE_ISRS();
+}
+
+void MemoryProfiler::print() {
+  SERIAL_LM(ECHO, "Memory profile (bytes):");
+  SERIAL_SMV(ECHO, " Free now:", freeMemory());
+  #if DISABLED(ARDUINO_ARCH_NATIVE)
+    SERIAL_MV(" Free min:", never_used());
+  #endif
+  SERIAL_EOL();
+
+  SERIAL_SM(ECHO, " Stack from the setup, in ISR");
+  SERIAL_MV(" stepper:", uint32_t(stack_top - isr_sp_min[MEM_ISR_STEPPER]));
+  SERIAL_EMV(" tick:", uint32_t(stack_top - isr_sp_min[MEM_ISR_TICK]));
+
+  SERIAL_SMV(ECHO, " Planner:", int(planner.block_buffer_size()));
+  SERIAL_MV(" x ", int(sizeof(block_t)));
+  SERIAL_EMV(" = ", int(planner.block_buffer_size() * sizeof(block_t)));
+  SERIAL_SMV(ECHO, " Commands:", int(commands.buffer_ring.size()));
+  SERIAL_MV(" x ", int(sizeof(gcode_t)));
+  SERIAL_EMV(" = ", int(commands.buffer_ring.size() * sizeof(gcode_t)));
+  #if ENABLED(BUFFER_ARENA)
+    SERIAL_EMV(" Buffer arena:", int(BUFFER_ARENA_SIZE));
+  #endif
+  SERIAL_SMV(ECHO, " Serial RX:", int(RX_BUFFER_SIZE));
+  SERIAL_EMV(" TX:", int(TX_BUFFER_SIZE));
+
+  // The static pools, at their maximum
+  SERIAL_SMV(ECHO, " Drivers:", int(MAX_DRIVER_XYZ + MAX_DRIVER_E));
+  SERIAL_MV(" x ", int(sizeof(Driver)));
+  SERIAL_EMV(" = ", int((MAX_DRIVER_XYZ + MAX_DRIVER_E) * sizeof(Driver)));
+  constexpr int heaters = 0
+    #if HAS_HOTENDS
+      + MAX_HOTEND
+    #endif
+    #if HAS_BEDS
+      + MAX_BED
+    #endif
+    #if HAS_CHAMBERS
+      + MAX_CHAMBER
+    #endif
+    #if HAS_COOLERS
+      + MAX_COOLER
+    #endif
+  ;
+  SERIAL_SMV(ECHO, " Heaters:", heaters);
+  SERIAL_MV(" x ", int(sizeof(Heater)));
+  SERIAL_EMV(" = ", int(heaters * sizeof(Heater)));
+  SERIAL_SMV(ECHO, " Fans:", int(MAX_FAN));
+  SERIAL_MV(" x ", int(sizeof(Fan)));
+  SERIAL_EMV(" = ", int(MAX_FAN * sizeof(Fan)));
+  SERIAL_SMV(ECHO, " Extruders:", int(MAX_EXTRUDER));
+  SERIAL_MV(" x ", int(sizeof(Extruder)));
+  SERIAL_EMV(" = ", int(MAX_EXTRUDER * sizeof(Extruder)));
+}
+
+/** Private Function */
+char* MemoryProfiler::heap_end() {
+  #if ENABLED(__AVR__)
+    return __brkval ? __brkval : &__bss_end;
+  #elif ENABLED(ARDUINO_ARCH_NATIVE)
+    return nullptr;
+  #else
+    return _sbrk(0);
+  #endif
+}
+
+/**
+ * The test bytes from the end of the heap, the stack has never gone under
+ */
+uint32_t MemoryProfiler::never_used() {
+  const char *p = heap_end();
+  NOLESS(p, paint_start);
+  const char * const start = p;
+  while (p < stack_top && *p == MEMORY_TEST_BYTE) p++;
+  return p - start;
+}
+
+#endif // ENABLED(MEMORY_PROFILER)
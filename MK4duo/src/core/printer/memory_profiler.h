@@ -0,0 +1,86 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * memory_profiler.h
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(MEMORY_PROFILER)
+
+enum MemoryIsrEnum : uint8_t {
+  MEM_ISR_STEPPER,
+  MEM_ISR_TICK,
+  MEM_ISR_COUNT
+};
+
+class MemoryProfiler {
+
+  public: /** Constructor */
+
+    MemoryProfiler() {}
+
+  public: /** Public Parameters */
+
+    static char * volatile isr_sp_min[MEM_ISR_COUNT];   // Lowest stack pointer seen in each ISR
+
+  private: /** Private Parameters */
+
+    static char *stack_top,     // Stack pointer of the setup, the base of the measures
+                *paint_start;   // First painted byte, over the heap
+
+  public: /** Public Function */
+
+    /**
+     * Fill the free RAM, from the end of the heap up to the stack, with a test byte.
+     * The bytes still equal to it are the stack never used since.
+     */
+    static void paint();
+
+    /**
+     * Sample in the ISR of the stack pointer, keeps the lowest
+     */
+    FORCE_INLINE static void sample(const MemoryIsrEnum i) {
+      char sp;
+      if (&sp < isr_sp_min[i]) isr_sp_min[i] = &sp;
+    }
+
+    static void print();
+
+  private: /** Private Function */
+
+    static char* heap_end();
+    static uint32_t never_used();
+
+};
+
+extern MemoryProfiler memoryProfiler;
+
+#define MEMORY_PROFILE_ISR(I)   memoryProfiler.sample(I)
+
+#else
+
+#define MEMORY_PROFILE_ISR(I)   NOOP
+
+#endif // ENABLED(MEMORY_PROFILER)
@@ -29,6 +29,10 @@
 #include "../../../MK4duo.h"
 #include "sanitycheck.h"
 
+#if ENABLED(NEOPIXEL_DMA)
+  #include "../../feature/rgbled/neopixel.h"
+#endif
+
 Printer printer;
 
 debug_flag_t    Printer::debug_flag;    // For debug
@@ -53,6 +57,11 @@ long_timer_t  Printer::max_inactivity_timer,
   uint8_t Printer::host_keepalive_time  = DEFAULT_KEEPALIVE_INTERVAL;
 #endif
 
+#if ENABLED(REALTIME_POSITION_REPORT)
+  millis_s      Printer::autoreport_position_ms = 0;
+  short_timer_t Printer::autoreport_position_timer;
+#endif
+
 // Printer mode
 PrinterModeEnum Printer::mode =
   #if ENABLED(PLOTTER)
@@ -69,6 +78,35 @@ PrinterModeEnum Printer::mode =
     PRINTER_MODE_FFF;
   #endif
 
+#if ENABLED(FAST_BOOT)
+
+  enum BootStepEnum : uint8_t {
+    BOOT_SD_MOUNT,
+    BOOT_SD_RESTART,
+    BOOT_TMC_TEST,
+    BOOT_DONE
+  };
+
+  uint8_t Printer::boot_step = BOOT_DONE;
+
+#endif
+
+#if HAS_BOOT_TIMELINE
+
+  // Times of the boot phases, kept for M136
+  struct boot_time_t {
+    PGM_P     name;
+    uint16_t  at,   // End of the phase, ms from the reset
+              ms;   // Length of the phase
+  };
+
+  boot_time_t boot_time[20];
+  uint8_t     boot_times = 0;
+  millis_l    boot_last  = 0;
+  bool        boot_done  = false;
+
+#endif
+
 #if ENABLED(BARICUDA)
   int Printer::baricuda_valve_pressure  = 0,
       Printer::baricuda_e_to_p_pressure = 0;
@@ -103,8 +141,30 @@ PrinterModeEnum Printer::mode =
  */
 void Printer::setup() {
 
+  #if ENABLED(CRASH_RECORD)
+    crashRecord.init();   // Before the ISR write in the record
+  #endif
+
   HAL::hwSetup();
 
+  BOOT_PHASE("hal");
+
+  #if ENABLED(MEMORY_PROFILER)
+    memoryProfiler.paint();
+  #endif
+
+  #if ENABLED(IDLE_PROFILER)
+    idleProfiler.reset();
+  #endif
+
+  #if ENABLED(BUFFER_ARENA)
+    bufferArena.apply();  // Factory split until the EEPROM is read
+  #endif
+
+  #if ENABLED(IDLE_SCHEDULER)
+    scheduler.init();
+  #endif
+
   #if ENABLED(MB_SETUP)
     MB_SETUP;
   #endif
@@ -137,9 +197,17 @@ void Printer::setup() {
     DLPSerial.begin(PROJECTOR_BAUDRATE);
   #endif
 
+  #if ENABLED(DLP_LAYER_CYCLE)
+    dlpcycle.init();
+  #endif
+
   // Check startup - does nothing if bootloader sets MCUSR to 0
   HAL::showStartReason();
 
+  #if ENABLED(CRASH_RECORD)
+    if (crashRecord.has_last) crashRecord.print();
+  #endif
+
   SERIAL_LM(ECHO, BUILD_VERSION);
 
   #if ENABLED(STRING_REVISION_DATE) && ENABLED(STRING_CONFIG_AUTHOR)
@@ -148,10 +216,13 @@ void Printer::setup() {
   #endif // STRING_REVISION_DATE
 
   SERIAL_SMV(ECHO, MSG_HOST_FREE_MEMORY, freeMemory());
-  SERIAL_EMV(MSG_HOST_PLANNER_BUFFER_BYTES, (int)sizeof(block_t)* (BLOCK_BUFFER_SIZE));
+  SERIAL_EMV(MSG_HOST_PLANNER_BUFFER_BYTES, (int)sizeof(block_t) * planner.block_buffer_size());
 
-  #if HAS_SD_SUPPORT
+  BOOT_PHASE("start");
+
+  #if HAS_SD_SUPPORT && (DISABLED(FAST_BOOT) || HAS_EEPROM_SD)
     card.mount();
+    BOOT_PHASE("sd");
   #endif
 
   // Init endstops
@@ -162,12 +233,22 @@ void Printer::setup() {
     filamentrunout.init();
   #endif
 
+  #if ENABLED(EEPROM_JOURNAL_SIZE)
+    journal.init();
+  #endif
+
   // Initial setup of print job counter
   print_job_counter.init();
 
   // Load data from EEPROM if available (or use defaults)
   // This also updates variables in the planner, elsewhere
-  bool eeprom_loaded = eeprom.load();
+  const bool eeprom_loaded = eeprom.load();
+
+  #if ENABLED(BUFFER_ARENA)
+    bufferArena.apply();
+  #endif
+
+  BOOT_PHASE("eeprom");
 
   #if ENABLED(WORKSPACE_OFFSETS)
     // Initialize current position based on data.home_offset
@@ -182,6 +263,12 @@ void Printer::setup() {
   // Initialize stepper. This enables interrupts!
   stepper.init();
 
+  #if ENABLED(STEP_COPROCESSOR)
+    coprocessor.init();
+  #endif
+
+  BOOT_PHASE("stepper");
+
   #if ENABLED(CNCROUTER)
     cnc.init();
   #endif
@@ -213,6 +300,9 @@ void Printer::setup() {
 
   #if ENABLED(LASER)
     laser.init();
+    #if ENABLED(EEPROM_JOURNAL_SIZE)
+      journal.read(JOURNAL_LASER_LIFETIME, &laser.lifetime, sizeof(laser.lifetime));
+    #endif
   #endif
 
   #if ENABLED(FLOWMETER_SENSOR)
@@ -226,25 +316,34 @@ void Printer::setup() {
     pcf8574.begin();
   #endif
 
+  #if HAS_ACCELEROMETER
+    accelerometer.init();
+  #endif
+
   #if ENABLED(RFID_MODULE)
     setRfid(rfid522.init());
     if (IsRfid()) SERIAL_EM("RFID CONNECT");
   #endif
 
+  BOOT_PHASE("devices");
+
   lcdui.init();
   lcdui.reset_status();
 
   // Show MK4duo boot screen
-  #if HAS_SPI_LCD && ENABLED(SHOW_BOOTSCREEN)
+  #if HAS_SPI_LCD && ENABLED(SHOW_BOOTSCREEN) && DISABLED(FAST_BOOT)
     lcdui.show_bootscreen();
   #endif
 
+  BOOT_PHASE("lcd");
+
   #if ENABLED(COLOR_MIXING_EXTRUDER) && MIXING_VIRTUAL_TOOLS > 1
     mixer.init();
   #endif
 
   #if HAS_BLTOUCH
     bltouch.init(true);
+    BOOT_PHASE("bltouch");
   #endif
 
   // All Initialized set Running to true.
@@ -252,27 +351,54 @@ void Printer::setup() {
 
   #if ENABLED(DELTA_HOME_ON_POWER)
     mechanics.home();
+    BOOT_PHASE("home");
   #endif
 
   zero_fan_speed();
 
   #if HAS_LCD_MENU && HAS_EEPROM
     if (!eeprom_loaded) lcdui.goto_screen(lcd_eeprom_allert);
+  #else
+    UNUSED(eeprom_loaded);
   #endif
 
-  #if HAS_SD_RESTART
+  #if HAS_SD_RESTART && DISABLED(FAST_BOOT)
     restart.check();
+    BOOT_PHASE("restart");
   #endif
 
   // Reset Watchdog
   watchdog.reset();
 
-  #if HAS_TRINAMIC && !PS_DEFAULT_OFF
+  #if HAS_TRINAMIC && !PS_DEFAULT_OFF && DISABLED(FAST_BOOT)
     tmc.test_connection(true, true, true, true);
+    BOOT_PHASE("tmc");
   #endif
 
   #if HAS_MMU2
     mmu2.init();
+    BOOT_PHASE("mmu2");
+  #endif
+
+  #if ENABLED(TOOLBOARD)
+    toolboard.init();
+  #endif
+
+  #if ENABLED(NET_BRIDGE)
+    netbridge.init();
+  #endif
+
+  BOOT_PHASE("setup");
+
+  #if ENABLED(FAST_BOOT)
+    boot_step = BOOT_SD_MOUNT;
+  #elif ENABLED(BOOT_TIMELINE)
+    boot_done = true;
+    boot_report();
+  #endif
+
+  #if ENABLED(RTOS_TASKS)
+    rtos.start();
   #endif
 
 }
@@ -296,6 +422,10 @@ void Printer::loop() {
       if (card.isAbortSDprinting()) abort_sd_printing();
     #endif // HAS_SD_SUPPORT
 
+    #if ENABLED(SD_JOB_QUEUE)
+      jobqueue.spin();
+    #endif
+
     commands.advance_queue();
     endstops.report_state();
 
@@ -323,6 +453,9 @@ void Printer::check_periodical_actions() {
   planner.check_axes_activity();
 
   if (!isSuspendAutoreport() && isAutoreportTemp()) {
+    #if ENABLED(HOST_OK_COALESCE)
+      commands.flush_ok();  // Held replies go out in the same burst of the report
+    #endif
     #if HAS_HEATER
       tempManager.report_temperatures();
     #endif
@@ -343,14 +476,19 @@ void Printer::check_periodical_actions() {
     #endif
   }
 
-  fanManager.spin();
+  // With the scheduler these run in the main loop
+  #if DISABLED(IDLE_SCHEDULER)
 
-  #if HAS_POWER_SWITCH
-    powerManager.spin();
-  #endif
+    fanManager.spin();
+
+    #if HAS_POWER_SWITCH
+      powerManager.spin();
+    #endif
+
+    #if ENABLED(FLOWMETER_SENSOR)
+      flowmeter.spin();
+    #endif
 
-  #if ENABLED(FLOWMETER_SENSOR)
-    flowmeter.spin();
   #endif
 
 }
@@ -377,6 +515,10 @@ void Printer::kill(PGM_P const lcd_msg/*=nullptr*/, const bool steppers_off/*=fa
 
   SERIAL_LM(ER, MSG_HOST_ERR_KILLED);
 
+  #if ENABLED(RTOS_TASKS)
+    rtos.stop();    // The kill screen goes to the display directly
+  #endif
+
   #if HAS_LCD
     lcdui.kill_screen(lcd_msg ? lcd_msg : GET_TEXT(MSG_KILLED));
   #else
@@ -514,19 +656,43 @@ void Printer::zero_fan_speed() {
  */
 void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
 
-  #if ENABLED(SPI_ENDSTOPS)
+  IDLE_PROFILE_BEGIN();
+
+  #if ENABLED(FAST_BOOT)
+    if (boot_step < BOOT_DONE) boot_spin();
+  #endif
+
+  #if HAS_ACCELEROMETER
+    accelerometer.spin();   // First, the FIFO of the chip is short
+  #endif
+
+  #if ENABLED(STEP_QUEUE)
+    stepQueue.fill();       // The steps for the Stepper ISR
+  #endif
+
+  #if ENABLED(STEP_COPROCESSOR)
+    coprocessor.spin();     // The blocks for the coprocessor
+  #endif
+
+  #if ENABLED(SEGMENT_MERGE)
+    planner.merge_check();  // The move held back, before the buffer runs low
+  #endif
+
+  #if ENABLED(SPI_ENDSTOPS) && DISABLED(SPI_ENDSTOPS_POLL_MS)
     if (endstops.tmc_spi_homing.any
       #if ENABLED(IMPROVE_HOMING_RELIABILITY)
         && ELAPSED(millis(), tmc.sg_guard_period)
       #endif
     ) {
-      for (uint8_t i = 4; i--;) // Read SGT 4 times per idle loop
-        if (endstops.tmc_spi_homing_check()) break;
+      #if ENABLED(TMC_SPI_BATCH)
+        endstops.tmc_spi_homing_check();  // Read SGT 4 times per idle loop, in one batch
+      #else
+        for (uint8_t i = 4; i--;) // Read SGT 4 times per idle loop
+          if (endstops.tmc_spi_homing_check()) break;
+      #endif
     }
   #endif
 
-  lcdui.update();
-
   #if HAS_POWER_CHECK
     powerManager.outage();
   #endif
@@ -538,39 +704,61 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
   // Tick timer job counter
   print_job_counter.tick();
 
-  commands.get_available();
+  #if ENABLED(SD_WRITE_BEHIND)
+    if (card.write_behind_pending()) card.write_behind_spin();
+  #endif
 
-  handle_safety_watch();
+  #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+    card.usb_task();
+  #endif
 
-  if (max_inactivity_timer.expired(max_inactive_time * 1000)) {
-    SERIAL_LMT(ER, MSG_HOST_KILL_INACTIVE_TIME, parser.command_ptr);
-    kill(GET_TEXT(MSG_KILLED));
-  }
+  #if HAS_SD_SUPPORT && ENABLED(JSON_OUTPUT)
+    if (card.scan_pending()) card.scan_spin();
+  #endif
 
-  sound.spin();
+  #if ENABLED(ADAPTIVE_MULTISTEPPING)
+    stepper.adapt_multistepping();
+  #endif
 
-  #if HAS_MAX31855 || HAS_MAX6675
-    tempManager.getTemperature_SPI();
+  #if ENABLED(REALTIME_COMMANDS)
+    emergency_parser.spin();  // The overrides received by the serial ISR
   #endif
 
-  #if HAS_DHT
-    dhtsensor.spin();
+  #if ENABLED(REALTIME_POSITION_REPORT)
+    if (autoreport_position_timer.expired(autoreport_position_ms) && !isSuspendAutoreport())
+      mechanics.report_realtime_position();
   #endif
 
-  #if ENABLED(CNCROUTER)
-    cnc.manage();
+  #if ENABLED(BINARY_STATUS_REPORT)
+    binary_status.spin();
   #endif
 
-  #if HAS_FILAMENT_SENSOR
-    filamentrunout.spin();
+  #if ENABLED(NEOPIXEL_DMA)
+    neopixel.spin();          // The frame shown while the previous one was sent
   #endif
 
-  #if ENABLED(RFID_MODULE)
-    rfid522.spin();
+  #if ENABLED(PCF8574_EXPANSION_IO)
+    pcf8574.spin();           // One I2C write of the outputs, one read of the inputs
   #endif
 
-  #if ENABLED(BABYSTEPPING)
-    babystep.spin();
+  IDLE_PROFILE_START(IDLE_SAFETY, safety_us);
+  handle_safety_watch();
+
+  if (max_inactivity_timer.expired(max_inactive_time * 1000)) {
+    SERIAL_LMT(ER, MSG_HOST_KILL_INACTIVE_TIME, parser.command_ptr);
+    kill(GET_TEXT(MSG_KILLED));
+  }
+  IDLE_PROFILE_END(IDLE_SAFETY, safety_us);
+
+  #if ENABLED(IDLE_SCHEDULER)
+    // LCD, commands, sound, sensors... each at its period
+    scheduler.spin();
+  #else
+    IDLE_PROFILE_START(IDLE_COMMANDS, commands_us);
+    commands.get_available();
+    IDLE_PROFILE_END(IDLE_COMMANDS, commands_us);
+
+    spin_tasks();
   #endif
 
   // Prevent steppers timing-out in the middle of M600
@@ -580,6 +768,17 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
     #define MOVE_AWAY_TEST true
   #endif
 
+  IDLE_PROFILE_START(IDLE_STEPPERS, steppers_us);
+
+  #if ENABLED(TMC_IDLE_CURRENT)
+    // Idle current after a while without moves, the planner writes back the run current
+    static long_timer_t idle_current_timer(millis());
+    if (planner.has_blocks_queued())
+      idle_current_timer.start();
+    else if (idle_current_timer.expired((TMC_IDLE_CURRENT_DELAY) * 1000UL, false))
+      tmc.set_idle_current(true);
+  #endif
+
   if (move_time) {
     static bool already_shutdown_steppers; // = false
     if (planner.has_blocks_queued())
@@ -610,6 +809,9 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
           if (laser.time / 60000 > 0) {
             laser.lifetime += laser.time / 60000; // convert to minutes
             laser.time = 0;
+            #if ENABLED(EEPROM_JOURNAL_SIZE)
+              journal.write(JOURNAL_LASER_LIFETIME, &laser.lifetime, sizeof(laser.lifetime));
+            #endif
           }
           laser.extinguish();
           #if ENABLED(LASER_PERIPHERALS)
@@ -621,6 +823,7 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
     else
       already_shutdown_steppers = false;
   }
+  IDLE_PROFILE_END(IDLE_STEPPERS, steppers_us);
 
   #if HAS_CHDK // Check if pin should be set to LOW (after M240 set it HIGH)
     if (chdk_timer.expired(PHOTO_SWITCH_MS)) WRITE(CHDK_PIN, LOW);
@@ -693,19 +896,110 @@ void Printer::idle(const bool ignore_stepper_queue/*=false*/) {
     }
   #endif
 
+  #if ENABLED(TOOL_CHANGE_PREHEAT)
+    toolManager.preheat_lookahead();
+  #endif
+
   #if ENABLED(TEMP_STAT_LEDS)
     handle_status_leds();
   #endif
 
+  IDLE_PROFILE_FINISH();
+
+  #if ENABLED(RTOS_TASKS)
+    rtos.yield();   // The UI task runs while this one waits
+  #endif
+
+  #if ENABLED(CRASH_RECORD)
+    crashRecord.idle_end();
+  #endif
+
+  watchdog.reset();
+
+}
+
+/**
+ * The tasks of the idle loop that are not time critical
+ */
+void Printer::spin_tasks() {
+
+  IDLE_PROFILE_START(IDLE_LCD, lcd_us);
+  SPI_ENDSTOPS_HOLD(true);
+  lcdui.update();
+  SPI_ENDSTOPS_HOLD(false);
+  IDLE_PROFILE_END(IDLE_LCD, lcd_us);
+
+  #if !HAS_TONE_ISR
+    IDLE_PROFILE_START(IDLE_SOUND, sound_us);
+    sound.spin();
+    IDLE_PROFILE_END(IDLE_SOUND, sound_us);
+  #endif
+
+  IDLE_PROFILE_START(IDLE_SENSORS, sensors_us);
+  #if HAS_MAX31855 || HAS_MAX6675
+    SPI_ENDSTOPS_HOLD(true);
+    tempManager.getTemperature_SPI();
+    SPI_ENDSTOPS_HOLD(false);
+  #endif
+
+  #if HAS_DHT
+    dhtsensor.spin();
+  #endif
+  IDLE_PROFILE_END(IDLE_SENSORS, sensors_us);
+
+  #if ENABLED(CNCROUTER)
+    IDLE_PROFILE_START(IDLE_CNC, cnc_us);
+    cnc.manage();
+    IDLE_PROFILE_END(IDLE_CNC, cnc_us);
+  #endif
+
+  #if HAS_FILAMENT_SENSOR
+    IDLE_PROFILE_START(IDLE_RUNOUT, runout_us);
+    filamentrunout.spin();
+    IDLE_PROFILE_END(IDLE_RUNOUT, runout_us);
+  #endif
+
+  #if ENABLED(RFID_MODULE)
+    IDLE_PROFILE_START(IDLE_RFID, rfid_us);
+    rfid522.spin();
+    IDLE_PROFILE_END(IDLE_RFID, rfid_us);
+  #endif
+
+  #if ENABLED(BABYSTEPPING)
+    IDLE_PROFILE_START(IDLE_BABYSTEP, babystep_us);
+    babystep.spin();
+    IDLE_PROFILE_END(IDLE_BABYSTEP, babystep_us);
+  #endif
+
   #if ENABLED(MONITOR_DRIVER_STATUS)
+    IDLE_PROFILE_START(IDLE_TMC, tmc_us);
+    SPI_ENDSTOPS_HOLD(true);
     tmc.monitor_drivers();
+    SPI_ENDSTOPS_HOLD(false);
+    IDLE_PROFILE_END(IDLE_TMC, tmc_us);
+  #endif
+
+  #if ENABLED(THERMAL_THROTTLE)
+    thermalthrottle.spin();
   #endif
 
   #if HAS_MMU2
+    IDLE_PROFILE_START(IDLE_MMU2, mmu2_us);
     mmu2.mmu_loop();
+    IDLE_PROFILE_END(IDLE_MMU2, mmu2_us);
   #endif
 
-  watchdog.reset();
+  #if ENABLED(TOOLBOARD)
+    toolboard.spin();
+  #endif
+
+  #if ENABLED(NET_BRIDGE)
+    netbridge.spin();
+  #endif
+
+  #if ENABLED(DLP_LAYER_CYCLE)
+    dlpcycle.spin();
+  #endif
 
 }
 
@@ -756,17 +1050,20 @@ void Printer::print_M353() {
     // Stop printer job timer
     print_job_counter.stop();
 
+    // Disabled Heaters and Fan, they cool while the head goes home
+    tempManager.disable_all_heaters();
+    zero_fan_speed();
+    setWaitForHeatUp(false);
+
+    // Drop the moves still in the planner, the home does not wait them
+    quickstop_stepper();
+
     // Auto home
     #if Z_HOME_DIR > 0
       mechanics.home();
     #else
       mechanics.home(HOME_X | HOME_Y);
     #endif
-
-    // Disabled Heaters and Fan
-    tempManager.disable_all_heaters();
-    zero_fan_speed();
-    setWaitForHeatUp(false);
   }
 
 #endif
@@ -907,6 +1204,77 @@ void Printer::handle_safety_watch() {
   }
 }
 
+#if ENABLED(FAST_BOOT)
+
+  /**
+   * An init step left by the setup for each idle, then the boot times
+   */
+  void Printer::boot_spin() {
+    const uint8_t step = boot_step++;   // The step may call idle
+    boot_last = millis();
+
+    switch (step) {
+      #if HAS_SD_SUPPORT && !HAS_EEPROM_SD
+        case BOOT_SD_MOUNT: card.mount(); BOOT_PHASE("sd"); break;
+      #endif
+      #if HAS_SD_RESTART
+        case BOOT_SD_RESTART: restart.check(); BOOT_PHASE("restart"); break;
+      #endif
+      #if HAS_TRINAMIC && !PS_DEFAULT_OFF
+        case BOOT_TMC_TEST: tmc.test_connection(true, true, true, true); BOOT_PHASE("tmc"); break;
+      #endif
+      default: break;
+    }
+
+    if (boot_step == BOOT_DONE) {
+      boot_done = true;
+      boot_report();
+    }
+  }
+
+#endif
+
+#if HAS_BOOT_TIMELINE
+
+  /**
+   * End of a boot phase. Only the phases up to the end of the boot are taken,
+   * the same code runs again later (M501, M502...)
+   */
+  void Printer::boot_phase(PGM_P const name) {
+    if (boot_done) return;
+    const millis_l now = millis();
+    if (boot_times < COUNT(boot_time)) {
+      boot_time[boot_times].name = name;
+      boot_time[boot_times].at = now;
+      boot_time[boot_times].ms = now - boot_last;
+      boot_times++;
+    }
+    boot_last = now;
+  }
+
+  void Printer::boot_report() {
+    #if ENABLED(BOOT_TIMELINE)
+      LOOP_L_N(i, boot_times) {
+        SERIAL_SM(ECHO, "Boot ");
+        SERIAL_STR(boot_time[i].name);
+        SERIAL_MV(" at:", boot_time[i].at);
+        SERIAL_EMV(" ms:", boot_time[i].ms);
+      }
+    #else
+      SERIAL_STR(ECHO);
+      SERIAL_MSG("Boot ms");
+      LOOP_L_N(i, boot_times) {
+        SERIAL_CHR(' ');
+        SERIAL_STR(boot_time[i].name);
+        SERIAL_MV(":", boot_time[i].ms);
+      }
+      SERIAL_EOL();
+    #endif
+    if (!boot_done) SERIAL_LM(ECHO, "Boot running");
+  }
+
+#endif
+
 #if ENABLED(HOST_KEEPALIVE_FEATURE)
 
   /**
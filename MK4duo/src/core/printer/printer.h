@@ -109,6 +109,15 @@ class Printer {
       static short_timer_t chdk_timer;
     #endif
 
+    #if ENABLED(FAST_BOOT)
+      static uint8_t boot_step;     // Next init step after the setup
+    #endif
+
+    #if ENABLED(REALTIME_POSITION_REPORT)
+      static millis_s       autoreport_position_ms;   // M154, 0 for none
+      static short_timer_t  autoreport_position_timer;
+    #endif
+
   public: /** Public Function */
 
     static void setup();  // Main setup
@@ -129,6 +138,7 @@ class Printer {
     static void zero_fan_speed();
 
     static void idle(const bool ignore_stepper_queue=false);
+    static void spin_tasks();
 
     static bool isPrinting();
     static bool isPaused();
@@ -137,6 +147,11 @@ class Printer {
 
     static void print_M353();
 
+    #if HAS_BOOT_TIMELINE
+      static void boot_phase(PGM_P const name);
+      static void boot_report();
+    #endif
+
     #if HAS_SD_SUPPORT
       static void abort_sd_printing();
     #endif
@@ -216,6 +231,10 @@ class Printer {
 
     static void handle_safety_watch();
 
+    #if ENABLED(FAST_BOOT)
+      static void boot_spin();
+    #endif
+
     #if ENABLED(HOST_KEEPALIVE_FEATURE)
       static void host_keepalive_tick();
     #endif
@@ -227,3 +246,9 @@ class Printer {
 };
 
 extern Printer printer;
+
+#if HAS_BOOT_TIMELINE
+  #define BOOT_PHASE(N) printer.boot_phase(PSTR(N))
+#else
+  #define BOOT_PHASE(N) NOOP
+#endif
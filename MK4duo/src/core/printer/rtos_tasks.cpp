@@ -0,0 +1,164 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * rtos_tasks.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(RTOS_TASKS)
+
+#if ENABLED(ARDUINO_ARCH_SAM)
+  #include <FreeRTOS_ARM.h>
+#elif ENABLED(ARDUINO_ARCH_STM32)
+  #include <STM32FreeRTOS.h>
+#endif
+
+#if HAS_GRAPHICAL_LCD
+  #include "../../lcd/ultralcd/dogm/ultralcd_dogm.h"
+  #include "../../lcd/ultralcd/dogm/HAL_LCD_com_defines.h"
+#endif
+
+RtosTasks rtos;
+
+static TaskHandle_t motion_handle;
+
+#if HAS_GRAPHICAL_LCD
+
+  #define DISPLAY_CHUNK 16    // Bytes of a write in a message, the longer ones are split
+
+  typedef struct {
+    uint8_t msg, arg_val,
+            data[DISPLAY_CHUNK];
+  } display_msg_t;
+
+  static QueueHandle_t  display_queue;          // nullptr with the display direct
+  static u8g_com_fnptr  display_com;            // The com function of the display
+  static volatile bool  display_direct = false;
+
+  // A display with its own pins, the SPI and I2C bus are used by the motion task too
+  static bool display_own_pins(const u8g_com_fnptr fn) {
+    return fn == U8G_COM_HAL_SW_SPI_FN || fn == U8G_COM_ST7920_HAL_SW_SPI;
+  }
+
+  static void display_send(display_msg_t &m) {
+    display_com(u8g.getU8g(), m.msg, m.arg_val, m.msg == U8G_COM_MSG_WRITE_SEQ ? m.data : nullptr);
+  }
+
+  static void display_put(const uint8_t msg, const uint8_t arg_val, const uint8_t * const data=nullptr) {
+    display_msg_t m;
+    m.msg = msg;
+    m.arg_val = arg_val;
+    if (data) memcpy(m.data, data, arg_val);
+    xQueueSend(display_queue, &m, portMAX_DELAY);
+  }
+
+  // The com function of the display for the motion task, the messages go to the UI task
+  static uint8_t display_defer(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr) {
+    if (display_direct) return display_com(u8g, msg, arg_val, arg_ptr);
+    if (msg == U8G_COM_MSG_WRITE_SEQ || msg == U8G_COM_MSG_WRITE_SEQ_P) {
+      // The program memory is in the address space on ARM, both are copied
+      const uint8_t *p = (const uint8_t*)arg_ptr;
+      while (arg_val) {
+        const uint8_t n = MIN(arg_val, DISPLAY_CHUNK);
+        display_put(U8G_COM_MSG_WRITE_SEQ, n, p);
+        p += n;
+        arg_val -= n;
+      }
+    }
+    else
+      display_put(msg, arg_val);
+    return 1;
+  }
+
+#endif // HAS_GRAPHICAL_LCD
+
+/** Public Function */
+void RtosTasks::start() {
+
+  #if HAS_GRAPHICAL_LCD
+    u8g_dev_t * const dev = u8g.getU8g()->dev;
+    if (display_own_pins(dev->com_fn)) {
+      display_queue = xQueueCreate(RTOS_DISPLAY_QUEUE, sizeof(display_msg_t));
+      if (display_queue && xTaskCreate(ui_task, "UI", RTOS_UI_STACK, nullptr, tskIDLE_PRIORITY + 1, nullptr) != pdPASS) {
+        vQueueDelete(display_queue);
+        display_queue = nullptr;
+      }
+      if (display_queue) {
+        display_com = dev->com_fn;
+        dev->com_fn = display_defer;
+      }
+    }
+  #endif
+
+  xTaskCreate(motion_task, "Motion", RTOS_MOTION_STACK, nullptr, tskIDLE_PRIORITY + 2, &motion_handle);
+
+  vTaskStartScheduler();
+
+  // Only with no memory for the tasks
+  SERIAL_LM(ER, "RTOS start failed");
+  printer.kill();
+}
+
+void RtosTasks::stop() {
+  #if HAS_GRAPHICAL_LCD
+    if (!display_queue || display_direct) return;
+    display_direct = true;
+    display_msg_t m;
+    while (xQueueReceiveFromISR(display_queue, &m, nullptr)) display_send(m);
+  #endif
+}
+
+void RtosTasks::yield() {
+  if (!motion_handle) return;   // From setup(), before the scheduler
+  // The motion task keeps the CPU while the planner has room and a
+  // command is ready, it waits a tick for the display and for the host
+  #if HAS_GRAPHICAL_LCD
+    const bool display_wait = !display_ready();
+  #else
+    constexpr bool display_wait = false;
+  #endif
+  if (display_wait || planner.is_full() || commands.buffer_ring.isEmpty()) vTaskDelay(1);
+}
+
+#if HAS_GRAPHICAL_LCD
+  bool RtosTasks::display_ready() { return !display_queue || !uxQueueMessagesWaiting(display_queue); }
+#endif
+
+/** Private Function */
+void RtosTasks::motion_task(void*) {
+  for (;;) printer.loop();
+}
+
+#if HAS_GRAPHICAL_LCD
+
+  void RtosTasks::ui_task(void*) {
+    display_msg_t m;
+    for (;;) if (xQueueReceive(display_queue, &m, portMAX_DELAY)) display_send(m);
+  }
+
+#endif
+
+#endif // ENABLED(RTOS_TASKS)
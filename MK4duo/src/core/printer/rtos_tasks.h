@@ -0,0 +1,87 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * rtos_tasks.h
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(RTOS_TASKS)
+
+/**
+ * The RTOS build, with the FreeRTOS library of the core
+ * (FreeRTOS_ARM for DUE, STM32duino FreeRTOS for STM32).
+ *
+ *  Motion    Printer::loop(), the commands, the host and SD intake,
+ *            the planner and the LCD menus, as in the single loop
+ *  UI        Sends the pages of the graphical display
+ *
+ * The heaters stay in the HAL tick, out of the tasks.
+ *
+ * The two tasks share only the display queue: the motion task draws a page
+ * and queues the messages of the display, the UI task sends them, and the
+ * next page is drawn when the queue is empty. The firmware state is in one
+ * task and needs no lock, and a slow display can not delay the planning.
+ * Only a display with its own pins (software SPI) goes to the UI task,
+ * one on the SPI or I2C bus of the SD and of the drivers stays direct.
+ */
+class RtosTasks {
+
+  public: /** Constructor */
+
+    RtosTasks() {}
+
+  public: /** Public Function */
+
+    static void start();  // Create the tasks and start the scheduler, never returns
+
+    /**
+     * The display direct again, for the kill screen.
+     * The queued messages are sent first, also from an interrupt.
+     */
+    static void stop();
+
+    /**
+     * From idle(): sleep a tick when there is nothing to plan
+     * or the display waits, so the UI task runs
+     */
+    static void yield();
+
+    #if HAS_GRAPHICAL_LCD
+      static bool display_ready();  // The last page is sent
+    #endif
+
+  private: /** Private Function */
+
+    static void motion_task(void*);
+
+    #if HAS_GRAPHICAL_LCD
+      static void ui_task(void*);
+    #endif
+
+};
+
+extern RtosTasks rtos;
+
+#endif // ENABLED(RTOS_TASKS)
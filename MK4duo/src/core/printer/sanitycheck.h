@@ -58,6 +58,10 @@
   #endif
 #endif
 
+#if ENABLED(SERVO_HARDWARE_PWM) && DISABLED(ARDUINO_ARCH_STM32) && DISABLED(ARDUINO_ARCH_SAMD)
+  #error "DEPENDENCY ERROR: SERVO_HARDWARE_PWM requires a STM32 or SAMD board."
+#endif
+
 // Limited number of servos
 #if NUM_SERVOS > 4
   #error "DEPENDENCY ERROR: The maximum number of SERVOS in MK4duo is 4."
@@ -66,6 +70,9 @@
   #if NUM_SERVOS < 1
     #error "DEPENDENCY ERROR: NUM_SERVOS has to be at least one if you enable ENABLE_SERVOS."
   #endif
+  #if ENABLED(ARDUINO_ARCH_SAMD) && DISABLED(SERVO_HARDWARE_PWM)
+    #error "DEPENDENCY ERROR: The servos on SAMD require SERVO_HARDWARE_PWM."
+  #endif
   #if Z_PROBE_SERVO_NR >= 0
     #if Z_PROBE_SERVO_NR >= NUM_SERVOS
       #error "DEPENDENCY ERROR: Z_PROBE_SERVO_NR must be smaller than NUM_SERVOS."
@@ -112,18 +119,92 @@
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "DEPENDENCY ERROR: BLOCK_BUFFER_SIZE must be a power of 2."
 #endif
+#if BLOCK_BUFFER_SIZE > 128
+  #error "DEPENDENCY ERROR: BLOCK_BUFFER_SIZE must be 128 or less."
+#endif
 #if DISABLED(MAX_CMD_SIZE)
   #error "DEPENDENCY ERROR: Missing setting MAX_CMD_SIZE."
 #endif
 #if DISABLED(BUFSIZE)
   #error "DEPENDENCY ERROR: Missing setting BUFSIZE."
 #endif
+#if !IS_POWER_OF_2(BUFSIZE) || BUFSIZE > 128
+  #error "DEPENDENCY ERROR: BUFSIZE must be a power of 2 up to 128."
+#endif
+#if ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 >= -1
+  #if DISABLED(SERIAL_PORT_2_HEADROOM)
+    #error "DEPENDENCY ERROR: Missing setting SERIAL_PORT_2_HEADROOM."
+  #elif SERIAL_PORT_2_HEADROOM >= BUFSIZE
+    #error "DEPENDENCY ERROR: SERIAL_PORT_2_HEADROOM must be less than BUFSIZE."
+  #endif
+#endif
+#if ENABLED(BUFFER_ARENA)
+  #if DISABLED(CPU_32_BIT)
+    #error "DEPENDENCY ERROR: BUFFER_ARENA requires a 32 bit board."
+  #elif DISABLED(BUFFER_ARENA_SIZE)
+    #error "DEPENDENCY ERROR: Missing setting BUFFER_ARENA_SIZE."
+  #elif ENABLED(LASER_RASTER_BINARY)
+    #error "DEPENDENCY ERROR: BUFFER_ARENA is not compatible with LASER_RASTER_BINARY."
+  #endif
+#endif
+#if HAS_COMPACT_GCODE
+  #if DISABLED(FASTER_GCODE_PARSER)
+    #error "DEPENDENCY ERROR: BINARY_GCODE_PROTOCOL, GCODE_PARSE_ON_ENQUEUE and SD_COMPILED_JOB require FASTER_GCODE_PARSER."
+  #elif MAX_CMD_SIZE < 41
+    #error "DEPENDENCY ERROR: BINARY_GCODE_PROTOCOL, GCODE_PARSE_ON_ENQUEUE and SD_COMPILED_JOB require MAX_CMD_SIZE of 41 or more."
+  #endif
+#endif
 #if ENABLED(SERIAL_XON_XOFF) && RX_BUFFER_SIZE < 1024
   #error "DEPENDENCY ERROR: For SERIAL_XON_XOFF set RX_BUFFER_SIZE to 1024 or more."
 #endif
+#if ENABLED(HOST_OK_COALESCE)
+  #if ENABLED(ADVANCED_OK)
+    #error "DEPENDENCY ERROR: HOST_OK_COALESCE and ADVANCED_OK are incompatible."
+  #elif (ENABLED(__AVR__) || ENABLED(ARDUINO_ARCH_SAM)) && TX_BUFFER_SIZE < 4
+    #error "DEPENDENCY ERROR: HOST_OK_COALESCE requires TX_BUFFER_SIZE of 4 or more."
+  #endif
+#endif
+#if ENABLED(SERIAL_RX_DMA)
+  #if DISABLED(ARDUINO_ARCH_SAM)
+    #error "DEPENDENCY ERROR: SERIAL_RX_DMA is only available on Arduino DUE."
+  #elif ENABLED(EMERGENCY_PARSER) || ENABLED(SERIAL_XON_XOFF)
+    #error "DEPENDENCY ERROR: SERIAL_RX_DMA is incompatible with EMERGENCY_PARSER and SERIAL_XON_XOFF."
+  #endif
+#endif
+#if ENABLED(SERIAL_BULK_READ) && !WITHIN(SERIAL_BULK_READ_SIZE, 1, 255)
+  #error "DEPENDENCY ERROR: SERIAL_BULK_READ_SIZE must be from 1 to 255."
+#endif
+#if ENABLED(SERIAL_RESEND_WINDOW) && (!IS_POWER_OF_2(SERIAL_RESEND_WINDOW) || !WITHIN(SERIAL_RESEND_WINDOW, 2, 64))
+  #error "DEPENDENCY ERROR: SERIAL_RESEND_WINDOW must be a power of 2 from 2 to 64."
+#endif
 #if !IS_POWER_OF_2(RX_BUFFER_SIZE) || RX_BUFFER_SIZE < 2
   #error "RX_BUFFER_SIZE must be a power of 2 greater than 1."
 #endif
 #if TX_BUFFER_SIZE && (TX_BUFFER_SIZE < 2 || TX_BUFFER_SIZE > 256 || !IS_POWER_OF_2(TX_BUFFER_SIZE))
   #error "TX_BUFFER_SIZE must be 0 or a power of 2 greater than 1."
 #endif
+
+// Crash record
+#if ENABLED(CRASH_RECORD)
+  #if DISABLED(CRASH_RECORD_COMMANDS) || DISABLED(CRASH_RECORD_LENGTH)
+    #error "DEPENDENCY ERROR: Missing setting CRASH_RECORD_COMMANDS or CRASH_RECORD_LENGTH."
+  #elif !WITHIN(CRASH_RECORD_COMMANDS, 1, 16)
+    #error "DEPENDENCY ERROR: CRASH_RECORD_COMMANDS must be from 1 to 16."
+  #elif !WITHIN(CRASH_RECORD_LENGTH, 8, MAX_CMD_SIZE)
+    #error "DEPENDENCY ERROR: CRASH_RECORD_LENGTH must be from 8 to MAX_CMD_SIZE."
+  #endif
+#endif
+
+// Idle scheduler and RTOS tasks
+#if ENABLED(IDLE_SCHEDULER) && DISABLED(IDLE_SCHEDULER_BUDGET_US)
+  #error "DEPENDENCY ERROR: Missing setting IDLE_SCHEDULER_BUDGET_US."
+#endif
+#if ENABLED(RTOS_TASKS)
+  #if DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_STM32)
+    #error "DEPENDENCY ERROR: RTOS_TASKS is only available on Arduino DUE and STM32."
+  #elif ENABLED(IDLE_SCHEDULER)
+    #error "DEPENDENCY ERROR: RTOS_TASKS is incompatible with IDLE_SCHEDULER."
+  #elif DISABLED(RTOS_MOTION_STACK) || DISABLED(RTOS_UI_STACK) || DISABLED(RTOS_DISPLAY_QUEUE)
+    #error "DEPENDENCY ERROR: Missing setting RTOS_MOTION_STACK, RTOS_UI_STACK or RTOS_DISPLAY_QUEUE."
+  #endif
+#endif
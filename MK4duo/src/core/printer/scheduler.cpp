@@ -0,0 +1,214 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * scheduler.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(IDLE_SCHEDULER)
+
+Scheduler scheduler;
+
+/**
+ * The tasks
+ */
+static void task_commands()   { commands.get_available(); }
+static void task_fans()       { fanManager.spin(); }
+static void task_lcd() {
+  SPI_ENDSTOPS_HOLD(true);
+  lcdui.update();
+  SPI_ENDSTOPS_HOLD(false);
+}
+
+static const char name_commands[] PROGMEM = "Commands",
+                  name_fans[]     PROGMEM = "Fans",
+                  name_lcd[]      PROGMEM = "LCD";
+
+#if !HAS_TONE_ISR
+  static void task_sound() { sound.spin(); }
+  static const char name_sound[] PROGMEM = "Sound";
+#endif
+#if ENABLED(BABYSTEPPING)
+  static void task_babystep() { babystep.spin(); }
+  static const char name_babystep[] PROGMEM = "Babystep";
+#endif
+#if ENABLED(CNCROUTER)
+  static void task_cnc() { cnc.manage(); }
+  static const char name_cnc[] PROGMEM = "CNC";
+#endif
+#if HAS_MAX31855 || HAS_MAX6675
+  static void task_sensors() {
+    SPI_ENDSTOPS_HOLD(true);
+    tempManager.getTemperature_SPI();
+    SPI_ENDSTOPS_HOLD(false);
+  }
+  static const char name_sensors[] PROGMEM = "Sensors";
+#endif
+#if HAS_FILAMENT_SENSOR
+  static void task_runout() { filamentrunout.spin(); }
+  static const char name_runout[] PROGMEM = "Runout";
+#endif
+#if HAS_MMU2
+  static void task_mmu2() { mmu2.mmu_loop(); }
+  static const char name_mmu2[] PROGMEM = "MMU2";
+#endif
+#if HAS_DHT
+  static void task_dht() { dhtsensor.spin(); }
+  static const char name_dht[] PROGMEM = "DHT";
+#endif
+#if ENABLED(MONITOR_DRIVER_STATUS)
+  static void task_tmc() {
+    SPI_ENDSTOPS_HOLD(true);
+    tmc.monitor_drivers();
+    SPI_ENDSTOPS_HOLD(false);
+  }
+  static const char name_tmc[] PROGMEM = "TMC";
+#endif
+#if ENABLED(RFID_MODULE)
+  static void task_rfid() { rfid522.spin(); }
+  static const char name_rfid[] PROGMEM = "RFID";
+#endif
+#if HAS_POWER_SWITCH
+  static void task_power() { powerManager.spin(); }
+  static const char name_power[] PROGMEM = "Power";
+#endif
+#if ENABLED(FLOWMETER_SENSOR)
+  static void task_flowmeter() { flowmeter.spin(); }
+  static const char name_flowmeter[] PROGMEM = "Flowmeter";
+#endif
+
+/**
+ * The table, in the order of the priority.
+ * Commands first, the LCD after the time critical tasks,
+ * the slow sensors and the 1 second tasks last.
+ */
+static const sched_task_t task[] PROGMEM = {
+  // spin           name              period ms   budget us   deferrable
+  { task_commands,  name_commands,       0,          500,       false },
+  #if ENABLED(BABYSTEPPING)
+    { task_babystep, name_babystep,      0,          100,       false },
+  #endif
+  #if !HAS_TONE_ISR
+    { task_sound,   name_sound,          0,          100,       false },
+  #endif
+  #if ENABLED(CNCROUTER)
+    { task_cnc,     name_cnc,            0,          200,       false },
+  #endif
+  #if HAS_MAX31855 || HAS_MAX6675
+    { task_sensors, name_sensors,       10,          300,       true  },
+  #endif
+  #if HAS_FILAMENT_SENSOR
+    { task_runout,  name_runout,         5,          200,       true  },
+  #endif
+  #if HAS_MMU2
+    { task_mmu2,    name_mmu2,          10,         1000,       true  },
+  #endif
+  { task_lcd,       name_lcd,            0,         5000,       true  },
+  #if HAS_DHT
+    { task_dht,     name_dht,           20,          300,       true  },
+  #endif
+  #if ENABLED(MONITOR_DRIVER_STATUS)
+    { task_tmc,     name_tmc,          100,         2000,       true  },
+  #endif
+  #if ENABLED(RFID_MODULE)
+    { task_rfid,    name_rfid,         100,         2000,       true  },
+  #endif
+  { task_fans,      name_fans,        1000,          500,       true  },
+  #if HAS_POWER_SWITCH
+    { task_power,   name_power,       1000,          100,       true  },
+  #endif
+  #if ENABLED(FLOWMETER_SENSOR)
+    { task_flowmeter, name_flowmeter, 1000,          100,       true  },
+  #endif
+};
+
+static constexpr uint8_t task_count = COUNT(task);
+
+static sched_state_t state[task_count];
+
+/** Public Function */
+void Scheduler::init() {
+  const millis_l now = millis();
+  for (uint8_t i = 0; i < task_count; i++) state[i].next_ms = now;
+  reset();
+}
+
+void Scheduler::spin() {
+
+  const uint32_t  start_us  = micros();
+  const millis_l  now       = millis();
+
+  for (uint8_t i = 0; i < task_count; i++) {
+    sched_task_t t;
+    memcpy_P(&t, &task[i], sizeof(sched_task_t));
+    sched_state_t &s = state[i];
+
+    if (t.period_ms && PENDING(now, s.next_ms)) continue;
+
+    // Over the idle budget a deferrable task waits, but only once
+    if (t.deferrable && !s.deferred && micros() - start_us > (IDLE_SCHEDULER_BUDGET_US)) {
+      s.deferred = true;
+      s.defers++;
+      continue;
+    }
+    s.deferred = false;
+
+    const uint32_t task_start_us = micros();
+    t.spin();
+    const uint32_t us = micros() - task_start_us;
+
+    if (t.period_ms) s.next_ms = now + t.period_ms;
+    s.runs++;
+    NOLESS(s.max_us, uint16_t(MIN(us, 0xFFFFUL)));
+    if (us > t.budget_us && s.overruns < 0xFFFF) s.overruns++;
+  }
+
+}
+
+void Scheduler::reset() {
+  for (uint8_t i = 0; i < task_count; i++) {
+    state[i].runs = 0;
+    state[i].max_us = state[i].overruns = state[i].defers = 0;
+  }
+}
+
+void Scheduler::print() {
+  SERIAL_LMV(ECHO, "Scheduler idle budget (us):", uint32_t(IDLE_SCHEDULER_BUDGET_US));
+  for (uint8_t i = 0; i < task_count; i++) {
+    sched_task_t t;
+    memcpy_P(&t, &task[i], sizeof(sched_task_t));
+    SERIAL_STR(ECHO);
+    SERIAL_STR(t.name);
+    SERIAL_MV(" period:", t.period_ms);
+    SERIAL_MV(" budget:", t.budget_us);
+    SERIAL_MV(" runs:", state[i].runs);
+    SERIAL_MV(" max:", state[i].max_us);
+    SERIAL_MV(" overruns:", state[i].overruns);
+    SERIAL_EMV(" defers:", state[i].defers);
+  }
+}
+
+#endif // ENABLED(IDLE_SCHEDULER)
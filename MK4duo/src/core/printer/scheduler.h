@@ -0,0 +1,74 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * scheduler.h
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(IDLE_SCHEDULER)
+
+// Struct scheduled task, the table is in PROGMEM
+typedef struct {
+  void      (*spin)();
+  PGM_P     name;
+  uint16_t  period_ms,    // 0 for each idle call
+            budget_us;    // Longest expected run, a longer one is an overrun
+  bool      deferrable;   // Waits for the next idle call when the idle budget is spent
+} sched_task_t;
+
+// Struct scheduled task state and statistics
+typedef struct {
+  millis_l  next_ms;
+  uint32_t  runs;
+  uint16_t  max_us,
+            overruns,
+            defers;
+  bool      deferred;
+} sched_state_t;
+
+class Scheduler {
+
+  public: /** Constructor */
+
+    Scheduler() {}
+
+  public: /** Public Function */
+
+    static void init();
+
+    /**
+     * Run the tasks that are due, in the order of the table,
+     * that is their priority
+     */
+    static void spin();
+
+    static void reset();
+    static void print();
+
+};
+
+extern Scheduler scheduler;
+
+#endif // ENABLED(IDLE_SCHEDULER)
@@ -28,10 +28,16 @@ Sound sound;
 sound_data_t Sound::data;
 
 /** Private Parameters */
-short_timer_t Sound::tone_timer;
+#if HAS_TONE_ISR
+  volatile uint32_t Sound::isr_ticks   = 0;
+  volatile bool     Sound::isr_running = false,
+                    Sound::isr_toggle  = false;
+#else
+  short_timer_t Sound::tone_timer;
+#endif
 
 /** Protected Parameters */
-Circular_Queue<tone_t, TONE_QUEUE_LENGTH> Sound::buffer;
+SPSC_Queue<tone_t, TONE_QUEUE_LENGTH> Sound::buffer;
 
 /** Public Function */
 void Sound::factory_parameters() {
@@ -42,34 +48,96 @@ void Sound::playtone(const uint16_t duration, const uint16_t frequency/*=0*/) {
   if (data.mode == SOUND_MODE_MUTE) return;
   while (buffer.isFull()) printer.idle(true);
   tone_t new_tone = { duration, frequency };
-  buffer.enqueue(new_tone);
+  #if HAS_TONE_ISR
+    // The ISR stops on an empty queue, wake it in the same critical section
+    CRITICAL_SECTION_START
+      buffer.enqueue(new_tone);
+      if (!isr_running) {
+        isr_running = true;
+        isr_ticks = 0;
+        HAL_TONE_TIMER_START(1000);
+      }
+    CRITICAL_SECTION_END
+  #else
+    buffer.enqueue(new_tone);
+  #endif
 }
 
-void Sound::spin() {
+#if HAS_TONE_ISR
 
-  static tone_t play_tone = { 0, 0 };
+  /**
+   * Called by the tone timer. During a tone the speaker toggles at twice
+   * its frequency; a pause, or the tone of a buzzer, counts at 1 kHz.
+   * At the end of a tone the next one of the queue starts.
+   */
+  void Sound::tone_isr() {
 
-  if (!tone_timer.isRunning()) {
-    if (buffer.isEmpty()) return;
+    static bool state = false;
 
-    play_tone = buffer.dequeue();
-    tone_timer.start();
+    if (isr_ticks) {
+      isr_ticks--;
+      if (isr_toggle) WRITE(BEEPER_PIN, (state = !state));
+      return;
+    }
+
+    off();
+    state = false;
 
-    if (play_tone.frequency > 0) {
-      #if ENABLED(LCD_USE_I2C_BUZZER)
-        lcd.buzz(play_tone.duration, play_tone.frequency);
-      #elif ENABLED(SPEAKER)
-        CRITICAL_SECTION_START
-          ::tone(BEEPER_PIN, play_tone.frequency, play_tone.duration);
-        CRITICAL_SECTION_END
-      #elif PIN_EXISTS(BEEPER)
-        on();
-      #endif
+    if (buffer.isEmpty()) {
+      isr_running = false;
+      HAL_TONE_TIMER_STOP();
+      return;
     }
+
+    const tone_t play_tone = buffer.dequeue();
+
+    #if ENABLED(SPEAKER)
+      if (play_tone.frequency > 0) {
+        const uint32_t rate = 2UL * play_tone.frequency;
+        isr_toggle = true;
+        isr_ticks = rate * play_tone.duration / 1000UL;
+        HAL_TONE_TIMER_RATE(rate);
+        return;
+      }
+    #else
+      if (play_tone.frequency > 0) on();
+    #endif
+
+    isr_toggle = false;
+    isr_ticks = play_tone.duration;
+    HAL_TONE_TIMER_RATE(1000);
+
   }
-  else if (tone_timer.expired(play_tone.duration)) reset();
 
-}
+#else
+
+  void Sound::spin() {
+
+    static tone_t play_tone = { 0, 0 };
+
+    if (!tone_timer.isRunning()) {
+      if (buffer.isEmpty()) return;
+
+      play_tone = buffer.dequeue();
+      tone_timer.start();
+
+      if (play_tone.frequency > 0) {
+        #if ENABLED(LCD_USE_I2C_BUZZER)
+          lcd.buzz(play_tone.duration, play_tone.frequency);
+        #elif ENABLED(SPEAKER)
+          CRITICAL_SECTION_START
+            ::tone(BEEPER_PIN, play_tone.frequency, play_tone.duration);
+          CRITICAL_SECTION_END
+        #elif PIN_EXISTS(BEEPER)
+          on();
+        #endif
+      }
+    }
+    else if (tone_timer.expired(play_tone.duration)) reset();
+
+  }
+
+#endif // !HAS_TONE_ISR
 
 void Sound::cyclestate() {
   switch (data.mode) {
@@ -23,6 +23,13 @@
 
 #define TONE_QUEUE_LENGTH 4
 
+// The HAL with a tone timer plays the queue from its ISR, without spin()
+#if ENABLED(HAL_TONE_ISR) && PIN_EXISTS(BEEPER) && DISABLED(LCD_USE_I2C_BUZZER)
+  #define HAS_TONE_ISR  1
+#else
+  #define HAS_TONE_ISR  0
+#endif
+
 // Struct Sound data
 typedef struct {
   SoundModeEnum mode;
@@ -50,11 +57,17 @@ class Sound {
 
   private: /** Private Parameters */
 
-    static short_timer_t tone_timer;
+    #if HAS_TONE_ISR
+      static volatile uint32_t  isr_ticks;    // ISR ticks left in the tone
+      static volatile bool      isr_running,
+                                isr_toggle;   // The ticks toggle the speaker
+    #else
+      static short_timer_t tone_timer;
+    #endif
 
   protected: /** Protected Parameters */
 
-    static Circular_Queue<tone_t, TONE_QUEUE_LENGTH> buffer;
+    static SPSC_Queue<tone_t, TONE_QUEUE_LENGTH> buffer;
 
   protected: /** Protected Function */
 
@@ -68,7 +81,11 @@ class Sound {
 
     static inline void reset() {
       off();
-      tone_timer.stop();
+      #if HAS_TONE_ISR
+        isr_ticks = 0;
+      #else
+        tone_timer.stop();
+      #endif
     }
 
   public: /** Public Function */
@@ -76,7 +93,13 @@ class Sound {
     static void factory_parameters();
 
     static void playtone(const uint16_t duration, const uint16_t freq);
-    static void spin();
+
+    #if HAS_TONE_ISR
+      FORCE_INLINE static void spin() {}
+      static void tone_isr();
+    #else
+      static void spin();
+    #endif
 
     static void cyclestate();
 
@@ -0,0 +1,218 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * step_coprocessor.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(STEP_COPROCESSOR)
+
+#define CP_START          0xA5
+#define CP_QUERY_MS       100     // Heartbeat, the coprocessor stops the motors without it
+#define CP_TIMEOUT_MS     1000    // A coprocessor silent for longer is lost
+#define CP_REPORT_LEN     19
+
+#define CP_CHECK_ENDSTOPS 0       // Segment flag bits
+#define CP_CHECK_PROBE    1
+
+StepCoprocessor coprocessor;
+
+/** Private Parameters */
+uint8_t StepCoprocessor::rx_buffer[24],
+        StepCoprocessor::rx_index     = 0,
+        StepCoprocessor::block_index  = 0,
+        StepCoprocessor::sent         = 0,
+        StepCoprocessor::done         = 0;
+
+bool StepCoprocessor::resync = false;
+
+millis_l StepCoprocessor::report_ms = 0;
+
+short_timer_t StepCoprocessor::query_timer;
+
+// CRC-8 (poly 0x07) of the frame from the command to the end of the payload
+static uint8_t crc8(uint8_t crc, const uint8_t b) {
+  crc ^= b;
+  LOOP_L_N(i, 8) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+  return crc;
+}
+
+/** Public Function */
+void StepCoprocessor::init() {
+  coprocessorSerial.begin(STEP_COPROCESSOR_BAUDRATE);
+  flush();
+  query_timer.start();
+}
+
+void StepCoprocessor::spin() {
+
+  receive();
+
+  // Without the reports the position of the machine is lost
+  if ((in_flight() || resync) && ELAPSED(millis(), report_ms + CP_TIMEOUT_MS)) {
+    if (in_flight()) {
+      SERIAL_LM(ER, "Step coprocessor: no report");
+      printer.kill(PSTR("Step coprocessor lost"));
+      return;
+    }
+    resync = false;
+    SERIAL_LM(ER, "Step coprocessor: no reply to the reset");
+  }
+
+  if (query_timer.expired(CP_QUERY_MS)) send_frame(CP_QUERY, nullptr, 0);
+
+  if (resync) return;
+
+  while (in_flight() < STEP_COPROCESSOR_SLOTS) {
+
+    // The newest block waits while the coprocessor has enough, till then the planner can still raise its exit speed
+    if (BLOCK_MOD(block_index + 1) == planner.block_buffer_head && in_flight() >= 2) return;
+
+    block_t* const b = planner.get_queue_block(block_index);
+    if (!b) return;
+    block_index = BLOCK_MOD(block_index + 1);
+
+    send_block(b);
+  }
+
+}
+
+void StepCoprocessor::flush() {
+  send_frame(CP_RESET, nullptr, 0);
+  sent = done = 0;
+  block_index = planner.block_buffer_tail;
+  resync = true;
+  report_ms = millis();
+}
+
+bool StepCoprocessor::is_block_queued(const block_t* const b) {
+  const uint8_t t = planner.block_buffer_tail;
+  return BLOCK_MOD(uint8_t(b - planner.block_buffer) - t) < BLOCK_MOD(block_index - t);
+}
+
+/** Private Function */
+void StepCoprocessor::send_frame(const CoprocessorFrameEnum cmd, const uint8_t * const payload, const uint8_t len) {
+  uint8_t crc = crc8(crc8(0, cmd), len);
+  coprocessorSerial.write(uint8_t(CP_START));
+  coprocessorSerial.write(uint8_t(cmd));
+  coprocessorSerial.write(len);
+  LOOP_L_N(i, len) {
+    coprocessorSerial.write(payload[i]);
+    crc = crc8(crc, payload[i]);
+  }
+  coprocessorSerial.write(crc);
+}
+
+void StepCoprocessor::send_block(const block_t* const b) {
+
+  // A sync block sets the position of the motors in its turn
+  if (TEST(b->flag, BLOCK_BIT_SYNC_POSITION)) {
+    uint8_t payload[1 + sizeof(b->position)];
+    payload[0] = sent++;
+    memcpy(&payload[1], &b->position, sizeof(b->position));   // All the targets are little endian
+    send_frame(CP_POSITION, payload, sizeof(payload));
+    return;
+  }
+
+  // The coprocessor runs the same trapezoid as the Stepper ISR
+  const uint32_t values[] = {
+    b->steps.a, b->steps.b, b->steps.c, b->steps.e,
+    b->step_event_count,
+    b->initial_rate, b->nominal_rate, b->final_rate,
+    b->acceleration_steps_per_s2,
+    b->accelerate_until, b->decelerate_after
+  };
+
+  // The endstops checked, as the Stepper ISR would at the start of the block
+  uint8_t flags = 0;
+  if (endstops.isEnabled())       SBI(flags, CP_CHECK_ENDSTOPS);
+  if (endstops.isProbeEnabled())  SBI(flags, CP_CHECK_PROBE);
+
+  uint8_t payload[4 + sizeof(values)];
+  payload[0] = sent++;
+  payload[1] = b->direction_bits;
+  payload[2] = flags;
+  payload[3] = b->active_extruder;
+  memcpy(&payload[4], values, sizeof(values));
+  send_frame(CP_SEGMENT, payload, sizeof(payload));
+
+}
+
+/**
+ * Read the reports of the coprocessor:
+ *  A5 'd' 13 <done> <endstops hit> <axes hit> <position x y z e> <crc>
+ *  A5 'z' 13 ... the same, the reply to the reset
+ */
+void StepCoprocessor::receive() {
+
+  while (coprocessorSerial.available()) {
+    const uint8_t c = coprocessorSerial.read();
+
+    if (rx_index == 0 && c != CP_START) continue;   // Wait the start of a frame
+    rx_buffer[rx_index++] = c;
+
+    if (rx_index < 3) continue;                     // Start, command and length
+    const uint8_t len = rx_buffer[2];
+    if (len > sizeof(rx_buffer) - 4) { rx_index = 0; continue; }
+    if (rx_index < len + 4) continue;
+
+    uint8_t crc = 0;
+    LOOP_S_L_N(i, 1, len + 3) crc = crc8(crc, rx_buffer[i]);
+
+    if (crc == rx_buffer[len + 3] && len == CP_REPORT_LEN) {
+      if (rx_buffer[1] == CP_RESET_OK)
+        report(&rx_buffer[3], true);
+      else if (rx_buffer[1] == CP_DONE && !resync)
+        report(&rx_buffer[3], false);
+    }
+
+    rx_index = 0;
+  }
+
+}
+
+void StepCoprocessor::report(const uint8_t * const payload, const bool reset) {
+
+  report_ms = millis();
+
+  if (reset)
+    resync = false;
+  else {
+    // The blocks done leave the planner
+    for (const uint8_t d = payload[0]; done != d && in_flight(); done++) {
+      stepper.coprocessor_block_done(&planner.block_buffer[planner.block_buffer_tail]);
+      planner.discard_current_block();
+    }
+  }
+
+  xyze_long_t pos;
+  memcpy(&pos, &payload[3], sizeof(pos));
+  if (payload[1]) endstops.coprocessor_hit(payload[1]);
+  stepper.coprocessor_sync(pos, payload[2]);
+
+}
+
+#endif // ENABLED(STEP_COPROCESSOR)
@@ -0,0 +1,103 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * step_coprocessor.h
+ *
+ * Split mode. The main MCU parses and plans, the blocks of the planner are
+ * sent on a serial port to a second MCU that runs their trapezoid, the steps,
+ * the directions and the endstops. The second MCU reports the blocks done and
+ * the position of the motors, the blocks stay in the planner till then.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEP_COPROCESSOR)
+
+enum CoprocessorFrameEnum : uint8_t {
+  CP_RESET    = 'R',    // Drop all the segments and stop the motors
+  CP_SEGMENT  = 'S',    // A block of the planner
+  CP_POSITION = 'P',    // A sync block, set the position of the motors
+  CP_QUERY    = 'Q',    // Ask for a report, the heartbeat
+  CP_DONE     = 'd',    // Report: blocks done, endstops hit and position
+  CP_RESET_OK = 'z'     // Report of the reset
+};
+
+class StepCoprocessor {
+
+  public: /** Constructor */
+
+    StepCoprocessor() {}
+
+  private: /** Private Parameters */
+
+    static uint8_t        rx_buffer[24],
+                          rx_index,
+                          block_index,      // The next block to send
+                          sent,             // Frames sent since the reset
+                          done;             // Frames done by the coprocessor since the reset
+    static bool           resync;           // Reset sent, waiting for its report
+    static millis_l       report_ms;
+    static short_timer_t  query_timer;
+
+  public: /** Public Function */
+
+    static void init();
+
+    /**
+     * Read the reports and send the planner blocks while the coprocessor has room
+     * Called from the main loop
+     */
+    static void spin();
+
+    /**
+     * Drop the segments on the coprocessor, the planner queue is emptied
+     * Called by Planner::quick_stop with the Stepper ISR disabled
+     */
+    static void flush();
+
+    /**
+     * The block is sent to the coprocessor, read only for the planner
+     */
+    static bool is_block_queued(const block_t* const b);
+
+    /**
+     * Waiting for the position after a reset
+     */
+    FORCE_INLINE static bool pending() { return resync; }
+
+  private: /** Private Function */
+
+    FORCE_INLINE static uint8_t in_flight() { return uint8_t(sent - done); }
+
+    static void send_frame(const CoprocessorFrameEnum cmd, const uint8_t * const payload, const uint8_t len);
+    static void send_block(const block_t* const b);
+
+    static void receive();
+    static void report(const uint8_t * const payload, const bool reset);
+
+};
+
+extern StepCoprocessor coprocessor;
+
+#endif // ENABLED(STEP_COPROCESSOR)
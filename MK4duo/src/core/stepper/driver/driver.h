@@ -137,7 +137,11 @@ class Driver {
       HAL::pinMode(data.pin.dir, OUTPUT);
     }
     FORCE_INLINE void dir_write(const bool state) {
-      HAL::digitalWrite(data.pin.dir, state);
+      #if ENABLED(STEP_PULSE_BATCH)
+        if (HAL_step_batch_active) HAL_step_batch_add(data.pin.dir, state);
+        else
+      #endif
+          HAL::digitalWrite(data.pin.dir, state);
       data.flag.dir_status = state;
     }
     FORCE_INLINE bool dir_read() {
@@ -155,12 +159,12 @@ class Driver {
       #if ENABLED(SQUARE_WAVE_STEPPING)
         if (tmc) return step_toggle(state);
       #endif
-      HAL::digitalWrite(data.pin.step, state);
+      step_pin_write(state);
       data.flag.step_status = state;
     }
     FORCE_INLINE void step_toggle(const bool state) {
       if (state) {
-        HAL::digitalWrite(data.pin.step, !data.flag.step_status);
+        step_pin_write(!data.flag.step_status);
         data.flag.step_status = !data.flag.step_status;
       }
     }
@@ -168,6 +172,15 @@ class Driver {
       return data.flag.step_status;
     }
 
+  private: /** Private Function */
+
+    FORCE_INLINE void step_pin_write(const bool state) {
+      #if ENABLED(STEP_PULSE_BATCH)
+        if (HAL_step_batch_active) return HAL_step_batch_add(data.pin.step, state);
+      #endif
+      HAL::digitalWrite(data.pin.step, state);
+    }
+
 };
 
 struct driver_t {
@@ -0,0 +1,128 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * isr_profiler.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(STEPPER_ISR_PROFILER)
+
+IsrProfiler isrProfiler;
+
+/** Public Parameters */
+isr_phase_t IsrProfiler::phase[ISR_PHASE_COUNT];
+
+/** Private Parameters */
+millis_l IsrProfiler::start_ms = 0;
+
+/** Public Function */
+void IsrProfiler::init() {
+  HAL_CYCLE_COUNTER_INIT();
+  reset();
+}
+
+void IsrProfiler::reset() {
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+  for (uint8_t p = 0; p < ISR_PHASE_COUNT; p++) {
+    phase[p].min = 0xFFFFFFFFUL;
+    phase[p].max = phase[p].total = phase[p].count = 0;
+  }
+  start_ms = millis();
+
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+}
+
+float IsrProfiler::duty_cycle() {
+  const millis_l elapsed_ms = millis() - start_ms;
+  if (!elapsed_ms) return 0.0f;
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+  const uint64_t total = phase[ISR_TOTAL].total;
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+  // total cycles / (cycles per ms * elapsed ms) * 100
+  return float(total) * 100000.0f / (float(HAL_CYCLE_COUNTER_RATE) * float(elapsed_ms));
+}
+
+void IsrProfiler::print() {
+
+  // Take a stable copy, the ISR keeps updating the counters
+  isr_phase_t copy[ISR_PHASE_COUNT];
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+  memcpy(copy, phase, sizeof(copy));
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+  SERIAL_LMV(ECHO, "ISR profile cycle rate (Hz):", uint32_t(HAL_CYCLE_COUNTER_RATE));
+  for (uint8_t p = 0; p < ISR_PHASE_COUNT; p++) {
+    if (!copy[p].count) continue;
+    SERIAL_STR(ECHO);
+    SERIAL_STR(phase_name(ISRPhaseEnum(p)));
+    SERIAL_MV(" min:", copy[p].min);
+    SERIAL_MV(" avg:", uint32_t(copy[p].total / copy[p].count));
+    SERIAL_MV(" max:", copy[p].max);
+    SERIAL_EMV(" count:", copy[p].count);
+  }
+  SERIAL_SMV(ECHO, "ISR duty cycle:", duty_cycle(), 2);
+  SERIAL_EMV("% steps per ISR:", stepper.get_steps_per_isr());
+}
+
+void IsrProfiler::print_json() {
+
+  // A stable copy, a 64 bit total is not read in one access
+  isr_phase_t copy[ISR_PHASE_COUNT];
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+  memcpy(copy, phase, sizeof(copy));
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+  SERIAL_MSG(",\"isr\":{");
+  for (uint8_t p = 0; p < ISR_PHASE_COUNT; p++) {
+    SERIAL_CHR('"');
+    SERIAL_STR(phase_name(ISRPhaseEnum(p)));
+    SERIAL_MV("\":[", copy[p].count ? copy[p].min : 0);
+    SERIAL_MV(",", copy[p].count ? uint32_t(copy[p].total / copy[p].count) : 0);
+    SERIAL_MV(",", copy[p].max);
+    SERIAL_MSG("],");
+  }
+  SERIAL_MV("\"rate\":", uint32_t(HAL_CYCLE_COUNTER_RATE));
+  SERIAL_MV(",\"duty\":", duty_cycle(), 2);
+  SERIAL_MV(",\"stepsPerIsr\":", stepper.get_steps_per_isr());
+  SERIAL_CHR('}');
+}
+
+/** Private Function */
+PGM_P IsrProfiler::phase_name(const ISRPhaseEnum p) {
+  switch (p) {
+    case ISR_PULSE_PHASE:   return PSTR("Pulse");
+    case ISR_BLOCK_PHASE:   return PSTR("Block");
+    case ISR_ADVANCE_PHASE: return PSTR("Advance");
+    default:                return PSTR("Total");
+  }
+}
+
+#endif // ENABLED(STEPPER_ISR_PROFILER)
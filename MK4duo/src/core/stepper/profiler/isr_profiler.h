@@ -0,0 +1,107 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * isr_profiler.h
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEPPER_ISR_PROFILER)
+
+enum ISRPhaseEnum : uint8_t {
+  ISR_PULSE_PHASE,
+  ISR_BLOCK_PHASE,
+  ISR_ADVANCE_PHASE,
+  ISR_TOTAL,
+  ISR_PHASE_COUNT
+};
+
+// Struct ISR phase statistics, in HAL_CYCLE_COUNTER() units
+// The total is 64 bit, at 168 MHz 32 bit wrap in 25 seconds of ISR time
+typedef struct {
+  uint32_t  min,
+            max;
+  uint64_t  total;
+  uint32_t  count;
+} isr_phase_t;
+
+class IsrProfiler {
+
+  public: /** Constructor */
+
+    IsrProfiler() {}
+
+  public: /** Public Parameters */
+
+    static isr_phase_t phase[ISR_PHASE_COUNT];
+
+  private: /** Private Parameters */
+
+    static millis_l start_ms;
+
+  public: /** Public Function */
+
+    static void init();
+    static void reset();
+
+    FORCE_INLINE static hal_cycle_t now() { return HAL_CYCLE_COUNTER(); }
+
+    /**
+     * Add a sample for the phase, from the start cycle to now
+     * Called from the Stepper ISR
+     */
+    FORCE_INLINE static void record(const ISRPhaseEnum p, const hal_cycle_t start) {
+      const uint32_t cycles = hal_cycle_t(now() - start);
+      isr_phase_t &ph = phase[p];
+      NOMORE(ph.min, cycles);
+      NOLESS(ph.max, cycles);
+      ph.total += cycles;
+      ph.count++;
+    }
+
+    /**
+     * ISR duty cycle since the last reset, in percent
+     */
+    static float duty_cycle();
+
+    static void print();
+    static void print_json();
+
+  private: /** Private Function */
+
+    static PGM_P phase_name(const ISRPhaseEnum p);
+
+};
+
+extern IsrProfiler isrProfiler;
+
+#define ISR_PROFILE_START(V)    const hal_cycle_t V = isrProfiler.now()
+#define ISR_PROFILE_END(P,V)    isrProfiler.record(P, V)
+
+#else
+
+#define ISR_PROFILE_START(V)    NOOP
+#define ISR_PROFILE_END(P,V)    NOOP
+
+#endif // ENABLED(STEPPER_ISR_PROFILER)
@@ -38,6 +38,74 @@
   #endif
 #endif
 
+#if ENABLED(ADAPTIVE_MULTISTEPPING)
+  #if ADAPTIVE_MULTISTEPPING_LOW_LOAD >= ADAPTIVE_MULTISTEPPING_HIGH_LOAD
+    #error "DEPENDENCY ERROR: ADAPTIVE_MULTISTEPPING_LOW_LOAD must be lower than ADAPTIVE_MULTISTEPPING_HIGH_LOAD."
+  #endif
+#endif
+
+#if ENABLED(FEED_HOLD)
+  #if DISABLED(REALTIME_COMMANDS)
+    #error "DEPENDENCY ERROR: FEED_HOLD requires REALTIME_COMMANDS."
+  #elif ENABLED(STEP_QUEUE)
+    #error "DEPENDENCY ERROR: FEED_HOLD is not compatible with STEP_QUEUE."
+  #endif
+#endif
+
+#if ENABLED(INPUT_SHAPING)
+  #if IS_KINEMATIC
+    #error "DEPENDENCY ERROR: INPUT_SHAPING is not available on the kinematic machines."
+  #elif DISABLED(SHAPING_FREQ_X) || DISABLED(SHAPING_FREQ_Y) || DISABLED(SHAPING_ZETA_X) || DISABLED(SHAPING_ZETA_Y)
+    #error "DEPENDENCY ERROR: Missing setting SHAPING_FREQ_X, SHAPING_FREQ_Y, SHAPING_ZETA_X or SHAPING_ZETA_Y."
+  #elif DISABLED(SHAPING_TYPE_X) || DISABLED(SHAPING_TYPE_Y) || !WITHIN(SHAPING_TYPE_X, 0, 2) || !WITHIN(SHAPING_TYPE_Y, 0, 2)
+    #error "DEPENDENCY ERROR: SHAPING_TYPE_X and SHAPING_TYPE_Y must be 0 (ZV), 1 (MZV) or 2 (EI)."
+  #elif DISABLED(SHAPING_BUFFER_SIZE) || !WITHIN(SHAPING_BUFFER_SIZE, 16, 4096)
+    #error "DEPENDENCY ERROR: SHAPING_BUFFER_SIZE must be between 16 and 4096."
+  #endif
+#endif
+
+#if ENABLED(STEP_QUEUE)
+  #if DISABLED(CPU_32_BIT)
+    #error "DEPENDENCY ERROR: STEP_QUEUE is only supported on 32 bit boards."
+  #elif ENABLED(LIN_ADVANCE) || ENABLED(BEZIER_JERK_CONTROL) || ENABLED(INPUT_SHAPING) || ENABLED(COLOR_MIXING_EXTRUDER)
+    #error "DEPENDENCY ERROR: STEP_QUEUE is not compatible with LIN_ADVANCE, BEZIER_JERK_CONTROL, INPUT_SHAPING or COLOR_MIXING_EXTRUDER."
+  #elif ENABLED(LASER) || ENABLED(ENDSTOP_TRIGGER_CAPTURE) || ENABLED(Z_LATE_ENABLE)
+    #error "DEPENDENCY ERROR: STEP_QUEUE is not compatible with LASER, ENDSTOP_TRIGGER_CAPTURE or Z_LATE_ENABLE."
+  #elif DISABLED(STEP_QUEUE_SIZE) || !WITHIN(STEP_QUEUE_SIZE, 64, 8192) || (STEP_QUEUE_SIZE & (STEP_QUEUE_SIZE - 1))
+    #error "DEPENDENCY ERROR: STEP_QUEUE_SIZE must be a power of 2 between 64 and 8192."
+  #elif DISABLED(STEP_QUEUE_MIN_INTERVAL) || !WITHIN(STEP_QUEUE_MIN_INTERVAL, 1, 100)
+    #error "DEPENDENCY ERROR: STEP_QUEUE_MIN_INTERVAL must be between 1 and 100 us."
+  #endif
+#endif
+
+#if ENABLED(STEP_COPROCESSOR)
+  #if DISABLED(__AVR__)
+    #error "DEPENDENCY ERROR: STEP_COPROCESSOR is only supported on AVR boards."
+  #elif DISABLED(STEP_COPROCESSOR_SERIAL) || STEP_COPROCESSOR_SERIAL < 1
+    #error "DEPENDENCY ERROR: STEP_COPROCESSOR requires a STEP_COPROCESSOR_SERIAL port."
+  #elif DISABLED(STEP_COPROCESSOR_BAUDRATE)
+    #error "DEPENDENCY ERROR: Missing setting STEP_COPROCESSOR_BAUDRATE."
+  #elif DISABLED(STEP_COPROCESSOR_SLOTS) || !WITHIN(STEP_COPROCESSOR_SLOTS, 2, BLOCK_BUFFER_SIZE - 1)
+    #error "DEPENDENCY ERROR: STEP_COPROCESSOR_SLOTS must be between 2 and BLOCK_BUFFER_SIZE - 1."
+  #elif ENABLED(LIN_ADVANCE) || ENABLED(BEZIER_JERK_CONTROL) || ENABLED(INPUT_SHAPING) || ENABLED(STEP_QUEUE) || ENABLED(COLOR_MIXING_EXTRUDER)
+    #error "DEPENDENCY ERROR: STEP_COPROCESSOR is not compatible with LIN_ADVANCE, BEZIER_JERK_CONTROL, INPUT_SHAPING, STEP_QUEUE or COLOR_MIXING_EXTRUDER."
+  #elif ENABLED(LASER) || ENABLED(BABYSTEPPING) || ENABLED(FEED_HOLD) || ENABLED(TOOLBOARD) || ENABLED(CNCROUTER_NATIVE_ARC)
+    #error "DEPENDENCY ERROR: STEP_COPROCESSOR is not compatible with LASER, BABYSTEPPING, FEED_HOLD, TOOLBOARD or CNCROUTER_NATIVE_ARC."
+  #elif ENABLED(ENDSTOP_TRIGGER_CAPTURE) || ENABLED(Z_LATE_ENABLE)
+    #error "DEPENDENCY ERROR: STEP_COPROCESSOR is not compatible with ENDSTOP_TRIGGER_CAPTURE or Z_LATE_ENABLE."
+  #elif HAS_MMU2 && MMU2_SERIAL == STEP_COPROCESSOR_SERIAL
+    #error "DEPENDENCY ERROR: STEP_COPROCESSOR_SERIAL and MMU2_SERIAL must be different."
+  #endif
+#endif
+
+#if ENABLED(STEP_PULSE_BATCH)
+  #if DISABLED(ARDUINO_ARCH_STM32) && DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_NATIVE)
+    #error "DEPENDENCY ERROR: STEP_PULSE_BATCH is only supported on Arduino DUE and STM32."
+  #elif ENABLED(PCF8574_EXPANSION_IO)
+    #error "DEPENDENCY ERROR: STEP_PULSE_BATCH is not compatible with PCF8574_EXPANSION_IO."
+  #endif
+#endif
+
 #if ENABLED(DIGIPOT_I2C)
   #if DISABLED(DIGIPOT_I2C_NUM_CHANNELS)
     #error "DEPENDENCY ERROR: Missing setting DIGIPOT_I2C_NUM_CHANNELS."
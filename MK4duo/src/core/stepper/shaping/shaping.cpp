@@ -0,0 +1,142 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * shaping.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(INPUT_SHAPING)
+
+InputShaping shaping;
+
+/** Public Parameters */
+shaping_data_t  InputShaping::data;
+shaping_axis_t  InputShaping::axis[XY];
+uint32_t        InputShaping::now = 0;
+
+/** Public Function */
+void InputShaping::factory_parameters() {
+  data.frequency[X_AXIS]  = SHAPING_FREQ_X;
+  data.frequency[Y_AXIS]  = SHAPING_FREQ_Y;
+  data.zeta[X_AXIS]       = SHAPING_ZETA_X;
+  data.zeta[Y_AXIS]       = SHAPING_ZETA_Y;
+  data.type[X_AXIS]       = SHAPING_TYPE_X;
+  data.type[Y_AXIS]       = SHAPING_TYPE_Y;
+}
+
+/**
+ * Impulses of the shapers for the damped period td:
+ *  ZV  1, K                            at 0, td/2
+ *  MZV 1-1/sqrt2, (sqrt2-1)k, (1-1/sqrt2)k^2 at 0, 3td/8, 3td/4 (k with 3/4 of the damping)
+ *  EI  (1+v)/4, (1-v)K/2, (1+v)K^2/4   at 0, td/2, td (v vibration tolerance 5%)
+ * The factors are normalized to SHAPING_ONE, the rounding goes to the first one.
+ */
+void InputShaping::refresh() {
+
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+  LOOP_XY(i) {
+    shaping_axis_t &ax = axis[i];
+    ax.reset();
+    ax.enabled = data.frequency[i] > 0;
+    ax.echoes = 1;
+    ax.factor[0] = SHAPING_ONE;
+    ax.factor[1] = ax.factor[2] = 0;
+    ax.delay[0] = ax.delay[1] = ax.delay[2] = 0;
+    ax.max_rate = 0;
+    if (!ax.enabled) continue;
+
+    const float z   = constrain(data.zeta[i], 0.0f, 0.99f),
+                df  = SQRT(1.0f - sq(z)),
+                td  = 1.0f / (data.frequency[i] * df),
+                K   = EXP(-z * M_PI / df);
+
+    float a[3], t[3];
+    switch (data.type[i]) {
+      case SHAPER_MZV: {
+        const float k = EXP(-0.75f * z * M_PI / df), a1 = 1.0f - M_SQRT1_2;
+        a[0] = a1;                      t[0] = 0;
+        a[1] = (M_SQRT2 - 1.0f) * k;    t[1] = 0.375f * td;
+        a[2] = a1 * sq(k);              t[2] = 0.75f * td;
+        ax.echoes = 2;
+      } break;
+      case SHAPER_EI: {
+        constexpr float v = 0.05f;
+        a[0] = 0.25f * (1.0f + v);      t[0] = 0;
+        a[1] = 0.5f * (1.0f - v) * K;   t[1] = 0.5f * td;
+        a[2] = a[0] * sq(K);            t[2] = td;
+        ax.echoes = 2;
+      } break;
+      default:
+        a[0] = 1.0f;                    t[0] = 0;
+        a[1] = K;                       t[1] = 0.5f * td;
+        break;
+    }
+
+    float sum = 0;
+    for (uint8_t n = 0; n <= ax.echoes; n++) sum += a[n];
+
+    int16_t rest = SHAPING_ONE;
+    for (uint8_t n = 1; n <= ax.echoes; n++) {
+      ax.factor[n] = LROUND(a[n] * (SHAPING_ONE) / sum);
+      ax.delay[n] = t[n] * (STEPPER_TIMER_RATE);
+      rest -= ax.factor[n];
+    }
+    ax.factor[0] = rest;
+
+    // A step stays in the queue for the last delay
+    ax.max_rate = (SHAPING_BUFFER_SIZE - 1) / t[ax.echoes];
+  }
+
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+}
+
+void InputShaping::reset() {
+  LOOP_XY(i) axis[i].reset();
+}
+
+bool InputShaping::pending() {
+  LOOP_XY(i) if (axis[i].enabled && axis[i].pending()) return true;
+  return false;
+}
+
+void InputShaping::print_M593() {
+  constexpr char shaper_name[SHAPER_COUNT][4] = { "ZV", "MZV", "EI" };
+  SERIAL_LM(CFG, "Input shaping: T<0 ZV, 1 MZV, 2 EI> F<Hz> D<zeta>");
+  LOOP_XY(i) {
+    SERIAL_SM(CFG, "  M593 ");
+    SERIAL_CHR(axis_codes[i]);
+    SERIAL_MV(" T", int(data.type[i]));
+    SERIAL_MV(" F", data.frequency[i]);
+    SERIAL_MV(" D", data.zeta[i]);
+    SERIAL_MSG(" ; ");
+    SERIAL_TXT(shaper_name[data.type[i] < SHAPER_COUNT ? data.type[i] : 0]);
+    SERIAL_EOL();
+  }
+}
+
+#endif // ENABLED(INPUT_SHAPING)
@@ -0,0 +1,156 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * shaping.h
+ *
+ * Input shaping of the X and Y steps. Every step of the Bresenham is split in
+ * the impulses of the shaper: the first one now, the echoes later from a queue
+ * of the step times. The impulses are shares of a step that sum in an error
+ * term, the motor steps when the term passes half a step, so no impulse makes
+ * more than one step and the steps of a move are the same.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(INPUT_SHAPING)
+
+#define SHAPING_ONE 256     // A step in impulse units, the impulses of a shaper sum to it
+
+enum ShaperEnum : uint8_t { SHAPER_ZV, SHAPER_MZV, SHAPER_EI, SHAPER_COUNT };
+
+// Struct Shaping data
+typedef struct {
+  float   frequency[XY],    // Hz, 0 is no shaping
+          zeta[XY];         // Damping ratio
+  uint8_t type[XY];         // ShaperEnum
+} shaping_data_t;
+
+// Struct Shaping axis, used in the Stepper ISR
+struct shaping_axis_t {
+
+  bool      enabled;
+  uint8_t   echoes;                       // Impulses after the first one, 1 or 2
+  int16_t   factor[3];                    // Share of a step of each impulse
+  uint32_t  delay[3],                     // Stepper ticks from the step to each impulse
+            max_rate;                     // Steps/s the queue can hold
+  int16_t   error;                        // Impulses not stepped yet
+  int8_t    dir;                          // Direction written to the driver, 0 for unknown
+  uint16_t  head, tail[2];                // A tail for each echo
+  uint32_t  time[SHAPING_BUFFER_SIZE];    // Time of the queued steps, the lowest bit is the direction
+
+  FORCE_INLINE void reset() { head = tail[0] = tail[1] = 0; error = 0; dir = 0; }
+
+  FORCE_INLINE bool pending() const { return tail[echoes - 1] != head; }
+
+  /**
+   * Add an impulse, return the step to do: 1, -1 or 0
+   */
+  FORCE_INLINE int8_t impulse(const int16_t f) {
+    error += f;
+    if (error > SHAPING_ONE / 2)    { error -= SHAPING_ONE; return  1; }
+    if (error < -(SHAPING_ONE / 2)) { error += SHAPING_ONE; return -1; }
+    return 0;
+  }
+
+  /**
+   * A step of the Bresenham, with no room in the queue the step is not shaped
+   */
+  FORCE_INLINE int8_t step(const bool forward, const uint32_t now) {
+    const uint16_t next = head + 1 == SHAPING_BUFFER_SIZE ? 0 : head + 1;
+    if (next == tail[echoes - 1]) return impulse(forward ? SHAPING_ONE : -SHAPING_ONE);
+    time[head] = (now & ~1UL) | (forward ? 1 : 0);
+    head = next;
+    return impulse(forward ? factor[0] : -factor[0]);
+  }
+
+  /**
+   * Ticks to the next impulse of an echo, negative when it is late
+   */
+  FORCE_INLINE int32_t echo_wait(const uint8_t e, const uint32_t now) const {
+    return int32_t((time[tail[e]] & ~1UL) + delay[e + 1] - now);
+  }
+
+  /**
+   * The impulse of the oldest step of an echo
+   */
+  FORCE_INLINE int8_t echo(const uint8_t e) {
+    const bool forward = TEST(time[tail[e]], 0);
+    if (++tail[e] == SHAPING_BUFFER_SIZE) tail[e] = 0;
+    return impulse(forward ? factor[e + 1] : -factor[e + 1]);
+  }
+
+};
+
+class InputShaping {
+
+  public: /** Constructor */
+
+    InputShaping() {}
+
+  public: /** Public Parameters */
+
+    static shaping_data_t data;
+    static shaping_axis_t axis[XY];
+    static uint32_t       now;              // Stepper ticks, the time of the queues
+
+  public: /** Public Function */
+
+    static void factory_parameters();
+
+    /**
+     * Impulses of the shapers from the data, with no steps in the queues
+     */
+    static void refresh();
+
+    /**
+     * Drop the echoes, when the block is aborted
+     */
+    static void reset();
+
+    /**
+     * Echoes to do after the last block
+     */
+    static bool pending();
+
+    /**
+     * Ticks to the next echo impulse, 0 when it is due
+     */
+    FORCE_INLINE static uint32_t next_echo() {
+      int32_t wait = INT32_MAX;
+      LOOP_XY(i) {
+        const shaping_axis_t &ax = axis[i];
+        if (!ax.enabled) continue;
+        for (uint8_t e = 0; e < ax.echoes; e++)
+          if (ax.tail[e] != ax.head) NOMORE(wait, ax.echo_wait(e, now));
+      }
+      return wait > 0 ? uint32_t(wait) : 0;
+    }
+
+    static void print_M593();
+
+};
+
+extern InputShaping shaping;
+
+#endif // ENABLED(INPUT_SHAPING)
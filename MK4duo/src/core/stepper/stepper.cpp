@@ -101,6 +101,12 @@ bool    Stepper::abort_current_block  = false;
   uint8_t Stepper::last_moved_extruder = 0xFF;
 #endif
 
+#if ENABLED(DUAL_X_CARRIAGE)
+  bool Stepper::dxc_x_step    = true,
+       Stepper::dxc_x2_step   = false,
+       Stepper::dxc_x2_mirror = false;
+#endif
+
 #if ENABLED(X_TWO_ENDSTOPS)
   bool Stepper::locked_X_motor = false, Stepper::locked_X2_motor = false;
 #endif
@@ -113,6 +119,10 @@ bool    Stepper::abort_current_block  = false;
   bool Stepper::locked_Z_motor = false, Stepper::locked_Z2_motor = false;
 #endif
 
+#if ENABLED(Z_STEPPER_AUTO_ALIGN)
+  uint32_t Stepper::z_align_steps[Z_STEPPER_COUNT] = { 0 };
+#endif
+
 uint32_t      Stepper::acceleration_time  = 0,
               Stepper::deceleration_time  = 0;
 
@@ -133,30 +143,66 @@ uint32_t      Stepper::advance_divisor        = 0,
 uint8_t       Stepper::active_extruder        = 0,
               Stepper::active_extruder_driver = 0;
 
-#if ENABLED(BEZIER_JERK_CONTROL)
+#if ENABLED(CNCROUTER_NATIVE_ARC)
+  uint8_t     Stepper::arc_major  = 0;
+  int32_t     Stepper::arc_f      = 0,
+              Stepper::arc_a      = 0,
+              Stepper::arc_b      = 0;
+  uint32_t    Stepper::arc_scale  = 0;
+#endif
+
+#if ENABLED(BEZIER_JERK_CONTROL) && ENABLED(__AVR__)
   int32_t __attribute__((used))   Stepper::bezier_A __asm__("bezier_A");      //  A coefficient in Bézier speed curve with alias for assembler
   int32_t __attribute__((used))   Stepper::bezier_B __asm__("bezier_B");      //  B coefficient in Bézier speed curve with alias for assembler
   int32_t __attribute__((used))   Stepper::bezier_C __asm__("bezier_C");      //  C coefficient in Bézier speed curve with alias for assembler
   uint32_t __attribute__((used))  Stepper::bezier_F __asm__("bezier_F");      //  F coefficient in Bézier speed curve with alias for assembler
   uint32_t __attribute__((used))  Stepper::bezier_AV __asm__("bezier_AV");    // AV coefficient in Bézier speed curve with alias for assembler
-  #if ENABLED(__AVR__)
-    bool __attribute__((used))    Stepper::A_negative __asm__("A_negative");  // If A coefficient was negative
-  #endif
+  bool __attribute__((used))      Stepper::A_negative __asm__("A_negative");  // If A coefficient was negative
+#elif ENABLED(BEZIER_JERK_CONTROL)
+  const bezier_coeff_t* Stepper::bezier = nullptr;                            // Coefficients computed by the planner
+#endif
+
+#if ENABLED(BEZIER_JERK_CONTROL)
   bool Stepper::bezier_2nd_half = false;  // =false If Bézier curve has been initialized or not
 #endif
 
 uint32_t Stepper::nextMainISR = 0;
 
+#if ENABLED(ADAPTIVE_MULTISTEPPING)
+  uint8_t   Stepper::multistep_bias   = 0;
+  uint32_t  Stepper::isr_busy_ticks   = 0,
+            Stepper::isr_period_ticks = 0;
+#endif
+
 #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
   static uint8_t oversampling_factor = 0;
 #else
   constexpr uint8_t oversampling_factor = 0;
 #endif
 
+#if ENABLED(INPUT_SHAPING)
+  uint32_t Stepper::nextShapingISR = 0;
+#endif
+
+#if ENABLED(FEED_HOLD)
+  feed_hold_t Stepper::hold = { HOLD_NONE, HOLD_SCALE_FULL, HOLD_RAMP_MAX };
+#endif
+
+#if ENABLED(STEP_QUEUE)
+  step_event_t  Stepper::sq_event;
+  bool          Stepper::sq_pending = false;
+#endif
+
 #if ENABLED(LIN_ADVANCE)
-  constexpr uint32_t LA_ADV_NEVER         = 0xFFFFFFFF;
-  uint32_t  Stepper::nextAdvanceISR       = LA_ADV_NEVER,
-            Stepper::LA_isr_rate          = LA_ADV_NEVER;
+  #if HAS_LIN_ADVANCE_ISR
+    constexpr uint32_t LA_ADV_NEVER       = 0xFFFFFFFF;
+    uint32_t  Stepper::nextAdvanceISR     = LA_ADV_NEVER,
+              Stepper::LA_isr_rate        = LA_ADV_NEVER;
+  #else
+    uint32_t  Stepper::LA_adv_factor      = 0;
+    uint16_t  Stepper::LA_target_adv_steps = 0;
+    int8_t    Stepper::LA_dir             = 0;
+  #endif
   uint16_t  Stepper::LA_current_adv_steps = 0,
             Stepper::LA_final_adv_steps   = 0,
             Stepper::LA_max_adv_steps     = 0;
@@ -170,16 +216,26 @@ int32_t Stepper::ticks_nominal = -1;
 #endif
 
 xyz_long_t  Stepper::endstops_trigsteps;
+#if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+  trigger_capture_t Stepper::capture;
+#endif
 xyze_long_t Stepper::count_position{0};
 xyze_int8_t Stepper::count_direction{1};
 
 #if ENABLED(LASER)
   int32_t Stepper::delta_error_laser = 0;
+  #if ENABLED(LASER_DYNAMIC_POWER)
+    uint32_t Stepper::laser_step_rate = 0;
+  #endif
   #if ENABLED(LASER_RASTER)
     int Stepper::counter_raster = 0;
   #endif // LASER_RASTER
 #endif // LASER
 
+// The drivers, in the static RAM
+static StaticPool<Driver, MAX_DRIVER_XYZ> driver_xyz_pool;
+static StaticPool<Driver, MAX_DRIVER_E>   driver_e_pool;
+
 /** Public Function */
 void Stepper::create_driver() {
   create_xyz_driver();
@@ -191,11 +247,11 @@ void Stepper::create_driver() {
 
 void Stepper::create_xyz_driver() {
 
-  constexpr char* drv_xyz_label[] = { "X", "Y", "Z" };
+  constexpr const char* drv_xyz_label[] = { "X", "Y", "Z" };
 
   LOOP_DRV_XYZ() {
     if (!driver.drv[d]) {
-      driver.drv[d] = new Driver(drv_xyz_label[d]);
+      driver.drv[d] = driver_xyz_pool.create(d, drv_xyz_label[d]);
       driver_factory_parameters(driver[d], d);
       SERIAL_SM(ECHO, "Create driver ");
       driver[d]->printLabel(); SERIAL_EOL();
@@ -208,7 +264,7 @@ void Stepper::create_xyz_driver() {
 
   #if X_STEPPER_COUNT == 2
     if (!driver.x2) {
-      driver.x2 = new Driver("X2");
+      driver.x2 = driver_xyz_pool.create(X2_DRV, "X2");
       driver_factory_parameters(driver.x2, X2_DRV);
       SERIAL_SM(ECHO, "Create driver ");
       driver.x2->printLabel(); SERIAL_EOL();
@@ -218,7 +274,7 @@ void Stepper::create_xyz_driver() {
 
   #if Y_STEPPER_COUNT == 2
     if (!driver.y2) {
-      driver.y2 = new Driver("Y2");
+      driver.y2 = driver_xyz_pool.create(Y2_DRV, "Y2");
       driver_factory_parameters(driver.y2, Y2_DRV);
       SERIAL_SM(ECHO, "Create driver ");
       driver.y2->printLabel(); SERIAL_EOL();
@@ -228,7 +284,7 @@ void Stepper::create_xyz_driver() {
 
   #if Z_STEPPER_COUNT >= 2
     if (!driver.z2) {
-      driver.z2 = new Driver("Z2");
+      driver.z2 = driver_xyz_pool.create(Z2_DRV, "Z2");
       driver_factory_parameters(driver.z2, Z2_DRV);
       SERIAL_SM(ECHO, "Create driver ");
       driver.z2->printLabel(); SERIAL_EOL();
@@ -238,7 +294,7 @@ void Stepper::create_xyz_driver() {
 
   #if Z_STEPPER_COUNT == 3
     if (!driver.z3) {
-      driver.z3 = new Driver("Z3");
+      driver.z3 = driver_xyz_pool.create(Z3_DRV, "Z3");
       driver_factory_parameters(driver.z3, Z3_DRV);
       SERIAL_SM(ECHO, "Create driver ");
       driver.z3->printLabel(); SERIAL_EOL();
@@ -250,11 +306,11 @@ void Stepper::create_xyz_driver() {
 
 void Stepper::create_ext_driver() {
 
-  constexpr char* drv_e_label[] = { "T0", "T1", "T2", "T3", "T4", "T5" };
+  constexpr const char* drv_e_label[] = { "T0", "T1", "T2", "T3", "T4", "T5" };
 
   LOOP_DRV_EXT() {
     if (!driver.e[d]) {
-      driver.e[d] = new Driver(drv_e_label[d]);
+      driver.e[d] = driver_e_pool.create(d, drv_e_label[d]);
       driver_factory_parameters(driver.e[d], d, false);
       SERIAL_SM(ECHO, "Create driver ");
       driver.e[d]->printLabel(); SERIAL_EOL();
@@ -276,8 +332,7 @@ void Stepper::change_number_driver(const uint8_t drv) {
     for (uint8_t dd = drv; dd < MAX_DRIVER_E; dd++) {
       if (driver.e[dd]) {
         SERIAL_LMT(ECHO, "Delete driver ", driver.e[dd]->axis_letter);
-        delete (driver.e[dd]);
-        driver.e[dd] = nullptr;
+        driver_e_pool.destroy(driver.e[dd]);
       }
     }
     data.drivers_e = drv;
@@ -291,6 +346,12 @@ void Stepper::init() {
     microstep_init();
   #endif
 
+  #if ENABLED(STEPPER_ISR_PROFILER)
+    isrProfiler.init();
+  #elif ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+    HAL_CYCLE_COUNTER_INIT();
+  #endif
+
   // Init Stepper ISR
   START_STEPPER_INTERRUPT();
   ENABLE_STEPPER_INTERRUPT();
@@ -336,6 +397,11 @@ void Stepper::factory_parameters() {
  */
 void Stepper::Step() {
 
+  MEMORY_PROFILE_ISR(MEM_ISR_STEPPER);
+  CRASH_RECORD_STEPPER();
+
+  ISR_PROFILE_START(isr_start);
+
   #if DISABLED(__AVR__)
     // Disable interrupts, to avoid ISR preemption while we reprogram the period
     // (AVR enters the ISR with global interrupts disabled, so no need to do it here)
@@ -361,30 +427,85 @@ void Stepper::Step() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
+    #if ENABLED(STEP_COPROCESSOR)
+      // The coprocessor steps the motors, the ISR only ticks
+      if (!nextMainISR) {
+        abort_current_block = false;
+        nextMainISR = (STEPPER_TIMER_RATE) / 1000;
+      }
+    #else
+
+    #if ENABLED(STEP_QUEUE)
+      // The steps are timed by the queue, just fire them
+      if (stepQueue.enabled) {
+        if (!nextMainISR) {
+          ISR_PROFILE_START(queue_start);
+          nextMainISR = step_queue_step();
+          ISR_PROFILE_END(ISR_PULSE_PHASE, queue_start);
+        }
+      }
+      else {
+    #endif
+
     // Run main stepping pulse phase ISR if we have to
-    if (!nextMainISR) pulse_phase_step();
+    if (!nextMainISR) {
+      ISR_PROFILE_START(pulse_start);
+      pulse_phase_step();
+      ISR_PROFILE_END(ISR_PULSE_PHASE, pulse_start);
+    }
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_LIN_ADVANCE_ISR
       // Run linear advance stepper ISR
-      if (!nextAdvanceISR) nextAdvanceISR = lin_advance_step();
+      if (!nextAdvanceISR) {
+        ISR_PROFILE_START(advance_start);
+        nextAdvanceISR = lin_advance_step();
+        ISR_PROFILE_END(ISR_ADVANCE_PHASE, advance_start);
+      }
+    #endif
+
+    #if ENABLED(INPUT_SHAPING)
+      // Run the echoes of the input shaping
+      if (!nextShapingISR) shaping_isr();
     #endif
 
     // Run main stepping block processing ISR if we have to
-    if (!nextMainISR) nextMainISR = block_phase_step();
+    if (!nextMainISR) {
+      ISR_PROFILE_START(block_start);
+      nextMainISR = block_phase_step();
+      ISR_PROFILE_END(ISR_BLOCK_PHASE, block_start);
+    }
+
+    #if ENABLED(STEP_QUEUE)
+      }
+    #endif
+
+    #endif // STEP_COPROCESSOR
 
-    #if ENABLED(LIN_ADVANCE)
+    #if HAS_LIN_ADVANCE_ISR
       uint32_t interval = MIN(nextAdvanceISR, nextMainISR); // Nearest time interval
     #else
       uint32_t interval = nextMainISR;                      // Remaining stepper ISR time
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      // The nearest echo, the pulse phase may have queued a step
+      nextShapingISR = shaping.next_echo();
+      NOMORE(interval, nextShapingISR);
+    #endif
+
     // Limit the value to the maximum possible value of the timer
     NOMORE(interval, uint32_t(HAL_TIMER_TYPE_MAX));
 
     // Compute the time remaining for the main isr
     nextMainISR -= interval;
 
-    #if ENABLED(LIN_ADVANCE)
+    #if ENABLED(INPUT_SHAPING)
+      // Compute the time remaining for the echoes
+      nextShapingISR -= interval;
+      shaping.now += interval;
+    #endif
+
+    #if HAS_LIN_ADVANCE_ISR
       // Compute the time remaining for the advance isr
       if (nextAdvanceISR != LA_ADV_NEVER) nextAdvanceISR -= interval;
     #endif
@@ -447,6 +568,14 @@ void Stepper::Step() {
   // Schedule next interrupt
   HAL_timer_set_count(STEPPER_TIMER_NUM, hal_timer_t(next_isr_ticks));
 
+  ISR_PROFILE_END(ISR_TOTAL, isr_start);
+
+  #if ENABLED(ADAPTIVE_MULTISTEPPING)
+    // The timer restarts at every ISR, so the current count is the time spent here
+    isr_busy_ticks += HAL_timer_get_current_count(STEPPER_TIMER_NUM);
+    isr_period_ticks += next_isr_ticks;
+  #endif
+
   // Don't forget to finally reenable interrupts
   ENABLE_ISRS();
 
@@ -459,6 +588,16 @@ void Stepper::Step() {
  */
 bool Stepper::is_block_busy(const block_t* const block) {
 
+  #if ENABLED(STEP_QUEUE)
+    // All the blocks in the step queue are read only
+    if (stepQueue.enabled) return stepQueue.is_block_queued(block);
+  #endif
+
+  #if ENABLED(STEP_COPROCESSOR)
+    // All the blocks sent to the coprocessor are read only
+    return coprocessor.is_block_queued(block);
+  #endif
+
   #if ENABLED(__AVR__)
 
     // Keep reading until 2 consecutive reads return the same value,
@@ -507,6 +646,17 @@ int32_t Stepper::position(const AxisEnum axis) {
   return v;
 }
 
+void Stepper::get_positions(xyze_long_t &pos) {
+
+  // A snapshot, no step between the axes
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+  pos = count_position;
+
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+}
+
 void Stepper::report_positions() {
 
   #ifdef __AVR__
@@ -567,6 +717,23 @@ void Stepper::reset_drivers() {
   set_directions();
 }
 
+/**
+ * DIR setup time of each axis, the slowest of its drivers (ns)
+ */
+constexpr uint32_t axis_direction_delay[XYZE] = {
+  MAX(X_DIRECTION_DELAY, X2_DIRECTION_DELAY),
+  MAX(Y_DIRECTION_DELAY, Y2_DIRECTION_DELAY),
+  MAX(Z_DIRECTION_DELAY, Z2_DIRECTION_DELAY, Z3_DIRECTION_DELAY),
+  MAX(E0_DIRECTION_DELAY, E1_DIRECTION_DELAY, E2_DIRECTION_DELAY,
+      E3_DIRECTION_DELAY, E4_DIRECTION_DELAY, E5_DIRECTION_DELAY)
+};
+
+FORCE_INLINE uint32_t Stepper::get_direction_delay(const uint8_t axis_bits) {
+  uint32_t direction_delay = data.direction_delay;
+  LOOP_XYZE(axis) if (TEST(axis_bits, axis)) NOLESS(direction_delay, axis_direction_delay[axis]);
+  return direction_delay;
+}
+
 /**
  * Set the stepper direction of each axis
  *
@@ -574,64 +741,104 @@ void Stepper::reset_drivers() {
  *   COREYX: X_AXIS=A_AXIS and Y_AXIS=B_AXIS
  *   COREXZ: X_AXIS=A_AXIS and Z_AXIS=C_AXIS
  *   COREZX: X_AXIS=A_AXIS and Z_AXIS=C_AXIS
+ *
+ * Only the DIR pins of the axes in changed are written, and the delay
+ * is the longest DIR setup time of their drivers.
  */
-void Stepper::set_directions() {
+void Stepper::set_directions(uint8_t changed/*=0xFF*/) {
+
+  #if ENABLED(INPUT_SHAPING)
+    // The echoes of the last block could have left the other direction on the pins
+    if (shaping.axis[X_AXIS].dir != count_direction.x) SBI(changed, X_AXIS);
+    if (shaping.axis[Y_AXIS].dir != count_direction.y) SBI(changed, Y_AXIS);
+  #endif
+
+  const uint32_t direction_delay = get_direction_delay(changed);
 
   // Pre changing directions, an small delay could be needed.
   // Min delay is 50 Nanoseconds
-  if (data.direction_delay >= 50) HAL::delayNanoseconds(data.direction_delay);
+  if (direction_delay >= 50) HAL::delayNanoseconds(direction_delay);
+
+  // The dir pins of all the axes, one store for each port
+  #if ENABLED(STEP_PULSE_BATCH)
+    HAL_step_batch_open();
+  #endif
+
+  #if ENABLED(DUAL_X_CARRIAGE)
+    // Both carriages follow the X axis in duplication, else the one of the block extruder
+    const bool duplicating = mechanics.extruder_duplication_enabled;
+    dxc_x_step    = duplicating || !movement_extruder();
+    dxc_x2_step   = duplicating || movement_extruder();
+    dxc_x2_mirror = duplicating && mechanics.mirrored_duplication_mode;
+  #endif
 
   #if HAS_X_DIR
-    if (motor_direction(X_AXIS)) {
-      set_X_dir(driver.x->isDir());
-      count_direction.x = -1;
-    }
-    else {
-      set_X_dir(!driver.x->isDir());
-      count_direction.x = 1;
+    if (TEST(changed, X_AXIS)) {
+      if (motor_direction(X_AXIS)) {
+        set_X_dir(driver.x->isDir());
+        count_direction.x = -1;
+      }
+      else {
+        set_X_dir(!driver.x->isDir());
+        count_direction.x = 1;
+      }
     }
   #endif
 
   #if HAS_Y_DIR
-    if (motor_direction(Y_AXIS)) {
-      set_Y_dir(driver.y->isDir());
-      count_direction.y = -1;
-    }
-    else {
-      set_Y_dir(!driver.y->isDir());
-      count_direction.y = 1;
+    if (TEST(changed, Y_AXIS)) {
+      if (motor_direction(Y_AXIS)) {
+        set_Y_dir(driver.y->isDir());
+        count_direction.y = -1;
+      }
+      else {
+        set_Y_dir(!driver.y->isDir());
+        count_direction.y = 1;
+      }
     }
   #endif
 
+  #if ENABLED(INPUT_SHAPING)
+    // The echoes of the last block write the direction when they need the other one
+    shaping.axis[X_AXIS].dir = count_direction.x;
+    shaping.axis[Y_AXIS].dir = count_direction.y;
+  #endif
+
   #if HAS_Z_DIR
-    if (motor_direction(Z_AXIS)) {
-      set_Z_dir(driver.z->isDir());
-      count_direction.z = -1;
-    }
-    else {
-      set_Z_dir(!driver.z->isDir());
-      count_direction.z = 1;
+    if (TEST(changed, Z_AXIS)) {
+      if (motor_direction(Z_AXIS)) {
+        set_Z_dir(driver.z->isDir());
+        count_direction.z = -1;
+      }
+      else {
+        set_Z_dir(!driver.z->isDir());
+        count_direction.z = 1;
+      }
     }
   #endif
 
   #if DISABLED(LIN_ADVANCE)
     #if ENABLED(COLOR_MIXING_EXTRUDER)
-      if (motor_direction(E_AXIS)) {
-        set_rev_E_dir();
-        count_direction.e = -1;
-      }
-      else {
-        set_nor_E_dir();
-        count_direction.e = 1;
+      if (TEST(changed, E_AXIS)) {
+        if (motor_direction(E_AXIS)) {
+          set_rev_E_dir();
+          count_direction.e = -1;
+        }
+        else {
+          set_nor_E_dir();
+          count_direction.e = 1;
+        }
       }
     #else
-      if (motor_direction(E_AXIS)) {
-        set_rev_E_dir(active_extruder_driver);
-        count_direction.e = -1;
-      }
-      else {
-        set_nor_E_dir(active_extruder_driver);
-        count_direction.e = 1;
+      if (TEST(changed, E_AXIS)) {
+        if (motor_direction(E_AXIS)) {
+          set_rev_E_dir(active_extruder_driver);
+          count_direction.e = -1;
+        }
+        else {
+          set_nor_E_dir(active_extruder_driver);
+          count_direction.e = 1;
+        }
       }
     #endif
   #endif // DISABLED(LIN_ADVANCE)
@@ -640,9 +847,13 @@ void Stepper::set_directions() {
     toolManager.encLastDir[active_extruder] = count_direction.e;
   #endif
 
+  #if ENABLED(STEP_PULSE_BATCH)
+    HAL_step_batch_flush();
+  #endif
+
   // After changing directions, an small delay could be needed.
   // Min delay is 50 Nanoseconds
-  if (data.direction_delay >= 50) HAL::delayNanoseconds(data.direction_delay);
+  if (direction_delay >= 50) HAL::delayNanoseconds(direction_delay);
 
 }
 
@@ -818,6 +1029,42 @@ bool Stepper::driver_is_enable() {
   return driver_enable;
 }
 
+#if ENABLED(ADAPTIVE_MULTISTEPPING)
+
+  void Stepper::adapt_multistepping() {
+
+    static short_timer_t adapt_timer(millis());
+    if (!adapt_timer.expired(100)) return;
+
+    // Take the counters with the ISR disabled
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+    const uint32_t busy = isr_busy_ticks, period = isr_period_ticks;
+    isr_busy_ticks = isr_period_ticks = 0;
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+    // Without motion there is nothing to trade
+    if (!period || !planner.has_blocks_queued()) {
+      multistep_bias = 0;
+      return;
+    }
+
+    // About 100ms of timer ticks, so busy * 100 fits in 32 bit
+    const uint8_t load = MIN(100UL, (busy * 100UL) / period);
+
+    // The planner is running dry while commands are waiting: the main loop is starved
+    const bool starved = planner.moves_planned() < 2 && !commands.buffer_ring.isEmpty();
+
+    if (load >= ADAPTIVE_MULTISTEPPING_HIGH_LOAD || (starved && load >= ADAPTIVE_MULTISTEPPING_LOW_LOAD)) {
+      if (multistep_bias < ADAPTIVE_MULTISTEPPING_MAX_BIAS) multistep_bias++;
+    }
+    else if (!starved && load < ADAPTIVE_MULTISTEPPING_LOW_LOAD && multistep_bias)
+      multistep_bias--;
+
+  }
+
+#endif // ENABLED(ADAPTIVE_MULTISTEPPING)
+
 /**
  * Handle a triggered endstop
  */
@@ -827,16 +1074,22 @@ void Stepper::endstop_triggered(const AxisEnum axis) {
   const bool isr_enabled = STEPPER_ISR_ENABLED();
   if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
 
+  #if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+    const xyze_long_t trig_position = edge_position();
+  #else
+    const xyze_long_t &trig_position = count_position;
+  #endif
+
   #if IS_CORE
 
     endstops_trigsteps[axis] = 0.5f * (
-      axis == CORE_AXIS_2 ? CORESIGN(count_position[CORE_AXIS_1] - count_position[CORE_AXIS_2])
-                          : count_position[CORE_AXIS_1] + count_position[CORE_AXIS_2]
+      axis == CORE_AXIS_2 ? CORESIGN(trig_position[CORE_AXIS_1] - trig_position[CORE_AXIS_2])
+                          : trig_position[CORE_AXIS_1] + trig_position[CORE_AXIS_2]
     );
 
   #else // !COREXY && !COREXZ && !COREYZ
 
-    endstops_trigsteps[axis] = count_position[axis];
+    endstops_trigsteps[axis] = trig_position[axis];
 
   #endif // !COREXY && !COREXZ && !COREYZ
 
@@ -848,6 +1101,24 @@ void Stepper::endstop_triggered(const AxisEnum axis) {
 
 }
 
+#if ENABLED(STEP_COPROCESSOR)
+
+  void Stepper::coprocessor_block_done(const block_t* const block) {
+    if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION)) sync_block_position(block);
+  }
+
+  void Stepper::coprocessor_sync(const xyze_long_t &pos, const uint8_t hit_axes) {
+    const bool isr_enabled = STEPPER_ISR_ENABLED();
+    if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+    count_position = pos;
+    if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+
+    // The coprocessor stops the axis at the trigger, its position is the triggered one
+    LOOP_XYZ(i) if (TEST(hit_axes, i)) endstop_triggered(AxisEnum(i));
+  }
+
+#endif
+
 /**
  * Triggered position of an axis in steps
  */
@@ -1345,6 +1616,28 @@ void Stepper::set_position(const AxisEnum a, const int32_t &v) {
 
 #endif // BABYSTEPPING
 
+#if ENABLED(MESH_STEPPER_CORRECTION)
+
+  // Called by the Tick, the Stepper ISR must not run in the middle
+  void Stepper::mesh_z_step(const bool up) {
+
+    DISABLE_ISRS();
+
+    const uint8_t old_Z_dir = driver.z->dir_read();
+    enable_Z();
+    set_Z_dir(driver.z->isDir() ^ up);
+    if (data.direction_delay >= 50)
+      HAL::delayNanoseconds(data.direction_delay);
+    start_Z_step();
+    HAL::delayNanoseconds(HAL_pulse_high_tick);
+    stop_Z_step();
+    set_Z_dir(old_Z_dir);
+
+    ENABLE_ISRS();
+  }
+
+#endif // MESH_STEPPER_CORRECTION
+
 /** Private Function */
 void Stepper::driver_factory_parameters(Driver* act, const uint8_t index, const bool axis/*=true*/) {
 
@@ -1394,6 +1687,36 @@ void Stepper::driver_factory_parameters(Driver* act, const uint8_t index, const
  * call to this method that might cause variation in the timing. The aim
  * is to keep pulse timing as regular as possible.
  */
+#if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+
+  /**
+   * The endstop pin ISR runs a little after the edge and the stepper ISR can
+   * pulse in the middle. Back-interpolate the last pulse phase on the edge time:
+   *  - Pulses all after the edge: the position before them
+   *  - Edge in the middle of the pulses: linear between before and now
+   *  - Pulses all before the edge or no valid edge: count_position
+   */
+  xyze_long_t Stepper::edge_position() {
+
+    xyze_long_t pos = count_position;
+    if (!capture.edge_valid) return pos;
+
+    const uint32_t  edge  = capture.edge_cycles,
+                    start = capture.start_cycles,
+                    end   = capture.pulsing ? HAL_CYCLE_COUNTER() : capture.end_cycles;
+
+    if (int32_t(start - edge) >= 0)
+      pos = capture.start_position;
+    else if (int32_t(end - edge) > 0 && end != start) {
+      const float ratio = float(edge - start) / float(end - start);
+      LOOP_XYZ(i) pos[i] = capture.start_position[i] + LROUND((count_position[i] - capture.start_position[i]) * ratio);
+    }
+
+    return pos;
+  }
+
+#endif // ENDSTOP_TRIGGER_CAPTURE
+
 void Stepper::pulse_phase_step() {
 
   // If we must abort the current block, do so!
@@ -1404,11 +1727,20 @@ void Stepper::pulse_phase_step() {
       current_block = NULL;
       planner.discard_current_block();
     }
+    #if ENABLED(INPUT_SHAPING)
+      // The echoes of the aborted moves are not done, the position is the one of the motors
+      shaping.reset();
+    #endif
   }
 
   // If there is no current block, do nothing
   if (!current_block) return;
 
+  #if ENABLED(FEED_HOLD)
+    // Stopped by the feed hold, in the middle of the block
+    if (hold.state == HOLD_STOPPED) return;
+  #endif
+
   // Compute the count of pending loops
   const uint32_t pending_events = step_event_count - step_events_completed;
   uint8_t events_to_do = MIN(pending_events, steps_per_isr);
@@ -1416,6 +1748,13 @@ void Stepper::pulse_phase_step() {
   // Just update the value we will get at the end of the loop
   step_events_completed += events_to_do;
 
+  #if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+    // Position and time before the pulses, to go back to the endstop edge
+    capture.start_position = count_position;
+    capture.start_cycles = HAL_CYCLE_COUNTER();
+    capture.pulsing = true;
+  #endif
+
   bool first_step = true;
   hal_timer_t pulse_tick_end = 0;
 
@@ -1431,13 +1770,25 @@ void Stepper::pulse_phase_step() {
       while (HAL_timer_get_current_count(STEPPER_TIMER_NUM) < pulse_tick_end) { /* nada */ }
 
     // Start an active pulse
-    pulse_tick_start();
+    #if ENABLED(STEP_PULSE_BATCH)
+      HAL_step_batch_open();
+      pulse_tick_start();
+      HAL_step_batch_flush();
+    #else
+      pulse_tick_start();
+    #endif
 
     pulse_tick_end = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + HAL_pulse_high_tick;
     while (HAL_timer_get_current_count(STEPPER_TIMER_NUM) < pulse_tick_end) { /* nada */ }
 
     // Stop an active pulse
-    pulse_tick_stop();
+    #if ENABLED(STEP_PULSE_BATCH)
+      HAL_step_batch_open();
+      pulse_tick_stop();
+      HAL_step_batch_flush();
+    #else
+      pulse_tick_stop();
+    #endif
 
     #if ENABLED(LASER)
       delta_error_laser += current_block->steps_l;
@@ -1448,7 +1799,8 @@ void Stepper::pulse_phase_step() {
           if (current_block->laser_mode == RASTER && current_block->laser_status == LASER_ON) { // Raster Firing Mode
             // For some reason, when comparing raster power to ppm line burns the rasters were around 2% more powerful
             // going from darkened paper to burning through paper.
-            laser.fire(current_block->laser_raster_data[counter_raster]);
+            if (counter_raster < current_block->laser_raster_len)
+              laser.fire(laser.raster_pool[current_block->laser_raster_index + counter_raster]);
             counter_raster++;
           }
         #endif // LASER_RASTER
@@ -1466,6 +1818,11 @@ void Stepper::pulse_phase_step() {
 
   } while (--events_to_do);
 
+  #if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+    capture.end_cycles = HAL_CYCLE_COUNTER();
+    capture.pulsing = false;
+  #endif
+
 }
 
 uint32_t Stepper::block_phase_step() {
@@ -1473,6 +1830,11 @@ uint32_t Stepper::block_phase_step() {
   // If no queued movements, just wait 1ms for the next move
   uint32_t interval = (STEPPER_TIMER_RATE) / 1000;
 
+  #if ENABLED(FEED_HOLD)
+    // Stopped, the block stays current until the resume
+    if (hold.state == HOLD_STOPPED) return interval;
+  #endif
+
   // If there is a current block
   if (current_block) {
 
@@ -1507,17 +1869,31 @@ uint32_t Stepper::block_phase_step() {
         #endif
 
         // acc_step_rate is in steps/second
+        uint32_t step_rate = acc_step_rate;
 
         // step_rate to timer interval
-        interval = calc_timer_interval(acc_step_rate, &steps_per_isr, oversampling_factor);
-        acceleration_time += interval;
+        #if ENABLED(FEED_HOLD)
+          if (hold.state)
+            interval = hold_interval(step_rate, acceleration_time);
+          else
+        #endif
+          {
+            interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
+            acceleration_time += interval;
+          }
+
+        #if ENABLED(LASER_DYNAMIC_POWER)
+          laser_step_rate = step_rate;
+        #endif
 
-        #if ENABLED(LIN_ADVANCE)
+        #if HAS_LIN_ADVANCE_ISR
           if (LA_use_advance_lead) {
             // Fire ISR if final adv_rate is reached
             if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
           }
           else if (LA_steps) nextAdvanceISR = 0;
+        #elif ENABLED(LIN_ADVANCE)
+          lin_advance_target(step_rate);
         #endif // ENABLED(LIN_ADVANCE)
       }
       // Are we in deceleration phase
@@ -1528,7 +1904,11 @@ uint32_t Stepper::block_phase_step() {
           // If this is the 1st time we process the 2nd half of the trapezoid...
           if (!bezier_2nd_half) {
             // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+            #if ENABLED(__AVR__)
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+            #else
+              bezier = &current_block->bezier_decel;
+            #endif
             bezier_2nd_half = true;
             // The first point starts at cruise rate. Just save evaluation of the Bézier curve
             step_rate = current_block->cruise_rate;
@@ -1555,10 +1935,21 @@ uint32_t Stepper::block_phase_step() {
         // step_rate is in steps/second
 
         // step_rate to timer interval
-        interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
-        deceleration_time += interval;
+        #if ENABLED(FEED_HOLD)
+          if (hold.state)
+            interval = hold_interval(step_rate, deceleration_time);
+          else
+        #endif
+          {
+            interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
+            deceleration_time += interval;
+          }
 
-        #if ENABLED(LIN_ADVANCE)
+        #if ENABLED(LASER_DYNAMIC_POWER)
+          laser_step_rate = step_rate;
+        #endif
+
+        #if HAS_LIN_ADVANCE_ISR
           if (LA_use_advance_lead) {
             // Wake up eISR on first deceleration loop and fire ISR if final adv_rate is reached
             if (step_events_completed <= decelerate_after + steps_per_isr ||
@@ -1569,14 +1960,30 @@ uint32_t Stepper::block_phase_step() {
             }
           }
           else if (LA_steps) nextAdvanceISR = 0;
+        #elif ENABLED(LIN_ADVANCE)
+          lin_advance_target(step_rate);
         #endif // LIN_ADVANCE
       }
       // We must be in cruise phase otherwise
       else {
 
-        #if ENABLED(LIN_ADVANCE)
+        #if HAS_LIN_ADVANCE_ISR
           // If there are any esteps, fire the next advance_isr "now"
           if (LA_steps && LA_isr_rate != current_block->advance_speed) nextAdvanceISR = 0;
+        #elif ENABLED(LIN_ADVANCE)
+          LA_target_adv_steps = LA_max_adv_steps;
+        #endif
+
+        #if ENABLED(FEED_HOLD)
+          if (hold.state) {
+            // No time in the cruise, ticks_nominal is computed again after the resume
+            uint32_t step_rate = current_block->nominal_rate, cruise_time = 0;
+            interval = hold_interval(step_rate, cruise_time);
+            #if ENABLED(LASER_DYNAMIC_POWER)
+              laser_step_rate = step_rate;
+            #endif
+          }
+          else {
         #endif
 
         // Calculate the ticks_nominal for this nominal speed, if not done yet
@@ -1587,6 +1994,14 @@ uint32_t Stepper::block_phase_step() {
 
         // The timer interval is just the nominal value for the nominal speed
         interval = ticks_nominal;
+
+        #if ENABLED(LASER_DYNAMIC_POWER)
+          laser_step_rate = current_block->nominal_rate;
+        #endif
+
+        #if ENABLED(FEED_HOLD)
+          }
+        #endif
       }
     }
   }
@@ -1600,10 +2015,15 @@ uint32_t Stepper::block_phase_step() {
 
       // Sync block? Sync the stepper counts and return
       while (TEST(current_block->flag, BLOCK_BIT_SYNC_POSITION)) {
-        _set_position(
-          current_block->position[A_AXIS], current_block->position[B_AXIS],
-          current_block->position[C_AXIS], current_block->position[E_AXIS]
-        );
+        #if ENABLED(DLP_LAYER_CYCLE)
+          // A dwell stays at the tail for its time, a millisecond each call
+          if (current_block->sync_dwell) {
+            current_block->sync_dwell--;
+            current_block = NULL;
+            return (STEPPER_TIMER_RATE) / 1000;
+          }
+        #endif
+        sync_block_position(current_block);
         planner.discard_current_block();
 
         // Try to get a new block
@@ -1703,6 +2123,23 @@ uint32_t Stepper::block_phase_step() {
         oversampling_factor = oversampling;
       #endif
 
+      #if ENABLED(CNCROUTER_NATIVE_ARC)
+        // An arc has one event for each step of the major axis
+        if (TEST(current_block->flag, BLOCK_BIT_ARC)) {
+          arc_major = TEST(current_block->flag, BLOCK_BIT_ARC_Y) ? 2 : 1;
+          arc_f = current_block->arc_f;
+          arc_a = current_block->arc_a;
+          arc_b = current_block->arc_b;
+          arc_scale = current_block->arc_scale;
+          oversampling = 0;
+          #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+            oversampling_factor = 0;
+          #endif
+        }
+        else
+          arc_major = 0;
+      #endif
+
       // Based on the oversampling factor, do the calculations
       step_event_count = current_block->step_event_count << oversampling;
 
@@ -1731,7 +2168,7 @@ uint32_t Stepper::block_phase_step() {
       decelerate_after = current_block->decelerate_after << oversampling;
 
       #if ENABLED(COLOR_MIXING_EXTRUDER)
-        mixer.stepper_setup(current_block->b_color);
+        mixer.stepper_setup(current_block->b_weight);
       #endif
 
       #if MAX_EXTRUDER > 1
@@ -1746,26 +2183,50 @@ uint32_t Stepper::block_phase_step() {
           if (active_extruder != last_moved_extruder) LA_current_adv_steps = 0;
         #endif
 
-        if ((LA_use_advance_lead = current_block->use_advance_lead)) {
-          LA_final_adv_steps = current_block->final_adv_steps;
-          LA_max_adv_steps = current_block->max_adv_steps;
-          // Start the ISR
-          nextAdvanceISR = 0;
-          LA_isr_rate = current_block->advance_speed;
-        }
-        else LA_isr_rate = LA_ADV_NEVER;
+        #if HAS_LIN_ADVANCE_ISR
+          if ((LA_use_advance_lead = current_block->use_advance_lead)) {
+            LA_final_adv_steps = current_block->final_adv_steps;
+            LA_max_adv_steps = current_block->max_adv_steps;
+            // Start the ISR
+            nextAdvanceISR = 0;
+            LA_isr_rate = current_block->advance_speed;
+          }
+          else LA_isr_rate = LA_ADV_NEVER;
+        #else
+          // The driver may have changed, write the E direction on the first pulse
+          LA_dir = 0;
+          if ((LA_use_advance_lead = current_block->use_advance_lead)) {
+            LA_final_adv_steps = current_block->final_adv_steps;
+            LA_max_adv_steps = current_block->max_adv_steps;
+            // Once for block, the step rate gives the advance steps in the ISR
+            LA_adv_factor = (uint32_t(LA_max_adv_steps) << 16) / current_block->nominal_rate;
+            lin_advance_target(current_block->initial_rate);
+          }
+        #endif
       #endif
 
-      if (current_block->direction_bits != last_direction_bits
-        #if DISABLED(COLOR_MIXING_EXTRUDER)
-          || active_extruder != last_moved_extruder
-        #endif
-      ) {
+      #if ENABLED(TOOLBOARD)
+        toolboard.block_start(current_block);
+      #endif
+
+      // Only the axes that flip, on zig-zag infill often just one
+      uint8_t direction_changed = current_block->direction_bits ^ last_direction_bits;
+      #if DISABLED(COLOR_MIXING_EXTRUDER)
+        if (active_extruder != last_moved_extruder) SBI(direction_changed, E_AXIS);
+      #endif
+      #if ENABLED(DUAL_X_CARRIAGE)
+        // The X dir goes to the carriages of the extruder
+        if (active_extruder != last_moved_extruder
+          || mechanics.extruder_duplication_enabled != (dxc_x_step && dxc_x2_step)
+        ) SBI(direction_changed, X_AXIS);
+      #endif
+
+      if (direction_changed) {
         last_direction_bits = current_block->direction_bits;
         #if MAX_EXTRUDER > 1
           last_moved_extruder = active_extruder;
         #endif
-        set_directions();
+        set_directions(direction_changed);
       }
 
       // At this point, we must ensure the movement about to execute isn't
@@ -1792,7 +2253,11 @@ uint32_t Stepper::block_phase_step() {
         acc_step_rate = current_block->initial_rate;
       #else
         // Initialize the Bézier speed curve
-        _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
+        #if ENABLED(__AVR__)
+          _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
+        #else
+          bezier = &current_block->bezier_accel;
+        #endif
         // We haven't started the 2nd half of the trapezoid
         bezier_2nd_half = false;
       #endif
@@ -1802,14 +2267,34 @@ uint32_t Stepper::block_phase_step() {
       #endif
 
       // Calculate the initial timer interval
-      interval = calc_timer_interval(current_block->initial_rate, &steps_per_isr, oversampling_factor);
+      uint32_t step_rate = current_block->initial_rate;
+      #if ENABLED(FEED_HOLD)
+        if (hold.state)
+          interval = hold_interval(step_rate, acceleration_time);
+        else
+      #endif
+          interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
+
+      #if ENABLED(LASER_DYNAMIC_POWER)
+        laser_step_rate = step_rate;
+      #endif
     }
   }
 
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
+    if (current_block && arc_major) interval = arc_interval(interval);
+  #endif
+
   // Continuous firing of the laser during a move happens here, PPM and raster happen further down
   #if ENABLED(LASER)
-    if (current_block->laser_mode == CONTINUOUS && current_block->laser_status == LASER_ON)
-      laser.fire(current_block->laser_intensity);
+    if (current_block->laser_mode == CONTINUOUS && current_block->laser_status == LASER_ON) {
+      #if ENABLED(LASER_DYNAMIC_POWER)
+        // Power in step with the speed, rate <= nominal_rate so it is at most laser_intensity
+        laser.fire((laser_step_rate * current_block->laser_power_factor) >> 16);
+      #else
+        laser.fire(current_block->laser_intensity);
+      #endif
+    }
 
     if (current_block->laser_status == LASER_OFF)
       laser.extinguish();
@@ -1819,21 +2304,282 @@ uint32_t Stepper::block_phase_step() {
   return interval;
 }
 
+#if ENABLED(FEED_HOLD)
+
+  void Stepper::feed_hold(const bool onoff) {
+
+    const block_t * block = current_block;
+    if (!block && planner.has_blocks_queued()) block = &planner.block_buffer[planner.block_buffer_tail];
+    const uint32_t ramp = hold_ramp(block);
+
+    CRITICAL_SECTION_START;
+      if (onoff) {
+        // Not moving, stopped at once
+        if (!current_block) {
+          hold.scale = 0;
+          hold.state = HOLD_STOPPED;
+        }
+        else if (hold.state != HOLD_STOPPED)
+          hold.state = HOLD_DECEL;
+      }
+      else if (hold.state != HOLD_NONE) {
+        // Nothing to resume, the next block starts as planned
+        if (!block) {
+          hold.scale = HOLD_SCALE_FULL;
+          hold.state = HOLD_NONE;
+        }
+        else
+          hold.state = HOLD_RESUME;
+      }
+      hold.ramp = ramp;
+    CRITICAL_SECTION_END;
+  }
+
+  /**
+   * The change of the scale for timer tick, to go from the nominal speed
+   * of the block to zero, or back, at the acceleration of the block
+   */
+  uint32_t Stepper::hold_ramp(const block_t * const block) {
+    if (!block || block->nominal_speed_sqr <= 0 || block->acceleration <= 0) return HOLD_RAMP_MAX;
+    const float ticks = SQRT(block->nominal_speed_sqr) / block->acceleration * float(STEPPER_TIMER_RATE),
+                ramp  = float(HOLD_SCALE_FULL) / MAX(ticks, 1.0f);
+    return ramp >= float(HOLD_RAMP_MAX) ? HOLD_RAMP_MAX : ramp < 1.0f ? 1 : uint32_t(ramp);
+  }
+
+  /**
+   * The step rate of the trapezoid is scaled, the trapezoid goes on in its own time:
+   * the profile time advances as the planned rate would have done for these steps.
+   * Then the scale moves along its ramp.
+   */
+  uint32_t Stepper::hold_interval(uint32_t &step_rate, uint32_t &profile_time) {
+
+    step_rate = HAL_MULTI_ACC(hold.scale, step_rate);
+    NOLESS(step_rate, uint32_t(HOLD_MIN_RATE));
+
+    const uint32_t interval = calc_timer_interval(step_rate, &steps_per_isr, oversampling_factor);
+    profile_time += HAL_MULTI_ACC(hold.scale, interval);
+
+    const uint32_t change = hold.ramp * MIN(interval, uint32_t(0xFFFF));
+    if (hold.state == HOLD_DECEL) {
+      if (change < hold.scale)
+        hold.scale -= change;
+      else {
+        hold.scale = 0;
+        hold.state = HOLD_STOPPED;
+      }
+    }
+    else if (change < HOLD_SCALE_FULL - hold.scale)
+      hold.scale += change;
+    else {
+      hold.scale = HOLD_SCALE_FULL;
+      hold.state = HOLD_NONE;
+      ticks_nominal = -1;
+    }
+
+    return interval;
+  }
+
+#endif // FEED_HOLD
+
+#if ENABLED(STEP_QUEUE)
+
+  uint32_t Stepper::step_queue_step() {
+
+    // If we must abort the current block, drop its steps
+    if (abort_current_block) {
+      abort_current_block = false;
+      if (current_block) {
+        stepQueue.drop_block();
+        axis_did_move = 0;
+        current_block = NULL;
+        planner.discard_current_block();
+      }
+      sq_pending = false;
+    }
+
+    // Limit the amount of entries with no interval
+    for (uint8_t max_events = 16; max_events--;) {
+
+      if (!sq_pending) {
+        if (!stepQueue.pop(sq_event)) {
+          // Nothing queued, in a block the main loop is late
+          if (current_block) {
+            stepQueue.starving();
+            return (STEPPER_TIMER_RATE) / 10000;
+          }
+          return (STEPPER_TIMER_RATE) / 1000;
+        }
+        // Wait the interval of the entry
+        if (sq_event.interval) {
+          sq_pending = true;
+          return sq_event.interval;
+        }
+      }
+
+      sq_pending = false;
+
+      switch (sq_event.type) {
+
+        case STEP_EVENT_STEP:
+          // The steps of an aborted block are dropped
+          if (current_block && sq_event.steps) {
+            step_needed.x = TEST(sq_event.steps, X_AXIS);
+            step_needed.y = TEST(sq_event.steps, Y_AXIS);
+            step_needed.z = TEST(sq_event.steps, Z_AXIS);
+            step_needed.e = TEST(sq_event.steps, E_AXIS);
+            LOOP_XYZE(i) if (step_needed[i]) count_position[i] += count_direction[i];
+
+            #if ENABLED(STEP_PULSE_BATCH)
+              HAL_step_batch_open();
+              pulse_tick_start();
+              HAL_step_batch_flush();
+            #else
+              pulse_tick_start();
+            #endif
+
+            const hal_timer_t pulse_tick_end = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + HAL_pulse_high_tick;
+            while (HAL_timer_get_current_count(STEPPER_TIMER_NUM) < pulse_tick_end) { /* nada */ }
+
+            #if ENABLED(STEP_PULSE_BATCH)
+              HAL_step_batch_open();
+              pulse_tick_stop();
+              HAL_step_batch_flush();
+            #else
+              pulse_tick_stop();
+            #endif
+          }
+          break;
+
+        case STEP_EVENT_BLOCK_START:
+          if (!current_block && planner.has_blocks_queued()) {
+            current_block = &planner.block_buffer[planner.block_buffer_tail];
+
+            #if HAS_SD_RESTART
+              restart.job_info.sdpos = current_block->sdpos;
+            #endif
+
+            // Flag all moving axes for proper endstop handling
+            uint8_t axis_bits = 0;
+            if (X_MOVE_TEST) SBI(axis_bits, A_AXIS);
+            if (Y_MOVE_TEST) SBI(axis_bits, B_AXIS);
+            if (Z_MOVE_TEST) SBI(axis_bits, C_AXIS);
+            axis_did_move = axis_bits;
+
+            #if MAX_EXTRUDER > 1
+              active_extruder = current_block->active_extruder;
+              active_extruder_driver = get_active_extruder_driver();
+            #endif
+
+            #if ENABLED(TOOLBOARD)
+              toolboard.block_start(current_block);
+            #endif
+
+            uint8_t direction_changed = current_block->direction_bits ^ last_direction_bits;
+            #if MAX_EXTRUDER > 1
+              if (active_extruder != last_moved_extruder) SBI(direction_changed, E_AXIS);
+            #endif
+            #if ENABLED(DUAL_X_CARRIAGE)
+              if (active_extruder != last_moved_extruder
+                || mechanics.extruder_duplication_enabled != (dxc_x_step && dxc_x2_step)
+              ) SBI(direction_changed, X_AXIS);
+            #endif
+
+            if (direction_changed) {
+              last_direction_bits = current_block->direction_bits;
+              #if MAX_EXTRUDER > 1
+                last_moved_extruder = active_extruder;
+              #endif
+              set_directions(direction_changed);
+            }
+
+            // A move against a triggered endstop is aborted at the next call
+            endstops.update();
+          }
+          break;
+
+        case STEP_EVENT_BLOCK_END:
+          if (current_block) {
+            #if ENABLED(EXTRUDER_ENCODER_CONTROL) && FILAMENT_RUNOUT_DISTANCE_MM > 0
+              filamentrunout.block_completed(current_block);
+            #endif
+            axis_did_move = 0;
+            current_block = NULL;
+            planner.discard_current_block();
+          }
+          break;
+
+        case STEP_EVENT_SYNC:
+          if (!current_block && planner.has_blocks_queued()) {
+            block_t * const block = &planner.block_buffer[planner.block_buffer_tail];
+            if (TEST(block->flag, BLOCK_BIT_SYNC_POSITION)) {
+              sync_block_position(block);
+              planner.discard_current_block();
+            }
+          }
+          break;
+
+        default: break;
+      }
+
+    }
+
+    return STEPPER_TIMER_TICKS_PER_US;
+  }
+
+#endif // STEP_QUEUE
+
+#if ENABLED(CNCROUTER_NATIVE_ARC)
+
+  FORCE_INLINE void Stepper::arc_tick() {
+    arc_f += arc_a;
+    arc_a += 2;
+    const bool minor = ABS(arc_f + arc_b) < ABS(arc_f);
+    if (minor) {
+      arc_f += arc_b;
+      arc_b += 2;
+    }
+    step_needed.x = arc_major == 1 || minor;
+    step_needed.y = arc_major == 2 || minor;
+    if (step_needed.x) count_position.x += count_direction.x;
+    if (step_needed.y) count_position.y += count_direction.y;
+  }
+
+#endif
+
 FORCE_INLINE void Stepper::pulse_tick_prepare() {
 
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
+    if (arc_major) arc_tick();
+    else {
+  #endif
+
   #if HAS_X_STEP
     delta_error.x += advance_dividend.x;
     if ((step_needed.x = (delta_error.x >= 0))) {
-      count_position.x += count_direction.x;
       delta_error.x -= advance_divisor;
+      #if ENABLED(INPUT_SHAPING)
+        if (shaping.axis[X_AXIS].enabled)
+          step_needed.x = shaping_step(X_AXIS, shaping.axis[X_AXIS].step(count_direction.x > 0, shaping.now));
+        else
+      #endif
+          count_position.x += count_direction.x;
     }
   #endif
 
   #if HAS_Y_STEP
     delta_error.y += advance_dividend.y;
     if ((step_needed.y = (delta_error.y >= 0))) {
-      count_position.y += count_direction.y;
       delta_error.y -= advance_divisor;
+      #if ENABLED(INPUT_SHAPING)
+        if (shaping.axis[Y_AXIS].enabled)
+          step_needed.y = shaping_step(Y_AXIS, shaping.axis[Y_AXIS].step(count_direction.y > 0, shaping.now));
+        else
+      #endif
+          count_position.y += count_direction.y;
+    }
+  #endif
+
+  #if ENABLED(CNCROUTER_NATIVE_ARC)
     }
   #endif
 
@@ -1856,6 +2602,9 @@ FORCE_INLINE void Stepper::pulse_tick_prepare() {
         motor_direction(E_AXIS) ? --LA_steps : ++LA_steps;
       #endif
     }
+    #if ENABLED(LIN_ADVANCE_BRESENHAM)
+      lin_advance_blend();
+    #endif
   #else
     delta_error.e += advance_dividend.e;
     if ((step_needed.e = (delta_error.e >= 0))) {
@@ -1868,6 +2617,10 @@ FORCE_INLINE void Stepper::pulse_tick_prepare() {
 
 FORCE_INLINE void Stepper::pulse_tick_start() {
 
+  #if ENABLED(STEP_QUEUE)
+    if (stepQueue.timing) stepQueue.time_steps(step_needed);
+  #endif
+
   #if HAS_X_STEP
     if (step_needed.x) start_X_step();
   #endif
@@ -1880,7 +2633,7 @@ FORCE_INLINE void Stepper::pulse_tick_start() {
     if (step_needed.z) start_Z_step();
   #endif
 
-  #if DISABLED(LIN_ADVANCE)
+  #if !HAS_LIN_ADVANCE_ISR
     #if ENABLED(COLOR_MIXING_EXTRUDER)
       if (step_needed.e) e_step_write(mixer.get_next_stepper(), !driver.e[0]->isStep());
     #else
@@ -1904,7 +2657,7 @@ FORCE_INLINE void Stepper::pulse_tick_stop() {
     if (step_needed.z) stop_Z_step();
   #endif
 
-  #if DISABLED(LIN_ADVANCE)
+  #if !HAS_LIN_ADVANCE_ISR
     #if ENABLED(COLOR_MIXING_EXTRUDER)
       if (step_needed.e) e_step_write(mixer.get_stepper(), driver.e[0]->isStep());
     #else
@@ -1940,16 +2693,8 @@ FORCE_INLINE void Stepper::start_X_step() {
       driver.x2->step_write(!driver.x2->isStep());
     #endif
   #elif ENABLED(DUAL_X_CARRIAGE)
-    if (mechanics.extruder_duplication_enabled) {
-      driver.x->step_write(!driver.x->isStep());
-      driver.x2->step_write(!driver.x2->isStep());
-    }
-    else {
-      if (movement_extruder())
-        driver.x2->step_write(!driver.x->isStep());
-      else
-        driver.x->step_write(!driver.x2->isStep());
-    }
+    if (dxc_x_step)  driver.x->step_write(!driver.x->isStep());
+    if (dxc_x2_step) driver.x2->step_write(!driver.x2->isStep());
   #else
     driver.x->step_write(!driver.x->isStep());
   #endif
@@ -2052,8 +2797,30 @@ FORCE_INLINE void Stepper::start_Z_step() {
     driver.z->step_write(!driver.z->isStep());
   #endif
 
+  #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+    if (separate_multi_axis) count_z_align_steps();
+  #endif
+
 }
 
+#if ENABLED(Z_STEPPER_AUTO_ALIGN)
+
+  /**
+   * Count the step of each unlocked Z motor, and lock it on the last of its steps.
+   * The move is as long as the largest correction, the others stop on the way.
+   */
+  FORCE_INLINE void Stepper::count_z_align_steps() {
+    #define _Z_ALIGN_COUNT(N,M) if (z_align_steps[N] && !locked_##M##_motor && !--z_align_steps[N]) locked_##M##_motor = true
+    _Z_ALIGN_COUNT(0, Z);
+    _Z_ALIGN_COUNT(1, Z2);
+    #if Z_STEPPER_COUNT == 3
+      _Z_ALIGN_COUNT(2, Z3);
+    #endif
+    #undef _Z_ALIGN_COUNT
+  }
+
+#endif
+
 /**
  * End X Y Z Step
  */
@@ -2087,16 +2854,8 @@ FORCE_INLINE void Stepper::set_X_dir(const bool dir) {
     driver.x->dir_write(dir);
     driver.x2->dir_write((dir) != INVERT_X2_VS_X_DIR);
   #elif ENABLED(DUAL_X_CARRIAGE)
-    if (mechanics.extruder_duplication_enabled) {
-      driver.x->dir_write(dir);
-      driver.x2->dir_write(mechanics.mirrored_duplication_mode ? !dir : dir);
-    }
-    else {
-      if (movement_extruder())
-        driver.x2->dir_write(dir);
-      else
-        driver.x->dir_write(dir);
-    }
+    if (dxc_x_step)  driver.x->dir_write(dir);
+    if (dxc_x2_step) driver.x2->dir_write(dir != dxc_x2_mirror);
   #else
     driver.x->dir_write(dir);
   #endif
@@ -2182,6 +2941,25 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
 
 }
 
+void Stepper::sync_block_position(const block_t* const block) {
+  #if ENABLED(SYNCHRONOUS_FAN_SPEED)
+    if (block->sync_fan) {
+      Fan* fan = fans[block->sync_fan - 1];
+      if (block->sync_fan_speed)
+        fan->set_speed(block->sync_fan_speed);
+      else
+        fan->speed = 0;
+    }
+  #endif
+  #if ENABLED(DLP_LAYER_CYCLE)
+    if (block->sync_expose) dlpcycle.expose_isr(block->sync_expose == DLP_EXPOSE_ON);
+  #endif
+  _set_position(
+    block->position[A_AXIS], block->position[B_AXIS],
+    block->position[C_AXIS], block->position[E_AXIS]
+  );
+}
+
 #if DISABLED(COLOR_MIXING_EXTRUDER)
   uint8_t Stepper::get_active_extruder_driver() {
     #if HAS_MKMULTI_TOOLS
@@ -2216,7 +2994,91 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
  * properly schedules blocks from the planner. This is executed after creating
  * the step pulses, so it is not time critical, as pulses are already done.
  */
-#if ENABLED(LIN_ADVANCE)
+#if ENABLED(INPUT_SHAPING)
+
+  FORCE_INLINE bool Stepper::shaping_step(const AxisEnum axis, const int8_t dir) {
+    if (!dir) return false;
+    shaping_axis_t &ax = shaping.axis[axis];
+    if (dir != ax.dir) {
+      ax.dir = dir;
+      if (axis == X_AXIS)
+        set_X_dir(dir > 0 ? !driver.x->isDir() : driver.x->isDir());
+      else
+        set_Y_dir(dir > 0 ? !driver.y->isDir() : driver.y->isDir());
+      // After changing directions, an small delay could be needed.
+      const uint32_t direction_delay = get_direction_delay(_BV(axis));
+      if (direction_delay >= 50) HAL::delayNanoseconds(direction_delay);
+    }
+    count_position[axis] += dir;
+    return true;
+  }
+
+  FORCE_INLINE bool Stepper::shaping_echo(const AxisEnum axis, bool &due) {
+    shaping_axis_t &ax = shaping.axis[axis];
+    if (ax.enabled) {
+      for (uint8_t e = 0; e < ax.echoes; e++) {
+        if (ax.tail[e] != ax.head && ax.echo_wait(e, shaping.now) <= 0) {
+          due = true;
+          return shaping_step(axis, ax.echo(e));
+        }
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Do the echo impulses that are due, an impulse of each axis for pulse
+   */
+  void Stepper::shaping_isr() {
+    bool due, pulsed = false;
+    // The pulse phase may have just stopped a pulse
+    hal_timer_t pulse_tick_end = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + HAL_pulse_low_tick;
+
+    do {
+      due = false;
+      step_needed.x = shaping_echo(X_AXIS, due);
+      step_needed.y = shaping_echo(Y_AXIS, due);
+
+      if (step_needed.x || step_needed.y) {
+
+        pulsed = true;
+        while (HAL_timer_get_current_count(STEPPER_TIMER_NUM) < pulse_tick_end) { /* nada */ }
+
+        #if ENABLED(STEP_PULSE_BATCH)
+          HAL_step_batch_open();
+        #endif
+        if (step_needed.x) start_X_step();
+        if (step_needed.y) start_Y_step();
+        #if ENABLED(STEP_PULSE_BATCH)
+          HAL_step_batch_flush();
+        #endif
+
+        pulse_tick_end = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + HAL_pulse_high_tick;
+        while (HAL_timer_get_current_count(STEPPER_TIMER_NUM) < pulse_tick_end) { /* nada */ }
+
+        #if ENABLED(STEP_PULSE_BATCH)
+          HAL_step_batch_open();
+        #endif
+        if (step_needed.x) stop_X_step();
+        if (step_needed.y) stop_Y_step();
+        #if ENABLED(STEP_PULSE_BATCH)
+          HAL_step_batch_flush();
+        #endif
+
+        // For minimum pulse time wait before the next pulse
+        pulse_tick_end = HAL_timer_get_current_count(STEPPER_TIMER_NUM) + HAL_pulse_low_tick;
+      }
+
+    } while (due);
+
+    // Low time of the last echo before the next pulse phase
+    if (pulsed)
+      while (HAL_timer_get_current_count(STEPPER_TIMER_NUM) < pulse_tick_end) { /* nada */ }
+  }
+
+#endif // ENABLED(INPUT_SHAPING)
+
+#if HAS_LIN_ADVANCE_ISR
 
   // Timer interrupt for E. LA_steps is set in the main routine
   uint32_t Stepper::lin_advance_step() {
@@ -2254,7 +3116,8 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
 
     // After changing directions, an small delay could be needed.
     // Min delay is 50 Nanoseconds
-    if (data.direction_delay >= 50) HAL::delayNanoseconds(data.direction_delay);
+    const uint32_t direction_delay = get_direction_delay(_BV(E_AXIS));
+    if (direction_delay >= 50) HAL::delayNanoseconds(direction_delay);
 
     bool first_step = true;
     hal_timer_t pulse_tick_end;
@@ -2294,6 +3157,43 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
     return interval;
   }
 
+#elif ENABLED(LIN_ADVANCE)
+
+  /**
+   * One advance step goes on a step event with no E step, or against the E step
+   * to cancel it, so LA_steps is -1, 0 or 1 and the event has at most one E pulse.
+   * The direction is written only when it changes.
+   */
+  FORCE_INLINE void Stepper::lin_advance_blend() {
+    if (LA_use_advance_lead) {
+      if (LA_current_adv_steps < LA_target_adv_steps) {
+        if (LA_steps <= 0) {
+          LA_steps++;
+          LA_current_adv_steps++;
+        }
+      }
+      else if (LA_current_adv_steps > LA_target_adv_steps && LA_steps >= 0) {
+        LA_steps--;
+        LA_current_adv_steps--;
+      }
+    }
+
+    if ((step_needed.e = (LA_steps != 0))) {
+      if (LA_steps != LA_dir) {
+        LA_dir = LA_steps;
+        #if ENABLED(COLOR_MIXING_EXTRUDER)
+          if (LA_steps > 0) set_nor_E_dir(); else set_rev_E_dir();
+        #else
+          if (LA_steps > 0) set_nor_E_dir(active_extruder_driver); else set_rev_E_dir(active_extruder_driver);
+        #endif
+        // After changing directions, an small delay could be needed.
+        const uint32_t direction_delay = get_direction_delay(_BV(E_AXIS));
+        if (direction_delay >= 50) HAL::delayNanoseconds(direction_delay);
+      }
+      LA_steps = 0;
+    }
+  }
+
 #endif // ENABLED(LIN_ADVANCE)
 
 #if ENABLED(BEZIER_JERK_CONTROL)
@@ -2374,7 +3274,8 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
    *
    *  For Any 32bit CPU:
    *
-   *    At the start of each trapezoid, calculate the coefficients A,B,C,F and Advance [AV], as follows:
+   *    For each phase of the trapezoid the planner calculates the coefficients A,B,C,F and Advance [AV]
+   *    with the block (bezier_coeff_t), the ISR only evaluates the curve. As follows:
    *
    *      A =  6*128*(VF - VI) =  768*(VF - VI)
    *      B = 15*128*(VI - VF) = 1920*(VI - VF)
@@ -3022,19 +3923,55 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
       return (r2 | (uint16_t(r3) << 8)) | (uint32_t(r4) << 16);
     }
 
-  #else // !ENABLED(__AVR__)
+  #elif defined(__arm__) || defined(__thumb__)
 
-    FORCE_INLINE void Stepper::_calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av) {
-      // Calculate the Bézier coefficients
-      bezier_A =  768 * (v1 - v0);
-      bezier_B = 1920 * (v0 - v1);
-      bezier_C = 1280 * (v1 - v0);
-      bezier_F =  128 * v0;
-      bezier_AV = av;
+    // The coefficients come from the block (bezier_coeff_t::set), for ARM the curve is evaluated with
+    // UMULL / SMLAL on the 64 bit pairs of registers, a fixed cost of 43 cycles
+    FORCE_INLINE int32_t Stepper::_eval_bezier_curve(const uint32_t curr_step) {
+      uint32_t  flo = 0,
+                fhi = bezier->AV * curr_step,
+                t   = fhi;
+      int32_t   alo = bezier->F,
+                ahi = 0,
+                A   = bezier->A,
+                B   = bezier->B,
+                C   = bezier->C;
+
+      __asm__ __volatile__(
+        ".syntax unified" "\n\t"              // Prevent the non unified syntax of CM0 / CM1
+        A("lsrs  %[ahi],%[alo],#1")           // a  = F << 31      1 cycles
+        A("lsls  %[alo],%[alo],#31")          //                   1 cycles
+        A("umull %[flo],%[fhi],%[fhi],%[t]")  // f *= t            5 cycles [fhi:flo=64bits]
+        A("umull %[flo],%[fhi],%[fhi],%[t]")  // f>>=32; f*=t      5 cycles [fhi:flo=64bits]
+        A("lsrs  %[flo],%[fhi],#1")           //                   1 cycles [31bits]
+        A("smlal %[alo],%[ahi],%[flo],%[C]")  // a+=(f>>33)*C;     5 cycles
+        A("umull %[flo],%[fhi],%[fhi],%[t]")  // f>>=32; f*=t      5 cycles [fhi:flo=64bits]
+        A("lsrs  %[flo],%[fhi],#1")           //                   1 cycles [31bits]
+        A("smlal %[alo],%[ahi],%[flo],%[B]")  // a+=(f>>33)*B;     5 cycles
+        A("umull %[flo],%[fhi],%[fhi],%[t]")  // f>>=32; f*=t      5 cycles [fhi:flo=64bits]
+        A("lsrs  %[flo],%[fhi],#1")           // f>>=33;           1 cycles [31bits]
+        A("smlal %[alo],%[ahi],%[flo],%[A]")  // a+=(f>>33)*A;     5 cycles
+        A("lsrs  %[alo],%[ahi],#6")           // a>>=38            1 cycles
+        : [alo]"+r"( alo ) ,
+          [flo]"+r"( flo ) ,
+          [fhi]"+r"( fhi ) ,
+          [ahi]"+r"( ahi ) ,
+          [A]"+r"( A ) ,                      // A, B, C and t are only inputs, but GCC breaks the
+          [B]"+r"( B ) ,                      // function with bad optimizations when they are listed
+          [C]"+r"( C ) ,                      // as such: all the registers are inputs and outputs
+          [t]"+r"( t )
+        :
+        : "cc"
+      );
+      return alo;
     }
 
+  #else // !ENABLED(__AVR__) && !__arm__
+
     FORCE_INLINE int32_t Stepper::_eval_bezier_curve(const uint32_t curr_step) {
-      uint32_t t = bezier_AV * curr_step;               // t: Range 0 - 1^32 = 32 bits
+      const int32_t bezier_A = bezier->A, bezier_B = bezier->B, bezier_C = bezier->C;
+      const uint32_t bezier_F = bezier->F;
+      uint32_t t = bezier->AV * curr_step;              // t: Range 0 - 1^32 = 32 bits
       uint64_t f = t;
       f *= t;                                           // Range 32*2 = 64 bits (unsigned)
       f >>= 32;                                         // Range 32 bits  (unsigned)
@@ -3052,7 +3989,7 @@ void Stepper::_set_position(const int32_t &a, const int32_t &b, const int32_t &c
       return (int32_t) acc;
     }
 
-  #endif // !ENABLED(__AVR__)
+  #endif // !ENABLED(__AVR__) && !__arm__
 
 #endif // BEZIER_JERK_CONTROL
 
@@ -43,6 +43,10 @@
 
 #include "tmc/tmc.h"
 #include "driver/driver.h"
+#include "profiler/isr_profiler.h"
+#include "shaping/shaping.h"
+#include "stepqueue/step_queue.h"
+#include "coprocessor/step_coprocessor.h"
 
 // Struct Stepper data
 struct stepper_data_t {
@@ -52,7 +56,33 @@ struct stepper_data_t {
             drivers_e       :  3;
   bool      quad_stepping   :  1;
 };
-  
+
+#if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+  // Time of the endstop edge and of the last pulse phase, in cycles
+  struct trigger_capture_t {
+    volatile bool edge_valid, pulsing;
+    uint32_t      edge_cycles,
+                  start_cycles,
+                  end_cycles;
+    xyze_long_t   start_position;       // count_position before the last pulse phase
+  };
+#endif
+
+#if ENABLED(FEED_HOLD)
+  enum FeedHoldEnum : uint8_t { HOLD_NONE, HOLD_DECEL, HOLD_STOPPED, HOLD_RESUME };
+
+  #define HOLD_SCALE_FULL 0xFFFFFFUL  // The planned speed, 24 bit for HAL_MULTI_ACC
+  #define HOLD_RAMP_MAX   0xFFFFUL
+  #define HOLD_MIN_RATE   32          // steps/s
+
+  // The speed of the trapezoid is scaled down to zero and back
+  struct feed_hold_t {
+    volatile FeedHoldEnum state;
+    uint32_t  scale,                  // Speed factor, HOLD_SCALE_FULL for the planned speed
+              ramp;                   // Change of the scale for timer tick
+  };
+#endif
+
 class Stepper {
 
   public: /** Constructor */
@@ -83,6 +113,11 @@ class Stepper {
       static uint8_t last_moved_extruder;
     #endif
 
+    #if ENABLED(DUAL_X_CARRIAGE)
+      // Carriages driven by the X axis of the block, and X2 reversed in mirrored mode
+      static bool dxc_x_step, dxc_x2_step, dxc_x2_mirror;
+    #endif
+
     #if ENABLED(X_TWO_ENDSTOPS)
       static bool locked_X_motor, locked_X2_motor;
     #endif
@@ -95,9 +130,19 @@ class Stepper {
       static bool locked_Z_motor, locked_Z2_motor;
     #endif
 
+    #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+      static uint32_t z_align_steps[Z_STEPPER_COUNT]; // Steps left to each Z motor before its lock, 0 for no limit
+    #endif
+
     static uint32_t acceleration_time, deceleration_time; // time measured in Stepper Timer ticks
     static uint8_t  steps_per_isr;                        // Count of steps to perform per Stepper ISR call
 
+    #if ENABLED(ADAPTIVE_MULTISTEPPING)
+      static uint8_t  multistep_bias;                     // Shift applied to the multistepping thresholds
+      static uint32_t isr_busy_ticks,                     // Ticks spent in the Stepper ISR since last check
+                      isr_period_ticks;                   // Ticks scheduled between Stepper ISR since last check
+    #endif
+
     // Delta error variables for the Bresenham line tracer
     static xyze_long_t  delta_error;
     static xyze_ulong_t advance_dividend;
@@ -108,36 +153,67 @@ class Stepper {
                         decelerate_after,       // The point from where we need to start decelerating
                         step_event_count;       // The total event count for the current block
 
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      // The circle tracer of an arc block, see Planner::buffer_arc()
+      static uint8_t    arc_major;              // 0 for a line, 1 for X, 2 for Y
+      static int32_t    arc_f,                  // x^2 + y^2 - r^2 of the point
+                        arc_a,                  // The change of arc_f for a step of the major axis
+                        arc_b;                  // The change of arc_f for a step of the other axis
+      static uint32_t   arc_scale;
+    #endif
+
     static uint8_t      active_extruder,        // Active extruder
                         active_extruder_driver; // Active extruder driver
 
     #if ENABLED(BEZIER_JERK_CONTROL)
-      static int32_t  bezier_A,     // A coefficient in Bzier speed curve
-                      bezier_B,     // B coefficient in Bzier speed curve
-                      bezier_C;     // C coefficient in Bzier speed curve
-      static uint32_t bezier_F,     // F coefficient in Bzier speed curve
-                      bezier_AV;    // AV coefficient in Bzier speed curve
       #if ENABLED(__AVR__)
+        static int32_t  bezier_A,   // A coefficient in Bzier speed curve
+                        bezier_B,   // B coefficient in Bzier speed curve
+                        bezier_C;   // C coefficient in Bzier speed curve
+        static uint32_t bezier_F,   // F coefficient in Bzier speed curve
+                        bezier_AV;  // AV coefficient in Bzier speed curve
         static bool A_negative;     // If A coefficient was negative
+      #else
+        static const bezier_coeff_t *bezier;  // Bzier speed curve of the phase, from the block
       #endif
       static bool bezier_2nd_half;  // If Bzier curve has been initialized or not
     #endif
 
     static uint32_t nextMainISR;    // time remaining for the next Step ISR
+    #if ENABLED(INPUT_SHAPING)
+      static uint32_t nextShapingISR; // time remaining for the next echo of the input shaping
+    #endif
+    #if ENABLED(STEP_QUEUE)
+      static step_event_t sq_event;   // The entry of the step queue waiting for its interval
+      static bool         sq_pending;
+    #endif
     #if ENABLED(LIN_ADVANCE)
-      static uint32_t nextAdvanceISR, LA_isr_rate;
+      #if HAS_LIN_ADVANCE_ISR
+        static uint32_t nextAdvanceISR, LA_isr_rate;
+      #else
+        static uint32_t LA_adv_factor;          // advance steps for step rate, 16.16 fixed point
+        static uint16_t LA_target_adv_steps;
+        static int8_t   LA_dir;                 // E direction written, 0 for unknown
+      #endif
       static uint16_t LA_current_adv_steps, LA_final_adv_steps, LA_max_adv_steps;
       static int8_t   LA_steps;
       static bool     LA_use_advance_lead;
     #endif // !LIN_ADVANCE
 
     static int32_t ticks_nominal;
+    #if ENABLED(FEED_HOLD)
+      static feed_hold_t hold;
+    #endif
     #if DISABLED(BEZIER_JERK_CONTROL)
       static uint32_t acc_step_rate; // needed for deceleration start point
     #endif
 
     static xyz_long_t endstops_trigsteps;
 
+    #if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+      static trigger_capture_t capture;
+    #endif
+
     /**
      * Positions of stepper motors, in step units
      */
@@ -157,6 +233,9 @@ class Stepper {
 
     #if ENABLED(LASER)
       static int32_t delta_error_laser;
+      #if ENABLED(LASER_DYNAMIC_POWER)
+        static uint32_t laser_step_rate;  // Step rate of the last phase step, for the power
+      #endif
       #if ENABLED(LASER_RASTER)
         static int counter_raster;
       #endif
@@ -209,6 +288,11 @@ class Stepper {
      */
     static int32_t position(const AxisEnum axis);
 
+    /**
+     * Get the positions of all the motors at the same step
+     */
+    static void get_positions(xyze_long_t &pos);
+
     /**
      * Report the positions of the steppers, in steps
      */
@@ -220,9 +304,9 @@ class Stepper {
     static void reset_drivers();
 
     /**
-     * Set direction bits for all steppers
+     * Set direction bits of the steppers, only of the axes changed (default all)
      */
-    static void set_directions();
+    static void set_directions(uint8_t changed=0xFF);
 
     /**
      * The stepper subsystem goes to sleep when it runs out of things to execute. Call this
@@ -251,11 +335,32 @@ class Stepper {
      */
     static bool driver_is_enable();
 
+    /**
+     * Count of steps performed per Stepper ISR call
+     */
+    FORCE_INLINE static uint8_t get_steps_per_isr() { return steps_per_isr; }
+
+    #if ENABLED(ADAPTIVE_MULTISTEPPING)
+      /**
+       * Raise or lower the multistepping thresholds from the measured
+       * ISR load and planner starvation - Called from the main loop
+       */
+      static void adapt_multistepping();
+    #endif
+
     /**
      * Quickly stop all steppers and clear the blocks queue
      */
     FORCE_INLINE static void quick_stop() { abort_current_block = true; }
 
+    #if ENABLED(FEED_HOLD)
+      /**
+       * Slow down to a stop along the path, or back to the planned speed
+       */
+      static void feed_hold(const bool onoff);
+      FORCE_INLINE static bool is_held() { return hold.state == HOLD_STOPPED; }
+    #endif
+
     /**
      * The direction of a single motor
      */
@@ -284,6 +389,30 @@ class Stepper {
      */
     static void endstop_triggered(const AxisEnum axis);
 
+    #if ENABLED(STEP_COPROCESSOR)
+      /**
+       * A block done by the coprocessor, the sync of a sync block
+       */
+      static void coprocessor_block_done(const block_t* const block);
+
+      /**
+       * The position of the motors on the coprocessor and the axes stopped by an endstop
+       */
+      static void coprocessor_sync(const xyze_long_t &pos, const uint8_t hit_axes);
+    #endif
+
+    #if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+      /**
+       * Timestamp of an endstop edge, taken on entry of the endstop pin ISR.
+       * Only a trigger handled before capture_release() is interpolated.
+       */
+      FORCE_INLINE static void capture_edge() {
+        capture.edge_cycles = HAL_CYCLE_COUNTER();
+        capture.edge_valid = true;
+      }
+      FORCE_INLINE static void capture_release() { capture.edge_valid = false; }
+    #endif
+
     /**
      * Triggered position of an axis in steps
      */
@@ -322,6 +451,10 @@ class Stepper {
       FORCE_INLINE static void set_z_lock(const bool state) { locked_Z_motor = state; }
       FORCE_INLINE static void set_z2_lock(const bool state) { locked_Z2_motor = state; }
     #endif
+    #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+      // With separate multi axis a Z motor is locked after the given steps, a move for all the Z motors
+      FORCE_INLINE static void set_z_align_steps(const uint8_t z, const uint32_t steps) { z_align_steps[z] = steps; }
+    #endif
 
     // Set the current position in steps
     static void set_position(const int32_t &a, const int32_t &b, const int32_t &c, const int32_t &e);
@@ -336,6 +469,10 @@ class Stepper {
       static void babystep(const AxisEnum axis, const bool direction); // perform a short step with a single stepper motor, outside of any convention
     #endif
 
+    #if ENABLED(MESH_STEPPER_CORRECTION)
+      static void mesh_z_step(const bool up); // a Z step of the mesh correction, not counted in count_position
+    #endif
+
     #if ENABLED(LASER)
       static bool laser_status();
       FORCE_INLINE static float laser_intensity() { return current_block->laser_intensity; }
@@ -348,21 +485,64 @@ class Stepper {
      */
     static void driver_factory_parameters(Driver* act, const uint8_t index, const bool axis=true);
 
+    #if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+      /**
+       * Position at the captured endstop edge
+       */
+      static xyze_long_t edge_position();
+    #endif
+
     /**
      * Pulse phase Step
      */
     static void pulse_phase_step();
 
+    #if ENABLED(FEED_HOLD)
+      /**
+       * Feed hold: ramp of the scale for a block, interval of the scaled step rate
+       */
+      static uint32_t hold_ramp(const block_t * const block);
+      static uint32_t hold_interval(uint32_t &step_rate, uint32_t &profile_time);
+    #endif
+
     /**
      * Block phase Step
      */
     static uint32_t block_phase_step();
 
+    #if ENABLED(STEP_QUEUE)
+      /**
+       * Step queue Step, fire the due entries of the queue
+       */
+      static uint32_t step_queue_step();
+    #endif
+
+    /**
+     * Set the position of a sync block
+     */
+    static void sync_block_position(const block_t* const block);
+
     /**
      * Pulse tick prepare
      */
     FORCE_INLINE static void pulse_tick_prepare();
 
+    #if ENABLED(CNCROUTER_NATIVE_ARC)
+      /**
+       * One event of an arc: the major axis steps, the other one
+       * if the step brings the point nearer the circle
+       */
+      FORCE_INLINE static void arc_tick();
+
+      /**
+       * The interval of the events on the arc for a constant tangential speed,
+       * the speed along the major axis goes with the other coordinate
+       */
+      FORCE_INLINE static uint32_t arc_interval(const uint32_t interval) {
+        return uint32_t((uint64_t(interval) * (arc_scale / uint32_t(ABS(arc_b - 1)))) >> 8);
+      }
+    #endif
+
     /**
      * Pulse tick Start
      */
@@ -387,6 +567,10 @@ class Stepper {
     FORCE_INLINE static void stop_Y_step();
     FORCE_INLINE static void stop_Z_step();
 
+    #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+      FORCE_INLINE static void count_z_align_steps();
+    #endif
+
     /**
      * Set X Y Z direction
      */
@@ -396,6 +580,11 @@ class Stepper {
     FORCE_INLINE static void set_nor_E_dir(const uint8_t e=0);
     FORCE_INLINE static void set_rev_E_dir(const uint8_t e=0);
 
+    /**
+     * DIR setup time for the axes in axis_bits, the slowest of their drivers
+     */
+    FORCE_INLINE static uint32_t get_direction_delay(const uint8_t axis_bits);
+
     /**
      * Extruder Step for the single E axis
      */
@@ -420,13 +609,33 @@ class Stepper {
       static uint8_t get_active_extruder_driver();
     #endif
 
-    #if ENABLED(LIN_ADVANCE)
+    #if ENABLED(INPUT_SHAPING)
+      // The echo impulses of the input shaping
+      static void shaping_isr();
+      // Direction and position of a shaped step, false for no step
+      FORCE_INLINE static bool shaping_step(const AxisEnum axis, const int8_t dir);
+      FORCE_INLINE static bool shaping_echo(const AxisEnum axis, bool &due);
+    #endif
+
+    #if HAS_LIN_ADVANCE_ISR
       // The Linear advance stepper Step
       static uint32_t lin_advance_step();
+    #elif ENABLED(LIN_ADVANCE)
+      // The advance steps for the step rate
+      FORCE_INLINE static void lin_advance_target(const uint32_t step_rate) {
+        if (LA_use_advance_lead) {
+          const uint32_t target = (step_rate * LA_adv_factor) >> 16;
+          LA_target_adv_steps = MIN(target, uint32_t(LA_max_adv_steps));
+        }
+      }
+      // Blend the advance steps in the E step of a step event
+      FORCE_INLINE static void lin_advance_blend();
     #endif
 
     #if ENABLED(BEZIER_JERK_CONTROL)
-      static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
+      #if ENABLED(__AVR__)
+        static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
+      #endif
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
     #endif
 
@@ -460,7 +669,11 @@ class Stepper {
       if (data.quad_stepping) {
         // Select the proper multistepping
         uint8_t idx = 0;
-        while (idx < 7 && step_rate > HAL_frequency_limit[idx]) {
+        #if ENABLED(ADAPTIVE_MULTISTEPPING)
+          while (idx < 7 && step_rate > (HAL_frequency_limit[idx] >> multistep_bias)) {
+        #else
+          while (idx < 7 && step_rate > HAL_frequency_limit[idx]) {
+        #endif
           step_rate >>= 1;
           multistep <<= 1;
           ++idx;
@@ -472,8 +685,8 @@ class Stepper {
       *loops = multistep;
 
       #if ENABLED(CPU_32_BIT)
-        // In case of high-performance processor, it is able to calculate in real-time
-        return uint32_t(STEPPER_TIMER_RATE) / step_rate;
+        // Interpolated reciprocal table, no divide in the ISR
+        return speed_lookup_32(step_rate);
       #else
         hal_timer_t timer;
         constexpr uint32_t min_step_rate = F_CPU / 500000U;
@@ -0,0 +1,241 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * step_queue.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(STEP_QUEUE)
+
+StepQueue stepQueue;
+
+/** Public Parameters */
+bool          StepQueue::enabled    = false;
+volatile bool StepQueue::timing     = false;
+step_timing_t StepQueue::step_time[XYZE];
+uint16_t      StepQueue::underruns  = 0,
+              StepQueue::max_level  = 0;
+
+/** Private Parameters */
+step_event_t      StepQueue::buffer[STEP_QUEUE_SIZE];
+volatile uint16_t StepQueue::head           = 0,
+                  StepQueue::tail           = 0;
+volatile bool     StepQueue::block_aborted  = false,
+                  StepQueue::flushed        = false;
+bool              StepQueue::starved        = false;
+
+block_t*  StepQueue::block        = nullptr;
+uint8_t   StepQueue::block_index  = 0;
+uint32_t  StepQueue::event_count  = 0,
+          StepQueue::steps[XYZE],
+          StepQueue::done[XYZE];
+int32_t   StepQueue::next_ticks[XYZE],
+          StepQueue::last_ticks   = 0,
+          StepQueue::block_ticks  = 0;
+float     StepQueue::v0           = 0,
+          StepQueue::vc           = 0,
+          StepQueue::accel_steps  = 0,
+          StepQueue::decel_start  = 0,
+          StepQueue::a_x2         = 0,
+          StepQueue::ticks_per_a  = 0,
+          StepQueue::ticks_per_vc = 0,
+          StepQueue::cruise_ticks = 0,
+          StepQueue::decel_ticks  = 0;
+
+/** Public Function */
+void StepQueue::set_enabled(const bool onoff) {
+
+  planner.synchronize();
+
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+
+  enabled = onoff;
+  head = tail = 0;
+  block = nullptr;
+  block_index = planner.block_buffer_tail;
+  block_aborted = flushed = false;
+  last_ticks = 0;
+
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+}
+
+void StepQueue::fill() {
+
+  if (!enabled) return;
+
+  // A quick stop emptied the planner
+  if (flushed) {
+    flushed = block_aborted = false;
+    block = nullptr;
+    block_index = planner.block_buffer_tail;
+    last_ticks = 0;
+  }
+
+  for (;;) {
+
+    // The Stepper ISR aborted the block, it is already out of the planner
+    if (block_aborted) {
+      block_aborted = false;
+      block = nullptr;
+      last_ticks = 0;
+    }
+
+    if (!block) {
+
+      if (room() < 2) return;
+
+      // The newest block waits for the queue to run low, till then the planner can still raise its exit speed
+      if (BLOCK_MOD(block_index + 1) == planner.block_buffer_head && level() > (STEP_QUEUE_SIZE) / 4) return;
+
+      block_t* const b = planner.get_queue_block(block_index);
+      if (!b) return;
+      block_index = BLOCK_MOD(block_index + 1);
+
+      if (TEST(b->flag, BLOCK_BIT_SYNC_POSITION))
+        push(0, 0, STEP_EVENT_SYNC);
+      else
+        start_block(b);
+
+      continue;
+    }
+
+    // The nearest step of the motors
+    int32_t t = INT32_MAX;
+    LOOP_XYZE(i) if (done[i] < steps[i]) NOMORE(t, next_ticks[i]);
+
+    // All the steps are queued, the time of the next block starts from the end of this one
+    if (t == INT32_MAX) {
+      const bool isr_enabled = STEPPER_ISR_ENABLED();
+      if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+      if (!block_aborted) push(0, 0, STEP_EVENT_BLOCK_END);
+      block_aborted = false;
+      if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+      block = nullptr;
+      last_ticks -= block_ticks;
+      continue;
+    }
+
+    // Hold the shortest interval, the longest ones take more entries
+    NOLESS(t, last_ticks + int32_t(STEP_QUEUE_MIN_TICKS));
+    uint32_t wait = uint32_t(t - last_ticks);
+    if (room() < wait / 0xFFFF + 2) return;
+    for (; wait > 0xFFFF; wait -= 0xFFFF) push(0xFFFF, 0, STEP_EVENT_STEP);
+
+    // The motors with a step in the interval step together
+    uint8_t mask = 0;
+    LOOP_XYZE(i) {
+      if (done[i] < steps[i] && next_ticks[i] <= t) {
+        SBI(mask, i);
+        if (++done[i] < steps[i])
+          next_ticks[i] = ticks_at((done[i] + 0.5f) * event_count / steps[i]);
+      }
+    }
+
+    push(uint16_t(wait), mask, STEP_EVENT_STEP);
+    last_ticks = t;
+  }
+
+}
+
+void StepQueue::flush() {
+  tail = head;
+  flushed = true;
+}
+
+bool StepQueue::is_block_queued(const block_t* const b) {
+  if (flushed) return false;
+  const uint8_t t = planner.block_buffer_tail;
+  return BLOCK_MOD(uint8_t(b - planner.block_buffer) - t) < BLOCK_MOD(block_index - t);
+}
+
+void StepQueue::reset_stats() {
+  underruns = max_level = 0;
+}
+
+void StepQueue::print_stats() {
+  SERIAL_ONOFF("Step queue", enabled);
+  SERIAL_MV(" size:", int(STEP_QUEUE_SIZE));
+  SERIAL_MV(" max_level:", max_level);
+  SERIAL_MV(" underruns:", underruns);
+  SERIAL_EMV(" max_rate:", int32_t(1000000UL / (STEP_QUEUE_MIN_INTERVAL)));
+}
+
+/** Private Function */
+void StepQueue::push(const uint16_t interval, const uint8_t steps, const uint8_t type) {
+  const uint16_t h = head;
+  step_event_t &ev = buffer[h];
+  ev.interval = interval;
+  ev.steps = steps;
+  ev.type = type;
+  sw_barrier();
+  head = (h + 1) & (STEP_QUEUE_SIZE - 1);
+  NOLESS(max_level, level());
+}
+
+void StepQueue::start_block(block_t* const b) {
+
+  block = b;
+  event_count = b->step_event_count;
+
+  const float a = b->acceleration_steps_per_s2;
+  v0          = b->initial_rate;
+  a_x2        = 2.0f * a;
+  accel_steps = a > 0 ? b->accelerate_until : 0;
+  decel_start = a > 0 ? b->decelerate_after : event_count;
+  ticks_per_a = a > 0 ? float(STEPPER_TIMER_RATE) / a : 0;
+
+  // The top speed, the trapezoid may not reach the nominal rate
+  const float v1 = SQRT(sq(v0) + a_x2 * accel_steps);
+  vc = MAX(MIN(v1, float(b->nominal_rate)), 1.0f);
+  ticks_per_vc = float(STEPPER_TIMER_RATE) / vc;
+
+  cruise_ticks = (v1 - v0) * ticks_per_a;
+  decel_ticks  = cruise_ticks + (decel_start - accel_steps) * ticks_per_vc;
+  block_ticks  = ticks_at(event_count);
+
+  // The k-th step of a motor is at the middle of its k-th share of the main axis
+  LOOP_XYZE(i) {
+    steps[i] = b->steps[i];
+    done[i] = 0;
+    if (steps[i]) next_ticks[i] = ticks_at(0.5f * event_count / steps[i]);
+  }
+
+  push(0, 0, STEP_EVENT_BLOCK_START);
+}
+
+int32_t StepQueue::ticks_at(const float s) {
+  float t;
+  if (s <= accel_steps)
+    t = (SQRT(sq(v0) + a_x2 * s) - v0) * ticks_per_a;
+  else if (s <= decel_start)
+    t = cruise_ticks + (s - accel_steps) * ticks_per_vc;
+  else
+    t = decel_ticks + (vc - SQRT(MAX(sq(vc) - a_x2 * (s - decel_start), 0.0f))) * ticks_per_a;
+  return LROUND(t);
+}
+
+#endif // ENABLED(STEP_QUEUE)
@@ -0,0 +1,208 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * step_queue.h
+ *
+ * Step queue mode. The main loop computes the time of every step of every
+ * motor from the trapezoid of the block and queues it as the interval from
+ * the previous entry, steps closer than the shortest interval share an entry.
+ * The Stepper ISR takes the next entry, fires its steps and waits the interval
+ * of the following one, so every motor steps at its own time.
+ *
+ * The blocks stay in the planner till the ISR reaches their end entry, so the
+ * planner queue works as with the Bresenham ISR.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(STEP_QUEUE)
+
+#define STEP_QUEUE_MIN_TICKS  ((STEP_QUEUE_MIN_INTERVAL) * (STEPPER_TIMER_TICKS_PER_US))
+
+enum StepEventEnum : uint8_t {
+  STEP_EVENT_STEP,          // Steps of the motors, none for a wait
+  STEP_EVENT_BLOCK_START,   // First entry of a block, the ISR takes the block
+  STEP_EVENT_BLOCK_END,     // Last entry of a block, the ISR discards the block
+  STEP_EVENT_SYNC           // A sync block, the ISR sets the position
+};
+
+// Struct Step event, an entry of the queue
+typedef struct {
+  uint16_t  interval;       // Stepper ticks from the previous entry
+  uint8_t   steps,          // Motors to step, a bit for each of X Y Z E
+            type;           // StepEventEnum
+} step_event_t;
+
+// Struct Step timing of a motor, for the benchmark of M130, in HAL_CYCLE_COUNTER() units
+struct step_timing_t {
+
+  hal_cycle_t last;         // Cycle of the last step
+  uint32_t    interval,     // Interval before the last step
+              min,          // Shortest interval, the highest step rate
+              jitter_max,   // Largest change of the interval between two steps
+              jitter_sum,
+              count;        // Steps
+
+  void reset() { interval = jitter_max = jitter_sum = count = 0; min = 0xFFFFFFFFUL; }
+
+  FORCE_INLINE void step(const hal_cycle_t now) {
+    if (count) {
+      const uint32_t iv = hal_cycle_t(now - last);
+      if (count > 1) {
+        const uint32_t j = iv > interval ? iv - interval : interval - iv;
+        jitter_sum += j;
+        NOLESS(jitter_max, j);
+      }
+      NOMORE(min, iv);
+      interval = iv;
+    }
+    last = now;
+    count++;
+  }
+
+};
+
+class StepQueue {
+
+  public: /** Constructor */
+
+    StepQueue() {}
+
+  public: /** Public Parameters */
+
+    static bool           enabled;          // Step queue instead of the Bresenham ISR
+    static volatile bool  timing;           // Take the time of the steps
+    static step_timing_t  step_time[XYZE];
+    static uint16_t       underruns,        // Times the queue ran dry in a block
+                          max_level;        // Most entries in the queue
+
+  private: /** Private Parameters */
+
+    static step_event_t       buffer[STEP_QUEUE_SIZE];
+    static volatile uint16_t  head, tail;
+    static volatile bool      block_aborted,  // The block being queued was dropped by the ISR
+                              flushed;        // All the blocks were dropped
+    static bool               starved;
+
+    // The block being queued
+    static block_t*     block;
+    static uint8_t      block_index;        // The next block to take from the planner
+    static uint32_t     event_count,
+                        steps[XYZE],
+                        done[XYZE];
+    static int32_t      next_ticks[XYZE],   // Time of the next step of each motor from the block start
+                        last_ticks,         // Time of the last entry from the block start
+                        block_ticks;        // Time of the block
+    static float        v0, vc, accel_steps, decel_start,
+                        a_x2, ticks_per_a, ticks_per_vc,
+                        cruise_ticks, decel_ticks;
+
+  public: /** Public Function */
+
+    /**
+     * Select the mode, with no moves queued
+     */
+    static void set_enabled(const bool onoff);
+
+    /**
+     * Queue the steps of the planner blocks while there is room
+     * Called from the main loop
+     */
+    static void fill();
+
+    /**
+     * Drop all the entries, the planner queue is emptied
+     * Called by Planner::quick_stop with the Stepper ISR disabled
+     */
+    static void flush();
+
+    /**
+     * The block is taken by the queue, read only for the planner
+     */
+    static bool is_block_queued(const block_t* const b);
+
+    static void reset_stats();
+    static void print_stats();
+
+    /**
+     * Take the next entry, false for none
+     * Called from the Stepper ISR
+     */
+    FORCE_INLINE static bool pop(step_event_t &ev) {
+      const uint16_t t = tail;
+      if (t == head) return false;
+      ev = buffer[t];
+      sw_barrier();
+      tail = (t + 1) & (STEP_QUEUE_SIZE - 1);
+      starved = false;
+      return true;
+    }
+
+    /**
+     * The queue ran dry in a block
+     * Called from the Stepper ISR
+     */
+    FORCE_INLINE static void starving() {
+      if (!starved) { starved = true; underruns++; }
+    }
+
+    /**
+     * Skip the entries of the current block, it was aborted
+     * Called from the Stepper ISR
+     */
+    FORCE_INLINE static void drop_block() {
+      step_event_t ev;
+      while (pop(ev)) if (ev.type == STEP_EVENT_BLOCK_END) return;
+      // Still queueing the block, the main loop drops it
+      block_aborted = true;
+    }
+
+    /**
+     * Take the time of the steps to do
+     * Called from the Stepper ISR
+     */
+    FORCE_INLINE static void time_steps(const xyze_bool_t &step) {
+      const hal_cycle_t now = HAL_CYCLE_COUNTER();
+      LOOP_XYZE(i) if (step[i]) step_time[i].step(now);
+    }
+
+  private: /** Private Function */
+
+    FORCE_INLINE static uint16_t level() { return (head - tail) & (STEP_QUEUE_SIZE - 1); }
+    FORCE_INLINE static uint16_t room()  { return (STEP_QUEUE_SIZE - 1) - level(); }
+
+    static void push(const uint16_t interval, const uint8_t steps, const uint8_t type);
+
+    static void start_block(block_t* const b);
+
+    /**
+     * Stepper ticks from the block start to the position s in steps of the main axis
+     */
+    static int32_t ticks_at(const float s);
+
+};
+
+extern StepQueue stepQueue;
+
+#endif // ENABLED(STEP_QUEUE)
@@ -60,6 +60,34 @@
 #endif
 #undef INVALID_TMC_SPI
 
+#if ENABLED(TMC_IDLE_CURRENT)
+  #if !HAS_TRINAMIC
+    #error "DEPENDENCY ERROR: TMC_IDLE_CURRENT requires TMC drivers."
+  #elif DISABLED(TMC_IDLE_CURRENT_PERCENT) || DISABLED(TMC_IDLE_CURRENT_DELAY)
+    #error "DEPENDENCY ERROR: Missing setting TMC_IDLE_CURRENT_PERCENT or TMC_IDLE_CURRENT_DELAY."
+  #elif !WITHIN(TMC_IDLE_CURRENT_PERCENT, 1, 100)
+    #error "DEPENDENCY ERROR: TMC_IDLE_CURRENT_PERCENT must be from 1 to 100."
+  #elif TMC_IDLE_CURRENT_DELAY < 1
+    #error "DEPENDENCY ERROR: TMC_IDLE_CURRENT_DELAY must be 1 or more seconds."
+  #endif
+#endif
+
+#if ENABLED(SPI_ENDSTOPS_POLL_MS)
+  #if DISABLED(SPI_ENDSTOPS)
+    #error "DEPENDENCY ERROR: SPI_ENDSTOPS_POLL_MS requires SPI_ENDSTOPS."
+  #elif !WITHIN(SPI_ENDSTOPS_POLL_MS, 1, 50)
+    #error "DEPENDENCY ERROR: SPI_ENDSTOPS_POLL_MS must be from 1 to 50."
+  #endif
+#endif
+
+#if ENABLED(TMC_SPI_BATCH)
+  #if !HAS_TMCX1XX
+    #error "DEPENDENCY ERROR: TMC_SPI_BATCH requires TMC2130, TMC2160, TMC5130 or TMC5160 drivers."
+  #elif ENABLED(TMC_USE_SW_SPI)
+    #error "DEPENDENCY ERROR: TMC_SPI_BATCH requires hardware SPI, disable TMC_USE_SW_SPI."
+  #endif
+#endif
+
 /**
  * Check existing RX/TX pins against enable TMC UART drivers.
  */
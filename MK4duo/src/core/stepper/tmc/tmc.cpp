@@ -45,6 +45,10 @@ TMC_Stepper tmc;
 /** Private Parameters */
 uint16_t TMC_Stepper::report_status_interval = 0;
 
+#if ENABLED(TMC_IDLE_CURRENT)
+  bool TMC_Stepper::on_idle_current = false;
+#endif
+
 /** Public Function */
 void TMC_Stepper::init_cs_pins() {
   #if PIN_EXISTS(X_CS)
@@ -440,6 +444,27 @@ void TMC_Stepper::restore() {
   LOOP_DRV() if (driver[d] && driver[d]->tmc) driver[d]->tmc->push();
 }
 
+#if ENABLED(TMC_IDLE_CURRENT)
+
+  /**
+   * The idle current is TMC_IDLE_CURRENT_PERCENT of the run current.
+   * val_mA keeps the run current of M906, the one written back.
+   */
+  void TMC_Stepper::set_idle_current(const bool onoff) {
+    if (onoff == on_idle_current) return;
+    on_idle_current = onoff;
+    LOOP_DRV() {
+      Driver* drv = driver[d];
+      if (drv && drv->tmc) {
+        const uint16_t run_mA = drv->tmc->val_mA;
+        drv->tmc->rms_current(onoff ? uint16_t(uint32_t(run_mA) * (TMC_IDLE_CURRENT_PERCENT) / 100) : run_mA);
+        drv->tmc->val_mA = run_mA;
+      }
+    }
+  }
+
+#endif
+
 void TMC_Stepper::test_connection(const bool test_x, const bool test_y, const bool test_z, const bool test_e) {
   uint8_t axis_connection = 0;
 
@@ -514,6 +539,9 @@ void TMC_Stepper::test_connection(const bool test_x, const bool test_y, const bo
     #endif
 
     if (need_update_error_counters || need_debug_reporting) {
+      #if ENABLED(TMC_SPI_BATCH)
+        read_status_batch();
+      #endif
       LOOP_DRV_ALL_XYZ()
         if (driver[d] && driver[d]->tmc) monitor_driver(driver[d], need_update_error_counters, need_debug_reporting);
       LOOP_DRV_EXT()
@@ -527,6 +555,62 @@ void TMC_Stepper::test_connection(const bool test_x, const bool test_y, const bo
 
 #endif // ENABLED(MONITOR_DRIVER_STATUS)
 
+#if ENABLED(TMC_SPI_BATCH)
+
+  /**
+   * Read regs registers of n drivers in a single SPI transaction.
+   * The answer to a read comes with the next datagram, so the first pass
+   * only requests and each following pass also requests the next register:
+   * n * (regs + 1) datagrams instead of n * regs * 2.
+   * data gets regs values for each driver.
+   */
+  void TMC_Stepper::spi_batch_read(MKTMC* const tmc_list[], const uint8_t n, const uint8_t addr[], const uint8_t regs, uint32_t * const data) {
+    SPI.beginTransaction(SPISettings(TMC_MODEL_LIB::spi_speed, MSBFIRST, SPI_MODE3));
+    LOOP_L_N(r, regs + 1) {
+      const uint8_t next = addr[r < regs ? r : 0];
+      LOOP_L_N(i, n) {
+        const uint32_t value = tmc_list[i]->spi_pipe(next);
+        if (r) data[i * regs + r - 1] = value;
+      }
+    }
+    SPI.endTransaction();
+  }
+
+  #if ENABLED(MONITOR_DRIVER_STATUS)
+
+    void TMC_Stepper::read_status_batch() {
+
+      #if ENABLED(TMC_DEBUG)
+        static constexpr uint8_t addr[] = { TMC_REG_DRV_STATUS, TMC_REG_PWM_SCALE };
+      #else
+        static constexpr uint8_t addr[] = { TMC_REG_DRV_STATUS };
+      #endif
+
+      MKTMC* tmc_list[MAX_DRIVER_XYZ + MAX_DRIVER_E];
+      uint32_t data[COUNT(tmc_list) * COUNT(addr)];
+      uint8_t n = 0;
+
+      LOOP_DRV_ALL_XYZ()
+        if (driver[d] && driver[d]->tmc) tmc_list[n++] = driver[d]->tmc;
+      LOOP_DRV_EXT()
+        if (driver.e[d] && driver.e[d]->tmc) tmc_list[n++] = driver.e[d]->tmc;
+
+      if (!n) return;
+
+      spi_batch_read(tmc_list, n, addr, COUNT(addr), data);
+
+      LOOP_L_N(i, n) {
+        tmc_list[i]->batch_drv_status = data[i * COUNT(addr)];
+        #if ENABLED(TMC_DEBUG)
+          tmc_list[i]->batch_pwm_scale = data[i * COUNT(addr) + 1];
+        #endif
+      }
+    }
+
+  #endif // MONITOR_DRIVER_STATUS
+
+#endif // TMC_SPI_BATCH
+
 #if HAS_SENSORLESS
 
   bool TMC_Stepper::enable_stallguard(Driver* drv) {
@@ -1127,7 +1211,11 @@ bool TMC_Stepper::test_connection(Driver* drv) {
     #elif HAVE_DRV(TMC2660)
       uint32_t TMC_Stepper::get_pwm_scale(Driver* drv) { UNUSED(drv); return 0; }
     #elif HAS_TMCX1XX
-      uint32_t TMC_Stepper::get_pwm_scale(Driver* drv) { return drv->tmc->PWM_SCALE(); }
+      #if ENABLED(TMC_SPI_BATCH)
+        uint32_t TMC_Stepper::get_pwm_scale(Driver* drv) { return drv->tmc->batch_pwm_scale; }
+      #else
+        uint32_t TMC_Stepper::get_pwm_scale(Driver* drv) { return drv->tmc->PWM_SCALE(); }
+      #endif
     #endif
   #endif
 
@@ -1198,7 +1286,11 @@ bool TMC_Stepper::test_connection(Driver* drv) {
         constexpr uint8_t STST_bp = 31;
       #endif
       TMC_driver_data data;
-      const auto ds = data.drv_status = drv->tmc->DRV_STATUS();
+      #if ENABLED(TMC_SPI_BATCH)
+        const auto ds = data.drv_status = drv->tmc->batch_drv_status;
+      #else
+        const auto ds = data.drv_status = drv->tmc->DRV_STATUS();
+      #endif
       #ifdef __AVR__
         // 8-bit optimization saves up to 70 bytes of PROGMEM per axis
         uint8_t spart;
@@ -85,6 +85,13 @@ static constexpr chopper_timing_t chopper_timing = CHOPPER_TIMING;
 static constexpr int8_t sgt_min = -64,
                         sgt_max =  63;
 
+#if ENABLED(TMC_SPI_BATCH)
+  // Registers of the pipelined reads
+  static constexpr uint8_t  TMC_REG_DRV_STATUS  = 0x6F,
+                            TMC_REG_PWM_SCALE   = 0x71,
+                            TMC_STALL_GUARD_bp  = 24;
+#endif
+
 extern bool report_tmc_status;
 
 constexpr uint16_t _tmc_thrs(const uint16_t msteps, const uint32_t thrs, const uint32_t spmm) {
@@ -349,6 +356,30 @@ class TMCStorage {
         }
       #endif
 
+      #if ENABLED(TMC_SPI_BATCH)
+
+        // Last values of TMC_Stepper::read_status_batch()
+        uint32_t batch_drv_status = 0;
+        #if ENABLED(TMC_DEBUG)
+          uint32_t batch_pwm_scale = 0;
+        #endif
+
+        /**
+         * One datagram of a pipelined read: request the register addr
+         * and return the data asked by the previous datagram.
+         * Call inside an SPI transaction.
+         */
+        uint32_t spi_pipe(const uint8_t addr) {
+          uint32_t data = 0;
+          this->switchCSpin(LOW);
+          this->status_response = SPI.transfer(addr & 0x7F);
+          LOOP_L_N(i, 4) data = (data << 8) | SPI.transfer(0x00);
+          this->switchCSpin(HIGH);
+          return data;
+        }
+
+      #endif // TMC_SPI_BATCH
+
       #if ENABLED(SPI_ENDSTOPS)
 
         bool test_stall_status() {
@@ -393,6 +424,10 @@ class TMC_Stepper {
 
     static uint16_t report_status_interval;
 
+    #if ENABLED(TMC_IDLE_CURRENT)
+      static bool on_idle_current;
+    #endif
+
   public: /** Public Function */
 
     static void init_cs_pins();
@@ -405,10 +440,20 @@ class TMC_Stepper {
 
     static void test_connection(const bool test_x, const bool test_y, const bool test_z, const bool test_e);
 
+    #if ENABLED(TMC_IDLE_CURRENT)
+      static void set_idle_current(const bool onoff);
+      // Run current back, before a new block after the idle
+      FORCE_INLINE static void run_current() { if (on_idle_current) set_idle_current(false); }
+    #endif
+
     #if ENABLED(MONITOR_DRIVER_STATUS)
       static void monitor_drivers();
     #endif
 
+    #if ENABLED(TMC_SPI_BATCH)
+      static void spi_batch_read(MKTMC* const tmc_list[], const uint8_t n, const uint8_t addr[], const uint8_t regs, uint32_t * const data);
+    #endif
+
     #if HAS_SENSORLESS
       static bool enable_stallguard(Driver* drv);
       static void disable_stallguard(Driver* drv, const bool enable);
@@ -479,6 +524,10 @@ class TMC_Stepper {
         #endif
       #endif
 
+      #if ENABLED(TMC_SPI_BATCH)
+        static void read_status_batch();
+      #endif
+
       static TMC_driver_data get_driver_data(Driver* drv);
       static void monitor_driver(Driver* drv, const bool need_update_error_counters, const bool need_debug_reporting);
 
@@ -45,6 +45,9 @@ float DHTSensor::temperature  = 25,
 /** Private Parameters */
 uint8_t DHTSensor::read_data[5] = { 0, 0, 0, 0, 0 };
 
+DHTStateEnum  DHTSensor::state    = DHTIdle;
+millis_s      DHTSensor::state_ms = 0;
+
 // ISR Parameters
 volatile uint16_t lastPulseTime;
 volatile uint8_t numPulses;
@@ -62,7 +65,12 @@ extern "C" void DHT_ISR() {
 }
 
 /** Public Function */
-void DHTSensor::init() { /*HAL::pinMode(data.pin, OUTPUT);*/ }
+void DHTSensor::init() {
+  // Stop a reading in progress, after this the pin can be changed
+  if (state == DHTReading) detachInterrupt(data.pin);
+  state     = DHTIdle;
+  state_ms  = millis();
+}
 
 void DHTSensor::factory_parameters() {
   data.pin  = DHT_DATA_PIN;
@@ -97,59 +105,71 @@ void DHTSensor::print_M305() {
   SERIAL_EOL();
 }
 
+/**
+ * Read the sensor as a state machine, every step is checked at each call
+ * and only the few microseconds of the end of the start signal are waited.
+ * The ISR takes the pulses (1 start bit + 40 data bits), typically in 4 to 5ms.
+ */
 void DHTSensor::spin() {
 
-  static short_timer_t min_read_timer(millis());
+  const millis_s now = millis();
 
-  if (min_read_timer.pending(DHTMinimumReadInterval)) return;
+  switch (state) {
 
-  // Start the reading process
-  HAL::pinMode(data.pin, INPUT_PULLUP);
-  delay(1);
+    case DHTIdle:
+      if (millis_s(now - state_ms) < DHTMinimumReadInterval) return;
+      // Start the reading process
+      HAL::pinMode(data.pin, INPUT_PULLUP);
+      state = DHTPullup;
+      break;
 
-  // First set data line low for a period according to sensor type
-  HAL::pinMode(data.pin, OUTPUT_LOW);
-  switch (data.type) {
-    case DHT22:
-    case DHT21:
-      HAL::delayMicroseconds(1100); // data sheet says "at least 1ms"
+    case DHTPullup:
+      if (millis_s(now - state_ms) < 2) return;
+      // First set data line low for a period according to sensor type
+      HAL::pinMode(data.pin, OUTPUT_LOW);
+      state = DHTStartSignal;
       break;
-    default:
-      delay(20); // data sheet says at least 18ms, 20ms just to be safe
+
+    case DHTStartSignal:
+      // Data sheet says at least 1ms for DHT21 and DHT22, at least 18ms for the other
+      if (millis_s(now - state_ms) < ((data.type == DHT22 || data.type == DHT21) ? 2 : 20)) return;
+
+      // End the start signal by setting data line high. The sensor will respond with the start bit in 20 to 40us.
+      // We need only force the data line high long enough to charge the line capacitance, after that the pullup resistor keeps it high.
+      // This will generate an interrupt, but we will ignore it
+      HAL::digitalWrite(data.pin, HIGH);
+      HAL::delayMicroseconds(3);
+
+      // End the start signal by setting data line high for 40 microseconds.
+      HAL::pinMode(data.pin, INPUT_PULLUP);
+      // Delay a bit to let sensor pull data line low.
+      HAL::delayMicroseconds(55);
+
+      // Turn off interrupts temporarily because the next sections
+      // are timing critical and we don't want any interruptions.
+      DISABLE_ISRS();
+        // Now start reading the data line to get the value from the DHT sensor.
+        // Read from the DHT sensor using an DHT_ISR
+        numPulses = COUNT(pulses);
+        attachInterrupt(digitalPinToInterrupt(data.pin), DHT_ISR, CHANGE);
+        lastPulseTime = 0;
+        numPulses = 0;
+      ENABLE_ISRS();
+      state = DHTReading;
       break;
+
+    case DHTReading:
+      // Wait for the incoming signal to be read by the ISR, or until timeout.
+      if (numPulses < COUNT(pulses) && millis_s(now - state_ms) < DHTMaximumReadTime) return;
+      detachInterrupt(data.pin);
+      // Attempt to convert the signal into temp + RH values
+      process_reading();
+      state = DHTIdle;
+      break;
+
   }
 
-  // End the start signal by setting data line high. The sensor will respond with the start bit in 20 to 40us.
-  // We need only force the data line high long enough to charge the line capacitance, after that the pullup resistor keeps it high.
-  // This will generate an interrupt, but we will ignore it
-  HAL::digitalWrite(data.pin, HIGH);
-  HAL::delayMicroseconds(3);
-
-  // End the start signal by setting data line high for 40 microseconds.
-  HAL::pinMode(data.pin, INPUT_PULLUP);
-  // Delay a bit to let sensor pull data line low.
-  HAL::delayMicroseconds(55);
-
-  // Turn off interrupts temporarily because the next sections
-  // are timing critical and we don't want any interruptions.
-  DISABLE_ISRS();
-    // Now start reading the data line to get the value from the DHT sensor.
-    // Read from the DHT sensor using an DHT_ISR
-    numPulses = COUNT(pulses);
-    attachInterrupt(digitalPinToInterrupt(data.pin), DHT_ISR, CHANGE);
-    lastPulseTime = 0;
-    numPulses = 0;
-  ENABLE_ISRS();
-
-  // Wait for the incoming signal to be read by the ISR (1 start bit + 40 data bits), or until timeout.
-  // We don't have the ISR wake the process up, because that would require the priority of the pin change interrupt to be reduced.
-  // So we just delay for long enough for the data to have been sent. It takes typically 4 to 5ms.
-  delay(DHTMaximumReadTime);
-
-  detachInterrupt(data.pin);
-
-  // Attempt to convert the signal into temp + RH values
-  process_reading();
+  state_ms = now;
 
 }
 
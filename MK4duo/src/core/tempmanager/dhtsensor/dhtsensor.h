@@ -32,6 +32,9 @@
 // Define types of sensors.
 enum DHTEnum : uint8_t { DHT11=11, DHT12=12, DHT21=21, DHT22=22 };
 
+// Steps of a reading, each one waits in spin() without blocking
+enum DHTStateEnum : uint8_t { DHTIdle, DHTPullup, DHTStartSignal, DHTReading };
+
 // Struct DHT data
 typedef struct {
   pin_t   pin;
@@ -55,6 +58,9 @@ class DHTSensor {
 
     static uint8_t read_data[5];
 
+    static DHTStateEnum state;
+    static millis_s     state_ms;
+
   public: /** Public Function */
 
     static void init();
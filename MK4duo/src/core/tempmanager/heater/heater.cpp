@@ -46,13 +46,26 @@ void Heater::init() {
   // Reset valor
   pwm_value             = 0;
   pwm_soft_pos          = 0;
+  pwm_hw_pin            = NoPin;
   consecutive_low_temp  = 0;
   target_temperature    = 0;
   idle_temperature      = 0;
+
+  #if ENABLED(HEAT_IN_BACKGROUND)
+    deferred_wait       = 0;
+  #endif
   data.sensor.adc_raw   = 0;
 
   current_temperature   = 25.0;
 
+  #if ENABLED(HOTEND_MPC)
+    mpc_reset(current_temperature);
+  #endif
+
+  #if ENABLED(TEMP_HISTORY)
+    history.reset();
+  #endif
+
   setActive(false);
   setIdle(false);
   ResetFault();
@@ -66,6 +79,9 @@ void Heater::init() {
   thermal_runaway_state = TRInactive;
 
   data.sensor.CalcDerivedParameters();
+  #if ENABLED(THERMISTOR_TABLE)
+    sensor_table.build(data.sensor);
+  #endif
 
   if (printer.isRunning()) return; // All running not reinitialize
 
@@ -81,6 +97,10 @@ void Heater::init() {
 
 void Heater::set_target_temp(const int16_t celsius) {
 
+  #if ENABLED(HEAT_IN_BACKGROUND)
+    deferred_wait = 0;  // A new target drops the wait still pending
+  #endif
+
   if (celsius == 0)
     SwitchOff();
   else if (!isPidTuned() && isUsePid()) {
@@ -199,6 +219,22 @@ void Heater::wait_for_target(bool no_wait_for_cooling/*=true*/) {
   printer.setAutoreportTemp(oldReport);
 }
 
+#if ENABLED(HEAT_IN_BACKGROUND)
+
+  void Heater::defer_wait(const bool no_wait_for_cooling/*=true*/) {
+    deferred_wait = no_wait_for_cooling ? 1 : 2;
+    tempManager.deferred_waits = true;
+  }
+
+  void Heater::wait_deferred() {
+    if (!deferred_wait) return;
+    const bool no_wait_for_cooling = deferred_wait == 1;
+    deferred_wait = 0;
+    wait_for_target(no_wait_for_cooling);
+  }
+
+#endif
+
 void Heater::get_output() {
 
   update_idle_timer();
@@ -211,7 +247,7 @@ void Heater::get_output() {
     #if HAS_COOLERS
       if (type == IS_COOLER) {
         if (isUsePid()) {
-          pwm_value = data.pid.compute(current_temperature, targetTemperature
+          pwm_value = data.pid.compute(pid_interval, current_temperature, targetTemperature
             #if ENABLED(PID_ADD_EXTRUSION_RATE)
               , 0xFF
             #endif
@@ -223,11 +259,16 @@ void Heater::get_output() {
       else
     #endif
       {
+        #if ENABLED(HOTEND_MPC)
+          if (isUsePid() && type == IS_HOTEND)
+            pwm_value = mpc_output(targetTemperature);
+          else
+        #endif
         if (isUsePid()) {
           #if ENABLED(PID_ADD_EXTRUSION_RATE)
             const uint8_t id = (type == IS_HOTEND) ? data.ID : 0xFF;
           #endif
-          pwm_value = data.pid.compute(targetTemperature, current_temperature
+          pwm_value = data.pid.compute(pid_interval, targetTemperature, current_temperature
             #if ENABLED(PID_ADD_EXTRUSION_RATE)
               , id, tempManager.heater.lpq_len
             #endif
@@ -264,8 +305,13 @@ void Heater::set_output_pwm() {
   const uint8_t new_pwm = isHWinvert() ? 255 - pwm_value : pwm_value;
 
   if (data.pin > NoPin) {
-    if (isHWpwm())
-      HAL::analogWrite(data.pin, new_pwm, data.freq);
+    if (isHWpwm() && hardware_pwm()) {
+      // Timer keeps the duty, write only the changes
+      if (new_pwm != pwm_hw_value) {
+        pwm_hw_value = new_pwm;
+        HAL::analogWrite(data.pin, new_pwm, data.freq);
+      }
+    }
     else {
       #if ENABLED(SOFTWARE_PDM)
         const uint8_t carry = pwm_soft_pos + new_pwm;
@@ -284,6 +330,20 @@ void Heater::set_output_pwm() {
 
 }
 
+/**
+ * Ask the HAL for a timer channel when the pin or the frequency changes,
+ * without a free channel the heater use the soft PWM.
+ */
+bool Heater::hardware_pwm() {
+  if (data.pin != pwm_hw_pin || data.freq != pwm_hw_freq) {
+    pwm_hw_pin    = data.pin;
+    pwm_hw_freq   = data.freq;
+    pwm_hw_value  = -1;
+    pwm_hw        = HAL::claim_hardware_pwm(data.pin, data.freq);
+  }
+  return pwm_hw;
+}
+
 void Heater::check_and_power() {
 
   if (isActive() && current_temperature > data.temp.max) max_temp_error();
@@ -340,6 +400,11 @@ void Heater::PID_autotune(const float target_temp, const uint8_t ncycles, const
   float     maxTemp = 0.0f,
             minTemp = 1000.0f;
 
+  float     last_Ku = 0.0f,
+            last_Tu = 0.0f;
+
+  bool      tuned   = false;
+
   pid_data_t tune_pid;
 
   tune_pid.Kp = 0.0;
@@ -363,8 +428,12 @@ void Heater::PID_autotune(const float target_temp, const uint8_t ncycles, const
     LEDColor color = ledevents.onHeatingStart(isHotend);
   #endif
 
+  // Step response, a single heating instead of the relay cycles
+  if (method == 5)
+    tuned = PID_step_response(target_temp, tune_pid);
+
   // PID Tuning loop
-  while (printer.isWaitForHeatUp()) {
+  else while (printer.isWaitForHeatUp()) {
 
     printer.idle();
 
@@ -453,6 +522,16 @@ void Heater::PID_autotune(const float target_temp, const uint8_t ncycles, const
             SERIAL_MV(MSG_HOST_KP, tune_pid.Kp);
             SERIAL_MV(MSG_HOST_KI, tune_pid.Ki);
             SERIAL_MV(MSG_HOST_KD, tune_pid.Kd);
+
+            // Amplitude and period no more changing, stop before the last cycle
+            #if PID_AUTOTUNE_CONVERGENCE > 0
+              if (cycles > 3
+                && ABS(Ku - last_Ku) < Ku * (PID_AUTOTUNE_CONVERGENCE * 0.01f)
+                && ABS(Tu - last_Tu) < Tu * (PID_AUTOTUNE_CONVERGENCE * 0.01f)
+              ) tuned = true;
+            #endif
+            last_Ku = Ku;
+            last_Tu = Tu;
           }
         }
 
@@ -505,59 +584,63 @@ void Heater::PID_autotune(const float target_temp, const uint8_t ncycles, const
       break;
     }
 
-    if (cycles > ncycles) {
+    if (tuned || cycles > ncycles) {
+      tuned = true;
+      break;
+    }
 
-      SERIAL_EM(MSG_HOST_PID_AUTOTUNE_FINISHED);
-      Pidtuning = false;
+    lcdui.update();
 
-      if (isHotend) {
-        SERIAL_MV(MSG_HOST_KP, tune_pid.Kp);
-        SERIAL_MV(MSG_HOST_KI, tune_pid.Ki);
-        SERIAL_EMV(MSG_HOST_KD, tune_pid.Kd);
-      }
+  }
 
-      #if HAS_BEDS
-        if (type == IS_BED) {
-          SERIAL_EMV("#define BED_Kp ", tune_pid.Kp);
-          SERIAL_EMV("#define BED_Ki ", tune_pid.Ki);
-          SERIAL_EMV("#define BED_Kd ", tune_pid.Kd);
-        }
-      #endif
+  if (tuned) {
 
-      #if HAS_CHAMBERS
-        if (type == IS_CHAMBER) {
-          SERIAL_EMV("#define CHAMBER_Kp ", tune_pid.Kp);
-          SERIAL_EMV("#define CHAMBER_Ki ", tune_pid.Ki);
-          SERIAL_EMV("#define CHAMBER_Kd ", tune_pid.Kd);
-        }
-      #endif
+    SERIAL_EM(MSG_HOST_PID_AUTOTUNE_FINISHED);
+    Pidtuning = false;
 
-      #if HAS_COOLERS
-        if (type == IS_COOLER) {
-          SERIAL_EMV("#define COOLER_Kp ", tune_pid.Kp);
-          SERIAL_EMV("#define COOLER_Ki ", tune_pid.Ki);
-          SERIAL_EMV("#define COOLER_Kd ", tune_pid.Kd);
-        }
-      #endif
+    if (isHotend) {
+      SERIAL_MV(MSG_HOST_KP, tune_pid.Kp);
+      SERIAL_MV(MSG_HOST_KI, tune_pid.Ki);
+      SERIAL_EMV(MSG_HOST_KD, tune_pid.Kd);
+    }
 
-      data.pid.Kp = tune_pid.Kp;
-      data.pid.Ki = tune_pid.Ki;
-      data.pid.Kd = tune_pid.Kd;
+    #if HAS_BEDS
+      if (type == IS_BED) {
+        SERIAL_EMV("#define BED_Kp ", tune_pid.Kp);
+        SERIAL_EMV("#define BED_Ki ", tune_pid.Ki);
+        SERIAL_EMV("#define BED_Kd ", tune_pid.Kd);
+      }
+    #endif
 
-      setPidTuned(true);
-      Pidtuning = false;
-      ResetFault();
+    #if HAS_CHAMBERS
+      if (type == IS_CHAMBER) {
+        SERIAL_EMV("#define CHAMBER_Kp ", tune_pid.Kp);
+        SERIAL_EMV("#define CHAMBER_Ki ", tune_pid.Ki);
+        SERIAL_EMV("#define CHAMBER_Kd ", tune_pid.Kd);
+      }
+    #endif
 
-      if (storeValues) eeprom.store();
+    #if HAS_COOLERS
+      if (type == IS_COOLER) {
+        SERIAL_EMV("#define COOLER_Kp ", tune_pid.Kp);
+        SERIAL_EMV("#define COOLER_Ki ", tune_pid.Ki);
+        SERIAL_EMV("#define COOLER_Kd ", tune_pid.Kd);
+      }
+    #endif
 
-      #if ENABLED(PRINTER_EVENT_LEDS)
-        ledevents.onPidTuningDone(color);
-      #endif
+    data.pid.Kp = tune_pid.Kp;
+    data.pid.Ki = tune_pid.Ki;
+    data.pid.Kd = tune_pid.Kd;
 
-      break;
-    }
+    setPidTuned(true);
+    Pidtuning = false;
+    ResetFault();
 
-    lcdui.update();
+    if (storeValues) eeprom.store();
+
+    #if ENABLED(PRINTER_EVENT_LEDS)
+      ledevents.onPidTuningDone(color);
+    #endif
 
   }
 
@@ -570,6 +653,252 @@ void Heater::PID_autotune(const float target_temp, const uint8_t ncycles, const
 
 }
 
+/**
+ * PID step response (M303 R5)
+ *
+ * Heat at full power and find the steepest rise of the temperature.
+ * The tangent at that point gives the dead time L and the rate R of a
+ * first order plus dead time model, tuned with the Ziegler-Nichols
+ * reaction curve. Stop when the rise slows down or at the target.
+ */
+bool Heater::PID_step_response(const float target_temp, pid_data_t &tune_pid) {
+
+  constexpr uint8_t PID_STEP_WINDOW = 8;
+
+  const millis_l  sample_interval = type == IS_HOTEND ? 500UL : 2000UL,
+                  start_ms        = millis();
+  millis_l        next_ms         = start_ms;
+
+  float     window[PID_STEP_WINDOW],
+            max_slope   = 0.0f,
+            peak_time   = 0.0f,
+            peak_temp   = 0.0f;
+  uint16_t  samples     = 0;
+
+  update_current_temperature();
+  const float start_temp = current_temperature;
+
+  if (start_temp > target_temp - 20) {
+    SERIAL_LM(ER, MSG_HOST_PID_TEMP_TOO_HIGH);
+    return false;
+  }
+
+  pwm_value = data.pid.Max;
+
+  while (printer.isWaitForHeatUp()) {
+
+    printer.idle();
+
+    update_current_temperature();
+
+    const millis_l now = millis();
+
+    if (ELAPSED(now, next_ms)) {
+      next_ms += sample_interval;
+      const uint8_t i = samples % PID_STEP_WINDOW;
+      if (samples >= PID_STEP_WINDOW) {
+        // Slope over the window, at the middle of the window
+        const float slope = (current_temperature - window[i]) / (PID_STEP_WINDOW * sample_interval * 0.001f);
+        if (slope > max_slope) {
+          max_slope = slope;
+          peak_time = (now - start_ms - (PID_STEP_WINDOW * sample_interval) / 2) * 0.001f;
+          peak_temp = (current_temperature + window[i]) * 0.5f;
+        }
+        else if (slope < max_slope * 0.7f) break;
+      }
+      window[i] = current_temperature;
+      samples++;
+    }
+
+    if (current_temperature >= target_temp) break;
+
+    if ((now - start_ms) > (MAX_CYCLE_TIME_PID_AUTOTUNE * 60L * 1000L)) {
+      SERIAL_LM(ER, MSG_HOST_PID_TIMEOUT);
+      LCD_ALERTMESSAGEPGM_P(PSTR(MSG_HOST_PID_TIMEOUT));
+      return false;
+    }
+
+    lcdui.update();
+
+  }
+
+  pwm_value = 0;
+
+  if (!printer.isWaitForHeatUp() || max_slope <= 0.0f) return false;
+
+  const float L = MAX(peak_time - (peak_temp - start_temp) / max_slope, sample_interval * 0.001f),
+              R = max_slope / data.pid.Max;
+
+  SERIAL_MV(" L:", L);
+  SERIAL_MV(" R:", R, 5);
+
+  tune_pid.Kp = 1.2f / (R * L);
+  tune_pid.Ki = tune_pid.Kp / (2.0f * L);
+  tune_pid.Kd = tune_pid.Kp * 0.5f * L;
+
+  SERIAL_MSG(" Step response PID:");
+  SERIAL_MV(MSG_HOST_KP, tune_pid.Kp);
+  SERIAL_MV(MSG_HOST_KI, tune_pid.Ki);
+  SERIAL_MV(MSG_HOST_KD, tune_pid.Kd);
+  SERIAL_EOL();
+
+  return true;
+}
+
+#if ENABLED(HOTEND_MPC)
+
+  /**
+   * MPC Autotuning (M307 S)
+   *
+   * Cool to ambient with the part fan on, heat at full power and fit the
+   * exponential rise for heat capacity and sensor responsiveness, then hold
+   * the target to measure the heat loss with the part fan off and on.
+   */
+  void Heater::MPC_autotune(const float target_temp, const bool storeValues/*=false*/) {
+
+    constexpr uint8_t MPC_TUNE_SAMPLES = 16;
+
+    const bool        oldReport = printer.isAutoreportTemp();
+    const mpc_data_t  old_mpc   = data.mpc;
+
+    tempManager.disable_all_heaters(); // switch off all heaters.
+
+    printer.setWaitForHeatUp(true);
+    printer.setAutoreportTemp(true);
+
+    Pidtuning = true;
+    ResetFault();
+    pwm_value = 0;
+
+    #if HAS_FAN && MPC_PART_FAN >= 0
+      Fan * const fan = MPC_PART_FAN < fanManager.data.fans ? fans[MPC_PART_FAN] : nullptr;
+      const uint8_t old_fan_speed = fan ? fan->speed : 0;
+      if (fan) fan->set_speed(255);
+    #endif
+
+    bool done = false;
+
+    do {
+
+      // Wait the temperature stop falling
+      SERIAL_EM(MSG_HOST_MPC_COOLING_TO_AMBIENT);
+      update_current_temperature();
+      float ambient_temp = current_temperature;
+      millis_l next_ms = millis() + 10000UL;
+      while (mpc_tune_idle()) {
+        if (ELAPSED(millis(), next_ms)) {
+          if (current_temperature >= ambient_temp) {
+            ambient_temp = (ambient_temp + current_temperature) * 0.5f;
+            break;
+          }
+          ambient_temp = current_temperature;
+          next_ms += 10000UL;
+        }
+      }
+      if (!printer.isWaitForHeatUp() || isFault()) break;
+
+      #if HAS_FAN && MPC_PART_FAN >= 0
+        if (fan) fan->set_speed(0);
+      #endif
+
+      // Heat at full power, doubling the sample distance when the buffer is full
+      SERIAL_EMV(MSG_HOST_MPC_HEATING_PAST, target_temp);
+      float     samples[MPC_TUNE_SAMPLES];
+      uint8_t   count = 0;
+      bool      sampling = false;
+      millis_l  sample_distance = 1000UL,
+                first_ms = 0;
+      const millis_l heat_start_ms = millis();
+      pwm_value = data.pid.Max;
+      while (mpc_tune_idle()) {
+        const millis_l now = millis();
+        if (!sampling && current_temperature >= ambient_temp + 20.0f) {
+          sampling = true;
+          first_ms = next_ms = now;
+        }
+        if (sampling && ELAPSED(now, next_ms)) {
+          if (count == MPC_TUNE_SAMPLES) {
+            for (uint8_t i = 0; i < MPC_TUNE_SAMPLES / 2; i++) samples[i] = samples[i << 1];
+            count = MPC_TUNE_SAMPLES / 2;
+            sample_distance <<= 1;
+          }
+          samples[count++] = current_temperature;
+          next_ms += sample_distance;
+        }
+        if (current_temperature >= target_temp) break;
+        if ((now - heat_start_ms) > (MAX_CYCLE_TIME_PID_AUTOTUNE * 60L * 1000L)) {
+          SERIAL_LM(ER, MSG_HOST_MPC_TIMEOUT);
+          LCD_ALERTMESSAGEPGM_P(PSTR(MSG_HOST_MPC_TIMEOUT));
+          break;
+        }
+      }
+      pwm_value = 0;
+      if (!printer.isWaitForHeatUp() || isFault() || current_temperature < target_temp) break;
+
+      // Three equally spaced samples of T = asymp - (asymp - ambient) * e^(-b * t)
+      const uint8_t n = (count & 1) ? count : count - 1;
+      if (count < 5) break;
+      const float t1 = samples[0], t2 = samples[n >> 1], t3 = samples[n - 1],
+                  span = (n >> 1) * sample_distance * 0.001f,
+                  asymp_temp = (sq(t2) - t1 * t3) / (2.0f * t2 - t1 - t3),
+                  block_responsiveness = LOG((t1 - asymp_temp) / (t2 - asymp_temp)) / span,
+                  t1_time = (first_ms - heat_start_ms) * 0.001f;
+      if (isnan(asymp_temp) || asymp_temp <= t3 || !(block_responsiveness > 0.0f)) break;
+
+      data.mpc.ambient_xfer_coeff_fan0  = data.mpc.heater_power * data.pid.Max / 255.0f / (asymp_temp - ambient_temp);
+      data.mpc.block_heat_capacity      = data.mpc.ambient_xfer_coeff_fan0 / block_responsiveness;
+      data.mpc.sensor_responsiveness    = block_responsiveness / (1.0f - (ambient_temp - asymp_temp) * EXP(-block_responsiveness * t1_time) / (t1 - asymp_temp));
+
+      // The steady state power gives the real loss to ambient
+      SERIAL_EMV(MSG_HOST_MPC_MEASURING_AMBIENT, target_temp);
+      mpc_reset(ambient_temp);
+      const float loss_fan0 = mpc_hold_loss(target_temp, ambient_temp);
+      if (isnan(loss_fan0)) break;
+      data.mpc.ambient_xfer_coeff_fan0  = loss_fan0;
+      data.mpc.block_heat_capacity      = loss_fan0 / block_responsiveness;
+
+      #if HAS_FAN && MPC_PART_FAN >= 0
+        if (fan) {
+          fan->set_speed(255);
+          const float loss_fan255 = mpc_hold_loss(target_temp, ambient_temp);
+          if (isnan(loss_fan255)) break;
+          data.mpc.fan255_adjustment = loss_fan255 - loss_fan0;
+        }
+      #endif
+
+      done = true;
+
+    } while (false);
+
+    tempManager.disable_all_heaters();
+    Pidtuning = false;
+
+    #if HAS_FAN && MPC_PART_FAN >= 0
+      if (fan) fan->set_speed(old_fan_speed);
+    #endif
+
+    if (done) {
+      SERIAL_EM(MSG_HOST_MPC_AUTOTUNE_FINISHED);
+      print_M307();
+      if (storeValues) eeprom.store();
+    }
+    else {
+      data.mpc = old_mpc;
+      SERIAL_LM(ER, MSG_HOST_MPC_AUTOTUNE_FAILED);
+      LCD_ALERTMESSAGEPGM_P(PSTR(MSG_HOST_MPC_AUTOTUNE_FAILED));
+    }
+
+    mpc_reset(current_temperature);
+
+    printer.setWaitForHeatUp(false);
+    printer.setAutoreportTemp(oldReport);
+
+    LCD_MESSAGEPGM(MSG_WELCOME);
+
+  }
+
+#endif // HOTEND_MPC
+
 void Heater::print_M301() {
   if (isUsePid()) {
     const int8_t heater_id = type == IS_HOTEND ? data.ID : -type;
@@ -647,6 +976,21 @@ void Heater::print_M306() {
 
 }
 
+#if ENABLED(HOTEND_MPC)
+  void Heater::print_M307() {
+    if (type != IS_HOTEND) return;
+    SERIAL_LM(CFG, "Hotend MPC parameters: H<Hotend> P<Heater power> C<Block heat capacity> R<Sensor responsiveness> A<Ambient xfer coeff> F<Ambient xfer coeff fan 255> E<Filament heat capacity per mm>:");
+    SERIAL_SMV(CFG, "  M307 H", int(data.ID));
+    SERIAL_MV(" P", data.mpc.heater_power);
+    SERIAL_MV(" C", data.mpc.block_heat_capacity);
+    SERIAL_MV(" R", data.mpc.sensor_responsiveness, 4);
+    SERIAL_MV(" A", data.mpc.ambient_xfer_coeff_fan0, 4);
+    SERIAL_MV(" F", data.mpc.ambient_xfer_coeff_fan0 + data.mpc.fan255_adjustment, 4);
+    SERIAL_MV(" E", data.mpc.filament_heat_capacity_permm, 6);
+    SERIAL_EOL();
+  }
+#endif
+
 #if HAS_AD8495 || HAS_AD595
   void Heater::print_M595() {
     const int8_t heater_id = type == IS_HOTEND ? data.ID : -type;
@@ -674,8 +1018,6 @@ void Heater::reset_idle_timer() {
 
 void Heater::thermal_runaway_protection() {
 
-  static long_timer_t thermal_runaway_timer(millis());
-
   switch (thermal_runaway_state) {
 
     // Inactive state waits for a target temperature to be set
@@ -685,6 +1027,7 @@ void Heater::thermal_runaway_protection() {
     case TRFirstHeating:
       if (current_temperature < target_temperature) break;
       thermal_runaway_state = TRStable;
+      thermal_runaway_timer.start();
 
     // While the temperature is stable watch for a bad temperature
     case TRStable:
@@ -832,3 +1175,118 @@ void Heater::update_idle_timer() {
   if (!isIdle() && idle_timeout_ms && (ELAPSED(millis(), idle_timeout_ms)))
     setIdle(true);
 }
+
+#if ENABLED(HOTEND_MPC)
+
+  void Heater::mpc_reset(const float ambient_temp) {
+    mpc_block_temp    = current_temperature;
+    mpc_sensor_temp   = current_temperature;
+    mpc_ambient_temp  = ambient_temp;
+    mpc_e_position    = stepper.position(E_AXIS);
+    mpc_sample_ms     = millis();
+  }
+
+  /**
+   * Advance the model of block and sensor every pid interval, pull it towards
+   * the measured temperature and give the power to reach the target in 2 seconds
+   * plus the loss to ambient, increased by the part fan and the filament flow.
+   */
+  uint8_t Heater::mpc_output(const float target_temp) {
+
+    constexpr float MPC_SMOOTHING_FACTOR    = 0.5f,
+                    MPC_MIN_AMBIENT_CHANGE  = 1.0f,   // (K/s)
+                    MPC_STEADYSTATE         = 0.5f;   // (K/s)
+
+    const millis_s now = millis(), elapsed = now - mpc_sample_ms;
+
+    if (elapsed < pid_interval) return pwm_value;
+
+    mpc_sample_ms = now;
+
+    const float dt = elapsed * 0.001f;
+    const mpc_data_t &mpc = data.mpc;
+
+    float ambient_xfer_coeff = mpc.ambient_xfer_coeff_fan0;
+
+    #if HAS_FAN && MPC_PART_FAN >= 0
+      if (MPC_PART_FAN < fanManager.data.fans && fans[MPC_PART_FAN])
+        ambient_xfer_coeff += fans[MPC_PART_FAN]->actual_speed() * (1.0f / 255.0f) * mpc.fan255_adjustment;
+    #endif
+
+    // The extruded filament takes heat out like a loss to ambient
+    const long e_position = stepper.position(E_AXIS);
+    if (data.ID == toolManager.active_hotend() && e_position > mpc_e_position) {
+      const float e_speed = (e_position - mpc_e_position) * extruders[toolManager.extruder.active]->steps_to_mm * (1.0f / dt);
+      ambient_xfer_coeff += e_speed * mpc.filament_heat_capacity_permm;
+    }
+    mpc_e_position = e_position;
+
+    const float blocktempdelta = (pwm_value * (mpc.heater_power / 255.0f) - (mpc_block_temp - mpc_ambient_temp) * ambient_xfer_coeff) * dt / mpc.block_heat_capacity;
+    mpc_block_temp  += blocktempdelta;
+    mpc_sensor_temp += (mpc_block_temp - mpc_sensor_temp) * mpc.sensor_responsiveness * dt;
+
+    // The model error is a disturbance or a slow model drift
+    const float delta_to_apply = (current_temperature - mpc_sensor_temp) * MPC_SMOOTHING_FACTOR;
+    mpc_block_temp  += delta_to_apply;
+    mpc_sensor_temp += delta_to_apply;
+
+    // Near the steady state the remaining error is in the ambient temperature
+    if (WITHIN(pwm_value, 1, data.pid.Max - 1) || ABS(blocktempdelta + delta_to_apply) < MPC_STEADYSTATE * dt)
+      mpc_ambient_temp += delta_to_apply > 0.0f ? MAX(delta_to_apply, MPC_MIN_AMBIENT_CHANGE * dt) : MIN(delta_to_apply, -MPC_MIN_AMBIENT_CHANGE * dt);
+
+    float power = 0.0f;
+    if (target_temp > 0) {
+      power = (target_temp - mpc_block_temp) * mpc.block_heat_capacity * 0.5f;
+      power += (mpc_block_temp - mpc_ambient_temp) * ambient_xfer_coeff;
+    }
+
+    float output = power * 255.0f / mpc.heater_power;
+    LIMIT(output, 0.0f, float(data.pid.Max));
+    return LROUND(output);
+  }
+
+  // Hold the target with the model and return the loss to ambient in W/K, NAN if aborted
+  float Heater::mpc_hold_loss(const float target_temp, const float ambient_temp) {
+
+    constexpr millis_l MPC_HOLD_MS = 30000UL;
+
+    const millis_l  measure_ms  = millis() + MPC_HOLD_MS,
+                    end_ms      = measure_ms + MPC_HOLD_MS;
+    millis_l        last_ms     = 0;
+    float           energy      = 0.0f,
+                    start_temp  = 0.0f,
+                    temp_sum    = 0.0f;
+    uint16_t        temp_count  = 0;
+
+    while (mpc_tune_idle()) {
+      const millis_l now = millis();
+      if (!last_ms) {
+        if (ELAPSED(now, measure_ms)) {
+          start_temp = current_temperature;
+          last_ms = now;
+        }
+      }
+      else {
+        energy += pwm_value * (data.mpc.heater_power / 255.0f) * (now - last_ms) * 0.001f;
+        temp_sum += current_temperature;
+        temp_count++;
+        last_ms = now;
+        if (ELAPSED(now, end_ms)) {
+          const float power = (energy - data.mpc.block_heat_capacity * (current_temperature - start_temp)) / (MPC_HOLD_MS * 0.001f);
+          return power / (temp_sum / temp_count - ambient_temp);
+        }
+      }
+      pwm_value = mpc_output(target_temp);
+    }
+
+    return NAN;
+  }
+
+  bool Heater::mpc_tune_idle() {
+    printer.idle();
+    update_current_temperature();
+    lcdui.update();
+    return printer.isWaitForHeatUp() && !isFault();
+  }
+
+#endif // HOTEND_MPC
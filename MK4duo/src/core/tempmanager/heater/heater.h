@@ -43,6 +43,27 @@ union heater_flag_t {
 enum HeatertypeEnum : uint8_t { IS_HOTEND, IS_BED, IS_CHAMBER, IS_COOLER };
 enum TRState        : uint8_t { TRInactive, TRFirstHeating, TRStable, TRRunaway };
 
+#if ENABLED(TEMP_HISTORY)
+  // Ring of the last samples, temperature in 1/8 degC and PWM
+  struct temp_history_t {
+    int16_t temp[TEMP_HISTORY_SIZE];
+    uint8_t pwm[TEMP_HISTORY_SIZE],
+            head,
+            count;
+    void reset() { head = count = 0; }
+    void add(const float celsius, const uint8_t pwm_value) {
+      int32_t t = LROUND(celsius * 8.0f);
+      LIMIT(t, INT16_MIN, INT16_MAX);
+      temp[head] = t;
+      pwm[head] = pwm_value;
+      if (++head >= TEMP_HISTORY_SIZE) head = 0;
+      if (count < TEMP_HISTORY_SIZE) count++;
+    }
+    // Ring index of sample i, 0 is the oldest
+    uint8_t index(const uint8_t i) { return (head + TEMP_HISTORY_SIZE - count + i) % TEMP_HISTORY_SIZE; }
+  };
+#endif
+
 // Struct Heater data
 struct heater_data_t {
   uint8_t         ID;
@@ -52,15 +73,19 @@ struct heater_data_t {
   limit_int_t     temp;
   pid_data_t      pid;
   sensor_data_t   sensor;
+  #if ENABLED(HOTEND_MPC)
+    mpc_data_t    mpc;
+  #endif
 };
 
 class Heater {
 
   public: /** Constructor */
 
-    Heater(HeatertypeEnum type_p, uint16_t temp_check_interval_p, uint8_t temp_hysteresis_p, uint8_t watch_period_p, uint8_t watch_increase_p) :
+    Heater(HeatertypeEnum type_p, uint16_t temp_check_interval_p, uint16_t pid_interval_p, uint8_t temp_hysteresis_p, uint8_t watch_period_p, uint8_t watch_increase_p) :
       type(type_p),
       temp_check_interval(temp_check_interval_p),
+      pid_interval(pid_interval_p),
       temp_hysteresis(temp_hysteresis_p),
       watch_period(watch_period_p),
       watch_increase(watch_increase_p)
@@ -77,11 +102,20 @@ class Heater {
 
     float           current_temperature;
 
+    #if ENABLED(THERMISTOR_TABLE)
+      thermistor_table_t sensor_table;
+    #endif
+
+    #if ENABLED(TEMP_HISTORY)
+      temp_history_t  history;
+    #endif
+
     const HeatertypeEnum type;
 
   private: /** Private Parameters */
 
-    const uint16_t  temp_check_interval;
+    const uint16_t  temp_check_interval,
+                    pid_interval;
 
     const uint8_t   temp_hysteresis,
                     watch_period,
@@ -92,15 +126,33 @@ class Heater {
 
     uint16_t        watch_target_temp;
 
+    pin_t           pwm_hw_pin;
+    uint16_t        pwm_hw_freq;
+    int16_t         pwm_hw_value;
+    bool            pwm_hw;
+
     TRState         thermal_runaway_state;
 
     millis_l        idle_timeout_ms;
 
     short_timer_t   next_check_timer;
-    long_timer_t    next_watch_timer;
+    long_timer_t    next_watch_timer,
+                    thermal_runaway_timer;
 
     bool            Pidtuning;
 
+    #if ENABLED(HEAT_IN_BACKGROUND)
+      uint8_t       deferred_wait;  // 0 none, 1 wait only when heating, 2 wait when heating and cooling
+    #endif
+
+    #if ENABLED(HOTEND_MPC)
+      float         mpc_block_temp,
+                    mpc_sensor_temp,
+                    mpc_ambient_temp;
+      long          mpc_e_position;
+      millis_s      mpc_sample_ms;
+    #endif
+
   public: /** Public Function */
 
     void init();
@@ -109,6 +161,11 @@ class Heater {
     void set_idle_temp(const int16_t celsius);
     void wait_for_target(bool no_wait_for_cooling=true);
 
+    #if ENABLED(HEAT_IN_BACKGROUND)
+      void defer_wait(const bool no_wait_for_cooling=true);
+      void wait_deferred();
+    #endif
+
     void get_output();
     void set_output_pwm();
 
@@ -116,9 +173,16 @@ class Heater {
 
     void PID_autotune(const float target_temp, const uint8_t ncycles, const uint8_t method, const bool storeValues=false);
 
+    #if ENABLED(HOTEND_MPC)
+      void MPC_autotune(const float target_temp, const bool storeValues=false);
+    #endif
+
     void print_M301();
     void print_M305();
     void print_M306();
+    #if ENABLED(HOTEND_MPC)
+      void print_M307();
+    #endif
     #if HAS_AD8495 || HAS_AD595
       void print_M595();
     #endif
@@ -129,7 +193,18 @@ class Heater {
     void thermal_runaway_protection();
     void start_watching();
 
-    FORCE_INLINE void update_current_temperature() { this->current_temperature = this->data.sensor.getTemperature(); }
+    FORCE_INLINE void update_current_temperature() {
+      #if ENABLED(TOOLBOARD)
+        if (this->data.sensor.type == 12) {
+          this->current_temperature = toolboard.temperature(this->data.ID);
+          return;
+        }
+      #endif
+      #if ENABLED(THERMISTOR_TABLE)
+        if (WITHIN(this->data.sensor.type, 1, 9) && this->sensor_table.getTemperature(this->data.sensor.adc_raw, this->current_temperature)) return;
+      #endif
+      this->current_temperature = this->data.sensor.getTemperature();
+    }
     FORCE_INLINE int16_t deg_current()  { return this->current_temperature + 0.5f; }
     FORCE_INLINE int16_t deg_target()   { return this->target_temperature;  }
     FORCE_INLINE int16_t deg_idle()     { return this->idle_temperature;    }
@@ -189,6 +264,8 @@ class Heater {
     }
     FORCE_INLINE bool isFault() { return data.flag.Fault; }
 
+    FORCE_INLINE bool isTuning() { return Pidtuning; }
+
     FORCE_INLINE void resetFlag() { data.flag.all = false; }
 
     FORCE_INLINE void SwitchOff() {
@@ -207,6 +284,17 @@ class Heater {
 
     void update_idle_timer();
 
+    bool PID_step_response(const float target_temp, pid_data_t &tune_pid);
+
+    #if ENABLED(HOTEND_MPC)
+      void mpc_reset(const float ambient_temp);
+      uint8_t mpc_output(const float target_temp);
+      float mpc_hold_loss(const float target_temp, const float ambient_temp);
+      bool mpc_tune_idle();
+    #endif
+
+    bool hardware_pwm();
+
 };
 
 #if HAS_HOTENDS
@@ -0,0 +1,43 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * mpc.h - Model Predictive Control object
+ */
+
+#if ENABLED(HOTEND_MPC)
+
+struct mpc_data_t {
+
+  public: /** Public Parameters */
+
+    float heater_power,                 // (W) Heater power at full PWM
+          block_heat_capacity,          // (J/K) Heat capacity of the heater block
+          sensor_responsiveness,        // (K/s/K) Rate of the sensor following the block
+          ambient_xfer_coeff_fan0,      // (W/K) Heat loss to ambient with the part fan off
+          fan255_adjustment,            // (W/K) Heat loss added by the part fan at full speed
+          filament_heat_capacity_permm; // (J/K/mm) Heat capacity of one mm of filament
+
+};
+
+#endif // HOTEND_MPC
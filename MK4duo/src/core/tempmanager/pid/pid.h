@@ -45,27 +45,37 @@ struct pid_data_t {
           pid_output  = 0.0,   
           last_temp   = 0.0;
 
-    short_timer_t next_sample_ms;
+    millis_s last_sample_ms;
 
   public: /** Public Function */
 
-    void init() { next_sample_ms.start(); }
+    void init() { last_sample_ms = millis(); }
 
-    float compute(const float target_temp, const float current_temp
+    /**
+     * Update the PID every interval ms. Ki and Kd are per second,
+     * so the terms are scaled by the time really elapsed.
+     */
+    float compute(const uint16_t interval, const float target_temp, const float current_temp
       #if ENABLED(PID_ADD_EXTRUSION_RATE)
         , const uint8_t tid, const int16_t lpq_len=0
       #endif
     ) {
 
-      if (next_sample_ms.expired(1000UL)) {
+      const millis_s now = millis(), elapsed = now - last_sample_ms;
 
-        const float pid_error = target_temp - current_temp,
+      if (elapsed >= interval) {
+
+        last_sample_ms = now;
+
+        const float dt        = elapsed * 0.001f,
+                    inv_dt    = 1000.0f / elapsed,
+                    pid_error = target_temp - current_temp,
                     dInput    = current_temp - last_temp;
 
         // Compute PID output
-        outputSum += (Ki * pid_error);
+        outputSum += (Ki * dt * pid_error);
         LIMIT(outputSum, drive.min, drive.max);
-        pid_output = Kp * pid_error + outputSum - Kd * dInput;
+        pid_output = Kp * pid_error + outputSum - Kd * inv_dt * dInput;
 
         #if ENABLED(PID_ADD_EXTRUSION_RATE)
           if (tid == toolManager.active_hotend()) {
@@ -78,7 +88,7 @@ struct pid_data_t {
               lpq[lpq_ptr] = 0;
             }
             if (++lpq_ptr >= lpq_len) lpq_ptr = 0;
-            pid_output += (lpq[lpq_ptr] * extruders[toolManager.extruder.active]->steps_to_mm) * Kc;
+            pid_output += (lpq[lpq_ptr] * extruders[toolManager.extruder.active]->steps_to_mm) * inv_dt * Kc;
           }
         #endif // PID_ADD_EXTRUSION_RATE
 
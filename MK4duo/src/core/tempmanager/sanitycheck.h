@@ -145,6 +145,17 @@
 #if DISABLED(HOTEND_Kd)
   #error "DEPENDENCY ERROR: Missing setting HOTEND_Kd."
 #endif
+#if ENABLED(HOTEND_MPC)
+  #if DISABLED(MPC_HEATER_POWER) || DISABLED(MPC_BLOCK_HEAT_CAPACITY) || DISABLED(MPC_SENSOR_RESPONSIVENESS)
+    #error "DEPENDENCY ERROR: Missing setting MPC_HEATER_POWER, MPC_BLOCK_HEAT_CAPACITY or MPC_SENSOR_RESPONSIVENESS."
+  #elif DISABLED(MPC_AMBIENT_XFER_COEFF) || DISABLED(MPC_AMBIENT_XFER_COEFF_FAN255) || DISABLED(MPC_FILAMENT_HEAT_CAPACITY)
+    #error "DEPENDENCY ERROR: Missing setting MPC_AMBIENT_XFER_COEFF, MPC_AMBIENT_XFER_COEFF_FAN255 or MPC_FILAMENT_HEAT_CAPACITY."
+  #elif DISABLED(MPC_PART_FAN) || DISABLED(MPC_AUTOTUNE_TEMP)
+    #error "DEPENDENCY ERROR: Missing setting MPC_PART_FAN or MPC_AUTOTUNE_TEMP."
+  #elif ENABLED(PID_ADD_EXTRUSION_RATE)
+    #error "DEPENDENCY ERROR: HOTEND_MPC already compensates the extrusion rate, disable PID_ADD_EXTRUSION_RATE."
+  #endif
+#endif
 
 #if HAS_TEMP_BED0
   #if DISABLED(BED_POWER_MAX)
@@ -311,3 +322,59 @@
     , "DEPENDENCY ERROR: only one DHT sensor is supported!"
   );
 #endif
+
+#if ENABLED(THERMISTOR_TABLE)
+  #if HAS_VREF_MONITOR
+    #error "DEPENDENCY ERROR: THERMISTOR_TABLE is incompatible with HAVE_VREF_MONITOR."
+  #elif DISABLED(THERMISTOR_TABLE_STEP) || DISABLED(THERMISTOR_TABLE_POINTS)
+    #error "DEPENDENCY ERROR: Missing setting THERMISTOR_TABLE_STEP or THERMISTOR_TABLE_POINTS."
+  #elif !WITHIN(THERMISTOR_TABLE_POINTS, 2, 255)
+    #error "DEPENDENCY ERROR: THERMISTOR_TABLE_POINTS must be from 2 to 255."
+  #endif
+#endif
+
+#if ENABLED(TEMP_HISTORY)
+  #if DISABLED(TEMP_HISTORY_SIZE) || DISABLED(TEMP_HISTORY_INTERVAL)
+    #error "DEPENDENCY ERROR: Missing setting TEMP_HISTORY_SIZE or TEMP_HISTORY_INTERVAL."
+  #elif !WITHIN(TEMP_HISTORY_SIZE, 2, 255)
+    #error "DEPENDENCY ERROR: TEMP_HISTORY_SIZE must be from 2 to 255."
+  #elif TEMP_HISTORY_INTERVAL < 100 || (TEMP_HISTORY_INTERVAL % 100) || TEMP_HISTORY_INTERVAL > 25500
+    #error "DEPENDENCY ERROR: TEMP_HISTORY_INTERVAL must be a multiple of 100 from 100 to 25500."
+  #endif
+#endif
+
+#if HAS_MAX6675 || HAS_MAX31855
+  #if DISABLED(THERMOCOUPLE_SAMPLE_PERIOD)
+    #error "DEPENDENCY ERROR: Missing setting THERMOCOUPLE_SAMPLE_PERIOD."
+  #elif THERMOCOUPLE_SAMPLE_PERIOD < 250 || THERMOCOUPLE_SAMPLE_PERIOD > 10000
+    #error "DEPENDENCY ERROR: THERMOCOUPLE_SAMPLE_PERIOD must be from 250 to 10000."
+  #endif
+#endif
+
+// PID intervals, the temperature manager runs every 100ms
+#if DISABLED(HOTEND_PID_INTERVAL) || DISABLED(BED_PID_INTERVAL) || DISABLED(CHAMBER_PID_INTERVAL) || DISABLED(COOLER_PID_INTERVAL)
+  #error "DEPENDENCY ERROR: Missing setting HOTEND_PID_INTERVAL, BED_PID_INTERVAL, CHAMBER_PID_INTERVAL or COOLER_PID_INTERVAL."
+#elif  HOTEND_PID_INTERVAL < 100 || (HOTEND_PID_INTERVAL % 100)   || BED_PID_INTERVAL < 100    || (BED_PID_INTERVAL % 100) \
+    || CHAMBER_PID_INTERVAL < 100 || (CHAMBER_PID_INTERVAL % 100) || COOLER_PID_INTERVAL < 100 || (COOLER_PID_INTERVAL % 100)
+  #error "DEPENDENCY ERROR: HOTEND_PID_INTERVAL, BED_PID_INTERVAL, CHAMBER_PID_INTERVAL and COOLER_PID_INTERVAL must be multiples of 100."
+#elif HOTEND_PID_INTERVAL > 10000 || BED_PID_INTERVAL > 10000 || CHAMBER_PID_INTERVAL > 10000 || COOLER_PID_INTERVAL > 10000
+  #error "DEPENDENCY ERROR: PID intervals must be 10000 or less."
+#endif
+
+#if ENABLED(ADC_OVERSAMPLING)
+  #if DISABLED(ARDUINO_ARCH_SAM)
+    #error "DEPENDENCY ERROR: ADC_OVERSAMPLING is only available on Arduino DUE."
+  #elif !WITHIN(ADC_OVERSAMPLING_BITS, 1, 3)
+    #error "DEPENDENCY ERROR: ADC_OVERSAMPLING_BITS must be from 1 to 3."
+  #endif
+#endif
+
+#if ENABLED(POWER_BUDGET)
+  #if DISABLED(POWER_BUDGET_PSU_WATTS) || DISABLED(POWER_BUDGET_HOTEND_WATTS) || DISABLED(POWER_BUDGET_BED_WATTS) || DISABLED(POWER_BUDGET_CHAMBER_WATTS) || DISABLED(POWER_BUDGET_HOLD_WINDOW)
+    #error "DEPENDENCY ERROR: Missing setting POWER_BUDGET_PSU_WATTS, POWER_BUDGET_HOTEND_WATTS, POWER_BUDGET_BED_WATTS, POWER_BUDGET_CHAMBER_WATTS or POWER_BUDGET_HOLD_WINDOW."
+  #elif POWER_BUDGET_PSU_WATTS <= 0
+    #error "DEPENDENCY ERROR: POWER_BUDGET_PSU_WATTS must be greater than 0."
+  #elif POWER_BUDGET_HOLD_WINDOW < 0
+    #error "DEPENDENCY ERROR: POWER_BUDGET_HOLD_WINDOW must be 0 or more."
+  #endif
+#endif
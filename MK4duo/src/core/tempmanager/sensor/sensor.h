@@ -87,7 +87,7 @@ typedef struct {
           const float   resistance = pullup_res * ((float)(adc_raw - adc_low) + 0.5f) / adc_inverse;
         #endif
 
-        const float logResistance = LOG(resistance);
+        const float logResistance = FAST_LOG(resistance);
         const float recipT = shA + shB * logResistance + shC * logResistance * logResistance * logResistance;
 
         /*
@@ -112,23 +112,32 @@ typedef struct {
       #if HAS_AMPLIFIER
 
         #define PGM_RD_W(x) (short)pgm_read_word(&x)
-        static uint8_t ttbllen_map = COUNT(temptable_amplifier);
+        constexpr uint8_t ttbllen_map = COUNT(temptable_amplifier);
+        static uint8_t hint = 1;  // Entry of the last lookup, the temperature changes slowly
         float celsius = 0;
-        uint8_t i;
 
         if (type == 20) {
-          for (i = 1; i < ttbllen_map; i++) {
-            if (PGM_RD_W(temptable_amplifier[i][0]) > adc_raw) {
-              celsius = PGM_RD_W(temptable_amplifier[i - 1][1]) +
-                        (adc_raw - PGM_RD_W(temptable_amplifier[i - 1][0])) *
-                        (float)(PGM_RD_W(temptable_amplifier[i][1]) - PGM_RD_W(temptable_amplifier[i - 1][1])) /
-                        (float)(PGM_RD_W(temptable_amplifier[i][0]) - PGM_RD_W(temptable_amplifier[i - 1][0]));
-              break;
+
+          // The first entry over adc_raw: the last one if still right, else a binary search
+          uint8_t i = hint;
+          if (!(PGM_RD_W(temptable_amplifier[i][0]) > adc_raw && (i == 1 || PGM_RD_W(temptable_amplifier[i - 1][0]) <= adc_raw))) {
+            uint8_t l = 1;
+            i = ttbllen_map;
+            while (l < i) {
+              const uint8_t m = (l + i) >> 1;
+              if (PGM_RD_W(temptable_amplifier[m][0]) > adc_raw) i = m; else l = m + 1;
             }
           }
 
-          // Overflow: Set to last value in the table
-          if (i == ttbllen_map) celsius = PGM_RD_W(temptable_amplifier[i - 1][1]);
+          if (i < ttbllen_map) {
+            hint = i;
+            celsius = PGM_RD_W(temptable_amplifier[i - 1][1]) +
+                      (adc_raw - PGM_RD_W(temptable_amplifier[i - 1][0])) *
+                      (float)(PGM_RD_W(temptable_amplifier[i][1]) - PGM_RD_W(temptable_amplifier[i - 1][1])) /
+                      (float)(PGM_RD_W(temptable_amplifier[i][0]) - PGM_RD_W(temptable_amplifier[i - 1][0]));
+          }
+          else // Overflow: Set to last value in the table
+            celsius = PGM_RD_W(temptable_amplifier[i - 1][1]);
 
           return celsius;
         }
@@ -179,17 +188,13 @@ typedef struct {
 
     #if HAS_MAX6675
 
-      #define MAX6675_HEAT_INTERVAL 250u
       #define MAX6675_ERROR_MASK      4
       #define MAX6675_DISCARD_BITS    3
 
+      // One SPI transfer, the TempManager keeps the sample period of each sensor
       int16_t read_max6675() {
 
-        static short_timer_t next_max6675_timer(millis());
-        static uint16_t max6675_temp = 2000;
-
-        if (next_max6675_timer.pending(MAX6675_HEAT_INTERVAL))
-          return int16_t(max6675_temp);
+        uint16_t max6675_temp;
 
         #if ENABLED(CPU_32_BIT)
           HAL::spiBegin();
@@ -239,19 +244,15 @@ typedef struct {
 
     #if HAS_MAX31855
 
-      #define MAX31855_HEAT_INTERVAL 250u
       #define MAX31855_DISCARD_BITS 18
 
+      // One SPI transfer, the TempManager keeps the sample period of each sensor
       int16_t read_max31855() {
 
-        static short_timer_t next_max31855_timer(millis());
-        static uint16_t last_max31855_temp  = 2000;
+        int16_t last_max31855_temp;
 
         uint32_t data = 0;
 
-        if (next_max31855_timer.pending(MAX31855_HEAT_INTERVAL))
-          return int16_t(last_max31855_temp);
-
         #if ENABLED(CPU_32_BIT)
           HAL::spiBegin();
         #else
@@ -296,3 +297,55 @@ typedef struct {
     #endif // HAS_MAX6675
 
 } sensor_data_t;
+
+#if ENABLED(THERMISTOR_TABLE)
+
+  // Table ADC values are scaled to use the whole 16 bit range
+  #define THERMISTOR_TABLE_SCALE  (65536UL / ((AD_RANGE) + 1))
+
+  typedef struct {
+
+    public: /** Public Parameters */
+
+      uint16_t adc[THERMISTOR_TABLE_POINTS];
+
+    public: /** Public Function */
+
+      /**
+       * Build the table from the sensor parameters, a point every THERMISTOR_TABLE_STEP
+       * degrees. Steinhart-Hart is solved for ln(R) with a few Newton steps from the
+       * beta value, exact when shC is 0. Call after CalcDerivedParameters().
+       */
+      void build(const sensor_data_t &sensor) {
+        const float adc_low = 2 * sensor.adc_low_offset,
+                    adc_max = AD_RANGE + (2 * sensor.adc_high_offset);
+        LOOP_L_N(i, THERMISTOR_TABLE_POINTS) {
+          const float recipT = 1.0f / (THERMISTOR_TABLE_MIN_TEMP + i * THERMISTOR_TABLE_STEP - (ABS_ZERO));
+          float logR = (recipT - sensor.shA) / sensor.shB;
+          LOOP_L_N(n, 3)
+            logR -= (sensor.shA + sensor.shB * logR + sensor.shC * logR * logR * logR - recipT) / (sensor.shB + 3 * sensor.shC * logR * logR);
+          const float resistance = EXP(logR),
+                      adc_point  = (resistance * (adc_max - 0.5f) + sensor.pullup_res * (adc_low - 0.5f)) / (resistance + sensor.pullup_res);
+          adc[i] = constrain(LROUND(adc_point * THERMISTOR_TABLE_SCALE), 0, 65535);
+        }
+      }
+
+      /**
+       * Get the temperature of an ADC value, false if it is outside the table.
+       * The ADC decreases as the temperature rises, a binary search finds the points.
+       */
+      bool getTemperature(const int16_t adc_raw, float &celsius) const {
+        const int32_t a = int32_t(adc_raw) * THERMISTOR_TABLE_SCALE;
+        if (a > adc[0] || a <= adc[THERMISTOR_TABLE_POINTS - 1]) return false;
+        uint8_t l = 0, h = THERMISTOR_TABLE_POINTS - 1;
+        while (h - l > 1) {
+          const uint8_t m = (l + h) >> 1;
+          if (adc[m] >= a) l = m; else h = m;
+        }
+        celsius = THERMISTOR_TABLE_MIN_TEMP + THERMISTOR_TABLE_STEP * (l + float(adc[l] - a) / float(adc[l] - adc[h]));
+        return true;
+      }
+
+  } thermistor_table_t;
+
+#endif // THERMISTOR_TABLE
@@ -169,6 +169,10 @@
   #define HOT0_NAME "DHT11"
   #define HOT0_R25  0.0
   #define HOT0_BETA 0.0
+#elif TEMP_SENSOR_HE0 == 12
+  #define HOT0_NAME "TOOLBOARD"
+  #define HOT0_R25  0.0
+  #define HOT0_BETA 0.0
 #elif TEMP_SENSOR_HE0 == 20
   #define HOT0_NAME "AMPLIFIER"
   #define HOT0_R25  0.0
@@ -203,6 +207,10 @@
   #define HOT1_NAME "DHT11"
   #define HOT1_R25  0.0
   #define HOT1_BETA 0.0
+#elif TEMP_SENSOR_HE1 == 12
+  #define HOT1_NAME "TOOLBOARD"
+  #define HOT1_R25  0.0
+  #define HOT1_BETA 0.0
 #elif TEMP_SENSOR_HE1 == 20
   #define HOT1_NAME "AMPLIFIER"
   #define HOT1_R25  0.0
@@ -237,6 +245,10 @@
   #define HOT2_NAME "DHT11"
   #define HOT2_R25  0.0
   #define HOT2_BETA 0.0
+#elif TEMP_SENSOR_HE2 == 12
+  #define HOT2_NAME "TOOLBOARD"
+  #define HOT2_R25  0.0
+  #define HOT2_BETA 0.0
 #elif TEMP_SENSOR_HE2 == 20
   #define HOT2_NAME "AMPLIFIER"
   #define HOT2_R25  0.0
@@ -271,6 +283,10 @@
   #define HOT3_NAME "DHT11"
   #define HOT3_R25  0.0
   #define HOT3_BETA 0.0
+#elif TEMP_SENSOR_HE3 == 12
+  #define HOT3_NAME "TOOLBOARD"
+  #define HOT3_R25  0.0
+  #define HOT3_BETA 0.0
 #elif TEMP_SENSOR_HE3 == 20
   #define HOT3_NAME "AMPLIFIER"
   #define HOT3_R25  0.0
@@ -305,6 +321,10 @@
   #define HOT4_NAME "DHT11"
   #define HOT4_R25  0.0
   #define HOT4_BETA 0.0
+#elif TEMP_SENSOR_HE4 == 12
+  #define HOT4_NAME "TOOLBOARD"
+  #define HOT4_R25  0.0
+  #define HOT4_BETA 0.0
 #elif TEMP_SENSOR_HE4 == 20
   #define HOT4_NAME "AMPLIFIER"
   #define HOT4_R25  0.0
@@ -339,6 +359,10 @@
   #define HOT5_NAME "DHT11"
   #define HOT5_R25  0.0
   #define HOT5_BETA 0.0
+#elif TEMP_SENSOR_HE5 == 12
+  #define HOT5_NAME "TOOLBOARD"
+  #define HOT5_R25  0.0
+  #define HOT5_BETA 0.0
 #elif TEMP_SENSOR_HE5 == 20
   #define HOT5_NAME "AMPLIFIER"
   #define HOT5_R25  0.0
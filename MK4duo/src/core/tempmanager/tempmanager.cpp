@@ -53,8 +53,32 @@ temp_data_t TempManager::heater;
 
 /** Private Parameters */
 
+// The heaters, in the static RAM
+#if HAS_HOTENDS
+  static StaticPool<Heater, MAX_HOTEND>   hotend_pool;
+#endif
+#if HAS_BEDS
+  static StaticPool<Heater, MAX_BED>      bed_pool;
+#endif
+#if HAS_CHAMBERS
+  static StaticPool<Heater, MAX_CHAMBER>  chamber_pool;
+#endif
+#if HAS_COOLERS
+  static StaticPool<Heater, MAX_COOLER>   cooler_pool;
+#endif
+
+Heater* TempManager::heater_list[MAX_HOTEND + MAX_BED + MAX_CHAMBER + MAX_COOLER] = { nullptr };
+uint8_t TempManager::heater_list_count = 0;
+
+#if ENABLED(HEAT_IN_BACKGROUND)
+  bool TempManager::deferred_waits = false;
+#endif
+
+#if ENABLED(POWER_BUDGET)
+  uint16_t TempManager::heater_watts[MAX_HOTEND + MAX_BED + MAX_CHAMBER + MAX_COOLER] = { 0 };
+#endif
+
 #if ENABLED(FILAMENT_WIDTH_SENSOR)
-  int8_t    TempManager::meas_shift_index;          // Index of a delayed sample in buffer
   uint16_t  TempManager::current_raw_filwidth = 0;  // Measured filament diameter - one extruder only
 #endif
 
@@ -96,7 +120,7 @@ void TempManager::create_object() {
   #if HAS_HOTENDS
     LOOP_HOTEND() {
       if (!hotends[h]) {
-        hotends[h] = new Heater(IS_HOTEND, HOTEND_CHECK_INTERVAL, HOTEND_HYSTERESIS, WATCH_HOTEND_PERIOD, WATCH_HOTEND_INCREASE);
+        hotends[h] = hotend_pool.create(h, IS_HOTEND, HOTEND_CHECK_INTERVAL, HOTEND_PID_INTERVAL, HOTEND_HYSTERESIS, WATCH_HOTEND_PERIOD, WATCH_HOTEND_INCREASE);
         hotends_factory_parameters(h);
         SERIAL_LMV(ECHO, "Create H", int(h));
         hotends[h]->init();
@@ -107,7 +131,7 @@ void TempManager::create_object() {
   #if HAS_BEDS
     LOOP_BED() {
       if (!beds[h]) {
-        beds[h] = new Heater(IS_BED, BED_CHECK_INTERVAL, BED_HYSTERESIS, WATCH_BED_PERIOD, WATCH_BED_INCREASE);
+        beds[h] = bed_pool.create(h, IS_BED, BED_CHECK_INTERVAL, BED_PID_INTERVAL, BED_HYSTERESIS, WATCH_BED_PERIOD, WATCH_BED_INCREASE);
         beds_factory_parameters(h);
         SERIAL_LMV(ECHO, "Create Bed", int(h));
         beds[h]->init();
@@ -118,7 +142,7 @@ void TempManager::create_object() {
   #if HAS_CHAMBERS
     LOOP_CHAMBER() {
       if (!chambers[h]) {
-        chambers[h] = new Heater(IS_CHAMBER, CHAMBER_CHECK_INTERVAL, CHAMBER_HYSTERESIS, WATCH_CHAMBER_PERIOD, WATCH_CHAMBER_INCREASE);
+        chambers[h] = chamber_pool.create(h, IS_CHAMBER, CHAMBER_CHECK_INTERVAL, CHAMBER_PID_INTERVAL, CHAMBER_HYSTERESIS, WATCH_CHAMBER_PERIOD, WATCH_CHAMBER_INCREASE);
         chambers_factory_parameters(h);
         SERIAL_LMV(ECHO, "Create Chamber", int(h));
         chambers[h]->init();
@@ -129,7 +153,7 @@ void TempManager::create_object() {
   #if HAS_COOLERS
     LOOP_COOLER() {
       if (!coolers[h]) {
-        coolers[h] = new Heater(IS_COOLER, COOLER_CHECK_INTERVAL, COOLER_HYSTERESIS, WATCH_COOLER_PERIOD, WATCH_COOLER_INCREASE);
+        coolers[h] = cooler_pool.create(h, IS_COOLER, COOLER_CHECK_INTERVAL, COOLER_PID_INTERVAL, COOLER_HYSTERESIS, WATCH_COOLER_PERIOD, WATCH_COOLER_INCREASE);
         coolers_factory_parameters(h);
         SERIAL_LMV(ECHO, "Create Cooler", int(h));
         coolers[h]->init();
@@ -137,6 +161,8 @@ void TempManager::create_object() {
     }
   #endif
 
+  refresh_heater_list();
+
 }
 
 void TempManager::factory_parameters() {
@@ -169,6 +195,9 @@ void TempManager::factory_parameters() {
 
 void TempManager::change_number_heater(const HeatertypeEnum type, const uint8_t h) {
 
+  // No pass on the heaters while they are deleted
+  heater_list_count = 0;
+
   if (type == IS_HOTEND) {
     if (heater.hotends < h) {
       heater.hotends = h;
@@ -177,8 +206,7 @@ void TempManager::change_number_heater(const HeatertypeEnum type, const uint8_t
     else if (heater.hotends > h) {
       for (uint8_t hh = h; hh < MAX_HOTEND; hh++) {
         if (hotends[hh]) {
-          delete (hotends[hh]);
-          hotends[hh] = nullptr;
+          hotend_pool.destroy(hotends[hh]);
           SERIAL_LMV(ECHO, "Delete H", int(hh));
         }
       }
@@ -193,8 +221,7 @@ void TempManager::change_number_heater(const HeatertypeEnum type, const uint8_t
     else if (heater.beds > h) {
       for (uint8_t hh = h; hh < MAX_BED; hh++) {
         if (beds[hh]) {
-          delete (beds[hh]);
-          beds[hh] = nullptr;
+          bed_pool.destroy(beds[hh]);
           SERIAL_LMV(ECHO, "Delete Bed", int(hh));
         }
       }
@@ -209,8 +236,7 @@ void TempManager::change_number_heater(const HeatertypeEnum type, const uint8_t
     else if (heater.chambers > h) {
       for (uint8_t hh = h; hh < MAX_CHAMBER; hh++) {
         if (chambers[hh]) {
-          delete (chambers[hh]);
-          chambers[hh] = nullptr;
+          chamber_pool.destroy(chambers[hh]);
           SERIAL_LMV(ECHO, "Delete Chamber", int(hh));
         }
       }
@@ -218,22 +244,13 @@ void TempManager::change_number_heater(const HeatertypeEnum type, const uint8_t
     }
   }
 
+  refresh_heater_list();
+
 }
 
 void TempManager::set_output_pwm() {
 
-  #if HAS_HOTENDS
-    LOOP_HOTEND() hotends[h]->set_output_pwm();
-  #endif
-  #if HAS_BEDS
-    LOOP_BED() beds[h]->set_output_pwm();
-  #endif
-  #if HAS_CHAMBERS
-    LOOP_CHAMBER() chambers[h]->set_output_pwm();
-  #endif
-  #if HAS_COOLERS
-    LOOP_COOLER() coolers[h]->set_output_pwm();
-  #endif
+  LOOP_L_N(i, heater_list_count) heater_list[i]->set_output_pwm();
 
   #if DISABLED(SOFTWARE_PDM)
     pwm_soft_count += SOFT_PWM_STEP;
@@ -256,36 +273,12 @@ void TempManager::spin() {
     if (emergency_parser.killed_by_M112) printer.kill(PSTR("M112"));
   #endif
 
-  #if HAS_HOTENDS
-    LOOP_HOTEND() {
-      // Update Current TempManager
-      hotends[h]->update_current_temperature();
-      hotends[h]->check_and_power();
-    }
-  #endif
-
-  #if HAS_BEDS
-    LOOP_BED() {
-      // Update Current TempManager
-      beds[h]->update_current_temperature();
-      beds[h]->check_and_power();
-    } // LOOP_BED
-  #endif
+  // Update the temperatures, then the safety checks and the output of every heater
+  LOOP_L_N(i, heater_list_count) heater_list[i]->update_current_temperature();
+  LOOP_L_N(i, heater_list_count) heater_list[i]->check_and_power();
 
-  #if HAS_CHAMBERS
-    LOOP_CHAMBER() {
-      // Update Current TempManager
-      chambers[h]->update_current_temperature();
-      chambers[h]->check_and_power();
-    } // LOOP_CHAMBER
-  #endif
-
-  #if HAS_COOLERS
-    LOOP_COOLER() {
-      // Update Current TempManager
-      coolers[h]->update_current_temperature();
-      coolers[h]->check_and_power();
-    } // LOOP_COOLER
+  #if ENABLED(POWER_BUDGET)
+    allocate_power();
   #endif
 
   #if HAS_MCU_TEMPERATURE
@@ -293,49 +286,32 @@ void TempManager::spin() {
     NOLESS(mcu_highest_temperature, mcu_current_temperature);
   #endif
 
-  // Control the extruder rate based on the width sensor
-  #if ENABLED(FILAMENT_WIDTH_SENSOR)
-
-    filament_width_meas = analog2widthFil();
-
-    if (filament_sensor) {
-      meas_shift_index = filwidth_delay_index[0] - meas_delay_cm;
-      if (meas_shift_index < 0) meas_shift_index += MAX_MEASUREMENT_DELAY + 1;  //loop around buffer if needed
-      LIMIT(meas_shift_index, 0, MAX_MEASUREMENT_DELAY);
-
-      // Convert the ratio value given by the filament width sensor
-      // into a volumetric multiplier. Conversion differs when using
-      // linear extrusion vs volumetric extrusion.
-      const float nom_meas_ratio = 1.0 + 0.01f * measurement_delay[meas_shift_index],
-                  ratio_2 = sq(nom_meas_ratio);
-
-      toolManager.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM] = toolManager.isVolumetric()
-        ? ratio_2 / CIRCLE_AREA(filament_width_nominal * 0.5f)  // Volumetric uses a true volumetric multiplier
-        : ratio_2;                                              // Linear squares the ratio, which scales the volume
-
-      extruders[FILAMENT_SENSOR_EXTRUDER_NUM]->refresh_e_factor();
+  #if ENABLED(TEMP_HISTORY)
+    static uint8_t history_ticks = 0;
+    if (++history_ticks >= TEMP_HISTORY_INTERVAL / 100) {
+      history_ticks = 0;
+      #if HAS_HOTENDS
+        LOOP_HOTEND() hotends[h]->history.add(hotends[h]->current_temperature, hotends[h]->pwm_value);
+      #endif
+      #if HAS_BEDS
+        LOOP_BED() beds[h]->history.add(beds[h]->current_temperature, beds[h]->pwm_value);
+      #endif
+      #if HAS_CHAMBERS
+        LOOP_CHAMBER() chambers[h]->history.add(chambers[h]->current_temperature, chambers[h]->pwm_value);
+      #endif
+      #if HAS_COOLERS
+        LOOP_COOLER() coolers[h]->history.add(coolers[h]->current_temperature, coolers[h]->pwm_value);
+      #endif
     }
+  #endif
 
-  #endif // FILAMENT_WIDTH_SENSOR
+  // The width for the ring of the planner, each block takes its factor from there
+  #if ENABLED(FILAMENT_WIDTH_SENSOR)
+    filament_width_meas = analog2widthFil();
+  #endif
   
   #if HAS_POWER_CONSUMPTION_SENSOR
-
-    static millis_l last_update = millis();
-    millis_l temp_last_update = millis();
-    millis_l from_last_update = temp_last_update - last_update;
-    static float watt_overflow = 0.0;
-    powerManager.consumption_meas = powerManager.analog2power();
-    /*SERIAL_MV("adc_raw:", powerManager.raw_analog2voltage(), 5);
-    SERIAL_MV(" - V:", powerManager.analog2voltage(), 5);
-    SERIAL_MV(" - I:", powerManager.analog2current(), 5);
-    SERIAL_EMV(" - P:", powerManager.analog2power(), 5);*/
-    watt_overflow += (powerManager.consumption_meas * from_last_update) / 3600000.0;
-    if (watt_overflow >= 1.0) {
-      print_job_counter.incConsumptionHour();
-      watt_overflow--;
-    }
-    last_update = temp_last_update;
-
+    powerManager.spin_consumption();
   #endif
 
   // Reset the watchdog after we know we have a temperature measurement.
@@ -486,46 +462,49 @@ bool TempManager::heaters_isActive() {
 
 #if HAS_MAX31855 || HAS_MAX6675
 
+  /**
+   * Read one heater sensor per call, in turn. Each heater gets a slot
+   * every THERMOCOUPLE_SAMPLE_PERIOD ms, so a call makes one SPI transfer
+   * at most, instead of one for each thermocouple.
+   */
   void TempManager::getTemperature_SPI() {
 
+    static short_timer_t next_spi_timer(millis());
+    static uint8_t spi_slot = 0;
+
+    const uint8_t slots = heater.hotends + heater.beds + heater.chambers;
+
+    if (!slots || !next_spi_timer.expired(THERMOCOUPLE_SAMPLE_PERIOD / slots)) return;
+
+    if (spi_slot >= slots) spi_slot = 0;
+
+    Heater *act = nullptr;
+    uint8_t slot = spi_slot++;
+
     #if HAS_HOTENDS
-      LOOP_HOTEND() {
-        if (false) {}
-        #if HAS_MAX31855
-          else if (hotends[h]->data.sensor.type == -4)
-            hotends[h]->data.sensor.adc_raw = hotends[h]->data.sensor.read_max31855();
-        #endif
-        #if HAS_MAX6675
-          else if (hotends[h]->data.sensor.type == -3)
-            hotends[h]->data.sensor.adc_raw = hotends[h]->data.sensor.read_max6675();
-        #endif
-      }
+      if (slot < heater.hotends) act = hotends[slot];
+      slot -= heater.hotends;
     #endif
     #if HAS_BEDS
-      LOOP_BED() {
-        if (false) {}
-        #if HAS_MAX31855
-          else if (beds[h]->data.sensor.type == -4)
-            beds[h]->data.sensor.adc_raw = beds[h]->data.sensor.read_max31855();
-        #endif
-        #if HAS_MAX6675
-          else if (beds[h]->data.sensor.type == -3)
-            beds[h]->data.sensor.adc_raw = beds[h]->data.sensor.read_max6675();
-        #endif
-      }
+      if (!act && slot < heater.beds) act = beds[slot];
+      slot -= heater.beds;
     #endif
     #if HAS_CHAMBERS
-      LOOP_CHAMBER() {
-        if (false) {}
-        #if HAS_MAX31855
-          else if (chambers[h]->data.sensor.type == -4)
-            chambers[h]->data.sensor.adc_raw = chambers[h]->data.sensor.read_max31855();
-        #endif
-        #if HAS_MAX6675
-          else if (chambers[h]->data.sensor.type == -3)
-            chambers[h]->data.sensor.adc_raw = chambers[h]->data.sensor.read_max6675();
-        #endif
-      }
+      if (!act && slot < heater.chambers) act = chambers[slot];
+    #endif
+
+    if (!act) return;
+
+    sensor_data_t &sens = act->data.sensor;
+
+    if (false) {}
+    #if HAS_MAX31855
+      else if (sens.type == -4)
+        sens.adc_raw = sens.read_max31855();
+    #endif
+    #if HAS_MAX6675
+      else if (sens.type == -3)
+        sens.adc_raw = sens.read_max6675();
     #endif
 
   }
@@ -647,6 +626,86 @@ void TempManager::report_temperatures(const bool showRaw/*=false*/) {
 }
 
 /** Private Function */
+void TempManager::refresh_heater_list() {
+  uint8_t n = 0;
+  #if HAS_HOTENDS
+    LOOP_HOTEND()   if (hotends[h])   heater_list[n++] = hotends[h];
+  #endif
+  #if HAS_BEDS
+    LOOP_BED()      if (beds[h])      heater_list[n++] = beds[h];
+  #endif
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER()  if (chambers[h])  heater_list[n++] = chambers[h];
+  #endif
+  #if HAS_COOLERS
+    LOOP_COOLER()   if (coolers[h])   heater_list[n++] = coolers[h];
+  #endif
+  heater_list_count = n;
+
+  #if ENABLED(POWER_BUDGET)
+    constexpr uint16_t  hotend_watts[]  = POWER_BUDGET_HOTEND_WATTS,
+                        bed_watts[]     = POWER_BUDGET_BED_WATTS,
+                        chamber_watts[] = POWER_BUDGET_CHAMBER_WATTS;
+    LOOP_L_N(i, n) {
+      const uint8_t id = heater_list[i]->data.ID;
+      switch (heater_list[i]->type) {
+        case IS_HOTEND:   heater_watts[i] = hotend_watts[ALIM(id, hotend_watts)];     break;
+        case IS_BED:      heater_watts[i] = bed_watts[ALIM(id, bed_watts)];           break;
+        case IS_CHAMBER:  heater_watts[i] = chamber_watts[ALIM(id, chamber_watts)];   break;
+        default:          heater_watts[i] = 0;                                        break;
+      }
+    }
+  #endif
+}
+
+#if ENABLED(HEAT_IN_BACKGROUND)
+
+  void TempManager::wait_deferred() {
+    deferred_waits = false;
+    LOOP_L_N(i, heater_list_count) heater_list[i]->wait_deferred();
+  }
+
+#endif
+
+#if ENABLED(POWER_BUDGET)
+
+  /**
+   * The outputs are asked in W x PWM. A heater in autotune is never touched,
+   * then the heaters holding the target come first and any left is for the
+   * heaters still heating. When a group asks for more than what is left,
+   * all its outputs are scaled down by the same factor.
+   */
+  void TempManager::allocate_power() {
+    uint32_t left = uint32_t(POWER_BUDGET_PSU_WATTS) * 255UL;
+    LOOP_L_N(i, heater_list_count) {
+      if (heater_list[i]->isTuning()) {
+        const uint32_t tuning = uint32_t(heater_watts[i]) * heater_list[i]->pwm_value;
+        left = tuning < left ? left - tuning : 0;
+      }
+    }
+    LOOP_L_N(pass, 2) {
+      uint32_t asked = 0;
+      LOOP_L_N(i, heater_list_count) {
+        Heater * const act = heater_list[i];
+        const bool holding = !act->isActive() || act->current_temperature >= act->deg_target() - (POWER_BUDGET_HOLD_WINDOW);
+        if (!act->isTuning() && holding == (pass == 0)) asked += uint32_t(heater_watts[i]) * act->pwm_value;
+      }
+      if (asked <= left) {
+        left -= asked;
+        continue;
+      }
+      LOOP_L_N(i, heater_list_count) {
+        Heater * const act = heater_list[i];
+        const bool holding = !act->isActive() || act->current_temperature >= act->deg_target() - (POWER_BUDGET_HOLD_WINDOW);
+        if (!act->isTuning() && holding == (pass == 0) && heater_watts[i])
+          act->pwm_value = uint8_t((uint32_t(act->pwm_value) * left) / asked);
+      }
+      left = 0;
+    }
+  }
+
+#endif // POWER_BUDGET
+
 #if HAS_HOTENDS
   void TempManager::hotends_factory_parameters(const uint8_t h) {
 
@@ -700,6 +759,25 @@ void TempManager::report_temperatures(const bool showRaw/*=false*/) {
     heat->setHWinvert(INVERTED_HEATER_PINS);
     heat->setHWpwm(USEABLE_HARDWARE_PWM(heat->data.pin));
     heat->setThermalProtection(THERMAL_PROTECTION_HOTENDS);
+    #if ENABLED(TOOLBOARD)
+      // The heater of a remote hotend is on its node
+      if (sens->type == 12) heat->data.pin = NoPin;
+    #endif
+    #if ENABLED(HOTEND_MPC)
+      constexpr float MPC_power[]     = MPC_HEATER_POWER,
+                      MPC_capacity[]  = MPC_BLOCK_HEAT_CAPACITY,
+                      MPC_sensor[]    = MPC_SENSOR_RESPONSIVENESS,
+                      MPC_fan0[]      = MPC_AMBIENT_XFER_COEFF,
+                      MPC_fan255[]    = MPC_AMBIENT_XFER_COEFF_FAN255,
+                      MPC_filament[]  = MPC_FILAMENT_HEAT_CAPACITY;
+      mpc_data_t &mpc                 = heat->data.mpc;
+      mpc.heater_power                = MPC_power[ALIM(h, MPC_power)];
+      mpc.block_heat_capacity         = MPC_capacity[ALIM(h, MPC_capacity)];
+      mpc.sensor_responsiveness       = MPC_sensor[ALIM(h, MPC_sensor)];
+      mpc.ambient_xfer_coeff_fan0     = MPC_fan0[ALIM(h, MPC_fan0)];
+      mpc.fan255_adjustment           = MPC_fan255[ALIM(h, MPC_fan255)] - mpc.ambient_xfer_coeff_fan0;
+      mpc.filament_heat_capacity_permm = MPC_filament[ALIM(h, MPC_filament)];
+    #endif
     #if HAS_EEPROM
       heat->setPidTuned(false);
     #else
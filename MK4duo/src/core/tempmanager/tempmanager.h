@@ -22,8 +22,10 @@
 #pragma once
 
 #include "dhtsensor/dhtsensor.h"
+#include "../../feature/toolboard/toolboard.h"
 #include "sensor/sensor.h"
 #include "pid/pid.h"
+#include "mpc/mpc.h"
 #include "heater/heater.h"
 
 struct temp_data_t {
@@ -68,10 +70,21 @@ class TempManager {
       static int16_t extrude_min_temp;
     #endif
 
+    #if ENABLED(HEAT_IN_BACKGROUND)
+      static bool    deferred_waits;  // Some heater has a M109-M190-M191 wait still to do
+    #endif
+
   private: /** Private Parameters */
 
+    // All the heaters in one list, for the passes on every heater
+    static Heater*  heater_list[MAX_HOTEND + MAX_BED + MAX_CHAMBER + MAX_COOLER];
+    static uint8_t  heater_list_count;
+
+    #if ENABLED(POWER_BUDGET)
+      static uint16_t heater_watts[MAX_HOTEND + MAX_BED + MAX_CHAMBER + MAX_COOLER];  // Power at full PWM of each heater of the list
+    #endif
+
     #if ENABLED(FILAMENT_WIDTH_SENSOR)
-      static int8_t   meas_shift_index;     // Index of a delayed sample in buffer
       static uint16_t current_raw_filwidth; // Measured filament diameter - one extruder only
     #endif
 
@@ -186,8 +199,31 @@ class TempManager {
     FORCE_INLINE static bool hotEnoughToExtrude(const uint8_t h) { return !tooColdToExtrude(h); }
     FORCE_INLINE static bool targetHotEnoughToExtrude(const uint8_t h) { return !targetTooColdToExtrude(h); }
 
+    // All the heaters, in the order hotends, beds, chambers, coolers
+    FORCE_INLINE static uint8_t heater_count()              { return heater_list_count; }
+    FORCE_INLINE static Heater* heater_at(const uint8_t h)  { return heater_list[h]; }
+
+    #if ENABLED(HEAT_IN_BACKGROUND)
+      /**
+       * Do the M109-M190-M191 waits left to the background
+       */
+      static void wait_deferred();
+    #endif
+
   private: /** Private Function */
 
+    /**
+     * Rebuild the list of all the heaters after a creation or a deletion
+     */
+    static void refresh_heater_list();
+
+    #if ENABLED(POWER_BUDGET)
+      /**
+       * Share the power of the PSU among the outputs of the heaters
+       */
+      static void allocate_power();
+    #endif
+
     /**
      * Hotends Factory parameters
      */
@@ -221,6 +221,17 @@ static_assert(1 >= 0
   #endif
 #endif
 
+#if ENABLED(TOOL_CHANGE_PREHEAT)
+  #if MAX_EXTRUDER < 2 || MAX_HOTEND < 2
+    #error "DEPENDENCY ERROR: You must have MAX_EXTRUDER > 1 and MAX_HOTEND > 1 for TOOL_CHANGE_PREHEAT."
+  #endif
+  #if DISABLED(TOOL_CHANGE_PREHEAT_LEAD)
+    #error "DEPENDENCY ERROR: TOOL_CHANGE_PREHEAT requires TOOL_CHANGE_PREHEAT_LEAD."
+  #elif TOOL_CHANGE_PREHEAT_LEAD < 1
+    #error "DEPENDENCY ERROR: TOOL_CHANGE_PREHEAT_LEAD must be at least 1 second."
+  #endif
+#endif
+
 #if (ENABLED(DONDOLO_SINGLE_MOTOR) || ENABLED(DONDOLO_DUAL_MOTOR)) && !HAS_SERVOS
   #error "DEPENDENCY ERROR: You must enabled ENABLE_SERVOS and set NUM_SERVOS > 0 for DONDOLO MULTI EXTRUDER."
 #endif
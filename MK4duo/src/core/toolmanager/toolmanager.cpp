@@ -43,12 +43,21 @@ tool_data_t ToolManager::extruder;
         ToolManager::IDLE_OOZING_retracted[MAX_EXTRUDER] = { false };
 #endif
 
+#if ENABLED(LIN_ADVANCE_PROFILES)
+  advance_profile_t ToolManager::advance_profile[LIN_ADVANCE_PROFILES];
+  uint8_t           ToolManager::advance_profile_active = 0;
+  float             ToolManager::profile_flow           = 1.0f;
+#endif
+
+// The extruders, in the static RAM
+static StaticPool<Extruder, MAX_EXTRUDER> extruder_pool;
+
 /** Public Function */
 void ToolManager::create_object() {
   #if MAX_EXTRUDER > 0
     LOOP_EXTRUDER() {
       if (!extruders[e]) {
-        extruders[e] = new Extruder();
+        extruders[e] = extruder_pool.create(e);
         extruder_factory_parameters(e);
         SERIAL_LMV(ECHO, "Create E", int(e));
       }
@@ -73,6 +82,11 @@ void ToolManager::factory_parameters() {
     IDLE_OOZING_enabled = true;
   #endif
 
+  #if ENABLED(LIN_ADVANCE_PROFILES)
+    LOOP_L_N(p, LIN_ADVANCE_PROFILES) advance_profile[p] = advance_profile_t();
+    set_advance_profile(0);
+  #endif
+
 }
 
 void ToolManager::extruder_factory_parameters(const uint8_t e) {
@@ -143,8 +157,7 @@ void ToolManager::change_number_extruder(const uint8_t e) {
     for (uint8_t ee = e; ee < MAX_EXTRUDER; ee++) {
       if (extruders[ee]) {
         SERIAL_LMV(ECHO, "Delete extruder ", ee);
-        delete (extruders[ee]);
-        extruders[ee] = nullptr;
+        extruder_pool.destroy(extruders[ee]);
       }
     }
     extruder.total = e;
@@ -321,6 +334,10 @@ void ToolManager::change(const uint8_t new_tool, bool no_move/*=false*/) {
       // Tell the planner the new "current position"
       mechanics.sync_plan_position();
 
+      #if ENABLED(TOOL_CHANGE_PREHEAT)
+        standby_tool_change();
+      #endif
+
       #if MECH(DELTA)
         const bool safe_to_move = mechanics.position.z < mechanics.delta_clip_start_height - 1;
       #else
@@ -418,14 +435,11 @@ void ToolManager::print_M563() {
 
   void ToolManager::setup_test_linadvance() {
     SERIAL_EONOFF(" Test Linear Advance", IsTestLinAdvance());
-    if (IsTestLinAdvance()) {
-      planner.synchronize();
+    if (IsTestLinAdvance())
       extruders[extruder.active]->data.advance_K = LIN_ADVANCE_K_START;
-    }
   }
 
   void ToolManager::test_linadvance() {
-    planner.synchronize();
     extruders[extruder.active]->data.advance_K += LIN_ADVANCE_K_FACTOR;
     SERIAL_SMV(ECHO, " Layer:", printer.currentLayer);
     SERIAL_EMV(" Lin Advance K:", extruders[extruder.active]->data.advance_K);
@@ -437,8 +451,26 @@ void ToolManager::print_M563() {
       SERIAL_SMV(CFG, "  M900 T", (int)e);
       SERIAL_EMV(" K", extruders[e]->data.advance_K);
     }
+    #if ENABLED(LIN_ADVANCE_PROFILES)
+      SERIAL_LM(CFG, "Linear Advance profiles P<profile> K<factor> F<flow>");
+      LOOP_L_N(p, LIN_ADVANCE_PROFILES) {
+        SERIAL_SMV(CFG, "  M900 P", int(p + 1));
+        SERIAL_MV(" K", advance_profile[p].K);
+        SERIAL_EMV(" F", advance_profile[p].flow_percentage);
+      }
+      SERIAL_LMV(CFG, "  Active profile: ", int(advance_profile_active));
+    #endif
   }
 
+  #if ENABLED(LIN_ADVANCE_PROFILES)
+
+    void ToolManager::set_advance_profile(const uint8_t p) {
+      advance_profile_active = p;
+      profile_flow = p ? advance_profile[p - 1].flow_percentage * 0.01f : 1.0f;
+    }
+
+  #endif
+
 #endif
 
 #if ENABLED(VOLUMETRIC_EXTRUSION)
@@ -521,6 +553,139 @@ void ToolManager::print_M563() {
 
 #endif
 
+#if ENABLED(TOOL_CHANGE_PREHEAT)
+
+  /**
+   * Estimate of the time of the queued commands, up to the next T
+   */
+  struct tool_scan_t {
+    xyz_pos_t   pos;
+    feedrate_t  fr_mm_s;
+    bool        relative;
+    float       seconds;
+  };
+
+  static float tool_scan_number(const char* &p, const char * const end) {
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+    float value = 0, scale = 0;
+    for (; p < end; p++) {
+      if (NUMERIC(*p)) {
+        value = value * 10 + (*p - '0');
+        if (scale) scale *= 10;
+      }
+      else if (*p == '.' && !scale) scale = 1;
+      else break;
+    }
+    if (scale > 1) value /= scale;
+    return neg ? -value : value;
+  }
+
+  /**
+   * Add the time of a line to the scan, return the tool of a T or -1
+   */
+  static int8_t tool_scan_line(const char *p, const char * const end, tool_scan_t &scan) {
+    while (p < end && *p == ' ') p++;
+    if (p < end && *p == 'N') {
+      p++;
+      while (p < end && (NUMERIC(*p) || *p == ' ')) p++;
+    }
+    if (p >= end) return -1;
+
+    const char letter = *p++;
+    if (p >= end || !NUMERIC(*p)) return -1;
+    const int16_t code = tool_scan_number(p, end);
+
+    if (letter == 'T') return code < MAX_EXTRUDER ? code : -1;
+    if (letter != 'G') return -1;
+
+    switch (code) {
+      case 0: case 1: case 2: case 3: {
+        // Arcs are taken as their chord
+        xyz_pos_t dest = scan.pos;
+        while (p < end && *p != ';' && *p != '*') {
+          const char c = *p++;
+          switch (c) {
+            case 'X': dest.x = tool_scan_number(p, end) + (scan.relative ? scan.pos.x : 0); break;
+            case 'Y': dest.y = tool_scan_number(p, end) + (scan.relative ? scan.pos.y : 0); break;
+            case 'Z': dest.z = tool_scan_number(p, end) + (scan.relative ? scan.pos.z : 0); break;
+            case 'F': scan.fr_mm_s = MMM_TO_MMS(tool_scan_number(p, end)); break;
+            default: break;
+          }
+        }
+        if (scan.fr_mm_s > 0) {
+          const xyz_pos_t diff = dest - scan.pos;
+          scan.seconds += SQRT(sq(diff.x) + sq(diff.y) + sq(diff.z)) / scan.fr_mm_s;
+        }
+        scan.pos = dest;
+      } break;
+      case 4:
+        while (p < end && *p != ';' && *p != '*') {
+          const char c = *p++;
+          if (c == 'P') scan.seconds += tool_scan_number(p, end) * 0.001f;
+          else if (c == 'S') scan.seconds += tool_scan_number(p, end);
+        }
+        break;
+      case 90: scan.relative = false; break;
+      case 91: scan.relative = true;  break;
+      default: break;
+    }
+    return -1;
+  }
+
+  void ToolManager::preheat_lookahead() {
+
+    static short_timer_t next_scan_timer(millis());
+    if (!printer.isPrinting() || !next_scan_timer.expired(500)) return;
+
+    tool_scan_t scan;
+    scan.pos = mechanics.position;
+    toLogical(scan.pos);
+    scan.fr_mm_s  = mechanics.feedrate_mm_s;
+    scan.relative = mechanics.axis_is_relative(X_AXIS);
+    scan.seconds  = 0;
+
+    // The moves in the planner come first
+    for (uint8_t b = planner.block_buffer_tail; b != planner.block_buffer_head; b = BLOCK_MOD(b + 1)) {
+      const block_t * const block = &planner.block_buffer[b];
+      if (!TEST(block->flag, BLOCK_BIT_SYNC_POSITION)) scan.seconds += block->millimeters * block->inverse_nominal_speed;
+    }
+
+    constexpr float lead = TOOL_CHANGE_PREHEAT_LEAD;
+    int8_t tool = -1;
+
+    uint8_t index = commands.buffer_ring.head();
+    for (uint8_t n = commands.buffer_ring.count(); n-- && tool < 0 && scan.seconds <= lead; index = (index + 1) % commands.buffer_ring.size()) {
+      const char * const line = commands.buffer_ring.peek(index).gcode;
+      tool = tool_scan_line(line, line + strlen(line), scan);
+    }
+
+    #if ENABLED(SDSUPPORT) && ENABLED(SD_READ_AHEAD)
+      // Then the lines already read from the card
+      if (tool < 0 && scan.seconds <= lead && IS_SD_PRINTING()) {
+        uint16_t count;
+        const char *p = card.read_ahead_unread(count);
+        const char * const end = p + count;
+        while (p < end && tool < 0 && scan.seconds <= lead) {
+          const char *eol = (const char*)memchr(p, '\n', end - p);
+          if (!eol) eol = end;
+          tool = tool_scan_line(p, eol, scan);
+          p = eol + 1;
+        }
+      }
+    #endif
+
+    if (tool < 0 || tool >= extruder.total || scan.seconds > lead) return;
+
+    const uint8_t h = extruders[tool]->get_hotend();
+    if (h != active_hotend() && hotends[h]->isIdle()) {
+      hotends[h]->reset_idle_timer();
+      if (printer.debugFeature()) DEBUG_EMV("Preheat for T", int(tool));
+    }
+  }
+
+#endif // TOOL_CHANGE_PREHEAT
+
 #if ENABLED(EXT_SOLENOID)
 
   void ToolManager::enable_solenoid(const uint8_t e) {
@@ -844,3 +1009,27 @@ void ToolManager::fast_line_to_current(const AxisEnum fr_axis) {
   }
 
 #endif // DUAL_X_CARRIAGE
+
+#if ENABLED(TOOL_CHANGE_PREHEAT)
+
+  /**
+   * The old hotend goes to its idle temperature, if set,
+   * the new one heats back to its target if it was idle
+   */
+  void ToolManager::standby_tool_change() {
+    const uint8_t old_h = extruders[extruder.previous]->get_hotend(),
+                  new_h = active_hotend();
+    if (old_h == new_h) return;
+
+    if (hotends[old_h]->deg_idle()) hotends[old_h]->start_idle_timer(0);
+
+    if (hotends[new_h]->isIdle()) {
+      hotends[new_h]->reset_idle_timer();
+      #if HAS_LCD
+        nozzle.set_heating_message();
+      #endif
+      hotends[new_h]->wait_for_target(true);
+    }
+  }
+
+#endif // TOOL_CHANGE_PREHEAT
@@ -38,6 +38,14 @@ struct tool_data_t {
   bool    LA_test     : 1;
 };
 
+#if ENABLED(LIN_ADVANCE_PROFILES)
+  // Struct pressure advance and flow of a feature of the print (perimeter, infill, bridge...)
+  struct advance_profile_t {
+    float   K               = LIN_ADVANCE_K;
+    int16_t flow_percentage = 100;
+  };
+#endif
+
 class ToolManager {
 
   public: /** Constructor */
@@ -56,6 +64,12 @@ class ToolManager {
       static bool IDLE_OOZING_enabled;
     #endif
 
+    #if ENABLED(LIN_ADVANCE_PROFILES)
+      static advance_profile_t  advance_profile[LIN_ADVANCE_PROFILES];
+      static uint8_t            advance_profile_active; // 1 to LIN_ADVANCE_PROFILES, 0 for the K of the extruder
+      static float              profile_flow;           // Flow factor of the active profile
+    #endif
+
   private: /** Private Parameters */
 
     #if ENABLED(IDLE_OOZING_PREVENT)
@@ -108,6 +122,23 @@ class ToolManager {
 
       FORCE_INLINE static void setTestLinAdvance(const bool onoff) { extruder.LA_test = onoff; }
       FORCE_INLINE static bool IsTestLinAdvance() { return extruder.LA_test; }
+
+      /**
+       * The K of the moves planned now: of the active profile, else of the extruder
+       */
+      FORCE_INLINE static float advance_K(const uint8_t e) {
+        #if ENABLED(LIN_ADVANCE_PROFILES)
+          if (advance_profile_active) return advance_profile[advance_profile_active - 1].K;
+        #endif
+        return extruders[e]->data.advance_K;
+      }
+    #endif
+
+    #if ENABLED(LIN_ADVANCE_PROFILES)
+      /**
+       * Switch the K and the flow of the next moves, those in the planner keep theirs
+       */
+      static void set_advance_profile(const uint8_t p);
     #endif
 
     #if ENABLED(VOLUMETRIC_EXTRUSION)
@@ -122,6 +153,14 @@ class ToolManager {
       static void IDLE_OOZING_retract(const bool retracting);
     #endif
 
+    #if ENABLED(TOOL_CHANGE_PREHEAT)
+      /**
+       * Heat back the idle hotend of the next T in the queue,
+       * TOOL_CHANGE_PREHEAT_LEAD seconds before the change
+       */
+      static void preheat_lookahead();
+    #endif
+
     #if ENABLED(EXT_SOLENOID)
       static void enable_solenoid(const uint8_t e);
       static void enable_solenoid_on_active_extruder();
@@ -150,6 +189,10 @@ class ToolManager {
       static void dualx_tool_change(bool &no_move);
     #endif
 
+    #if ENABLED(TOOL_CHANGE_PREHEAT)
+      static void standby_tool_change();
+    #endif
+
 };
 
 extern ToolManager toolManager;
@@ -0,0 +1,249 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * accelerometer.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if HAS_ACCELEROMETER
+
+Accelerometer accelerometer;
+
+#if ENABLED(ACCELEROMETER_ADXL345)
+  #define ACC_REG_ID      0x00
+  #define ACC_ID          0xE5
+  #define ACC_REG_DATA    0x32          // DATAX0, X Y and Z little endian
+  #define ACC_REG_FIFO    0x39          // FIFO_STATUS, samples in the low 6 bits
+  #define ACC_RATE_CODE   (ACCELEROMETER_RATE == 1600 ? 0x0E : ACCELEROMETER_RATE == 800 ? 0x0D : 0x0C)
+  constexpr float acc_scale = 0.0039f * 9806.65f;   // Full resolution, 3.9 mg for LSB
+#else
+  #define ACC_REG_ID      0x0F
+  #define ACC_ID          0x44
+  #define ACC_REG_DATA    0x28          // OUT_X_L, X Y and Z little endian
+  #define ACC_REG_FIFO    0x2F          // FIFO_SAMPLES, samples in the low 6 bits
+  #define ACC_RATE_CODE   (ACCELEROMETER_RATE == 1600 ? 0x94 : ACCELEROMETER_RATE == 800 ? 0x84 : 0x74)
+  constexpr float acc_scale = 0.000488f * 9806.65f; // 16 g, 14 bits left aligned, 0.488 mg for LSB
+#endif
+
+#define ACC_FIFO_SIZE     32
+
+/** Public Parameters */
+bool      Accelerometer::ready    = false;
+uint16_t  Accelerometer::overruns = 0;
+
+/** Private Parameters */
+bool        Accelerometer::active = false;
+uint32_t    Accelerometer::count  = 0;
+xyz_int_t   Accelerometer::ref;
+xyz_float_t Accelerometer::sum,
+            Accelerometer::sum2;
+
+#if HAS_SD_SUPPORT
+  SdFile    Accelerometer::log_file;
+#endif
+
+/**
+ * Registers of the chip, on SPI (LIS2DW only) or I2C
+ */
+static void acc_write(const uint8_t reg, const uint8_t val) {
+  #if ENABLED(ACCELEROMETER_SPI)
+    HAL::digitalWrite(ACCELEROMETER_CS_PIN, LOW);
+    HAL::spiSend(reg);
+    HAL::spiSend(val);
+    HAL::digitalWrite(ACCELEROMETER_CS_PIN, HIGH);
+  #else
+    WIRE.beginTransmission(uint8_t(ACCELEROMETER_I2C_ADDRESS));
+    WIRE.write(reg);
+    WIRE.write(val);
+    WIRE.endTransmission();
+  #endif
+}
+
+static void acc_read(const uint8_t reg, uint8_t * const buf, const uint8_t len) {
+  #if ENABLED(ACCELEROMETER_SPI)
+    HAL::digitalWrite(ACCELEROMETER_CS_PIN, LOW);
+    HAL::spiSend(reg | 0x80);           // Read, the address increments with IF_ADD_INC
+    HAL::spiReadBlock(buf, len);
+    HAL::digitalWrite(ACCELEROMETER_CS_PIN, HIGH);
+  #else
+    WIRE.beginTransmission(uint8_t(ACCELEROMETER_I2C_ADDRESS));
+    WIRE.write(reg);
+    WIRE.endTransmission();
+    WIRE.requestFrom(uint8_t(ACCELEROMETER_I2C_ADDRESS), len);
+    for (uint8_t i = 0; i < len; i++)
+      buf[i] = WIRE.available() ? WIRE.read() : 0;
+  #endif
+}
+
+/** Public Function */
+void Accelerometer::init() {
+
+  #if ENABLED(ACCELEROMETER_SPI)
+    HAL::pinMode(ACCELEROMETER_CS_PIN, OUTPUT_HIGH);
+    HAL::spiBegin();
+  #else
+    WIRE.begin();
+    WIRE.setClock(400000);              // A sample is 6 bytes, 100 kHz is too slow for the rate
+  #endif
+
+  uint8_t id = 0;
+  acc_read(ACC_REG_ID, &id, 1);
+  ready = (id == ACC_ID);
+  if (!ready) {
+    SERIAL_LMV(ER, "Accelerometer not found, id ", int(id));
+    return;
+  }
+
+  #if ENABLED(ACCELEROMETER_ADXL345)
+    acc_write(0x2D, 0x00);              // POWER_CTL standby
+    acc_write(0x31, 0x0B);              // DATA_FORMAT full resolution, 16 g
+    acc_write(0x2C, ACC_RATE_CODE);     // BW_RATE
+    acc_write(0x38, 0x80);              // FIFO_CTL stream, the oldest sample is lost when full
+    acc_write(0x2D, 0x08);              // POWER_CTL measure
+  #else
+    acc_write(0x21, 0x0C);              // CTRL2 block data update, address increment
+    acc_write(0x25, 0x30);              // CTRL6 16 g
+    acc_write(0x2E, 0xC0);              // FIFO_CTRL continuous, the oldest sample is lost when full
+    acc_write(0x20, ACC_RATE_CODE);     // CTRL1 rate, high performance
+  #endif
+
+}
+
+bool Accelerometer::read(xyz_float_t &acc) {
+  if (!ready || !fifo_level()) return false;
+  xyz_int_t raw;
+  read_raw(raw);
+  acc.set(raw.x * acc_scale, raw.y * acc_scale, raw.z * acc_scale);
+  return true;
+}
+
+void Accelerometer::start(const char * const log_name/*=nullptr*/) {
+  if (!ready) return;
+
+  #if HAS_SD_SUPPORT
+    if (log_name && card.isMounted()) {
+      card.fat.chdir();
+      if (log_file.open(card.fat.vwd(), log_name, O_CREAT | O_WRITE | O_TRUNC)) {
+        char line[32];
+        sprintf_P(line, PSTR("# rate %i Hz, mm/s^2\n"), int(ACCELEROMETER_RATE));
+        log_file.write(line, strlen(line));
+        SERIAL_EMT("Accelerometer log ", log_name);
+      }
+      else
+        SERIAL_LMT(ER, "Accelerometer log not open ", log_name);
+    }
+  #else
+    UNUSED(log_name);
+  #endif
+
+  // Drop the old samples
+  xyz_int_t raw;
+  for (uint8_t n = fifo_level(); n--;) read_raw(raw);
+
+  overruns = 0;
+  mark(0);
+  active = true;
+}
+
+void Accelerometer::stop() {
+  spin();
+  active = false;
+  #if HAS_SD_SUPPORT
+    if (log_file.isOpen()) {
+      log_file.sync();
+      log_file.close();
+    }
+  #endif
+  if (overruns) SERIAL_EMV("Accelerometer FIFO full ", overruns);
+}
+
+void Accelerometer::mark(const float freq) {
+  count = 0;
+  sum.reset();
+  sum2.reset();
+  #if HAS_SD_SUPPORT
+    if (log_file.isOpen() && freq > 0) {
+      char line[24];
+      sprintf_P(line, PSTR("# freq %i.%i\n"), int(freq), int(freq * 10) % 10);
+      log_file.write(line, strlen(line));
+    }
+  #else
+    UNUSED(freq);
+  #endif
+}
+
+float Accelerometer::vibration() {
+  if (count < 2) return 0;
+  float var = 0;
+  LOOP_XYZ(i) {
+    const float mean = sum[i] / count;
+    var += sum2[i] / count - sq(mean);
+  }
+  return var > 0 ? SQRT(var) : 0;
+}
+
+void Accelerometer::spin() {
+  if (!active) return;
+
+  for (uint8_t n = fifo_level(); n--;) {
+    xyz_int_t raw;
+    read_raw(raw);
+
+    if (!count) ref = raw;
+    LOOP_XYZ(i) {
+      const float d = float(raw[i] - ref[i]) * acc_scale;
+      sum[i] += d;
+      sum2[i] += sq(d);
+    }
+    count++;
+
+    #if HAS_SD_SUPPORT
+      if (log_file.isOpen()) {
+        char line[24];
+        sprintf_P(line, PSTR("%i,%i,%i\n"), int(raw.x * acc_scale), int(raw.y * acc_scale), int(raw.z * acc_scale));
+        log_file.write(line, strlen(line));
+      }
+    #endif
+  }
+}
+
+/** Private Function */
+uint8_t Accelerometer::fifo_level() {
+  uint8_t level = 0;
+  acc_read(ACC_REG_FIFO, &level, 1);
+  level &= 0x3F;
+  if (level >= ACC_FIFO_SIZE) overruns++;
+  return level;
+}
+
+void Accelerometer::read_raw(xyz_int_t &raw) {
+  uint8_t buf[6];
+  acc_read(ACC_REG_DATA, buf, 6);
+  raw.set(int16_t(buf[0] | (buf[1] << 8)), int16_t(buf[2] | (buf[3] << 8)), int16_t(buf[4] | (buf[5] << 8)));
+}
+
+#endif // HAS_ACCELEROMETER
@@ -0,0 +1,95 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * accelerometer.h
+ *
+ * ADXL345 or LIS2DW accelerometer on the toolhead, for the resonance test of M594.
+ * The chip fills its FIFO at ACCELEROMETER_RATE, spin() empties it from the idle
+ * loop: every sample adds to the vibration of the frequency under test and is
+ * logged on SD when a log is open.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if HAS_ACCELEROMETER
+
+class Accelerometer {
+
+  public: /** Constructor */
+
+    Accelerometer() {}
+
+  public: /** Public Parameters */
+
+    static bool       ready;        // The chip answered at init
+    static uint16_t   overruns;     // FIFO full before it was read
+
+  private: /** Private Parameters */
+
+    static bool         active;
+    static uint32_t     count;
+    static xyz_int_t    ref;        // First sample, removes the gravity from the sums
+    static xyz_float_t  sum, sum2;
+
+    #if HAS_SD_SUPPORT
+      static SdFile     log_file;
+    #endif
+
+  public: /** Public Function */
+
+    static void init();
+
+    /**
+     * One sample in mm/s^2, false with no sample in the FIFO
+     */
+    static bool read(xyz_float_t &acc);
+
+    /**
+     * Start the sampling, with a log on SD if the name is not null
+     */
+    static void start(const char * const log_name=nullptr);
+    static void stop();
+
+    /**
+     * A new frequency of the sweep: a new vibration sum and a line in the log
+     */
+    static void mark(const float freq);
+
+    /**
+     * RMS acceleration (mm/s^2) of the samples since the mark
+     */
+    static float vibration();
+
+    static void spin();
+
+  private: /** Private Function */
+
+    static uint8_t fifo_level();
+    static void read_raw(xyz_int_t &raw);
+
+};
+
+extern Accelerometer accelerometer;
+
+#endif // HAS_ACCELEROMETER
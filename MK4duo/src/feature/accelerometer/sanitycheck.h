@@ -0,0 +1,48 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+#if HAS_ACCELEROMETER
+  #if ENABLED(ACCELEROMETER_ADXL345) && ENABLED(ACCELEROMETER_LIS2DW)
+    #error "DEPENDENCY ERROR: Enable only one of ACCELEROMETER_ADXL345 or ACCELEROMETER_LIS2DW."
+  #elif DISABLED(CPU_32_BIT)
+    #error "DEPENDENCY ERROR: The accelerometer requires a 32 bit board."
+  #elif ENABLED(ACCELEROMETER_SPI) && ENABLED(ACCELEROMETER_ADXL345)
+    #error "DEPENDENCY ERROR: The ADXL345 needs SPI mode 3, the SPI of the HAL is mode 0. Put it on I2C."
+  #elif ENABLED(ACCELEROMETER_SPI) && !PIN_EXISTS(ACCELEROMETER_CS)
+    #error "DEPENDENCY ERROR: You have to set ACCELEROMETER_CS_PIN to a valid pin if you enable ACCELEROMETER_SPI."
+  #elif DISABLED(ACCELEROMETER_SPI) && DISABLED(ACCELEROMETER_I2C_ADDRESS)
+    #error "DEPENDENCY ERROR: Missing setting ACCELEROMETER_I2C_ADDRESS."
+  #elif ACCELEROMETER_RATE != 400 && ACCELEROMETER_RATE != 800 && ACCELEROMETER_RATE != 1600
+    #error "DEPENDENCY ERROR: ACCELEROMETER_RATE must be 400, 800 or 1600."
+  #elif DISABLED(RESONANCE_FREQ_MIN) || DISABLED(RESONANCE_FREQ_MAX) || DISABLED(RESONANCE_FREQ_STEP) || DISABLED(RESONANCE_ACCEL_PER_HZ) || DISABLED(RESONANCE_TIME)
+    #error "DEPENDENCY ERROR: Missing setting RESONANCE_FREQ_MIN, RESONANCE_FREQ_MAX, RESONANCE_FREQ_STEP, RESONANCE_ACCEL_PER_HZ or RESONANCE_TIME."
+  #elif RESONANCE_FREQ_MIN <= 0 || RESONANCE_FREQ_MAX <= RESONANCE_FREQ_MIN || RESONANCE_FREQ_MAX * 2 >= ACCELEROMETER_RATE
+    #error "DEPENDENCY ERROR: RESONANCE_FREQ_MAX must be over RESONANCE_FREQ_MIN and under half of ACCELEROMETER_RATE."
+  #endif
+#endif
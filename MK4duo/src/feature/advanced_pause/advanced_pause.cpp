@@ -49,13 +49,28 @@ PauseMenuResponseEnum AdvancedPause::menu_response;
 uint8_t AdvancedPause::did_pause_print = 0;
 
 /** Public Function */
-void AdvancedPause::do_pause_e_move(const float &length, const feedrate_t &fr_mm_s) {
+
+/**
+ * E move queued in segments of PAUSE_PARK_E_SEGMENT, with idle() between them.
+ * The segments go at full speed through their junctions, a quick stop ends the move.
+ * Return false if the move was stopped.
+ */
+bool AdvancedPause::do_pause_e_move(const float &length, const feedrate_t &fr_mm_s) {
   #if HAS_FILAMENT_SENSOR
     filamentrunout.reset();
   #endif
-  mechanics.position.e += length /extruders[toolManager.extruder.active]->e_factor;
-  planner.buffer_line(mechanics.position, fr_mm_s, toolManager.extruder.active);
+  const float     total     = length / extruders[toolManager.extruder.active]->e_factor,
+                  target    = mechanics.position.e + total;
+  const uint16_t  segments  = MAX(1, int(CEIL(ABS(total) / (PAUSE_PARK_E_SEGMENT))));
+  const float     segment   = total / segments;
+
+  for (uint16_t s = 1; s <= segments; s++) {
+    mechanics.position.e = s == segments ? target : mechanics.position.e + segment;
+    if (!planner.buffer_line(mechanics.position, fr_mm_s, toolManager.extruder.active)) return false;
+    printer.idle();
+  }
   planner.synchronize();
+  return true;
 }
 
 /**
@@ -439,10 +454,10 @@ bool AdvancedPause::load_filament(const float &slow_load_length/*=0*/, const flo
   #endif
 
   // Slow Load filament
-  if (slow_load_length) do_pause_e_move(slow_load_length, feedrate_t(PAUSE_PARK_SLOW_LOAD_FEEDRATE));
+  bool loaded = !slow_load_length || do_pause_e_move(slow_load_length, feedrate_t(PAUSE_PARK_SLOW_LOAD_FEEDRATE));
 
   // Fast Load Filament
-  if (fast_load_length) do_pause_e_move(fast_load_length, feedrate_t(PAUSE_PARK_FAST_LOAD_FEEDRATE));
+  if (loaded && fast_load_length) loaded = do_pause_e_move(fast_load_length, feedrate_t(PAUSE_PARK_FAST_LOAD_FEEDRATE));
 
   #if ENABLED(DUAL_X_CARRIAGE)
     toolManager.extruder.active = saved_ext;
@@ -450,6 +465,8 @@ bool AdvancedPause::load_filament(const float &slow_load_length/*=0*/, const flo
     stepper.set_directions();
   #endif
 
+  if (!loaded) return false;
+
   do {
     if (purge_length > 0) {
       // "Wait for filament purge"
@@ -458,7 +475,11 @@ bool AdvancedPause::load_filament(const float &slow_load_length/*=0*/, const flo
       #endif
 
       // Extrude filament to get into hotend
-      do_pause_e_move(purge_length, feedrate_t(PAUSE_PARK_PURGE_FEEDRATE));
+      #if ENABLED(ADVANCED_PAUSE_CONTINUOUS_PURGE)
+        continuous_purge();
+      #else
+        if (!do_pause_e_move(purge_length, feedrate_t(PAUSE_PARK_PURGE_FEEDRATE))) return false;
+      #endif
     }
 
     // Show "Purge More" / "Resume" menu and wait for reply
@@ -527,16 +548,18 @@ bool AdvancedPause::unload_filament(const float &unload_length, const bool show_
   #endif
 
   // Retract filament
-  do_pause_e_move(-FILAMENT_UNLOAD_RETRACT_LENGTH, feedrate_t(PAUSE_PARK_RETRACT_FEEDRATE));
+  if (!do_pause_e_move(-FILAMENT_UNLOAD_RETRACT_LENGTH, feedrate_t(PAUSE_PARK_RETRACT_FEEDRATE))) return false;
 
-  // Wait for filament to cool
-  HAL::delayMilliseconds(FILAMENT_UNLOAD_DELAY);
+  // Wait for filament to cool, the host and the LCD keep running
+  short_timer_t cool_timer(millis());
+  while (!cool_timer.expired(FILAMENT_UNLOAD_DELAY, false)) printer.idle(true);
 
   // Quickly purge
-  do_pause_e_move(FILAMENT_UNLOAD_RETRACT_LENGTH + FILAMENT_UNLOAD_PURGE_LENGTH, extruders[toolManager.extruder.active]->data.max_feedrate_mm_s);
+  if (!do_pause_e_move(FILAMENT_UNLOAD_RETRACT_LENGTH + FILAMENT_UNLOAD_PURGE_LENGTH, extruders[toolManager.extruder.active]->data.max_feedrate_mm_s))
+    return false;
 
   // Unload filament
-  do_pause_e_move(unload_length, feedrate_t(PAUSE_PARK_UNLOAD_FEEDRATE));
+  if (!do_pause_e_move(unload_length, feedrate_t(PAUSE_PARK_UNLOAD_FEEDRATE))) return false;
 
   // Disable extruders steppers for manual filament changing
   #if HAS_E_STEPPER_ENABLE
@@ -548,6 +571,41 @@ bool AdvancedPause::unload_filament(const float &unload_length, const bool show_
 }
 
 /** Private Function */
+
+#if ENABLED(ADVANCED_PAUSE_CONTINUOUS_PURGE)
+
+  /**
+   * Purge in short segments until the LCD click or M108, with two segments at most
+   * in the planner, so the purge ends soon after the confirm.
+   */
+  void AdvancedPause::continuous_purge() {
+    constexpr float segment = 1.0f;
+
+    host_action.prompt_reason = PROMPT_USER_CONTINUE;
+    host_action.prompt_begin(PSTR("Purging"));
+    host_action.prompt_button(PSTR("Continue"));
+    host_action.prompt_show();
+
+    #if HAS_FILAMENT_SENSOR
+      filamentrunout.reset();
+    #endif
+
+    printer.setWaitForUser(true);   // LCD click or M108 will clear this
+    const float e_factor = extruders[toolManager.extruder.active]->e_factor;
+    for (float purged = 0; printer.isWaitForUser() && purged < (PAUSE_PARK_PURGE_MAX_LENGTH);) {
+      if (planner.moves_planned() < 2) {
+        mechanics.position.e += segment / e_factor;
+        if (!planner.buffer_line(mechanics.position, feedrate_t(PAUSE_PARK_PURGE_FEEDRATE), toolManager.extruder.active)) break;
+        purged += segment;
+      }
+      printer.idle(true);
+    }
+    printer.setWaitForUser(false);
+    planner.synchronize();
+  }
+
+#endif
+
 void AdvancedPause::show_continue_prompt(const bool is_reload) {
   #if HAS_LCD_MENU
     lcd_pause_show_message(is_reload ? PAUSE_MESSAGE_INSERT : PAUSE_MESSAGE_WAITING);
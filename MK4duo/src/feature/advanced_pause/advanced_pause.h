@@ -55,7 +55,7 @@ class AdvancedPause {
 
   public: /** Public Function */
 
-    static void do_pause_e_move(const float &length, const feedrate_t &fr_mm_s);
+    static bool do_pause_e_move(const float &length, const feedrate_t &fr_mm_s);
 
     static bool pause_print(const float &retract, const xyz_pos_t &park_point, const float &unload_length=0, const bool show_lcd=false DXC_PARAMS);
 
@@ -75,6 +75,10 @@ class AdvancedPause {
     static void show_continue_prompt(const bool is_reload);
     static bool ensure_safe_temperature(const PauseModeEnum tmode=PAUSE_MODE_SAME);
 
+    #if ENABLED(ADVANCED_PAUSE_CONTINUOUS_PURGE)
+      static void continuous_purge();
+    #endif
+
     #if HAS_BUZZER
       static void filament_change_beep(const int8_t max_beep_count, const bool init=false);
     #endif
@@ -47,6 +47,12 @@
   #if DISABLED(PAUSE_PARK_PRINTER_OFF)
     #error "DEPENDENCY ERROR: Missing setting PAUSE_PARK_PRINTER_OFF."
   #endif
+  #if DISABLED(PAUSE_PARK_E_SEGMENT)
+    #error "DEPENDENCY ERROR: Missing setting PAUSE_PARK_E_SEGMENT."
+  #endif
+  #if ENABLED(ADVANCED_PAUSE_CONTINUOUS_PURGE) && DISABLED(PAUSE_PARK_PURGE_MAX_LENGTH)
+    #error "DEPENDENCY ERROR: Missing setting PAUSE_PARK_PURGE_MAX_LENGTH."
+  #endif
 #else
   #if ENABLED(PARK_HEAD_ON_PAUSE)
     #error "DEPENDENCY ERROR: PARK_HEAD_ON_PAUSE currently requires ADVANCED_PAUSE_FEATURE."
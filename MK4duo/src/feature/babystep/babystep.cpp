@@ -36,6 +36,11 @@ Babystep babystep;
 /** Public Parameters */
 volatile int16_t Babystep::steps[BS_TODO_AXIS(Z_AXIS) + 1];
 
+#if ENABLED(BABYSTEP_PLANNER)
+  float Babystep::z_offset = 0,
+        Babystep::z_target = 0;
+#endif
+
 #if HAS_LCD_MENU
   int16_t Babystep::accum;
   #if ENABLED(BABYSTEP_DISPLAY_TOTAL)
@@ -45,13 +50,29 @@ volatile int16_t Babystep::steps[BS_TODO_AXIS(Z_AXIS) + 1];
 
 /** Public Function */
 void Babystep::spin() {
-  #if ENABLED(BABYSTEP_XY)
+  #if ENABLED(BABYSTEP_XY) && ENABLED(BABYSTEP_PLANNER)
+    step_axis(X_AXIS);
+    step_axis(Y_AXIS);
+  #elif ENABLED(BABYSTEP_XY)
     LOOP_XYZ(axis) step_axis((AxisEnum)axis);
-  #else
+  #elif DISABLED(BABYSTEP_PLANNER)
     step_axis(Z_AXIS);
   #endif
 }
 
+#if ENABLED(BABYSTEP_PLANNER)
+
+  /**
+   * Move the planner Z offset towards the babysteps, called before each G-code move
+   */
+  void Babystep::planner_step() {
+    const float diff = z_target - z_offset;
+    if (diff == 0) return;
+    z_offset = ABS(diff) > (BABYSTEP_PLANNER_MOVE_MM) ? z_offset + (diff > 0 ? (BABYSTEP_PLANNER_MOVE_MM) : -(BABYSTEP_PLANNER_MOVE_MM)) : z_target;
+  }
+
+#endif
+
 void Babystep::add_mm(const AxisEnum axis, const float &mm) {
   add_steps(axis, mm * mechanics.data.axis_steps_per_mm[axis]);
 }
@@ -67,6 +88,13 @@ void Babystep::add_steps(const AxisEnum axis, const int16_t distance) {
     #endif
   #endif
 
+  #if ENABLED(BABYSTEP_PLANNER)
+    if (axis == Z_AXIS) {
+      z_target += (BABYSTEP_INVERT_Z ? -distance : distance) * mechanics.steps_to_mm[Z_AXIS];
+      return;
+    }
+  #endif
+
   #if IS_CORE
     #if ENABLED(BABYSTEP_XY)
       switch (axis) {
@@ -53,6 +53,11 @@ class Babystep {
 
     static volatile int16_t steps[BS_TODO_AXIS(Z_AXIS) + 1];
 
+    #if ENABLED(BABYSTEP_PLANNER)
+      static float  z_offset,                                   // Z offset added to the planned moves
+                    z_target;                                   // Z offset asked by the babysteps
+    #endif
+
       #if HAS_LCD_MENU
         static int16_t accum;                                   // Total babysteps in current edit
         #if ENABLED(BABYSTEP_DISPLAY_TOTAL)
@@ -75,6 +80,11 @@ class Babystep {
     static void add_mm(const AxisEnum axis, const float &mm);
     static void spin();
 
+    #if ENABLED(BABYSTEP_PLANNER)
+      static void planner_step();
+      static inline void planner_reset() { z_offset = z_target = 0; }
+    #endif
+
   private: /** Private Function */
 
     static void step_axis(const AxisEnum axis);
@@ -26,3 +26,13 @@
  *
  * Test configuration values for errors at compile-time.
  */
+
+#if ENABLED(BABYSTEP_PLANNER)
+  #if DISABLED(BABYSTEPPING)
+    #error "DEPENDENCY ERROR: BABYSTEP_PLANNER requires BABYSTEPPING."
+  #elif !defined(BABYSTEP_PLANNER_MOVE_MM)
+    #error "DEPENDENCY ERROR: BABYSTEP_PLANNER requires BABYSTEP_PLANNER_MOVE_MM."
+  #else
+    static_assert(BABYSTEP_PLANNER_MOVE_MM > 0, "DEPENDENCY ERROR: BABYSTEP_PLANNER requires BABYSTEP_PLANNER_MOVE_MM greater than 0.");
+  #endif
+#endif
@@ -52,7 +52,7 @@ void AutoBedLevel::extrapolate_one_point(const uint8_t x, const uint8_t y, const
     DEBUG_CHR(']');
   }
 
-  if (!isnan(z_values[x][y])) {
+  if (!isnan(float(z_values[x][y]))) {
     if (printer.debugFeature()) DEBUG_EM(" (done)");
     return;  // Don't overwrite good values.
   }
@@ -132,20 +132,20 @@ void AutoBedLevel::extrapolate_unprobed_bed_level() {
 void AutoBedLevel::print_bilinear_leveling_grid() {
   SERIAL_LM(ECHO, "Bilinear Leveling Grid:");
   bedlevel.print_2d_array(GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y, 3,
-    [](const uint8_t ix, const uint8_t iy){ return z_values[ix][iy]; }
+    [](const uint8_t ix, const uint8_t iy) -> float { return z_values[ix][iy]; }
   );
 }
 
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
 
-  float       AutoBedLevel::z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
+  mesh_z_t    AutoBedLevel::z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
   xy_float_t  AutoBedLevel::bilinear_grid_factor_virt;
   xy_pos_t    AutoBedLevel::bilinear_grid_spacing_virt;
 
   void AutoBedLevel::print_bilinear_leveling_grid_virt() {
     SERIAL_LM(ECHO, "Subdivided with CATMULL ROM Leveling Grid:");
     bedlevel.print_2d_array(ABL_GRID_POINTS_VIRT_X, ABL_GRID_POINTS_VIRT_Y, 5,
-      [](const uint8_t ix, const uint8_t iy){ return z_values_virt[ix][iy]; }
+      [](const uint8_t ix, const uint8_t iy) -> float { return z_values_virt[ix][iy]; }
     );
   }
 
@@ -242,6 +242,9 @@ void AutoBedLevel::refresh_bed_level() {
   #if ENABLED(ABL_BILINEAR_SUBDIVISION)
     virt_interpolate();
   #endif
+  #if ENABLED(ABL_BILINEAR_COEFFICIENTS)
+    calc_cells();
+  #endif
 }
 
 #if ENABLED(ABL_BILINEAR_SUBDIVISION)
@@ -258,6 +261,43 @@ void AutoBedLevel::refresh_bed_level() {
   #define ABL_BG_GRID(X,Y)  z_values[X][Y]
 #endif
 
+#if ENABLED(ABL_BILINEAR_COEFFICIENTS)
+
+  AutoBedLevel::abl_cell_t AutoBedLevel::cells[ABL_CELLS_X][ABL_CELLS_Y];
+
+  void AutoBedLevel::calc_cells() {
+    for (uint8_t x = 0; x < ABL_CELLS_X; x++) {
+      for (uint8_t y = 0; y < ABL_CELLS_Y; y++) {
+        const float z00 = ABL_BG_GRID(x, y),     z10 = ABL_BG_GRID(x + 1, y),
+                    z01 = ABL_BG_GRID(x, y + 1), z11 = ABL_BG_GRID(x + 1, y + 1);
+        abl_cell_t &cell = cells[x][y];
+        cell.z0  = z00;
+        cell.dx  = z10 - z00;
+        cell.dy  = z01 - z00;
+        cell.dxy = z11 - z10 - z01 + z00;
+      }
+    }
+  }
+
+  // Get the Z adjustment for non-linear bed leveling
+  float AutoBedLevel::bilinear_z_offset(const xy_pos_t &raw) {
+
+    // XY relative to the probed area, in grid units
+    const xy_pos_t rel = raw - bilinear_start.asFloat();
+    xy_float_t ratio = { rel.x * ABL_BG_FACTOR(x), rel.y * ABL_BG_FACTOR(y) };
+
+    // Cell indices, constrained within bounds. Off the grid the edge value is used.
+    const uint8_t cx = constrain(FLOOR(ratio.x), 0, ABL_CELLS_X - 1),
+                  cy = constrain(FLOOR(ratio.y), 0, ABL_CELLS_Y - 1);
+    ratio.x = constrain(ratio.x - cx, 0, 1);
+    ratio.y = constrain(ratio.y - cy, 0, 1);
+
+    const abl_cell_t &cell = cells[cx][cy];
+    return cell.z0 + ratio.x * cell.dx + ratio.y * (cell.dy + ratio.x * cell.dxy);
+  }
+
+#else
+
 // Get the Z adjustment for non-linear bed leveling
 float AutoBedLevel::bilinear_z_offset(const xy_pos_t &raw) {
 
@@ -337,6 +377,8 @@ float AutoBedLevel::bilinear_z_offset(const xy_pos_t &raw) {
   return offset;
 }
 
+#endif // !ABL_BILINEAR_COEFFICIENTS
+
 #if !IS_KINEMATIC
 
   #define CELL_INDEX(A,V) ((V - bilinear_start.A) * ABL_BG_FACTOR(A))
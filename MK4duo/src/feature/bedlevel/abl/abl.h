@@ -42,11 +42,24 @@ class AutoBedLevel {
       #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
       #define ABL_TEMP_POINTS_X (GRID_MAX_POINTS_X + 2)
       #define ABL_TEMP_POINTS_Y (GRID_MAX_POINTS_Y + 2)
-      static float      z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
+      static mesh_z_t   z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
       static xy_float_t bilinear_grid_factor_virt;
       static xy_pos_t   bilinear_grid_spacing_virt;
     #endif
 
+    #if ENABLED(ABL_BILINEAR_COEFFICIENTS)
+      #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+        #define ABL_CELLS_X ((GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS))
+        #define ABL_CELLS_Y ((GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS))
+      #else
+        #define ABL_CELLS_X (GRID_MAX_POINTS_X - 1)
+        #define ABL_CELLS_Y (GRID_MAX_POINTS_Y - 1)
+      #endif
+      // Inside a cell Z = z0 + rx * dx + ry * (dy + rx * dxy), rx and ry from 0 to 1
+      typedef struct { float z0, dx, dy, dxy; } abl_cell_t;
+      static abl_cell_t cells[ABL_CELLS_X][ABL_CELLS_Y];
+    #endif
+
   public: /** Public Function */
 
     static float bilinear_z_offset(const xy_pos_t &raw);
@@ -82,6 +95,10 @@ class AutoBedLevel {
       static float bed_level_virt_2cmr(const uint8_t x, const uint8_t y, const float &tx, const float &ty);
     #endif
 
+    #if ENABLED(ABL_BILINEAR_COEFFICIENTS)
+      static void calc_cells();
+    #endif
+
 };
 
 extern AutoBedLevel abl;
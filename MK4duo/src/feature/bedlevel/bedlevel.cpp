@@ -47,13 +47,29 @@ level_flag_t Bedlevel::flag;
 #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
   float Bedlevel::z_fade_height,
         Bedlevel::inverse_z_fade_height,
-        Bedlevel::last_fade_z;
+        Bedlevel::last_fade_z,
+        Bedlevel::z_fade_factor = 1.0f;
+#endif
+
+#if ENABLED(MESH_STEPPER_CORRECTION)
+  volatile int32_t Bedlevel::mesh_z_steps = 0;
+#endif
+
+/** Private Parameters */
+#if ABL_PLANAR
+  bool  Bedlevel::plane_linear  = true;
+  float Bedlevel::plane_a       = 0.0f,
+        Bedlevel::plane_b       = 0.0f,
+        Bedlevel::plane_c       = 0.0f,
+        Bedlevel::plane_d       = 0.0f,
+        Bedlevel::plane_k       = 1.0f;
 #endif
 
 /** Public Function */
 void Bedlevel::factory_parameters() {
   #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-    z_fade_height = 0.0f;
+    z_fade_height = inverse_z_fade_height = 0.0f;
+    force_fade_recalc();
   #endif
   reset();
 }
@@ -69,10 +85,17 @@ void Bedlevel::apply_leveling(xyz_pos_t &raw) {
   #if ABL_PLANAR
 
     xy_pos_t d = raw - level_fulcrum();
+    if (plane_linear) {
+      const float z = raw.z;
+      raw.z += plane_a * d.x + plane_b * d.y;
+      raw.x += plane_c * z;
+      raw.y += plane_d * z;
+      return;
+    }
     apply_rotation_xyz(matrix, d.x, d.y, raw.z);
     raw = d + level_fulcrum();
 
-  #elif HAS_MESH
+  #elif HAS_MESH && DISABLED(MESH_STEPPER_CORRECTION)
 
     #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
       const float fade_scaling_factor = fade_scaling_factor_for_z(raw.z);
@@ -103,13 +126,19 @@ void Bedlevel::unapply_leveling(xyz_pos_t &raw) {
 
   #if ABL_PLANAR
 
-    matrix_3x3 inverse = matrix_3x3::transpose(matrix);
-
     xy_pos_t d = raw - level_fulcrum();
+    if (plane_linear) {
+      raw.z = (raw.z - plane_a * d.x - plane_b * d.y) * plane_k;
+      raw.x -= plane_c * raw.z;
+      raw.y -= plane_d * raw.z;
+      return;
+    }
+
+    matrix_3x3 inverse = matrix_3x3::transpose(matrix);
     apply_rotation_xyz(inverse, d.x, d.y, raw.z);
     raw = d + level_fulcrum();
 
-  #elif HAS_MESH
+  #elif HAS_MESH && DISABLED(MESH_STEPPER_CORRECTION)
 
     #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
       const float fade_scaling_factor = fade_scaling_factor_for_z(raw.z);
@@ -177,6 +206,10 @@ void Bedlevel::set_bed_leveling_enabled(const bool enable/*=true*/) {
       // change unleveled position.x to physical position.x without moving steppers.
       apply_leveling(mechanics.position);
       flag.leveling_active = false;  // disable only AFTER calling apply_leveling
+      #if ENABLED(MESH_STEPPER_CORRECTION)
+        // The stepper takes Z back to the plane, the position is the same
+        while (mesh_z_steps && !printer.isStopped()) HAL::delayMilliseconds(1);
+      #endif
     }
     else {                          // leveling from off to on
       flag.leveling_active = true;  // enable BEFORE calling unapply_leveling, otherwise ignored
@@ -188,6 +221,47 @@ void Bedlevel::set_bed_leveling_enabled(const bool enable/*=true*/) {
   }
 }
 
+#if ENABLED(MESH_STEPPER_CORRECTION)
+
+  void Bedlevel::mesh_correction_tick() {
+
+    int32_t target = 0;
+
+    if (flag.leveling_active) {
+      // Where the motors are, in the planner the moves are unleveled
+      const xy_pos_t raw = {
+        stepper.position(X_AXIS) * mechanics.steps_to_mm.x,
+        stepper.position(Y_AXIS) * mechanics.steps_to_mm.y
+      };
+      #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+        // Not with fade_scaling_factor_for_z, its values are for the main loop
+        const float fade = MAX(1.0f - stepper.position(Z_AXIS) * mechanics.steps_to_mm.z * inverse_z_fade_height, 0.0f);
+      #else
+        constexpr float fade = 1.0f;
+      #endif
+      #if ENABLED(MESH_BED_LEVELING)
+        const float z = mbl.get_z(raw
+          #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+            , fade
+          #endif
+        );
+      #else
+        const float z = fade ? fade * abl.bilinear_z_offset(raw) : 0.0f;
+      #endif
+      target = LROUND(z * mechanics.data.axis_steps_per_mm.z);
+    }
+
+    const int32_t todo = target - mesh_z_steps;
+    if (!todo) return;
+
+    const bool up = todo > 0;
+    const uint8_t steps = MIN(ABS(todo), MESH_STEPPER_CORRECTION_STEPS);
+    for (uint8_t s = 0; s < steps; s++) stepper.mesh_z_step(up);
+    mesh_z_steps += up ? steps : -steps;
+  }
+
+#endif // MESH_STEPPER_CORRECTION
+
 #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
 
   void Bedlevel::set_z_fade_height(const float zfh, const bool do_report/*=true*/) {
@@ -231,9 +305,40 @@ void Bedlevel::reset() {
         abl.z_values[x][y] = NAN;
   #elif ABL_PLANAR
     matrix.set_to_identity();
+    refresh_plane();
   #endif
 }
 
+#if ABL_PLANAR
+
+  /**
+   * For a small tilt of the bed the rotation is, at the first order,
+   *   z += a * x + b * y,  x += c * z,  y += d * z
+   * the cosines on the diagonal differ from 1 far below a step.
+   * When the rotation differs from this form by less than PLANE_TOLERANCE
+   * anywhere in the machine, the form is applied, a multiply-add for each
+   * axis in place of the matrix, else the matrix.
+   */
+  void Bedlevel::refresh_plane() {
+    constexpr float PLANE_TOLERANCE = 0.001f;   // mm
+    const xy_pos_t fulcrum = level_fulcrum();
+    const float rx = MAX(ABS(X_MIN_POS - fulcrum.x), ABS(X_MAX_POS - fulcrum.x)),
+                ry = MAX(ABS(Y_MIN_POS - fulcrum.y), ABS(Y_MAX_POS - fulcrum.y)),
+                rz = MAX(ABS(Z_MIN_POS), ABS(Z_MAX_POS));
+    const abc_float_t (&m)[3] = matrix.vectors;
+    const float ex = ABS(m[0][0] - 1.0f) * rx + ABS(m[1][0]) * ry,
+                ey = ABS(m[0][1]) * rx + ABS(m[1][1] - 1.0f) * ry,
+                ez = ABS(m[2][2] - 1.0f) * rz;
+    plane_a = m[0][2];
+    plane_b = m[1][2];
+    plane_c = m[2][0];
+    plane_d = m[2][1];
+    plane_k = 1.0f / (1.0f - plane_a * plane_c - plane_b * plane_d);
+    plane_linear = MAX(ex, ey, ez) < PLANE_TOLERANCE;
+  }
+
+#endif
+
 #if ENABLED(AUTO_BED_LEVELING_BILINEAR) || ENABLED(MESH_BED_LEVELING)
 
   /**
@@ -42,7 +42,30 @@
 
 #if HAS_MESH
 
-  typedef float bed_mesh_t[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+  #if ENABLED(MESH_INT16_STORAGE)
+
+    /**
+     * Mesh point stored as int16 micrometres, INT16_MIN marks an unprobed (NAN) point.
+     * Reads convert to float, so the mesh code works the same as with a float mesh.
+     */
+    struct mesh_z_t {
+      int16_t um;
+      FORCE_INLINE operator float() const { return um == INT16_MIN ? NAN : um * 0.001f; }
+      FORCE_INLINE mesh_z_t& operator=(const float &z) {
+        um = isnan(z) ? INT16_MIN : (int16_t)LROUND(constrain(z, -32.767f, 32.767f) * 1000.0f);
+        return *this;
+      }
+      FORCE_INLINE mesh_z_t& operator+=(const float &z) { return *this = float(*this) + z; }
+      FORCE_INLINE mesh_z_t& operator-=(const float &z) { return *this = float(*this) - z; }
+    };
+
+  #else
+
+    typedef float mesh_z_t;
+
+  #endif
+
+  typedef mesh_z_t bed_mesh_t[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 
   #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
     #include "abl/abl.h"
@@ -111,10 +134,21 @@ class Bedlevel {
       static float z_fade_height, inverse_z_fade_height;
     #endif
 
+    #if ENABLED(MESH_STEPPER_CORRECTION)
+      static volatile int32_t mesh_z_steps; // Z steps of the mesh done by the stepper, not in count_position
+    #endif
+
   private: /** Private Parameters */
 
     #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
-      static float last_fade_z;
+      static float last_fade_z, z_fade_factor;
+    #endif
+
+    #if ABL_PLANAR
+      static bool   plane_linear;       // The matrix is applied at the first order, see refresh_plane
+      static float  plane_a, plane_b,   // Z on X and Y
+                    plane_c, plane_d,   // X and Y on Z
+                    plane_k;            // Inverse of the determinant, for unapply
     #endif
 
   public: /** Public Function */
@@ -133,34 +167,45 @@ class Bedlevel {
       flag.leveling_active = false;
     }
 
+    #if ABL_PLANAR
+      // Call on each change of the matrix
+      static void refresh_plane();
+      FORCE_INLINE static void set_matrix(const matrix_3x3 &m) { matrix = m; refresh_plane(); }
+    #endif
+
     static bool leveling_is_valid();
     static void set_bed_leveling_enabled(const bool enable=true);
     static void reset();
 
     FORCE_INLINE static void restore_bed_leveling_state() { set_bed_leveling_enabled(flag.leveling_previous); }
 
+    #if ENABLED(MESH_STEPPER_CORRECTION)
+      /**
+       * Called by the HAL Tick: step Z towards the mesh under the nozzle,
+       * or back to the plane with the leveling off.
+       */
+      static void mesh_correction_tick();
+    #endif
+
     #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
 
       static void set_z_fade_height(const float zfh, const bool do_report=true);
 
       /**
        * Get the Z leveling fade factor based on the given Z height,
-       * re-calculating only when needed.
+       * re-calculating only when Z changes, so once per layer.
+       * inverse_z_fade_height is 0.0 with no fade height, so the
+       * same expression gives 1.0 there and needs no extra test.
        *
-       *  Returns 1.0 if planner.z_fade_height is 0.0.
+       *  Returns 1.0 if z_fade_height is 0.0.
        *  Returns 0.0 if Z is past the specified 'Fade Height'.
        */
-      static inline float fade_scaling_factor_for_z(const float &rz) {
-        static float z_fade_factor = 1.0;
-        if (z_fade_height) {
-          if (rz >= z_fade_height) return 0.0;
-          if (last_fade_z != rz) {
-            last_fade_z = rz;
-            z_fade_factor = 1.0 - rz * inverse_z_fade_height;
-          }
-          return z_fade_factor;
+      FORCE_INLINE static float fade_scaling_factor_for_z(const float &rz) {
+        if (last_fade_z != rz) {
+          last_fade_z = rz;
+          z_fade_factor = MAX(1.0f - rz * inverse_z_fade_height, 0.0f);
         }
-        return 1.0;
+        return z_fade_factor;
       }
 
       FORCE_INLINE static void force_fade_recalc() { last_fade_z = -999.999; }
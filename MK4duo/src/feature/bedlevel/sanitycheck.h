@@ -85,6 +85,18 @@ static_assert(1 >= 0
 /**
  * ENABLE_LEVELING_FADE_HEIGHT requirements
  */
+#if ENABLED(MESH_STEPPER_CORRECTION)
+  #if NOMECH(CARTESIAN)
+    #error "DEPENDENCY ERROR: MESH_STEPPER_CORRECTION supports only CARTESIAN printers."
+  #elif DISABLED(MESH_BED_LEVELING) && (DISABLED(AUTO_BED_LEVELING_BILINEAR) || DISABLED(ABL_BILINEAR_COEFFICIENTS))
+    #error "DEPENDENCY ERROR: MESH_STEPPER_CORRECTION requires MESH_BED_LEVELING or AUTO_BED_LEVELING_BILINEAR with ABL_BILINEAR_COEFFICIENTS."
+  #elif DISABLED(CPU_32_BIT)
+    #error "DEPENDENCY ERROR: MESH_STEPPER_CORRECTION requires a 32 bit board."
+  #elif !WITHIN(MESH_STEPPER_CORRECTION_STEPS, 1, 64)
+    #error "DEPENDENCY ERROR: MESH_STEPPER_CORRECTION_STEPS must be between 1 and 64."
+  #endif
+#endif
+
 #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT) && !HAS_LEVELING
   #error "DEPENDENCY ERROR: ENABLE_LEVELING_FADE_HEIGHT requires Bed Level."
 #endif
@@ -96,3 +108,33 @@ static_assert(1 >= 0
 #if ENABLED(MESH_EDIT_GFX_OVERLAY) && (DISABLED(AUTO_BED_LEVELING_UBL) || DISABLED(DOGLCD))
   #error "DEPENDENCY ERROR: MESH_EDIT_GFX_OVERLAY requires AUTO_BED_LEVELING_UBL and a Graphical LCD."
 #endif
+
+#if ENABLED(MESH_INT16_STORAGE) && DISABLED(AUTO_BED_LEVELING_BILINEAR) && DISABLED(AUTO_BED_LEVELING_UBL)
+  #error "DEPENDENCY ERROR: MESH_INT16_STORAGE requires AUTO_BED_LEVELING_BILINEAR or AUTO_BED_LEVELING_UBL."
+#endif
+
+#if ENABLED(ABL_PRINT_AREA)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "DEPENDENCY ERROR: ABL_PRINT_AREA requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(PROBE_MANUALLY)
+    #error "DEPENDENCY ERROR: ABL_PRINT_AREA is not compatible with PROBE_MANUALLY."
+  #elif !HAS_SD_SUPPORT
+    #error "DEPENDENCY ERROR: ABL_PRINT_AREA requires SDSUPPORT."
+  #elif !defined(ABL_PRINT_AREA_SCAN)
+    #error "DEPENDENCY ERROR: ABL_PRINT_AREA requires ABL_PRINT_AREA_SCAN."
+  #endif
+#endif
+
+#if ENABLED(UBL_MESH_CACHE)
+  #if DISABLED(AUTO_BED_LEVELING_UBL)
+    #error "DEPENDENCY ERROR: UBL_MESH_CACHE requires AUTO_BED_LEVELING_UBL."
+  #elif !HAS_BED_PROBE || ENABLED(PROBE_MANUALLY)
+    #error "DEPENDENCY ERROR: UBL_MESH_CACHE requires a probe."
+  #elif !HAS_EEPROM
+    #error "DEPENDENCY ERROR: UBL_MESH_CACHE requires EEPROM support."
+  #elif !defined(UBL_MESH_CACHE_SLOTS) || !defined(UBL_MESH_CACHE_TEMP_DIFF) || !defined(UBL_MESH_CACHE_TOLERANCE) || !defined(UBL_MESH_CACHE_MAX_USES)
+    #error "DEPENDENCY ERROR: UBL_MESH_CACHE requires UBL_MESH_CACHE_SLOTS, UBL_MESH_CACHE_TEMP_DIFF, UBL_MESH_CACHE_TOLERANCE and UBL_MESH_CACHE_MAX_USES."
+  #elif UBL_MESH_CACHE_SLOTS < 1
+    #error "DEPENDENCY ERROR: UBL_MESH_CACHE_SLOTS must be at least 1."
+  #endif
+#endif
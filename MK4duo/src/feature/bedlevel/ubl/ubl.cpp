@@ -36,10 +36,10 @@
     SERIAL_LM(ECHO, "  G29 I99");
     for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
       for (uint8_t y = 0;  y < GRID_MAX_POINTS_Y; y++) {
-        if (!isnan(z_values[x][y])) {
+        if (!isnan(float(z_values[x][y]))) {
           SERIAL_SMV(ECHO, "  M421 I", int(x));
           SERIAL_MV(" J", int(y));
-          SERIAL_MV(" Z", z_values[x][y], 4);
+          SERIAL_MV(" Z", float(z_values[x][y]), 4);
           SERIAL_EOL();
           HAL::delayMilliseconds(75);
         }
@@ -84,6 +84,15 @@ class unified_bed_leveling {
     }
     static void smart_fill_mesh();
 
+    #if ENABLED(UBL_MESH_CACHE)
+      static bool     cache_pending;  // Cache the mesh of G29 P1 O when it is complete
+      static uint32_t cache_plate;
+      static void mesh_cache_tag(mesh_tag_t &tag, const uint32_t plate);
+      static bool mesh_cache_check();
+      static bool mesh_cache_load(const uint32_t plate);
+      static void mesh_cache_store();
+    #endif
+
     #if ENABLED(UBL_DEVEL_DEBUGGING)
       static void g29_what_command();
       static void g29_eeprom_dump();
@@ -314,7 +323,7 @@ class unified_bed_leveling {
     static inline bool mesh_is_valid() {
       for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
         for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
-          if (isnan(z_values[x][y])) return false;
+          if (isnan(float(z_values[x][y]))) return false;
         }
       }
       return true;
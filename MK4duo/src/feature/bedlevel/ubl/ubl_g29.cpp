@@ -52,6 +52,11 @@
     int unified_bed_leveling::g29_grid_size;
   #endif
 
+  #if ENABLED(UBL_MESH_CACHE)
+    bool      unified_bed_leveling::cache_pending = false;
+    uint32_t  unified_bed_leveling::cache_plate   = 0;
+  #endif
+
   /**
    *   G29: Unified Bed Leveling by Roxy
    *
@@ -108,6 +113,10 @@
    *   L #   Load       Load Mesh from the specified location in the EEPROM. Set this location as activated
    *                    for subsequent Load and Store operations.
    *
+   *   O #   Cache      With P1 and UBL_MESH_CACHE, reuse the cached mesh probed with the same bed temperature,
+   *                    probe Z offset and plate ID (the # value, 0 if omitted) if a 3-point check agrees with it.
+   *                    Otherwise probe, and the mesh goes in the cache once it is complete (after P3 if needed).
+   *
    *   The P or Phase commands are used for the bulk of the work to setup a Mesh. In general, your Mesh will
    *   start off being initialized with a G29 P0 or a G29 P1. Further refinement of the Mesh happens with
    *   each additional Phase that processes it.
@@ -398,12 +407,27 @@
           // Zero Mesh Data
           //
           reset();
+          #if ENABLED(UBL_MESH_CACHE)
+            cache_pending = false;
+          #endif
           SERIAL_EM("Mesh zeroed.");
           break;
 
         #if HAS_BED_PROBE
 
           case 1: {
+            #if ENABLED(UBL_MESH_CACHE)
+              // A cached mesh of the same conditions skips the probing
+              cache_pending = parser.seen('O');
+              if (cache_pending) {
+                cache_plate = parser.has_value() ? parser.value_ulong() : 0;
+                if (mesh_cache_load(cache_plate)) {
+                  cache_pending = false;
+                  probe_deployed = true;
+                  break;
+                }
+              }
+            #endif
             //
             // Invalidate Entire Mesh and Automatically Probe Mesh in areas that can be reached by the probe
             //
@@ -502,7 +526,7 @@
                   // user meant to populate ALL INVALID mesh points to value
                   for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
                     for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
-                      if (isnan(z_values[x][y])) z_values[x][y] = g29_constant;
+                      if (isnan(float(z_values[x][y]))) z_values[x][y] = g29_constant;
                   break; // No more invalid Mesh Points to populate
                 }
                 else
@@ -593,6 +617,9 @@
 
       eeprom.load_mesh(g29_storage_slot);
       storage_slot = g29_storage_slot;
+      #if ENABLED(UBL_MESH_CACHE)
+        cache_pending = false;
+      #endif
 
       SERIAL_EM("Done.");
     }
@@ -629,6 +656,13 @@
     if (parser.seen('T'))
       display_map(g29_map_type);
 
+    #if ENABLED(UBL_MESH_CACHE)
+      if (cache_pending && mesh_is_valid()) {
+        cache_pending = false;
+        mesh_cache_store();
+      }
+    #endif
+
   LEAVE:
 
     #if HAS_LCD_MENU && !HAS_NEXTION_LCD
@@ -659,7 +693,7 @@
     int n = 0;
     for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
       for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
-        if (!isnan(z_values[x][y])) {
+        if (!isnan(float(z_values[x][y]))) {
           sum += z_values[x][y];
           n++;
         }
@@ -672,7 +706,7 @@
     float sum_of_diff_squared = 0;
     for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
       for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
-        if (!isnan(z_values[x][y]))
+        if (!isnan(float(z_values[x][y])))
           sum_of_diff_squared += sq(z_values[x][y] - mean);
 
     SERIAL_EMV("# of samples: ", n);
@@ -684,14 +718,14 @@
     if (cflag)
       for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
         for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
-          if (!isnan(z_values[x][y]))
+          if (!isnan(float(z_values[x][y])))
             z_values[x][y] -= mean + value;
   }
 
   void unified_bed_leveling::shift_mesh_height() {
     for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
       for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
-        if (!isnan(z_values[x][y]))
+        if (!isnan(float(z_values[x][y])))
           z_values[x][y] += g29_constant;
   }
 
@@ -760,6 +794,123 @@
       );
     }
 
+    #if ENABLED(UBL_MESH_CACHE)
+
+      /**
+       * The cache is in the last UBL_MESH_CACHE_SLOTS mesh slots,
+       * each one tagged with the conditions it was probed in.
+       */
+      void unified_bed_leveling::mesh_cache_tag(mesh_tag_t &tag, const uint32_t plate) {
+        tag.tagged    = true;
+        tag.bed_temp  =
+          #if HAS_BEDS
+            beds[0]->deg_target()
+          #else
+            0
+          #endif
+        ;
+        tag.z_offset  = probe.data.offset.z;
+        tag.plate_id  = plate;
+        tag.uses      = 0;
+      }
+
+      // Probe 3 points, the mesh is still good if it agrees with all of them
+      bool unified_bed_leveling::mesh_cache_check() {
+        const float x_min = probe.min_x(), x_max = probe.max_x(),
+                    y_min = probe.min_y(), y_max = probe.max_y();
+        const xy_pos_t points[3] = { { x_min, y_min }, { x_max, y_min }, { (x_min + x_max) * 0.5f, y_max } };
+
+        save_ubl_active_state_and_disable();
+
+        bool good = true;
+        LOOP_L_N(i, 3) {
+          const float measured_z = probe.check_at_point(points[i], i < 2 ? PROBE_PT_RAISE : PROBE_PT_STOW, g29_verbose_level);
+          if (isnan(measured_z)) { good = false; break; }
+          const float error = measured_z - get_z_correction(points[i]);
+          SERIAL_MV("Check point ", int(i + 1));
+          SERIAL_EMV(" error ", error, 3);
+          if (ABS(error) > (UBL_MESH_CACHE_TOLERANCE)) { good = false; break; }
+        }
+
+        STOW_PROBE();
+        restore_ubl_active_state_and_leave();
+        return good;
+      }
+
+      bool unified_bed_leveling::mesh_cache_load(const uint32_t plate) {
+        const int16_t a = eeprom.calc_num_meshes();
+        if (a <= UBL_MESH_CACHE_SLOTS) return false;
+
+        mesh_tag_t now;
+        mesh_cache_tag(now, plate);
+
+        for (int8_t s = a - (UBL_MESH_CACHE_SLOTS); s < a; s++) {
+          mesh_tag_t tag;
+          if (!eeprom.read_mesh_tag(s, tag)
+            || tag.plate_id != now.plate_id
+            || ABS(tag.bed_temp - now.bed_temp) > UBL_MESH_CACHE_TEMP_DIFF
+            || ABS(tag.z_offset - now.z_offset) > 0.001f
+            || tag.uses >= UBL_MESH_CACHE_MAX_USES
+          ) continue;
+
+          uint16_t crc = 0;
+          eeprom.load_mesh(s, nullptr, &crc);
+          if (crc != tag.crc || !mesh_is_valid()) {
+            invalidate();
+            continue;
+          }
+
+          SERIAL_EMV("Cached mesh in slot ", int(s));
+          if (!mesh_cache_check()) {
+            // The bed is not the one of the cache
+            invalidate();
+            SERIAL_EM("Cached mesh rejected.");
+            return false;
+          }
+
+          tag.uses++;
+          eeprom.write_mesh_tag(s, tag);
+          SERIAL_EM("Cached mesh used, no probing.");
+          return true;
+        }
+        return false;
+      }
+
+      // Same conditions, else a free slot, else the oldest store
+      void unified_bed_leveling::mesh_cache_store() {
+        const int16_t a = eeprom.calc_num_meshes();
+        if (a <= UBL_MESH_CACHE_SLOTS) {
+          SERIAL_EM("?Not enough EEPROM for the mesh cache.");
+          return;
+        }
+
+        mesh_tag_t now;
+        mesh_cache_tag(now, cache_plate);
+
+        int8_t same = -1, empty = -1, oldest = a - (UBL_MESH_CACHE_SLOTS);
+        uint16_t stamp_max = 0, stamp_min = 0xFFFF;
+        for (int8_t s = a - (UBL_MESH_CACHE_SLOTS); s < a; s++) {
+          mesh_tag_t tag;
+          if (!eeprom.read_mesh_tag(s, tag)) {
+            if (empty < 0) empty = s;
+            continue;
+          }
+          if (same < 0 && tag.plate_id == now.plate_id
+            && ABS(tag.bed_temp - now.bed_temp) <= UBL_MESH_CACHE_TEMP_DIFF
+            && ABS(tag.z_offset - now.z_offset) <= 0.001f
+          ) same = s;
+          NOLESS(stamp_max, tag.stamp);
+          if (tag.stamp < stamp_min) { stamp_min = tag.stamp; oldest = s; }
+        }
+
+        const int8_t slot = same >= 0 ? same : empty >= 0 ? empty : oldest;
+        now.stamp = stamp_max + 1;
+        eeprom.store_mesh(slot, &now);
+        SERIAL_EMV("Mesh cached in slot ", int(slot));
+      }
+
+    #endif // UBL_MESH_CACHE
+
   #endif // HAS_BED_PROBE
 
   #if HAS_LCD_MENU && !HAS_NEXTION_LCD
@@ -894,7 +1045,7 @@
         z_values[lpos.x][lpos.y] = mechanics.position.z - thick;
         if (g29_verbose_level > 2) {
           SERIAL_MSG("Mesh Point Measured at: ");
-          SERIAL_VAL(z_values[lpos.x][lpos.y], 6);
+          SERIAL_VAL(float(z_values[lpos.x][lpos.y]), 6);
           SERIAL_EOL();
         }
         Com::serialFlush(); // Prevent host M105 buffer overrun.
@@ -1179,7 +1330,7 @@
     for (int8_t i = 0; i < GRID_MAX_POINTS_X; i++) {
       for (int8_t j = 0; j < GRID_MAX_POINTS_Y; j++) {
 
-        if (isnan(z_values[i][j])) { // Check to see if this location holds an invalid mesh point
+        if (isnan(float(z_values[i][j]))) { // Check to see if this location holds an invalid mesh point
 
           if (!mechanics.position_is_reachable_by_probe(mesh_index_to_xpos(i), mesh_index_to_ypos(j)))
             continue;
@@ -1190,7 +1341,7 @@
           float d1, d2 = 99999.9f;
           for (int8_t k = 0; k < GRID_MAX_POINTS_X; k++) {
             for (int8_t l = 0; l < GRID_MAX_POINTS_Y; l++) {
-              if (!isnan(z_values[k][l])) {
+              if (!isnan(float(z_values[k][l]))) {
                 found_a_real = true;
 
                 // Add in a random weighting factor that scrambles the probing of the
@@ -1239,7 +1390,7 @@
     for (int8_t i = 0; i < GRID_MAX_POINTS_X; i++) {
       for (int8_t j = 0; j < GRID_MAX_POINTS_Y; j++) {
 
-        if ( (type == (isnan(z_values[i][j]) ? INVALID : REAL))
+        if ( (type == (isnan(float(z_values[i][j])) ? INVALID : REAL))
           || (type == SET_IN_BITMAP && !done_flags->marked(i, j))
         ) {
           // Found a Mesh Point of the specified type!
@@ -1572,7 +1723,7 @@
 
       for (uint8_t jx = 0; jx < GRID_MAX_POINTS_X; jx++)
         for (uint8_t jy = 0; jy < GRID_MAX_POINTS_Y; jy++)
-          if (!isnan(z_values[jx][jy]))
+          if (!isnan(float(z_values[jx][jy])))
             SBI(bitmap[jx], jy);
 
       xy_pos_t ppos;
@@ -1580,7 +1731,7 @@
         ppos.x = mesh_index_to_xpos(ix);
         for (uint8_t iy = 0; iy < GRID_MAX_POINTS_Y; iy++) {
           ppos.y = mesh_index_to_ypos(iy);
-          if (isnan(z_values[ix][iy])) {
+          if (isnan(float(z_values[ix][iy]))) {
             // undefined mesh point at (ppos.x,ppos.y), compute weighted LSF from original valid mesh points.
             incremental_LSF_reset(&lsf_results);
             xy_pos_t rpos;
@@ -1743,7 +1894,7 @@
 
       g29_storage_slot = parser.value_int();
 
-      float tmp_z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+      bed_mesh_t tmp_z_values;
       eeprom.load_mesh(g29_storage_slot, &tmp_z_values);
 
       SERIAL_MV("Subtracting mesh in slot ", g29_storage_slot);
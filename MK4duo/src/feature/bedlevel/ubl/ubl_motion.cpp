@@ -360,21 +360,25 @@
     // Move to first segment destination
     raw += diff;
 
+    // Mesh cell of the first segment and the position in it. The next cells are
+    // found by stepping from this one, with no index math or lookup per cell.
+    // Note for cell index, if point is outside the mesh grid (in MIN_PROBE_EDGE perimeter)
+    // the bilinear interpolation from the adjacent cell within the mesh will still work.
+    // Inner loop will exit each time (because out of cell bounds) but will come back
+    // in top of loop and stay on the same adjacent cell, just less efficient
+    // for mesh inset area.
+    xy_int8_t icell = {
+      int8_t((raw.x - (MESH_MIN_X)) * RECIPROCAL(MESH_X_DIST)),
+      int8_t((raw.y - (MESH_MIN_Y)) * RECIPROCAL(MESH_Y_DIST))
+    };
+    LIMIT(icell.x, 0, (GRID_MAX_POINTS_X) - 2);
+    LIMIT(icell.y, 0, (GRID_MAX_POINTS_Y) - 2);
+
+    xy_pos_t cell = { raw.x - mesh_index_to_xpos(icell.x), raw.y - mesh_index_to_ypos(icell.y) };
+
     for (;;) {  // for each mesh cell encountered during the move
 
       // Compute mesh cell invariants that remain constant for all segments within cell.
-      // Note for cell index, if point is outside the mesh grid (in MIN_PROBE_EDGE perimeter)
-      // the bilinear interpolation from the adjacent cell within the mesh will still work.
-      // Inner loop will exit each time (because out of cell bounds) but will come back
-      // in top of loop and again re-find same adjacent cell and use it, just less efficient
-      // for mesh inset area.
-
-      xy_int8_t icell = {
-        int8_t((raw.x - (MESH_MIN_X)) * RECIPROCAL(MESH_X_DIST)),
-        int8_t((raw.y - (MESH_MIN_Y)) * RECIPROCAL(MESH_Y_DIST))
-      };
-      LIMIT(icell.x, 0, (GRID_MAX_POINTS_X) - 1);
-      LIMIT(icell.y, 0, (GRID_MAX_POINTS_Y) - 1);
 
       float z_x0y0 = z_values[icell.x  ][icell.y  ],  // z at lower left corner
             z_x1y0 = z_values[icell.x+1][icell.y  ],  // z at upper left corner
@@ -386,9 +390,6 @@
       if (isnan(z_x0y1)) z_x0y1 = 0;              //   in order to avoid isnan tests per cell,
       if (isnan(z_x1y1)) z_x1y1 = 0;              //   thus guessing zero for undefined points
 
-      const xy_pos_t pos = { mesh_index_to_xpos(icell.x), mesh_index_to_ypos(icell.y) };
-      xy_pos_t cell = raw - pos;
-
       const float z_xmy0 = (z_x1y0 - z_x0y0) * RECIPROCAL(MESH_X_DIST),   // z slope per x along y0 (lower left to lower right)
                   z_xmy1 = (z_x1y1 - z_x0y1) * RECIPROCAL(MESH_X_DIST);   // z slope per x along y1 (upper left to upper right)
 
@@ -436,6 +437,13 @@
         z_cxym += z_sxym;   // adjust z_cxym by per-segment z_sxym
 
       } // segment loop
+
+      // Step to the cell the move entered, a long segment may cross more than one
+      while (cell.x > MESH_X_DIST && icell.x < (GRID_MAX_POINTS_X) - 2) { icell.x++; cell.x -= MESH_X_DIST; }
+      while (cell.x < 0           && icell.x > 0)                       { icell.x--; cell.x += MESH_X_DIST; }
+      while (cell.y > MESH_Y_DIST && icell.y < (GRID_MAX_POINTS_Y) - 2) { icell.y++; cell.y -= MESH_Y_DIST; }
+      while (cell.y < 0           && icell.y > 0)                       { icell.y--; cell.y += MESH_Y_DIST; }
+
     } // cell loop
 
     return false; // caller will update position
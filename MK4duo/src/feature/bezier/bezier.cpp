@@ -36,44 +36,30 @@
   #define MAX_STEP 0.1
   #define SIGMA 0.1
 
+  // Longest chord for kinematic machines, each one is a linear move of the towers or arms
+  #define MAX_KINEMATIC_MM 2.0
+
   /**
-   * The algorithm for computing the step is loosely based on the one in Kig
-   * (See https://sources.debian.net/src/kig/4:15.08.3-1/misc/kigpainter.cpp/#L759)
-   * However, we do not use the stack.
+   * The curve is walked by forward differencing: with the step h in t, the
+   * first, second and third differences d1, d2, d3 of the cubic go to the next
+   * point with three additions per axis, and no full evaluation of the curve.
    *
-   * The algorithm goes as it follows: the parameters t runs from 0.0 to
-   * 1.0 describing the curve, which is evaluated by eval_bezier(). At
-   * each iteration we have to choose a step, i.e., the increment of the
-   * t variable. By default the step of the previous iteration is taken,
-   * and then it is enlarged or reduced depending on how straight the
-   * curve locally is. The step is always clamped between MIN_STEP/2 and
-   * 2*MAX_STEP. MAX_STEP is taken at the first iteration.
+   * The step is adapted as in Kig
+   * (See https://sources.debian.net/src/kig/4:15.08.3-1/misc/kigpainter.cpp/#L759),
+   * but the test is exact for a cubic and costs no evaluation: the midpoint of the
+   * interval [t, t+h] is off the chord by d2/8 - d3/16. While that is over SIGMA the
+   * step is halved, and if it was not halved it is doubled while the doubled step,
+   * off by d2/2, stays within SIGMA. The differences are rescaled in place:
    *
-   * For some t, the step value is considered acceptable if the curve in
-   * the interval [t, t+step] is sufficiently straight, i.e.,
-   * sufficiently close to linear interpolation. In practice the
-   * following test is performed: the distance between eval_bezier(...,
-   * t+step/2) is evaluated and compared with 0.5*(eval_bezier(...,
-   * t)+eval_bezier(..., t+step)). If it is smaller than SIGMA, then the
-   * step value is considered acceptable, otherwise it is not. The code
-   * seeks to find the larger step value which is considered acceptable.
+   *   halving:  d1 = d1/2 - d2/8 + d3/16,  d2 = d2/4 - d3/8,  d3 = d3/8
+   *   doubling: d1 = 2 d1 + d2,            d2 = 4 (d2 + d3),  d3 = 8 d3
    *
-   * At every iteration the recorded step value is considered and then
-   * iteratively halved until it becomes acceptable. If it was already
-   * acceptable in the beginning (i.e., no halving were done), then
-   * maybe it was necessary to enlarge it; then it is iteratively
-   * doubled while it remains acceptable. The last acceptable value
-   * found is taken, provided that it is between MIN_STEP and MAX_STEP
-   * and does not bring t over 1.0.
+   * The step stays between MIN_STEP/2 and 2*MAX_STEP, and the last point is
+   * the target itself, so the rounding of the additions does not pile up at
+   * the end. Distances are taken in "norm 1", the sum of the offsets, that is quicker.
    *
-   * Caveat: this algorithm is not perfect, since it can happen that a
-   * step is considered acceptable even when the curve is not linear at
-   * all in the interval [t, t+step] (but its mid point coincides "by
-   * chance" with the midpoint according to the parametrization). This
-   * kind of glitches can be eliminated with proper first derivative
-   * estimates; however, given the improbability of such configurations,
-   * the mitigation offered by MIN_STEP and the small computational
-   * power available on Arduino, I think it is not wise to implement it.
+   * On kinematic machines the chord is also kept within MAX_KINEMATIC_MM, and
+   * every point goes to buffer_line(), that transforms it, with no more segmentation.
    */
   void Bezier::cubic_b_spline(const xyze_pos_t position, const xyze_pos_t target, const float offset[4], feedrate_t fr_mm_s, uint8_t extruder) {
 
@@ -82,75 +68,83 @@
                 first1 = position.y + offset[1],
                 second0 = target.x + offset[2],
                 second1 = target.y + offset[3];
-    float t = 0.0;
 
-    xyze_pos_t bez_target;
-    bez_target.x = position.x;
-    bez_target.y = position.y;
+    // Polynomial coefficients, B(t) = ((a * t + b) * t + c) * t + position
+    const xy_float_t  c = { 3.0f * (first0 - position.x), 3.0f * (first1 - position.y) },
+                      b = { 3.0f * (position.x - 2.0f * first0 + second0), 3.0f * (position.y - 2.0f * first1 + second1) },
+                      a = { target.x - position.x - 3.0f * (second0 - first0), target.y - position.y - 3.0f * (second1 - first1) };
+
+    // Forward differences for the first step
     float step = MAX_STEP;
+    const float step2 = sq(step), step3 = step2 * step;
+    xy_float_t  d1 = (a * step + b) * step2 + c * step,
+                d2 = a * (6.0f * step3) + b * (2.0f * step2),
+                d3 = a * (6.0f * step3);
+
+    xyze_pos_t bez_target = position;
+    float t = 0.0;
 
     short_timer_t next_idle_timer(millis());
 
-    while (t < 1.0) {
+    for (;;) {
 
       if (next_idle_timer.expired(200)) printer.idle();
 
       // First try to reduce the step in order to make it sufficiently
       // close to a linear interpolation.
       bool did_reduce = false;
-      float new_t = t + step;
-      NOMORE(new_t, 1.0);
-      float new_pos0 = eval_bezier(position.x, first0, second0, target.x, new_t);
-      float new_pos1 = eval_bezier(position.y, first1, second1, target.y, new_t);
-      for (;;) {
-        if (new_t - t < (MIN_STEP)) break;
-        const float candidate_t = 0.5 * (t + new_t),
-                    candidate_pos0 = eval_bezier(position.x, first0, second0, target.x, candidate_t),
-                    candidate_pos1 = eval_bezier(position.y, first1, second1, target.y, candidate_t),
-                    interp_pos0 = 0.5 * (bez_target.x + new_pos0),
-                    interp_pos1 = 0.5 * (bez_target.y + new_pos1);
-        if (dist1(candidate_pos0, candidate_pos1, interp_pos0, interp_pos1) <= (SIGMA)) break;
-        new_t = candidate_t;
-        new_pos0 = candidate_pos0;
-        new_pos1 = candidate_pos1;
+      while (step >= (MIN_STEP) && (
+        ABS(d2.x * 0.125f - d3.x * 0.0625f) + ABS(d2.y * 0.125f - d3.y * 0.0625f) > (SIGMA)
+        #if IS_KINEMATIC
+          || ABS(d1.x) + ABS(d1.y) > (MAX_KINEMATIC_MM)
+        #endif
+      )) {
+        d1 = d1 * 0.5f - d2 * 0.125f + d3 * 0.0625f;
+        d2 = d2 * 0.25f - d3 * 0.125f;
+        d3 *= 0.125f;
+        step *= 0.5f;
         did_reduce = true;
       }
 
       // If we did not reduce the step, maybe we should enlarge it.
-      if (!did_reduce) for (;;) {
-        if (new_t - t > MAX_STEP) break;
-        const float candidate_t = t + 2.0 * (new_t - t);
-        if (candidate_t >= 1.0) break;
-        const float candidate_pos0 = eval_bezier(position.x, first0, second0, target.x, candidate_t),
-                    candidate_pos1 = eval_bezier(position.y, first1, second1, target.y, candidate_t),
-                    interp_pos0 = 0.5 * (bez_target.x + candidate_pos0),
-                    interp_pos1 = 0.5 * (bez_target.y + candidate_pos1);
-        if (dist1(new_pos0, new_pos1, interp_pos0, interp_pos1) > (SIGMA)) break;
-        new_t = candidate_t;
-        new_pos0 = candidate_pos0;
-        new_pos1 = candidate_pos1;
+      if (!did_reduce) while (step <= (MAX_STEP) && t + 2.0f * step < 1.0f
+        && (ABS(d2.x) + ABS(d2.y)) * 0.5f <= (SIGMA)
+        #if IS_KINEMATIC
+          && ABS(2.0f * d1.x + d2.x) + ABS(2.0f * d1.y + d2.y) <= (MAX_KINEMATIC_MM)
+        #endif
+      ) {
+        d1 = d1 * 2.0f + d2;
+        d2 = (d2 + d3) * 4.0f;
+        d3 *= 8.0f;
+        step *= 2.0f;
       }
 
-      step = new_t - t;
-      t = new_t;
+      t += step;
+      const bool last = t >= 1.0f;
 
       // Compute and send new position
-      bez_target.x = new_pos0;
-      bez_target.y = new_pos1;
-      // FIXME. The following two are wrong, since the parameter t is
-      // not linear in the distance.
-      bez_target.z = interp(position.z, target.z, t);
-      bez_target.e = interp(position.e, target.e, t);
+      if (last)
+        bez_target = target;
+      else {
+        bez_target.x += d1.x;
+        bez_target.y += d1.y;
+        d1 += d2;
+        d2 += d3;
+        // FIXME. The following two are wrong, since the parameter t is
+        // not linear in the distance.
+        bez_target.z = interp(position.z, target.z, t);
+        bez_target.e = interp(position.e, target.e, t);
+      }
       endstops.apply_motion_limits(bez_target);
 
       #if HAS_LEVELING && !PLANNER_LEVELING
-        xyze_pos_t pos = { bez_target.x, bez_target.y, bez_target.z, bez_target.e };
-        planner.apply_leveling(pos);
+        xyze_pos_t pos = bez_target;
+        bedlevel.apply_leveling(pos);
       #else
         const xyze_pos_t &pos = bez_target;
       #endif
 
-      if (!planner.buffer_line(bez_target, fr_mm_s, extruder))
+      if (!planner.buffer_line(pos, fr_mm_s, extruder) || last)
         break;
     }
   }
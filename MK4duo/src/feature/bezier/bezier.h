@@ -52,21 +52,6 @@
       */
       static inline float interp(float a, float b, float t) { return (1.0 - t) * a + t * b; }
 
-      static inline float eval_bezier(float a, float b, float c, float d, float t) {
-        float iab = interp(a, b, t);
-        float ibc = interp(b, c, t);
-        float icd = interp(c, d, t);
-        float iabc = interp(iab, ibc, t);
-        float ibcd = interp(ibc, icd, t);
-        float iabcd = interp(iabc, ibcd, t);
-        return iabcd;
-      }
-
-      /**
-       * We approximate Euclidean distance with the sum of the coordinates
-       * offset (so-called "norm 1"), which is quicker to compute.
-       */
-      static inline float dist1(float x1, float y1, float x2, float y2) { return ABS(x1 - x2) + ABS(y1 - y2); }
   };
 
 #endif // ENABLED(G5_BEZIER)
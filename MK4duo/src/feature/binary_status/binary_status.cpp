@@ -0,0 +1,112 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * binary_status.cpp - Binary status frames for the monitoring hosts
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(BINARY_STATUS_REPORT)
+
+BinaryStatus binary_status;
+
+/** Private Parameters */
+millis_s      BinaryStatus::interval_ms = 0;
+short_timer_t BinaryStatus::timer;
+int8_t        BinaryStatus::port        = -1;
+
+/** Public Function */
+void BinaryStatus::set_interval(const millis_s ms) {
+  interval_ms = ms ? MAX(ms, millis_s(BINARY_STATUS_MIN_INTERVAL)) : 0;
+  port = Com::serial_port_index;
+  timer.start();
+}
+
+void BinaryStatus::send() {
+
+  uint8_t frame[BINARY_STATUS_MAX_SIZE], *p = &frame[2];
+
+  #define PUT(V) do{ const auto v = V; memcpy(p, &v, sizeof(v)); p += sizeof(v); }while(0)
+
+  PUT(uint8_t(BINARY_STATUS_VERSION));
+  PUT(uint32_t(millis()));
+
+  uint8_t state = 0;
+  #if HAS_SD_SUPPORT
+    if (card.isPrinting()) SBI(state, 0);
+    if (card.isPaused())   SBI(state, 1);
+  #endif
+  if (planner.has_blocks_queued()) SBI(state, 2);
+  #if ENABLED(REALTIME_COMMANDS)
+    if (emergency_parser.feed_hold) SBI(state, 3);
+  #endif
+  PUT(state);
+
+  PUT(uint8_t(planner.moves_planned()));
+  PUT(uint8_t(commands.buffer_ring.count()));
+
+  #if HAS_SD_SUPPORT
+    PUT(uint8_t(card.percentDone()));
+    PUT(uint32_t(card.getIndex()));
+  #else
+    PUT(uint8_t(0));
+    PUT(uint32_t(0));
+  #endif
+
+  xyze_pos_t lpos;
+  mechanics.get_realtime_position(lpos);
+  LOOP_XYZE(i) PUT(float(lpos[i]));
+
+  PUT(uint8_t(tempManager.heater_count()));
+  LOOP_L_N(h, tempManager.heater_count()) {
+    Heater * const act = tempManager.heater_at(h);
+    PUT(uint8_t(act->type));
+    PUT(int16_t(act->current_temperature * 10.0f));
+    PUT(int16_t(act->target_temperature));
+    PUT(uint8_t(act->pwm_value));
+  }
+
+  #if HAS_FAN
+    PUT(uint8_t(fanManager.data.fans));
+    LOOP_FAN() PUT(uint8_t(fans[f]->actual_speed()));
+  #else
+    PUT(uint8_t(0));
+  #endif
+
+  #undef PUT
+
+  frame[0] = BINARY_STATUS_SYNC;
+  frame[1] = uint8_t(p - &frame[2]);
+
+  uint16_t crc = 0xFFFF;
+  crc16(&crc, &frame[1], p - &frame[1]);
+  memcpy(p, &crc, sizeof(crc));
+  p += sizeof(crc);
+
+  const int8_t saved_port = Com::serial_port_index;
+  SERIAL_PORT(port);
+  SERIAL_OUT(write, frame, p - frame);
+  SERIAL_PORT(saved_port);
+}
+
+#endif // BINARY_STATUS_REPORT
@@ -0,0 +1,79 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * binary_status.h - Binary status frames for the monitoring hosts
+ *
+ * M155 B<ms> sends the frame every B milliseconds, always at the start of a line,
+ * little endian:
+ *   uint8  0xA6   sync, never the first byte of a text line
+ *   uint8  len    bytes from version to the last fan
+ *   uint8  version
+ *   uint32 millis
+ *   uint8  state  bit 0 SD printing, 1 SD paused, 2 moving, 3 feed hold
+ *   uint8  moves in the planner
+ *   uint8  commands in the buffer
+ *   uint8  SD progress in percent
+ *   uint32 SD position
+ *   float  X Y Z E   logical position from the step counts
+ *   uint8  heaters, then for each heater:
+ *     uint8  type    0 hotend, 1 bed, 2 chamber, 3 cooler
+ *     int16  current temperature in 0.1 C
+ *     int16  target temperature in C
+ *     uint8  PWM
+ *   uint8  fans, then the speed of each fan (uint8)
+ *   uint16 crc    CRC16-CCITT (init 0xFFFF) of len up to the last fan
+ */
+
+#if ENABLED(BINARY_STATUS_REPORT)
+
+#define BINARY_STATUS_SYNC          0xA6
+#define BINARY_STATUS_VERSION       1
+#define BINARY_STATUS_MIN_INTERVAL  20    // ms
+#define BINARY_STATUS_MAX_SIZE      (2 + 31 + (MAX_HOTEND + MAX_BED + MAX_CHAMBER + MAX_COOLER) * 6 + 1 + MAX_FAN + 2)
+
+class BinaryStatus {
+
+  public: /** Constructor */
+
+    BinaryStatus() {}
+
+  private: /** Private Parameters */
+
+    static millis_s       interval_ms;      // 0 for none
+    static short_timer_t  timer;
+    static int8_t         port;             // The port of the M155 B
+
+  public: /** Public Function */
+
+    static void set_interval(const millis_s ms);
+
+    FORCE_INLINE static void spin() { if (timer.expired(interval_ms)) send(); }
+
+    static void send();
+
+};
+
+extern BinaryStatus binary_status;
+
+#endif // BINARY_STATUS_REPORT
@@ -36,6 +36,12 @@ BLTouch bltouch;
 /** Public Parameters */
 bool BLTouch::last_mode = false;
 
+/** Private Parameters */
+#if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+  BLTCommand  BLTouch::pending_cmd  = 0;
+  millis_l    BLTouch::pending_ms   = 0;
+#endif
+
 /** Public Function */
 // Init the class and device. Call from setup().
 void BLTouch::init(const bool set_voltage/*=false*/) {
@@ -153,8 +159,16 @@ bool BLTouch::deploy() {
   // Do a DEPLOY
   if (printer.debugFeature()) DEBUG_EM(">>> bltouch.deploy() start");
 
+  #if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+    if (pending_stow_done()) return true;
+    // A deploy sent with the travel waits only the rest of DEPLOY_DELAY
+    const bool alarm = pending_cmd == BLTOUCH_CMD_DEPLOY ? pending_wait(BLTOUCH_DEPLOY_DELAY) : cmd_deploy_alarm();
+  #else
+    const bool alarm = cmd_deploy_alarm();
+  #endif
+
   // Attempt to DEPLOY, wait for DEPLOY_DELAY or ALARM
-  if (cmd_deploy_alarm()) {
+  if (alarm) {
     // The deploy might have failed or the probe is already triggered (nozzle too low?)
     if (printer.debugFeature()) DEBUG_EM("BLTouch ALARM or TRIGGER after DEPLOY, recovering");
 
@@ -196,8 +210,14 @@ bool BLTouch::stow() {
   // Note: If the probe is deployed AND in an ALARM condition, this STOW will not pull up the pin
   // and the ALARM condition will still be there. --> ANTClabs should change this behaviour maybe
 
+  #if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+    const bool alarm = pending_cmd == BLTOUCH_CMD_STOW ? pending_wait(BLTOUCH_STOW_DELAY) : cmd_stow_alarm();
+  #else
+    const bool alarm = cmd_stow_alarm();
+  #endif
+
   // Attempt to STOW, wait for STOW_DELAY or ALARM
-  if (cmd_stow_alarm()) {
+  if (alarm) {
     // The stow might have failed
     if (printer.debugFeature()) DEBUG_EM("BLTouch ALARM or TRIGGER after STOW, recovering");
 
@@ -222,6 +242,33 @@ bool BLTouch::stow() {
   return false; // report success to caller
 }
 
+#if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+
+  /**
+   * Send the DEPLOY with no wait, the systems move to the point while
+   * the pin comes down. deploy() waits what is left of DEPLOY_DELAY.
+   */
+  void BLTouch::deploy_start() {
+    if (pending_cmd == BLTOUCH_CMD_DEPLOY || pending_stow_done()) return;
+    if (printer.debugFeature()) DEBUG_EM("BLTouch pipelined DEPLOY");
+    MOVE_SERVO(Z_PROBE_SERVO_NR, BLTOUCH_CMD_DEPLOY);
+    pending_cmd = BLTOUCH_CMD_DEPLOY;
+    pending_ms = millis();
+  }
+
+  /**
+   * Send the STOW after a trigger with no wait, the raise runs while the
+   * pin goes up. The alarm is checked by the next deploy or stow.
+   */
+  void BLTouch::stow_start() {
+    if (printer.debugFeature()) DEBUG_EM("BLTouch pipelined STOW");
+    MOVE_SERVO(Z_PROBE_SERVO_NR, BLTOUCH_CMD_STOW);
+    pending_cmd = BLTOUCH_CMD_STOW;
+    pending_ms = millis();
+  }
+
+#endif
+
 /** Private Functions */
 void BLTouch::clear() {
   cmd_reset();  // RESET or RESET_SW will clear an alarm condition but...
@@ -247,11 +294,33 @@ void BLTouch::mode_conv(const bool M5V/*=false*/) {
 
 bool BLTouch::command(const BLTCommand cmd, const millis_s ms/*=BLTOUCH_DELAY*/) {
   if (printer.debugFeature()) DEBUG_EMV("BLTouch Command :", cmd);
+  #if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+    pending_cmd = 0;
+  #endif
   MOVE_SERVO(Z_PROBE_SERVO_NR, cmd);
   HAL::delayMilliseconds(MAX(ms, (uint32_t)BLTOUCH_DELAY));
   return triggered();
 }
 
+#if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+
+  // Wait what is left of the delay of the pending command
+  bool BLTouch::pending_wait(const millis_s ms) {
+    const millis_l  elapsed = millis() - pending_ms,
+                    delay   = MAX(ms, (uint32_t)BLTOUCH_DELAY);
+    if (elapsed < delay) HAL::delayMilliseconds(delay - elapsed);
+    pending_cmd = 0;
+    return triggered();
+  }
+
+  // Close a pending STOW, the full stow() recovers an alarm. Return true on error.
+  bool BLTouch::pending_stow_done() {
+    if (pending_cmd != BLTOUCH_CMD_STOW) return false;
+    return pending_wait(BLTOUCH_STOW_DELAY) && stow();
+  }
+
+#endif
+
 bool BLTouch::triggered() {
   #if HAS_Z_PROBE_PIN
     return HAL::digitalRead(Z_PROBE_PIN) != endstops.isLogic(Z_PROBE);
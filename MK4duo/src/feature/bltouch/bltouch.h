@@ -76,6 +76,11 @@ class BLTouch {
     static bool deploy();
     static bool stow();
 
+    #if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+      static void deploy_start();
+      static void stow_start();
+    #endif
+
     FORCE_INLINE static void cmd_reset()          { (void)command(BLTOUCH_CMD_RESET, BLTOUCH_RESET_DELAY);            }
     FORCE_INLINE static void cmd_selftest()       { (void)command(BLTOUCH_CMD_SELFTEST);                              }
 
@@ -92,6 +97,13 @@ class BLTouch {
     FORCE_INLINE static void mode_conv_5V()       { mode_conv(true); }
     FORCE_INLINE static void mode_conv_OD()       { mode_conv(false); }
 
+  private: /** Private Parameters */
+
+    #if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+      static BLTCommand pending_cmd;  // Command sent with no wait, 0 for none
+      static millis_l   pending_ms;
+    #endif
+
   private: /** Private Function */
 
     static void clear();
@@ -99,6 +111,11 @@ class BLTouch {
     static bool command(const BLTCommand cmd, const millis_s ms=BLTOUCH_DELAY);
     static bool triggered();
 
+    #if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+      static bool pending_wait(const millis_s ms);
+      static bool pending_stow_done();
+    #endif
+
     FORCE_INLINE static bool cmd_deploy_alarm() { return command(BLTOUCH_CMD_DEPLOY,  BLTOUCH_DEPLOY_DELAY);  }
     FORCE_INLINE static bool cmd_stow_alarm()   { return command(BLTOUCH_CMD_STOW,    BLTOUCH_STOW_DELAY);    }
 
@@ -26,3 +26,11 @@
  *
  * Test configuration values for errors at compile-time.
  */
+
+#if ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+  #if DISABLED(BLTOUCH)
+    #error "DEPENDENCY ERROR: BLTOUCH_PIPELINED_DEPLOY requires BLTOUCH."
+  #elif ENABLED(BLTOUCH_HIGH_SPEED_MODE)
+    #error "DEPENDENCY ERROR: BLTOUCH_PIPELINED_DEPLOY is not compatible with BLTOUCH_HIGH_SPEED_MODE (always on for DELTA)."
+  #endif
+#endif
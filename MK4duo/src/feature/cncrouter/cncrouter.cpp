@@ -56,11 +56,24 @@ uint8_t Cncrouter::active_tool = 0;
   uint32_t Cncrouter::rpm_instant = 0;
 #endif
 
+#if ENABLED(CNCROUTER_TACHO)
+  tacho_data_t Cncrouter::tacho;
+  void cnc_tacho_interrupt() { cnc.tacho.interrupt(); }
+#endif
+
+#if ENABLED(CNCROUTER_FEED_OVERRIDE)
+  uint8_t Cncrouter::feed_percentage = 100;
+#endif
+
 void Cncrouter::init() {
   SET_OUTPUT(CNCROUTER_PIN);
   #if ENABLED(FAST_PWM_CNCROUTER) && ENABLED(__AVR__)
     HAL::setPwmFrequency(CNCROUTER_PIN, 2); // No prescaling. Pwm frequency = F_CPU/256/64
   #endif
+  #if ENABLED(CNCROUTER_TACHO)
+    tacho.pin = CNCROUTER_TACHO_PIN;
+    tacho.init(cnc_tacho_interrupt);
+  #endif
 }
 
 void Cncrouter::manage() {
@@ -69,6 +82,21 @@ void Cncrouter::manage() {
     if (rpm_target != rpm_instant && next_speed_step_timer.expired((CNCROUTER_SLOWSTART_INTERVAL) * 1000))
       speed_step();   
   #endif
+
+  #if ENABLED(CNCROUTER_TACHO)
+    #if ENABLED(CNCROUTER_FEED_OVERRIDE)
+      constexpr millis_s tacho_interval = CNCROUTER_FEED_INTERVAL;
+    #else
+      constexpr millis_s tacho_interval = 100;
+    #endif
+    static short_timer_t tacho_timer(millis());
+    if (tacho_timer.expired(tacho_interval)) {
+      if (tacho.spin(!!get_Speed())) SERIAL_LM(ER, "Spindle stalled");
+      #if ENABLED(CNCROUTER_FEED_OVERRIDE)
+        feed_step(get_rpm());
+      #endif
+    }
+  #endif
 }
 
 void Cncrouter::tool_change(uint8_t tool_id, bool wait/*=true*/, bool raise_z/*=true*/) {
@@ -138,7 +166,15 @@ void Cncrouter::tool_change(uint8_t tool_id, bool wait/*=true*/, bool raise_z/*=
 
   void Cncrouter::print_Speed() {
     SERIAL_MV(" CNC speed: ", get_Speed());
-    SERIAL_EM(" rpm ");
+    #if ENABLED(CNCROUTER_TACHO)
+      SERIAL_MV(" rpm measured: ", get_rpm());
+    #endif
+    #if ENABLED(CNCROUTER_FEED_OVERRIDE)
+      SERIAL_MV(" rpm feed: ", int(feed_percentage));
+      SERIAL_EM("%");
+    #else
+      SERIAL_EM(" rpm ");
+    #endif
   }
 
 #endif
@@ -179,6 +215,31 @@ void Cncrouter::disable_router() {
 
 #endif
 
+#if ENABLED(CNCROUTER_FEED_OVERRIDE)
+
+  /**
+   * Lower the feed while the rpm is under the commanded one by more than
+   * CNCROUTER_FEED_DROP percent, raise it again when the rpm is back within
+   * half of the drop. The gap between the two is the hysteresis.
+   * With the spindle off the feed is the one set by M220.
+   */
+  void Cncrouter::feed_step(const uint32_t rpm) {
+    if (rpm_instant == 0) {
+      feed_percentage = 100;
+      return;
+    }
+    if (rpm * 100 < rpm_instant * (100 - (CNCROUTER_FEED_DROP))) {
+      if (feed_percentage > (CNCROUTER_FEED_MIN))
+        feed_percentage = MAX(feed_percentage - (CNCROUTER_FEED_STEP), CNCROUTER_FEED_MIN);
+    }
+    else if (rpm * 200 >= rpm_instant * (200 - (CNCROUTER_FEED_DROP))) {
+      if (feed_percentage < 100)
+        feed_percentage = MIN(feed_percentage + (CNCROUTER_FEED_STEP), 100);
+    }
+  }
+
+#endif
+
 // XXX TODO: support for CNCROUTER_ANTICLOCKWISE 
 void Cncrouter::setRouterSpeed(uint32_t rpm, bool clockwise/*=false*/) {
   #if ENABLED(FAST_PWM_CNCROUTER)
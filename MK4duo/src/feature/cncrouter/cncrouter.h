@@ -50,6 +50,14 @@ class Cncrouter {
 
   public: /** Public Parameters */
 
+    #if ENABLED(CNCROUTER_TACHO)
+      static tacho_data_t tacho;            // rpm for CNCROUTER_TACHO_PULSES 2
+    #endif
+
+    #if ENABLED(CNCROUTER_FEED_OVERRIDE)
+      static uint8_t feed_percentage;       // scale of the M220 feedrate on the spindle load
+    #endif
+
   private: /** Private Parameters */
 
     static uint8_t active_tool;
@@ -81,12 +89,20 @@ class Cncrouter {
       #endif // INVERTED_CNCROUTER_PIN
     #endif // FAST_PWM_CNCROUTER
 
+    #if ENABLED(CNCROUTER_TACHO)
+      static uint32_t get_rpm() { return uint32_t(tacho.rpm) * 2 / (CNCROUTER_TACHO_PULSES); }
+    #endif
+
     static void setRouterSpeed(uint32_t rpm, bool clockwise=false);
     static void disable_router();
 
   private: /** Private Function */
 
     static void speed_step();
+
+    #if ENABLED(CNCROUTER_FEED_OVERRIDE)
+      static void feed_step(const uint32_t rpm);
+    #endif
     static uint8_t calcPWM(uint32_t rpm);
     static void setPwm(uint8_t pwm);
 
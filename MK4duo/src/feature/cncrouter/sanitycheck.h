@@ -30,3 +30,35 @@
 #if ENABLED(CNCROUTER) && !PIN_EXISTS(CNCROUTER)
   #error "DEPENDENCY ERROR: You have to set CNCROUTER_PIN to a valid pin if you enable CNCROUTER."
 #endif
+
+#if ENABLED(CNCROUTER_TACHO)
+  #if DISABLED(TACHOMETRIC)
+    #error "DEPENDENCY ERROR: CNCROUTER_TACHO requires TACHOMETRIC."
+  #elif !PIN_EXISTS(CNCROUTER_TACHO)
+    #error "DEPENDENCY ERROR: You have to set CNCROUTER_TACHO_PIN to a valid pin if you enable CNCROUTER_TACHO."
+  #elif DISABLED(CNCROUTER_TACHO_PULSES)
+    #error "DEPENDENCY ERROR: Missing setting CNCROUTER_TACHO_PULSES."
+  #endif
+#endif
+
+#if ENABLED(CNCROUTER_NATIVE_ARC)
+  #if DISABLED(ARC_SUPPORT)
+    #error "DEPENDENCY ERROR: CNCROUTER_NATIVE_ARC requires ARC_SUPPORT."
+  #elif IS_KINEMATIC || IS_CORE
+    #error "DEPENDENCY ERROR: CNCROUTER_NATIVE_ARC requires a Cartesian machine."
+  #elif ENABLED(__AVR__)
+    #error "DEPENDENCY ERROR: CNCROUTER_NATIVE_ARC requires a 32 bit board."
+  #elif ENABLED(INPUT_SHAPING) || ENABLED(STEP_QUEUE) || ENABLED(HYSTERESIS_FEATURE)
+    #error "DEPENDENCY ERROR: CNCROUTER_NATIVE_ARC is not compatible with INPUT_SHAPING, STEP_QUEUE or HYSTERESIS_FEATURE."
+  #endif
+#endif
+
+#if ENABLED(CNCROUTER_FEED_OVERRIDE)
+  #if DISABLED(CNCROUTER_TACHO) || DISABLED(FAST_PWM_CNCROUTER)
+    #error "DEPENDENCY ERROR: CNCROUTER_FEED_OVERRIDE requires CNCROUTER_TACHO and FAST_PWM_CNCROUTER."
+  #elif DISABLED(CNCROUTER_FEED_DROP) || DISABLED(CNCROUTER_FEED_STEP) || DISABLED(CNCROUTER_FEED_MIN) || DISABLED(CNCROUTER_FEED_INTERVAL)
+    #error "DEPENDENCY ERROR: Missing setting CNCROUTER_FEED_DROP, CNCROUTER_FEED_STEP, CNCROUTER_FEED_MIN or CNCROUTER_FEED_INTERVAL."
+  #elif !WITHIN(CNCROUTER_FEED_MIN, 1, 100) || !WITHIN(CNCROUTER_FEED_DROP, 1, 99)
+    #error "DEPENDENCY ERROR: CNCROUTER_FEED_MIN must be 1-100 and CNCROUTER_FEED_DROP 1-99."
+  #endif
+#endif
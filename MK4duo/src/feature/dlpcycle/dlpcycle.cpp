@@ -0,0 +1,127 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(DLP_LAYER_CYCLE)
+
+DLPCycle dlpcycle;
+
+/** Public Parameters */
+float     DLPCycle::peel_distance     = 0,
+          DLPCycle::peel_feedrate     = 0,
+          DLPCycle::retract_feedrate  = 0,
+          DLPCycle::tilt_distance     = 0,
+          DLPCycle::layer_thickness   = 0;
+
+millis_l  DLPCycle::peel_pause        = 0,
+          DLPCycle::settle_time       = 0,
+          DLPCycle::overlap_time      = 0;
+
+uint16_t  DLPCycle::layer             = 0;
+
+/** Private Parameters */
+volatile uint8_t  DLPCycle::expose_count[2]  = { 0 };
+volatile bool     DLPCycle::exposing         = false;
+
+uint8_t           DLPCycle::report_count[2]  = { 0 };
+
+/** Public Function */
+void DLPCycle::init() {
+  #if PIN_EXISTS(DLP_EXPOSE)
+    OUT_WRITE(DLP_EXPOSE_PIN, LOW);
+  #endif
+}
+
+void DLPCycle::spin() {
+
+  // The end of the exposure dropped by a quick stop, the queue can't be empty while exposing
+  if (exposing && !planner.has_blocks_queued()) expose_isr(false);
+
+  // The starts and the ends alternate, even those of the layers run in the same idle loop
+  for (;;) {
+    const bool on = report_count[0] == report_count[1];
+    if (report_count[on ? 0 : 1] == expose_count[on ? 0 : 1]) break;
+    report_count[on ? 0 : 1]++;
+    host_action.expose(on);
+  }
+
+}
+
+void DLPCycle::set_peel(const float distance, const float feedrate, const float retract, const millis_l pause, const float tilt, const float thickness) {
+  peel_distance     = distance;
+  peel_feedrate     = feedrate;
+  retract_feedrate  = retract;
+  peel_pause        = pause;
+  tilt_distance     = tilt;
+  layer_thickness   = thickness;
+  layer             = 0;
+}
+
+void DLPCycle::queue_layer(const millis_l exposure, const bool tilt) {
+
+  const uint8_t tool  = toolManager.extruder.active;
+  const float   x     = mechanics.destination.x,
+                y     = mechanics.destination.y,
+                z     = mechanics.destination.z,
+                next_z  = z + layer_thickness;
+
+  // The settle, with the trigger of the exposure ahead by the latency of the projector
+  const millis_l overlap = MIN(overlap_time, settle_time);
+  planner.buffer_sync_dwell(settle_time - overlap);
+  planner.buffer_sync_expose(true);
+  planner.buffer_sync_dwell(overlap + exposure);
+  planner.buffer_sync_expose(false);
+
+  // The second Z motor is on E: the peel lifts a side and then the other, the tilt just one
+  if (tilt) {
+    if (tilt_distance > 0) {
+      planner.buffer_line(x, y, z + tilt_distance, z, retract_feedrate, tool);
+      planner.buffer_sync_dwell(peel_pause);
+    }
+  }
+  else if (peel_distance > 0) {
+    const float peel_z = z + peel_distance;
+    planner.buffer_line(x, y, peel_z, z, peel_feedrate, tool);
+    planner.buffer_line(x, y, peel_z, peel_z, peel_feedrate, tool);
+    planner.buffer_sync_dwell(peel_pause);
+  }
+
+  // Down to the next layer, the settle of the next cycle follows
+  planner.buffer_line(x, y, next_z, next_z, retract_feedrate, tool);
+
+  mechanics.destination.z = next_z;
+  mechanics.position = mechanics.destination;
+  layer++;
+
+}
+
+void DLPCycle::expose_isr(const bool on) {
+  #if PIN_EXISTS(DLP_EXPOSE)
+    WRITE(DLP_EXPOSE_PIN, on ? HIGH : LOW);
+  #endif
+  exposing = on;
+  expose_count[on ? 0 : 1]++;
+}
+
+#endif // ENABLED(DLP_LAYER_CYCLE)
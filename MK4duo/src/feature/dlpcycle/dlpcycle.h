@@ -0,0 +1,85 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * dlpcycle.h
+ *
+ * The cycle of a DLP layer queued in the planner: settle, exposure, peel or tilt, next layer
+ */
+
+#if ENABLED(DLP_LAYER_CYCLE)
+
+enum DLPExposeEnum : uint8_t {
+  DLP_EXPOSE_NONE,
+  DLP_EXPOSE_ON,
+  DLP_EXPOSE_OFF
+};
+
+class DLPCycle {
+
+  public: /** Constructor */
+
+    DLPCycle() {}
+
+  public: /** Public Parameters */
+
+    static float    peel_distance,    // Set by M650
+                    peel_feedrate,
+                    retract_feedrate,
+                    tilt_distance,
+                    layer_thickness;
+
+    static millis_l peel_pause,
+                    settle_time,      // [ms] Resin settle before the exposure, M652 S
+                    overlap_time;     // [ms] Exposure triggered before the end of the settle, M652 O
+
+    static uint16_t layer;            // Layers queued since M650
+
+  private: /** Private Parameters */
+
+    static volatile uint8_t expose_count[2];  // Exposures started and ended by the stepper
+    static volatile bool    exposing;
+
+    static uint8_t          report_count[2];  // The ones reported to the host
+
+  public: /** Public Function */
+
+    static void init();
+    static void spin();
+
+    static void set_peel(const float distance, const float feedrate, const float retract, const millis_l pause, const float tilt, const float thickness);
+
+    /**
+     * The cycle of the layer at the Z of the destination, all in the planner:
+     * the moves are computed here, the waits are sync blocks timed by the stepper
+     */
+    static void queue_layer(const millis_l exposure, const bool tilt);
+
+    // From the Stepper ISR, at the sync block of the exposure
+    static void expose_isr(const bool on);
+
+};
+
+extern DLPCycle dlpcycle;
+
+#endif // ENABLED(DLP_LAYER_CYCLE)
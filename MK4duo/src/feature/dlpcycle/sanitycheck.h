@@ -0,0 +1,38 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+#if ENABLED(DLP_LAYER_CYCLE)
+  #if !MECH(MUVE3D)
+    #error "DEPENDENCY ERROR: DLP_LAYER_CYCLE requires MECH_MUVE3D."
+  #elif ENABLED(STEP_QUEUE) || ENABLED(STEP_COPROCESSOR)
+    #error "DEPENDENCY ERROR: DLP_LAYER_CYCLE is not compatible with STEP_QUEUE or STEP_COPROCESSOR."
+  #elif DISABLED(DLP_EXPOSE_PIN)
+    #error "DEPENDENCY ERROR: Missing setting DLP_EXPOSE_PIN, set it to NoPin for the host action only."
+  #endif
+#endif
@@ -36,11 +36,41 @@ bool  EmergencyParser::killed_by_M112 = false;
 
 uint8_t EmergencyParser::M876_response = 0;
 
+#if ENABLED(REALTIME_COMMANDS)
+  volatile bool EmergencyParser::feed_hold = false;
+#endif
+
 /** Private Parameters */
 bool EmergencyParser::enabled = true;
 
+#if ENABLED(REALTIME_COMMANDS)
+  volatile bool   EmergencyParser::feedrate_reset = false,
+                  EmergencyParser::flow_reset     = false;
+  volatile int8_t EmergencyParser::feedrate_delta = 0,
+                  EmergencyParser::flow_delta     = 0;
+  bool            EmergencyParser::hold_reported  = false;
+#endif
+
 //Public Function
-void EmergencyParser::update(EmergencyStateEnum &state, const uint8_t c) {
+bool EmergencyParser::update(EmergencyStateEnum &state, const uint8_t c) {
+
+  #if ENABLED(REALTIME_COMMANDS)
+    if (c & 0x80) {
+      // A continuation byte of an UTF-8 character
+      if (state >= EP_UTF8_1 && state <= EP_UTF8_3 && c < 0xC0) {
+        state = (state == EP_UTF8_1) ? EP_IGNORE : EmergencyStateEnum(state - 1);
+        return false;
+      }
+      // The lead byte of an UTF-8 character
+      if (c >= 0xC2 && c <= 0xF4) {
+        state = (c < 0xE0) ? EP_UTF8_1 : (c < 0xF0) ? EP_UTF8_2 : EP_UTF8_3;
+        return false;
+      }
+      if (enabled && realtime(c)) return true;
+      state = EP_IGNORE;
+      return false;
+    }
+  #endif
 
   switch (state) {
     case EP_RESET:
@@ -65,6 +95,7 @@ void EmergencyParser::update(EmergencyStateEnum &state, const uint8_t c) {
         case ' ': break;
         case '1': state = EP_M1;     break;
         case '4': state = EP_M4;     break;
+        case '5': state = EP_M5;     break;
         case '8': state = EP_M8;     break;
         default: state  = EP_IGNORE;
       }
@@ -94,6 +125,14 @@ void EmergencyParser::update(EmergencyStateEnum &state, const uint8_t c) {
       state = (c == '0') ? EP_M410 : EP_IGNORE;
       break;
 
+    case EP_M5:
+      state = (c == '2') ? EP_M52 : EP_IGNORE;
+      break;
+
+    case EP_M52:
+      state = (c == '4') ? EP_M524 : EP_IGNORE;
+      break;
+
     case EP_M8:
       state = (c == '7') ? EP_M87 : EP_IGNORE;
       break;
@@ -134,6 +173,16 @@ void EmergencyParser::update(EmergencyStateEnum &state, const uint8_t c) {
           case EP_M410:
             printer.quickstop_stepper();
             break;
+          case EP_M524:
+            #if HAS_SD_SUPPORT
+              // The abort runs in the main loop, here only the waits are broken
+              if (IS_SD_PRINTING()) {
+                card.setAbortSDprinting(true);
+                printer.setWaitForHeatUp(false);
+                printer.setWaitForUser(false);
+              }
+            #endif
+            break;
           case EP_M876SN:
             host_action.response_handler(M876_response);
             break;
@@ -143,6 +192,82 @@ void EmergencyParser::update(EmergencyStateEnum &state, const uint8_t c) {
         state = EP_RESET;
       }
   }
+
+  return false;
 }
 
+#if ENABLED(REALTIME_COMMANDS)
+
+  /**
+   * Apply the overrides received since the last call. Called from idle(),
+   * so the serial ISR never changes the feedrate or the flow of a move being planned.
+   */
+  void EmergencyParser::spin() {
+
+    CRITICAL_SECTION_START;
+      const bool    f_reset = feedrate_reset, e_reset = flow_reset;
+      const int8_t  f_delta = feedrate_delta, e_delta = flow_delta;
+      feedrate_reset = flow_reset = false;
+      feedrate_delta = flow_delta = 0;
+    CRITICAL_SECTION_END;
+
+    if (f_reset || f_delta) {
+      if (f_reset) mechanics.feedrate_percentage = 100;
+      mechanics.feedrate_percentage = constrain(mechanics.feedrate_percentage + f_delta, 10, 999);
+      SERIAL_LMV(ECHO, "Speed factor: ", mechanics.feedrate_percentage);
+    }
+
+    #if MAX_EXTRUDER > 0
+      if (e_reset || e_delta) {
+        Extruder * const ext = extruders[toolManager.extruder.active];
+        if (e_reset) ext->flow_percentage = 100;
+        ext->flow_percentage = constrain(ext->flow_percentage + e_delta, 10, 999);
+        ext->refresh_e_factor();
+        SERIAL_LMV(ECHO, "Flow: ", ext->flow_percentage);
+      }
+    #else
+      UNUSED(e_reset); UNUSED(e_delta);
+    #endif
+
+    if (hold_reported != feed_hold) {
+      hold_reported = feed_hold;
+      #if ENABLED(FEED_HOLD)
+        stepper.feed_hold(hold_reported);
+      #endif
+      SERIAL_LM(ECHO, hold_reported ? "Feed hold" : "Resume");
+    }
+
+  }
+
+  /**
+   * Act on a realtime byte, in the serial ISR. Only set the requests.
+   */
+  bool EmergencyParser::realtime(const uint8_t c) {
+
+    // Saturated, the value is applied within a few ms
+    #define RT_STEP(D,S) D = constrain(D + (S), -100, 100)
+
+    switch (c) {
+      case 0x81: feed_hold = true;  break;
+      case 0x82: feed_hold = false; break;
+      case 0x90: feedrate_reset = true; feedrate_delta = 0; break;
+      case 0x91: RT_STEP(feedrate_delta,  10); break;
+      case 0x92: RT_STEP(feedrate_delta, -10); break;
+      case 0x93: RT_STEP(feedrate_delta,   1); break;
+      case 0x94: RT_STEP(feedrate_delta,  -1); break;
+      case 0x99: flow_reset = true; flow_delta = 0; break;
+      case 0x9A: RT_STEP(flow_delta,  10); break;
+      case 0x9B: RT_STEP(flow_delta, -10); break;
+      case 0x9C: RT_STEP(flow_delta,   1); break;
+      case 0x9D: RT_STEP(flow_delta,  -1); break;
+      default: return false;
+    }
+
+    #undef RT_STEP
+
+    return true;
+  }
+
+#endif // REALTIME_COMMANDS
+
 #endif // EMERGENCY_PARSER
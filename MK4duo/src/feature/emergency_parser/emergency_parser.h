@@ -37,16 +37,38 @@ class EmergencyParser {
 
     static uint8_t M876_response;
 
+    #if ENABLED(REALTIME_COMMANDS)
+      static volatile bool feed_hold;     // The command queue is not read
+    #endif
+
   private: /** Private Parameters */
 
     static bool enabled;
 
+    #if ENABLED(REALTIME_COMMANDS)
+      // Set by the serial ISR, applied by spin()
+      static volatile bool    feedrate_reset, flow_reset;
+      static volatile int8_t  feedrate_delta, flow_delta;
+      static bool             hold_reported;
+    #endif
+
   public: /** Public Function */
 
     FORCE_INLINE static void enable()   { enabled = true; }
     FORCE_INLINE static void disable()  { enabled = false; }
 
-    static void update(EmergencyStateEnum &state, const uint8_t c);
+    // Return true for a realtime byte, not to be stored in the receive buffer
+    static bool update(EmergencyStateEnum &state, const uint8_t c);
+
+    #if ENABLED(REALTIME_COMMANDS)
+      static void spin();
+    #endif
+
+  private: /** Private Function */
+
+    #if ENABLED(REALTIME_COMMANDS)
+      static bool realtime(const uint8_t c);
+    #endif
 
 };
 
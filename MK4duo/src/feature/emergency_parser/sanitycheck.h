@@ -26,3 +26,7 @@
  *
  * Test configuration values for errors at compile-time.
  */
+
+#if ENABLED(REALTIME_COMMANDS) && DISABLED(EMERGENCY_PARSER)
+  #error "DEPENDENCY ERROR: REALTIME_COMMANDS requires EMERGENCY_PARSER."
+#endif
@@ -37,5 +37,27 @@
   uint8_t meas_delay_cm = MEASUREMENT_DELAY_CM;                   // Distance delay setting
   int8_t  measurement_delay[MAX_MEASUREMENT_DELAY + 1],           // Ring buffer to delayed measurement. Store extruder factor after subtracting 100
           filwidth_delay_index[2] = { 0, -1 };                    // Indexes into ring buffer
+  float   filwidth_factor = 1.0f;                                 // Width factor of the E steps of the last block, 1.0 nominal
+
+  /**
+   * Factor of the E steps of a block of the sensor extruder, from the width
+   * measured when the filament now in the melt chamber passed the sensor.
+   * The ring has one sample for each cm of filament fed by the planner.
+   */
+  float filwidth_block_factor() {
+    if (!filament_sensor || filwidth_delay_index[1] < 0) return (filwidth_factor = 1.0f);
+
+    int8_t index = filwidth_delay_index[0] - meas_delay_cm;
+    if (index < 0) index += MAX_MEASUREMENT_DELAY + 1;  // Loop around buffer if needed
+    LIMIT(index, 0, MAX_MEASUREMENT_DELAY);
+
+    // Linear squares the ratio, which scales the volume. Volumetric takes the
+    // measured area in place of the one of the filament size in e_factor.
+    const float ratio_2 = sq(1.0f + 0.01f * measurement_delay[index]);
+    filwidth_factor = toolManager.isVolumetric()
+      ? ratio_2 / (extruders[FILAMENT_SENSOR_EXTRUDER_NUM]->volumetric_multiplier * toolManager.volumetric_area_nominal)
+      : ratio_2;
+    return filwidth_factor;
+  }
 
 #endif
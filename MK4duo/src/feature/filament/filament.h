@@ -34,4 +34,7 @@
   extern uint8_t  meas_delay_cm;                                // Distance delay setting
   extern int8_t   measurement_delay[MAX_MEASUREMENT_DELAY + 1], // Ring buffer to delayed measurement. Store extruder factor after subtracting 100
                   filwidth_delay_index[2];                      // Indexes into ring buffer
+  extern float    filwidth_factor;                              // Width factor of the E steps of the last block, 1.0 nominal
+
+  float filwidth_block_factor();
 #endif
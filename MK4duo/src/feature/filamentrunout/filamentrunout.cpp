@@ -36,7 +36,15 @@ FilamentRunout filamentrunout;
 /** Public Parameters */
 filament_data_t FilamentSensorBase::data;
 
-#if FILAMENT_RUNOUT_DISTANCE_MM > 0
+#if ENABLED(EXTRUDER_ENCODER_MOTION)
+  volatile float  RunoutResponseMotion::slot_commanded[EXTRUDERS] = { 0 };
+  uint16_t        RunoutResponseMotion::slot_pulses[EXTRUDERS] = { 0 };
+  float           RunoutResponseMotion::window_commanded[EXTRUDERS][RunoutResponseMotion::slots],
+                  RunoutResponseMotion::window_measured[EXTRUDERS][RunoutResponseMotion::slots];
+  uint8_t         RunoutResponseMotion::window_index[EXTRUDERS] = { 0 },
+                  RunoutResponseMotion::window_filled[EXTRUDERS] = { 0 },
+                  RunoutResponseMotion::ran_out = 0;
+#elif FILAMENT_RUNOUT_DISTANCE_MM > 0
   volatile float RunoutResponseDelayed::runout_mm_countdown[EXTRUDERS] = { 0 };
 #endif
 
@@ -45,7 +53,7 @@ filament_data_t FilamentSensorBase::data;
   uint8_t FilamentSensorEncoder::motion_detected = 0;
 #endif
 
-#if FILAMENT_RUNOUT_DISTANCE_MM == 0
+#if DISABLED(EXTRUDER_ENCODER_MOTION) && FILAMENT_RUNOUT_DISTANCE_MM == 0
   int8_t RunoutResponseDebounced::runout_count = 0;
 #endif
 
@@ -154,7 +162,57 @@ void FilamentSensorBase::filament_present(const uint8_t extruder) {
   filamentrunout.filament_present(extruder);
 }
 
-#if FILAMENT_RUNOUT_DISTANCE_MM > 0
+#if ENABLED(EXTRUDER_ENCODER_MOTION)
+
+  /**
+   * Called by FilamentSensorEncoder::run for each edge of the encoder
+   */
+  void FilamentSensorBase::motion_pulse(const uint8_t extruder) {
+    filamentrunout.response.motion_pulse(extruder);
+  }
+
+  void RunoutResponseMotion::filament_present(const uint8_t extruder) {
+    slot_commanded[extruder] = 0;
+    slot_pulses[extruder] = 0;
+    window_index[extruder] = window_filled[extruder] = 0;
+    CBI(ran_out, extruder);
+  }
+
+  /**
+   * Close the slot of the active extruder when slot_mm were commanded
+   * and check the ratio of measured to commanded filament on the window
+   */
+  void RunoutResponseMotion::run() {
+    const uint8_t e = toolManager.extruder.active;
+    if (slot_commanded[e] < slot_mm) return;
+
+    const uint8_t i = window_index[e];
+    window_commanded[e][i] = slot_commanded[e];
+    window_measured[e][i] = slot_pulses[e] * float(FILAMENT_MOTION_MM_PER_PULSE);
+    slot_commanded[e] = 0;
+    slot_pulses[e] = 0;
+    window_index[e] = (i + 1) % slots;
+    if (window_filled[e] < slots) window_filled[e]++;
+    if (window_filled[e] < slots) return;
+
+    float commanded = 0, measured = 0;
+    for (uint8_t s = 0; s < slots; s++) {
+      commanded += window_commanded[e][s];
+      measured += window_measured[e][s];
+    }
+    const float ratio = measured / commanded;
+
+    #if ENABLED(FILAMENT_RUNOUT_SENSOR_DEBUG)
+      SERIAL_MV("Filament motion E", int(e));
+      SERIAL_MV(" commanded:", commanded);
+      SERIAL_MV(" measured:", measured);
+      SERIAL_EMV(" ratio:", ratio);
+    #endif
+
+    if (ratio < float(FILAMENT_MOTION_MIN_RATIO)) SBI(ran_out, e);
+  }
+
+#elif FILAMENT_RUNOUT_DISTANCE_MM > 0
 
   void RunoutResponseDelayed::filament_present(const uint8_t extruder) {
     runout_mm_countdown[extruder] = filamentrunout.runout_distance();
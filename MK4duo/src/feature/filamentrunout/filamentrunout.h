@@ -103,13 +103,13 @@ class FilamentRunoutBase {
     // Give the response a chance to update its counter.
     static inline void spin() {
       if (sensor.isEnabled() && !sensor.isFilamentOut() && printer.isPrinting()) {
-        #if FILAMENT_RUNOUT_DISTANCE_MM > 0
-          cli(); // Prevent RunoutResponseDelayed::block_completed from accumulating here
+        #if FILAMENT_RUNOUT_DISTANCE_MM > 0 || ENABLED(EXTRUDER_ENCODER_MOTION)
+          cli(); // Prevent the response block_completed from accumulating here
         #endif
         response.run();
         sensor.run();
         const bool ran_out = response.has_run_out();
-        #if FILAMENT_RUNOUT_DISTANCE_MM > 0
+        #if FILAMENT_RUNOUT_DISTANCE_MM > 0 || ENABLED(EXTRUDER_ENCODER_MOTION)
           sei();
         #endif
         if (ran_out) {
@@ -242,6 +242,10 @@ class FilamentSensorBase {
 
     static void filament_present(const uint8_t extruder);
 
+    #if ENABLED(EXTRUDER_ENCODER_MOTION)
+      static void motion_pulse(const uint8_t extruder);
+    #endif
+
 };
 
 #if ENABLED(EXTRUDER_ENCODER_CONTROL)
@@ -261,10 +265,14 @@ class FilamentSensorBase {
     public: /** Public Function */
 
       static inline void block_completed(const block_t* const b) {
-        // If the sensor wheel has moved since the last call to
-        // this method reset the runout counter for the active extruder.
-        if (TEST(motion_detected, b->active_extruder))
-          filament_present(b->active_extruder);
+        #if ENABLED(EXTRUDER_ENCODER_MOTION)
+          UNUSED(b);  // The pulses are counted by the response
+        #else
+          // If the sensor wheel has moved since the last call to
+          // this method reset the runout counter for the active extruder.
+          if (TEST(motion_detected, b->active_extruder))
+            filament_present(b->active_extruder);
+        #endif
 
         // Clear motion triggers for next block
         motion_detected = 0;
@@ -286,6 +294,11 @@ class FilamentSensorBase {
           }
         #endif
 
+        #if ENABLED(EXTRUDER_ENCODER_MOTION)
+          // A pulse for each edge of the encoder
+          if (change) LOOP_EXTRUDER() if (TEST(change, e)) motion_pulse(e);
+        #endif
+
         motion_detected |= change;
       }
 
@@ -340,7 +353,52 @@ class FilamentSensorBase {
 
 #endif // DISABLED(EXTRUDER_ENCODER_CONTROL)
 
-#if FILAMENT_RUNOUT_DISTANCE_MM > 0
+#if ENABLED(EXTRUDER_ENCODER_MOTION)
+
+  // RunoutResponseMotion compares the filament moved by the encoder with the
+  // E moves of the completed blocks, over the last FILAMENT_MOTION_WINDOW_MM
+  // of commanded filament. A ratio under FILAMENT_MOTION_MIN_RATIO is taken
+  // as a jam or an under-extrusion and triggers a runout event.
+  class RunoutResponseMotion {
+
+    private: /** Private Parameters */
+
+      static constexpr uint8_t  slots   = 4;
+      static constexpr float    slot_mm = float(FILAMENT_MOTION_WINDOW_MM) / slots;
+
+      static volatile float slot_commanded[EXTRUDERS];    // Commanded mm of the open slot, from the ISR
+      static uint16_t       slot_pulses[EXTRUDERS];       // Encoder pulses of the open slot
+      static float          window_commanded[EXTRUDERS][slots],
+                            window_measured[EXTRUDERS][slots];
+      static uint8_t        window_index[EXTRUDERS],
+                            window_filled[EXTRUDERS];
+      static uint8_t        ran_out;
+
+    public: /** Public Function */
+
+      static inline void reset() {
+        LOOP_EXTRUDER() filament_present(e);
+      }
+
+      static void run();
+
+      static inline bool has_run_out() { return TEST(ran_out, toolManager.extruder.active); }
+
+      static void filament_present(const uint8_t extruder);
+
+      static inline void motion_pulse(const uint8_t extruder) { slot_pulses[extruder]++; }
+
+      static inline void block_completed(const block_t* const block) {
+        // The encoder turns both ways, retracts and primes count too
+        if (printer.isPrinting()) {
+          const uint8_t e = block->active_extruder;
+          slot_commanded[e] += block->steps.e * extruders[e]->steps_to_mm;
+        }
+      }
+
+  };
+
+#elif FILAMENT_RUNOUT_DISTANCE_MM > 0
 
   // RunoutResponseDelayed triggers a runout event only if the length
   // of filament specified by FILAMENT_RUNOUT_DISTANCE_MM has been fed
@@ -414,7 +472,9 @@ class FilamentSensorBase {
 
 #endif // !FILAMENT_RUNOUT_DISTANCE_MM
 
-#if FILAMENT_RUNOUT_DISTANCE_MM > 0
+#if ENABLED(EXTRUDER_ENCODER_MOTION)
+  typedef FilamentRunoutBase<RunoutResponseMotion, FilamentSensorEncoder>   FilamentRunout;
+#elif FILAMENT_RUNOUT_DISTANCE_MM > 0
   #if ENABLED(EXTRUDER_ENCODER_CONTROL)
     typedef FilamentRunoutBase<RunoutResponseDelayed, FilamentSensorEncoder>  FilamentRunout;
   #else
@@ -42,6 +42,17 @@
   #elif DISABLED(ADVANCED_PAUSE_FEATURE)
     static_assert(NULL == strstr(FILAMENT_RUNOUT_SCRIPT, "M600"), "DEPENDENCY ERROR: ADVANCED_PAUSE_FEATURE is required to use M600 with FILAMENT_RUNOUT_SENSOR.");
   #endif
+  #if ENABLED(EXTRUDER_ENCODER_MOTION)
+    #if DISABLED(EXTRUDER_ENCODER_CONTROL)
+      #error "DEPENDENCY ERROR: EXTRUDER_ENCODER_CONTROL is require to use EXTRUDER_ENCODER_MOTION"
+    #elif FILAMENT_RUNOUT_DISTANCE_MM > 0
+      #error "DEPENDENCY ERROR: EXTRUDER_ENCODER_MOTION requires FILAMENT_RUNOUT_DISTANCE_MM 0"
+    #elif DISABLED(FILAMENT_MOTION_MM_PER_PULSE) || DISABLED(FILAMENT_MOTION_WINDOW_MM) || DISABLED(FILAMENT_MOTION_MIN_RATIO)
+      #error "DEPENDENCY ERROR: Missing setting FILAMENT_MOTION_MM_PER_PULSE, FILAMENT_MOTION_WINDOW_MM or FILAMENT_MOTION_MIN_RATIO."
+    #endif
+    static_assert(FILAMENT_MOTION_WINDOW_MM >= 8 * (FILAMENT_MOTION_MM_PER_PULSE), "FILAMENT_MOTION_WINDOW_MM must be at least 8 encoder pulses.");
+    static_assert(FILAMENT_MOTION_MIN_RATIO > 0 && FILAMENT_MOTION_MIN_RATIO < 1, "FILAMENT_MOTION_MIN_RATIO must be between 0 and 1.");
+  #endif
 #else
   #if ENABLED(EXTRUDER_ENCODER_CONTROL)
     #error "DEPENDENCY ERROR: FILAMENT_RUNOUT_SENSOR is require to use EXTRUDER_ENCODER_CONTROL"
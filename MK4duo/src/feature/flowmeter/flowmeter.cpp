@@ -53,6 +53,9 @@ int       FlowMeter::flowrate_pulsecount  = 0;
 
 /** Private Parameters */
 millis_l  FlowMeter::lastflow             = 0;
+#if ENABLED(FLOWMETER_CAPTURE)
+  bool    FlowMeter::capture              = false;
+#endif
 
 /** Public Function */
 void flowrate_pulsecounter() {
@@ -63,6 +66,12 @@ void flowrate_pulsecounter() {
 void FlowMeter::init() {
   flowrate = 0;
   flowrate_pulsecount = 0;
+
+  #if ENABLED(FLOWMETER_CAPTURE)
+    capture = HAL::tacho_capture_init(FLOWMETER_PIN);
+    if (capture) return;
+  #endif
+
   HAL::pinMode(FLOWMETER_PIN, INPUT);
 
   attachInterrupt(digitalPinToInterrupt(FLOWMETER_PIN), flowrate_pulsecounter, FALLING);
@@ -72,17 +81,35 @@ void FlowMeter::spin() {
 
   millis_l now = millis();
 
-  detachInterrupt(digitalPinToInterrupt(FLOWMETER_PIN));
-  flowrate  = (float)(((1000.0 / (float)((float)now - (float)lastflow)) * (float)flowrate_pulsecount) / (float)FLOWMETER_CALIBRATION);
-  #if ENABLED(FLOWMETER_DEBUG)
-    SERIAL_SM(DEB, "FLOWMETER DEBUG ");
-    SERIAL_MV(" flowrate:", flowrate);
-    SERIAL_MV(" flowrate_pulsecount:", flowrate_pulsecount);
-    SERIAL_EMV(" CALIBRATION:", FLOWMETER_CALIBRATION);
+  #if ENABLED(FLOWMETER_CAPTURE)
+    if (capture) {
+      uint32_t period, age;
+      HAL::tacho_capture_read(FLOWMETER_PIN, period, age);
+      // No pulse for a second is no flow
+      flowrate = (period && age < HAL_TACHO_CAPTURE_RATE) ? (float(HAL_TACHO_CAPTURE_RATE) / period) / (float)FLOWMETER_CALIBRATION : 0;
+      #if ENABLED(FLOWMETER_DEBUG)
+        SERIAL_SM(DEB, "FLOWMETER DEBUG ");
+        SERIAL_MV(" flowrate:", flowrate);
+        SERIAL_MV(" period:", period);
+        SERIAL_EMV(" CALIBRATION:", FLOWMETER_CALIBRATION);
+      #endif
+      lastflow = now;
+    }
+    else
   #endif
-  lastflow = now;
-  flowrate_pulsecount = 0;
-  attachInterrupt(digitalPinToInterrupt(FLOWMETER_PIN), flowrate_pulsecounter, FALLING);
+  {
+    detachInterrupt(digitalPinToInterrupt(FLOWMETER_PIN));
+    flowrate  = (float)(((1000.0 / (float)((float)now - (float)lastflow)) * (float)flowrate_pulsecount) / (float)FLOWMETER_CALIBRATION);
+    #if ENABLED(FLOWMETER_DEBUG)
+      SERIAL_SM(DEB, "FLOWMETER DEBUG ");
+      SERIAL_MV(" flowrate:", flowrate);
+      SERIAL_MV(" flowrate_pulsecount:", flowrate_pulsecount);
+      SERIAL_EMV(" CALIBRATION:", FLOWMETER_CALIBRATION);
+    #endif
+    lastflow = now;
+    flowrate_pulsecount = 0;
+    attachInterrupt(digitalPinToInterrupt(FLOWMETER_PIN), flowrate_pulsecounter, FALLING);
+  }
 
   #if ENABLED(MINFLOW_PROTECTION)
     if (flow_firstread && print_job_counter.isRunning() && (flowrate < (float)MINFLOW_PROTECTION)) {
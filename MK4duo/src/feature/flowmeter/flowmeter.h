@@ -60,6 +60,10 @@ class FlowMeter {
 
     static millis_l lastflow;
 
+    #if ENABLED(FLOWMETER_CAPTURE)
+      static bool capture;          // the timer capture measure the period, no interrupt
+    #endif
+
   public: /** Public Function */
 
     static void init();
@@ -30,3 +30,11 @@
 #if ENABLED(FLOWMETER_SENSOR) && !PIN_EXISTS(FLOWMETER)
   #error "DEPENDENCY ERROR: You have to set FLOWMETER_PIN to a valid pin if you enable FLOWMETER_SENSOR."
 #endif
+
+#if ENABLED(FLOWMETER_CAPTURE)
+  #if DISABLED(FLOWMETER_SENSOR)
+    #error "DEPENDENCY ERROR: FLOWMETER_CAPTURE requires FLOWMETER_SENSOR."
+  #elif DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_STM32)
+    #error "DEPENDENCY ERROR: FLOWMETER_CAPTURE is only available on Arduino DUE and STM32."
+  #endif
+#endif
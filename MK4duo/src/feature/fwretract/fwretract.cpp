@@ -68,6 +68,19 @@ void FWRetract::factory_parameters() {
   }
 }
 
+#if ENABLED(FWRETRACT_COMBINED)
+
+  /**
+   * Feedrate of a move of E with the Z lift, on the lift length: the time is the longest
+   * between E, at its feedrate, and Z, at its maximum feedrate
+   */
+  static feedrate_t combined_feedrate(const float hop, const float e_length, const feedrate_t e_feedrate) {
+    if (!hop) return e_feedrate;
+    return hop / MAX(ABS(e_length) / e_feedrate, hop / mechanics.data.max_feedrate_mm_s.z);
+  }
+
+#endif
+
 /**
  * Retract or recover according to firmware settings
  *
@@ -81,6 +94,9 @@ void FWRetract::factory_parameters() {
  *
  * Note: Auto-retract will apply the set Z hop in addition to any Z hop
  *       included in the G-code. Use M207 Z0 to to prevent double hop.
+ *
+ * With FWRETRACT_COMBINED the retract and the Z lift, or the lowering and
+ * the recover, are a single move, and there is no wait for the planner.
  */
 void FWRetract::retract(const bool retracting
   #if MAX_EXTRUDER > 1
@@ -108,41 +124,73 @@ void FWRetract::retract(const bool retracting
   // The current position will be the destination for E and Z moves
   mechanics.destination = mechanics.position;
 
-  if (retracting) {
-    // Retract by moving from a faux E position back to the current E position
-    mechanics.feedrate_mm_s = data.retract_feedrate_mm_s * unscale_fr;
-    current_retract[toolManager.extruder.active] = base_retract * unscale_e;
-    mechanics.prepare_move_to_destination();  // set_current_to_destination
-    planner.synchronize();                    // Wait for move to complete
-
-    // Is a Z hop set, and has the hop not yet been done?
-    if (data.retract_zlift > 0.01 && !current_hop) {  // Apply hop only once
-      current_hop += data.retract_zlift;              // Add to the hop total (again, only once)
-      mechanics.feedrate_mm_s = mechanics.data.max_feedrate_mm_s.z * unscale_fr; // Maximum Z feedrate
-      mechanics.prepare_move_to_destination();        // Raise up, set_current_to_destination
-      planner.synchronize();                          // Wait for move to complete
+  #if ENABLED(FWRETRACT_COMBINED)
+
+    if (retracting) {
+      // Retract and lift in one move, from a faux E and Z position back to the current position
+      current_retract[toolManager.extruder.active] = base_retract * unscale_e;
+      const float hop = (data.retract_zlift > 0.01 && !current_hop) ? data.retract_zlift : 0.0f;  // Apply hop only once
+      current_hop += hop;
+      mechanics.feedrate_mm_s = combined_feedrate(hop, current_retract[toolManager.extruder.active], data.retract_feedrate_mm_s) * unscale_fr;
+      mechanics.prepare_move_to_destination();
     }
-  }
-  else {
-    // If a hop was done and Z hasn't changed, undo the Z hop
-    if (current_hop) {
+    else {
+      const float extra_recover = swapping ? data.swap_retract_recover_length : data.retract_recover_length;
+      if (extra_recover != 0.0) {
+        mechanics.position.e -= extra_recover;  // Adjust the current E position by the extra amount to recover
+        mechanics.sync_plan_position_e();       // Sync the planner position so the extra amount is recovered
+      }
+
+      // Lower and recover in one move
+      const float hop = current_hop,
+                  recover = current_retract[toolManager.extruder.active] + extra_recover;
       current_hop = 0.0;
-      mechanics.feedrate_mm_s = mechanics.data.max_feedrate_mm_s.z * unscale_fr; // Z feedrate to max
-      mechanics.prepare_move_to_destination();        // Lower Z and update position.x
-      planner.synchronize();                          // Wait for move to complete
+      current_retract[toolManager.extruder.active] = 0.0;
+      mechanics.feedrate_mm_s = combined_feedrate(hop, recover,
+        swapping ? data.swap_retract_recover_feedrate_mm_s : data.retract_recover_feedrate_mm_s
+      ) * unscale_fr;
+      mechanics.prepare_move_to_destination();
     }
 
-    const float extra_recover = swapping ? data.swap_retract_recover_length : data.retract_recover_length;
-    if (extra_recover != 0.0) {
-      mechanics.position.e -= extra_recover;  // Adjust the current E position by the extra amount to recover
-      mechanics.sync_plan_position_e();               // Sync the planner position so the extra amount is recovered
+  #else
+
+    if (retracting) {
+      // Retract by moving from a faux E position back to the current E position
+      mechanics.feedrate_mm_s = data.retract_feedrate_mm_s * unscale_fr;
+      current_retract[toolManager.extruder.active] = base_retract * unscale_e;
+      mechanics.prepare_move_to_destination();  // set_current_to_destination
+      planner.synchronize();                    // Wait for move to complete
+
+      // Is a Z hop set, and has the hop not yet been done?
+      if (data.retract_zlift > 0.01 && !current_hop) {  // Apply hop only once
+        current_hop += data.retract_zlift;              // Add to the hop total (again, only once)
+        mechanics.feedrate_mm_s = mechanics.data.max_feedrate_mm_s.z * unscale_fr; // Maximum Z feedrate
+        mechanics.prepare_move_to_destination();        // Raise up, set_current_to_destination
+        planner.synchronize();                          // Wait for move to complete
+      }
+    }
+    else {
+      // If a hop was done and Z hasn't changed, undo the Z hop
+      if (current_hop) {
+        current_hop = 0.0;
+        mechanics.feedrate_mm_s = mechanics.data.max_feedrate_mm_s.z * unscale_fr; // Z feedrate to max
+        mechanics.prepare_move_to_destination();        // Lower Z and update position.x
+        planner.synchronize();                          // Wait for move to complete
+      }
+
+      const float extra_recover = swapping ? data.swap_retract_recover_length : data.retract_recover_length;
+      if (extra_recover != 0.0) {
+        mechanics.position.e -= extra_recover;  // Adjust the current E position by the extra amount to recover
+        mechanics.sync_plan_position_e();               // Sync the planner position so the extra amount is recovered
+      }
+
+      current_retract[toolManager.extruder.active] = 0.0;
+      mechanics.feedrate_mm_s = (swapping ? data.swap_retract_recover_feedrate_mm_s : data.retract_recover_feedrate_mm_s) * unscale_fr;
+      mechanics.prepare_move_to_destination();          // Recover E, set_current_to_destination
+      planner.synchronize();                            // Wait for move to complete
     }
 
-    current_retract[toolManager.extruder.active] = 0.0;
-    mechanics.feedrate_mm_s = (swapping ? data.swap_retract_recover_feedrate_mm_s : data.retract_recover_feedrate_mm_s) * unscale_fr;
-    mechanics.prepare_move_to_destination();          // Recover E, set_current_to_destination
-    planner.synchronize();                            // Wait for move to complete
-  }
+  #endif // !FWRETRACT_COMBINED
 
   mechanics.feedrate_mm_s = old_feedrate_mm_s;        // Restore original feedrate
   retracted[toolManager.extruder.active] = retracting; // Active extruder now retracted / recovered
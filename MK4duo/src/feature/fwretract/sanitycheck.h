@@ -60,3 +60,7 @@
     #error "DEPENDENCY ERROR: Missing setting RETRACT_RECOVER_FEEDRATE_SWAP."
   #endif
 #endif
+
+#if ENABLED(FWRETRACT_COMBINED) && DISABLED(FWRETRACT)
+  #error "DEPENDENCY ERROR: FWRETRACT_COMBINED requires FWRETRACT."
+#endif
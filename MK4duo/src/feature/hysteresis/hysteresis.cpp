@@ -30,11 +30,15 @@ Hysteresis hysteresis;
 /** Public Parameters */
 hysteresis_data_t Hysteresis::data;
 
+/** Private Parameters */
+float Hysteresis::residual[XYZ] = { 0.0f };
+
 /** Public Function */
 void Hysteresis::factory_parameters() {
   constexpr float tmp[] = HYSTERESIS_AXIS_MM;
   LOOP_XYZ(i) data.mm[i] = tmp[i];
   data.correction = HYSTERESIS_CORRECTION;
+  data.smoothing_mm = HYSTERESIS_SMOOTHING_MM;
 }
 
 void Hysteresis::add_correction_step(block_t * const block) {
@@ -47,16 +51,36 @@ void Hysteresis::add_correction_step(block_t * const block) {
 
   last_direction_bits ^= direction_change_bits;
 
-  if (data.correction == 0.0f || !direction_change_bits) return;
+  if (data.correction == 0.0f) return;
 
-  LOOP_XYZ(axis) {
-    if (data.mm[axis]) {
-      // When an axis changes direction, add axis hysteresis
-      if (TEST(direction_change_bits, axis)) {
-        const uint32_t fix = data.correction * data.mm[axis] * mechanics.data.axis_steps_per_mm[axis];
-        block->steps[axis] += fix;
+  if (data.smoothing_mm <= 0.0f) {
+    if (!direction_change_bits) return;
+    LOOP_XYZ(axis) {
+      if (data.mm[axis]) {
+        // When an axis changes direction, add axis hysteresis
+        if (TEST(direction_change_bits, axis)) {
+          const uint32_t fix = data.correction * data.mm[axis] * mechanics.data.axis_steps_per_mm[axis];
+          block->steps[axis] += fix;
+        }
       }
     }
+    return;
+  }
+
+  /**
+   * Smoothing: at a change of direction the residual becomes the part of the gap
+   * taken up on the old side, the correction less what was still to do there.
+   * Each block moving the axis takes its share of the correction, the length of the
+   * block on the smoothing distance, and the Bresenham steps spread it along the block.
+   */
+  LOOP_XYZ(axis) {
+    if (!data.mm[axis]) continue;
+    const float fix = data.correction * data.mm[axis] * mechanics.data.axis_steps_per_mm[axis];
+    if (TEST(direction_change_bits, axis)) residual[axis] = MAX(fix - residual[axis], 0.0f);
+    if (!residual[axis] || !block->steps[axis]) continue;
+    const float before = residual[axis];
+    residual[axis] = MAX(before - fix * block->millimeters / data.smoothing_mm, 0.0f);
+    block->steps[axis] += LROUND(before) - LROUND(residual[axis]);
   }
 }
 
@@ -66,6 +90,7 @@ void Hysteresis::print_M99() {
   SERIAL_MV(" Y", data.mm[Y_AXIS]);
   SERIAL_MV(" Z", data.mm[Z_AXIS]);
   SERIAL_MV(" F", data.correction);
+  SERIAL_MV(" S", data.smoothing_mm);
   SERIAL_EOL();
 }
 
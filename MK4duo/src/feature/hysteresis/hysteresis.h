@@ -26,7 +26,8 @@
 // Struct Hysteresis data
 typedef struct {
   float mm[XYZ],
-        correction;
+        correction,
+        smoothing_mm;
 } hysteresis_data_t;
 
 class Hysteresis {
@@ -39,6 +40,10 @@ class Hysteresis {
 
     static hysteresis_data_t data;
 
+  private: /** Private Parameters */
+
+    static float residual[XYZ];   // Steps of the correction still to do, with smoothing
+
   public: /** Public Function */
 
     static void factory_parameters();
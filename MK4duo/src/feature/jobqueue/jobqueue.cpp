@@ -0,0 +1,182 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * jobqueue.cpp
+ *
+ * The queue file has one path from the root for each line,
+ * the first line is the job printing or the next to print.
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(SD_JOB_QUEUE)
+
+JobQueue jobqueue;
+
+/** Public Parameters */
+SdFile JobQueue::queue_file;
+
+/** Private Parameters */
+char JobQueue::next_job[MAX_PATH_NAME_LENGHT] = { '\0' };
+
+bool  JobQueue::job_ended     = false,
+      JobQueue::start_pending = false;
+
+/** Public Function */
+void JobQueue::add(const char * path) {
+  while (*path == '/') path++;
+  if (!*path || strlen(path) >= MAX_PATH_NAME_LENGHT) return;
+
+  if (!file_exists(path)) {
+    SERIAL_LMT(ER, "Job queue, file not found: ", path);
+    return;
+  }
+
+  if (!card.open_jobqueue_file(queue_file, O_WRITE | O_CREAT | O_APPEND)) {
+    SERIAL_LM(ER, "Job queue, write failed");
+    return;
+  }
+  queue_file.write(path);
+  queue_file.write("\n");
+  queue_file.close();
+  SERIAL_LMT(ECHO, "Job queued: ", path);
+}
+
+void JobQueue::list() {
+  char name[MAX_PATH_NAME_LENGHT];
+  uint8_t n = 0;
+  SERIAL_EM("Job queue:");
+  while (n < 255 && read_job(n + 1, name)) {
+    SERIAL_MV(" ", int(++n));
+    SERIAL_EMT(": ", name);
+  }
+  if (!n) SERIAL_EM(" empty");
+}
+
+void JobQueue::remove(const uint8_t index) {
+
+  if (!index) {
+    // All of them
+    start_pending = job_ended = false;
+    card.delete_jobqueue_file();
+    SERIAL_LM(ECHO, "Job queue cleared");
+    return;
+  }
+
+  SdFile new_file;
+  if (!card.open_jobqueue_file(queue_file, O_READ)) return;
+  if (!card.open_jobqueue_file(new_file, O_RDWR | O_CREAT | O_TRUNC, true)) {
+    queue_file.close();
+    SERIAL_LM(ER, "Job queue, write failed");
+    return;
+  }
+
+  // All the lines up to the end, but the removed one
+  char name[MAX_PATH_NAME_LENGHT];
+  bool found = false;
+  int16_t len;
+  for (uint8_t n = 1; (len = queue_file.fgets(name, sizeof(name))) > 0; n++) {
+    if (n == index) { found = true; continue; }
+    new_file.write(name);
+    if (name[len - 1] != '\n') new_file.write("\n");
+  }
+  queue_file.close();
+  new_file.close();
+
+  if (found) card.replace_jobqueue_file();
+  else SERIAL_LMV(ER, "Job queue, no job ", int(index));
+}
+
+void JobQueue::start() {
+  if (IS_SD_PRINTING() || card.isFileOpen() || print_job_counter.isRunning()) {
+    SERIAL_LM(ER, "Job queue, a job is running");
+    return;
+  }
+  if (!read_job(1, next_job)) {
+    SERIAL_LM(ECHO, "Job queue empty");
+    return;
+  }
+  card.openAndPrintFile(next_job);
+}
+
+void JobQueue::prepare_next() {
+  char name[MAX_PATH_NAME_LENGHT];
+  const char * printed = card.fileName;
+  while (*printed == '/') printed++;
+
+  next_job[0] = '\0';
+  job_ended = read_job(1, name) && !strcasecmp(name, printed);
+
+  // A missing file is dropped here, not at the start with the printer waiting
+  if (job_ended) {
+    while (read_job(2, next_job) && !file_exists(next_job)) {
+      SERIAL_LMT(ER, "Job queue, file not found: ", next_job);
+      remove(2);
+      next_job[0] = '\0';
+    }
+  }
+}
+
+bool JobQueue::print_finished() {
+  if (!job_ended) return false;
+  job_ended = false;
+  remove(1);
+  if (!next_job[0]) {
+    SERIAL_LM(ECHO, "Job queue done");
+    return false;
+  }
+  start_pending = true;
+  return true;
+}
+
+void JobQueue::spin() {
+  // The last lines of the job and its end commands run first
+  if (!start_pending || commands.buffer_ring.count() || IS_SD_PRINTING() || planner.has_blocks_queued()) return;
+  start_pending = false;
+  SERIAL_LMT(ECHO, "Job queue, next: ", next_job);
+  commands.enqueue_now_P(PSTR(SD_JOB_QUEUE_SCRIPT));
+  card.openAndPrintFile(next_job);
+}
+
+/** Private Function */
+bool JobQueue::read_job(const uint8_t index, char * const name) {
+  name[0] = '\0';
+  if (!card.open_jobqueue_file(queue_file, O_READ)) return false;
+  int16_t len = 0;
+  for (uint8_t n = 0; n < index; n++)
+    if ((len = queue_file.fgets(name, MAX_PATH_NAME_LENGHT)) <= 0) break;
+  queue_file.close();
+  if (len <= 0) { name[0] = '\0'; return false; }
+  if (name[len - 1] == '\n') name[len - 1] = '\0';
+  return name[0] != '\0';
+}
+
+bool JobQueue::file_exists(const char * const name) {
+  SdFile file;
+  const bool exists = file.open(&card.root, name, O_READ);
+  if (exists) file.close();
+  return exists;
+}
+
+#endif // ENABLED(SD_JOB_QUEUE)
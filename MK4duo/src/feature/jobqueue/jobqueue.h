@@ -0,0 +1,79 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * jobqueue.h
+ *
+ * SD jobs printed one after the other, from a queue file on the card
+ */
+
+#if ENABLED(SD_JOB_QUEUE)
+
+class JobQueue {
+
+  public: /** Constructor */
+
+    JobQueue() {}
+
+  public: /** Public Parameters */
+
+    static SdFile queue_file;
+
+  private: /** Private Parameters */
+
+    static char next_job[MAX_PATH_NAME_LENGHT];   // The job after the one printing, ready at its end
+
+    static bool job_ended,                        // The printed file was the first of the queue
+                start_pending;                    // Start next_job when the commands are done
+
+  public: /** Public Function */
+
+    static void add(const char * path);
+    static void list();
+    static void remove(const uint8_t index);
+    static void start();
+
+    /**
+     * At the end of the file, while the last moves run:
+     * check that it is the first job and get the next one
+     */
+    static void prepare_next();
+
+    /**
+     * After the end of the print: drop the first job and
+     * start the next once the queue of the commands is empty
+     */
+    static bool print_finished();
+
+    static void spin();
+
+  private: /** Private Function */
+
+    static bool read_job(const uint8_t index, char * const name);
+    static bool file_exists(const char * const name);
+
+};
+
+extern JobQueue jobqueue;
+
+#endif // ENABLED(SD_JOB_QUEUE)
@@ -77,6 +77,17 @@
 
     uint8_t       Laser::raster_direction     = 0;
 
+    unsigned char Laser::raster_pool[LASER_RASTER_POOL_SIZE];
+
+    static uint16_t raster_pool_head = 0;   // First byte after the newest pixels
+
+    #if ENABLED(LASER_RASTER_BINARY)
+      uint8_t     Laser::raster_stream[BUFSIZE + 1][LASER_MAX_RASTER_LINE],
+                  Laser::raster_stream_len[BUFSIZE + 1],
+                  Laser::raster_stream_head   = 0,
+                  Laser::raster_stream_tail   = 0;
+    #endif
+
   #endif
 
   void Laser::init() {
@@ -167,6 +178,59 @@
     }
   }
 
+  #if ENABLED(LASER_RASTER)
+
+    /**
+     * Room for len pixels, in one piece, in the pool. The pixels in use are the ones
+     * from the oldest queued raster block to the head, blocks are freed in order.
+     * Wait for the stepper to free blocks if there is no room.
+     */
+    uint16_t Laser::raster_pool_take(const uint16_t len) {
+      for (;;) {
+        bool      used = false;
+        uint16_t  tail = 0;
+        for (uint8_t b = planner.block_buffer_tail; b != planner.block_buffer_head; b = BLOCK_MOD(b + 1)) {
+          const block_t * const block = &planner.block_buffer[b];
+          if (block->laser_raster_len) { tail = block->laser_raster_index; used = true; break; }
+        }
+
+        if (!used) raster_pool_head = 0;
+
+        uint16_t index = raster_pool_head;
+        bool room;
+        if (!used || raster_pool_head >= tail) {
+          room = (LASER_RASTER_POOL_SIZE) - raster_pool_head >= len;
+          if (!room && tail > len) { index = 0; room = true; }   // Wrap to the start
+        }
+        else
+          room = tail - raster_pool_head > len;
+
+        if (room) {
+          raster_pool_head = index + len;
+          return index;
+        }
+
+        printer.idle();
+      }
+    }
+
+  #endif
+
+  #if ENABLED(LASER_RASTER_BINARY)
+
+    /**
+     * The line of the running G7 B in raster_data, false if none was received
+     */
+    bool Laser::raster_stream_pop() {
+      if (raster_stream_head == raster_stream_tail) return false;
+      raster_num_pixels = raster_stream_len[raster_stream_tail];
+      memcpy(raster_data, raster_stream[raster_stream_tail], raster_num_pixels);
+      raster_stream_tail = (raster_stream_tail + 1) % (BUFSIZE + 1);
+      return true;
+    }
+
+  #endif
+
   #if ENABLED(LASER_PERIPHERALS)
     bool Laser::peripherals_ok() { return !HAL::digitalRead(LASER_PERIPHERALS_STATUS_PIN); }
 
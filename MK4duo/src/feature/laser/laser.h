@@ -77,6 +77,15 @@
 
         static uint8_t        raster_direction;
 
+        static unsigned char  raster_pool[LASER_RASTER_POOL_SIZE];  // Pixels of the queued blocks
+
+        #if ENABLED(LASER_RASTER_BINARY)
+          // Lines of the queued G7 B, one more than the commands in the buffer
+          static uint8_t      raster_stream[BUFSIZE + 1][LASER_MAX_RASTER_LINE],
+                              raster_stream_len[BUFSIZE + 1],
+                              raster_stream_head, raster_stream_tail;
+        #endif
+
       #endif
 
     public: /** Public Function */
@@ -86,6 +95,20 @@
       static void extinguish();
       static void set_mode(uint8_t mode);
 
+      #if ENABLED(LASER_RASTER)
+        static uint16_t raster_pool_take(const uint16_t len);
+      #endif
+
+      #if ENABLED(LASER_RASTER_BINARY)
+        static inline uint8_t* raster_stream_slot() { return raster_stream[raster_stream_head]; }
+        static inline void raster_stream_push(const uint8_t len) {
+          raster_stream_len[raster_stream_head] = len;
+          raster_stream_head = (raster_stream_head + 1) % (BUFSIZE + 1);
+        }
+        static inline void raster_stream_clear() { raster_stream_head = raster_stream_tail = 0; }
+        static bool raster_stream_pop();
+      #endif
+
       #if ENABLED(LASER_PERIPHERALS)
         static bool peripherals_ok();
         static void peripherals_on();
@@ -36,6 +36,18 @@
       #error "DEPENDENCY ERROR: You have to set LASER_PERIPHERALS_STATUS_PIN to a valid pin if you enable LASER_PERIPHERALS."
     #endif
   #endif
+  #if ENABLED(LASER_RASTER)
+    #if DISABLED(LASER_RASTER_POOL_SIZE)
+      #error "DEPENDENCY ERROR: Missing setting LASER_RASTER_POOL_SIZE."
+    #elif LASER_RASTER_POOL_SIZE <= 2 * (LASER_MAX_RASTER_LINE) || LASER_RASTER_POOL_SIZE > 32768
+      #error "DEPENDENCY ERROR: LASER_RASTER_POOL_SIZE must be over 2 * LASER_MAX_RASTER_LINE and at most 32768."
+    #endif
+    #if ENABLED(LASER_RASTER_BINARY) && LASER_MAX_RASTER_LINE > 255
+      #error "DEPENDENCY ERROR: LASER_RASTER_BINARY requires LASER_MAX_RASTER_LINE of 255 or less."
+    #endif
+  #elif ENABLED(LASER_RASTER_BINARY)
+    #error "DEPENDENCY ERROR: LASER_RASTER_BINARY requires LASER_RASTER."
+  #endif
   #if (DISABLED(LASER_CONTROL) || ((LASER_CONTROL != 1) && (LASER_CONTROL != 2)))
      #error "DEPENDENCY ERROR: You have to set LASER_CONTROL to 1 or 2."
   #else
@@ -42,25 +42,26 @@ float Mixer::collector[MIXING_STEPPERS]; // mix proportion. 0.0 = off, otherwise
 
   gradient_t Mixer::gradient = {
     false,        // enabled
+    -1,           // slice
     { 0 },        // color (array)
+    { { 0 } },    // table (array)
     0, 0,         // start_z, end_z
     0, 1,         // start_vtool, end_vtool
     { 0 }, { 0 }  // start_mix, end_mix (array)
   };
 
-  float Mixer::prev_z = 0;
-
 #endif
 
 /** Private Parameters */
 // Used up to Planner level
 uint_fast8_t  Mixer::selected_vtool = 0;
-mixer_color_t Mixer::color[MIXING_VIRTUAL_TOOLS][MIXING_STEPPERS];
+mixer_color_t   Mixer::color[MIXING_VIRTUAL_TOOLS][MIXING_STEPPERS];
+mixer_weight_t  Mixer::weight[MIXING_STEPPERS] = { MIXER_WEIGHT_TOTAL };
 
 // Used in Stepper
-int_fast8_t   Mixer::runner = 0;
-mixer_color_t Mixer::s_color[MIXING_STEPPERS];
-mixer_accu_t  Mixer::accu[MIXING_STEPPERS] = { 0 };
+int_fast8_t     Mixer::runner = 0;
+mixer_weight_t  Mixer::s_weight[MIXING_STEPPERS] = { MIXER_WEIGHT_TOTAL };
+mixer_accu_t    Mixer::accu[MIXING_STEPPERS] = { 0 };
 
 void Mixer::normalize(const uint8_t tool_index) {
   float cmax = 0;
@@ -108,6 +109,8 @@ void Mixer::normalize(const uint8_t tool_index) {
 
   #if HAS_GRADIENT_MIX
     refresh_gradient();
+  #else
+    update_weight();
   #endif
 
 }
@@ -125,6 +128,8 @@ void Mixer::reset_vtools() {
       MIXING_STEPPER_LOOP(i)
         color[t][i] = (i == 0) ? COLOR_A_MASK : 0;
   #endif
+
+  update_weight();
 }
 
 // called at boot
@@ -148,23 +153,59 @@ void Mixer::refresh_collector(const float proportion/*=1.0*/, const uint8_t t/*=
   MIXING_STEPPER_LOOP(i) collector[i] = color[t][i] * inv_prop;
 }
 
-#if HAS_GRADIENT_MIX
+/**
+ * Integer step weights of the current color for the next blocks,
+ * the rounding goes to the largest so they sum to MIXER_WEIGHT_TOTAL
+ */
+void Mixer::update_weight() {
+  const mixer_color_t* const c =
+    #if HAS_GRADIENT_MIX
+      gradient.enabled ? gradient.color :
+    #endif
+    color[selected_vtool];
 
-  void Mixer::update_gradient_for_z(const float z) {
-    if (z == prev_z) return;
-    prev_z = z;
+  uint32_t csum = 0;
+  uint8_t cmax = 0;
+  MIXING_STEPPER_LOOP(i) {
+    csum += c[i];
+    if (c[i] > c[cmax]) cmax = i;
+  }
 
-    const float slice = gradient.end_z - gradient.start_z;
+  mixer_weight_t wsum = 0;
+  MIXING_STEPPER_LOOP(i) {
+    weight[i] = csum ? mixer_weight_t((uint32_t(c[i]) * (MIXER_WEIGHT_TOTAL)) / csum) : 0;
+    wsum += weight[i];
+  }
+  weight[cmax] += MIXER_WEIGHT_TOTAL - wsum;
+}
 
-    float pct = float(z - gradient.start_z) / slice;
-    NOLESS(pct, 0.0f); NOMORE(pct, 1.0f);
+#if HAS_GRADIENT_MIX
 
-    MIXING_STEPPER_LOOP(i) {
-      const mixer_perc_t sm = gradient.start_mix[i];
-      mix[i] = sm + (gradient.end_mix[i] - sm) * pct;
+  /**
+   * The color of every slice from start to end Z, called when the gradient changes
+   */
+  void Mixer::fill_gradient_table() {
+    for (uint8_t s = 0; s <= MIXING_GRADIENT_STEPS; s++) {
+      const float pct = float(s) / float(MIXING_GRADIENT_STEPS);
+      MIXING_STEPPER_LOOP(i) {
+        const mixer_perc_t sm = gradient.start_mix[i];
+        mix[i] = sm + (gradient.end_mix[i] - sm) * pct;
+      }
+      copy_mix_to_color(gradient.table[s]);
     }
+  }
+
+  void Mixer::update_gradient_for_z(const float z) {
+    if (!gradient.enabled) return;
+
+    const float pct = (z - gradient.start_z) / (gradient.end_z - gradient.start_z);
+    const int8_t slice = pct <= 0.0f ? 0 : pct >= 1.0f ? MIXING_GRADIENT_STEPS : int8_t(pct * (MIXING_GRADIENT_STEPS) + 0.5f);
+    if (slice == gradient.slice) return;
+    gradient.slice = slice;
 
-    copy_mix_to_color(gradient.color);
+    MIXING_STEPPER_LOOP(i) gradient.color[i] = gradient.table[slice][i];
+    update_mix_from_gradient();
+    update_weight();
   }
 
   void Mixer::update_gradient_for_planner_z() {
@@ -32,14 +32,14 @@
 //#define MIXING_DEBUG
 
 #ifdef __AVR__
-  #define MIXER_ACCU_SIGNED
   #define COLOR_A_MASK  0x80
-  #define COLOR_MASK    0x7F
 #else
   #define COLOR_A_MASK  0x8000
-  #define COLOR_MASK    0x7FFF
 #endif
 
+// Sum of the step weights of a block
+#define MIXER_WEIGHT_TOTAL  1024
+
 #define MIXING_STEPPER_LOOP(VAR) \
   for (uint8_t VAR = 0; VAR < MIXING_STEPPERS; VAR++)
 
@@ -47,7 +47,9 @@
 
   typedef struct {
     bool          enabled;                    // This gradient is enabled
+    int8_t        slice;                      // Slice of the current color, -1 for none
     mixer_color_t color[MIXING_STEPPERS];     // The current gradient color
+    mixer_color_t table[MIXING_GRADIENT_STEPS + 1][MIXING_STEPPERS]; // The color of every slice
     float         start_z, end_z;             // Region for gradient
     int8_t        start_vtool, end_vtool;     // Start and end virtual tools
     mixer_perc_t  start_mix[MIXING_STEPPERS], // Start and end mixes from those tools
@@ -69,7 +71,6 @@ class Mixer {
     #if HAS_GRADIENT_MIX
       static mixer_perc_t mix[MIXING_STEPPERS]; // Scratch array for the Mix in proportion to 100
       static gradient_t gradient;
-      static float prev_z;
     #endif
 
   private: /** Private Parameters */
@@ -77,10 +78,11 @@ class Mixer {
     // Used up to Planner level
     static uint_fast8_t   selected_vtool;
     static mixer_color_t  color[MIXING_VIRTUAL_TOOLS][MIXING_STEPPERS];
+    static mixer_weight_t weight[MIXING_STEPPERS];  // Step weights of the current mix for the blocks
 
     // Used in Stepper
     static int_fast8_t    runner;
-    static mixer_color_t  s_color[MIXING_STEPPERS];
+    static mixer_weight_t s_weight[MIXING_STEPPERS];
     static mixer_accu_t   accu[MIXING_STEPPERS];
 
   public: /** Public Function */
@@ -90,6 +92,8 @@ class Mixer {
     static void reset_vtools();
     static void refresh_collector(const float proportion=1.0, const uint8_t t=selected_vtool);
 
+    static void update_weight();
+
     // Used up to Planner level
     FORCE_INLINE static void set_collector(const uint8_t c, const float f) { collector[c] = MAX(f, 0.0f); }
 
@@ -103,21 +107,16 @@ class Mixer {
       #if HAS_GRADIENT_MIX
         update_mix_from_vtool();
       #endif
+      update_weight();
     }
 
     // Used when dealing with blocks
-    FORCE_INLINE static void populate_block(mixer_color_t b_color[MIXING_STEPPERS]) {
-      #if HAS_GRADIENT_MIX
-        if (gradient.enabled) {
-          MIXING_STEPPER_LOOP(i) b_color[i] = gradient.color[i];
-          return;
-        }
-      #endif
-      MIXING_STEPPER_LOOP(i) b_color[i] = color[selected_vtool][i];
+    FORCE_INLINE static void populate_block(mixer_weight_t b_weight[MIXING_STEPPERS]) {
+      MIXING_STEPPER_LOOP(i) b_weight[i] = weight[i];
     }
 
-    FORCE_INLINE static void stepper_setup(mixer_color_t b_color[MIXING_STEPPERS]) {
-      MIXING_STEPPER_LOOP(i) s_color[i] = b_color[i];
+    FORCE_INLINE static void stepper_setup(const mixer_weight_t b_weight[MIXING_STEPPERS]) {
+      MIXING_STEPPER_LOOP(i) s_weight[i] = b_weight[i];
     }
 
     #if HAS_GRADIENT_MIX
@@ -143,6 +142,7 @@ class Mixer {
         refresh_gradient();
       }
 
+      static void fill_gradient_table();
       static void update_gradient_for_z(const float z);
       static void update_gradient_for_planner_z();
       static inline void gradient_control(const float z) {
@@ -170,31 +170,35 @@ class Mixer {
           COPY_ARRAY(gradient.start_mix, mix);
           update_mix_from_vtool(gradient.end_vtool);
           COPY_ARRAY(gradient.end_mix, mix);
+          fill_gradient_table();
+          gradient.slice = -1;
           update_gradient_for_planner_z();
           COPY_ARRAY(mix, mix_bak);
-          prev_z = -1;
         }
+        update_weight();
       }
 
     #endif // HAS_GRADIENT_MIX
 
     // Used in Stepper
     FORCE_INLINE static uint8_t get_stepper() { return runner; }
+
+    /**
+     * Bresenham over the mixing steppers with the integer weights of the block.
+     * Every E step adds the weights to the accumulators and the stepper with
+     * the highest one takes the step and gives back MIXER_WEIGHT_TOTAL, so the
+     * accumulators sum to zero and each stepper gets its share of the steps
+     * within one step. The work is the same for any mix.
+     */
     FORCE_INLINE static uint8_t get_next_stepper() {
-      for (;;) {
-        if (--runner < 0) runner = MIXING_STEPPERS - 1;
-        accu[runner] += s_color[runner];
-        if (
-          #ifdef MIXER_ACCU_SIGNED
-            accu[runner] < 0
-          #else
-            accu[runner] & COLOR_A_MASK
-          #endif
-        ) {
-          accu[runner] &= COLOR_MASK;
-          return runner;
-        }
+      uint8_t next = 0;
+      MIXING_STEPPER_LOOP(i) {
+        accu[i] += s_weight[i];
+        if (accu[i] > accu[next]) next = i;
       }
+      accu[next] -= MIXER_WEIGHT_TOTAL;
+      runner = next;
+      return next;
     }
 
 };
@@ -34,6 +34,9 @@
   #if MIXING_STEPPERS < 2
     #error "DEPENDENCY ERROR: You must set MIXING_STEPPERS >= 2 for a mixing extruder."
   #endif
+  #if HAS_GRADIENT_MIX && (DISABLED(MIXING_GRADIENT_STEPS) || !WITHIN(MIXING_GRADIENT_STEPS, 1, 100))
+    #error "DEPENDENCY ERROR: MIXING_GRADIENT_STEPS must be between 1 and 100."
+  #endif
   #if ENABLED(FILAMENT_WIDTH_SENSOR)
     #error "DEPENDENCY ERROR: COLOR_MIXING_EXTRUDER is incompatible with FILAMENT_WIDTH_SENSOR. Comment out this line to use it anyway."
   #endif
@@ -82,6 +82,13 @@ int16_t MMU2::version = -1, MMU2::buildnr = -1;
 short_timer_t MMU2::last_request_timer, MMU2::next_P0_request_timer;
 char MMU2::rx_buffer[16], MMU2::tx_buffer[16];
 
+#if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+  uint8_t MMU2::tc_state = MMU2_TC_IDLE, MMU2::tc_index = 0;
+  bool MMU2::tc_waiting = false;
+  short_timer_t MMU2::lookahead_timer;
+  #define MMU2_LOOKAHEAD_MS 100
+#endif
+
 #if HAS_LCD_MENU
 
   struct E_Step {
@@ -110,6 +117,12 @@ void MMU2::init() {
   mmuSerial.begin(MMU_BAUD);
   extruder = MMU2_NO_TOOL;
 
+  #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+    tc_state = MMU2_TC_IDLE;
+    tc_waiting = false;
+    lookahead_timer.start();
+  #endif
+
   HAL::delayMilliseconds(10);
   reset();
   rx_buffer[0] = '\0';
@@ -368,6 +381,18 @@ void MMU2::mmu_loop() {
       }
       break;
   }
+
+  #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+    if (enabled) {
+      if (tc_state != MMU2_TC_IDLE)
+        tool_change_spin();
+      else if (printer.isPrinting() && lookahead_timer.expired(MMU2_LOOKAHEAD_MS)) {
+        // Prefetch, a T in the command queue with no extrusion before it
+        const uint8_t index = next_queued_tool();
+        if (index != MMU2_NO_TOOL && index != extruder) start_tool_change(index);
+      }
+    }
+  #endif
 }
 
 /**
@@ -487,6 +512,16 @@ void MMU2::tool_change(uint8_t index) {
 
   if (!enabled) return;
 
+  #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+
+    // Already started by the lookahead
+    if (tc_state != MMU2_TC_IDLE && tc_index == index) return;
+
+    wait_tool_change();
+    if (index != extruder) start_tool_change(index);
+
+  #else
+
   set_runout_valid(false);
 
   if (index != extruder) {
@@ -510,6 +545,8 @@ void MMU2::tool_change(uint8_t index) {
   }
 
   set_runout_valid(true);
+
+  #endif // !MMU2_ASYNC_TOOL_CHANGE
 }
 
 /**
@@ -525,6 +562,10 @@ void MMU2::tool_change(const char* special) {
 
   if (!enabled) return;
 
+  #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+    wait_tool_change();
+  #endif
+
   #if HAS_LCD_MENU
 
     set_runout_valid(false);
@@ -562,6 +603,110 @@ void MMU2::tool_change(const char* special) {
 
 }
 
+#if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+
+  /**
+   * Wait for the tool change in progress, if any
+   */
+  void MMU2::wait_tool_change() {
+    if (tc_state == MMU2_TC_IDLE || tc_waiting) return;
+    tc_waiting = true;
+    while (tc_state == MMU2_TC_WAIT_E) printer.idle();
+    if (tc_state == MMU2_TC_SWAP) {
+      manage_response(true, true);
+      tool_change_done();
+    }
+    tc_waiting = false;
+  }
+
+  void MMU2::start_tool_change(const uint8_t index) {
+    set_runout_valid(false);
+    tc_index = index;
+    tc_state = MMU2_TC_WAIT_E;
+    tool_change_spin();
+  }
+
+  /**
+   * Step of the tool change, called by mmu_loop()
+   */
+  void MMU2::tool_change_spin() {
+    switch (tc_state) {
+      case MMU2_TC_WAIT_E:
+        // The old filament must stay at the gears until its moves are done
+        if (state != 1 || cmd != MMU_CMD_NONE || e_moves_queued()) break;
+        stepper.disable_E(0);
+        lcdui.status_printf_P(0, GET_TEXT(MSG_MMU2_LOADING_FILAMENT), int(tc_index + 1));
+        tc_state = MMU2_TC_SWAP;
+        command(MMU_CMD_T0 + tc_index);
+        break;
+      case MMU2_TC_SWAP:
+        if (tc_waiting || !ready) break;
+        ready = false;
+        tool_change_done();
+        break;
+      default: break;
+    }
+  }
+
+  void MMU2::tool_change_done() {
+    command(MMU_CMD_C0);
+    extruder = tc_index; // filament change is finished
+    toolManager.extruder.active = 0;
+
+    stepper.enable_E(0);
+
+    SERIAL_LMV(ECHO, MSG_HOST_ACTIVE_EXTRUDER, int(extruder));
+
+    lcdui.reset_status();
+    set_runout_valid(true);
+    tc_state = MMU2_TC_IDLE;
+  }
+
+  /**
+   * Planner blocks with E steps
+   */
+  bool MMU2::e_moves_queued() {
+    for (uint8_t b = planner.block_buffer_tail; b != planner.block_buffer_head; b = BLOCK_MOD(b + 1)) {
+      const block_t * const block = &planner.block_buffer[b];
+      if (!TEST(block->flag, BLOCK_BIT_SYNC_POSITION) && block->steps.e) return true;
+    }
+    return false;
+  }
+
+  /**
+   * The tool of the next T in the command queue, MMU2_NO_TOOL
+   * if a command that may extrude or wait comes before it.
+   */
+  uint8_t MMU2::next_queued_tool() {
+    uint8_t index = commands.buffer_ring.head();
+    for (uint8_t n = commands.buffer_ring.count(); n--; index = (index + 1) % commands.buffer_ring.size()) {
+      const char *p = commands.buffer_ring.peek(index).gcode;
+      while (*p == ' ') p++;
+      if (*p == 'N') {
+        p++;
+        while (NUMERIC(*p)) p++;
+        while (*p == ' ') p++;
+      }
+      const char letter = *p++;
+      if (!NUMERIC(*p)) return MMU2_NO_TOOL;
+      const int code = atoi(p);
+      switch (letter) {
+        case 'T': return code < EXTRUDERS ? uint8_t(code) : MMU2_NO_TOOL;
+        case 'G':
+          if (code <= 3) { if (strchr(p, 'E')) return MMU2_NO_TOOL; }
+          else if (code != 4 && code != 92) return MMU2_NO_TOOL;
+          break;
+        case 'M':
+          if (code != 104 && code != 106 && code != 107 && code != 117 && code != 400) return MMU2_NO_TOOL;
+          break;
+        default: return MMU2_NO_TOOL;
+      }
+    }
+    return MMU2_NO_TOOL;
+  }
+
+#endif // MMU2_ASYNC_TOOL_CHANGE
+
 /**
  * Set next command
  */
@@ -662,6 +807,9 @@ void MMU2::manage_response(const bool move_axes, const bool turn_off_nozzle) {
 
 void MMU2::set_filament_type(uint8_t index, uint8_t filamentType) {
   if (!enabled) return;
+  #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+    wait_tool_change();
+  #endif
   cmd_arg = filamentType;
   command(MMU_CMD_F0 + index);
   manage_response(true, true);
@@ -684,6 +832,9 @@ void MMU2::set_runout_valid(const bool valid) {
   // Load filament into MMU2
   void MMU2::load_filament(uint8_t index) {
     if (!enabled) return;
+    #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+      wait_tool_change();
+    #endif
     command(MMU_CMD_L0 + index);
     manage_response(false, false);
     sound.playtone(200, 404);
@@ -698,6 +849,10 @@ void MMU2::set_runout_valid(const bool valid) {
 
     if (!enabled) return false;
 
+    #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+      wait_tool_change();
+    #endif
+
     if (tempManager.tooColdToExtrude(toolManager.active_hotend())) {
       sound.playtone(200, 404);
       LCD_ALERTMESSAGEPGM(MSG_HOTEND_TOO_COLD);
@@ -23,6 +23,14 @@
 
 struct E_Step;
 
+#if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+  enum MMU2ToolChangeEnum : uint8_t {
+    MMU2_TC_IDLE,
+    MMU2_TC_WAIT_E,   // The E moves of the old filament are in the planner
+    MMU2_TC_SWAP      // T sent, the MMU is swapping the filament
+  };
+#endif
+
 class MMU2 {
 
   public: /** Constructor */
@@ -40,6 +48,12 @@ class MMU2 {
     static short_timer_t last_request_timer, next_P0_request_timer;
     static char rx_buffer[16], tx_buffer[16];
 
+    #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+      static uint8_t tc_state, tc_index;
+      static bool tc_waiting;
+      static short_timer_t lookahead_timer;
+    #endif
+
   public: /** Public Function */
 
     static void init();
@@ -50,6 +64,13 @@ class MMU2 {
     static uint8_t get_current_tool();
     static void set_filament_type(uint8_t index, uint8_t type);
 
+    #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+      /**
+       * Wait the end of the tool change in progress, if any
+       */
+      static void wait_tool_change();
+    #endif
+
     #if HAS_LCD_MENU
       static bool unload();
       static void load_filament(uint8_t);
@@ -77,6 +98,14 @@ class MMU2 {
     static void filament_runout();
     static void set_runout_valid(const bool valid);
 
+    #if ENABLED(MMU2_ASYNC_TOOL_CHANGE)
+      static void start_tool_change(const uint8_t index);
+      static void tool_change_spin();
+      static void tool_change_done();
+      static bool e_moves_queued();
+      static uint8_t next_queued_tool();
+    #endif
+
     #if HAS_LCD_MENU
       static void load_to_nozzle();
       static void filament_ramming();
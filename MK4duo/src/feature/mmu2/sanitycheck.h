@@ -26,3 +26,7 @@
  *
  * Test configuration values for errors at compile-time.
  */
+
+#if ENABLED(MMU2_ASYNC_TOOL_CHANGE) && !HAS_MMU2
+  #error "DEPENDENCY ERROR: MMU2_ASYNC_TOOL_CHANGE requires PRUSA_MMU2."
+#endif
@@ -0,0 +1,273 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * netbridge.cpp
+ *
+ * Network bridge: uploads and streamed jobs from an ESP32 on the secondary serial port
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(NET_BRIDGE)
+
+#define NB_START              0xA5
+#define NB_CONTROL_ROOM       16    // Bytes of the window kept for 'R' and 'Q', sent without credit
+
+#define NB_UPLOAD_SAVED       0     // Results of an upload
+#define NB_UPLOAD_FAILED      1
+#define NB_UPLOAD_BUSY        2
+
+#define NB_STATUS_SD_MOUNTED  0     // Status flag bits
+#define NB_STATUS_UPLOADING   1
+#define NB_STATUS_SD_PRINTING 2
+
+NetBridge netbridge;
+
+/** Public Parameters */
+bool NetBridge::uploading = false;
+
+/** Private Parameters */
+uint8_t   NetBridge::rx_buffer[NET_BRIDGE_MAX_PAYLOAD + 4];
+uint16_t  NetBridge::rx_index = 0,
+          NetBridge::credit   = 0;
+uint32_t  NetBridge::lines    = 0;
+bool      NetBridge::resync   = false;
+
+// CRC-8 (poly 0x07) of the frame from the command to the end of the payload
+static uint8_t crc8(uint8_t crc, const uint8_t b) {
+  crc ^= b;
+  LOOP_L_N(i, 8) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+  return crc;
+}
+
+/** Public Function */
+void NetBridge::init() {
+  MKSERIAL2.begin(BAUDRATE_2);
+  grant();  // For a bridge up before the board, else its reset asks again
+}
+
+void NetBridge::spin() {
+
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    // The SD dropped the upload, on its timeout
+    if (uploading && !card.isUploading()) {
+      uploading = false;
+      send_uploaded(NB_UPLOAD_FAILED);
+    }
+  #endif
+
+  for (;;) {
+    // A whole frame in the buffer: start, command, length, payload and crc
+    if (rx_index >= 3 && rx_index == rx_buffer[2] + 4U) {
+      if (!process_frame()) break;  // The line waits, the next bytes stay in the port
+      rx_index = 0;
+      continue;
+    }
+    if (!MKSERIAL2.available()) break;
+    const uint8_t c = MKSERIAL2.read();
+    if (rx_index == 0 && c != NB_START) continue;   // Wait the start of a frame
+    rx_buffer[rx_index++] = c;
+  }
+
+  grant();
+}
+
+/** Private Function */
+void NetBridge::send_frame(const NetBridgeFrameEnum cmd, const uint8_t * const payload, const uint8_t len) {
+  uint8_t crc = crc8(crc8(0, cmd), len);
+  MKSERIAL2.write(uint8_t(NB_START));
+  MKSERIAL2.write(uint8_t(cmd));
+  MKSERIAL2.write(len);
+  LOOP_L_N(i, len) {
+    MKSERIAL2.write(payload[i]);
+    crc = crc8(crc, payload[i]);
+  }
+  MKSERIAL2.write(crc);
+}
+
+void NetBridge::send_status() {
+  uint8_t payload[6];
+  payload[0] = 0;
+  if (IS_SD_MOUNTED())  SBI(payload[0], NB_STATUS_SD_MOUNTED);
+  if (uploading)        SBI(payload[0], NB_STATUS_UPLOADING);
+  if (IS_SD_PRINTING()) SBI(payload[0], NB_STATUS_SD_PRINTING);
+  payload[1] = commands.buffer_ring.size() - commands.buffer_ring.count();
+  memcpy(&payload[2], &lines, sizeof(lines));     // All the targets are little endian
+  send_frame(NB_STATUS, payload, sizeof(payload));
+}
+
+void NetBridge::send_uploaded(const uint8_t result) {
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    const uint16_t crc = card.upload_checksum();
+  #else
+    constexpr uint16_t crc = 0;
+  #endif
+  const uint8_t payload[] = { result, lowByte(crc), highByte(crc) };
+  send_frame(NB_UPLOADED, payload, sizeof(payload));
+}
+
+/**
+ * The bridge sends only the bytes granted: the free room of the window,
+ * less the credit still open and the bytes waiting in the port.
+ * Granted a quarter of the window at a time, to keep the frames few.
+ */
+void NetBridge::grant() {
+  if (resync) return;
+  const int16_t room = int16_t(NET_BRIDGE_RX_WINDOW - NB_CONTROL_ROOM) - int16_t(credit) - int16_t(MKSERIAL2.available());
+  if (room < (NET_BRIDGE_RX_WINDOW) / 4) return;
+  credit += room;
+  const uint8_t payload[] = { lowByte(room), highByte(room) };
+  send_frame(NB_CREDIT, payload, sizeof(payload));
+}
+
+bool NetBridge::process_frame() {
+
+  const uint8_t cmd = rx_buffer[1],
+                len = rx_buffer[2];
+  const uint8_t * const payload = &rx_buffer[3];
+
+  uint8_t crc = crc8(crc8(0, cmd), len);
+  LOOP_L_N(i, len) crc = crc8(crc, payload[i]);
+
+  if (crc != payload[len]) {
+    // The bridge goes back to the last line queued after its reset
+    if (!resync) {
+      resync = true;
+      #if ENABLED(SD_UPLOAD_BLOCKS)
+        if (uploading) {
+          card.abortUpload();
+          uploading = false;
+          send_uploaded(NB_UPLOAD_FAILED);
+        }
+      #endif
+      send_frame(NB_ERROR, (const uint8_t*)&lines, sizeof(lines));
+      SERIAL_LM(ER, "Bridge: bad frame");
+    }
+    return true;
+  }
+
+  switch (cmd) {
+    case NB_RESET:
+      resync = false;
+      credit = 0;
+      return true;
+    case NB_QUERY:
+      send_status();
+      return true;
+    default: break;
+  }
+
+  if (resync) return true;
+
+  switch (cmd) {
+
+    case NB_LINE: {
+      // Flow control by the command queue: no ok for the lines
+      if (commands.buffer_ring.isFull()) return false;
+      if (len < MAX_CMD_SIZE) {
+        char line[MAX_CMD_SIZE];
+        memcpy(line, payload, len);
+        line[len] = '\0';
+        commands.enqueue_job_line(line);
+      }
+      else
+        SERIAL_LM(ER, "Bridge: line too long");
+      lines++;
+    } break;
+
+    #if ENABLED(SD_UPLOAD_BLOCKS)
+      case NB_UPLOAD: start_upload(payload, len); break;
+      case NB_DATA:   put_data(payload, len); break;
+      case NB_ABORT:
+        if (uploading) {
+          card.abortUpload();
+          uploading = false;
+          SERIAL_EM("Bridge: upload aborted");
+        }
+        break;
+    #else
+      case NB_UPLOAD: send_uploaded(NB_UPLOAD_BUSY); break;
+    #endif
+
+    default: break;
+  }
+
+  // The frame is out of the credit
+  const uint16_t size = len + 4;
+  credit = credit > size ? credit - size : 0;
+  return true;
+}
+
+#if ENABLED(SD_UPLOAD_BLOCKS)
+
+  /**
+   * <uint32 size> <name>: the file is written by the upload of M28 B,
+   * in whole blocks of a contiguous file
+   */
+  void NetBridge::start_upload(const uint8_t * const payload, const uint8_t len) {
+
+    if (len < 5 || !IS_SD_MOUNTED() || card.isUploading() || card.isSaving() || IS_SD_PRINTING()) {
+      send_uploaded(NB_UPLOAD_BUSY);
+      return;
+    }
+
+    uint32_t size;
+    memcpy(&size, payload, sizeof(size));
+    char path[NET_BRIDGE_MAX_PAYLOAD - 3];
+    memcpy(path, payload + 4, len - 4);
+    path[len - 4] = '\0';
+
+    if (size) card.startUpload(path, size);
+    if (!card.isUploading()) {
+      send_uploaded(NB_UPLOAD_FAILED);
+      return;
+    }
+
+    uploading = true;
+    #if ENABLED(EMERGENCY_PARSER)
+      emergency_parser.enable();  // The bytes of the host are still commands
+    #endif
+  }
+
+  void NetBridge::put_data(const uint8_t * const payload, const uint8_t len) {
+    if (!uploading) return;       // After an abort, the frames on their way
+    LOOP_L_N(i, len) {
+      if (!card.upload_put(payload[i])) {
+        uploading = false;
+        send_uploaded(NB_UPLOAD_FAILED);
+        return;
+      }
+      if (!card.isUploading()) {
+        uploading = false;
+        send_uploaded(NB_UPLOAD_SAVED);
+        return;
+      }
+    }
+  }
+
+#endif // SD_UPLOAD_BLOCKS
+
+#endif // ENABLED(NET_BRIDGE)
@@ -0,0 +1,95 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * netbridge.h
+ *
+ * Network bridge: uploads and streamed jobs from an ESP32 on the secondary serial port
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(NET_BRIDGE)
+
+#define NET_BRIDGE_MAX_PAYLOAD 255
+
+// The frames of the link, see serial-protocol.md
+enum NetBridgeFrameEnum : uint8_t {
+  NB_RESET    = 'R',  // bridge => main: restart the credits, after a boot or an error
+  NB_QUERY    = 'Q',  // bridge => main: heartbeat, the reply is a status
+  NB_UPLOAD   = 'U',  // bridge => main: size and name of a file to write on SD
+  NB_DATA     = 'D',  // bridge => main: the next bytes of the upload
+  NB_LINE     = 'L',  // bridge => main: a line of a streamed job, for the command queue
+  NB_ABORT    = 'A',  // bridge => main: drop the upload running
+  NB_CREDIT   = 'C',  // main => bridge: bytes more the bridge may send
+  NB_STATUS   = 's',  // main => bridge: the reply to a query
+  NB_UPLOADED = 'u',  // main => bridge: the upload is over, result and crc16
+  NB_ERROR    = 'e'   // main => bridge: a bad frame, frames ignored up to a reset
+};
+
+class NetBridge {
+
+  public: /** Constructor */
+
+    NetBridge() {}
+
+  public: /** Public Parameters */
+
+    static bool uploading;          // The upload running on the SD comes from the bridge
+
+  private: /** Private Parameters */
+
+    static uint8_t  rx_buffer[NET_BRIDGE_MAX_PAYLOAD + 4];
+    static uint16_t rx_index,
+                    credit;         // Bytes granted to the bridge and not received yet
+    static uint32_t lines;          // Lines queued since the startup
+    static bool     resync;         // After a bad frame, wait for a reset
+
+  public: /** Public Function */
+
+    static void init();
+    static void spin();
+
+  private: /** Private Function */
+
+    static void send_frame(const NetBridgeFrameEnum cmd, const uint8_t * const payload, const uint8_t len);
+    static void send_status();
+    static void send_uploaded(const uint8_t result);
+    static void grant();
+
+    /**
+     * Run the frame in rx_buffer. False keeps it there:
+     * a line waits for a free slot of the command queue.
+     */
+    static bool process_frame();
+
+    #if ENABLED(SD_UPLOAD_BLOCKS)
+      static void start_upload(const uint8_t * const payload, const uint8_t len);
+      static void put_data(const uint8_t * const payload, const uint8_t len);
+    #endif
+
+};
+
+extern NetBridge netbridge;
+
+#endif // ENABLED(NET_BRIDGE)
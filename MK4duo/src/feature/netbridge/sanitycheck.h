@@ -0,0 +1,44 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+#if ENABLED(NET_BRIDGE)
+  #if DISABLED(SERIAL_PORT_2) || SERIAL_PORT_2 < -1
+    #error "DEPENDENCY ERROR: NET_BRIDGE requires the secondary port SERIAL_PORT_2."
+  #elif DISABLED(NET_BRIDGE_RX_WINDOW)
+    #error "DEPENDENCY ERROR: Missing setting NET_BRIDGE_RX_WINDOW."
+  #elif !WITHIN(NET_BRIDGE_RX_WINDOW, 260, 4096)
+    #error "DEPENDENCY ERROR: NET_BRIDGE_RX_WINDOW must be from 260 to 4096, a whole frame of 259 bytes must fit."
+  #elif (ENABLED(__AVR__) || ENABLED(ARDUINO_ARCH_SAM)) && NET_BRIDGE_RX_WINDOW > RX_BUFFER_SIZE
+    #error "DEPENDENCY ERROR: NET_BRIDGE_RX_WINDOW must not be bigger than RX_BUFFER_SIZE."
+  #elif HAS_SD_SUPPORT && DISABLED(SD_UPLOAD_BLOCKS)
+    #error "DEPENDENCY ERROR: NET_BRIDGE requires SD_UPLOAD_BLOCKS for the uploads to the SD."
+  #elif ENABLED(TOOLBOARD) && TOOLBOARD_SERIAL == SERIAL_PORT_2
+    #error "DEPENDENCY ERROR: TOOLBOARD_SERIAL and the SERIAL_PORT_2 of NET_BRIDGE must be different."
+  #endif
+#endif
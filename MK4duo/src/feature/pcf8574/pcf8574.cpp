@@ -32,24 +32,43 @@
         PCF8574::byteBuffered       = 0,
         PCF8574::writeByteBuffered  = 0;
 
+  volatile bool PCF8574::write_pending = false;
+
+  bool PCF8574::started = false;
+
   millis_l PCF8574::lastReadMillis  = 0;
 
   void PCF8574::begin() {
 
     WIRE.begin();
 
-    // Check if there are pins to set low
-    if (writeMode || readMode) {
-      WIRE.beginTransmission(_address);
-      byte usedPin = writeMode | readMode;
-      WIRE.write(~usedPin);
-      WIRE.endTransmission();
-    }
+    #if PIN_EXISTS(PCF8574_INT)
+      SET_INPUT_PULLUP(PCF8574_INT_PIN);
+    #endif
 
-    lastReadMillis = millis();
+    started = true;
+    write_port();
+    read_port();
+  }
+
+  // Flush the outputs changed since the last cycle and refresh the inputs
+  void PCF8574::spin() {
+    if (!started) return;
+
+    if (write_pending) write_port();
+
+    if (readMode) {
+      // The INT line of the chip is low from a change of an input to the read of the port
+      #if PIN_EXISTS(PCF8574_INT)
+        if (!READ(PCF8574_INT_PIN))
+      #else
+        if (ELAPSED(millis(), lastReadMillis + READ_ELAPSED_TIME))
+      #endif
+          read_port();
+    }
   }
 
-  void PCF8574::pinMode(const uint8_t pin, const uint8_t mode){
+  void PCF8574::pinMode(const uint8_t pin, const uint8_t mode) {
 
     if (mode == OUTPUT) {
       writeMode = writeMode |  bit(pin);
@@ -59,48 +78,36 @@
       writeMode = writeMode &  ~bit(pin);
       readMode  = readMode  |   bit(pin);
     }
-    begin();
+    write_pending = true;
   };
 
   void PCF8574::digitalWrite(const uint8_t pin, const uint8_t value) {
-    WIRE.beginTransmission(_address);   // Begin the transmission to PCF8574
+    const byte old = writeByteBuffered;
     if (value == HIGH)
       writeByteBuffered = writeByteBuffered | bit(pin);
     else
       writeByteBuffered = writeByteBuffered & ~bit(pin);
 
-    writeByteBuffered = writeByteBuffered & writeMode;
-    WIRE.write(writeByteBuffered);
-    WIRE.endTransmission();
+    if (writeByteBuffered != old) write_pending = true;
   };
 
   uint8_t PCF8574::digitalRead(const uint8_t pin) {
-    uint8_t value = LOW;
-
-    // Check if pin already HIGH than read and prevent reread of i2c
-    if ((bit(pin) & byteBuffered))
-      value = HIGH;
-    else if ((millis() > lastReadMillis + READ_ELAPSED_TIME)) {
-      WIRE.requestFrom(_address, (uint8_t)1); // Begin transmission to PCF8574
-      lastReadMillis = millis();
-
-      if (WIRE.available()) {                 // If bytes are available to be recieved
-        byte iInput = WIRE.read();            // Read a byte
-
-        if ((iInput & readMode)) {
-          byteBuffered = byteBuffered | (byte)iInput;
-          if ((bit(pin) & byteBuffered))
-            value = HIGH;
-        }
-      }
-    }
+    return (byteBuffered & bit(pin)) ? HIGH : LOW;
+  };
 
-    // If HIGH set to low to read buffer only one time
-    if (value == HIGH)
-      byteBuffered = ~bit(pin) & byteBuffered;
+  // The outputs, the inputs and the free pins high (quasi-bidirectional port)
+  void PCF8574::write_port() {
+    write_pending = false;
+    WIRE.beginTransmission(_address);
+    WIRE.write((writeByteBuffered & writeMode) | ~writeMode);
+    WIRE.endTransmission();
+  }
 
-    return value;
-  };
+  void PCF8574::read_port() {
+    lastReadMillis = millis();
+    WIRE.requestFrom(_address, (uint8_t)1);
+    if (WIRE.available()) byteBuffered = WIRE.read() & readMode;
+  }
 
   PCF8574 pcf8574(PCF8574_ADDRESS);
 
@@ -19,7 +19,6 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  *
  */
-
 #pragma once
 
 #if ENABLED(PCF8574_EXPANSION_IO)
@@ -27,6 +26,11 @@
   #define READ_ELAPSED_TIME      10
   #define PIN_START_FOR_PCF8574 120
 
+  /**
+   * The pins are a copy of the port: digitalWrite and digitalRead don't use the bus
+   * and can run in an interrupt. spin() writes the changed outputs and reads the
+   * inputs, one I2C transfer each, on the INT line of the chip or at READ_ELAPSED_TIME.
+   */
   class PCF8574 {
 
     public: /** Constructor */
@@ -42,17 +46,25 @@
                   byteBuffered,
                   writeByteBuffered;
 
-      static millis_l lastReadMillis;
+      static volatile bool write_pending;
+
+      static bool     started;
 
-      bool        _usingInterrupt = false;
+      static millis_l lastReadMillis;
 
     public: /** Public Function */
 
       static void begin();
+      static void spin();
       static void pinMode(const uint8_t pin, const uint8_t mode);
       static void     digitalWrite(const uint8_t pin, const uint8_t value);
       static uint8_t  digitalRead(const uint8_t pin);
 
+    private: /** Private Function */
+
+      static void write_port();
+      static void read_port();
+
   };
 
   extern PCF8574 pcf8574;
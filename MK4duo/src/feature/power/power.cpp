@@ -34,11 +34,18 @@ Power powerManager;
 
 #if HAS_POWER_CONSUMPTION_SENSOR
   int16_t   Power::current_raw_powconsumption = 0;    // Holds measured power consumption
-  float     Power::consumption_meas           = 0.0;
-  uint32_t  Power::startpower                 = 0;
+  float     Power::consumption_meas           = 0.0,
+            Power::current_rms                = 0.0;
+  uint32_t  Power::job_mwh                    = 0;
 #endif
 
 /** Private Parameters */
+#if HAS_POWER_CONSUMPTION_SENSOR
+  uint32_t  Power::sample_count               = 0,
+            Power::sample_abs_sum             = 0;
+  uint64_t  Power::sample_sqr_sum             = 0;
+#endif
+
 #if HAS_POWER_SWITCH
   bool        Power::powersupply_on = false;
   #if (POWER_TIMEOUT > 0)
@@ -79,6 +86,17 @@ Power powerManager;
     }
 
     void Power::outage() {
+      #if ENABLED(STATS_DEFERRED_SAVE)
+        // Save the statistics counted in RAM once for each outage
+        static bool stats_saved = false;
+        if (READ(POWER_CHECK_PIN) != isLogic()) {
+          if (!stats_saved) {
+            stats_saved = true;
+            print_job_counter.saveStats();
+          }
+        }
+        else stats_saved = false;
+      #endif
       if (IS_SD_PRINTING() && READ(POWER_CHECK_PIN) != isLogic())
         card.setAbortSDprinting(true);
     }
@@ -126,6 +144,58 @@ Power powerManager;
 
 #if HAS_POWER_CONSUMPTION_SENSOR
 
+  #define POWER_ZERO_RAW    int32_t((POWER_ZERO) * (AD_RANGE) / (HAL_VOLTAGE_PIN))
+  #define POWER_AMP_PER_RAW ((HAL_VOLTAGE_PIN) / float(AD_RANGE) / (POWER_SENSITIVITY))
+
+  void Power::sample(const uint16_t raw) {
+    const uint32_t dist = ABS(int32_t(raw) - POWER_ZERO_RAW);
+    sample_abs_sum += dist;
+    sample_sqr_sum += dist * dist;
+    sample_count++;
+  }
+
+  void Power::spin_consumption() {
+
+    static millis_l last_update = millis();
+    static float mwh_fraction = 0.0f, wh_fraction = 0.0f;
+
+    const millis_l now = millis(),
+                   elapsed = now - last_update;
+    last_update = now;
+
+    // No sample, the last power holds
+    if (sample_count) {
+      #define POWER_CALIBRATED(I) MAX(0.0f, (100 - (POWER_ERROR)) * 0.01f * (I) * POWER_AMP_PER_RAW - (POWER_OFFSET))
+      current_rms = POWER_CALIBRATED(SQRT(float(sample_sqr_sum) / sample_count));
+
+      // The mean current of a DC supply gives its power, the RMS one that of the mains
+      #if ENABLED(POWER_CONSUMPTION_AC)
+        const float current = current_rms;
+      #else
+        const float current = POWER_CALIBRATED(float(sample_abs_sum) / sample_count);
+      #endif
+      consumption_meas = current * (POWER_VOLTAGE) * 100 / (POWER_EFFICIENCY);
+
+      sample_count = sample_abs_sum = 0;
+      sample_sqr_sum = 0;
+    }
+
+    // Whole mWh and Wh counted, the fractions kept: a float total would lose the small windows
+    const float mwh = consumption_meas * elapsed / 3600.0f;
+    if (print_job_counter.isRunning()) {
+      mwh_fraction += mwh;
+      const uint32_t whole = mwh_fraction;
+      job_mwh += whole;
+      mwh_fraction -= whole;
+    }
+    wh_fraction += mwh * 0.001f;
+    if (wh_fraction >= 1.0f) {
+      print_job_counter.incConsumptionHour();
+      wh_fraction--;
+    }
+
+  }
+
   // Convert adc_raw Power Consumption to watt
   float Power::raw_analog2voltage() {
     return ((HAL_VOLTAGE_PIN) * current_raw_powconsumption) / (AD_RANGE);
@@ -61,12 +61,19 @@ class Power {
 
     #if HAS_POWER_CONSUMPTION_SENSOR
       static int16_t  current_raw_powconsumption;
-      static float    consumption_meas;   // holds the power consumption as accurately measured
-      static uint32_t startpower;
+      static float    consumption_meas,   // [W] The mean power of the last window, the measured load of the power supply
+                      current_rms;        // [A] The RMS current of the last window
+      static uint32_t job_mwh;            // [mWh] Energy of the print job, from its start
     #endif
 
   private: /** Private Parameters */
 
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      static uint32_t sample_count,       // The samples of the window, from HAL::Tick
+                      sample_abs_sum;     // Of the distance from POWER_ZERO
+      static uint64_t sample_sqr_sum;
+    #endif
+
     #if HAS_POWER_SWITCH
       static bool powersupply_on;
       #if (POWER_TIMEOUT > 0)
@@ -128,6 +135,22 @@ class Power {
     #endif
 
     #if HAS_POWER_CONSUMPTION_SENSOR
+
+      /**
+       * Each conversion of the sensor, at AD_RANGE, from HAL::Tick: the
+       * windows have many of them to follow the PWM of the heaters
+       */
+      static void sample(const uint16_t raw);
+
+      /**
+       * The power and the energy of the window since the last call,
+       * every 100 ms from tempManager.spin
+       */
+      static void spin_consumption();
+
+      FORCE_INLINE static void job_reset() { job_mwh = 0; }
+      FORCE_INLINE static float job_energy() { return job_mwh * 0.001f; }  // [Wh]
+
       static float  analog2voltage(),
                     analog2current(),
                     analog2power(),
@@ -34,6 +34,11 @@ Probe probe;
 /** Public Parameters */
 probe_data_t Probe::data;
 
+/** Private Parameters */
+#if ENABLED(PROBE_FLY)
+  bool Probe::fly_at_trigger = false;
+#endif
+
 /** Public Function */
 void Probe::factory_parameters() {
   data.offset.set(X_PROBE_OFFSET_FROM_NOZZLE, Y_PROBE_OFFSET_FROM_NOZZLE, Z_PROBE_OFFSET_FROM_NOZZLE);
@@ -50,6 +55,10 @@ bool Probe::set_deployed(const bool deploy) {
     DEBUG_ELOGIC("deploy", deploy);
   }
 
+  #if ENABLED(PROBE_FLY)
+    fly_at_trigger = false;
+  #endif
+
   if (endstops.isProbeEnabled() == deploy) return false;
 
   // Make room for probe to deploy (or stow)
@@ -146,7 +155,7 @@ bool Probe::set_deployed(const bool deploy) {
       if (printer.debugFeature()) {
         DEBUG_MV(">>> check_at_point(", LOGICAL_X_POSITION(rx));
         DEBUG_MV(", ", LOGICAL_Y_POSITION(ry));
-        DEBUG_MT(", ", raise_after == PROBE_PT_RAISE ? "raise" : raise_after == PROBE_PT_STOW ? "stow" : "none");
+        DEBUG_MT(", ", raise_after == PROBE_PT_RAISE ? "raise" : raise_after == PROBE_PT_STOW ? "stow" : raise_after == PROBE_PT_FLY ? "fly" : "none");
         DEBUG_MV(", ", int(verbose_level));
         DEBUG_MT(", ", probe_relative ? "probe" : "nozzle");
         DEBUG_EM("_relative)");
@@ -175,20 +184,54 @@ bool Probe::set_deployed(const bool deploy) {
         #endif
       ;
 
+      #if ENABLED(PROBE_FLY)
+        const bool fly = raise_after == PROBE_PT_FLY;
+        // From the trigger of the last point just clear the bed
+        if (fly && fly_at_trigger) npos.z = mechanics.position.z + (PROBE_FLY_CLEARANCE);
+        fly_at_trigger = false;
+      #endif
+
       const float old_feedrate_mm_s = mechanics.feedrate_mm_s;
       mechanics.feedrate_mm_s = XY_PROBE_FEEDRATE_MM_S;
 
+      // Drop the pin while the probe travels to the point
+      #if HAS_BLTOUCH && ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+        if (endstops.isProbeEnabled()) bltouch.deploy_start();
+      #endif
+
       // Move the probe to the starting XYZ
-      mechanics.do_blocking_move_to(npos);
+      #if ENABLED(PROBE_FLY_CONTACTLESS)
+        if (fly && npos.z > mechanics.position.z) {
+          // No contact with the bed, raise and travel together
+          mechanics.position.set(npos.x, npos.y, npos.z);
+          mechanics.line_to_position(XY_PROBE_FEEDRATE_MM_S);
+          planner.synchronize();
+        }
+        else
+      #endif
+          mechanics.do_blocking_move_to(npos);
 
       float measured_z = NAN;
       if (!DEPLOY_PROBE()) {
-        measured_z = run_probing() + data.offset.z;
+        #if ENABLED(PROBE_FLY)
+          if (fly) {
+            // A single probe, the next point starts from the trigger
+            const float z_probe_low_point = mechanics.isAxisHomed(Z_AXIS) ? Z_PROBE_LOW_POINT - data.offset.z : -10.0;
+            if (!move_to_z(z_probe_low_point, MMM_TO_MMS(PROBE_FLY_SPEED))) {
+              measured_z = mechanics.position.z + data.offset.z;
+              fly_at_trigger = true;
+            }
+          }
+          else
+        #endif
+        {
+          measured_z = run_probing() + data.offset.z;
 
-        if (raise_after == PROBE_PT_RAISE)
-          mechanics.do_blocking_move_to_z(mechanics.position.z + Z_PROBE_BETWEEN_HEIGHT, MMM_TO_MMS(data.speed_fast));
-        else if (raise_after == PROBE_PT_STOW)
-          if (STOW_PROBE()) measured_z = NAN;
+          if (raise_after == PROBE_PT_RAISE)
+            mechanics.do_blocking_move_to_z(mechanics.position.z + Z_PROBE_BETWEEN_HEIGHT, MMM_TO_MMS(data.speed_fast));
+          else if (raise_after == PROBE_PT_STOW)
+            if (STOW_PROBE()) measured_z = NAN;
+        }
       }
 
       if (verbose_level > 2) {
@@ -399,6 +442,8 @@ void Probe::specific_action(const bool deploy) {
     dock_sled(!deploy);
   #elif HAS_BLTOUCH && ENABLED(BLTOUCH_HIGH_SPEED_MODE)
     deploy ? bltouch.cmd_deploy() : bltouch.cmd_stow();
+  #elif HAS_BLTOUCH && ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+    if (!deploy) (void)bltouch.stow();  // Close the pipelined STOW of the last probe
   #elif HAS_Z_SERVO_PROBE && DISABLED(BLTOUCH)
     MOVE_SERVO(Z_PROBE_SERVO_NR, servo[Z_PROBE_SERVO_NR].angle[(deploy ? 0 : 1)]);
   #elif HAS_ALLEN_KEY
@@ -472,7 +517,9 @@ bool Probe::move_to_z(const float z, const feedrate_t fr_mm_s) {
   #endif
 
   // Retract BLTouch immediately after a probe if it was triggered
-  #if HAS_BLTOUCH && DISABLED(BLTOUCH_HIGH_SPEED_MODE)
+  #if HAS_BLTOUCH && ENABLED(BLTOUCH_PIPELINED_DEPLOY)
+    if (probe_triggered) bltouch.stow_start();
+  #elif HAS_BLTOUCH && DISABLED(BLTOUCH_HIGH_SPEED_MODE)
     if (probe_triggered && bltouch.stow()) return true;
   #endif
 
@@ -145,6 +145,12 @@ class Probe {
 
     static void servo_test();
 
+  private: /** Private Parameters */
+
+    #if ENABLED(PROBE_FLY)
+      static bool fly_at_trigger;   // Left at the trigger of a PROBE_PT_FLY point
+    #endif
+
   private: /** Private Function */
 
     static void specific_action(const bool deploy);
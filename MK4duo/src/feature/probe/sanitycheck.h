@@ -110,3 +110,23 @@
     #error "DEPENDENCY ERROR: G38_PROBE_TARGET requires a Cartesian or Core machine."
   #endif
 #endif
+
+// Probe on the fly
+#if ENABLED(PROBE_FLY)
+  #if !HAS_BED_PROBE || ENABLED(PROBE_MANUALLY)
+    #error "DEPENDENCY ERROR: PROBE_FLY requires a probe! Define a Z Servo, BLTOUCH, Z_PROBE_ALLEN_KEY, Z_PROBE_SLED, or Z_PROBE_FIX_MOUNTED."
+  #elif !defined(PROBE_FLY_SPEED) || !defined(PROBE_FLY_CLEARANCE)
+    #error "DEPENDENCY ERROR: PROBE_FLY requires PROBE_FLY_SPEED and PROBE_FLY_CLEARANCE."
+  #elif PROBE_FLY_CLEARANCE <= 0
+    #error "DEPENDENCY ERROR: PROBE_FLY_CLEARANCE must be greater than 0."
+  #endif
+#endif
+#if ENABLED(PROBE_FLY_CONTACTLESS)
+  #if DISABLED(PROBE_FLY)
+    #error "DEPENDENCY ERROR: PROBE_FLY_CONTACTLESS requires PROBE_FLY."
+  #elif IS_KINEMATIC
+    #error "DEPENDENCY ERROR: PROBE_FLY_CONTACTLESS requires a Cartesian or Core machine."
+  #elif ENABLED(BLTOUCH) || HAS_Z_SERVO_PROBE || ENABLED(Z_PROBE_ALLEN_KEY) || ENABLED(Z_PROBE_SLED)
+    #error "DEPENDENCY ERROR: PROBE_FLY_CONTACTLESS requires a fixed mounted probe with no contact."
+  #endif
+#endif
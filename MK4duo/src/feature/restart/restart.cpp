@@ -35,7 +35,12 @@ restart_job_t Restart::job_info;
 bool  Restart::enabled;
 
 uint32_t  Restart::cmd_sdpos      = 0,
-          Restart::sdpos[BUFSIZE] = { 0 };  
+          Restart::sdpos[BUFSIZE_MAX] = { 0 };
+
+#if ENABLED(SD_RESTART_RAW_SLOTS)
+  uint32_t Restart::raw_block     = 0;
+  static_assert(sizeof(restart_job_t) <= 512, "restart_job_t must fit a block for SD_RESTART_RAW_SLOTS.");
+#endif
 
 /** Public Function */
 void Restart::enable(const bool onoff) {
@@ -65,19 +70,44 @@ void Restart::start_job() {
   card.getAbsFilename(job_info.fileName);
   cmd_sdpos = 0;
   ZERO(sdpos);
+  #if ENABLED(SD_RESTART_RAW_SLOTS)
+    raw_block = card.restart_raw_block(true);
+  #endif
 }
 
 void Restart::purge_job() {
+  #if ENABLED(SD_WRITE_BEHIND)
+    card.write_behind_cancel(WB_RESTART);
+  #endif
   clear_job();
   card.delete_restart_file();
+  #if ENABLED(SD_RESTART_RAW_SLOTS)
+    raw_block = 0;
+  #endif
 }
 
 void Restart::load_job() {
-  if (exists()) {
-    open(true);
-    (void)job_file.read(&job_info, sizeof(job_info));
-    close();
-  }
+  #if ENABLED(SD_RESTART_RAW_SLOTS)
+    // The newest valid block, a block cut by a power loss is not valid
+    clear_job();
+    raw_block = card.restart_raw_block(false);
+    cache_t * const cache = raw_block ? card.fat.vol()->cacheClear() : nullptr;
+    if (cache) {
+      const restart_job_t * const slot_info = (const restart_job_t*)cache->data;
+      for (uint8_t s = 0; s < SD_RESTART_RAW_SLOTS; s++) {
+        if (!card.fat.card()->readBlock(raw_block + s, cache->data)) break;
+        if (slot_info->valid_head && slot_info->valid_head == slot_info->valid_foot
+          && (!valid() || int8_t(slot_info->valid_head - job_info.valid_head) > 0)
+        ) memcpy(&job_info, slot_info, sizeof(job_info));
+      }
+    }
+  #else
+    if (exists()) {
+      open(true);
+      (void)job_file.read(&job_info, sizeof(job_info));
+      close();
+    }
+  #endif
   debug_info(PSTR("Load"));
 }
 
@@ -129,6 +159,14 @@ void Restart::save_job(const bool force_save/*=false*/, const bool save_count/*=
       job_info.density_percentage[e]  = extruders[e]->density_percentage;
     }
 
+    #if ENABLED(FWRETRACT)
+      LOOP_EXTRUDER() {
+        job_info.retracted[e]       = fwretract.retracted[e];
+        job_info.current_retract[e] = fwretract.current_retract[e];
+      }
+      job_info.current_hop = fwretract.current_hop;
+    #endif
+
     // Leveling      
     #if HAS_LEVELING
       job_info.leveling = bedlevel.flag.leveling_active;
@@ -149,6 +187,14 @@ void Restart::save_job(const bool force_save/*=false*/, const bool save_count/*=
     // Elapsed print job time
     job_info.print_job_counter_elapsed = print_job_counter.duration();
 
+    #if ENABLED(SD_WRITE_BEHIND)
+      if (!force_save) {
+        card.write_behind(WB_RESTART);
+        return;
+      }
+      card.write_behind_cancel(WB_RESTART);
+    #endif
+
     write_job();
   }
 }
@@ -171,15 +217,17 @@ void Restart::resume_job() {
     commands.process_now_P(PSTR("M420 S0 Z0"));
   #endif
 
-  // Reset E, raise Z, home XY...
+  // Reset E, raise Z, home XY, all while the heaters heat up
   commands.process_now_P(PSTR("G92.9 E0"));
   #if Z_HOME_DIR > 0
+    set_heaters();
     commands.process_now_P(G28_CMD);
   #else
     commands.process_now_P(PSTR("G92.9 Z0"));
     mechanics.home_flag.ZHomed = true;
     stepper.enable_Z();
     commands.process_now_P(PSTR("G1 Z" STRINGIFY(RESTART_ZRAISE)));
+    set_heaters();  // The nozzle is off the part now
     commands.process_now_P(PSTR("G28 XY"));
   #endif
 
@@ -189,43 +237,7 @@ void Restart::resume_job() {
     commands.process_now(cmd);
   #endif
 
-  // Set temperature
-  #if HAS_CHAMBERS
-    LOOP_CHAMBER() {
-      if (chambers[h]) {
-        chambers[h]->set_target_temp(job_info.chamber_target_temperature[h]);
-        chambers[h]->wait_for_target(true);
-      }
-    }
-  #endif
-  #if HAS_BEDS
-    LOOP_BED() {
-      if (beds[h]) {
-        beds[h]->set_target_temp(job_info.bed_target_temperature[h]);
-        beds[h]->wait_for_target(true);
-      }
-    }
-  #endif
-  #if HAS_HOTENDS
-    LOOP_HOTEND() {
-      if (hotends[h]) {
-        hotends[h]->set_target_temp(job_info.target_temperature[h]);
-        hotends[h]->wait_for_target(true);
-      }
-    }
-  #endif
-
-  // Set fan
-  #if HAS_FAN
-    LOOP_FAN() {
-      if (fans[f]) fans[f]->speed = job_info.fan_speed[f];
-    }
-  #endif
-
-  LOOP_EXTRUDER() {
-    extruders[e]->flow_percentage     = job_info.flow_percentage[e];
-    extruders[e]->density_percentage  = job_info.density_percentage[e];
-  }
+  wait_heaters();
 
   // Set leveling
   #if HAS_LEVELING
@@ -281,22 +293,47 @@ void Restart::resume_job() {
     commands.process_now(cmd);
   #endif
 
-  // Un-retract
-  #if SD_RESTART_FILE_PURGE_LEN > 0
-    commands.process_now_P(PSTR("G1 E" STRINGIFY(SD_RESTART_FILE_PURGE_LEN) " F3000"));
+  // Un-retract, a job stopped with a firmware retract stays retracted
+  #if ENABLED(FWRETRACT)
+    const float retract_len = job_info.retracted[toolManager.extruder.active] ? job_info.current_retract[toolManager.extruder.active] : 0.0f;
+  #else
+    constexpr float retract_len = 0.0f;
   #endif
-
-  // Restore the feedrate
-  sprintf_P(cmd, PSTR("G1 F%d"), job_info.feedrate);
-  commands.process_now(cmd);
+  if (SD_RESTART_FILE_PURGE_LEN > 0 || retract_len) {
+    sprintf_P(cmd, PSTR("G1 E%s F3000"), dtostrf(float(SD_RESTART_FILE_PURGE_LEN) - retract_len, 1, 3, str1));
+    commands.process_now(cmd);
+  }
 
   // Restore E position
   sprintf_P(cmd, PSTR("G92.9 E%s"), dtostrf(job_info.axis_position_mm.e, 1, 3, str1));
   commands.process_now(cmd);
 
-  // Relative mode
+  // All the rest of the job state in one go, no more moves up to the print
+  mechanics.feedrate_mm_s = MMM_TO_MMS(job_info.feedrate);
   mechanics.axis_relative_modes = job_info.axis_relative_modes;
 
+  #if HAS_FAN
+    LOOP_FAN() {
+      if (fans[f]) fans[f]->speed = job_info.fan_speed[f];
+    }
+  #endif
+
+  LOOP_EXTRUDER() {
+    extruders[e]->flow_percentage     = job_info.flow_percentage[e];
+    extruders[e]->density_percentage  = job_info.density_percentage[e];
+  }
+
+  #if ENABLED(FWRETRACT)
+    // The saved position is the one of the steppers, with the hop and without the retract
+    LOOP_EXTRUDER() {
+      fwretract.retracted[e]        = job_info.retracted[e];
+      fwretract.current_retract[e]  = job_info.current_retract[e];
+    }
+    fwretract.current_hop = job_info.current_hop;
+    mechanics.position.z -= fwretract.current_hop;
+    mechanics.position.e += fwretract.current_retract[toolManager.extruder.active];
+  #endif
+
   #if ENABLED(WORKSPACE_OFFSETS)
     LOOP_XYZ(i) {
       mechanics.data.home_offset[i] = job_info.home_offset[i];
@@ -318,16 +355,54 @@ void Restart::resume_job() {
 /** Private Function */
 void Restart::clear_job() { memset(&job_info, 0, sizeof(job_info)); }
 
+// All the targets at once, the heaters heat up together and during the homing
+void Restart::set_heaters() {
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() if (chambers[h]) chambers[h]->set_target_temp(job_info.chamber_target_temperature[h]);
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() if (beds[h]) beds[h]->set_target_temp(job_info.bed_target_temperature[h]);
+  #endif
+  #if HAS_HOTENDS
+    LOOP_HOTEND() if (hotends[h]) hotends[h]->set_target_temp(job_info.target_temperature[h]);
+  #endif
+}
+
+void Restart::wait_heaters() {
+  #if HAS_CHAMBERS
+    LOOP_CHAMBER() if (chambers[h]) chambers[h]->wait_for_target(true);
+  #endif
+  #if HAS_BEDS
+    LOOP_BED() if (beds[h]) beds[h]->wait_for_target(true);
+  #endif
+  #if HAS_HOTENDS
+    LOOP_HOTEND() if (hotends[h]) hotends[h]->wait_for_target(true);
+  #endif
+}
+
 void Restart::write_job() {
   bool failed = false;
 
   debug_info(PSTR("Write"));
 
-  open(false);
-  if (!job_file.seekSet(0)) failed = true;
-  if (!failed && !job_file.write(&job_info, sizeof(job_info)) == sizeof(job_info))
-    failed = true;
-  close();
+  #if ENABLED(SD_RESTART_RAW_SLOTS)
+    // One block write in the next slot, the one before stays valid until it is done
+    if (!raw_block) raw_block = card.restart_raw_block(true);
+    cache_t * const cache = raw_block ? card.fat.vol()->cacheClear() : nullptr;
+    if (cache) {
+      memset(cache->data, 0, sizeof(cache->data));
+      memcpy(cache->data, &job_info, sizeof(job_info));
+      failed = !card.fat.card()->writeBlock(raw_block + job_info.valid_head % (SD_RESTART_RAW_SLOTS), cache->data);
+    }
+    else
+      failed = true;
+  #else
+    open(false);
+    if (!job_file.seekSet(0)) failed = true;
+    if (!failed && !job_file.write(&job_info, sizeof(job_info)) == sizeof(job_info))
+      failed = true;
+    close();
+  #endif
   if (failed) DEBUG_LM(DEB, " Restart file write failed.");
 
 }
@@ -72,6 +72,13 @@ typedef struct {
   int16_t flow_percentage[MAX_EXTRUDER],
           density_percentage[MAX_EXTRUDER];
 
+  // Firmware retract
+  #if ENABLED(FWRETRACT)
+    bool  retracted[MAX_EXTRUDER];
+    float current_retract[MAX_EXTRUDER],
+          current_hop;
+  #endif
+
   // Leveling
   #if HAS_LEVELING
     bool  leveling;
@@ -108,7 +115,13 @@ class Restart {
     static bool enabled;
 
     static uint32_t cmd_sdpos,
-                    sdpos[BUFSIZE];
+                    sdpos[BUFSIZE_MAX];
+
+  private: /** Private Parameters */
+
+    #if ENABLED(SD_RESTART_RAW_SLOTS)
+      static uint32_t raw_block;  // First block of the restart file on the card, 0 = none
+    #endif
 
   public: /** Public Function */
 
@@ -120,6 +133,7 @@ class Restart {
     static void purge_job();
     static void load_job();
     static void save_job(const bool force_save=false, const bool save_count=true);
+    static void write_job();
     static void resume_job();
 
     static inline bool exists()               { return card.exist_restart_file(); }
@@ -136,7 +150,8 @@ class Restart {
 
     static void clear_job();
 
-    static void write_job();
+    static void set_heaters();
+    static void wait_heaters();
 
     #if ENABLED(DEBUG_RESTART)
       static void debug_info(PGM_P const prefix);
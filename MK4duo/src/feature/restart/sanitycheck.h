@@ -26,3 +26,11 @@
  *
  * Test configuration values for errors at compile-time.
  */
+
+#if ENABLED(SD_RESTART_RAW_SLOTS)
+  #if DISABLED(SD_RESTART_FILE)
+    #error "DEPENDENCY ERROR: SD_RESTART_RAW_SLOTS requires SD_RESTART_FILE."
+  #elif !WITHIN(SD_RESTART_RAW_SLOTS, 1, 16)
+    #error "DEPENDENCY ERROR: SD_RESTART_RAW_SLOTS must be from 1 to 16."
+  #endif
+#endif
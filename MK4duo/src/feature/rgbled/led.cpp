@@ -100,7 +100,7 @@ void LEDLights::set_color(const LEDColor &incol
       neopixel.set_color(neocolor);
     else {
       neopixel.strip.setPixelColor(nextLed, neocolor);
-      neopixel.strip.show();
+      neopixel.show();
       if (++nextLed >= neopixel.strip.numPixels()) nextLed = 0;
       return;
     }
@@ -32,14 +32,26 @@
 
 #include "neopixel.h"
 
+Neopixel neopixel;
+
 /** Public Parameters */
 Adafruit_NeoPixel Neopixel::strip = Adafruit_NeoPixel(NEOPIXEL_PIXELS, NEOPIXEL_PIN, NEOPIXEL_TYPE + NEO_KHZ800);
 
+/** Private Parameters */
+#if ENABLED(NEOPIXEL_DMA)
+  bool      Neopixel::dma_ready   = false,
+            Neopixel::dma_pending = false;
+  uint16_t  Neopixel::dma_bit0    = 0,
+            Neopixel::dma_bit1    = 0,
+            Neopixel::dma_buffer[(NEOPIXEL_BYTES * 8 + 1) * HAL_NEOPIXEL_DMA_STRIDE] = { 0 };
+  uint32_t  Neopixel::dma_free_us = 0;
+#endif
+
 /** Public Function */
 void Neopixel::set_color(const uint32_t color) {
   for (uint16_t i = 0; i < strip.numPixels(); ++i)
     strip.setPixelColor(i, color);
-  strip.show();
+  show();
 }
 
 void Neopixel::setup() {
@@ -47,8 +59,14 @@ void Neopixel::setup() {
   SET_OUTPUT(NEOPIXEL_PIN);
 
   strip.setBrightness(NEOPIXEL_BRIGHTNESS); // 0 - 255 range
-  strip.begin();
-  strip.show(); // initialize to all off
+
+  #if ENABLED(NEOPIXEL_DMA)
+    dma_ready = HAL::neopixel_dma_init(NEOPIXEL_PIN, dma_bit0, dma_bit1);
+    if (!dma_ready)
+  #endif
+      strip.begin();
+
+  show(); // initialize to all off
 
   #if ENABLED(NEOPIXEL_STARTUP_TEST)
     HAL::delayMilliseconds(1000);
@@ -62,4 +80,49 @@ void Neopixel::setup() {
   set_color(strip.Color(NEO_BLACK));       // black
 }
 
+#if ENABLED(NEOPIXEL_DMA)
+
+  /**
+   * The pixels of the strip are the frame to send, the DMA buffer is the
+   * frame on the wire. A frame shown while the previous one is on the wire
+   * or latching waits in the pixels and spin() sends it.
+   */
+  void Neopixel::show() {
+    if (!dma_ready)
+      strip.show();
+    else if (PENDING(micros(), dma_free_us))
+      dma_pending = true;
+    else
+      dma_send();
+  }
+
+  void Neopixel::spin() {
+    if (dma_pending && ELAPSED(micros(), dma_free_us)) dma_send();
+  }
+
+#endif
+
+/** Private Function */
+#if ENABLED(NEOPIXEL_DMA)
+
+  // One PWM period for each bit, MSB first, and a last low period
+  void Neopixel::dma_send() {
+    const uint8_t * const pixels = strip.getPixels();
+    uint16_t *p = dma_buffer + HAL_NEOPIXEL_DMA_STRIDE - 1;
+    for (uint16_t i = 0; i < NEOPIXEL_BYTES; i++) {
+      const uint8_t b = pixels[i];
+      for (uint8_t mask = 0x80; mask; mask >>= 1, p += HAL_NEOPIXEL_DMA_STRIDE)
+        *p = (b & mask) ? dma_bit1 : dma_bit0;
+    }
+    *p = 0;
+
+    dma_pending = false;
+    HAL::neopixel_dma_send(dma_buffer, COUNT(dma_buffer));
+
+    // 1.25 us for each period, the first one before the first bit
+    dma_free_us = micros() + ((NEOPIXEL_BYTES * 8 + 2) * 5UL) / 4 + (NEOPIXEL_RESET_US);
+  }
+
+#endif
+
 #endif // ENABLED(NEOPIXEL_LED)
@@ -42,6 +42,11 @@
 
 #define NEO_BLACK   0, 0, 0, 0
 
+#if ENABLED(NEOPIXEL_DMA)
+  #define NEOPIXEL_BYTES    ((NEOPIXEL_PIXELS) * (NEOPIXEL_IS_RGB ? 3 : 4))
+  #define NEOPIXEL_RESET_US 300   // Low time to latch a frame
+#endif
+
 class Neopixel {
 
   public: /** Constructor */
@@ -57,6 +62,30 @@ class Neopixel {
     static void setup();
     static void set_color(const uint32_t color);
 
+    #if ENABLED(NEOPIXEL_DMA)
+      static void show();
+      static void spin();
+    #else
+      static inline void show() { strip.show(); }
+    #endif
+
+  #if ENABLED(NEOPIXEL_DMA)
+
+    private: /** Private Parameters */
+
+      static bool     dma_ready,
+                      dma_pending;
+      static uint16_t dma_bit0,
+                      dma_bit1,
+                      dma_buffer[(NEOPIXEL_BYTES * 8 + 1) * HAL_NEOPIXEL_DMA_STRIDE];
+      static uint32_t dma_free_us;
+
+    private: /** Private Function */
+
+      static void dma_send();
+
+  #endif
+
 };
 
 extern Neopixel neopixel;
@@ -52,6 +52,16 @@
   #error "DEPENDENCY ERROR: LED_CONTROL_MENU requires an LCD controller."
 #endif
 
+#if ENABLED(NEOPIXEL_DMA)
+  #if DISABLED(NEOPIXEL_LED)
+    #error "DEPENDENCY ERROR: NEOPIXEL_DMA requires NEOPIXEL_LED."
+  #elif DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_STM32)
+    #error "DEPENDENCY ERROR: NEOPIXEL_DMA is only available on Arduino DUE and STM32."
+  #elif ENABLED(ARDUINO_ARCH_STM32) && (DISABLED(NEOPIXEL_DMA_STREAM) || DISABLED(NEOPIXEL_DMA_CHANNEL))
+    #error "DEPENDENCY ERROR: Missing setting NEOPIXEL_DMA_STREAM or NEOPIXEL_DMA_CHANNEL."
+  #endif
+#endif
+
 #if ENABLED(CASE_LIGHT_USE_NEOPIXEL) && DISABLED(NEOPIXEL_LED)
   #error "DEPENDENCY ERROR: CASE_LIGHT_USE_NEOPIXEL requires NEOPIXEL_LED."
 #endif
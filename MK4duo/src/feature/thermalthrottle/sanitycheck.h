@@ -0,0 +1,40 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+#if ENABLED(THERMAL_THROTTLE)
+  #if !HAS_MCU_TEMPERATURE && !(HAS_TRINAMIC && ENABLED(MONITOR_DRIVER_STATUS))
+    #error "DEPENDENCY ERROR: THERMAL_THROTTLE requires a board with the MCU temperature or TMC drivers with MONITOR_DRIVER_STATUS."
+  #elif DISABLED(THERMAL_THROTTLE_MCU_START) || DISABLED(THERMAL_THROTTLE_MIN_PERCENT) || DISABLED(THERMAL_THROTTLE_OTPW_STEP) || DISABLED(THERMAL_THROTTLE_RECOVER)
+    #error "DEPENDENCY ERROR: Missing setting THERMAL_THROTTLE_MCU_START, THERMAL_THROTTLE_MIN_PERCENT, THERMAL_THROTTLE_OTPW_STEP or THERMAL_THROTTLE_RECOVER."
+  #elif !WITHIN(THERMAL_THROTTLE_MIN_PERCENT, 10, 100)
+    #error "DEPENDENCY ERROR: THERMAL_THROTTLE_MIN_PERCENT must be from 10 to 100."
+  #elif !WITHIN(THERMAL_THROTTLE_OTPW_STEP, 1, 50)
+    #error "DEPENDENCY ERROR: THERMAL_THROTTLE_OTPW_STEP must be from 1 to 50."
+  #endif
+#endif
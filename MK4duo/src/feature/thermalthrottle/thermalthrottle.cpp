@@ -0,0 +1,77 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(THERMAL_THROTTLE)
+
+ThermalThrottle thermalthrottle;
+
+/** Public Parameters */
+uint8_t ThermalThrottle::percent  = 100;
+float   ThermalThrottle::factor   = 1.0f;
+
+/** Public Function */
+void ThermalThrottle::spin() {
+
+  static short_timer_t check_timer(millis());
+  if (!check_timer.expired(1000)) return;
+
+  uint8_t new_percent = 100;
+
+  // Linear from the start temperature to the MCU alarm
+  #if HAS_MCU_TEMPERATURE
+    const int16_t mcu_temp  = tempManager.mcu_current_temperature,
+                  mcu_alarm = tempManager.mcu_alarm_temperature;
+    if (mcu_temp >= mcu_alarm)
+      new_percent = THERMAL_THROTTLE_MIN_PERCENT;
+    else if (mcu_temp > THERMAL_THROTTLE_MCU_START)
+      new_percent = 100 - (100 - (THERMAL_THROTTLE_MIN_PERCENT)) * (mcu_temp - (THERMAL_THROTTLE_MCU_START)) / (mcu_alarm - (THERMAL_THROTTLE_MCU_START));
+  #endif
+
+  // A step down for each check with a driver in pre-warning, a step back after a while with none
+  #if HAS_TRINAMIC && ENABLED(MONITOR_DRIVER_STATUS)
+    static uint8_t  driver_percent = 100,
+                    recover_count  = 0;
+    bool otpw = false;
+    LOOP_DRV() if (driver[d] && driver[d]->tmc && driver[d]->tmc->otpw_count) otpw = true;
+    if (otpw) {
+      driver_percent = MAX(int16_t(driver_percent) - (THERMAL_THROTTLE_OTPW_STEP), int16_t(THERMAL_THROTTLE_MIN_PERCENT));
+      recover_count = 0;
+    }
+    else if (driver_percent < 100 && ++recover_count >= THERMAL_THROTTLE_RECOVER) {
+      driver_percent = MIN(driver_percent + (THERMAL_THROTTLE_OTPW_STEP), 100);
+      recover_count = 0;
+    }
+    NOMORE(new_percent, driver_percent);
+  #endif
+
+  if (new_percent != percent) {
+    percent = new_percent;
+    factor = percent * 0.01f;
+    SERIAL_LMV(ECHO, "Thermal throttle feedrate ", int(percent));
+  }
+
+}
+
+#endif // ENABLED(THERMAL_THROTTLE)
@@ -0,0 +1,51 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * thermalthrottle.h
+ *
+ * Feedrate scaled down with the temperature of the MCU and of the TMC drivers
+ */
+
+#if ENABLED(THERMAL_THROTTLE)
+
+class ThermalThrottle {
+
+  public: /** Constructor */
+
+    ThermalThrottle() {}
+
+  public: /** Public Parameters */
+
+    static uint8_t  percent;  // Feedrate allowed by the temperatures, 100 when cool
+    static float    factor;   // percent as a multiplier, for MMS_SCALED
+
+  public: /** Public Function */
+
+    static void spin();
+
+};
+
+extern ThermalThrottle thermalthrottle;
+
+#endif // ENABLED(THERMAL_THROTTLE)
@@ -0,0 +1,56 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * sanitycheck.h
+ *
+ * Test configuration values for errors at compile-time.
+ */
+
+#if ENABLED(TOOLBOARD)
+  #if DISABLED(TOOLBOARD_SERIAL) || TOOLBOARD_SERIAL < 1
+    #error "DEPENDENCY ERROR: TOOLBOARD requires a TOOLBOARD_SERIAL port."
+  #elif DISABLED(TOOLBOARD_BAUDRATE)
+    #error "DEPENDENCY ERROR: Missing setting TOOLBOARD_BAUDRATE."
+  #elif DISABLED(TOOLBOARD_TOOL_NODE)
+    #error "DEPENDENCY ERROR: Missing setting TOOLBOARD_TOOL_NODE."
+  #elif ENABLED(ARDUINO_ARCH_SAMD) || ENABLED(ARDUINO_ARCH_NATIVE)
+    #error "DEPENDENCY ERROR: TOOLBOARD is not supported on this platform."
+  #elif ENABLED(LIN_ADVANCE)
+    #error "DEPENDENCY ERROR: TOOLBOARD is not compatible with LIN_ADVANCE, the nodes run their E without advance."
+  #elif ENABLED(COLOR_MIXING_EXTRUDER)
+    #error "DEPENDENCY ERROR: TOOLBOARD is not compatible with COLOR_MIXING_EXTRUDER."
+  #elif HAS_MMU2 && MMU2_SERIAL == TOOLBOARD_SERIAL
+    #error "DEPENDENCY ERROR: TOOLBOARD_SERIAL and MMU2_SERIAL must be different."
+  #endif
+#endif
+
+#if DISABLED(TOOLBOARD) && (TEMP_SENSOR_HE0 == 12 || TEMP_SENSOR_HE1 == 12 || TEMP_SENSOR_HE2 == 12 || TEMP_SENSOR_HE3 == 12 || TEMP_SENSOR_HE4 == 12 || TEMP_SENSOR_HE5 == 12)
+  #error "DEPENDENCY ERROR: TEMP_SENSOR 12 requires TOOLBOARD."
+#endif
+
+#if TEMP_SENSOR_BED0 == 12 || TEMP_SENSOR_BED1 == 12 || TEMP_SENSOR_BED2 == 12 || TEMP_SENSOR_BED3 == 12 \
+ || TEMP_SENSOR_CHAMBER0 == 12 || TEMP_SENSOR_CHAMBER1 == 12 || TEMP_SENSOR_CHAMBER2 == 12 || TEMP_SENSOR_CHAMBER3 == 12 \
+ || TEMP_SENSOR_COOLER == 12
+  #error "DEPENDENCY ERROR: TEMP_SENSOR 12 (Toolboard) is only for the hotends."
+#endif
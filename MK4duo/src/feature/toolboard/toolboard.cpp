@@ -0,0 +1,202 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * toolboard.cpp
+ *
+ * Hotends and extruders on expansion boards (nodes) on a UART bus
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+#include "sanitycheck.h"
+
+#if ENABLED(TOOLBOARD)
+
+#define TB_START            0xA5
+#define TB_BROADCAST        0xFF
+#define TB_POLL_MS          (100 / (EXTRUDERS))   // Each node polled every 100ms
+#define TB_TIMEOUT_MS       2000                  // A node silent for longer is lost
+
+#define TB_STATUS_FAULT     0                     // Report status bits
+#define TB_STATUS_LOST      1
+
+Toolboard toolboard;
+
+/** Public Parameters */
+toolboard_node_t Toolboard::node[TOOLBOARD_MAX_NODES];
+
+/** Private Parameters */
+uint8_t Toolboard::rx_buffer[16],
+        Toolboard::rx_index     = 0,
+        Toolboard::poll_index   = 0,
+        Toolboard::segment_seq  = 0;
+
+volatile bool Toolboard::overrun = false;
+
+short_timer_t Toolboard::poll_timer;
+
+constexpr int8_t tool_nodes[] = TOOLBOARD_TOOL_NODE;
+
+// CRC-8 (poly 0x07) of the frame from the address to the end of the payload
+static uint8_t crc8(uint8_t crc, const uint8_t b) {
+  crc ^= b;
+  LOOP_L_N(i, 8) crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+  return crc;
+}
+
+/** Public Function */
+void Toolboard::init() {
+  toolboardSerial.begin(TOOLBOARD_BAUDRATE);
+  LOOP_L_N(n, TOOLBOARD_MAX_NODES) node[n].report_ms = 0;
+  reset_segments();
+  poll_timer.start();
+}
+
+void Toolboard::spin() {
+
+  receive();
+
+  if (overrun) {
+    overrun = false;
+    SERIAL_LM(ER, "Toolboard: TX buffer full, E segment lost");
+  }
+
+  // Poll one node at a time with the target of its hotend, the heartbeat of the node
+  if (poll_timer.expired(TB_POLL_MS)) {
+    const uint8_t t = poll_index;
+    if (++poll_index >= EXTRUDERS) poll_index = 0;
+    const int8_t n = tool_node(t);
+    if (n >= 0) {
+      const int16_t target = t < tempManager.heater.hotends && hotends[t]->isActive()
+        ? (hotends[t]->isIdle() ? hotends[t]->deg_idle() : hotends[t]->deg_target())
+        : 0;
+      const uint8_t payload[] = { lowByte(target), highByte(target) };
+      // A segment of the Stepper ISR mustn't enter in the middle of the frame
+      const bool isr_enabled = STEPPER_ISR_ENABLED();
+      if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+      send_frame(n, TB_TARGET, payload, sizeof(payload));
+      if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+    }
+  }
+
+}
+
+int8_t Toolboard::tool_node(const uint8_t tool) {
+  return tool < COUNT(tool_nodes) ? tool_nodes[tool] : -1;
+}
+
+float Toolboard::temperature(const uint8_t tool) {
+  const int8_t n = tool_node(tool);
+  if (n < 0) return ABS_ZERO;
+  const toolboard_node_t &nd = node[n];
+  if (!nd.report_ms || ELAPSED(millis(), nd.report_ms + TB_TIMEOUT_MS)) return ABS_ZERO;
+  if (TEST(nd.status, TB_STATUS_FAULT)) return 2000;
+  return nd.temperature;
+}
+
+void Toolboard::block_start(const block_t * const block) {
+
+  if (!block->steps.e) return;
+  const int8_t n = tool_node(block->active_extruder);
+  if (n < 0) return;
+
+  // The node runs the same trapezoid as the main stepper, for the E only
+  const uint32_t values[] = {
+    block->steps.e, block->step_event_count,
+    block->initial_rate, block->nominal_rate, block->final_rate,
+    block->acceleration_steps_per_s2,
+    block->accelerate_until, block->decelerate_after
+  };
+  uint8_t payload[2 + sizeof(values)];
+  payload[0] = segment_seq++;
+  payload[1] = TEST(block->direction_bits, E_AXIS);
+  memcpy(&payload[2], values, sizeof(values));    // All the targets are little endian
+
+  // Never wait in the ISR: a frame that doesn't fit is dropped and reported
+  if (toolboardSerial.availableForWrite() < sizeof(payload) + 5)
+    overrun = true;
+  else
+    send_frame(n, TB_SEGMENT, payload, sizeof(payload));
+
+}
+
+void Toolboard::reset_segments() {
+  const bool isr_enabled = STEPPER_ISR_ENABLED();
+  if (isr_enabled) DISABLE_STEPPER_INTERRUPT();
+  send_frame(TB_BROADCAST, TB_RESET, nullptr, 0);
+  segment_seq = 0;
+  if (isr_enabled) ENABLE_STEPPER_INTERRUPT();
+}
+
+/** Private Function */
+void Toolboard::send_frame(const uint8_t addr, const ToolboardFrameEnum cmd, const uint8_t * const payload, const uint8_t len) {
+  uint8_t crc = crc8(crc8(crc8(0, addr), cmd), len);
+  toolboardSerial.write(uint8_t(TB_START));
+  toolboardSerial.write(addr);
+  toolboardSerial.write(uint8_t(cmd));
+  toolboardSerial.write(len);
+  LOOP_L_N(i, len) {
+    toolboardSerial.write(payload[i]);
+    crc = crc8(crc, payload[i]);
+  }
+  toolboardSerial.write(crc);
+}
+
+/**
+ * Read the reports of the nodes:
+ *  A5 <node> 'r' 04 <temp x10 lo> <temp x10 hi> <pwm> <status> <crc>
+ */
+void Toolboard::receive() {
+
+  while (toolboardSerial.available()) {
+    const uint8_t c = toolboardSerial.read();
+
+    if (rx_index == 0 && c != TB_START) continue;   // Wait the start of a frame
+    rx_buffer[rx_index++] = c;
+
+    if (rx_index < 4) continue;                     // Start, node, command and length
+    const uint8_t len = rx_buffer[3];
+    if (len > sizeof(rx_buffer) - 5) { rx_index = 0; continue; }
+    if (rx_index < len + 5) continue;
+
+    uint8_t crc = 0;
+    LOOP_S_L_N(i, 1, len + 4) crc = crc8(crc, rx_buffer[i]);
+    const uint8_t n = rx_buffer[1];
+
+    if (crc == rx_buffer[len + 4] && rx_buffer[2] == TB_REPORT && len == 4 && n < TOOLBOARD_MAX_NODES) {
+      toolboard_node_t &nd = node[n];
+      nd.temperature  = int16_t(rx_buffer[4] | (rx_buffer[5] << 8)) * 0.1f;
+      nd.pwm          = rx_buffer[6];
+      nd.status       = rx_buffer[7];
+      nd.report_ms    = millis() | 1;               // 0 is never
+      if (TEST(nd.status, TB_STATUS_LOST))
+        SERIAL_LMV(ER, "Toolboard: E segment lost on node ", int(n));
+    }
+
+    rx_index = 0;
+  }
+
+}
+
+#endif // ENABLED(TOOLBOARD)
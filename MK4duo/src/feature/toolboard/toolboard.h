@@ -0,0 +1,108 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * toolboard.h
+ *
+ * Hotends and extruders on expansion boards (nodes) on a UART bus
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(TOOLBOARD)
+
+#define TOOLBOARD_MAX_NODES 8
+
+// The frames of the bus, see serial-protocol.md
+enum ToolboardFrameEnum : uint8_t {
+  TB_RESET    = 'R',  // main => all : drop the segments
+  TB_TARGET   = 'T',  // main => node: target temperature, poll and heartbeat
+  TB_SEGMENT  = 'S',  // main => node: the E of the block the stepper starts
+  TB_REPORT   = 'r'   // node => main: temperature, output and status
+};
+
+struct toolboard_node_t {
+  float     temperature;  // Last reported, in °C
+  uint8_t   pwm,          // Last reported output of the node heater
+            status;       // Last reported status bits
+  millis_l  report_ms;    // Time of the last report, 0 never
+};
+
+class Toolboard {
+
+  public: /** Constructor */
+
+    Toolboard() {}
+
+  public: /** Public Parameters */
+
+    static toolboard_node_t node[TOOLBOARD_MAX_NODES];
+
+  private: /** Private Parameters */
+
+    static uint8_t  rx_buffer[16],
+                    rx_index,
+                    poll_index,       // The next tool to poll
+                    segment_seq;      // Sequence of the segments, for the lost ones
+
+    static volatile bool overrun;     // A segment didn't fit the TX buffer
+
+    static short_timer_t poll_timer;
+
+  public: /** Public Function */
+
+    static void init();
+    static void spin();
+
+    /**
+     * Node of the tool, -1 if on the main board
+     */
+    static int8_t tool_node(const uint8_t tool);
+
+    /**
+     * Temperature of the remote hotend for the heater: ABS_ZERO when
+     * the node is silent and 2000 on its fault, for the min/max temp errors
+     */
+    static float temperature(const uint8_t tool);
+
+    /**
+     * Called by the Stepper ISR at the start of each block:
+     * the E of a remote extruder goes to its node
+     */
+    static void block_start(const block_t * const block);
+
+    /**
+     * Called by the quick stop: the nodes drop their segments
+     */
+    static void reset_segments();
+
+  private: /** Private Function */
+
+    static void send_frame(const uint8_t addr, const ToolboardFrameEnum cmd, const uint8_t * const payload, const uint8_t len);
+    static void receive();
+
+};
+
+extern Toolboard toolboard;
+
+#endif // ENABLED(TOOLBOARD)
@@ -144,6 +144,8 @@
 #define MSG_HOST_ERR_LINE_NO                    "Line Number is not Last Line Number+1, Last Line: "
 #define MSG_HOST_ERR_CHECKSUM_MISMATCH          "checksum mismatch, Last Line: "
 #define MSG_HOST_ERR_NO_CHECKSUM                "No Checksum with line number, Last Line: "
+#define MSG_HOST_ERR_BINARY_CODE                "Binary G-code not G0-G3, Last Line: "
+#define MSG_HOST_ERR_BINARY_FULL                "Command buffer full, Last Line: "
 #define MSG_HOST_FILE_PRINTED                   "Done printing file"
 #define MSG_HOST_BEGIN_FILE_LIST                "Begin file list"
 #define MSG_HOST_END_FILE_LIST                  "End file list"
@@ -272,6 +274,14 @@
 #define MSG_HOST_PID_TEMP_TOO_HIGH              MSG_HOST_PID_AUTOTUNE_FAILED " Temperature too high"
 #define MSG_HOST_PID_TEMP_TOO_LOW               MSG_HOST_PID_AUTOTUNE_FAILED " Temperature too low"
 #define MSG_HOST_PID_TIMEOUT                    MSG_HOST_PID_AUTOTUNE_FAILED " timeout"
+#define MSG_HOST_MPC_AUTOTUNE_PREFIX            "MPC Autotune"
+#define MSG_HOST_MPC_AUTOTUNE_START             MSG_HOST_MPC_AUTOTUNE_PREFIX " start"
+#define MSG_HOST_MPC_AUTOTUNE_FAILED            MSG_HOST_MPC_AUTOTUNE_PREFIX " failed!"
+#define MSG_HOST_MPC_AUTOTUNE_FINISHED          MSG_HOST_MPC_AUTOTUNE_PREFIX " finished! Put the constants from below into Configuration!"
+#define MSG_HOST_MPC_COOLING_TO_AMBIENT         MSG_HOST_MPC_AUTOTUNE_PREFIX " cooling to ambient"
+#define MSG_HOST_MPC_HEATING_PAST               MSG_HOST_MPC_AUTOTUNE_PREFIX " heating past "
+#define MSG_HOST_MPC_MEASURING_AMBIENT          MSG_HOST_MPC_AUTOTUNE_PREFIX " measuring heat loss at "
+#define MSG_HOST_MPC_TIMEOUT                    MSG_HOST_MPC_AUTOTUNE_FAILED " timeout"
 #define MSG_HOST_BIAS                           " bias:"
 #define MSG_HOST_D                              " d:"
 #define MSG_HOST_T_MIN                          " min:"
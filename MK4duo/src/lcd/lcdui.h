@@ -397,6 +397,9 @@ class LcdUI {
       #endif
       static void update_buttons();
       static bool button_pressed();
+      #if ENABLED(LCD_ENCODER_ISR)
+        static void encoder_isr();
+      #endif
       #if ENABLED(AUTO_BED_LEVELING_UBL) || ENABLED(G26_MESH_VALIDATION)
         static void wait_for_release();
       #endif
@@ -431,8 +434,15 @@ class LcdUI {
       static void _synchronize();
     #endif
 
+    #if ENABLED(LCD_ENCODER_ISR)
+      static bool encoder_events();
+    #endif
+
     #if HAS_SPI_LCD
       static void draw_status_screen();
+      #if HAS_GRAPHICAL_LCD && ENABLED(STATUS_SCREEN_CHANGE_TRACKING)
+        static bool status_screen_changed();
+      #endif
       static void finish_status(const bool persist);
     #else
       static inline void finish_status(const bool persist) { UNUSED(persist); refresh(); }
@@ -214,17 +214,38 @@
 #if ENABLED(MESH_EDIT_MENU)
 
   inline void refresh_planner() {
+    #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+      abl.refresh_bed_level();
+    #endif
     mechanics.set_position_from_steppers_for_axis(ALL_AXES);
     mechanics.sync_plan_position();
   }
 
+  static uint8_t xind, yind; // =0
+
+  #if ENABLED(MESH_INT16_STORAGE)
+
+    // The mesh point is not a float, edit a copy and store it back
+    static float mesh_edit_z;
+
+    inline void mesh_edit_store() {
+      Z_VALUES(xind, yind) = mesh_edit_z;
+      refresh_planner();
+    }
+
+  #endif
+
   void menu_edit_mesh() {
-    static uint8_t xind, yind; // =0
     START_MENU();
     BACK_ITEM(MSG_BED_LEVELING);
     EDIT_ITEM(int8, MSG_MESH_X, &xind, 0, GRID_MAX_POINTS_X - 1);
     EDIT_ITEM(int8, MSG_MESH_Y, &yind, 0, GRID_MAX_POINTS_Y - 1);
-    EDIT_ITEM_FAST(float43, MSG_MESH_EDIT_Z, &Z_VALUES(xind, yind), -(LCD_PROBE_Z_RANGE) * 0.5, (LCD_PROBE_Z_RANGE) * 0.5, refresh_planner);
+    #if ENABLED(MESH_INT16_STORAGE)
+      mesh_edit_z = Z_VALUES(xind, yind);
+      EDIT_ITEM_FAST(float43, MSG_MESH_EDIT_Z, &mesh_edit_z, -(LCD_PROBE_Z_RANGE) * 0.5, (LCD_PROBE_Z_RANGE) * 0.5, mesh_edit_store);
+    #else
+      EDIT_ITEM_FAST(float43, MSG_MESH_EDIT_Z, &Z_VALUES(xind, yind), -(LCD_PROBE_Z_RANGE) * 0.5, (LCD_PROBE_Z_RANGE) * 0.5, refresh_planner);
+    #endif
     END_MENU();
   }
 
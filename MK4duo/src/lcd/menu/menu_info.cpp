@@ -38,7 +38,7 @@
 void menu_info_stats() {
   if (lcdui.use_click()) return lcdui.goto_previous_screen();
 
-  char buffer[21];
+  char buffer[22];
 
   printStatistics stats = print_job_counter.getStats();
 
@@ -123,6 +123,19 @@ uint8_t NextionLCD::PageID              = 0;
   NexUpload NextionLCD::Firmware(NEXTION_FIRMWARE_FILE, 57600);
 #endif
 
+#if ENABLED(NEXTION_BATCH_SIZE)
+  char      NextionLCD::batch[NEXTION_BATCH_SIZE];
+  uint16_t  NextionLCD::batch_head      = 0,
+            NextionLCD::batch_tail      = 0;
+  bool      NextionLCD::batching        = false;
+#endif
+
+#if ENABLED(NEXTION_GFX_FEED_MS)
+  xyz_pos_t NextionLCD::gfx_feed_pos;
+  bool      NextionLCD::gfx_feed_pending  = false,
+            NextionLCD::gfx_feed_extrude  = false;
+#endif
+
 /**
  *******************************************************************
  * Nextion component for page:menu
@@ -402,15 +415,45 @@ void NextionLCD::read_serial() {
 }
 
 void NextionLCD::sendCommand(const char* cmd) {
-  nexSerial.print(cmd);
+  put(cmd);
   sendCommand_end();
 }
 
 void NextionLCD::sendCommandPGM(PGM_P cmd) {
-  while (char c = pgm_read_byte(cmd++)) nexSerial.write(c);
+  while (char c = pgm_read_byte(cmd++)) put(c);
   sendCommand_end();
 }
 
+/**
+ * All the bytes to the display go here. In the status update they go in
+ * the batch, sent by batch_drain() as the serial has room, so the update
+ * never waits for the serial. Out of the batch the bytes pending go first.
+ */
+void NextionLCD::put(const char c) {
+  #if ENABLED(NEXTION_BATCH_SIZE)
+    if (batching) {
+      if (batch_head == NEXTION_BATCH_SIZE) batch_drain(true);
+      batch[batch_head++] = c;
+      return;
+    }
+    if (batch_tail != batch_head) batch_drain(true);
+  #endif
+  nexSerial.write(c);
+}
+
+#if ENABLED(NEXTION_BATCH_SIZE)
+
+  void NextionLCD::batch_drain(const bool all/*=false*/) {
+    uint16_t count = batch_head - batch_tail;
+    #if ENABLED(ARDUINO_ARCH_STM32) || TX_BUFFER_SIZE > 0
+      if (!all) NOMORE(count, uint16_t(nexSerial.availableForWrite()));
+    #endif
+    while (count--) nexSerial.write(batch[batch_tail++]);
+    if (batch_tail == batch_head) batch_head = batch_tail = 0;
+  }
+
+#endif
+
 void NextionLCD::status_screen_update() {
 
   static uint8_t    PreviousPage          = 0xFF,
@@ -421,6 +464,19 @@ void NextionLCD::status_screen_update() {
 
   static int16_t    PreviousDegHotend[MAX_HOTEND] = { 0xFFFF };
 
+  #if ENABLED(NEXTION_BATCH_SIZE)
+    static int16_t  PreviousCurHotend[MAX_HOTEND] = { 0xFFFF };
+    #if HAS_BEDS
+      static int16_t  PreviousCurBed      = 0xFFFF;
+    #endif
+    #if HAS_CHAMBERS
+      static int16_t  PreviousCurChamber  = 0xFFFF;
+    #endif
+    #define CHANGED(P,V) (P != int16_t(V) && ((P = int16_t(V)), true))
+  #else
+    #define CHANGED(P,V) true
+  #endif
+
   #if HAS_BEDS
     static int16_t  PreviousDegBed        = 0xFFFF;
   #endif
@@ -441,6 +497,11 @@ void NextionLCD::status_screen_update() {
 
   if (!NextionON) return;
 
+  #if ENABLED(NEXTION_BATCH_SIZE)
+    if (batch_tail != batch_head) return;   // The display has not got the last update yet
+    batching = true;
+  #endif
+
   #if ENABLED(NEXTION_GFX)
     if (printer.isPrinting()) {
       if (!GfxVis) {
@@ -462,6 +523,16 @@ void NextionLCD::status_screen_update() {
       #if ENABLED(NEXTION_GFX)
         mechanics.nextion_gfx_clear();
       #endif
+      #if ENABLED(NEXTION_BATCH_SIZE)
+        // New page, send all the temperatures
+        LOOP_HOTEND() PreviousCurHotend[h] = 0xFFFF;
+        #if HAS_BEDS
+          PreviousCurBed = 0xFFFF;
+        #endif
+        #if HAS_CHAMBERS
+          PreviousCurChamber = 0xFFFF;
+        #endif
+      #endif
     }
 
     #if HAS_FAN
@@ -482,7 +553,8 @@ void NextionLCD::status_screen_update() {
 
     #if HAS_HOTENDS
       for (uint8_t h = 0; h < max_hotends; h++) {
-        setValue(Hotend_deg[h], hotends[h]->deg_current());
+        if (CHANGED(PreviousCurHotend[h], hotends[h]->deg_current()))
+          setValue(Hotend_deg[h], hotends[h]->deg_current());
         if (PreviousDegHotend[h] != hotends[h]->deg_target()) {
           setValue(Hotend_trg[h], hotends[h]->deg_target());
           PreviousDegHotend[h] = hotends[h]->deg_target();
@@ -491,7 +563,8 @@ void NextionLCD::status_screen_update() {
     #endif
     #if HAS_BEDS
       if (tempManager.heater.beds) {
-        setValue(Bed_deg, beds[0]->deg_current());
+        if (CHANGED(PreviousCurBed, beds[0]->deg_current()))
+          setValue(Bed_deg, beds[0]->deg_current());
         if (PreviousDegBed != beds[0]->deg_target()) {
           setValue(Bed_trg, beds[0]->deg_target());
           PreviousDegBed = beds[0]->deg_target();
@@ -500,7 +573,8 @@ void NextionLCD::status_screen_update() {
     #endif
     #if HAS_CHAMBERS
       if (tempManager.heater.chambers) {
-        setValue(Chamber_deg, chambers[0]->deg_current());
+        if (CHANGED(PreviousCurChamber, chambers[0]->deg_current()))
+          setValue(Chamber_deg, chambers[0]->deg_current());
         if (PreviousDegChamber != chambers[0]->deg_target()) {
           setValue(Chamber_trg, chambers[0]->deg_target());
           PreviousDegChamber = chambers[0]->deg_target();
@@ -584,6 +658,13 @@ void NextionLCD::status_screen_update() {
 
   PreviousPage = PageID;
 
+  #if ENABLED(NEXTION_BATCH_SIZE)
+    batching = false;
+    batch_drain();
+  #endif
+
+  #undef CHANGED
+
 }
 
 void NextionLCD::moveto(const uint8_t col, const uint8_t row) {
@@ -594,24 +675,24 @@ void NextionLCD::moveto(const uint8_t col, const uint8_t row) {
 void NextionLCD::setText(NexObject &nexobject, PGM_P buffer) {
   char cmd[NEXTION_MAX_MESSAGE_LENGTH + 5];
   sprintf_P(cmd, PSTR("p[%u].b[%u].txt="), nexobject.pid, nexobject.cid);
-  nexSerial.print(cmd);
+  put(cmd);
   sprintf_P(cmd, PSTR("\"%s\""), buffer);
-  nexSerial.print(cmd);
+  put(cmd);
   sendCommand_end();
 }
 
 void NextionLCD::startChar(NexObject &nexobject) {
   char cmd[NEXTION_BUFFER_SIZE] = { 0 };
   sprintf_P(cmd, PSTR("p[%u].b[%u].txt=\""), nexobject.pid, nexobject.cid);
-  nexSerial.print(cmd);
+  put(cmd);
 }
 
 void NextionLCD::setChar(const char pchar) {
-  nexSerial.write(pchar);
+  put(pchar);
 }
 
 void NextionLCD::endChar() {
-  nexSerial.print("\"");
+  put('"');
   sendCommand_end();
 }
 
@@ -746,6 +827,9 @@ void NextionLCD::Set_font_color_pco(NexObject &nexobject, const uint16_t number)
     if (PageID == 2 && printer.isPrinting()) {
       const xyz_pos_t pos = { x, y, z };
       gfx.clear(pos);
+      #if ENABLED(NEXTION_GFX_FEED_MS)
+        gfx_feed_pending = gfx_feed_extrude = false;
+      #endif
     }
   }
 
@@ -765,7 +849,7 @@ void NextionLCD::Set_font_color_pco(NexObject &nexobject, const uint16_t number)
         pos.x += mechanics.data.print_radius;
         pos.y += mechanics.data.print_radius;
       #endif
-      #if ENABLED(ARDUINO_ARCH_SAM)
+      #if ENABLED(ARDUINO_ARCH_SAM) && DISABLED(NEXTION_GFX_FEED_MS)
         gfx.line_to(NX_TOOL, pos, true);
       #else
         gfx.line_to(NX_TOOL, pos);
@@ -786,6 +870,44 @@ void NextionLCD::Set_font_color_pco(NexObject &nexobject, const uint16_t number)
     }
   }
 
+  #if ENABLED(NEXTION_GFX_FEED_MS)
+
+    /**
+     * The moves only keep the last end point, the preview draws it at most
+     * once every NEXTION_GFX_FEED_MS as a single line, so the cost is the
+     * same at any segment rate. The moves in the interval are decimated.
+     */
+    void NextionLCD::gfx_feed(const xyz_pos_t &pos, const bool extrude) {
+      gfx_feed_pos = pos;
+      if (extrude) gfx_feed_extrude = true;
+      gfx_feed_pending = true;
+    }
+
+    void NextionLCD::gfx_feed_spin() {
+      static short_timer_t feed_timer(millis());
+
+      if (!gfx_feed_pending || !feed_timer.expired(NEXTION_GFX_FEED_MS)) return;
+
+      #if ENABLED(NEXTION_BATCH_SIZE)
+        if (batch_tail != batch_head) return;   // The display has not got the last update yet
+        batching = true;
+      #endif
+
+      if (gfx_feed_extrude)
+        gfx_line_to(gfx_feed_pos);
+      else
+        gfx_cursor_to(gfx_feed_pos);
+
+      gfx_feed_pending = gfx_feed_extrude = false;
+
+      #if ENABLED(NEXTION_BATCH_SIZE)
+        batching = false;
+        batch_drain();
+      #endif
+    }
+
+  #endif
+
 #endif
 
 #if ENABLED(RFID_MODULE)
@@ -1312,6 +1434,14 @@ void LcdUI::update() {
 
   #endif // HAS_SD_SUPPORT
 
+  #if ENABLED(NEXTION_BATCH_SIZE)
+    nexlcd.batch_drain();
+  #endif
+
+  #if ENABLED(NEXTION_GFX_FEED_MS)
+    nexlcd.gfx_feed_spin();
+  #endif
+
   if (next_lcd_update_timer.expired(LCD_UPDATE_INTERVAL))
     nexlcd.status_screen_update();
 
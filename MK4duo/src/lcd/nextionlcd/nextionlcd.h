@@ -173,6 +173,19 @@ class NextionLCD {
       static NexUpload Firmware;
     #endif
 
+    #if ENABLED(NEXTION_BATCH_SIZE)
+      static char     batch[NEXTION_BATCH_SIZE];  // Commands of the status update, sent with no wait
+      static uint16_t batch_head,
+                      batch_tail;
+      static bool     batching;
+    #endif
+
+    #if ENABLED(NEXTION_GFX_FEED_MS)
+      static xyz_pos_t  gfx_feed_pos;       // Last end point of the moves, not yet in the preview
+      static bool       gfx_feed_pending,
+                        gfx_feed_extrude;
+    #endif
+
   public: /** Public Function */
 
     static void init();
@@ -184,6 +197,10 @@ class NextionLCD {
 
     static void status_screen_update();
 
+    #if ENABLED(NEXTION_BATCH_SIZE)
+      static void batch_drain(const bool all=false);
+    #endif
+
     static void moveto(const uint8_t col, const uint8_t row);
     static void setText(NexObject &nexobject, PGM_P buffer);
     static void startChar(NexObject &nexobject);
@@ -211,6 +228,10 @@ class NextionLCD {
       static void gfx_cursor_to(xyz_pos_t pos, bool force_cursor=false);
       static void gfx_line_to(xyz_pos_t pos);
       static void gfx_plane_to(xyz_pos_t pos);
+      #if ENABLED(NEXTION_GFX_FEED_MS)
+        static void gfx_feed(const xyz_pos_t &pos, const bool extrude);
+        static void gfx_feed_spin();
+      #endif
     #endif
 
     #if ENABLED(RFID_MODULE)
@@ -239,7 +260,10 @@ class NextionLCD {
 
     static bool getConnect(char* buffer);
 
-    FORCE_INLINE static void sendCommand_end() { nexSerial.write(end, 3); }
+    static void put(const char c);
+    static void put(const char* str) { while (*str) put(*str++); }
+
+    FORCE_INLINE static void sendCommand_end() { put(char(end[0])); put(char(end[1])); put(char(end[2])); }
 
     FORCE_INLINE static void clear_rx() { while (nexSerial.available()) (void)nexSerial.read(); }
 
@@ -192,6 +192,17 @@ static_assert(1 >= 0
   #endif
 #endif
 
+// Encoder read in the HAL tick
+#if ENABLED(LCD_ENCODER_ISR)
+  #if !HAS_LCD_MENU || !HAS_DIGITAL_BUTTONS
+    #error "DEPENDENCY ERROR: LCD_ENCODER_ISR requires an LCD MENU with the buttons on pins."
+  #elif !(BUTTON_EXISTS(EN1) && BUTTON_EXISTS(EN2) && BUTTON_EXISTS(ENC))
+    #error "DEPENDENCY ERROR: LCD_ENCODER_ISR requires BTN_EN1, BTN_EN2 and BTN_ENC."
+  #elif ENABLED(LCD_I2C_VIKI) || ENABLED(REPRAPWORLD_KEYPAD)
+    #error "DEPENDENCY ERROR: LCD_ENCODER_ISR is not compatible with the buttons of LCD_I2C_VIKI or REPRAPWORLD_KEYPAD."
+  #endif
+#endif
+
 // LCD_BED_LEVELING requirements
 #if ENABLED(LCD_BED_LEVELING)
   #if !HAS_LCD_MENU
@@ -237,3 +248,39 @@ static_assert(1 >= 0
 #if ENCODER_PULSES_PER_STEP < 0
   #error "DEPENDENCY ERROR: ENCODER_PULSES_PER_STEP should not be negative, use REVERSE_MENU_DIRECTION instead."
 #endif
+#if ENABLED(STATUS_SCREEN_CHANGE_TRACKING) && !HAS_GRAPHICAL_LCD
+  #error "DEPENDENCY ERROR: STATUS_SCREEN_CHANGE_TRACKING requires a graphical LCD."
+#endif
+#if ENABLED(ST7920_FRAME_DIFF)
+  #if DISABLED(U8GLIB_ST7920)
+    #error "DEPENDENCY ERROR: ST7920_FRAME_DIFF requires an ST7920 graphical LCD."
+  #elif defined(__AVR__)
+    #error "DEPENDENCY ERROR: ST7920_FRAME_DIFF is not available on AVR."
+  #endif
+#endif
+#if ENABLED(LCD_SHADOW_WRITES) && !HAS_CHARACTER_LCD
+  #error "DEPENDENCY ERROR: LCD_SHADOW_WRITES requires a character LCD."
+#endif
+#if ENABLED(LCD_UPDATE_BUDGET_CHARS)
+  #if !HAS_CHARACTER_LCD
+    #error "DEPENDENCY ERROR: LCD_UPDATE_BUDGET_CHARS requires a character LCD."
+  #elif !WITHIN(LCD_UPDATE_BUDGET_CHARS, 1, 255)
+    #error "DEPENDENCY ERROR: LCD_UPDATE_BUDGET_CHARS must be from 1 to 255."
+  #elif LCD_WIDTH > 32
+    #error "DEPENDENCY ERROR: LCD_UPDATE_BUDGET_CHARS requires LCD_WIDTH of 32 or less."
+  #endif
+#endif
+#if ENABLED(NEXTION_GFX_FEED_MS)
+  #if DISABLED(NEXTION_GFX)
+    #error "DEPENDENCY ERROR: NEXTION_GFX_FEED_MS requires NEXTION_GFX."
+  #elif NEXTION_GFX_FEED_MS < 20
+    #error "DEPENDENCY ERROR: NEXTION_GFX_FEED_MS must be 20 or more."
+  #endif
+#endif
+#if ENABLED(NEXTION_BATCH_SIZE)
+  #if DISABLED(NEXTION)
+    #error "DEPENDENCY ERROR: NEXTION_BATCH_SIZE requires NEXTION."
+  #elif NEXTION_BATCH_SIZE < NEXTION_MAX_MESSAGE_LENGTH + 32
+    #error "DEPENDENCY ERROR: NEXTION_BATCH_SIZE is too small for a command."
+  #endif
+#endif
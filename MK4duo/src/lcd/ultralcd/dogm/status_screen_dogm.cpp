@@ -276,12 +276,7 @@ void LcdUI::draw_status_screen() {
     strcpy(zstring, ftostr52sp (LOGICAL_Z_POSITION(mechanics.position.z)));
     #if HAS_LCD_FILAMENT_SENSOR
       strcpy(wstring, ftostr12ns(filament_width_meas));
-      strcpy(mstring, i16tostr3(100.0 * (
-          toolManager.isVolumetric()
-            ? toolManager.volumetric_area_nominal / toolManager.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-            : toolManager.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-        )
-      ));
+      strcpy(mstring, i16tostr3(100.0f * filwidth_factor));
     #endif
 
     duration_t elapsed  = print_job_counter.duration();
@@ -489,7 +484,7 @@ void LcdUI::draw_status_screen() {
         lcd_put_u8str(buffer2);
       }
       else {
-        lcd_put_u8str(54, 48, ui32tostr4(print_job_counter.getConsumptionHour() - powerManager.startpower));
+        lcd_put_u8str(54, 48, ui32tostr4(uint32_t(powerManager.job_energy())));
         lcd_put_u8str((char*)"Wh");
       }
     #endif
@@ -622,6 +617,99 @@ void LcdUI::draw_status_screen() {
   }
 }
 
+#if ENABLED(STATUS_SCREEN_CHANGE_TRACKING)
+
+  static uint32_t status_signature;
+
+  static void status_signature_add(const void * const data, uint8_t len) {
+    const uint8_t *b = (const uint8_t*)data;
+    while (len--) status_signature = (status_signature ^ *b++) * 16777619UL;  // FNV-1a
+  }
+  #define SIGN_ADD(V) do{ const auto _v = (V); status_signature_add(&_v, sizeof(_v)); }while(0)
+
+  /**
+   * The values shown on the Status Screen all go in a signature, so
+   * a redraw with the same signature would send the same pixels.
+   * The blink only counts when something on the screen blinks.
+   */
+  bool LcdUI::status_screen_changed() {
+
+    // Lines that alternate or change with no value to track
+    #if HAS_LCD_FILAMENT_SENSOR || HAS_LCD_POWER_SENSOR || HAS_GRADIENT_MIX
+
+      return true;
+
+    #else
+
+    static uint32_t last_signature = 0;
+
+    if (printer.mode != PRINTER_MODE_FFF) return true;
+
+    status_signature = 2166136261UL;
+
+    bool blinking = false;
+
+    LOOP_HOTEND() {
+      SIGN_ADD(int16_t(hotends[h]->deg_current() + 0.5f));
+      SIGN_ADD(int16_t(hotends[h]->isIdle() ? hotends[h]->deg_idle() : hotends[h]->deg_target()));
+      SIGN_ADD(hotends[h]->isHeating());
+      if (hotends[h]->isIdle()) blinking = true;
+    }
+    #if HAS_BEDS
+      if (tempManager.heater.beds) {
+        SIGN_ADD(int16_t(beds[0]->deg_current() + 0.5f));
+        SIGN_ADD(int16_t(beds[0]->isIdle() ? beds[0]->deg_idle() : beds[0]->deg_target()));
+        SIGN_ADD(beds[0]->isHeating());
+        if (beds[0]->isIdle()) blinking = true;
+      }
+    #endif
+    #if HAS_CHAMBERS
+      if (tempManager.heater.chambers) {
+        SIGN_ADD(int16_t(chambers[0]->deg_current() + 0.5f));
+        SIGN_ADD(int16_t(chambers[0]->deg_target()));
+        SIGN_ADD(chambers[0]->isHeating());
+        if (chambers[0]->isIdle()) blinking = true;
+      }
+    #endif
+
+    #if HAS_FAN
+      if (fanManager.data.fans) {
+        SIGN_ADD(fans[0]->actual_speed());
+        #if STATUS_FAN_FRAMES > 1
+          if (fans[0]->speed) blinking = true;
+        #endif
+      }
+    #endif
+
+    LOOP_XYZ(axis) if (!mechanics.isAxisHomed(AxisEnum(axis))) blinking = true;
+    SIGN_ADD(LROUND(LOGICAL_X_POSITION(mechanics.position.x)));
+    SIGN_ADD(LROUND(LOGICAL_Y_POSITION(mechanics.position.y)));
+    SIGN_ADD(LROUND(LOGICAL_Z_POSITION(mechanics.position.z) * 100));
+    SIGN_ADD(mechanics.feedrate_percentage);
+
+    SIGN_ADD(printer.progress);
+    SIGN_ADD(millis_l(print_job_counter.duration()));
+    if (print_job_counter.isRunning()) blinking = true;
+    #if HAS_SD_SUPPORT
+      SIGN_ADD(card.isFileOpen());
+    #endif
+
+    status_signature_add(status_message, strlen(status_message));
+    #if ENABLED(STATUS_MESSAGE_SCROLLING)
+      if (utf8_strlen(status_message) > LCD_WIDTH) blinking = true;
+    #endif
+
+    if (blinking) SIGN_ADD(get_blink());
+
+    if (status_signature == last_signature) return false;
+    last_signature = status_signature;
+    return true;
+
+    #endif
+  }
+
+#endif // STATUS_SCREEN_CHANGE_TRACKING
+
 void LcdUI::draw_status_message(const bool blink) {
 
   // Get the UTF8 character count of the string
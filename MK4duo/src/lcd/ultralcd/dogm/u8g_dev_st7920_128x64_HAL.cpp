@@ -83,6 +83,11 @@ static const uint8_t u8g_dev_st7920_128x64_HAL_init_seq[] PROGMEM = {
   U8G_ESC_END         // end of sequence
 };
 
+#if ENABLED(ST7920_FRAME_DIFF)
+  // The rows sent to the GDRAM, a row not changed since the last frame is not sent again
+  static uint8_t u8g_dev_st7920_128x64_HAL_frame[LCD_PIXEL_HEIGHT][(LCD_PIXEL_WIDTH) / 8];
+#endif
+
 void clear_graphics_DRAM(u8g_t *u8g, u8g_dev_t *dev) {
   u8g_SetChipSelect(u8g, dev, 1);
   u8g_Delay(1);
@@ -101,6 +106,43 @@ void clear_graphics_DRAM(u8g_t *u8g, u8g_dev_t *dev) {
   u8g_WriteByte(u8g, dev, 0x0C); //display on, cursor+blink off
 
   u8g_SetChipSelect(u8g, dev, 0);
+
+  #if ENABLED(ST7920_FRAME_DIFF)
+    ZERO(u8g_dev_st7920_128x64_HAL_frame);  // As the cleared GDRAM
+  #endif
+}
+
+static void u8g_dev_st7920_128x64_HAL_write_page(u8g_t *u8g, u8g_dev_t *dev, const uint8_t rows) {
+  u8g_pb_t *pb = (u8g_pb_t *)(dev->dev_mem);
+  uint8_t y = pb->p.page_y0;
+  uint8_t *ptr = (uint8_t *)pb->buf;
+
+  u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
+  u8g_SetChipSelect(u8g, dev, 1);
+  for (uint8_t i = 0; i < rows; i++, y++, ptr += (LCD_PIXEL_WIDTH) / 8) {
+
+    #if ENABLED(ST7920_FRAME_DIFF)
+      uint8_t * const sent = u8g_dev_st7920_128x64_HAL_frame[y];
+      if (!memcmp(sent, ptr, (LCD_PIXEL_WIDTH) / 8)) continue;
+      memcpy(sent, ptr, (LCD_PIXEL_WIDTH) / 8);
+    #endif
+
+    u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
+    u8g_WriteByte(u8g, dev, 0x03E );      /* enable extended mode */
+
+    if (y < 32) {
+      u8g_WriteByte(u8g, dev, 0x080 | y );      /* y pos  */
+      u8g_WriteByte(u8g, dev, 0x080  );      /* set x pos to 0*/
+    }
+    else {
+      u8g_WriteByte(u8g, dev, 0x080 | (y-32) );      /* y pos  */
+      u8g_WriteByte(u8g, dev, 0x080 | 8);      /* set x pos to 64*/
+    }
+
+    u8g_SetAddress(u8g, dev, 1);                  /* data mode */
+    u8g_WriteSequence(u8g, dev, (LCD_PIXEL_WIDTH) / 8, ptr);
+  }
+  u8g_SetChipSelect(u8g, dev, 0);
 }
 
 uint8_t u8g_dev_st7920_128x64_HAL_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, void *arg) {
@@ -112,35 +154,8 @@ uint8_t u8g_dev_st7920_128x64_HAL_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, vo
       break;
     case U8G_DEV_MSG_STOP:
       break;
-    case U8G_DEV_MSG_PAGE_NEXT: {
-      uint8_t y, i;
-      uint8_t *ptr;
-      u8g_pb_t *pb = (u8g_pb_t *)(dev->dev_mem);
-
-      u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-      u8g_SetChipSelect(u8g, dev, 1);
-      y = pb->p.page_y0;
-      ptr = (uint8_t *)pb->buf;
-      for (i = 0; i < 8; i ++) {
-        u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-        u8g_WriteByte(u8g, dev, 0x03E );      /* enable extended mode */
-
-        if (y < 32) {
-          u8g_WriteByte(u8g, dev, 0x080 | y );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080  );      /* set x pos to 0*/
-        }
-        else {
-          u8g_WriteByte(u8g, dev, 0x080 | (y-32) );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080 | 8);      /* set x pos to 64*/
-        }
-
-        u8g_SetAddress(u8g, dev, 1);                  /* data mode */
-        u8g_WriteSequence(u8g, dev, (LCD_PIXEL_WIDTH) / 8, ptr);
-        ptr += (LCD_PIXEL_WIDTH) / 8;
-        y++;
-      }
-      u8g_SetChipSelect(u8g, dev, 0);
-    }
+    case U8G_DEV_MSG_PAGE_NEXT:
+      u8g_dev_st7920_128x64_HAL_write_page(u8g, dev, PAGE_HEIGHT);
     break;
   }
   return u8g_dev_pb8h1_base_fn(u8g, dev, msg, arg);
@@ -157,35 +172,8 @@ uint8_t u8g_dev_st7920_128x64_HAL_4x_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg,
     case U8G_DEV_MSG_STOP:
       break;
 
-    case U8G_DEV_MSG_PAGE_NEXT: {
-      uint8_t y, i;
-      uint8_t *ptr;
-      u8g_pb_t *pb = (u8g_pb_t *)(dev->dev_mem);
-
-      u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-      u8g_SetChipSelect(u8g, dev, 1);
-      y = pb->p.page_y0;
-      ptr = (uint8_t *)pb->buf;
-      for (i = 0; i < 32; i ++) {
-        u8g_SetAddress(u8g, dev, 0);           /* cmd mode */
-        u8g_WriteByte(u8g, dev, 0x03E );      /* enable extended mode */
-
-        if (y < 32) {
-          u8g_WriteByte(u8g, dev, 0x080 | y );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080  );      /* set x pos to 0*/
-        }
-        else {
-          u8g_WriteByte(u8g, dev, 0x080 | (y-32) );      /* y pos  */
-          u8g_WriteByte(u8g, dev, 0x080 | 8);      /* set x pos to 64*/
-        }
-
-        u8g_SetAddress(u8g, dev, 1);                  /* data mode */
-        u8g_WriteSequence(u8g, dev, (LCD_PIXEL_WIDTH) / 8, ptr);
-        ptr += (LCD_PIXEL_WIDTH) / 8;
-        y++;
-      }
-      u8g_SetChipSelect(u8g, dev, 0);
-    }
+    case U8G_DEV_MSG_PAGE_NEXT:
+      u8g_dev_st7920_128x64_HAL_write_page(u8g, dev, 32);
     break;
   }
   return u8g_dev_pb32h1_base_fn(u8g, dev, msg, arg);
@@ -48,14 +48,29 @@ static int pf_bsearch_cb_comp_fntifo_pgm (void *userdata, size_t idx, void *data
   return fontinfo_compare(&localval, (uxg_fontinfo_t*)data_pin);
 }
 
+/**
+ * The glyph cache, code point to font, direct mapped on the low bits of the code point.
+ * The letters of a language are near, so they are all in the cache after the first frame
+ * and the binary search in the font table, from PROGMEM, is done only once per letter.
+ * A code point is always >= 256, so the 0 of an empty entry never matches.
+ */
+#define GLYPH_CACHE_SIZE 16   // Power of 2
+
+typedef struct _glyph_cache_t {
+  uint16_t val;
+  const font_t * fnt;
+} glyph_cache_t;
+
 typedef struct _font_group_t {
   const uxg_fontinfo_t * m_fntifo;
   int m_fntinfo_num;
+  glyph_cache_t m_cache[GLYPH_CACHE_SIZE];
 } font_group_t;
 
 static int fontgroup_init(font_group_t * root, const uxg_fontinfo_t * fntinfo, int number) {
   root->m_fntifo = fntinfo;
   root->m_fntinfo_num = number;
+  ZERO(root->m_cache);
   return 0;
 }
 
@@ -65,10 +80,18 @@ static const font_t* fontgroup_find(font_group_t * root, wchar_t val) {
 
   if (val < 256) return NULL;
 
+  glyph_cache_t * const cache = &root->m_cache[val & (GLYPH_CACHE_SIZE - 1)];
+  if (cache->val == val) return cache->fnt;
+
   if (pf_bsearch_r((void*)root->m_fntifo, root->m_fntinfo_num, pf_bsearch_cb_comp_fntifo_pgm, (void*)&vcmp, &idx) < 0)
-    return NULL;
+    vcmp.fntdata = NULL;
+  else
+    memcpy_P(&vcmp, root->m_fntifo + idx, sizeof(vcmp));
 
-  memcpy_P(&vcmp, root->m_fntifo + idx, sizeof(vcmp));
+  if (val <= 0xFFFF) {   // Also the not found, drawn with the default font
+    cache->val = val;
+    cache->fnt = vcmp.fntdata;
+  }
   return vcmp.fntdata;
 }
 
@@ -113,7 +136,7 @@ static void fontgroup_drawstring(font_group_t *group, const font_t *fnt_default,
 }
 
 static bool flag_fontgroup_was_inited = false;
-static font_group_t g_fontgroup_root = {NULL, 0};
+static font_group_t g_fontgroup_root;
 
 /**
  * @brief check if font is loaded
@@ -525,8 +525,8 @@ void LcdUI::clear_lcd() { } // Automatically cleared by Picture Loop
 
         // Show the location value
         lcd_put_u8str(74, LCD_PIXEL_HEIGHT, "Z:");
-        if (!isnan(ubl.z_values[x_plot][y_plot]))
-          lcd_put_u8str(ftostr43sign(ubl.z_values[x_plot][y_plot]));
+        if (!isnan(float(ubl.z_values[x_plot][y_plot])))
+          lcd_put_u8str(ftostr43sign(float(ubl.z_values[x_plot][y_plot])));
         else
           lcd_put_u8str_P(PSTR(" -----"));
       }
@@ -26,6 +26,91 @@
 #endif
 extern LCD_CLASS lcd;
 
+#if HAS_LCD_SHADOW
+
+  /**
+   * Shadow of the display. The direct draw only sends the cells that differ
+   * from the shadow, and moves the cursor of the display only where a run of
+   * changed cells breaks. The cells off the screen are dropped.
+   *
+   * A deferred draw only changes the shadow and marks the cells that differ
+   * from the display, lcd_shadow_flush() sends a bounded number of them for
+   * each call.
+   */
+  #if ENABLED(LCD_UPDATE_BUDGET_CHARS)
+    bool lcd_deferred = false;
+    static uint32_t shadow_dirty[LCD_HEIGHT];
+    #define SHADOW_DIRTY(R,C) TEST32(shadow_dirty[R], C)
+  #else
+    constexpr bool lcd_deferred = false;
+    #define SHADOW_DIRTY(R,C) false
+  #endif
+
+  static uint8_t  shadow[LCD_HEIGHT][LCD_WIDTH],
+                  shadow_col = 0, shadow_row = 0,
+                  cursor_col = 0, cursor_row = 0xFF;  // The address of the display, row 0xFF if unknown
+
+  void lcd_shadow_clear() {
+    memset(shadow, ' ', sizeof(shadow));
+    #if ENABLED(LCD_UPDATE_BUDGET_CHARS)
+      ZERO(shadow_dirty);
+    #endif
+    cursor_col = cursor_row = 0;
+  }
+
+  void lcd_shadow_lost_cursor() { cursor_row = 0xFF; }
+
+  // Write a cell of the display, the cursor goes there only if it's elsewhere
+  static void lcd_send(const uint8_t col, const uint8_t row, const uint8_t c) {
+    if (cursor_row != row || cursor_col != col) lcd.setCursor(col, row);
+    lcd.write(c);
+    cursor_col = col + 1;
+    cursor_row = row;
+  }
+
+  static void lcd_write(const uint8_t c) {
+    if (shadow_row < LCD_HEIGHT && shadow_col < LCD_WIDTH) {
+      uint8_t &cell = shadow[shadow_row][shadow_col];
+      if (lcd_deferred) {
+        #if ENABLED(LCD_UPDATE_BUDGET_CHARS)
+          if (cell != c) {
+            cell = c;
+            SBI32(shadow_dirty[shadow_row], shadow_col);
+          }
+        #endif
+      }
+      else if (cell != c || SHADOW_DIRTY(shadow_row, shadow_col)) {
+        lcd_send(shadow_col, shadow_row, c);
+        cell = c;
+        #if ENABLED(LCD_UPDATE_BUDGET_CHARS)
+          CBI32(shadow_dirty[shadow_row], shadow_col);
+        #endif
+      }
+    }
+    shadow_col++;
+  }
+
+  #if ENABLED(LCD_UPDATE_BUDGET_CHARS)
+
+    void lcd_shadow_flush(uint8_t budget) {
+      for (uint8_t row = 0; row < LCD_HEIGHT && budget; row++) {
+        for (uint8_t col = 0; col < LCD_WIDTH && shadow_dirty[row] && budget; col++) {
+          if (!TEST32(shadow_dirty[row], col)) continue;
+          lcd_send(col, row, shadow[row][col]);
+          CBI32(shadow_dirty[row], col);
+          budget--;
+        }
+      }
+    }
+
+  #endif
+
+#else
+
+  #define lcd_write(C) lcd.write(C)
+
+#endif // HAS_LCD_SHADOW
+
 int lcd_glyph_height() { return 1; }
 
 typedef struct _hd44780_charmap_t {
@@ -874,9 +959,27 @@ static int pf_bsearch_cb_comp_hd4map_pgm(void *userdata, size_t idx, void * data
   return hd44780_charmap_compare(&localval, (hd44780_charmap_t *)data_pin);
 }
 
-void lcd_moveto(const lcd_uint_t col, const lcd_uint_t row) { lcd.setCursor(col, row); }
+#if HAS_LCD_SHADOW
 
-void lcd_put_int(const int i) { lcd.print(i); }
+  // The cursor of the display moves with the first changed cell
+  void lcd_moveto(const lcd_uint_t col, const lcd_uint_t row) {
+    shadow_col = col;
+    shadow_row = row;
+  }
+
+  void lcd_put_int(const int i) {
+    char str[7];
+    itoa(i, str, 10);
+    for (const char *s = str; *s; s++) lcd_write(*s);
+  }
+
+#else
+
+  void lcd_moveto(const lcd_uint_t col, const lcd_uint_t row) { lcd.setCursor(col, row); }
+
+  void lcd_put_int(const int i) { lcd.print(i); }
+
+#endif
 
 // return < 0 on error
 // return the advanced cols
@@ -894,7 +997,7 @@ int lcd_put_wchar_max(wchar_t c, pixel_len_t max_length) {
 
   // TODO: fix the '\\' that doesnt exist in the HD44870
   if (c < 128) {
-    lcd.write((uint8_t)c);
+    lcd_write((uint8_t)c);
     return 1;
   }
   copy_address = NULL;
@@ -911,16 +1014,16 @@ int lcd_put_wchar_max(wchar_t c, pixel_len_t max_length) {
     hd44780_charmap_t localval;
     // found
     memcpy_P(&localval, copy_address, sizeof(localval));
-    lcd.write(localval.idx);
+    lcd_write(localval.idx);
     if (max_length >= 2 && localval.idx2 > 0) {
-      lcd.write(localval.idx2);
+      lcd_write(localval.idx2);
       return 2;
     }
     return 1;
   }
 
   // Not found, print '?' instead
-  lcd.write((uint8_t)'?');
+  lcd_write((uint8_t)'?');
   return 1;
 }
 
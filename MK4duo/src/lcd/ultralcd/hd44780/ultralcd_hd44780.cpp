@@ -87,7 +87,7 @@ static void createChar_P(const char c, const byte * const ptr) {
   byte temp[8];
   for (uint8_t i = 0; i < 8; i++)
     temp[i] = pgm_read_byte(&ptr[i]);
-  lcd.createChar(c, temp);
+  LCD_CREATE_CHAR(c, temp);
 }
 
 #if ENABLED(LCD_PROGRESS_BAR)
@@ -360,10 +360,10 @@ void LcdUI::init_lcd() {
 
   set_custom_characters(on_status_screen() ? CHARSET_INFO : CHARSET_MENU);
 
-  lcd.clear();
+  LCD_CLEAR();
 }
 
-void LcdUI::clear_lcd() { lcd.clear(); }
+void LcdUI::clear_lcd() { LCD_CLEAR(); }
 
 #if ENABLED(SHOW_BOOTSCREEN)
 
@@ -411,7 +411,7 @@ void LcdUI::clear_lcd() { lcd.clear(); }
 
   void LcdUI::show_bootscreen() {
     set_custom_characters(CHARSET_BOOT);
-    lcd.clear();
+    LCD_CLEAR();
 
     #define LCD_EXTRA_SPACE (LCD_WIDTH-8)
 
@@ -445,10 +445,10 @@ void LcdUI::clear_lcd() { lcd.clear(); }
       CENTER_OR_SCROLL(MK4DUO_FIRMWARE_URL, BOOTSCREEN_TIMEOUT);
     }
 
-    lcd.clear();
+    LCD_CLEAR();
     HAL::delayMilliseconds(100);
     set_custom_characters(CHARSET_INFO);
-    lcd.clear();
+    LCD_CLEAR();
   }
 
 #endif // SHOW_BOOTSCREEN
@@ -564,11 +564,7 @@ void LcdUI::draw_status_message(const bool blink) {
         lcd_put_u8str_P(PSTR("Dia "));
         lcd_put_u8str(ftostr12ns(filament_width_meas));
         lcd_put_u8str_P(PSTR(" V"));
-        lcd_put_u8str(i8tostr3(100.0 * (
-          toolManager.isVolumetric()
-            ? toolManager.volumetric_area_nominal / toolManager.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-            : toolManager.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-        )));
+        lcd_put_u8str(i8tostr3(100.0f * filwidth_factor));
         lcd_put_wchar('%');
         return;
       }
@@ -836,7 +832,7 @@ void LcdUI::draw_status_screen() {
           lcd_put_u8str(buffer);
         }
         else {
-          lcd_put_u8str(itostr4(print_job_counter.getConsumptionHour() - powerManager.startpower));
+          lcd_put_u8str(itostr4(uint16_t(powerManager.job_energy())));
           lcd_put_u8str_P(PSTR("Wh"));
         }
       #else
@@ -1131,7 +1127,7 @@ void LcdUI::draw_status_screen() {
 
     void prep_and_put_map_char(custom_char &chrdata, const coordinate &ul, const coordinate &lr, const coordinate &brc, const uint8_t cl, const char c, const uint8_t x, const uint8_t y) {
       add_edges_to_custom_char(chrdata, ul, lr, brc, cl);
-      lcd.createChar(c, (uint8_t*)&chrdata);
+      LCD_CREATE_CHAR(c, (uint8_t*)&chrdata);
       lcd_put_wchar(x, y, c);
     }
 
@@ -1234,18 +1230,18 @@ void LcdUI::draw_status_screen() {
 
         clear_custom_char(&new_char);
         new_char.custom_char_bits[0] = 0b11111U;                            // Char #0 is used for the box top line
-        lcd.createChar(CHAR_LINE_TOP, (uint8_t*)&new_char);
+        LCD_CREATE_CHAR(CHAR_LINE_TOP, (uint8_t*)&new_char);
 
         clear_custom_char(&new_char);
         k = (GRID_MAX_POINTS_Y) * pixels_per_y_mesh_pnt + 1;                // Row of pixels for the bottom box line
         l = k % (HD44780_CHAR_HEIGHT);                                      // Row within relevant character cell
         new_char.custom_char_bits[l] = 0b11111U;                            // Char #1 is used for the box bottom line
-        lcd.createChar(CHAR_LINE_BOT, (uint8_t*)&new_char);
+        LCD_CREATE_CHAR(CHAR_LINE_BOT, (uint8_t*)&new_char);
 
         clear_custom_char(&new_char);
         for (j = 0; j < HD44780_CHAR_HEIGHT; j++)
           new_char.custom_char_bits[j] = 0b10000U;                          // Char #2 is used for the box left edge
-        lcd.createChar(CHAR_EDGE_L, (uint8_t*)&new_char);
+        LCD_CREATE_CHAR(CHAR_EDGE_L, (uint8_t*)&new_char);
 
         clear_custom_char(&new_char);
         m = (GRID_MAX_POINTS_X) * pixels_per_x_mesh_pnt + 1;                // Column of pixels for the right box line
@@ -1253,7 +1249,7 @@ void LcdUI::draw_status_screen() {
         i = HD44780_CHAR_WIDTH - 1 - n;                                     // Column within relevant character cell (0 on the right)
         for (j = 0; j < HD44780_CHAR_HEIGHT; j++)
           new_char.custom_char_bits[j] = (uint8_t)_BV(i);                   // Char #3 is used for the box right edge
-        lcd.createChar(CHAR_EDGE_R, (uint8_t*)&new_char);
+        LCD_CREATE_CHAR(CHAR_EDGE_R, (uint8_t*)&new_char);
 
         i = x_plot * pixels_per_x_mesh_pnt - suppress_x_offset;
         j = y_plot_inv * pixels_per_y_mesh_pnt - suppress_y_offset;
@@ -1355,8 +1351,8 @@ void LcdUI::draw_status_screen() {
          * Print Z values
          */
         _ZLABEL(_LCD_W_POS, 1);
-        if (!isnan(ubl.z_values[x_plot][y_plot]))
-          lcd_put_u8str(ftostr43sign(ubl.z_values[x_plot][y_plot]));
+        if (!isnan(float(ubl.z_values[x_plot][y_plot])))
+          lcd_put_u8str(ftostr43sign(float(ubl.z_values[x_plot][y_plot])));
         else
           lcd_put_u8str_P(PSTR(" -----"));
 
@@ -1374,8 +1370,8 @@ void LcdUI::draw_status_screen() {
          * Show the location value
          */
         _ZLABEL(_LCD_W_POS, 3);
-        if (!isnan(ubl.z_values[x_plot][y_plot]))
-          lcd_put_u8str(ftostr43sign(ubl.z_values[x_plot][y_plot]));
+        if (!isnan(float(ubl.z_values[x_plot][y_plot])))
+          lcd_put_u8str(ftostr43sign(float(ubl.z_values[x_plot][y_plot])));
         else
           lcd_put_u8str_P(PSTR(" -----"));
 
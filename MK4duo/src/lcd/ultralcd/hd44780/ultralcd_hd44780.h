@@ -92,3 +92,11 @@
 #endif
 
 #include "../lcdprint.h"
+
+#if HAS_LCD_SHADOW
+  #define LCD_CLEAR() do{ lcd.clear(); lcd_shadow_clear(); }while(0)
+  #define LCD_CREATE_CHAR(C,D) do{ lcd.createChar(C, D); lcd_shadow_lost_cursor(); }while(0)
+#else
+  #define LCD_CLEAR() lcd.clear()
+  #define LCD_CREATE_CHAR(C,D) lcd.createChar(C, D)
+#endif
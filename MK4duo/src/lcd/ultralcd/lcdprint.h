@@ -41,6 +41,23 @@ int lcd_put_u8str_max(const char * utf8_str, pixel_len_t max_length);
  */
 void lcd_moveto(const lcd_uint_t col, const lcd_uint_t row);
 
+#if HAS_LCD_SHADOW
+  /**
+   * The display was cleared, or its address moved by other commands
+   */
+  void lcd_shadow_clear();
+  void lcd_shadow_lost_cursor();
+#endif
+
+#if HAS_CHARACTER_LCD && ENABLED(LCD_UPDATE_BUDGET_CHARS)
+  /**
+   * Deferred draw in the shadow of the display, sent by lcd_shadow_flush()
+   * with at most budget characters for each call
+   */
+  extern bool lcd_deferred;
+  void lcd_shadow_flush(uint8_t budget);
+#endif
+
 /**
  * @brief Draw a ROM UTF-8 string
  *
@@ -74,6 +74,105 @@ millis_l LcdUI::next_button_update_ms = 0;
   volatile int8_t encoderDiff; // Updated in update_buttons, added to encoderPosition every LCD update
 #endif
 
+#if ENABLED(LCD_ENCODER_ISR)
+
+  /**
+   * Events of the encoder read in the HAL tick. An entry is a press of the
+   * click or a count of pulses of the wheel: the pulses in the same direction
+   * add to the last entry while it's queued.
+   */
+  #define ENCODER_EVENTS      8
+  #define ENCODER_EVENT_CLICK INT8_MIN
+  #define ENCODER_DEBOUNCE_MS 8
+
+  static volatile int8_t  encoder_queue[ENCODER_EVENTS];
+  static volatile uint8_t encoder_head = 0, encoder_tail = 0;
+  static volatile bool    encoder_live = false;   // The pins are set up
+
+  static void encoder_push(const int8_t e) {
+    if (e != ENCODER_EVENT_CLICK && encoder_head != encoder_tail) {
+      const uint8_t last = (encoder_head + ENCODER_EVENTS - 1) % (ENCODER_EVENTS);
+      const int8_t q = encoder_queue[last];
+      if (q != ENCODER_EVENT_CLICK && (q > 0) == (e > 0) && ABS(q) < 100) {
+        encoder_queue[last] = q + e;
+        return;
+      }
+    }
+    const uint8_t next = (encoder_head + 1) % (ENCODER_EVENTS);
+    if (next != encoder_tail) {   // Else the queue is full, drop it
+      encoder_queue[encoder_head] = e;
+      encoder_head = next;
+    }
+  }
+
+  /**
+   * Read the wheel and the click
+   * Warning: This function is called from interrupt context!
+   */
+  void LcdUI::encoder_isr() {
+    if (!encoder_live) return;
+
+    // The index of the bits BA in the wheel sequence 00, 10, 11, 01
+    static constexpr uint8_t wheel_index[4] = { 0, 3, 1, 2 };
+    static uint8_t last_bits = 0;
+    uint8_t enc = 0;
+    if (BUTTON_PRESSED(EN1)) enc |= B01;
+    if (BUTTON_PRESSED(EN2)) enc |= B10;
+    if (enc != last_bits) {
+      switch ((wheel_index[enc] - wheel_index[last_bits]) & 3) {
+        case 1: encoder_push(encoderDirection); break;
+        case 3: encoder_push(-encoderDirection); break;
+        default: break;   // A missed pulse, no direction
+      }
+      last_bits = enc;
+    }
+
+    // A press is a change held for ENCODER_DEBOUNCE_MS
+    static bool pressed = false;
+    static uint8_t settle = 0;
+    #if ENABLED(INVERT_CLICK_BUTTON)
+      const bool down = !BUTTON_PRESSED(ENC);
+    #else
+      const bool down = BUTTON_PRESSED(ENC);
+    #endif
+    if (down == pressed)
+      settle = 0;
+    else if (++settle >= ENCODER_DEBOUNCE_MS) {
+      settle = 0;
+      pressed = down;
+      if (pressed) encoder_push(ENCODER_EVENT_CLICK);
+    }
+  }
+
+  /**
+   * Add the queued pulses to encoderDiff, up to the first click
+   * Return true for a click
+   */
+  bool LcdUI::encoder_events() {
+    bool click = false, moved = false;
+    while (encoder_tail != encoder_head) {
+      CRITICAL_SECTION_START
+        const int8_t e = encoder_queue[encoder_tail];
+        encoder_tail = (encoder_tail + 1) % (ENCODER_EVENTS);
+      CRITICAL_SECTION_END
+      if (e == ENCODER_EVENT_CLICK) {
+        click = true;
+        break;                                // The next events go after the click is handled
+      }
+      encoderDiff = constrain(int16_t(encoderDiff) + e, -127, 127);
+      moved = true;
+    }
+    if (moved && external_control) {
+      #if ENABLED(AUTO_BED_LEVELING_UBL)
+        ubl.encoder_diff = encoderDiff;       // Make encoder rotation available to UBL G29 mesh editing.
+      #endif
+      encoderDiff = 0;                        // Hide the encoder event from the current screen handler.
+    }
+    return click;
+  }
+
+#endif // LCD_ENCODER_ISR
+
 #if HAS_LCD_MENU
 
   #if HAS_SD_SUPPORT
@@ -278,6 +377,10 @@ void LcdUI::init() {
     encoderDiff = 0;
   #endif
 
+  #if ENABLED(LCD_ENCODER_ISR)
+    encoder_live = true;
+  #endif
+
 }
 
 bool LcdUI::get_blink(uint8_t moltiplicator/*=1*/) {
@@ -656,17 +759,30 @@ void LcdUI::update() {
     // If the state changes the next update may be delayed 300-500ms.
     update_buttons();
 
-    // If the action button is pressed...
-    static bool wait_for_unclick; // = 0
-    if (!external_control && button_pressed()) {
-      if (!wait_for_unclick) {                                  // If not waiting for a debounce release:
-        wait_for_unclick = true;                                //  - Set debounce flag to ignore continous clicks
+    #if ENABLED(LCD_ENCODER_ISR)
+
+      // The presses queued by the tick, none is lost in a long blocking call
+      if (encoder_events() && !external_control) {
         lcd_clicked = !printer.isWaitForUser() && !no_reentry;  //  - Keep the click if not waiting for a user-click
         printer.setWaitForUser(false);                          //  - Any click clears wait for user
         quick_feedback();                                       //  - Always make a click sound
       }
-    }
-    else wait_for_unclick = false;
+
+    #else
+
+      // If the action button is pressed...
+      static bool wait_for_unclick; // = 0
+      if (!external_control && button_pressed()) {
+        if (!wait_for_unclick) {                                  // If not waiting for a debounce release:
+          wait_for_unclick = true;                                //  - Set debounce flag to ignore continous clicks
+          lcd_clicked = !printer.isWaitForUser() && !no_reentry;  //  - Keep the click if not waiting for a user-click
+          printer.setWaitForUser(false);                          //  - Any click clears wait for user
+          quick_feedback();                                       //  - Always make a click sound
+        }
+      }
+      else wait_for_unclick = false;
+
+    #endif
 
     #if BUTTON_EXISTS(BACK)
       if (LCD_BACK_CLICKED()) {
@@ -711,6 +827,11 @@ void LcdUI::update() {
 
   #endif // HAS_SD_SUPPORT
 
+  #if HAS_CHARACTER_LCD && ENABLED(LCD_UPDATE_BUDGET_CHARS)
+    // Send a part of the changed characters at each call
+    lcd_shadow_flush(LCD_UPDATE_BUDGET_CHARS);
+  #endif
+
   if (next_lcd_update_timer.expired(LCD_UPDATE_INTERVAL)
     #if HAS_GRAPHICAL_LCD
       || drawing_screen
@@ -788,6 +909,7 @@ void LcdUI::update() {
 
     // This runs every ~100ms when idling often enough.
     // Instead of tracking changes just redraw the Status Screen once per second.
+    // With STATUS_SCREEN_CHANGE_TRACKING the redraw, all the u8g pages, only when a value changed.
     if (on_status_screen() && !status_update_delay--) {
       status_update_delay = 9
         #if HAS_GRAPHICAL_LCD
@@ -795,7 +917,10 @@ void LcdUI::update() {
         #endif
       ;
       max_display_update_time--;
-      refresh(LCDVIEW_REDRAW_NOW);
+      #if HAS_GRAPHICAL_LCD && ENABLED(STATUS_SCREEN_CHANGE_TRACKING)
+        if (status_screen_changed())
+      #endif
+          refresh(LCDVIEW_REDRAW_NOW);
     }
 
     #if HAS_LCD_MENU && ENABLED(SCROLL_LONG_FILENAMES)
@@ -817,7 +942,11 @@ void LcdUI::update() {
     // then we want to use 1/2 of the time only.
     uint16_t bbr2 = planner.block_buffer_runtime() >> 1;
 
-    if ((should_draw() || drawing_screen) && (!bbr2 || bbr2 > max_display_update_time)) {
+    if ((should_draw() || drawing_screen) && (!bbr2 || bbr2 > max_display_update_time)
+      #if ENABLED(RTOS_TASKS) && HAS_GRAPHICAL_LCD
+        && rtos.display_ready()         // The UI task sent the last page
+      #endif
+    ) {
 
       // Change state of drawing flag between screen updates
       if (!drawing_screen) switch (lcdDrawUpdate) {
@@ -855,6 +984,12 @@ void LcdUI::update() {
           return;
         }
 
+      #elif ENABLED(LCD_UPDATE_BUDGET_CHARS)
+
+        lcd_deferred = true;                  // Draw in the shadow, sent over the next calls
+        run_current_screen();
+        lcd_deferred = false;
+
       #else
 
         run_current_screen();
@@ -1071,7 +1206,7 @@ void LcdUI::update() {
 
     } // next_button_update_ms
 
-    #if HAS_ENCODER_WHEEL
+    #if HAS_ENCODER_WHEEL && DISABLED(LCD_ENCODER_ISR)
       static uint8_t lastEncoderBits;
 
       #define encrot0 0
@@ -1101,7 +1236,7 @@ void LcdUI::update() {
         lastEncoderBits = enc;
       }
 
-    #endif // HAS_ENCODER_WHEEL
+    #endif // HAS_ENCODER_WHEEL && !LCD_ENCODER_ISR
   }
 
   bool LcdUI::button_pressed() { return BUTTON_CLICK(); }
@@ -91,6 +91,7 @@ enum BusyStateEnum : uint8_t {
 /**
  * Emergency Parser
  *  Currently looking for: M108, M112, M410, M876
+ *  and the realtime bytes, outside the UTF-8 characters
  */
 enum EmergencyStateEnum : uint8_t {
   EP_RESET,
@@ -104,11 +105,17 @@ enum EmergencyStateEnum : uint8_t {
   EP_M4,
   EP_M41,
   EP_M410,
+  EP_M5,
+  EP_M52,
+  EP_M524,
   EP_M8,
   EP_M87,
   EP_M876,
   EP_M876S,
   EP_M876SN,
+  EP_UTF8_1, // continuation bytes still expected
+  EP_UTF8_2,
+  EP_UTF8_3,
   EP_IGNORE // to '\n'
 };
 
@@ -138,13 +145,19 @@ enum BlockFlagBitEnum : uint8_t {
   BLOCK_BIT_NOMINAL_LENGTH,
 
   // Sync the stepper counts from the block
-  BLOCK_BIT_SYNC_POSITION
+  BLOCK_BIT_SYNC_POSITION,
+
+  // An octant of a circle, traced with the integer circle. Y is the major axis if set, else X
+  BLOCK_BIT_ARC,
+  BLOCK_BIT_ARC_Y
 };
 
 enum BlockFlagEnum : uint8_t {
   BLOCK_FLAG_RECALCULATE          = _BV(BLOCK_BIT_RECALCULATE),
   BLOCK_FLAG_NOMINAL_LENGTH       = _BV(BLOCK_BIT_NOMINAL_LENGTH),
-  BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION)
+  BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION),
+  BLOCK_FLAG_ARC                  = _BV(BLOCK_BIT_ARC),
+  BLOCK_FLAG_ARC_Y                = _BV(BLOCK_BIT_ARC_Y)
 };
 
 /**
@@ -224,7 +237,8 @@ enum HD44780CharSetEnum : uint8_t {
 enum ProbePtRaiseEnum : uint8_t {
   PROBE_PT_NONE,  // No raise or stow after run_probing
   PROBE_PT_STOW,  // Do a complete stow after run_probing
-  PROBE_PT_RAISE  // Raise to "between" clearance after run_probing
+  PROBE_PT_RAISE, // Raise to "between" clearance after run_probing
+  PROBE_PT_FLY    // A single fast probe, the next point raises PROBE_FLY_CLEARANCE only
 };
 
 /**
@@ -254,7 +268,27 @@ enum CfgSDEnum : uint8_t {   // This need to be in the same order as cfgSD_KEY
 
 enum LsActionEnum : uint8_t {
   LS_Count,
-  LS_GetFilename
+  LS_GetFilename,
+  LS_Index,
+  LS_SortKeys
+};
+
+/**
+ * SD gcode info scan phases
+ */
+enum GcodeScanEnum : uint8_t {
+  SCAN_IDLE,
+  SCAN_HEAD,
+  SCAN_TAIL,
+  SCAN_HEIGHT
+};
+
+/**
+ * SD write behind jobs
+ */
+enum WriteBehindEnum : uint8_t {
+  WB_EEPROM   = _BV(0),
+  WB_RESTART  = _BV(1)
 };
 
 /**
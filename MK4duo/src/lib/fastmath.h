@@ -0,0 +1,100 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * fastmath.h - Approximate math for the hot paths
+ *
+ * The planner, the delta and SCARA Transform and the thermistor tables call
+ * sqrt, atan2 and log many times a second. On AVR and on the DUE these are
+ * soft float libm routines, the ones here trade the last bits for time.
+ * The bounds are checked by the host build: mk4duo_native -m
+ *
+ *  fast_rsqrt  1/sqrt(x), bit trick and two Newton steps    rel. error < 5e-6
+ *  fast_sqrt   x * fast_rsqrt(x), or VSQRT on an FPU HAL    rel. error < 5e-6
+ *  fast_atan2  polynomial on [0, 1] and octant reduction    abs. error < 2e-6 rad
+ *  fast_log    exponent and atanh series on [0.707, 1.414]  abs. error < 2e-6
+ *
+ * The FAST_ macros call them with FAST_MATH, the libm functions otherwise.
+ */
+
+union fastmath_bits_t {
+  float     f;
+  uint32_t  i;
+};
+
+static FORCE_INLINE float fast_rsqrt(const float x) {
+  fastmath_bits_t u;
+  u.f = x;
+  u.i = 0x5F375A86UL - (u.i >> 1);
+  const float x2 = x * 0.5f;
+  float y = u.f;
+  y *= 1.5f - x2 * sq(y);   // 1.8e-3
+  y *= 1.5f - x2 * sq(y);   // 4.7e-6
+  return y;
+}
+
+static FORCE_INLINE float fast_sqrt(const float x) {
+  if (x <= 0.0f) return 0.0f;
+  #ifdef HAL_FAST_SQRT
+    return HAL_FAST_SQRT(x);
+  #else
+    return x * fast_rsqrt(x);
+  #endif
+}
+
+static inline float fast_atan2(const float y, const float x) {
+  const float ax = ABS(x), ay = ABS(y);
+  if (ax == 0.0f && ay == 0.0f) return 0.0f;
+  const bool swap = ay > ax;
+  const float z = swap ? ax / ay : ay / ax,
+              z2 = sq(z);
+  float r = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f + z2 * (-0.11643287f + z2 * (0.05265332f + z2 * -0.01172120f)))));
+  if (swap) r = float(M_PI_2) - r;
+  if (x < 0.0f) r = float(M_PI) - r;
+  return signbit(y) ? -r : r;
+}
+
+static inline float fast_log(const float x) {
+  if (x <= 0.0f) return -INFINITY;
+  fastmath_bits_t u;
+  u.f = x;
+  int16_t e = int16_t((u.i >> 23) & 0xFF) - 127;
+  u.i = (u.i & 0x007FFFFFUL) | 0x3F800000UL;      // Mantissa in [1, 2)
+  if (u.f > float(M_SQRT2)) { u.f *= 0.5f; e++; } // and in [0.707, 1.414]
+  const float s = (u.f - 1.0f) / (u.f + 1.0f),
+              s2 = sq(s);
+  // ln(2) in two parts, e * 0.69314575f is exact
+  return e * 0.69314575f + (e * 1.4286068e-6f + 2.0f * s * (1.0f + s2 * (0.33333333f + s2 * (0.2f + s2 * (0.14285714f + s2 * 0.11111111f)))));
+}
+
+#if ENABLED(FAST_MATH)
+  #define FAST_SQRT(x)      fast_sqrt(x)
+  #define FAST_RSQRT(x)     fast_rsqrt(x)
+  #define FAST_ATAN2(y, x)  fast_atan2(y, x)
+  #define FAST_LOG(x)       fast_log(x)
+#else
+  #define FAST_SQRT(x)      SQRT(x)
+  #define FAST_RSQRT(x)     RSQRT(x)
+  #define FAST_ATAN2(y, x)  ATAN2(y, x)
+  #define FAST_LOG(x)       LOG(x)
+#endif
@@ -300,6 +300,7 @@
 #define COS(x)      cosf(x)
 #define SIN(x)      sinf(x)
 #define LOG(x)      logf(x)
+#define EXP(x)      expf(x)
 
 #ifdef __cplusplus
 
@@ -0,0 +1,189 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * @brief   Single producer single consumer queue
+ * @details Lock free ring buffer for the handoff between an ISR and the main loop,
+ *          or between two tasks.
+ *
+ * The producer owns the write index, the consumer owns the read index, and
+ * neither writes the index of the other, so no count is shared.
+ * The indexes run free and are masked on access, N must be a power of 2
+ * and all the N items are used.
+ *
+ *  Producer: reserve() / commit(), enqueue()
+ *  Consumer: peek() / discard(), dequeue(), clear()
+ *
+ * The indexes are one byte, atomic on AVR too.
+ */
+template<typename T, uint8_t N>
+class SPSC_Queue {
+
+  static_assert(N && !(N & (N - 1)) && N <= 128, "SPSC_Queue size must be a power of 2 up to 128.");
+
+  private: /** Private Parameters */
+
+    static constexpr uint8_t mask = N - 1;
+
+    volatile uint8_t  read_index,   // Owned by the consumer
+                      write_index;  // Owned by the producer
+    T queue[N];
+
+    // The item must be in memory before the index that publishes it
+    FORCE_INLINE static void barrier() { __asm__ __volatile__("" ::: "memory"); }
+
+  public: /** Constructor */
+
+    SPSC_Queue<T, N>() : read_index(0), write_index(0) {}
+
+  public: /** Public Function */
+
+    // Consumer: drop all the items
+    void clear() { read_index = write_index; }
+
+    // Consumer: copy and drop the head item
+    T dequeue() {
+      if (isEmpty()) return T();
+      const T item = queue[read_index & mask];
+      barrier();
+      read_index = read_index + 1;
+      return item;
+    }
+
+    // Consumer: drop the head item without copying it
+    void discard() {
+      if (isEmpty()) return;
+      barrier();
+      read_index = read_index + 1;
+    }
+
+    // Producer: reserve the tail slot to be filled in place, nullptr if full
+    T* reserve() { return isFull() ? nullptr : &queue[write_index & mask]; }
+
+    // Producer: publish the slot returned by reserve()
+    void commit() {
+      barrier();
+      write_index = write_index + 1;
+    }
+
+    // Producer: copy the item at the tail
+    bool enqueue(T const &item) {
+      if (isFull()) return false;
+      queue[write_index & mask] = item;
+      commit();
+      return true;
+    }
+
+    bool isEmpty() const  { return read_index == write_index; }
+    bool isFull()  const  { return count() >= N; }
+
+    uint8_t count() const { return uint8_t(write_index - read_index); }
+
+    static constexpr uint8_t size() { return N; }
+
+    // The head item, valid while it is not discarded
+    T& peek() { return queue[read_index & mask]; }
+
+    // The item at a slot index, from head() onward for count() items
+    T& peek(const uint8_t index) { return queue[index & mask]; }
+
+    uint8_t head() const { return read_index & mask; }   // Slot of the head item
+    uint8_t tail() const { return write_index & mask; }  // Slot of the next item
+
+};
+
+/**
+ * @brief   The same queue on memory given at run time
+ * @details SPSC_Queue<T, 0> holds no items: attach() hands it the slots, a
+ *          power of 2 up to 128, while the queue is empty and no ISR uses it.
+ */
+template<typename T>
+class SPSC_Queue<T, 0> {
+
+  private: /** Private Parameters */
+
+    uint8_t mask, n;
+
+    volatile uint8_t  read_index,   // Owned by the consumer
+                      write_index;  // Owned by the producer
+    T *queue;
+
+    FORCE_INLINE static void barrier() { __asm__ __volatile__("" ::: "memory"); }
+
+  public: /** Constructor */
+
+    constexpr SPSC_Queue() : mask(0), n(0), read_index(0), write_index(0), queue(nullptr) {}
+
+  public: /** Public Function */
+
+    void attach(T * const slots, const uint8_t count) {
+      queue = slots;
+      n = count;
+      mask = count - 1;
+      read_index = write_index = 0;
+    }
+
+    void clear() { read_index = write_index; }
+
+    T dequeue() {
+      if (isEmpty()) return T();
+      const T item = queue[read_index & mask];
+      barrier();
+      read_index = read_index + 1;
+      return item;
+    }
+
+    void discard() {
+      if (isEmpty()) return;
+      barrier();
+      read_index = read_index + 1;
+    }
+
+    T* reserve() { return isFull() ? nullptr : &queue[write_index & mask]; }
+
+    void commit() {
+      barrier();
+      write_index = write_index + 1;
+    }
+
+    bool enqueue(T const &item) {
+      if (isFull()) return false;
+      queue[write_index & mask] = item;
+      commit();
+      return true;
+    }
+
+    bool isEmpty() const  { return read_index == write_index; }
+    bool isFull()  const  { return count() >= n; }
+
+    uint8_t count() const { return uint8_t(write_index - read_index); }
+
+    uint8_t size() const { return n; }
+
+    T& peek() { return queue[read_index & mask]; }
+    T& peek(const uint8_t index) { return queue[index & mask]; }
+
+    uint8_t head() const { return read_index & mask; }
+    uint8_t tail() const { return write_index & mask; }
+
+};
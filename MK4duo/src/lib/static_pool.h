@@ -0,0 +1,54 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#ifdef __AVR__
+  #include <new.h>
+#else
+  #include <new>
+#endif
+
+/**
+ * @brief   Static storage for the objects created at run time
+ * @details The drivers, heaters, fans and extruders are created and deleted
+ *          when their number changes, up to a maximum fixed at compile time.
+ *          The pool keeps the room for the maximum in the static RAM:
+ *          no heap, no fragmentation, and each object has a fixed address.
+ *
+ *  create(i, args...) builds the object i in place, destroy(ptr) ends it
+ *  and clears the pointer. The slot i is free for a new create().
+ */
+template<typename T, uint8_t N>
+class StaticPool {
+
+  private: /** Private Parameters */
+
+    alignas(T) uint8_t storage[N][sizeof(T)];
+
+  public: /** Public Function */
+
+    template<typename... Args>
+    T* create(const uint8_t i, Args... args) { return new (storage[i]) T(args...); }
+
+    static void destroy(T* &obj) { obj->~T(); obj = nullptr; }
+
+};
@@ -33,13 +33,14 @@ typedef int8_t    pin_t;
  */
 #ifdef __AVR__
   typedef uint8_t       mixer_color_t;
-  typedef int8_t        mixer_accu_t;
+  typedef int16_t       mixer_accu_t;
   typedef int8_t        mixer_perc_t;
 #else
   typedef uint_fast16_t mixer_color_t;
-  typedef uint_fast16_t mixer_accu_t;
+  typedef int16_t       mixer_accu_t;
   typedef int8_t        mixer_perc_t;
 #endif
+typedef uint16_t        mixer_weight_t;
 
 /**
  * Conditional type assignment magic. For example...
@@ -64,7 +65,16 @@ typedef float feedrate_t;
 // Feedrate scaling and conversion
 #define MMM_TO_MMS(MM_M)  feedrate_t((MM_M)/60.0f)
 #define MMS_TO_MMM(MM_S)  ((MM_S)*60.0f)
-#define MMS_SCALED(MM_S)  ((MM_S)* 0.01f * mechanics.feedrate_percentage)
+#if ENABLED(THERMAL_THROTTLE)
+  #define THROTTLE_SCALED(MM_S) ((MM_S) * thermalthrottle.factor)
+#else
+  #define THROTTLE_SCALED(MM_S) (MM_S)
+#endif
+#if ENABLED(CNCROUTER_FEED_OVERRIDE)
+  #define MMS_SCALED(MM_S)  THROTTLE_SCALED((MM_S)* 0.0001f * mechanics.feedrate_percentage * cnc.feed_percentage)
+#else
+  #define MMS_SCALED(MM_S)  THROTTLE_SCALED((MM_S)* 0.01f * mechanics.feedrate_percentage)
+#endif
 /***********************************************************/
 
 template<typename T> struct                 XYval;
@@ -139,12 +149,13 @@ typedef abce_float_t                   abce_pos_t;
 
   #define NATIVE_TO_LOGICAL(POS, AXIS)    ((POS) + mechanics.workspace_offset[AXIS])
   #define LOGICAL_TO_NATIVE(POS, AXIS)    ((POS) - mechanics.workspace_offset[AXIS])
-  inline void toLogical(xy_pos_t &raw)    { raw += mechanics.workspace_offset; }
-  inline void toLogical(xyz_pos_t &raw)   { raw += mechanics.workspace_offset; }
-  inline void toLogical(xyze_pos_t &raw)  { raw += mechanics.workspace_offset; }
-  inline void toNative(xy_pos_t &raw)     { raw -= mechanics.workspace_offset; }
-  inline void toNative(xyz_pos_t &raw)    { raw -= mechanics.workspace_offset; }
-  inline void toNative(xyze_pos_t &raw)   { raw -= mechanics.workspace_offset; }
+  // Defined after the Mechanics class, in mechanics.h
+  inline void toLogical(xy_pos_t &raw);
+  inline void toLogical(xyz_pos_t &raw);
+  inline void toLogical(xyze_pos_t &raw);
+  inline void toNative(xy_pos_t &raw);
+  inline void toNative(xyz_pos_t &raw);
+  inline void toNative(xyze_pos_t &raw);
 
 #else
 
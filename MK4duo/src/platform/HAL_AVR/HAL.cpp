@@ -330,6 +330,9 @@ void HAL::analogWrite(const pin_t pin, const uint8_t uValue, const uint16_t freq
 
 void HAL::Tick() {
 
+  MEMORY_PROFILE_ISR(MEM_ISR_TICK);
+  CRASH_RECORD_TICK();
+
   static short_timer_t  cycle_1s_timer(millis()),
                         cycle_100_timer(millis());
 
@@ -342,6 +345,11 @@ void HAL::Tick() {
 
   if (printer.isStopped()) return;
 
+  #if ENABLED(LCD_ENCODER_ISR)
+    // Encoder wheel and click, queued for the UI
+    lcdui.encoder_isr();
+  #endif
+
   // Heaters set output PWM
   tempManager.set_output_pwm();
 
@@ -357,6 +365,9 @@ void HAL::Tick() {
   if ((ADCSRA & _BV(ADSC)) == 0) {  // Conversion finished?
     channel = pgm_read_byte(&AnalogInputChannels[adcSamplePos]);
     const uint16_t read_adc = ADC;
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      if (channel == POWER_CONSUMPTION_PIN) powerManager.sample(read_adc);
+    #endif
     AnalogInputRead[adcSamplePos] += uint32_t(read_adc) - uint32_t(sample[adcSamplePos][adcCounter[adcSamplePos]]);
     sample[adcSamplePos][adcCounter[adcSamplePos]] = read_adc;
     if (++adcCounter[adcSamplePos] >= (NUM_ADC_SAMPLES)) {
@@ -66,6 +66,7 @@
 #include <avr/io.h>
 #include <avr/eeprom.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
 
 // --------------------------------------------------------------------------
 // Types
@@ -198,6 +199,12 @@ typedef uint16_t  ptr_int_t;
 #define TEMP_TIMSK                  TIMSK0
 #define TEMP_OCIE                   OCIE0B
 
+// Cycle counter, used by the ISR profiler (stepper timer ticks)
+#define HAL_CYCLE_COUNTER_INIT()    NOOP
+#define HAL_CYCLE_COUNTER()         HAL_timer_get_current_count(STEPPER_TIMER_NUM)
+#define HAL_CYCLE_COUNTER_RATE      (STEPPER_TIMER_RATE)
+typedef hal_timer_t hal_cycle_t;
+
 #define TIMER_OCR_0                 OCR0A
 #define TIMER_OCR_1                 OCR1A
 #define TIMER_COUNTER_0             TCNT0
@@ -490,6 +497,9 @@ class HAL {
 
     static void analogWrite(const pin_t pin, const uint8_t uValue, const uint16_t freq=1000U);
 
+    // Fixed timer channel per pin, just report the pins with hardware PWM
+    FORCE_INLINE static bool claim_hardware_pwm(const pin_t pin, const uint16_t) { return USEABLE_HARDWARE_PWM(pin); }
+
     static void Tick();
 
     static pin_t digital_value_pin();
@@ -572,6 +582,14 @@ class HAL {
       return millis();
     }
 
+    // Idle mode, the timers and the UART go on and wake the CPU
+    static inline void waitForInterrupt() {
+      set_sleep_mode(SLEEP_MODE_IDLE);
+      sleep_enable();
+      sleep_cpu();
+      sleep_disable();
+    }
+
     //
     // SPI related functions
     //
@@ -75,6 +75,9 @@
 #define _GET_OUTPUT(IO)       TEST(DIO ## IO ## _DDR, DIO ## IO ## _PIN)
 #define _GET_TIMER(IO)        DIO ## IO ## _PWM
 
+#define _PORT_INPUT(IO)       (&DIO ## IO ## _RPORT)
+#define _PORT_MASK(IO)        _BV(DIO ## IO ## _PIN)
+
 #define READ(IO)              _READ(IO)
 #define WRITE(IO,V)           _WRITE(IO,V)
 #define TOGGLE(IO)            _TOGGLE(IO)
@@ -89,6 +92,12 @@
 #define GET_OUTPUT(IO)        _GET_OUTPUT(IO)
 #define GET_TIMER(IO)         _GET_TIMER(IO)
 
+// Input register and bit mask of a pin, for sampling a whole port with one read
+typedef volatile uint8_t* port_input_t;
+typedef uint8_t           port_mask_t;
+#define PORT_INPUT(IO)        _PORT_INPUT(IO)
+#define PORT_MASK(IO)         _PORT_MASK(IO)
+
 #define OUT_WRITE(IO,V)       do{ SET_OUTPUT(IO); WRITE(IO,V); }while(0)
 
 /**
@@ -393,12 +393,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
   // Read the character from the USART
   uint8_t c = R_UDR;
 
-  if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+  // A realtime command of the emergency parser is not stored
+  const bool realtime = Cfg::EMERGENCYPARSER && emergency_parser.update(emergency_state, c);
 
   // If the character is to be stored at the index just before the tail
   // (such that the head would advance to the current tail), the RX FIFO is
   // full, so don't write the character or advance the head.
-  if (i != t) {
+  if (realtime) {}
+  else if (i != t) {
     rx_buffer.buffer[h] = c;
     h = i;
   }
@@ -447,12 +449,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = R_UDR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+            // A realtime command of the emergency parser is not stored
+            const bool realtime = Cfg::EMERGENCYPARSER && emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
             // full, so don't write the character or advance the head.
-            if (i != t) {
+            if (realtime) {}
+            else if (i != t) {
               rx_buffer.buffer[h] = c;
               h = i;
             }
@@ -486,12 +490,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = R_UDR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+            // A realtime command of the emergency parser is not stored
+            const bool realtime = Cfg::EMERGENCYPARSER && emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
             // full, so don't write the character or advance the head.
-            if (i != t) {
+            if (realtime) {}
+            else if (i != t) {
               rx_buffer.buffer[h] = c;
               h = i;
             }
@@ -739,6 +745,44 @@ MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>> MKSerial1;
 
 #endif // HAS_MMU2 && MMU2_SERIAL > 0
 
+#if ENABLED(TOOLBOARD) && TOOLBOARD_SERIAL > 0
+
+  // Hookup ISR handlers
+  ISR(SERIAL_REGNAME(USART,TOOLBOARD_SERIAL,_RX_vect)) {
+    MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>>::store_rxd_char();
+  }
+
+  ISR(SERIAL_REGNAME(USART,TOOLBOARD_SERIAL,_UDRE_vect)) {
+    MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>>::_tx_udr_empty_irq();
+  }
+
+  // Preinstantiate
+  template class MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>>;
+
+  // Instantiate
+  MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>> toolboardSerial;
+
+#endif // ENABLED(TOOLBOARD) && TOOLBOARD_SERIAL > 0
+
+#if ENABLED(STEP_COPROCESSOR) && STEP_COPROCESSOR_SERIAL > 0
+
+  // Hookup ISR handlers
+  ISR(SERIAL_REGNAME(USART,STEP_COPROCESSOR_SERIAL,_RX_vect)) {
+    MKHardwareSerial<MK4duoSerialCfg<STEP_COPROCESSOR_SERIAL>>::store_rxd_char();
+  }
+
+  ISR(SERIAL_REGNAME(USART,STEP_COPROCESSOR_SERIAL,_UDRE_vect)) {
+    MKHardwareSerial<MK4duoSerialCfg<STEP_COPROCESSOR_SERIAL>>::_tx_udr_empty_irq();
+  }
+
+  // Preinstantiate
+  template class MKHardwareSerial<MK4duoSerialCfg<STEP_COPROCESSOR_SERIAL>>;
+
+  // Instantiate
+  MKHardwareSerial<MK4duoSerialCfg<STEP_COPROCESSOR_SERIAL>> coprocessorSerial;
+
+#endif // ENABLED(STEP_COPROCESSOR) && STEP_COPROCESSOR_SERIAL > 0
+
 #endif // (UBRRH || UBRR0H || UBRR1H || UBRR2H || UBRR3H)
 
 #endif // __AVR__
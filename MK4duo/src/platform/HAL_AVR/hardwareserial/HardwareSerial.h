@@ -224,6 +224,9 @@ class MKHardwareSerial {
     FORCE_INLINE static uint8_t framing_errors() { return Cfg::RX_FRAMING_ERRORS ? rx_framing_errors : 0; }
     FORCE_INLINE static ring_buffer_pos_t rxMaxEnqueued() { return Cfg::MAX_RX_QUEUED ? rx_max_enqueued : 0; }
 
+    // Free bytes in the TX ring, writes up to this size never wait for the UART
+    FORCE_INLINE static uint8_t availableForWrite() { return Cfg::TX_SIZE > 0 ? (tx_buffer.tail - tx_buffer.head - 1) & (Cfg::TX_SIZE - 1) : 0; }
+
     FORCE_INLINE static void write(const char* str) { while (*str) write(*str++); }
     FORCE_INLINE static void write(const uint8_t* buffer, size_t size) { while (size--) write(*buffer++); }
     FORCE_INLINE static void print(const String& s) { for (int i = 0; i < (int)s.length(); i++) write(s[i]); }
@@ -261,3 +264,11 @@ extern MKHardwareSerial<MK4duoSerialHostCfg<SERIAL_PORT_1>> MKSerial1;
 #if HAS_MMU2 && MMU2_SERIAL > 0
   extern MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>> mmuSerial;
 #endif
+
+#if ENABLED(TOOLBOARD) && TOOLBOARD_SERIAL > 0
+  extern MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>> toolboardSerial;
+#endif
+
+#if ENABLED(STEP_COPROCESSOR) && STEP_COPROCESSOR_SERIAL > 0
+  extern MKHardwareSerial<MK4duoSerialCfg<STEP_COPROCESSOR_SERIAL>> coprocessorSerial;
+#endif
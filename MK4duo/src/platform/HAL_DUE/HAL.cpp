@@ -59,6 +59,13 @@
 #include <malloc.h>
 #include <Wire.h>
 
+#if ENABLED(STEP_PULSE_BATCH)
+  uint32_t  HAL_step_batch_set[4]   = { 0 },
+            HAL_step_batch_clear[4] = { 0 };
+  uint8_t   HAL_step_batch_ports    = 0;
+  bool      HAL_step_batch_active   = false;
+#endif
+
 /** Public Parameters */
 uint8_t MCUSR;
 
@@ -228,12 +235,64 @@ void AnalogInEnablePin(const pin_t r_pin, const bool enable) {
   }
 }   
 
-// Read the most recent 12-bit result from a pin
+#if ENABLED(ADC_OVERSAMPLING)
+
+  /**
+   * The ADC runs free with the channel number tagged on each result and the PDC
+   * fills adc_pdc_buffer with a pass of ADC_OVERSAMPLING_RATIO results per enabled
+   * channel. AnalogInReadPDC() decimates a completed pass and starts the next one.
+   */
+  #define ADC_OVERSAMPLING_RATIO  (1 << (2 * (ADC_OVERSAMPLING_BITS)))
+
+  static uint16_t adc_pdc_buffer[NUM_ANALOG_INPUTS * ADC_OVERSAMPLING_RATIO],
+                  adc_decimated[NUM_ANALOG_INPUTS];
+
+  static void AnalogInStartPDC() {
+    ADC->ADC_RPR = (uint32_t)adc_pdc_buffer;
+    ADC->ADC_RCR = __builtin_popcount(ADC->ADC_CHSR) * ADC_OVERSAMPLING_RATIO;
+  }
+
+  // Decimate the pass if the PDC has completed it
+  static bool AnalogInReadPDC() {
+    if (ADC->ADC_RCR || !ADC->ADC_CHSR) return false;
+
+    const uint16_t count = __builtin_popcount(ADC->ADC_CHSR) * ADC_OVERSAMPLING_RATIO;
+    uint32_t sum[NUM_ANALOG_INPUTS] = { 0 };
+    uint16_t num[NUM_ANALOG_INPUTS] = { 0 };
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      static const uint8_t power_ch = PinToAdcChannel(POWER_CONSUMPTION_PIN);
+    #endif
+    for (uint16_t i = 0; i < count; i++) {
+      const uint16_t value = adc_pdc_buffer[i];
+      const uint8_t ch = value >> 12;
+      sum[ch] += value & 0x0FFF;
+      num[ch]++;
+      #if HAS_POWER_CONSUMPTION_SENSOR
+        // All the samples of the pass, a burst of the PDC for the power integrator
+        if (ch == power_ch) powerManager.sample((value & 0x0FFF) << (ADC_OVERSAMPLING_BITS));
+      #endif
+    }
+
+    // A channel just enabled can be short of samples in this pass, so divide by the real count
+    LOOP_L_N(ch, NUM_ANALOG_INPUTS)
+      if (num[ch]) adc_decimated[ch] = (sum[ch] << (ADC_OVERSAMPLING_BITS)) / num[ch];
+
+    AnalogInStartPDC();
+    return true;
+  }
+
+#endif // ADC_OVERSAMPLING
+
+// Read the most recent result from a pin
 uint16_t AnalogInReadPin(const pin_t r_pin) {
 
   adc_channel_num_t adc_ch = PinToAdcChannel(r_pin);
   if ((unsigned int)adc_ch < NUM_ANALOG_INPUTS)
-    return adc_get_channel_value(ADC, adc_ch);
+    #if ENABLED(ADC_OVERSAMPLING)
+      return adc_decimated[adc_ch];
+    #else
+      return adc_get_channel_value(ADC, adc_ch);
+    #endif
   else
     return 0;
 }
@@ -322,6 +381,14 @@ void HAL::analogStart() {
   ADC->ADC_IER = 0;             // no ADC interrupts
   ADC->ADC_COR = 0;             // Single-ended, no offset
 
+  #if ENABLED(ADC_OVERSAMPLING)
+    // Free run with the channel number in each result, the PDC stores them
+    ADC->ADC_MR   = (ADC->ADC_MR & ~ADC_MR_FREERUN) | ADC_MR_FREERUN_ON;
+    ADC->ADC_EMR |= ADC_EMR_TAG;
+    AnalogInStartPDC();
+    ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+  #endif
+
   // start first conversion
   AnalogInStartConversion();
 }
@@ -351,6 +418,155 @@ bool HAL::tc_status(const pin_t pin) {
   else return false;
 }
 
+/**
+ * Hardware PWM allocator.
+ * All the PWM channels run from the shared CLKA, so they all get the first frequency claimed.
+ * The TIOA and TIOB outputs of a TC channel share the counter, so they share the frequency.
+ * Return false when the pin has no free channel for this frequency, the caller use soft PWM.
+ */
+#if HAS_TACHO_CAPTURE
+  static uint16_t tc_capture = 0; // TC channels in capture mode, no PWM on them
+#endif
+
+bool HAL::claim_hardware_pwm(const pin_t pin, const uint16_t freq) {
+
+  static pin_t    pwm_owner[8] = { NoPin, NoPin, NoPin, NoPin, NoPin, NoPin, NoPin, NoPin };
+  static uint16_t pwm_freq = 0,
+                  tc_freq[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+  if (pin <= 0 || freq == 0) return false;
+
+  const PinDescription& pinDesc = g_APinDescription[pin];
+  const uint32_t attr = pinDesc.ulPinAttribute;
+
+  // analogWrite use the PWM peripheral first
+  if (attr & PIN_ATTR_PWM) {
+    const uint8_t chan = pinDesc.ulPWMChannel;
+    if (pwm_owner[chan] != NoPin && pwm_owner[chan] != pin) return false;
+    if (pwm_freq != 0 && pwm_freq != freq) return false;
+    pwm_owner[chan] = pin;
+    pwm_freq = freq;
+    return true;
+  }
+
+  if (attr & PIN_ATTR_TIMER) {
+    const uint8_t id = uint8_t(pinDesc.ulTCChannel) >> 1;
+    #if HAS_TACHO_CAPTURE
+      if (TEST(tc_capture, id)) return false;
+    #endif
+    if (tc_freq[id] != 0 && tc_freq[id] != freq) return false;
+    tc_freq[id] = freq;
+    return true;
+  }
+
+  return false;
+}
+
+#if HAS_TACHO_CAPTURE
+
+  /**
+   * Tachometer on the TIOA input of a free TC channel.
+   * RA and RB capture the counter on the falling edges one after the other,
+   * so the two registers always hold the last two edges with no interrupt.
+   * Return false when the pin is not a TIOA or the channel is in use.
+   */
+  bool HAL::tacho_capture_init(const pin_t pin) {
+
+    if (pin <= 0) return false;
+
+    const PinDescription& pinDesc = g_APinDescription[pin];
+    const uint32_t attr = pinDesc.ulPinAttribute;
+
+    // Only TIOA is a capture input, PWM pins have the peripheral of the PWM
+    if (!(attr & PIN_ATTR_TIMER) || (attr & PIN_ATTR_PWM) || TEST(pinDesc.ulTCChannel, 0)) return false;
+
+    const uint8_t id = uint8_t(pinDesc.ulTCChannel) >> 1;
+    if (id == TONE_TIMER_NUM || id == STEPPER_TIMER_NUM || id == 5) return false; // Tone, Stepper and Servo
+    if (TEST(tc_capture, id)) return true;
+
+    Tc* tc = TimerConfig[id].pTimerRegs;
+    const uint32_t chan = TimerConfig[id].channel;
+
+    PIO_Configure(pinDesc.pPort, pinDesc.ulPinType, pinDesc.ulPin, PIO_PULLUP);
+    pmc_set_writeprotect(false);
+    pmc_enable_periph_clk((uint32_t)TimerConfig[id].IRQ_Id);
+    TC_Configure(tc, chan, TC_CMR_TCCLKS_TIMER_CLOCK4 | TC_CMR_LDRA_FALLING | TC_CMR_LDRB_FALLING);
+    tc->TC_CHANNEL[chan].TC_IDR = 0xFFFFFFFF;
+    TC_Start(tc, chan);
+
+    SBI(tc_capture, id);
+    return true;
+  }
+
+  /**
+   * Period of the last two edges and time from the last one, in HAL_TACHO_CAPTURE_RATE ticks.
+   * The newer capture is the one nearer to the counter.
+   */
+  void HAL::tacho_capture_read(const pin_t pin, uint32_t &period, uint32_t &age) {
+    const uint8_t id = uint8_t(g_APinDescription[pin].ulTCChannel) >> 1;
+    const TcChannel& ch = TimerConfig[id].pTimerRegs->TC_CHANNEL[TimerConfig[id].channel];
+    const uint32_t  now   = ch.TC_CV,
+                    age_a = now - ch.TC_RA,
+                    age_b = now - ch.TC_RB;
+    age     = MIN(age_a, age_b);
+    period  = MAX(age_a, age_b) - age;
+  }
+
+#endif // HAS_TACHO_CAPTURE
+
+#if ENABLED(NEOPIXEL_DMA)
+
+  /**
+   * NeoPixel on a PWM pin, a synchronous channel with channel 0 at 800 kHz.
+   * At each period the PDC writes the duty of channel 0 and of the pin, the
+   * update of the synchronous channels loads them at the end of the period.
+   * A bit is a period with a high time of 0.35 us (0) or 0.70 us (1), sent
+   * with no interrupt and no CPU time. The last duty of a frame is 0, the pin
+   * stays low. The variant has no PWM pin on channel 0.
+   * Return false when the pin is not a PWM pin.
+   */
+  bool HAL::neopixel_dma_init(const pin_t pin, uint16_t &bit0, uint16_t &bit1) {
+
+    if (pin <= 0) return false;
+
+    const PinDescription& pinDesc = g_APinDescription[pin];
+    if (!(pinDesc.ulPinAttribute & PIN_ATTR_PWM) || pinDesc.ulPWMChannel == 0) return false;
+
+    constexpr uint32_t period = (F_CPU) / 800000UL;
+    const uint32_t chan = pinDesc.ulPWMChannel;
+
+    bit0 = period * 9 / 32;
+    bit1 = period * 9 / 16;
+
+    pmc_enable_periph_clk(PWM_INTERFACE_ID);
+    PIO_Configure(pinDesc.pPort, pinDesc.ulPinType, pinDesc.ulPin, pinDesc.ulPinConfiguration);
+
+    PWM_INTERFACE->PWM_DIS = _BV(0) | _BV(chan);
+    PWMC_ConfigureChannel(PWM_INTERFACE, 0, PWM_CMR_CPRE_MCK, 0, 0);
+    PWMC_ConfigureChannel(PWM_INTERFACE, chan, PWM_CMR_CPRE_MCK, 0, 0);
+    PWMC_SetPeriod(PWM_INTERFACE, 0, period);
+    PWMC_SetPeriod(PWM_INTERFACE, chan, period);
+    PWMC_SetDutyCycle(PWM_INTERFACE, 0, 0);
+    PWMC_SetDutyCycle(PWM_INTERFACE, chan, 0);
+
+    // Update at each period, with the duty written by the PDC
+    PWM_INTERFACE->PWM_SCM  = _BV(0) | _BV(chan) | PWM_SCM_UPDM_MODE2;
+    PWM_INTERFACE->PWM_SCUP = PWM_SCUP_UPR(0);
+    PWM_INTERFACE->PWM_ENA  = _BV(0); // Channel 0 starts all the synchronous channels
+
+    g_pinStatus[pin] = (g_pinStatus[pin] & 0xF0) | PIN_STATUS_PWM;
+    return true;
+  }
+
+  // Two duty (channel 0 and pin) for each bit of the frame
+  void HAL::neopixel_dma_send(const uint16_t *buffer, const uint16_t count) {
+    PWM_INTERFACE->PWM_TPR  = (uint32_t)buffer;
+    PWM_INTERFACE->PWM_TCR  = count;
+    PWM_INTERFACE->PWM_PTCR = PERIPH_PTCR_TXTEN;
+  }
+
+#endif // NEOPIXEL_DMA
+
 /**
  * PWM output only work on the pins with hardware support.
  *  For the rest of the pins, we default to digital output
@@ -442,7 +658,9 @@ void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq/*=1
       // PWM Startup code
       pmc_enable_periph_clk(PWM_INTERFACE_ID);
       PWMC_ConfigureClocks(freq * PWM_MAX_DUTY_CYCLE, 0, VARIANT_MCK);
-      PWM_INTERFACE->PWM_SCM = 0; // ensure no sync channels
+      #if DISABLED(NEOPIXEL_DMA)
+        PWM_INTERFACE->PWM_SCM = 0; // ensure no sync channels, they are of the NeoPixel
+      #endif
       PWMEnabled = true;
     }
 
@@ -549,11 +767,19 @@ void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq/*=1
  */
 void HAL::Tick() {
 
+  MEMORY_PROFILE_ISR(MEM_ISR_TICK);
+  CRASH_RECORD_TICK();
+
   static short_timer_t  cycle_1s_timer(millis()),
                         cycle_100_timer(millis());
 
   if (printer.isStopped()) return;
 
+  #if ENABLED(LCD_ENCODER_ISR)
+    // Encoder wheel and click, queued for the UI
+    lcdui.encoder_isr();
+  #endif
+
   // Heaters set output PWM
   tempManager.set_output_pwm();
 
@@ -567,7 +793,11 @@ void HAL::Tick() {
   if (cycle_1s_timer.expired(1000)) printer.check_periodical_actions();
 
   // Read analog or SPI values
-  if (adc_get_status(ADC)) { // conversion finished?
+  #if ENABLED(ADC_OVERSAMPLING)
+    if (AnalogInReadPDC()) { // pass finished?
+  #else
+    if (adc_get_status(ADC)) { // conversion finished?
+  #endif
 
     #if HAS_HOTENDS
       LOOP_HOTEND() {
@@ -617,6 +847,9 @@ void HAL::Tick() {
     #endif
 
     #if HAS_POWER_CONSUMPTION_SENSOR
+      #if DISABLED(ADC_OVERSAMPLING)
+        powerManager.sample(AnalogInReadPin(POWER_CONSUMPTION_PIN));
+      #endif
       const_cast<ADCAveragingFilter&>(powerFilter).process_reading(AnalogInReadPin(POWER_CONSUMPTION_PIN));
       if (powerFilter.IsValid())
         powerManager.current_raw_powconsumption = powerFilter.GetSum();
@@ -630,7 +863,14 @@ void HAL::Tick() {
 
   }
 
-  AnalogInStartConversion();
+  #if DISABLED(ADC_OVERSAMPLING)
+    AnalogInStartConversion();
+  #endif
+
+  // Z of the mesh under the nozzle
+  #if ENABLED(MESH_STEPPER_CORRECTION)
+    bedlevel.mesh_correction_tick();
+  #endif
 
   // Tick endstops state, if required
   endstops.Tick();
@@ -663,14 +903,18 @@ extern "C" int sysTickHook() {
 }
 
 HAL_TONE_TIMER_ISR() {
-  static uint8_t pin_state = 0;
   HAL_timer_isr_prologue(TONE_TIMER_NUM);
 
-  if (toggles) {
-    toggles--;
-    HAL::digitalWrite(tone_pin, (pin_state ^= 1));
-  }
-  else noTone(tone_pin);
+  #if HAS_TONE_ISR
+    Sound::tone_isr();
+  #else
+    static uint8_t pin_state = 0;
+    if (toggles) {
+      toggles--;
+      HAL::digitalWrite(tone_pin, (pin_state ^= 1));
+    }
+    else noTone(tone_pin);
+  #endif
 }
 
 HAL_STEPPER_TIMER_ISR() {
@@ -188,7 +188,11 @@ typedef uint32_t  ptr_int_t;
 #define ADC_TEMPERATURE_SENSOR  15
 // Bits of the ADC converter
 #define ANALOG_INPUT_BITS 12
-#define AD_RANGE        4095      // 12-bit resolution
+#if ENABLED(ADC_OVERSAMPLING)
+  #define AD_RANGE      (4095 << (ADC_OVERSAMPLING_BITS)) // 12-bit resolution plus the oversampling bits
+#else
+  #define AD_RANGE      4095      // 12-bit resolution
+#endif
 #define ABS_ZERO        -273.15f
 #define NUM_ADC_SAMPLES   32
 #define AD595_MAX        330.0f
@@ -268,6 +272,18 @@ class HAL {
     static bool pwm_status(const pin_t pin);
     static bool tc_status(const pin_t pin);
 
+    static bool claim_hardware_pwm(const pin_t pin, const uint16_t freq);
+
+    #if HAS_TACHO_CAPTURE
+      static bool tacho_capture_init(const pin_t pin);
+      static void tacho_capture_read(const pin_t pin, uint32_t &period, uint32_t &age);
+    #endif
+
+    #if ENABLED(NEOPIXEL_DMA)
+      static bool neopixel_dma_init(const pin_t pin, uint16_t &bit0, uint16_t &bit1);
+      static void neopixel_dma_send(const uint16_t *buffer, const uint16_t count);
+    #endif
+
     static void analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t freq=1000U);
 
     static void Tick();
@@ -316,6 +332,8 @@ class HAL {
       return millis();
     }
 
+    FORCE_INLINE static void waitForInterrupt() { __WFI(); }
+
     static void showStartReason();
 
     static void resetHardware();
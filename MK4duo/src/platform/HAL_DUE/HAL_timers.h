@@ -68,6 +68,12 @@
 #define TONE_TIMER_NUM              3  // index of timer to use for beeper tones
 #define HAL_TONE_TIMER_ISR()        void TC3_Handler()
 
+// The tone timer plays the sound queue
+#define HAL_TONE_ISR
+#define HAL_TONE_TIMER_START(F)     HAL_timer_start(TONE_TIMER_NUM, F)
+#define HAL_TONE_TIMER_RATE(F)      HAL_timer_set_count(TONE_TIMER_NUM, (VARIANT_MCK) / 2 / (F))
+#define HAL_TONE_TIMER_STOP()       HAL_timer_disable_interrupt(TONE_TIMER_NUM)
+
 #define HAL_TIMER_RATE              ((F_CPU) / 2) // 42 MHz
 
 // Stepper Timer
@@ -81,6 +87,12 @@
 #define STEPPER_CLOCK_RATE          ((F_CPU) / 128)                                           // frequency of the clock used for stepper pulse timing
 #define HAL_STEPPER_TIMER_ISR()     void TC4_Handler()
 
+// Tachometer capture clock, TIMER_CLOCK4 of the TC
+#define HAL_TACHO_CAPTURE_RATE      ((F_CPU) / 128)
+
+// NeoPixel DMA, the PDC writes the duty of channel 0 and of the pin for each bit
+#define HAL_NEOPIXEL_DMA_STRIDE     2
+
 #define AD_PRESCALE_FACTOR          84  // 500 kHz ADC clock 
 #define AD_TRACKING_CYCLES          4   // 0 - 15     + 1 adc clock cycles
 #define AD_TRANSFER_CYCLES          1   // 0 - 3      * 2 + 3 adc clock cycles
@@ -92,6 +104,12 @@
 #define DISABLE_STEPPER_INTERRUPT() HAL_timer_disable_interrupt(STEPPER_TIMER_NUM)
 #define STEPPER_ISR_ENABLED()       HAL_timer_interrupt_is_enabled(STEPPER_TIMER_NUM)
 
+// Cycle counter, used by the ISR profiler and the endstop trigger capture (DWT on Cortex-M3/M4)
+#define HAL_CYCLE_COUNTER_INIT()    do{ CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; DWT->CYCCNT = 0; DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; }while(0)
+#define HAL_CYCLE_COUNTER()         (DWT->CYCCNT)
+#define HAL_CYCLE_COUNTER_RATE      (F_CPU)
+typedef uint32_t hal_cycle_t;
+
 // Estimate the amount of time the ISR will take to execute
 #define TIMER_CYCLES                34UL
 
@@ -0,0 +1,196 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Based on u8g_com_st7920_hw_spi.c
+ *
+ * Universal 8bit Graphics Library
+ *
+ * Copyright (c) 2011, olikraus@gmail.com
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice, this list
+ *    of conditions and the following disclaimer.
+ *
+ *  * Redistributions in binary form must reproduce the above copyright notice, this
+ *    list of conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef ARDUINO_ARCH_SAM
+
+#include "../../../../MK4duo.h"
+
+#if ENABLED(U8GLIB_ST7920)
+
+#include <U8glib.h>
+#include "u8g_com_sw_spi_shared.h"
+
+/**
+ * ST7920 on the hardware SPI0.
+ * Commands go byte by byte, the data sequences (the pixel rows) are
+ * expanded to the nibble pairs of the ST7920 serial protocol and sent by
+ * the DMAC, while the device prepares the next row.
+ */
+
+#define ST7920_DMAC_CH      3   // DMAC channel, 0 and 1 are of the SD card driver
+#define ST7920_SPI_TX_IDX   1   // DMAC hardware interface of the SPI0 TX
+#define ST7920_SPI_DIVIDER 42   // 2 MHz, the ST7920 serial clock is 2.5 MHz max
+#define ST7920_SEQ_MAX     16   // Bytes of a sequence in a DMA transfer, a row of the display
+
+static uint8_t rs_last_state = 255;
+
+static uint8_t dma_buffer[2][2 * ST7920_SEQ_MAX], dma_index = 0;
+
+static void u8g_com_DUE_st7920_dma_wait() {
+  while (DMAC->DMAC_CHSR & (DMAC_CHSR_ENA0 << ST7920_DMAC_CH)) { /* nada */ }
+  while ((SPI0->SPI_SR & SPI_SR_TXEMPTY) == 0) { /* nada */ }
+  uint32_t dummy_read = SPI0->SPI_RDR;  // drop the received bytes and the overrun flag
+  dummy_read = SPI0->SPI_SR;
+  UNUSED(dummy_read);
+}
+
+static void u8g_com_DUE_st7920_dma_start(const uint8_t *src, const uint16_t count) {
+  DMAC->DMAC_CHDR = DMAC_CHDR_DIS0 << ST7920_DMAC_CH;
+  DMAC->DMAC_CH_NUM[ST7920_DMAC_CH].DMAC_SADDR = (uint32_t)src;
+  DMAC->DMAC_CH_NUM[ST7920_DMAC_CH].DMAC_DADDR = (uint32_t)&SPI0->SPI_TDR;
+  DMAC->DMAC_CH_NUM[ST7920_DMAC_CH].DMAC_DSCR  = 0;
+  DMAC->DMAC_CH_NUM[ST7920_DMAC_CH].DMAC_CTRLA = count | DMAC_CTRLA_SRC_WIDTH_BYTE | DMAC_CTRLA_DST_WIDTH_BYTE;
+  DMAC->DMAC_CH_NUM[ST7920_DMAC_CH].DMAC_CTRLB = DMAC_CTRLB_SRC_DSCR | DMAC_CTRLB_DST_DSCR | DMAC_CTRLB_FC_MEM2PER_DMA_FC
+                                               | DMAC_CTRLB_SRC_INCR_INCREMENTING | DMAC_CTRLB_DST_INCR_FIXED;
+  DMAC->DMAC_CH_NUM[ST7920_DMAC_CH].DMAC_CFG   = DMAC_CFG_DST_PER(ST7920_SPI_TX_IDX) | DMAC_CFG_DST_H2SEL
+                                               | DMAC_CFG_SOD | DMAC_CFG_FIFOCFG_ALAP_CFG;
+  DMAC->DMAC_CHER = DMAC_CHER_ENA0 << ST7920_DMAC_CH;
+}
+
+static void u8g_com_DUE_st7920_spi_init() {
+  // NPCS0 register, the PCS bits of the DMA bytes are 0. SPI mode 0, the DUE CPHA bit is inverted
+  SPI0->SPI_CSR[0] = SPI_CSR_SCBR(ST7920_SPI_DIVIDER) | SPI_CSR_CSAAT | SPI_CSR_NCPHA;
+}
+
+static void u8g_com_DUE_st7920_spi_send(const uint8_t val) {
+  while ((SPI0->SPI_SR & SPI_SR_TDRE) == 0) { /* nada */ }
+  SPI0->SPI_TDR = (uint32_t)val | SPI_PCS(0);
+}
+
+static void u8g_com_DUE_st7920_set_rs(const uint8_t rs) {
+  if (rs != rs_last_state) {  // time to send a command/data byte
+    rs_last_state = rs;
+    u8g_com_DUE_st7920_spi_send(rs ? 0x0FA : 0x0F8); // Command or Data
+    while ((SPI0->SPI_SR & SPI_SR_TXEMPTY) == 0) { /* nada */ }
+    DELAY_US(40); // give the controller some time to process the data: 20 is bad, 30 is OK, 40 is safe
+  }
+}
+
+static void u8g_com_DUE_st7920_write_byte_hw_spi(const uint8_t rs, const uint8_t val) {
+  u8g_com_DUE_st7920_dma_wait();
+  u8g_com_DUE_st7920_set_rs(rs);
+  u8g_com_DUE_st7920_spi_send(val & 0xF0);
+  u8g_com_DUE_st7920_spi_send(val << 4);
+}
+
+static void u8g_com_DUE_st7920_write_seq_hw_spi(const uint8_t rs, const uint8_t *ptr, uint8_t len) {
+  while (len > 0) {
+    const uint8_t n = MIN(len, ST7920_SEQ_MAX);
+    // Expand in the free buffer while the DMA sends the other one
+    uint8_t * const buf = dma_buffer[dma_index];
+    for (uint8_t i = 0; i < n; i++) {
+      buf[2 * i]     = ptr[i] & 0xF0;
+      buf[2 * i + 1] = ptr[i] << 4;
+    }
+    u8g_com_DUE_st7920_dma_wait();
+    u8g_com_DUE_st7920_set_rs(rs);
+    u8g_com_DUE_st7920_dma_start(buf, 2 * n);
+    dma_index ^= 1;
+    ptr += n;
+    len -= n;
+  }
+}
+
+uint8_t u8g_com_HAL_DUE_ST7920_hw_spi_fn(u8g_t *u8g, uint8_t msg, uint8_t arg_val, void *arg_ptr) {
+  switch (msg) {
+    case U8G_COM_MSG_INIT:
+      u8g_SetPILevel_DUE(u8g, U8G_PI_CS, 0);
+      u8g_SetPIOutput_DUE(u8g, U8G_PI_CS);
+
+      HAL::spiBegin();
+      u8g_com_DUE_st7920_spi_init();
+
+      pmc_enable_periph_clk(ID_DMAC);
+      DMAC->DMAC_EN = DMAC_EN_ENABLE;
+
+      u8g_Delay(5);
+
+      rs_last_state = 255;
+      u8g->pin_list[U8G_PI_A0_STATE] = 0;       /* initial RS state: command mode */
+      break;
+
+    case U8G_COM_MSG_STOP:
+      u8g_com_DUE_st7920_dma_wait();
+      break;
+
+    case U8G_COM_MSG_RESET:
+      if (U8G_PIN_NONE != u8g->pin_list[U8G_PI_RESET]) u8g_SetPILevel_DUE(u8g, U8G_PI_RESET, arg_val);
+      break;
+
+    case U8G_COM_MSG_ADDRESS:                     /* define cmd (arg_val = 0) or data mode (arg_val = 1) */
+      u8g->pin_list[U8G_PI_A0_STATE] = arg_val;
+      break;
+
+    case U8G_COM_MSG_CHIP_SELECT:
+      u8g_com_DUE_st7920_dma_wait();
+      if (arg_val) u8g_com_DUE_st7920_spi_init();   // The SPI0 is shared, another driver can have changed it
+      if (U8G_PIN_NONE != u8g->pin_list[U8G_PI_CS])
+        u8g_SetPILevel_DUE(u8g, U8G_PI_CS, arg_val);  //note: the st7920 has an active high chip select
+      break;
+
+    case U8G_COM_MSG_WRITE_BYTE:
+      u8g_com_DUE_st7920_write_byte_hw_spi(u8g->pin_list[U8G_PI_A0_STATE], arg_val);
+      break;
+
+    case U8G_COM_MSG_WRITE_SEQ:
+    case U8G_COM_MSG_WRITE_SEQ_P:
+      u8g_com_DUE_st7920_write_seq_hw_spi(u8g->pin_list[U8G_PI_A0_STATE], (uint8_t*)arg_ptr, arg_val);
+      break;
+  }
+  return 1;
+}
+
+#endif // U8GLIB_ST7920
+#endif // ARDUINO_ARCH_SAM
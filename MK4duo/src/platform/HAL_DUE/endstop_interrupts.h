@@ -37,48 +37,7 @@
  */
 
 void Endstops::setup_interrupts() {
-
-  #if HAS_X_MAX
-    attachInterrupt(digitalPinToInterrupt(X_MAX_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_X_MIN
-    attachInterrupt(digitalPinToInterrupt(X_MIN_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Y_MAX
-    attachInterrupt(digitalPinToInterrupt(Y_MAX_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Y_MIN
-    attachInterrupt(digitalPinToInterrupt(Y_MIN_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z_MAX
-    attachInterrupt(digitalPinToInterrupt(Z_MAX_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z_MIN
-    attachInterrupt(digitalPinToInterrupt(Z_MIN_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z2_MAX
-    attachInterrupt(digitalPinToInterrupt(Z2_MAX_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z2_MIN
-    attachInterrupt(digitalPinToInterrupt(Z2_MIN_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z3_MAX
-    attachInterrupt(digitalPinToInterrupt(Z3_MAX_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z3_MIN
-    attachInterrupt(digitalPinToInterrupt(Z3_MIN_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z_PROBE_PIN
-    attachInterrupt(digitalPinToInterrupt(Z_PROBE_PIN), endstop_ISR, CHANGE); // assign it
-  #endif
+  endstop_group_attach([](const pin_t pin) {
+    attachInterrupt(digitalPinToInterrupt(pin), endstop_ISR, CHANGE);
+  });
 }
@@ -157,6 +157,12 @@ FORCE_INLINE static bool READ(const pin_t pin) {
   }
 }
 
+// Input register and bit mask of a pin, for sampling a whole port with one read
+typedef volatile const uint32_t* port_input_t;
+typedef uint32_t port_mask_t;
+FORCE_INLINE static port_input_t PORT_INPUT(const pin_t pin) { return &fastio[uint8_t(pin)].base_address->PIO_PDSR; }
+FORCE_INLINE static port_mask_t PORT_MASK(const pin_t pin) { return MASK(fastio[uint8_t(pin)].shift_count); }
+
 // Write to a pin
 FORCE_INLINE static void WRITE(const pin_t pin, const bool flag) {
   #if ENABLED(PCF8574_EXPANSION_IO)
@@ -180,6 +186,46 @@ FORCE_INLINE static void TOGGLE(const pin_t pin) {
   WRITE(pin, !READ(pin));
 }
 
+#if ENABLED(STEP_PULSE_BATCH)
+
+  /**
+   * Step pulse batch
+   * While the batch is open the step and dir edges are collected in a set and a
+   * clear mask for each PIO, from the port and bit of the fastio table, then
+   * flushed with one SODR and one CODR store for each PIO.
+   */
+  #define HAL_STEP_BATCH_PORT(pio)  uint8_t(((uint32_t)(pio) - (uint32_t)PIOA) >> 9)
+
+  extern uint32_t HAL_step_batch_set[4],
+                  HAL_step_batch_clear[4];
+  extern uint8_t  HAL_step_batch_ports;
+  extern bool     HAL_step_batch_active;
+
+  FORCE_INLINE static void HAL_step_batch_open() { HAL_step_batch_active = true; }
+
+  FORCE_INLINE static void HAL_step_batch_add(const pin_t pin, const bool flag) {
+    const uint8_t   port = HAL_STEP_BATCH_PORT(fastio[uint8_t(pin)].base_address);
+    const uint32_t  mask = MASK(fastio[uint8_t(pin)].shift_count);
+    if (flag) HAL_step_batch_set[port] |= mask; else HAL_step_batch_clear[port] |= mask;
+    SBI(HAL_step_batch_ports, port);
+  }
+
+  FORCE_INLINE static void HAL_step_batch_flush() {
+    uint8_t ports = HAL_step_batch_ports;
+    while (ports) {
+      const uint8_t port = __builtin_ctz(ports);
+      Pio * const pio = (Pio*)((uint32_t)PIOA + (uint32_t(port) << 9));
+      if (HAL_step_batch_set[port])   pio->PIO_SODR = HAL_step_batch_set[port];
+      if (HAL_step_batch_clear[port]) pio->PIO_CODR = HAL_step_batch_clear[port];
+      HAL_step_batch_set[port] = HAL_step_batch_clear[port] = 0;
+      CBI(ports, port);
+    }
+    HAL_step_batch_ports = 0;
+    HAL_step_batch_active = false;
+  }
+
+#endif
+
 // Set pin as input
 FORCE_INLINE static void SET_INPUT(const pin_t pin) {
   #if ENABLED(PCF8574_EXPANSION_IO)
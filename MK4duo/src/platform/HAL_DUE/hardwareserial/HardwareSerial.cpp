@@ -63,12 +63,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
   // Read the character from the USART
   uint8_t c = HWUART->UART_RHR;
 
-  if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+  // A realtime command of the emergency parser is not stored
+  const bool realtime = Cfg::EMERGENCYPARSER && emergency_parser.update(emergency_state, c);
 
   // If the character is to be stored at the index just before the tail
   // (such that the head would advance to the current tail), the RX FIFO is
   // full, so don't write the character or advance the head.
-  if (i != t) {
+  if (realtime) {}
+  else if (i != t) {
     rx_buffer.buffer[h] = c;
     h = i;
   }
@@ -116,12 +118,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = HWUART->UART_RHR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+            // A realtime command of the emergency parser is not stored
+            const bool realtime = Cfg::EMERGENCYPARSER && emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
             // full, so don't write the character or advance the head.
-            if (i != t) {
+            if (realtime) {}
+            else if (i != t) {
               rx_buffer.buffer[h] = c;
               h = i;
             }
@@ -150,12 +154,14 @@ FORCE_INLINE void MKHardwareSerial<Cfg>::store_rxd_char() {
             // Read the character from the USART
             c = HWUART->UART_RHR;
 
-            if (Cfg::EMERGENCYPARSER) emergency_parser.update(emergency_state, c);
+            // A realtime command of the emergency parser is not stored
+            const bool realtime = Cfg::EMERGENCYPARSER && emergency_parser.update(emergency_state, c);
 
             // If the character is to be stored at the index just before the tail
             // (such that the head would advance to the current tail), the FIFO is
             // full, so don't write the character or advance the head.
-            if (i != t) {
+            if (realtime) {}
+            else if (i != t) {
               rx_buffer.buffer[h] = c;
               h = i;
             }
@@ -225,8 +231,14 @@ void MKHardwareSerial<Cfg>::UART_ISR() {
 
   const uint32_t status = HWUART->UART_SR;
 
-  // Data received?
-  if (status & UART_SR_RXRDY) store_rxd_char();
+  if (Cfg::RX_DMA) {
+    // PDC moved to the next buffer, queue the ring again for the following lap
+    if (status & UART_SR_ENDRX) {
+      HWUART->UART_RNPR = (uint32_t)rx_buffer.buffer;
+      HWUART->UART_RNCR = Cfg::RX_SIZE;
+    }
+  }
+  else if (status & UART_SR_RXRDY) store_rxd_char(); // Data received?
 
   if (Cfg::TX_SIZE > 0) {
     // Something to send, and TX interrupts are enabled (meaning something to send)?
@@ -277,15 +289,29 @@ void MKHardwareSerial<Cfg>::begin(const long baud) {
 
   // Configure interrupts
   HWUART->UART_IDR = 0xFFFFFFFF;
-  HWUART->UART_IER = UART_IER_RXRDY | UART_IER_OVRE | UART_IER_FRAME;
+
+  if (Cfg::RX_DMA) {
+    // The PDC writes the ring as two chained transfers of RX_SIZE bytes. The interrupt
+    // comes once per lap to chain the next one, instead of once per received byte.
+    rx_buffer.head = rx_buffer.tail = 0;
+    HWUART->UART_RPR  = (uint32_t)rx_buffer.buffer;
+    HWUART->UART_RCR  = Cfg::RX_SIZE;
+    HWUART->UART_RNPR = (uint32_t)rx_buffer.buffer;
+    HWUART->UART_RNCR = Cfg::RX_SIZE;
+    HWUART->UART_PTCR = UART_PTCR_RXTEN;
+    HWUART->UART_IER  = UART_IER_ENDRX | UART_IER_OVRE | UART_IER_FRAME;
+  }
+  else
+    HWUART->UART_IER = UART_IER_RXRDY | UART_IER_OVRE | UART_IER_FRAME;
 
   // Install interrupt handler
   install_isr(HWUART_IRQ, UART_ISR);
 
   // Configure priority. We need a very high priority to avoid losing characters
   // and we need to be able to preempt the Stepper ISR and everything else!
-  // (this could probably be fixed by using DMA with the Serial port)
-  NVIC_SetPriority(HWUART_IRQ, 1);
+  // With RX_DMA the interrupt only chains the PDC once per lap of the ring,
+  // so it can wait below the Stepper ISR (priority 2) without losing characters.
+  NVIC_SetPriority(HWUART_IRQ, Cfg::RX_DMA ? 4 : 1);
 
   // Enable UART interrupt in NVIC
   NVIC_EnableIRQ(HWUART_IRQ);
@@ -307,19 +333,21 @@ void MKHardwareSerial<Cfg>::end() {
   __DSB();
   __ISB();
 
+  if (Cfg::RX_DMA) HWUART->UART_PTCR = UART_PTCR_RXTDIS;
+
   pmc_disable_periph_clk(HWUART_IRQ_ID);
 }
 
 template<typename Cfg>
 int MKHardwareSerial<Cfg>::peek() {
-  const int v = rx_buffer.head == rx_buffer.tail ? -1 : rx_buffer.buffer[rx_buffer.tail];
+  const int v = rx_head() == rx_buffer.tail ? -1 : rx_buffer.buffer[rx_buffer.tail];
   return v;
 }
 
 template<typename Cfg>
 int MKHardwareSerial<Cfg>::read() {
 
-  const ring_buffer_pos_t h = rx_buffer.head;
+  const ring_buffer_pos_t h = rx_head();
   ring_buffer_pos_t t = rx_buffer.tail;
 
   if (h == t) return -1;
@@ -359,14 +387,14 @@ int MKHardwareSerial<Cfg>::read() {
 
 template<typename Cfg>
 typename MKHardwareSerial<Cfg>::ring_buffer_pos_t MKHardwareSerial<Cfg>::available() {
-  const ring_buffer_pos_t h = rx_buffer.head, t = rx_buffer.tail;
+  const ring_buffer_pos_t h = rx_head(), t = rx_buffer.tail;
   return (ring_buffer_pos_t)(Cfg::RX_SIZE + h - t) & (Cfg::RX_SIZE - 1);
 }
 
 template<typename Cfg>
 void MKHardwareSerial<Cfg>::flush() {
 
-  rx_buffer.tail = rx_buffer.head;
+  rx_buffer.tail = rx_head();
 
   if (Cfg::XONOFF) {
     if ((xon_xoff_state & XON_XOFF_CHAR_MASK) == XOFF_CHAR) {
@@ -629,4 +657,9 @@ void MKHardwareSerial<Cfg>::printFloat(double number, uint8_t digits) {
   MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>> mmuSerial;
 #endif
 
+#if ENABLED(TOOLBOARD) && TOOLBOARD_SERIAL > 0
+  template class MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>>;
+  MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>> toolboardSerial;
+#endif
+
 #endif // ARDUINO_ARCH_SAM
@@ -79,6 +79,11 @@ class MKHardwareSerial {
     FORCE_INLINE static void store_rxd_char();
     FORCE_INLINE static void _tx_thr_empty_irq(void);
 
+    // With RX_DMA the PDC fills rx_buffer and its pointer is the head
+    FORCE_INLINE static ring_buffer_pos_t rx_head() {
+      return Cfg::RX_DMA ? (ring_buffer_pos_t)(HWUART->UART_RPR - (uint32_t)rx_buffer.buffer) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1) : rx_buffer.head;
+    }
+
     static void UART_ISR(void);
 
   public: /** Public Function */
@@ -98,6 +103,9 @@ class MKHardwareSerial {
     FORCE_INLINE static uint8_t framing_errors() { return Cfg::RX_FRAMING_ERRORS ? rx_framing_errors : 0; }
     FORCE_INLINE static ring_buffer_pos_t rxMaxEnqueued() { return Cfg::MAX_RX_QUEUED ? rx_max_enqueued : 0; }
 
+    // Free bytes in the TX ring, writes up to this size never wait for the UART
+    FORCE_INLINE static uint8_t availableForWrite() { return Cfg::TX_SIZE > 0 ? (tx_buffer.tail - tx_buffer.head - 1) & (Cfg::TX_SIZE - 1) : 0; }
+
     FORCE_INLINE static void write(const char* str) { while (*str) write(*str++); }
     FORCE_INLINE static void write(const uint8_t* buffer, size_t size) { while (size--) write(*buffer++); }
     FORCE_INLINE static void print(const String& s) { for (int i = 0; i < (int)s.length(); i++) write(s[i]); }
@@ -137,3 +145,7 @@ class MKHardwareSerial {
 #if HAS_MMU2 && MMU2_SERIAL > 0
   extern MKHardwareSerial<MK4duoSerialCfg<MMU2_SERIAL>> mmuSerial;
 #endif
+
+#if ENABLED(TOOLBOARD) && TOOLBOARD_SERIAL > 0
+  extern MKHardwareSerial<MK4duoSerialCfg<TOOLBOARD_SERIAL>> toolboardSerial;
+#endif
@@ -43,6 +43,11 @@ bool MemoryStore::access_write() {
     eeprom_flush();
   #elif HAS_EEPROM_SD
     card.write_eeprom();
+  #elif HAS_EEPROM_PAGED
+    if (eeprom_page_flush()) {
+      SERIAL_LM(ECHO, MSG_HOST_ERR_EEPROM_WRITE);
+      return true;
+    }
   #endif
   return false;
 }
@@ -53,6 +58,11 @@ bool MemoryStore::write_data(int &pos, const uint8_t *value, size_t size, uint16
     uint8_t v = *value;
     #if HAS_EEPROM_SD
       eeprom_data[pos] = v;
+    #elif HAS_EEPROM_PAGED
+      if (eeprom_page_write(pos, v)) {
+        SERIAL_LM(ECHO, MSG_HOST_ERR_EEPROM_WRITE);
+        return true;
+      }
     #else
       uint8_t * const p = (uint8_t * const)pos;
       // EEPROM has only ~100,000 write cycles,
@@ -79,6 +89,8 @@ bool MemoryStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc
   while (size--) {
     #if HAS_EEPROM_SD
       uint8_t c = eeprom_data[pos];
+    #elif HAS_EEPROM_PAGED
+      uint8_t c = eeprom_page_read(pos);
     #else
       uint8_t c = eeprom_read_byte((uint8_t*)pos);
     #endif
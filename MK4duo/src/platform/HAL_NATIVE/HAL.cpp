@@ -0,0 +1,160 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+#include "../../../MK4duo.h"
+
+/** Public Parameters */
+uint32_t HAL_native_pins[NUM_DIGITAL_PINS / 32] = { 0 };
+
+#if ENABLED(STEP_PULSE_BATCH)
+  uint32_t  HAL_step_batch_set[NUM_DIGITAL_PINS / 32]   = { 0 },
+            HAL_step_batch_clear[NUM_DIGITAL_PINS / 32] = { 0 };
+  uint8_t   HAL_step_batch_ports  = 0;
+  bool      HAL_step_batch_active = false;
+#endif
+uint32_t HAL_native_blocks = 0;
+
+// No heap limit on the host, report the size of a big MCU
+int freeMemory() { return 96 * 1024; }
+
+void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t) {
+  WRITE(pin, ulValue > 127);
+}
+
+/**
+ * Task Tick, for each millisecond of the host clock
+ *
+ *  - Check the periodical actions each second
+ *  - Tick endstops state
+ */
+void HAL::Tick() {
+
+  MEMORY_PROFILE_ISR(MEM_ISR_TICK);
+  CRASH_RECORD_TICK();
+
+  static short_timer_t cycle_1s_timer(millis());
+
+  if (printer.isStopped()) return;
+
+  // Event 1.0 Second
+  if (cycle_1s_timer.expired(1000)) printer.check_periodical_actions();
+
+  // Z of the mesh under the nozzle
+  #if ENABLED(MESH_STEPPER_CORRECTION)
+    bedlevel.mesh_correction_tick();
+  #endif
+
+  // Tick endstops state, if required
+  endstops.Tick();
+
+}
+
+/**
+ * The endstops of the host build, on the steps done by the motors.
+ * The machine starts at the home of each axis, the endstops of the
+ * homing direction are triggered at the home, the others never.
+ */
+static xyz_long_t native_machine{0};
+
+#define _NATIVE_ENDSTOP(A,M,TRIGGERED) WRITE(A##_##M##_PIN, (TRIGGERED) != endstops.isLogic(A##_##M))
+
+static void native_endstops() {
+  #if HAS_X_MIN
+    _NATIVE_ENDSTOP(X, MIN, X_HOME_DIR < 0 && native_machine.x <= 0);
+  #endif
+  #if HAS_X_MAX
+    _NATIVE_ENDSTOP(X, MAX, X_HOME_DIR > 0 && native_machine.x >= 0);
+  #endif
+  #if HAS_Y_MIN
+    _NATIVE_ENDSTOP(Y, MIN, Y_HOME_DIR < 0 && native_machine.y <= 0);
+  #endif
+  #if HAS_Y_MAX
+    _NATIVE_ENDSTOP(Y, MAX, Y_HOME_DIR > 0 && native_machine.y >= 0);
+  #endif
+  #if HAS_Z_MIN
+    _NATIVE_ENDSTOP(Z, MIN, Z_HOME_DIR < 0 && native_machine.z <= 0);
+  #endif
+  #if HAS_Z_MAX
+    _NATIVE_ENDSTOP(Z, MAX, Z_HOME_DIR > 0 && native_machine.z >= 0);
+  #endif
+}
+
+/**
+ * The interrupts of the host build, from the watchdog reset
+ *
+ *  - HAL::Tick for each elapsed millisecond
+ *  - The stepper ISR, with no wait between the steps, and the endstops
+ *    after each step, as the endstop interrupts. A full planner waits
+ *    for the room of one block, as on a printer the look-ahead is full.
+ *    The other waits are for the end of the moves, all the blocks are done.
+ */
+void HAL::poll() {
+
+  static bool polling = false;
+  static millis_l last_tick = millis();
+
+  if (polling) return;
+  polling = true;
+
+  const millis_l now = millis();
+  while (PENDING(last_tick, now)) {
+    last_tick++;
+    Tick();
+  }
+
+  if (HAL_timer_isr_enabled) {
+    native_endstops();
+    const uint8_t free_blocks = planner.moves_free();
+    while (planner.has_blocks_queued() && !(free_blocks == 0 && planner.moves_free())) {
+      const xyz_long_t before = { stepper.position(X_AXIS), stepper.position(Y_AXIS), stepper.position(Z_AXIS) };
+      stepper.Step();
+      native_machine.x += stepper.position(X_AXIS) - before.x;
+      native_machine.y += stepper.position(Y_AXIS) - before.y;
+      native_machine.z += stepper.position(Z_AXIS) - before.z;
+      native_endstops();
+      endstops.update();
+    }
+    HAL_native_blocks += planner.moves_free() - free_blocks;
+  }
+
+  polling = false;
+}
+
+pin_t HAL::digital_value_pin() {
+  const pin_t pin = parser.value_pin();
+  return WITHIN(pin, 0 , NUM_DIGITAL_PINS - 1) ? pin : NoPin;
+}
+
+pin_t HAL::analog_value_pin() {
+  const pin_t pin = parser.value_pin();
+  return WITHIN(pin, 0 , NUM_DIGITAL_PINS - 1) ? pin : NoPin;
+}
+
+// Reset is the end of the host program
+void HAL::resetHardware() {
+  MKSERIAL1.flush();
+  exit(0);
+}
+
+#endif // ARDUINO_ARCH_NATIVE
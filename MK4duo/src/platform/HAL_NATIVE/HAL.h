@@ -0,0 +1,185 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include <stdint.h>
+
+// --------------------------------------------------------------------------
+// Types
+// --------------------------------------------------------------------------
+typedef uint32_t  hal_timer_t;
+typedef uintptr_t ptr_int_t;
+
+// --------------------------------------------------------------------------
+// Includes
+// --------------------------------------------------------------------------
+#include "watchdog/watchdog.h"
+#include "fastio.h"
+#include "math.h"
+#include "delay.h"
+#include "HAL_timers.h"
+
+// --------------------------------------------------------------------------
+// Defines
+// --------------------------------------------------------------------------
+#define MKSERIAL1 Serial
+
+#if ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 >= -1
+  #error "The native build has only one serial port"
+#endif
+
+// CRITICAL SECTION, one thread and no interrupts
+#define CRITICAL_SECTION_START  NOOP;
+#define CRITICAL_SECTION_END    NOOP;
+
+// ISR function
+#define ISRS_ENABLED()          true
+#define ENABLE_ISRS()           NOOP
+#define DISABLE_ISRS()          NOOP
+#define cli()                   NOOP
+#define sei()                   NOOP
+
+// Voltage
+#define HAL_VOLTAGE_PIN 3.3
+
+#define PACK    __attribute__ ((packed))
+
+// Macros for stepper.cpp
+#define HAL_MULTI_ACC(A,B)  MultiU32X24toH32(A,B)
+
+// Bits for PWM
+#undef PWM_RESOLUTION
+#define PWM_RESOLUTION       8
+
+// Bits of the ADC converter
+#define ANALOG_INPUT_BITS   12
+#define AD_RANGE          _BV(ANALOG_INPUT_BITS)
+#define ABS_ZERO          -273.15f
+#define NUM_ADC_SAMPLES     32
+#define AD595_MAX          330.0f
+#define AD8495_MAX         660.0f
+
+#define GET_PIN_MAP_PIN(index) index
+#define GET_PIN_MAP_INDEX(pin) pin
+#define PARSED_PIN_INDEX(code, dval) parser.intval(code, dval)
+
+// --------------------------------------------------------------------------
+// Public Variables
+// --------------------------------------------------------------------------
+
+// Blocks done by the stepper
+extern uint32_t HAL_native_blocks;
+
+int freeMemory();
+
+typedef AveragingFilter<NUM_ADC_SAMPLES> ADCAveragingFilter;
+
+/**
+ * The host build has no interrupts. The watchdog reset, at the end
+ * of each idle, is the point where the time-driven jobs are done,
+ * see HAL::poll. The heaters are not simulated, the temperatures
+ * are not read.
+ */
+class HAL {
+
+  public: /** Constructor */
+
+    HAL() { }
+
+    virtual ~HAL() {}
+
+  public: /** Public Function */
+
+    static void analogStart() {}
+    static void AdcChangePin(const pin_t, const pin_t) {}
+
+    static void hwSetup(void) {}
+
+    static void analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t PWM_freq=1000U);
+
+    FORCE_INLINE static bool claim_hardware_pwm(const pin_t pin, const uint16_t) { return USEABLE_HARDWARE_PWM(pin); }
+
+    static void Tick();
+
+    static void poll();
+
+    static int32_t analog2mv(const int16_t adc_raw) { return int32_t(adc_raw) * 3300 / AD_RANGE; }
+
+    static pin_t digital_value_pin();
+    static pin_t analog_value_pin();
+
+    FORCE_INLINE static void pinMode(const pin_t pin, const uint8_t mode) {
+      switch (mode) {
+        case INPUT:         SET_INPUT(pin);         break;
+        case OUTPUT:        SET_OUTPUT(pin);        break;
+        case INPUT_PULLUP:  SET_INPUT_PULLUP(pin);  break;
+        case OUTPUT_LOW:    SET_OUTPUT_LOW(pin);    break;
+        case OUTPUT_HIGH:   SET_OUTPUT_HIGH(pin);   break;
+        default:                                    break;
+      }
+    }
+    FORCE_INLINE static void digitalWrite(const pin_t pin, const bool value) {
+      WRITE(pin, value);
+    }
+    FORCE_INLINE static bool digitalRead(const pin_t pin) {
+      return READ(pin);
+    }
+    FORCE_INLINE static void setInputPullup(const pin_t pin, const bool onoff) {
+      onoff ? pinMode(pin, INPUT_PULLUP) : pinMode(pin, INPUT);
+    }
+
+    FORCE_INLINE static void delayNanoseconds(const uint32_t) {}
+    FORCE_INLINE static void delayMicroseconds(const uint32_t delayUs) {
+      ::delayMicroseconds(delayUs);
+    }
+    FORCE_INLINE static void delayMilliseconds(const uint16_t delayMs) {
+      delay(delayMs);
+    }
+    FORCE_INLINE static uint32_t timeInMilliseconds() {
+      return millis();
+    }
+
+    // The time of the host build runs in the loop, no sleep
+    FORCE_INLINE static void waitForInterrupt() {}
+
+    static void showStartReason() {}
+
+    static void resetHardware();
+
+    // SPI related functions, nothing on the bus
+    static void spiBegin() {}
+    static void spiInit(uint8_t) {}
+    static void spiSend(uint8_t) {}
+    static uint8_t spiReceive(void) { return 0xFF; }
+    static void spiReadBlock(uint8_t* buf, uint16_t nbyte) { memset(buf, 0xFF, nbyte); }
+    static void spiSendBlock(uint8_t, const uint8_t*) {}
+
+};
+
+// EEPROM
+uint8_t eeprom_read_byte(uint8_t* pos);
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n);
+void eeprom_write_byte(uint8_t* pos, uint8_t value);
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n);
@@ -0,0 +1,84 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+#include "../../../MK4duo.h"
+#include "HAL_timers.h"
+#include <time.h>
+
+// ------------------------
+// Public Variables
+// ------------------------
+hal_timer_t HAL_min_pulse_cycle     = 0,
+            HAL_pulse_high_tick     = 0,
+            HAL_pulse_low_tick      = 0,
+            HAL_frequency_limit[8]  = { 0 };
+
+bool        HAL_timer_isr_enabled   = false;
+hal_timer_t HAL_timer_compare       = 0;
+
+// ------------------------
+// Public functions
+// ------------------------
+hal_cycle_t HAL_native_cycles() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return hal_cycle_t(uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec);
+}
+
+hal_timer_t HAL_isr_execuiton_cycle(const hal_timer_t rate) {
+  return (ISR_BASE_CYCLES + ISR_BEZIER_CYCLES + (ISR_LOOP_CYCLES) * rate + ISR_LA_BASE_CYCLES + ISR_LA_LOOP_CYCLES) / rate;
+}
+
+hal_timer_t HAL_ns_to_pulse_tick(const hal_timer_t ns) {
+  return (ns + STEPPER_TIMER_PULSE_TICK_NS / 2) / STEPPER_TIMER_PULSE_TICK_NS;
+}
+
+// The same limits of a Cortex-M3 at F_CPU, the planner sees a real board
+void HAL_calc_pulse_cycle() {
+
+  const hal_timer_t HAL_min_step_period_ns = 1000000000UL / stepper.data.maximum_rate;
+  hal_timer_t       HAL_min_pulse_high_ns,
+                    HAL_min_pulse_low_ns;
+
+  HAL_min_pulse_cycle = MAX((hal_timer_t)((F_CPU) / stepper.data.maximum_rate), hal_timer_t((F_CPU) / 500000UL) * MAX((hal_timer_t)stepper.data.minimum_pulse, hal_timer_t(1)));
+
+  if (stepper.data.minimum_pulse) {
+    HAL_min_pulse_high_ns = hal_timer_t(stepper.data.minimum_pulse) * 1000UL;
+    HAL_min_pulse_low_ns  = MAX((HAL_min_step_period_ns - MIN(HAL_min_step_period_ns, HAL_min_pulse_high_ns)), HAL_min_pulse_high_ns);
+  }
+  else {
+    HAL_min_pulse_high_ns = 500000000UL / stepper.data.maximum_rate;
+    HAL_min_pulse_low_ns  = HAL_min_pulse_high_ns;
+  }
+
+  HAL_pulse_high_tick = HAL_ns_to_pulse_tick(HAL_min_pulse_high_ns - MIN(HAL_min_pulse_high_ns, hal_timer_t(TIMER_SETUP_NS)));
+  HAL_pulse_low_tick  = HAL_ns_to_pulse_tick(HAL_min_pulse_low_ns - MIN(HAL_min_pulse_low_ns, hal_timer_t(TIMER_SETUP_NS)));
+
+  // The stepping frequency limits for each multistepping rate
+  LOOP_L_N(i, 8)
+    HAL_frequency_limit[i] = ((F_CPU) / HAL_isr_execuiton_cycle(_BV(i))) >> i;
+
+}
+
+#endif // ARDUINO_ARCH_NATIVE
@@ -0,0 +1,102 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+// ------------------------
+// Defines
+// ------------------------
+#define FORCE_INLINE __attribute__((always_inline)) inline
+
+#define HAL_TIMER_TYPE_MAX          0xFFFFFFFF
+#define HAL_TIMER_RATE              ((F_CPU)/2)
+#define NUM_HARDWARE_TIMERS         1
+
+// Stepper Timer
+#define STEPPER_TIMER_NUM           0
+#define STEPPER_TIMER_PRESCALE      2
+#define STEPPER_TIMER_RATE          ((HAL_TIMER_RATE)/STEPPER_TIMER_PRESCALE)
+#define STEPPER_TIMER_TICKS_PER_US  ((STEPPER_TIMER_RATE)/1000000UL)
+#define STEPPER_TIMER_PULSE_TICK_NS (1000000000UL / STEPPER_TIMER_RATE)
+#define STEPPER_TIMER_MIN_INTERVAL  1
+#define STEPPER_TIMER_MAX_INTERVAL  (STEPPER_TIMER_TICKS_PER_US * STEPPER_TIMER_MIN_INTERVAL)
+
+#define START_STEPPER_INTERRUPT()   HAL_timer_start()
+#define ENABLE_STEPPER_INTERRUPT()  HAL_timer_enable_interrupt()
+#define DISABLE_STEPPER_INTERRUPT() HAL_timer_disable_interrupt()
+#define STEPPER_ISR_ENABLED()       HAL_timer_interrupt_is_enabled()
+
+// Cycle counter, the host clock in nanoseconds
+#define HAL_CYCLE_COUNTER_INIT()    NOOP
+#define HAL_CYCLE_COUNTER()         HAL_native_cycles()
+#define HAL_CYCLE_COUNTER_RATE      1000000000UL
+typedef uint32_t hal_cycle_t;
+
+// The ISR cycles of a Cortex-M3 at F_CPU, for the timings of the stepper
+#define TIMER_CYCLES                34UL
+#define ISR_BASE_CYCLES            792UL
+#if ENABLED(LIN_ADVANCE)
+  #define ISR_LA_BASE_CYCLES        64UL
+#else
+  #define ISR_LA_BASE_CYCLES         0UL
+#endif
+#if ENABLED(BEZIER_JERK_CONTROL)
+  #define ISR_BEZIER_CYCLES         40UL
+#else
+  #define ISR_BEZIER_CYCLES          0UL
+#endif
+#define ISR_LOOP_BASE_CYCLES         4UL
+#define ISR_STEPPER_CYCLES          16UL
+#define MIN_ISR_LOOP_CYCLES         (ISR_STEPPER_CYCLES * 4UL)
+#define ISR_LOOP_CYCLES             (ISR_LOOP_BASE_CYCLES + MAX(HAL_min_pulse_cycle, MIN_ISR_LOOP_CYCLES))
+#define TIMER_SETUP_NS              (1000UL * TIMER_CYCLES / ((F_CPU) / 1000000UL))
+#if ENABLED(LIN_ADVANCE)
+  #define ISR_LA_LOOP_CYCLES        MAX(HAL_min_pulse_cycle, 16UL)
+#else
+  #define ISR_LA_LOOP_CYCLES        0UL
+#endif
+
+// ------------------------
+// Public Variables
+// ------------------------
+extern hal_timer_t  HAL_min_pulse_cycle,
+                    HAL_pulse_high_tick,
+                    HAL_pulse_low_tick,
+                    HAL_frequency_limit[8];
+
+extern bool         HAL_timer_isr_enabled;
+extern hal_timer_t  HAL_timer_compare;
+
+// ------------------------
+// Public functions
+// ------------------------
+hal_cycle_t HAL_native_cycles();
+
+void HAL_calc_pulse_cycle();
+
+FORCE_INLINE void HAL_timer_start() { HAL_timer_isr_enabled = true; }
+FORCE_INLINE void HAL_timer_enable_interrupt() { HAL_timer_isr_enabled = true; }
+FORCE_INLINE void HAL_timer_disable_interrupt() { HAL_timer_isr_enabled = false; }
+FORCE_INLINE bool HAL_timer_interrupt_is_enabled() { return HAL_timer_isr_enabled; }
+FORCE_INLINE uint32_t HAL_timer_get_Clk_Freq() { return STEPPER_TIMER_RATE; }
+
+FORCE_INLINE hal_timer_t HAL_timer_get_current_count(const uint8_t) { return 0; }
+FORCE_INLINE void HAL_timer_set_count(const uint8_t, const hal_timer_t count) { HAL_timer_compare = count; }
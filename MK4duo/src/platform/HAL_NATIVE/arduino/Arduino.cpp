@@ -0,0 +1,111 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+/**
+ * Arduino.cpp
+ *
+ * The Arduino core of the host build
+ */
+
+#include "Arduino.h"
+#include "SPI.h"
+#include <time.h>
+#include <unistd.h>
+
+NativeSerial Serial;
+SPIClass SPI;
+
+// Time from the start of the program
+static uint64_t native_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+static const uint64_t native_start_ns = native_ns();
+
+uint32_t millis() { return uint32_t((native_ns() - native_start_ns) / 1000000ULL); }
+uint32_t micros() { return uint32_t((native_ns() - native_start_ns) / 1000ULL); }
+
+void delay(const uint32_t ms) { usleep(ms * 1000UL); }
+void delayMicroseconds(const uint32_t us) { usleep(us); }
+void yield() {}
+
+// Pins, the state is the one of fastio
+extern uint32_t HAL_native_pins[];
+
+void pinMode(const uint8_t pin, const uint8_t mode) {
+  if (mode == INPUT_PULLUP) digitalWrite(pin, HIGH);
+}
+void digitalWrite(const uint8_t pin, const uint8_t value) {
+  if (value) HAL_native_pins[pin >> 5] |= (1UL << (pin & 0x1F));
+  else       HAL_native_pins[pin >> 5] &= ~(1UL << (pin & 0x1F));
+}
+int digitalRead(const uint8_t pin) { return (HAL_native_pins[pin >> 5] >> (pin & 0x1F)) & 1; }
+int analogRead(const uint8_t) { return 0; }
+void analogWrite(const uint8_t pin, const int value) { digitalWrite(pin, value > 127); }
+void attachInterrupt(const uint8_t, void (*)(), const int) {}
+void detachInterrupt(const uint8_t) {}
+
+long random(long max) { return max > 0 ? rand() % max : 0; }
+long random(long min, long max) { return max > min ? min + rand() % (max - min) : min; }
+void randomSeed(unsigned long seed) { srand(seed); }
+
+char* dtostrf(double val, signed char width, unsigned char prec, char *s) {
+  sprintf(s, "%*.*f", width, prec, val);
+  return s;
+}
+
+char* ultoa(unsigned long val, char *s, int radix) {
+  char buffer[8 * sizeof(long) + 1], *p = &buffer[sizeof(buffer) - 1];
+  *p = '\0';
+  do {
+    const char c = val % radix;
+    val /= radix;
+    *--p = c < 10 ? c + '0' : c + 'a' - 10;
+  } while (val);
+  return strcpy(s, p);
+}
+char* ltoa(long val, char *s, int radix) {
+  if (val < 0 && radix == 10) {
+    *s = '-';
+    ultoa(0UL - (unsigned long)val, s + 1, radix);
+    return s;
+  }
+  return ultoa((unsigned long)val, s, radix);
+}
+char* itoa(int val, char *s, int radix) { return ltoa(val, s, radix); }
+char* utoa(unsigned val, char *s, int radix) { return ultoa(val, s, radix); }
+
+// The serial is the standard output, the commands come from the benchmark
+int NativeSerial::available() { return 0; }
+int NativeSerial::read() { return -1; }
+int NativeSerial::peek() { return -1; }
+size_t NativeSerial::write(const uint8_t c) {
+  if (!quiet) putchar(c);
+  return 1;
+}
+void NativeSerial::flush() { fflush(stdout); }
+
+#endif // ARDUINO_ARCH_NATIVE
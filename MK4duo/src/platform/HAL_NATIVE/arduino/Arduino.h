@@ -0,0 +1,262 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Arduino.h
+ *
+ * The part of the Arduino core used by MK4duo, for the host build.
+ * Time is the host clock, the pins are an array of states.
+ */
+
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define ARDUINO 10809
+
+#ifndef F_CPU
+  #define F_CPU 84000000UL
+#endif
+
+#define LOW           0
+#define HIGH          1
+#define INPUT         0x0
+#define OUTPUT        0x1
+#define INPUT_PULLUP  0x2
+#define CHANGE        2
+#define FALLING       3
+#define RISING        4
+
+#define PI            3.1415926535897932384626433832795
+#define HALF_PI       1.5707963267948966192313216916398
+#define TWO_PI        6.283185307179586476925286766559
+#define DEG_TO_RAD    0.017453292519943295769236907684886
+#define RAD_TO_DEG    57.295779513082320876798154814105
+
+#ifndef _BV
+  #define _BV(b)      (1UL << (b))
+#endif
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg)  ((deg)*DEG_TO_RAD)
+#define degrees(rad)  ((rad)*RAD_TO_DEG)
+#define sq(x)         ((x)*(x))
+
+#define lowByte(w)    ((uint8_t) ((w) & 0xFF))
+#define highByte(w)   ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+
+#define digitalPinToInterrupt(p)  (p)
+#define NOT_AN_INTERRUPT          -1
+
+// Program memory is the RAM
+#define PROGMEM
+#define PGM_P                     const char *
+#define PSTR(s)                   (s)
+#define F(s)                      (s)
+#define pgm_read_byte(addr)       (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr)  pgm_read_byte(addr)
+#define pgm_read_word(addr)       (*(addr))
+#define pgm_read_word_near(addr)  pgm_read_word(addr)
+#define pgm_read_dword(addr)      (*(addr))
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#define pgm_read_float(addr)      (*(const float *)(addr))
+#define pgm_read_ptr(addr)        (*(addr))
+#define strcpy_P                  strcpy
+#define strncpy_P                 strncpy
+#define strcat_P                  strcat
+#define strncat_P                 strncat
+#define strcmp_P                  strcmp
+#define strncmp_P                 strncmp
+#define strcasecmp_P              strcasecmp
+#define strstr_P                  strstr
+#define strchr_P                  strchr
+#define strrchr_P                 strrchr
+#define strlen_P                  strlen
+#define memcpy_P                  memcpy
+#define sprintf_P                 sprintf
+#define snprintf_P                snprintf
+#define vsnprintf_P               vsnprintf
+
+class __FlashStringHelper;
+
+// Only a holder of a text, for the String overloads of the libraries
+class String {
+
+  public: /** Constructor */
+
+    String(const char * const s="") : str(s) {}
+
+  private: /** Private Parameters */
+
+    const char *str;
+
+  public: /** Public Function */
+
+    const char* c_str() const { return str; }
+    size_t length() const { return strlen(str); }
+
+};
+
+// Time
+uint32_t millis();
+uint32_t micros();
+void delay(const uint32_t ms);
+void delayMicroseconds(const uint32_t us);
+void yield();
+
+// Pins
+void pinMode(const uint8_t pin, const uint8_t mode);
+void digitalWrite(const uint8_t pin, const uint8_t value);
+int digitalRead(const uint8_t pin);
+int analogRead(const uint8_t pin);
+void analogWrite(const uint8_t pin, const int value);
+void attachInterrupt(const uint8_t pin, void (*handler)(), const int mode);
+void detachInterrupt(const uint8_t pin);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+char* dtostrf(double val, signed char width, unsigned char prec, char *s);
+char* itoa(int val, char *s, int radix);
+char* ltoa(long val, char *s, int radix);
+char* utoa(unsigned val, char *s, int radix);
+char* ultoa(unsigned long val, char *s, int radix);
+
+#define DEC 10
+#define HEX 16
+#define OCT  8
+#define BIN  2
+
+/**
+ * Print as the Arduino core, to a write of a byte
+ */
+class Print {
+
+  public: /** Public Function */
+
+    virtual ~Print() {}
+
+    virtual size_t write(const uint8_t c) = 0;
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+      size_t n = 0;
+      while (size--) n += write(*buffer++);
+      return n;
+    }
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const char str[])                      { return write(str); }
+    size_t print(const __FlashStringHelper *str)        { return write((const char *)str); }
+    size_t print(const char c)                          { return write(uint8_t(c)); }
+    size_t print(const unsigned char n, int base=DEC)   { return printNumber(n, base); }
+    size_t print(const int n, int base=DEC)             { return print(long(n), base); }
+    size_t print(const unsigned int n, int base=DEC)    { return printNumber(n, base); }
+    size_t print(const long n, int base=DEC) {
+      if (base == DEC && n < 0) return write(uint8_t('-')) + printNumber(0UL - (unsigned long)n, DEC);
+      return printNumber((unsigned long)n, base);
+    }
+    size_t print(const unsigned long n, int base=DEC)   { return printNumber(n, base); }
+    size_t print(const long long n, int base=DEC)       { return print(long(n), base); }
+    size_t print(const unsigned long long n, int base=DEC) { return printNumber((unsigned long)n, base); }
+    size_t print(const double n, int digits=2) {
+      char buffer[40];
+      if (isnan(n)) return write("nan");
+      if (isinf(n)) return write("inf");
+      snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+      return write(buffer);
+    }
+
+    size_t println()                                    { return write(uint8_t('\n')); }
+    template<typename T> size_t println(const T v)      { return print(v) + println(); }
+    template<typename T> size_t println(const T v, int f) { return print(v, f) + println(); }
+
+  private: /** Private Function */
+
+    size_t printNumber(unsigned long n, int base) {
+      char buffer[8 * sizeof(long) + 1], *str = &buffer[sizeof(buffer) - 1];
+      *str = '\0';
+      if (base < 2) base = 10;
+      do {
+        const char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+      } while (n);
+      return write(str);
+    }
+
+};
+
+class Stream : public Print {
+
+  public: /** Public Function */
+
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+};
+
+/**
+ * The serial of the host build, stdin and stdout
+ */
+class NativeSerial : public Stream {
+
+  public: /** Public Parameters */
+
+    bool quiet;   // Drop the output, for the benchmarks
+
+  public: /** Public Function */
+
+    NativeSerial() : quiet(false) {}
+
+    void begin(const uint32_t) {}
+    void end() {}
+    operator bool() { return true; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(const uint8_t c) override;
+    using Print::write;
+    int availableForWrite() override { return 64; }
+    void flush() override;
+
+};
+
+extern NativeSerial Serial;
+
+#define SerialUSB Serial
@@ -0,0 +1,74 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * SPI.h
+ *
+ * An SPI bus of the host build, no device answers
+ */
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+#define LSBFIRST  0
+#define MSBFIRST  1
+
+#define SPI_CLOCK_DIV2    0x04
+#define SPI_CLOCK_DIV4    0x00
+#define SPI_CLOCK_DIV8    0x05
+#define SPI_CLOCK_DIV16   0x01
+#define SPI_CLOCK_DIV32   0x06
+#define SPI_CLOCK_DIV64   0x02
+#define SPI_CLOCK_DIV128  0x03
+
+class SPISettings {
+
+  public: /** Constructor */
+
+    SPISettings() {}
+    SPISettings(const uint32_t, const uint8_t, const uint8_t) {}
+
+};
+
+class SPIClass {
+
+  public: /** Public Function */
+
+    static void begin() {}
+    static void end() {}
+    static void beginTransaction(const SPISettings) {}
+    static void endTransaction() {}
+    static void setBitOrder(const uint8_t) {}
+    static void setDataMode(const uint8_t) {}
+    static void setClockDivider(const uint8_t) {}
+    static uint8_t transfer(const uint8_t) { return 0xFF; }
+    static uint16_t transfer16(const uint16_t) { return 0xFFFF; }
+    static void transfer(void *buf, const size_t count) { memset(buf, 0xFF, count); }
+
+};
+
+extern SPIClass SPI;
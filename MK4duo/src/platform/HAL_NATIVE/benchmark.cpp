@@ -0,0 +1,223 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+/**
+ * benchmark.cpp
+ *
+ * The main of the host build, it replays G-code files through the
+ * parser, the commands, the mechanics and the planner:
+ *
+ *   mk4duo_native [-v] [-r <count>] <file.gcode> ...
+ *   mk4duo_native -m
+ *
+ *   -v          Print the answers of the firmware
+ *   -r <count>  Replay the files count times (default 1)
+ *   -m          Check the error bounds of fastmath.h against libm
+ *
+ * For each file the parser alone, then the whole replay, are timed.
+ * The stepper ISR runs with no wait between the steps, see HAL::poll.
+ * The heaters are not simulated: cold extrusion is allowed and the waits
+ * for the temperatures (M109, M190, M191) are removed from the files.
+ * The last lines are the position and the steps at the end, the same
+ * firmware and the same files give the same lines, a check for the
+ * regressions.
+ */
+
+#include "../../../MK4duo.h"
+#include <time.h>
+
+static double benchmark_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Read a file and keep the commands, as the serial input does:
+ * comments, spaces and empty lines are removed.
+ * The waits for the temperatures are removed too.
+ * Return the number of lines, one after the other, nul terminated.
+ */
+static size_t benchmark_load(const char * const path, char * &text) {
+
+  FILE * const f = fopen(path, "rb");
+  if (!f) return 0;
+  fseek(f, 0, SEEK_END);
+  const long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+
+  char * const raw = (char*)malloc(size + 1);
+  text = (char*)malloc(size + 1);
+  const size_t len = fread(raw, 1, size, f);
+  fclose(f);
+  raw[len] = '\0';
+
+  size_t lines = 0;
+  char *out = text;
+  for (char *p = raw; *p;) {
+    char * const start = out;
+    bool comment = false;
+    for (; *p && *p != '\n' && *p != '\r'; p++) {
+      if (*p == ';' || *p == '(') comment = true;
+      if (!comment && !(out == start && *p == ' ')) *out++ = *p;
+    }
+    while (out > start && out[-1] == ' ') out--;
+    while (*p == '\n' || *p == '\r') p++;
+    *out = '\0';
+    const bool wait = !strncmp(start, "M109", 4) || !strncmp(start, "M190", 4) || !strncmp(start, "M191", 4);
+    if (out > start && out - start < MAX_CMD_SIZE && !wait) {
+      out++;
+      lines++;
+    }
+    else
+      out = start;
+  }
+
+  free(raw);
+  return lines;
+}
+
+/**
+ * The worst error of each function of fastmath.h on a sweep of its inputs,
+ * the libm function in double as the reference. Fails on a bound missed.
+ */
+static bool benchmark_check(const char * const name, const double err, const double bound) {
+  const bool ok = err < bound;
+  printf(" %-11s %.2e < %.0e %s\n", name, err, bound, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+static int benchmark_fastmath() {
+  double rsqrt_err = 0, sqrt_err = 0, atan2_err = 0, log_err = 0;
+
+  // Square roots from 1e-6 to 1e9, the steps^2 and mm^2 of the planner and the Transform
+  for (double x = 1e-6; x < 1e9; x *= 1.0001) {
+    const float f = float(x);
+    NOLESS(rsqrt_err, fabs(fast_rsqrt(f) * sqrt(double(f)) - 1.0));
+    NOLESS(sqrt_err, fabs(fast_sqrt(f) / sqrt(double(f)) - 1.0));
+  }
+
+  // atan2 all around, near the axes and the diagonals too
+  const double radius[] = { 1e-3, 1.0, 400.0 };
+  for (int32_t a = -200000; a <= 200000; a++) {
+    const double t = M_PI * a / 200000.0;
+    for (const double r : radius) {
+      const float y = float(r * sin(t)), x = float(r * cos(t));
+      double d = fabs(double(fast_atan2(y, x)) - atan2(double(y), double(x)));
+      if (d > M_PI) d = 2 * M_PI - d;
+      NOLESS(atan2_err, d);
+    }
+  }
+
+  // log from 1e-3 to 1e8 ohm, the resistance of the thermistors
+  for (double x = 1e-3; x < 1e8; x *= 1.0001) {
+    const float f = float(x);
+    NOLESS(log_err, fabs(double(fast_log(f)) - log(double(f))));
+  }
+
+  printf("fastmath.h:\n");
+  bool ok = benchmark_check("fast_rsqrt", rsqrt_err, 5e-6);
+  ok &= benchmark_check("fast_sqrt", sqrt_err, 5e-6);
+  ok &= benchmark_check("fast_atan2", atan2_err, 2e-6);
+  ok &= benchmark_check("fast_log", log_err, 2e-6);
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+
+  uint16_t repeat = 1;
+  int first = 1;
+  Serial.quiet = true;
+  for (; first < argc && argv[first][0] == '-'; first++) {
+    if (!strcmp(argv[first], "-m")) return benchmark_fastmath();
+    if (!strcmp(argv[first], "-v")) Serial.quiet = false;
+    else if (!strcmp(argv[first], "-r") && first + 1 < argc) repeat = MAX(atoi(argv[++first]), 1);
+    else break;
+  }
+
+  if (first >= argc) {
+    fprintf(stderr, "Usage: %s [-v] [-r <count>] <file.gcode> ...\n       %s -m\n", argv[0], argv[0]);
+    return 1;
+  }
+
+  printer.setup();
+  printer.setAllowColdExtrude(true);
+
+  for (int a = first; a < argc; a++) {
+
+    char *text = nullptr;
+    const size_t lines = benchmark_load(argv[a], text);
+    if (!lines) {
+      fprintf(stderr, "%s: no commands\n", argv[a]);
+      free(text);
+      return 1;
+    }
+
+    char buffer[MAX_CMD_SIZE];
+
+    // The parser alone
+    double start = benchmark_seconds();
+    for (uint16_t r = 0; r < repeat; r++) {
+      const char *line = text;
+      for (size_t l = 0; l < lines; l++) {
+        strcpy(buffer, line);
+        parser.parse(buffer);
+        line += strlen(line) + 1;
+      }
+    }
+    const double parse_s = benchmark_seconds() - start;
+
+    // The whole replay, as from the serial
+    const uint32_t blocks = HAL_native_blocks;
+    start = benchmark_seconds();
+    for (uint16_t r = 0; r < repeat; r++) {
+      const char *line = text;
+      for (size_t l = 0; l < lines; l++) {
+        commands.enqueue_one_now(line);
+        commands.advance_queue();
+        line += strlen(line) + 1;
+      }
+      planner.synchronize();
+    }
+    const double replay_s = benchmark_seconds() - start;
+
+    const uint32_t segments = HAL_native_blocks - blocks;
+    const double total = double(lines) * repeat;
+    printf("%s: %lu lines\n", argv[a], (unsigned long)lines);
+    printf(" parse:   %.3f s %.0f lines/s\n", parse_s, total / parse_s);
+    printf(" replay:  %.3f s %.0f lines/s\n", replay_s, total / replay_s);
+    printf(" planner: %lu segments %.0f segments/s\n", (unsigned long)segments, segments / replay_s);
+    printf(" position: X%.3f Y%.3f Z%.3f E%.3f\n",
+      mechanics.position.x, mechanics.position.y, mechanics.position.z, mechanics.position.e);
+    printf(" steps:    X%ld Y%ld Z%ld E%ld\n",
+      (long)stepper.position(X_AXIS), (long)stepper.position(Y_AXIS), (long)stepper.position(Z_AXIS), (long)stepper.position(E_AXIS));
+    fflush(stdout);
+
+    free(text);
+  }
+
+  return 0;
+}
+
+#endif // ARDUINO_ARCH_NATIVE
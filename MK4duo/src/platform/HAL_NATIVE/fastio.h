@@ -0,0 +1,105 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Pins of the host build, a state for each pin
+ */
+
+// ------------------------
+// Defines
+// ------------------------
+#define NUM_DIGITAL_PINS  256
+
+#define OUTPUT_LOW  0x4
+#define OUTPUT_HIGH 0x5
+
+extern uint32_t HAL_native_pins[NUM_DIGITAL_PINS / 32];
+
+// Read a pin
+FORCE_INLINE static bool READ(const uint8_t pin) {
+  return TEST32(HAL_native_pins[pin >> 5], pin & 0x1F);
+}
+
+// Input register and bit mask of a pin, for sampling a whole port with one read
+typedef volatile const uint32_t* port_input_t;
+typedef uint32_t port_mask_t;
+FORCE_INLINE static port_input_t PORT_INPUT(const uint8_t pin) { return &HAL_native_pins[pin >> 5]; }
+FORCE_INLINE static port_mask_t PORT_MASK(const uint8_t pin) { return _BV32(pin & 0x1F); }
+
+// Write to a pin
+FORCE_INLINE static void WRITE(const uint8_t pin, const bool flag) {
+  if (flag) SBI32(HAL_native_pins[pin >> 5], pin & 0x1F);
+  else      CBI32(HAL_native_pins[pin >> 5], pin & 0x1F);
+}
+
+// Toogle pin
+FORCE_INLINE static void TOGGLE(const uint8_t pin) {
+  HAL_native_pins[pin >> 5] ^= _BV32(pin & 0x1F);
+}
+
+#if ENABLED(STEP_PULSE_BATCH)
+
+  /**
+   * Step pulse batch
+   * The step and dir edges are collected in a set and a clear mask for each
+   * word of pins, then flushed with one store for each word.
+   */
+  extern uint32_t HAL_step_batch_set[NUM_DIGITAL_PINS / 32],
+                  HAL_step_batch_clear[NUM_DIGITAL_PINS / 32];
+  extern uint8_t  HAL_step_batch_ports;
+  extern bool     HAL_step_batch_active;
+
+  FORCE_INLINE static void HAL_step_batch_open() { HAL_step_batch_active = true; }
+
+  FORCE_INLINE static void HAL_step_batch_add(const pin_t pin, const bool flag) {
+    const uint8_t port = uint8_t(pin) >> 5;
+    if (flag) HAL_step_batch_set[port] |= _BV32(pin & 0x1F); else HAL_step_batch_clear[port] |= _BV32(pin & 0x1F);
+    SBI(HAL_step_batch_ports, port);
+  }
+
+  FORCE_INLINE static void HAL_step_batch_flush() {
+    uint8_t ports = HAL_step_batch_ports;
+    while (ports) {
+      const uint8_t port = __builtin_ctz(ports);
+      HAL_native_pins[port] = (HAL_native_pins[port] | HAL_step_batch_set[port]) & ~HAL_step_batch_clear[port];
+      HAL_step_batch_set[port] = HAL_step_batch_clear[port] = 0;
+      CBI(ports, port);
+    }
+    HAL_step_batch_ports = 0;
+    HAL_step_batch_active = false;
+  }
+
+#endif
+
+// Set pin as input or output
+FORCE_INLINE static void SET_INPUT(const pin_t) {}
+FORCE_INLINE static void SET_INPUT_PULLUP(const pin_t pin) { WRITE(pin, HIGH); }
+FORCE_INLINE static void SET_INPUT_ANALOG(const pin_t) {}
+FORCE_INLINE static void SET_OUTPUT(const pin_t) {}
+FORCE_INLINE static void SET_OUTPUT_LOW(const pin_t pin) { WRITE(pin, LOW); }
+FORCE_INLINE static void SET_OUTPUT_HIGH(const pin_t pin) { WRITE(pin, HIGH); }
+
+// Shorthand
+FORCE_INLINE static void OUT_WRITE(const pin_t pin, const uint8_t flag) { WRITE(pin, flag); }
+
+FORCE_INLINE static bool USEABLE_HARDWARE_PWM(const pin_t) { return true; }
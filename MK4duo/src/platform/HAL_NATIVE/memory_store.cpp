@@ -0,0 +1,82 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef ARDUINO_ARCH_NATIVE
+
+#include "../../../MK4duo.h"
+
+#if HAS_EEPROM
+
+MemoryStore memorystore;
+
+// The EEPROM of the host build is in RAM, it starts erased at each run
+static uint8_t eeprom_data[E2END + 1];
+static bool eeprom_erased = false;
+
+static void eeprom_erase() {
+  if (!eeprom_erased) {
+    memset(eeprom_data, 0xFF, sizeof(eeprom_data));
+    eeprom_erased = true;
+  }
+}
+
+/** Public Function */
+bool MemoryStore::access_start() {
+  eeprom_erase();
+  return false;
+}
+
+bool MemoryStore::access_write() { return false; }
+
+bool MemoryStore::write_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
+
+  eeprom_erase();
+  while (size--) {
+    const uint8_t v = *value;
+    eeprom_data[pos] = v;
+    crc16(crc, &v, 1);
+    pos++;
+    value++;
+  };
+
+  return false;
+}
+
+bool MemoryStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc, const bool writing/*=true*/) {
+
+  eeprom_erase();
+  while (size--) {
+    const uint8_t c = eeprom_data[pos];
+    if (writing) *value = c;
+    crc16(crc, &c, 1);
+    pos++;
+    value++;
+  };
+
+  return false;
+}
+
+size_t MemoryStore::capacity() { return E2END + 1; }
+
+#endif // HAS_EEPROM
+
+#endif // ARDUINO_ARCH_NATIVE
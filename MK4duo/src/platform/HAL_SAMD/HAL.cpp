@@ -323,11 +323,19 @@ void HAL::analogWrite(pin_t pin, uint32_t value, const uint16_t freq/*=1000U*/)
  */
 void HAL::Tick() {
 
+  MEMORY_PROFILE_ISR(MEM_ISR_TICK);
+  CRASH_RECORD_TICK();
+
   static short_timer_t  cycle_1s_timer(millis()),
                         cycle_100_timer(millis());
 
   if (printer.isStopped()) return;
 
+  #if ENABLED(LCD_ENCODER_ISR)
+    // Encoder wheel and click, queued for the UI
+    lcdui.encoder_isr();
+  #endif
+
   // Heaters set output PWM
   tempManager.set_output_pwm();
 
@@ -348,6 +356,11 @@ void HAL::Tick() {
     tempManager.set_current_temp_raw();
   #endif
 
+  // Z of the mesh under the nozzle
+  #if ENABLED(MESH_STEPPER_CORRECTION)
+    bedlevel.mesh_correction_tick();
+  #endif
+
   endstops.Tick();
 
 }
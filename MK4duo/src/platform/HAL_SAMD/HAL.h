@@ -204,6 +204,9 @@ class HAL {
 
     static void analogWrite(const pin_t pin, const uint32_t value, const uint16_t freq=1000U);
 
+    // Fixed timer channel per pin, just report the pins with hardware PWM
+    FORCE_INLINE static bool claim_hardware_pwm(const pin_t pin, const uint16_t) { return USEABLE_HARDWARE_PWM(pin); }
+
     static void Tick();
 
     static pin_t digital_value_pin();
@@ -246,6 +249,8 @@ class HAL {
       return millis();
     }
 
+    FORCE_INLINE static void waitForInterrupt() { __WFI(); }
+
     FORCE_INLINE static void setInputPullup(const pin_t pin, const bool onoff) {
       const PinDescription& pinDesc = g_APinDescription[pin];
       if (pinDesc.ulPinType != PIO_NOT_A_PIN) {
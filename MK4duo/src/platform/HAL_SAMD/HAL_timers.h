@@ -99,6 +99,12 @@ typedef struct {
 #define ENABLE_STEPPER_INTERRUPT()  HAL_timer_enable_interrupt(STEPPER_TIMER_NUM)
 #define DISABLE_STEPPER_INTERRUPT() HAL_timer_disable_interrupt(STEPPER_TIMER_NUM)
 
+// Cycle counter, used by the ISR profiler (no DWT on Cortex-M0+, use the stepper timer ticks)
+#define HAL_CYCLE_COUNTER_INIT()    NOOP
+#define HAL_CYCLE_COUNTER()         HAL_timer_get_current_count(STEPPER_TIMER_NUM)
+#define HAL_CYCLE_COUNTER_RATE      (STEPPER_TIMER_RATE)
+typedef hal_timer_t hal_cycle_t;
+
 #define HAL_ENABLE_ISRs()           ENABLE_STEPPER_INTERRUPT()
 #define HAL_DISABLE_ISRs()          DISABLE_STEPPER_INTERRUPT()
 
@@ -0,0 +1,45 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ *  Endstop interrupts for SAMD51 based targets.
+ *  The EIC has 16 lines and each pin is wired to only one of them (ulExtInt of the
+ *  pin description). Pins without a line, or two endstops on the same line, can't
+ *  raise the interrupt: the endstops are then polled in the Tick as before.
+ */
+
+void Endstops::setup_interrupts() {
+
+  if (!endstop_group_lines_free([](const pin_t pin) {
+    const EExt_Interrupts line = g_APinDescription[pin].ulExtInt;
+    return int8_t(line == EXTERNAL_INT_NONE || line == EXTERNAL_INT_NMI ? -1 : line);
+  })) {
+    flag.Polling = true;
+    return;
+  }
+
+  endstop_group_attach([](const pin_t pin) {
+    attachInterrupt(pin, endstop_ISR, CHANGE);
+  });
+
+}
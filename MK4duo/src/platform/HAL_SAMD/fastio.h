@@ -66,6 +66,12 @@ FORCE_INLINE static bool READ(const uint8_t pin) {
   return !!(PORT->Group[g_APinDescription[pin].ulPort].IN.reg & (1ul << g_APinDescription[pin].ulPin));
 }
 
+// Input register and bit mask of a pin, for sampling a whole port with one read
+typedef volatile const uint32_t* port_input_t;
+typedef uint32_t port_mask_t;
+FORCE_INLINE static port_input_t PORT_INPUT(const uint8_t pin) { return &PORT->Group[g_APinDescription[pin].ulPort].IN.reg; }
+FORCE_INLINE static port_mask_t PORT_MASK(const uint8_t pin) { return 1ul << g_APinDescription[pin].ulPin; }
+
 // write to a pin
 // On some boards pins > 0x100 are used. These are not converted to atomic actions. An critical section is needed.
 FORCE_INLINE static void WRITE(const uint8_t pin, const bool flag) {
@@ -29,6 +29,17 @@ static FORCE_INLINE uint32_t MultiU32X24toH32(uint32_t longIn1, uint32_t longIn2
 	return ((uint64_t)longIn1 * longIn2 + 0x00800000) >> 24;
 }
 
+#if defined(__ARM_FP) && (__ARM_FP & 4)
+
+  // Single precision FPU (Cortex-M4F): one VSQRT, without the errno check of sqrtf
+  static FORCE_INLINE float HAL_fast_sqrt(float x) {
+    __asm__ ("vsqrt.f32 %0, %1" : "=t" (x) : "t" (x));
+    return x;
+  }
+  #define HAL_FAST_SQRT(x) HAL_fast_sqrt(x)
+
+#endif
+
 // Class to perform averaging of values read from the ADC
 // numAveraged should be a power of 2 for best efficiency
 template <size_t numAveraged> class AveragingFilter {
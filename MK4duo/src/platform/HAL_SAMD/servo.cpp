@@ -0,0 +1,209 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Servos on the TCC channels of the SAMD: 50 Hz PWM with the compare in µs.
+ * The pulses go with no interrupt, the stepper ISR can't stretch them.
+ */
+
+#ifdef ARDUINO_ARCH_SAMD
+
+#include "../../../MK4duo.h"
+
+#if HAS_SERVOS
+
+#include "wiring_private.h"
+
+ServoInfo_t servo_info[MAX_SERVOS]; // static array of servo structures
+uint8_t ServoCount = 0;             // the total number of attached servo_info
+
+#define SERVO_MIN() (MIN_PULSE_WIDTH - min * 4)   // minimum value in µs for this servo
+#define SERVO_MAX() (MAX_PULSE_WIDTH - max * 4)   // maximum value in µs for this servo
+
+#define SERVO_TCC_PRESCALER   16                                            // 3 MHz from the 48 MHz GCLK0
+#define SERVO_TICKS_PER_US    ((F_CPU) / (SERVO_TCC_PRESCALER) / 1000000UL)
+
+/************ static functions common to all instances ***********************/
+static Tcc      *pwm_tcc[MAX_SERVOS] = { nullptr };
+static uint8_t  pwm_channel[MAX_SERVOS];
+static bool     tcc_enabled[TCC_INST_NUM] = { false };
+
+// Wait for synchronization of registers between the clock domains
+static __inline__ void syncTCC(Tcc* TCCx) __attribute__((always_inline, unused));
+static void syncTCC(Tcc* TCCx) {
+  while (TCCx->SYNCBUSY.reg & TCC_SYNCBUSY_MASK);
+}
+
+// Return false when the pin is not a TCC channel: a TC has no period register
+static bool pwm_attach(const uint8_t index, const pin_t pin) {
+
+  if (pwm_tcc[index]) return true;
+
+  const PinDescription &pinDesc = g_APinDescription[pin];
+  const uint32_t attr = pinDesc.ulPinAttribute;
+  if ((attr & PIN_ATTR_PWM) != PIN_ATTR_PWM) return false;
+
+  const uint32_t tcNum = GetTCNumber(pinDesc.ulPWMChannel);
+  if (tcNum >= TCC_INST_NUM) return false;
+
+  pinPeripheral(pin, (attr & PIN_ATTR_TIMER) ? PIO_TIMER : PIO_TIMER_ALT);
+
+  Tcc * const TCCx = (Tcc*) GetTC(pinDesc.ulPWMChannel);
+
+  if (!tcc_enabled[tcNum]) {
+    tcc_enabled[tcNum] = true;
+
+    const uint16_t GCLK_CLKCTRL_IDs[] = {
+      GCLK_CLKCTRL_ID(GCM_TCC0_TCC1), // TCC0
+      GCLK_CLKCTRL_ID(GCM_TCC0_TCC1), // TCC1
+      GCLK_CLKCTRL_ID(GCM_TCC2_TC3),  // TCC2
+    };
+    GCLK->CLKCTRL.reg = (uint16_t) (GCLK_CLKCTRL_CLKEN | GCLK_CLKCTRL_GEN_GCLK0 | GCLK_CLKCTRL_IDs[tcNum]);
+    while (GCLK->STATUS.bit.SYNCBUSY == 1);
+
+    // Disable TCCx
+    TCCx->CTRLA.bit.ENABLE = 0;
+    syncTCC(TCCx);
+    TCCx->CTRLA.reg = TCC_CTRLA_PRESCALER_DIV16;
+    syncTCC(TCCx);
+    // Set TCCx as normal PWM, a period of REFRESH_INTERVAL
+    TCCx->WAVE.reg = TCC_WAVE_WAVEGEN_NPWM;
+    syncTCC(TCCx);
+    TCCx->PER.reg = REFRESH_INTERVAL * SERVO_TICKS_PER_US - 1;
+    syncTCC(TCCx);
+    // Enable TCCx
+    TCCx->CTRLA.bit.ENABLE = 1;
+    syncTCC(TCCx);
+  }
+
+  pwm_channel[index] = GetTCChannelNumber(pinDesc.ulPWMChannel);
+  TCCx->CC[pwm_channel[index]].reg = 0;
+  syncTCC(TCCx);
+
+  pwm_tcc[index] = TCCx;
+  return true;
+}
+
+// The new compare goes at the end of a period, never a cut pulse
+static void pwm_write(const uint8_t index, const uint32_t us) {
+  Tcc * const TCCx = pwm_tcc[index];
+  TCCx->CTRLBSET.bit.LUPD = 1;
+  syncTCC(TCCx);
+  TCCx->CCB[pwm_channel[index]].reg = us * SERVO_TICKS_PER_US;
+  syncTCC(TCCx);
+  TCCx->CTRLBCLR.bit.LUPD = 1;
+  syncTCC(TCCx);
+}
+/****************** end of static functions ******************************/
+
+MKServo::MKServo() {
+  if (ServoCount < MAX_SERVOS) {
+    index = ServoCount++;                           // assign a servo index to this instance
+    servo_info[index].ticks = DEFAULT_PULSE_WIDTH;  // store default values
+  }
+  else
+    index = INVALID_SERVO;  // too many servo_info
+}
+
+int8_t MKServo::attach(const pin_t inPin) {
+  return attach(inPin, MIN_PULSE_WIDTH, MAX_PULSE_WIDTH);
+}
+
+int8_t MKServo::attach(const pin_t inPin, const int inMin, const int inMax) {
+
+  if (index >= MAX_SERVOS) return -1;
+
+  if (inPin > 0) servo_info[index].Pin.nbr = inPin;
+
+  if (!pwm_attach(index, servo_info[index].Pin.nbr)) {
+    if (inPin > 0) SERIAL_LM(ER, "Servo pin isn't a TCC channel");
+    return -1;
+  }
+
+  servo_info[index].ticks = DEFAULT_PULSE_WIDTH;
+
+  // todo min/max check: abs(min - MIN_PULSE_WIDTH) /4 < 128
+  min  = (MIN_PULSE_WIDTH - inMin) / 4; //resolution of min/max is 4 µs
+  max  = (MAX_PULSE_WIDTH - inMax) / 4;
+
+  servo_info[index].Pin.isActive = true;
+  pwm_write(index, servo_info[index].ticks);
+
+  return index;
+}
+
+void MKServo::detach() {
+  if (pwm_tcc[index]) pwm_write(index, 0);  // No pulses
+  servo_info[index].Pin.isActive = false;
+}
+
+void MKServo::write(int value) {
+  // treat values less than 544 as angles in degrees (valid values in microseconds are handled as microseconds)
+  if (value < MIN_PULSE_WIDTH)
+    value = map(value, 0, 180, SERVO_MIN(), SERVO_MAX());
+
+  writeMicroseconds(value);
+}
+
+void MKServo::writeMicroseconds(int value) {
+  // calculate and store the values for the given channel
+  byte channel = index;
+  if ((channel < MAX_SERVOS)) { // ensure channel is valid
+    LIMIT(value, SERVO_MIN(), SERVO_MAX());
+    servo_info[channel].ticks = value;
+    if (servo_info[channel].Pin.isActive) pwm_write(channel, value);
+  }
+}
+
+// return the value as degrees
+int MKServo::read() { return map(readMicroseconds() + 1, SERVO_MIN(), SERVO_MAX(), 0, 180); }
+
+int MKServo::readMicroseconds() {
+  unsigned int pulsewidth;
+  if (index != INVALID_SERVO) pulsewidth = servo_info[index].ticks;
+  else pulsewidth  = 0;
+  return pulsewidth;
+}
+
+bool MKServo::attached()  { return servo_info[index].Pin.isActive; }
+
+void MKServo::move(const int value) {
+  if (attach(0) >= 0) {
+    write(value);
+    HAL::delayMilliseconds(SERVO_DEACTIVATION_DELAY);
+    #if ENABLED(DEACTIVATE_SERVOS_AFTER_MOVE)
+      detach();
+    #endif
+  }
+}
+
+void MKServo::print_M281() {
+  SERIAL_LM(CFG, "Servo Angles: P<Servo> L<Low> U<Up>:");
+  SERIAL_SMV(CFG, "  M281 P", (int)index);
+  SERIAL_MV(" L", angle[0]);
+  SERIAL_MV(" U", angle[1]);
+  SERIAL_EOL();
+}
+
+#endif // HAS_SERVOS
+
+#endif // ARDUINO_ARCH_SAMD
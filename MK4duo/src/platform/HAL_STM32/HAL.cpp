@@ -171,6 +171,160 @@ void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t PWM_freq
 
 }
 
+#if HAS_TACHO_CAPTURE
+
+  /**
+   * Tachometer on the CH1 or CH2 input of a free timer, in PWM input mode.
+   * The channel of the pin captures the period, the slave mode resets the
+   * counter on each edge, so the counter is the time from the last edge.
+   * Return false when the pin is not a CH1/CH2 input or the timer is in use.
+   */
+  static uint32_t tacho_capture_mask = 0;
+
+  bool HAL::tacho_capture_init(const pin_t pin) {
+
+    if (pin <= 0) return false;
+
+    const PinName p = digitalPinToPinName(pin);
+    TIM_TypeDef * const Instance = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_TIM);
+    if (Instance == NP) return false;
+
+    #if defined(STEP_TIMER)
+      if (Instance == STEP_TIMER) return false;
+    #endif
+    #if defined(SERVO_TIMER)
+      if (Instance == SERVO_TIMER) return false;
+    #endif
+
+    const uint32_t index = get_timer_index(Instance);
+    if (TEST(tacho_capture_mask, index)) return true;
+    if (HardwareTimer_Handle[index] != NULL) return false;
+
+    const uint32_t channel = STM_PIN_CHANNEL(pinmap_function(p, PinMap_TIM));
+    if (channel != 1 && channel != 2) return false;
+
+    HardwareTimer * const timer = new HardwareTimer(Instance);
+    timer->setPrescaleFactor(timer->getTimerClkFreq() / (HAL_TACHO_CAPTURE_RATE));
+    timer->setOverflow(0x10000, TICK_FORMAT);
+    timer->setMode(channel, TIMER_INPUT_FREQ_DUTY_MEASUREMENT, p);
+    pin_PullConfig(get_GPIO_Port(STM_PORT(p)), STM_LL_GPIO_PIN(p), GPIO_PULLUP);
+
+    // Only the overflow sets the update flag, not the reset of the slave mode
+    __HAL_TIM_URS_ENABLE(&HardwareTimer_Handle[index]->handle);
+    timer->resume();
+
+    SBI(tacho_capture_mask, index);
+    return true;
+  }
+
+  /**
+   * Period of the last two edges and time from the last one, in HAL_TACHO_CAPTURE_RATE ticks.
+   * An overflow with no edge after it is a time longer than the counter.
+   */
+  void HAL::tacho_capture_read(const pin_t pin, uint32_t &period, uint32_t &age) {
+    const PinName p = digitalPinToPinName(pin);
+    const uint32_t  index   = get_timer_index((TIM_TypeDef *)pinmap_peripheral(p, PinMap_TIM)),
+                    channel = STM_PIN_CHANNEL(pinmap_function(p, PinMap_TIM));
+    HardwareTimer * const timer = (HardwareTimer *)(HardwareTimer_Handle[index]->__this);
+    TIM_HandleTypeDef * const htim = &HardwareTimer_Handle[index]->handle;
+
+    if (__HAL_TIM_GET_FLAG(htim, channel == 1 ? TIM_FLAG_CC1 : TIM_FLAG_CC2))
+      __HAL_TIM_CLEAR_FLAG(htim, TIM_FLAG_UPDATE);
+
+    period  = timer->getCaptureCompare(channel);
+    age     = __HAL_TIM_GET_FLAG(htim, TIM_FLAG_UPDATE) ? HAL_TIMER_TYPE_MAX : timer->getCount();
+  }
+
+#endif // HAS_TACHO_CAPTURE
+
+#if ENABLED(NEOPIXEL_DMA)
+
+  /**
+   * NeoPixel on a timer channel in PWM mode at 800 kHz. The compare of the
+   * channel requests the DMA, which writes the next compare in the preload
+   * register, loaded at the update. A bit is a period with a high time of
+   * 0.35 us (0) or 0.70 us (1), sent with no interrupt and no CPU time.
+   * The last compare of a frame is 0, the pin stays low.
+   * NEOPIXEL_DMA_STREAM and NEOPIXEL_DMA_CHANNEL are the request of the channel.
+   * Return false when the pin is not a channel of a free timer or the DMA has
+   * no stream (the processors with the DMA streams are the F2, F4 and F7).
+   */
+  #if defined(DMA_SxCR_CHSEL)
+    static DMA_HandleTypeDef neopixel_dma;
+    static volatile uint32_t *neopixel_ccr = nullptr;
+  #endif
+
+  bool HAL::neopixel_dma_init(const pin_t pin, uint16_t &bit0, uint16_t &bit1) {
+
+    #if defined(DMA_SxCR_CHSEL)
+
+      if (pin <= 0) return false;
+
+      const PinName p = digitalPinToPinName(pin);
+      TIM_TypeDef * const Instance = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+      if (Instance == NP) return false;
+
+      #if defined(STEP_TIMER)
+        if (Instance == STEP_TIMER) return false;
+      #endif
+      #if defined(SERVO_TIMER)
+        if (Instance == SERVO_TIMER) return false;
+      #endif
+
+      const uint32_t index = get_timer_index(Instance);
+      if (HardwareTimer_Handle[index] != NULL) return false;
+
+      __HAL_RCC_DMA1_CLK_ENABLE();
+      __HAL_RCC_DMA2_CLK_ENABLE();
+      neopixel_dma.Instance                 = NEOPIXEL_DMA_STREAM;
+      neopixel_dma.Init.Channel             = NEOPIXEL_DMA_CHANNEL;
+      neopixel_dma.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+      neopixel_dma.Init.PeriphInc           = DMA_PINC_DISABLE;
+      neopixel_dma.Init.MemInc              = DMA_MINC_ENABLE;
+      neopixel_dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+      neopixel_dma.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+      neopixel_dma.Init.Mode                = DMA_NORMAL;
+      neopixel_dma.Init.Priority            = DMA_PRIORITY_LOW;
+      neopixel_dma.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+      if (HAL_DMA_Init(&neopixel_dma) != HAL_OK) return false;
+
+      const uint32_t channel = STM_PIN_CHANNEL(pinmap_function(p, PinMap_PWM));
+
+      HardwareTimer * const timer = new HardwareTimer(Instance);
+      timer->setMode(channel, TIMER_OUTPUT_COMPARE_PWM1, p);
+      timer->setOverflow(800000UL, HERTZ_FORMAT);
+      timer->setCaptureCompare(channel, 0, TICK_COMPARE_FORMAT);
+
+      const uint32_t period = timer->getOverflow(TICK_FORMAT);
+      bit0 = period * 9 / 32;
+      bit1 = period * 9 / 16;
+
+      neopixel_ccr = &Instance->CCR1 + (channel - 1);
+      __HAL_TIM_ENABLE_DMA(&HardwareTimer_Handle[index]->handle, TIM_DMA_CC1 << (channel - 1));
+      timer->resume();
+      return true;
+
+    #else
+
+      UNUSED(pin); UNUSED(bit0); UNUSED(bit1);
+      return false;
+
+    #endif
+  }
+
+  // One compare for each bit of the frame
+  void HAL::neopixel_dma_send(const uint16_t *buffer, const uint16_t count) {
+    #if defined(DMA_SxCR_CHSEL)
+      // With no interrupt the HAL keep the stream busy after the transfer, the abort free it
+      HAL_DMA_Abort(&neopixel_dma);
+      HAL_DMA_Start(&neopixel_dma, (uint32_t)buffer, (uint32_t)neopixel_ccr, count);
+    #else
+      UNUSED(buffer); UNUSED(count);
+    #endif
+  }
+
+#endif // NEOPIXEL_DMA
+
 /**
  * Task Tick is is called 1000 timer per second.
  * It is used to update pwm values for heater and some other frequent jobs.
@@ -183,11 +337,19 @@ void HAL::analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t PWM_freq
  */
 void HAL::Tick() {
 
+  MEMORY_PROFILE_ISR(MEM_ISR_TICK);
+  CRASH_RECORD_TICK();
+
   static short_timer_t  cycle_1s_timer(millis()),
                         cycle_100_timer(millis());
 
   if (printer.isStopped()) return;
 
+  #if ENABLED(LCD_ENCODER_ISR)
+    // Encoder wheel and click, queued for the UI
+    lcdui.encoder_isr();
+  #endif
+
   // Heaters set output PWM
   tempManager.set_output_pwm();
 
@@ -240,7 +402,9 @@ void HAL::Tick() {
   #endif
 
   #if HAS_POWER_CONSUMPTION_SENSOR
-    const_cast<ADCAveragingFilter&>(powerFilter).process_reading(analogRead(POWER_CONSUMPTION_PIN));
+    const uint16_t power_raw = analogRead(POWER_CONSUMPTION_PIN);
+    powerManager.sample(power_raw);
+    const_cast<ADCAveragingFilter&>(powerFilter).process_reading(power_raw);
     if (powerFilter.IsValid())
       powerManager.current_raw_powconsumption = powerFilter.GetSum();
   #endif
@@ -257,6 +421,11 @@ void HAL::Tick() {
       HAL_VREF = 1210 * AD_RANGE / vrefFilter.GetSum(); // ADC sample to mV
   #endif
 
+  // Z of the mesh under the nozzle
+  #if ENABLED(MESH_STEPPER_CORRECTION)
+    bedlevel.mesh_correction_tick();
+  #endif
+
   // Tick endstops state, if required
   endstops.Tick();
 
@@ -289,5 +458,13 @@ extern "C" void HAL_SYSTICK_Callback(void) { HAL::Tick(); }
 
 void Step_Handler(HardwareTimer*) { stepper.Step(); }
 
+#ifdef TONE_TIMER
+  void Tone_Handler(HardwareTimer*) {
+    #if HAS_TONE_ISR
+      Sound::tone_isr();
+    #endif
+  }
+#endif
+
 
 #endif // ARDUINO_ARCH_STM32
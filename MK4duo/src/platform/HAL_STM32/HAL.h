@@ -213,6 +213,19 @@ class HAL {
 
     static void analogWrite(const pin_t pin, uint32_t ulValue, const uint16_t PWM_freq=1000U);
 
+    // Fixed timer channel per pin, just report the pins with hardware PWM
+    FORCE_INLINE static bool claim_hardware_pwm(const pin_t pin, const uint16_t) { return USEABLE_HARDWARE_PWM(pin); }
+
+    #if HAS_TACHO_CAPTURE
+      static bool tacho_capture_init(const pin_t pin);
+      static void tacho_capture_read(const pin_t pin, uint32_t &period, uint32_t &age);
+    #endif
+
+    #if ENABLED(NEOPIXEL_DMA)
+      static bool neopixel_dma_init(const pin_t pin, uint16_t &bit0, uint16_t &bit1);
+      static void neopixel_dma_send(const uint16_t *buffer, const uint16_t count);
+    #endif
+
     static void Tick();
 
     static int32_t analog2mv(const int16_t adc_raw);
@@ -254,6 +267,8 @@ class HAL {
       return millis();
     }
 
+    FORCE_INLINE static void waitForInterrupt() { __WFI(); }
+
     static void showStartReason();
 
     static void resetHardware();
@@ -37,6 +37,9 @@ hal_timer_t HAL_min_pulse_cycle     = 0,
 // Hardware Timer
 // ------------------------
 HardwareTimer *MK_step_timer = nullptr;
+#ifdef TONE_TIMER
+  HardwareTimer *MK_tone_timer = nullptr;
+#endif
 
 // ------------------------
 // Public functions
@@ -105,6 +108,20 @@ void HAL_timer_disable_interrupt() {
   }
 }
 
+#ifdef TONE_TIMER
+
+  void HAL_tone_timer_start(const uint32_t frequency) {
+    if (!MK_tone_timer) {
+      MK_tone_timer = new HardwareTimer(TONE_TIMER);
+      MK_tone_timer->setInterruptPriority(NvicPriorityTone, 0);
+      MK_tone_timer->attachInterrupt(Tone_Handler);
+    }
+    MK_tone_timer->setOverflow(frequency, HERTZ_FORMAT);
+    MK_tone_timer->resume();
+  }
+
+#endif
+
 uint32_t HAL_timer_get_Clk_Freq() {
   return HAL_timer_initialized() ? MK_step_timer->getTimerClkFreq() : 0;
 }
@@ -30,6 +30,7 @@
 #define HAL_TIMER_RATE              ((F_CPU)/2)
 #define NUM_HARDWARE_TIMERS         1                                           // Only Stepper use Hardware Timer
 #define NvicPriorityStepper         2
+#define NvicPriorityTone            6
 #define NvicPrioritySystick         0x0F
 
 // Stepper Timer
@@ -46,6 +47,30 @@
 #define DISABLE_STEPPER_INTERRUPT() HAL_timer_disable_interrupt()
 #define STEPPER_ISR_ENABLED()       HAL_timer_interrupt_is_enabled()
 
+// Tone Timer, the timer of the tone() of the core if the board gives none.
+// Its ISR plays the sound queue, tone() is not used.
+#if !defined(TONE_TIMER) && defined(TIMER_TONE)
+  #define TONE_TIMER                TIMER_TONE
+#endif
+#ifdef TONE_TIMER
+  #define HAL_TONE_ISR
+  #define HAL_TONE_TIMER_START(F)   HAL_tone_timer_start(F)
+  #define HAL_TONE_TIMER_RATE(F)    MK_tone_timer->setOverflow(F, HERTZ_FORMAT)
+  #define HAL_TONE_TIMER_STOP()     MK_tone_timer->pause()
+#endif
+
+// Tachometer capture clock, prescaled timer clock with a 16 bit counter (1.3 s)
+#define HAL_TACHO_CAPTURE_RATE      50000UL
+
+// NeoPixel DMA, the DMA writes the compare of the channel for each bit
+#define HAL_NEOPIXEL_DMA_STRIDE     1
+
+// Cycle counter, used by the ISR profiler and the endstop trigger capture (DWT on Cortex-M3/M4)
+#define HAL_CYCLE_COUNTER_INIT()    do{ CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; DWT->CYCCNT = 0; DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk; }while(0)
+#define HAL_CYCLE_COUNTER()         (DWT->CYCCNT)
+#define HAL_CYCLE_COUNTER_RATE      (F_CPU)
+typedef uint32_t hal_cycle_t;
+
 // Estimate the amount of time the ISR will take to execute
 #define TIMER_CYCLES                34UL
 
@@ -136,11 +161,17 @@ extern hal_timer_t  HAL_min_pulse_cycle,
 // Hardware Timer
 // ------------------------
 extern HardwareTimer *MK_step_timer;
+#ifdef TONE_TIMER
+  extern HardwareTimer *MK_tone_timer;
+#endif
 
 // ------------------------
 // Public functions for timer
 // ------------------------
 extern void Step_Handler(HardwareTimer*);
+#ifdef TONE_TIMER
+  extern void Tone_Handler(HardwareTimer*);
+#endif
 
 // ------------------------
 // Public functions
@@ -151,6 +182,9 @@ void HAL_timer_enable_interrupt();
 void HAL_timer_disable_interrupt();
 bool HAL_timer_interrupt_is_enabled();
 uint32_t HAL_timer_get_Clk_Freq();
+#ifdef TONE_TIMER
+  void HAL_tone_timer_start(const uint32_t frequency);
+#endif
 
 FORCE_INLINE bool HAL_timer_initialized() {
   return MK_step_timer != nullptr;
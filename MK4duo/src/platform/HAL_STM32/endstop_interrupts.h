@@ -21,49 +21,21 @@
  */
 #pragma once
 
-void Endstops::setup_interrupts() {
-
-  #if HAS_X_MAX
-    attachInterrupt(X_MAX_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_X_MIN
-    attachInterrupt(X_MIN_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Y_MAX
-    attachInterrupt(Y_MAX_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Y_MIN
-    attachInterrupt(Y_MIN_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z_MAX
-    attachInterrupt(Z_MAX_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z_MIN
-    attachInterrupt(Z_MIN_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
-
-  #if HAS_Z2_MAX
-    attachInterrupt(Z2_MAX_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
+/**
+ *  Endstop interrupts for STM32 based targets.
+ *  All pins have an EXTI line, but the line is the pin number inside the port:
+ *  PA0 and PB0 share EXTI0. With two endstops on the same line the endstops are polled.
+ */
 
-  #if HAS_Z2_MIN
-    attachInterrupt(Z2_MIN_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
+void Endstops::setup_interrupts() {
 
-  #if HAS_Z3_MAX
-    attachInterrupt(Z3_MAX_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
+  if (!endstop_group_lines_free([](const pin_t pin) { return int8_t(STM_PIN(digitalPinToPinName(pin))); })) {
+    flag.Polling = true;
+    return;
+  }
 
-  #if HAS_Z3_MIN
-    attachInterrupt(Z3_MIN_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
+  endstop_group_attach([](const pin_t pin) {
+    attachInterrupt(pin, endstop_ISR, CHANGE);
+  });
 
-  #if HAS_Z_PROBE_PIN
-    attachInterrupt(Z_PROBE_PIN, endstop_ISR, CHANGE); // assign it
-  #endif
 }
@@ -19,10 +19,15 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  *
  */
-#pragma once
 
 #if defined(ARDUINO_ARCH_STM32) && !defined(STM32GENERIC)
 
 #include "../../../MK4duo.h"
 
+#if ENABLED(STEP_PULSE_BATCH)
+  uint32_t  HAL_step_batch_bsrr[MAX_NB_PORT]  = { 0 };
+  uint16_t  HAL_step_batch_ports              = 0;
+  bool      HAL_step_batch_active             = false;
+#endif
+
 #endif
@@ -79,6 +79,12 @@ FORCE_INLINE static bool READ(const uint8_t pin) {
   }
 }
 
+// Input register and bit mask of a pin, for sampling a whole port with one read
+typedef volatile const uint32_t* port_input_t;
+typedef uint32_t port_mask_t;
+FORCE_INLINE static port_input_t PORT_INPUT(const uint8_t pin) { return &GPIOPort[GPIO2PORT(pin)]->IDR; }
+FORCE_INLINE static port_mask_t PORT_MASK(const uint8_t pin) { return GPIO2BIT(pin); }
+
 // Write to a pin
 FORCE_INLINE static void WRITE(const uint8_t pin, const bool flag) {
   #if ENABLED(PCF8574_EXPANSION_IO)
@@ -176,6 +182,39 @@ FORCE_INLINE static void OUT_WRITE(const pin_t pin, const uint8_t flag) {
   }
 }
 
+#if ENABLED(STEP_PULSE_BATCH)
+
+  /**
+   * Step pulse batch
+   * While the batch is open the step and dir edges are collected in one
+   * BSRR word for each GPIO port, then flushed with one store per port.
+   */
+  extern uint32_t HAL_step_batch_bsrr[MAX_NB_PORT];
+  extern uint16_t HAL_step_batch_ports;
+  extern bool     HAL_step_batch_active;
+
+  FORCE_INLINE static void HAL_step_batch_open() { HAL_step_batch_active = true; }
+
+  FORCE_INLINE static void HAL_step_batch_add(const pin_t pin, const bool flag) {
+    const uint8_t port = GPIO2PORT(pin);
+    HAL_step_batch_bsrr[port] |= flag ? GPIO2BIT(pin) : GPIO2BIT(pin) << 16;
+    SBI(HAL_step_batch_ports, port);
+  }
+
+  FORCE_INLINE static void HAL_step_batch_flush() {
+    uint16_t ports = HAL_step_batch_ports;
+    while (ports) {
+      const uint8_t port = __builtin_ctz(ports);
+      GPIOPort[port]->BSRR = HAL_step_batch_bsrr[port];
+      HAL_step_batch_bsrr[port] = 0;
+      CBI(ports, port);
+    }
+    HAL_step_batch_ports = 0;
+    HAL_step_batch_active = false;
+  }
+
+#endif
+
 FORCE_INLINE static bool USEABLE_HARDWARE_PWM(const pin_t pin) {
   return digitalPinHasPWM(pin);
 }
@@ -105,3 +105,19 @@
     #define mmuSerial Serial6
   #endif
 #endif
+
+#if ENABLED(TOOLBOARD) && TOOLBOARD_SERIAL > 0
+  #if TOOLBOARD_SERIAL == 1
+    #define toolboardSerial Serial1
+  #elif TOOLBOARD_SERIAL == 2
+    #define toolboardSerial Serial2
+  #elif TOOLBOARD_SERIAL == 3
+    #define toolboardSerial Serial3
+  #elif TOOLBOARD_SERIAL == 4
+    #define toolboardSerial Serial4
+  #elif TOOLBOARD_SERIAL == 5
+    #define toolboardSerial Serial5
+  #elif TOOLBOARD_SERIAL == 6
+    #define toolboardSerial Serial6
+  #endif
+#endif
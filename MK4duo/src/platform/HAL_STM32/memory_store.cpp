@@ -50,6 +50,11 @@ bool MemoryStore::access_write() {
     eeprom_buffer_flush();
   #elif HAS_EEPROM_SD
     card.write_eeprom();
+  #elif HAS_EEPROM_PAGED
+    if (eeprom_page_flush()) {
+      SERIAL_LM(ECHO, MSG_HOST_ERR_EEPROM_WRITE);
+      return true;
+    }
   #endif
   return false;
 }
@@ -62,6 +67,11 @@ bool MemoryStore::write_data(int &pos, const uint8_t *value, size_t size, uint16
       eeprom_buffered_write_byte(pos, v);
     #elif HAS_EEPROM_SD
       eeprom_data[pos] = v;
+    #elif HAS_EEPROM_PAGED
+      if (eeprom_page_write(pos, v)) {
+        SERIAL_LM(ECHO, MSG_HOST_ERR_EEPROM_WRITE);
+        return true;
+      }
     #else
       uint8_t * const p = (uint8_t * const)pos;
       // EEPROM has only ~100,000 write cycles,
@@ -90,6 +100,8 @@ bool MemoryStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc
       const uint8_t c = eeprom_buffered_read_byte(pos);
     #elif HAS_EEPROM_SD
       const uint8_t c = eeprom_data[pos];
+    #elif HAS_EEPROM_PAGED
+      const uint8_t c = eeprom_page_read(pos);
     #else
       const uint8_t c = eeprom_read_byte((uint8_t*)pos);
     #endif
@@ -39,6 +39,69 @@ static HardwareTimer TimerServo(SERVO_TIMER);
 static volatile int8_t timerChannel[_Nbr_16timers] = {-1};  // counter for the servo being pulsed for each timer (or -1 if refresh interval)
 volatile uint32_t CumulativeCountSinceRefresh = 0;
 
+#if ENABLED(SERVO_HARDWARE_PWM)
+
+  /**
+   * A servo on a channel of a free timer, in PWM mode at 50 Hz with the compare in µs.
+   * The pulses go with no interrupt, the stepper ISR can't stretch them.
+   * The servos on the channels of one timer share it.
+   */
+  static HardwareTimer *pwm_timer[MAX_SERVOS] = { nullptr };
+  static uint32_t pwm_channel[MAX_SERVOS],
+                  pwm_timer_mask = 0;                         // Timers of the servos
+
+  #define IS_PWM_SERVO(I) (pwm_timer[I] != nullptr)
+
+  // Return false when the pin is not a channel of a free timer
+  static bool pwm_attach(const uint8_t index, const pin_t pin) {
+
+    if (IS_PWM_SERVO(index)) return true;
+
+    const PinName p = digitalPinToPinName(pin);
+    TIM_TypeDef * const Instance = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+    if (Instance == NP) return false;
+
+    #if defined(STEP_TIMER)
+      if (Instance == STEP_TIMER) return false;
+    #endif
+    if (Instance == SERVO_TIMER) return false;
+    #if defined(TONE_TIMER)
+      if (Instance == TONE_TIMER) return false;
+    #endif
+
+    const uint32_t timer_index = get_timer_index(Instance);
+    HardwareTimer *timer;
+    if (TEST(pwm_timer_mask, timer_index))
+      timer = (HardwareTimer *)(HardwareTimer_Handle[timer_index]->__this);
+    else {
+      if (HardwareTimer_Handle[timer_index] != NULL) return false;
+      timer = new HardwareTimer(Instance);
+      timer->setOverflow(REFRESH_INTERVAL, MICROSEC_FORMAT);
+      SBI(pwm_timer_mask, timer_index);
+    }
+
+    pwm_channel[index] = STM_PIN_CHANNEL(pinmap_function(p, PinMap_PWM));
+    timer->setMode(pwm_channel[index], TIMER_OUTPUT_COMPARE_PWM1, p);
+    timer->setCaptureCompare(pwm_channel[index], 0, MICROSEC_COMPARE_FORMAT);
+    timer->resume();
+
+    pwm_timer[index] = timer;
+    return true;
+  }
+
+  FORCE_INLINE static void pwm_write(const uint8_t index, const uint32_t us) {
+    pwm_timer[index]->setCaptureCompare(pwm_channel[index], us, MICROSEC_COMPARE_FORMAT);
+  }
+
+#else
+  #define IS_PWM_SERVO(I) false
+#endif
+
+// The servo pulsed by the timer ISR
+FORCE_INLINE static bool isr_active(const uint8_t index) {
+  return servo_info[index].Pin.isActive == true && !IS_PWM_SERVO(index);
+}
+
 static void Servo_PeriodElapsedCallback(HardwareTimer*) {
   // Only 1 timer used
   timer16_Sequence_t timer_id = _timer1;
@@ -46,7 +109,7 @@ static void Servo_PeriodElapsedCallback(HardwareTimer*) {
   if (timerChannel[timer_id] < 0) // Restart from 1st servo
     CumulativeCountSinceRefresh = 0;
   else {
-    if (timerChannel[timer_id] < ServoCount && servo_info[timerChannel[timer_id]].Pin.isActive == true)
+    if (timerChannel[timer_id] < ServoCount && isr_active(timerChannel[timer_id]))
       digitalWrite(servo_info[timerChannel[timer_id]].Pin.nbr, LOW); // pulse this channel low if activated
   }
 
@@ -54,7 +117,7 @@ static void Servo_PeriodElapsedCallback(HardwareTimer*) {
   if (timerChannel[timer_id] < ServoCount && timerChannel[timer_id] < SERVOS_PER_TIMER) {
     TimerServo.setOverflow(servo_info[timerChannel[timer_id]].ticks);
     CumulativeCountSinceRefresh += servo_info[timerChannel[timer_id]].ticks;
-    if (servo_info[timerChannel[timer_id]].Pin.isActive == true)
+    if (isr_active(timerChannel[timer_id]))
       digitalWrite(servo_info[timerChannel[timer_id]].Pin.nbr, HIGH);
   }
   else {
@@ -79,7 +142,7 @@ static void TimerServoInit() {
 static bool isTimerActive() {
   // returns true if any servo is active on this timer
   for (uint8_t channel = 0; channel < SERVOS_PER_TIMER; channel++) {
-    if (servo_info[channel].Pin.isActive == true) return true;
+    if (isr_active(channel)) return true;
   }
   return false;
 }
@@ -111,6 +174,14 @@ int8_t MKServo::attach(const pin_t inPin, const int inMin, const int inMax) {
   min  = (MIN_PULSE_WIDTH - inMin) / 4; //resolution of min/max is 4 µs
   max  = (MAX_PULSE_WIDTH - inMax) / 4;
 
+  #if ENABLED(SERVO_HARDWARE_PWM)
+    if (pwm_attach(index, servo_info[index].Pin.nbr)) {
+      servo_info[index].Pin.isActive = true;
+      pwm_write(index, servo_info[index].ticks);
+      return index;
+    }
+  #endif
+
   // initialize the timer if it has not already been initialized
   if (isTimerActive() == false) TimerServoInit();
   servo_info[index].Pin.isActive = true;  // this must be set after the check for isTimerActive
@@ -119,6 +190,9 @@ int8_t MKServo::attach(const pin_t inPin, const int inMin, const int inMax) {
 }
 
 void MKServo::detach() {
+  #if ENABLED(SERVO_HARDWARE_PWM)
+    if (IS_PWM_SERVO(index)) pwm_write(index, 0);   // No pulses
+  #endif
   servo_info[index].Pin.isActive = false;
   if (isTimerActive() == false) TimerServo.pause();
 }
@@ -137,6 +211,9 @@ void MKServo::writeMicroseconds(int value) {
   if ((channel < MAX_SERVOS)) { // ensure channel is valid
     LIMIT(value, SERVO_MIN(), SERVO_MAX());
     servo_info[channel].ticks = value;
+    #if ENABLED(SERVO_HARDWARE_PWM)
+      if (IS_PWM_SERVO(channel) && servo_info[channel].Pin.isActive) pwm_write(channel, value);
+    #endif
   }
 }
 
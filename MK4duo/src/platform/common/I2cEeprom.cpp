@@ -32,10 +32,17 @@
 #include "../platform.h"
 #include <Wire.h>
 
+#ifndef EEPROM_PAGE_SIZE
+  #define EEPROM_PAGE_SIZE 32     // The page of the 24C32/24C64, the bigger chips have 64 or 128
+#endif
+
 #ifndef EEPROM_DELAY
-  #define EEPROM_DELAY 5
+  #define EEPROM_DELAY 5          // Write cycle time, the acknowledge polling gives up after twice
 #endif
 
+// The Wire buffer is of 32 bytes, 2 are for the address
+#define EEPROM_CHUNK_SIZE (EEPROM_PAGE_SIZE < 30 ? EEPROM_PAGE_SIZE : 30)
+
 static uint8_t eeprom_device_address = 0x50;
 
 static void eeprom_init() {
@@ -46,77 +53,103 @@ static void eeprom_init() {
   }
 }
 
-void eeprom_write_byte(uint8_t* pos, uint8_t value) {
-  unsigned eeprom_address = (unsigned) pos;
-
+static void eeprom_begin(const unsigned eeprom_address) {
   eeprom_init();
-
   WIRE.beginTransmission(eeprom_device_address);
   WIRE.write((int)(eeprom_address >> 8));   // MSB
   WIRE.write((int)(eeprom_address & 0xFF)); // LSB
-  WIRE.write(value);
-  WIRE.endTransmission();
-
-  // wait for write cycle to complete
-  // this could be done more efficiently with "acknowledge polling"
-  HAL::delayMilliseconds(EEPROM_DELAY);
 }
 
-// WARNING: address is a page address, 6-bit end will wrap around
-// also, data can be maximum of about 30 bytes, because the Wire library has a buffer of 32 bytes
-void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
-
-  eeprom_init();
+/**
+ * Acknowledge polling: the chip does not answer its address while
+ * it writes, so the wait is only of the real write cycle.
+ */
+static bool eeprom_wait_ready() {
+  const millis_l timeout_ms = millis() + 2 * (EEPROM_DELAY);
+  for (;;) {
+    WIRE.beginTransmission(eeprom_device_address);
+    if (WIRE.endTransmission() == 0) return true;
+    if (ELAPSED(millis(), timeout_ms)) return false;
+  }
+}
 
-  WIRE.beginTransmission(eeprom_device_address);
-  WIRE.write((int)((unsigned)eeprom_address >> 8));   // MSB
-  WIRE.write((int)((unsigned)eeprom_address & 0xFF)); // LSB
+// A write must be in a single page, with at most EEPROM_CHUNK_SIZE bytes
+static bool eeprom_write_chunk(const unsigned eeprom_address, const uint8_t *data, const uint8_t n) {
+  eeprom_begin(eeprom_address);
+  WIRE.write(data, n);
   WIRE.endTransmission();
+  return eeprom_wait_ready();
+}
 
-  uint8_t *ptr = (uint8_t*)pos;
-  uint8_t flag = 0;
+static void eeprom_read_chunk(const unsigned eeprom_address, uint8_t *data, const uint8_t n) {
+  eeprom_begin(eeprom_address);
+  WIRE.endTransmission();
   WIRE.requestFrom(eeprom_device_address, (byte)n);
-  for (byte c = 0; c < n && WIRE.available(); c++)
-    flag |= WIRE.read() ^ ptr[c];
+  for (byte c = 0; c < n; c++)
+    data[c] = WIRE.available() ? WIRE.read() : 0xFF;
+}
 
-  if (flag) {
-    WIRE.beginTransmission(eeprom_device_address);
-    WIRE.write((int)((unsigned)eeprom_address >> 8));   // MSB
-    WIRE.write((int)((unsigned)eeprom_address & 0xFF)); // LSB
-    WIRE.write((uint8_t*)(pos), n);
-    WIRE.endTransmission();
-
-    // wait for write cycle to complete
-    // this could be done more efficiently with "acknowledge polling"
-    HAL::delayMilliseconds(EEPROM_DELAY);
+// Length of the next chunk from an address, not past the end and the page
+static uint8_t eeprom_chunk_len(const unsigned eeprom_address, const size_t n) {
+  const unsigned page_left = EEPROM_PAGE_SIZE - (eeprom_address & (EEPROM_PAGE_SIZE - 1));
+  size_t len = MIN(n, page_left);
+  return MIN(len, size_t(EEPROM_CHUNK_SIZE));
+}
+
+static void eeprom_read_burst(const unsigned eeprom_address, uint8_t *data, size_t n) {
+  for (unsigned addr = eeprom_address; n;) {
+    const uint8_t len = eeprom_chunk_len(addr, n);
+    eeprom_read_chunk(addr, data, len);
+    addr += len; data += len; n -= len;
   }
 }
 
-uint8_t eeprom_read_byte(uint8_t* pos) {
-  byte data = 0xFF;
-  unsigned eeprom_address = (unsigned) pos;
+static bool eeprom_write_burst(const unsigned eeprom_address, const uint8_t *data, size_t n) {
+  bool ok = true;
+  for (unsigned addr = eeprom_address; n;) {
+    const uint8_t len = eeprom_chunk_len(addr, n);
+    if (!eeprom_write_chunk(addr, data, len)) ok = false;
+    addr += len; data += len; n -= len;
+  }
+  return ok;
+}
 
-  eeprom_init ();
+static EepromPageCache<EEPROM_PAGE_SIZE, eeprom_read_burst, eeprom_write_burst> page_cache;
 
-  WIRE.beginTransmission(eeprom_device_address);
-  WIRE.write((int)(eeprom_address >> 8));   // MSB
-  WIRE.write((int)(eeprom_address & 0xFF)); // LSB
-  WIRE.endTransmission();
-  WIRE.requestFrom(eeprom_device_address, (byte)1);
-  return WIRE.available() ? WIRE.read() : 0xFF;
+bool eeprom_page_write(const int pos, const uint8_t value) { return page_cache.write(pos, value); }
+uint8_t eeprom_page_read(const int pos) { return page_cache.read(pos); }
+bool eeprom_page_flush() { return page_cache.flush(); }
+
+/**
+ * The byte and block access, with the cache written first
+ */
+void eeprom_write_byte(uint8_t* pos, uint8_t value) {
+  eeprom_page_flush();
+  eeprom_write_chunk((uintptr_t)pos, &value, 1);
 }
 
-// maybe let's not read more than 30 or 32 bytes at a time!
-void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
-  eeprom_init();
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
+  eeprom_page_flush();
+  const uint8_t *ptr = (const uint8_t*)pos;
+  uint8_t check[EEPROM_CHUNK_SIZE];
+  for (unsigned addr = (uintptr_t)eeprom_address; n;) {
+    const uint8_t len = eeprom_chunk_len(addr, n);
+    eeprom_read_chunk(addr, check, len);
+    if (memcmp(check, ptr, len)) eeprom_write_chunk(addr, ptr, len);
+    addr += len; ptr += len; n -= len;
+  }
+}
 
-  WIRE.beginTransmission(eeprom_device_address);
-  WIRE.write((int)((unsigned)eeprom_address >> 8));   // MSB
-  WIRE.write((int)((unsigned)eeprom_address & 0xFF)); // LSB
-  WIRE.endTransmission();
-  WIRE.requestFrom(eeprom_device_address, (byte)n);
-  for (byte c = 0; c < n; c++ )
-    if (WIRE.available()) *((uint8_t*)pos + c) = WIRE.read();
+uint8_t eeprom_read_byte(uint8_t* pos) {
+  uint8_t data;
+  eeprom_page_flush();
+  eeprom_read_chunk((uintptr_t)pos, &data, 1);
+  return data;
+}
+
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
+  eeprom_page_flush();
+  eeprom_read_burst((uintptr_t)eeprom_address, (uint8_t*)pos, n);
 }
 
 #endif // HAS_EEPROM_I2C
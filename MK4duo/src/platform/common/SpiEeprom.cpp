@@ -31,88 +31,110 @@
 
 #include "../platform.h"
 
-#define CMD_WREN  6   // WREN
-#define CMD_READ  3   // WRITE
-#define CMD_WRITE 2   // WRITE
-
-uint8_t eeprom_read_byte(uint8_t* pos) {
-  uint8_t v;
-  uint8_t eeprom_temp[3];
-
-  // set read location
-  // begin transmission from device
-  eeprom_temp[0] = CMD_READ;
-  eeprom_temp[1] = ((unsigned)pos >> 8) & 0xFF; // addr High
-  eeprom_temp[2] = (unsigned)pos & 0xFF;        // addr Low
+#define CMD_WREN  6   // Write enable
+#define CMD_RDSR  5   // Read status register
+#define CMD_READ  3   // Read
+#define CMD_WRITE 2   // Write
+
+#define SR_WIP    1   // Status: write in progress
+
+#ifndef EEPROM_PAGE_SIZE
+  #define EEPROM_PAGE_SIZE 32     // The page of the 25LC640, the bigger chips have 64 or 128
+#endif
+
+static void eeprom_command(const uint8_t cmd, const unsigned eeprom_address) {
+  const uint8_t eeprom_temp[3] = {
+    cmd,
+    uint8_t((eeprom_address >> 8) & 0xFF),  // addr High
+    uint8_t(eeprom_address & 0xFF)          // addr Low
+  };
   HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
   HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
   HAL::spiSend(SPI_CHAN_EEPROM1, eeprom_temp, 3);
+}
 
-  v = HAL::spiReceive(SPI_CHAN_EEPROM1);
+static void eeprom_write_enable() {
+  const uint8_t cmd = CMD_WREN;
+  HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
+  HAL::spiSend(SPI_CHAN_EEPROM1, &cmd, 1);
   HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
-  return v;
 }
 
-void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
-  uint8_t eeprom_temp[3];
-  uint8_t *p_pos = (uint8_t *)pos;
-
-  // set read location
-  // begin transmission from device
-  eeprom_temp[0] = CMD_READ;
-  eeprom_temp[1] = ((unsigned)eeprom_address >> 8) & 0xFF;  // addr High
-  eeprom_temp[2] = (unsigned)eeprom_address & 0xFF;         // addr Low
-  HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
-  HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
-  HAL::spiSend(SPI_CHAN_EEPROM1, eeprom_temp, 3);
+/**
+ * The EEPROM holds WIP in the status register while it writes the page,
+ * the FRAM writes at the speed of the bus.
+ */
+static bool eeprom_wait_ready() {
+  #if ENABLED(EEPROM_SPI_FRAM)
+    return true;
+  #else
+    const millis_l timeout_ms = millis() + 10;
+    for (;;) {
+      const uint8_t cmd = CMD_RDSR;
+      HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
+      HAL::spiSend(SPI_CHAN_EEPROM1, &cmd, 1);
+      const uint8_t status = HAL::spiReceive(SPI_CHAN_EEPROM1);
+      HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
+      if (!(status & SR_WIP)) return true;
+      if (ELAPSED(millis(), timeout_ms)) return false;
+    }
+  #endif
+}
 
-  while (n--)
-    *p_pos++ = HAL::spiReceive(SPI_CHAN_EEPROM1);
+static void eeprom_read_burst(const unsigned eeprom_address, uint8_t *data, size_t n) {
+  eeprom_command(CMD_READ, eeprom_address);
+  while (n--) *data++ = HAL::spiReceive(SPI_CHAN_EEPROM1);
   HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
 }
 
-void eeprom_write_byte(uint8_t* pos, uint8_t value) {
-  uint8_t eeprom_temp[3];
+// A write of the EEPROM never goes out of a page, the FRAM has no pages
+static bool eeprom_write_burst(const unsigned eeprom_address, const uint8_t *data, size_t n) {
+  bool ok = true;
+  for (unsigned addr = eeprom_address; n;) {
+    #if ENABLED(EEPROM_SPI_FRAM)
+      const size_t len = n;
+    #else
+      const size_t len = MIN(n, size_t(EEPROM_PAGE_SIZE - (addr & (EEPROM_PAGE_SIZE - 1))));
+    #endif
+    eeprom_write_enable();
+    eeprom_command(CMD_WRITE, addr);
+    HAL::spiSend(SPI_CHAN_EEPROM1, data, len);
+    HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
+    if (!eeprom_wait_ready()) ok = false;
+    addr += len; data += len; n -= len;
+  }
+  return ok;
+}
 
-  /*write enable*/
-  eeprom_temp[0] = CMD_WREN;
-  HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
-  HAL::spiSend(SPI_CHAN_EEPROM1, eeprom_temp, 1);
-  HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
-  HAL::delayMilliseconds(1);
+static EepromPageCache<EEPROM_PAGE_SIZE, eeprom_read_burst, eeprom_write_burst> page_cache;
 
-  /*write addr*/
-  eeprom_temp[0] = CMD_WRITE;
-  eeprom_temp[1] = ((unsigned)pos>>8) & 0xFF;  //addr High
-  eeprom_temp[2] = (unsigned)pos & 0xFF;       //addr Low
-  HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
-  HAL::spiSend(SPI_CHAN_EEPROM1, eeprom_temp, 3);
+bool eeprom_page_write(const int pos, const uint8_t value) { return page_cache.write(pos, value); }
+uint8_t eeprom_page_read(const int pos) { return page_cache.read(pos); }
+bool eeprom_page_flush() { return page_cache.flush(); }
 
-  HAL::spiSend(SPI_CHAN_EEPROM1, value);
-  HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
-  HAL::delayMilliseconds(7);  // wait for page write to complete
+/**
+ * The byte and block access, with the cache written first
+ */
+uint8_t eeprom_read_byte(uint8_t* pos) {
+  uint8_t v;
+  eeprom_page_flush();
+  eeprom_read_burst((uintptr_t)pos, &v, 1);
+  return v;
 }
 
-void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
-  uint8_t eeprom_temp[3];
-
-  /*write enable*/
-  eeprom_temp[0] = CMD_WREN;
-  HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
-  HAL::spiSend(SPI_CHAN_EEPROM1, eeprom_temp, 1);
-  HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
-  HAL::delayMilliseconds(1);
+void eeprom_read_block(void* pos, const void* eeprom_address, size_t n) {
+  eeprom_page_flush();
+  eeprom_read_burst((uintptr_t)eeprom_address, (uint8_t*)pos, n);
+}
 
-  /*write addr*/
-  eeprom_temp[0] = CMD_WRITE;
-  eeprom_temp[1] = ((unsigned)eeprom_address >> 8) & 0xFF;  // addr High
-  eeprom_temp[2] = (unsigned)eeprom_address & 0xFF;         // addr Low
-  HAL::digitalWrite(SPI_EEPROM1_CS, LOW);
-  HAL::spiSend(SPI_CHAN_EEPROM1, eeprom_temp, 3);
+void eeprom_write_byte(uint8_t* pos, uint8_t value) {
+  eeprom_page_flush();
+  eeprom_write_burst((uintptr_t)pos, &value, 1);
+}
 
-  HAL::spiSend(SPI_CHAN_EEPROM1, (const uint8_t*)pos, n);
-  HAL::digitalWrite(SPI_EEPROM1_CS, HIGH);
-  HAL::delayMilliseconds(7);  // wait for page write to complete
+void eeprom_update_block(const void* pos, void* eeprom_address, size_t n) {
+  eeprom_page_flush();
+  eeprom_write_burst((uintptr_t)eeprom_address, (const uint8_t*)pos, n);
 }
 
 #endif // HAS_EEPROM_SPI
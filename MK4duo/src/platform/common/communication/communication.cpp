@@ -86,6 +86,33 @@ int Com::serialRead(const uint8_t index) {
   }
 }
 
+/**
+ * Read up to size bytes without waiting, return the number of bytes read.
+ * On SAMD the core moves whole USB packets in readBytes(), elsewhere
+ * the ring buffer of the port is drained with read().
+ */
+template <typename S>
+static int serial_read_bytes(S &port, char * buffer, int size) {
+  #if ENABLED(ARDUINO_ARCH_SAMD)
+    NOMORE(size, port.available());
+    return size > 0 ? port.readBytes(buffer, size) : 0;
+  #else
+    int count = 0, c;
+    while (count < size && (c = port.read()) >= 0) buffer[count++] = c;
+    return count;
+  #endif
+}
+
+int Com::serialReadBytes(const uint8_t index, char * buffer, const int size) {
+  switch (index) {
+    case 0: return serial_read_bytes(MKSERIAL1, buffer, size);
+    #if NUM_SERIAL > 1
+      case 1: return serial_read_bytes(MKSERIAL2, buffer, size);
+    #endif
+    default: return 0;
+  }
+}
+
 bool Com::serialDataAvailable() {
   return false
     || MKSERIAL1.available()
@@ -105,6 +132,16 @@ bool Com::serialDataAvailable(const uint8_t index) {
   }
 }
 
+int Com::serialAvailableForWrite(const uint8_t index) {
+  switch (index) {
+    case 0: return MKSERIAL1.availableForWrite();
+    #if NUM_SERIAL > 1
+      case 1: return MKSERIAL2.availableForWrite();
+    #endif
+    default: return 0;
+  }
+}
+
 // Functions for serial printing from PROGMEM. (Saves loads of SRAM.)
 void Com::printPGM(PGM_P str) {
   while (char c = pgm_read_byte(str++)) {
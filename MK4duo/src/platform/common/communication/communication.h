@@ -62,10 +62,13 @@ class Com {
     static void serialFlush();
 
     static int serialRead(const uint8_t index);
+    static int serialReadBytes(const uint8_t index, char * buffer, const int size);
 
     static bool serialDataAvailable();
     static bool serialDataAvailable(const uint8_t index);
 
+    static int serialAvailableForWrite(const uint8_t index);
+
     // Functions for serial printing from PROGMEM. (Saves loads of SRAM.)
     static void printPGM(PGM_P);
 
@@ -83,7 +86,7 @@ class Com {
 };
 
 // MACRO FOR SERIAL
-#if ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 >= -1
+#if ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 >= -1 && DISABLED(NET_BRIDGE)  // With NET_BRIDGE the port talks in frames
   #define NUM_SERIAL 2
 #else
   #define NUM_SERIAL 1
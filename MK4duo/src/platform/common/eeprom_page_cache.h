@@ -0,0 +1,106 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * eeprom_page_cache.h
+ *
+ * Page cache of the external EEPROM for the settings store.
+ * A page is read once, the changed bytes of a page are written at once,
+ * as a single span, and read back to check, when the page is left or at
+ * the flush. The unchanged pages are never written.
+ *
+ * READ and WRITE are the transfers of the chip, a WRITE is never out of a page
+ * and returns false on a timeout of the write cycle.
+ */
+
+typedef void (*eeprom_read_t)(const unsigned eeprom_address, uint8_t *data, size_t n);
+typedef bool (*eeprom_write_t)(const unsigned eeprom_address, const uint8_t *data, size_t n);
+
+template<uint8_t PAGE_SIZE, eeprom_read_t READ, eeprom_write_t WRITE>
+class EepromPageCache {
+
+  static_assert(PAGE_SIZE && !(PAGE_SIZE & (PAGE_SIZE - 1)), "EEPROM_PAGE_SIZE must be a power of 2.");
+
+  public: /** Constructor */
+
+    EepromPageCache() : page_address(-1), dirty_first(PAGE_SIZE), dirty_last(0) {}
+
+  private: /** Private Parameters */
+
+    uint8_t data[PAGE_SIZE];
+    int     page_address;                 // Address of the cached page, -1 for none
+    uint8_t dirty_first, dirty_last;      // Span of the changed bytes
+
+  public: /** Public Function */
+
+    // Write the changed bytes, true on error. The cache is emptied.
+    bool flush() {
+      bool error = false;
+      if (page_address >= 0 && dirty_first <= dirty_last) {
+        const unsigned address = page_address + dirty_first;
+        const uint8_t n = dirty_last - dirty_first + 1;
+        if (!WRITE(address, &data[dirty_first], n)) error = true;
+        uint8_t check[PAGE_SIZE];
+        READ(address, check, n);
+        if (memcmp(check, &data[dirty_first], n)) error = true;
+      }
+      page_address = -1;
+      dirty_first = PAGE_SIZE;
+      dirty_last = 0;
+      return error;
+    }
+
+    // True on an error writing the page left
+    bool write(const int pos, const uint8_t value) {
+      const bool error = load(pos);
+      const uint8_t i = pos & (PAGE_SIZE - 1);
+      if (data[i] != value) {
+        data[i] = value;
+        NOMORE(dirty_first, i);
+        NOLESS(dirty_last, i);
+      }
+      return error;
+    }
+
+    uint8_t read(const int pos) {
+      load(pos);
+      return data[pos & (PAGE_SIZE - 1)];
+    }
+
+  private: /** Private Function */
+
+    bool load(const int pos) {
+      const int address = pos & ~(PAGE_SIZE - 1);
+      if (address == page_address) return false;
+      const bool error = flush();
+      READ(address, data, PAGE_SIZE);
+      page_address = address;
+      return error;
+    }
+
+};
+
+// The cache of the board EEPROM, the functions return true on a write error
+bool eeprom_page_write(const int pos, const uint8_t value);
+uint8_t eeprom_page_read(const int pos);
+bool eeprom_page_flush();
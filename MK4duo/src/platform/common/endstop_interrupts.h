@@ -24,14 +24,102 @@
 #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
 
 // One ISR for all Endstop Interrupts
-void endstop_ISR() { endstops.update(); }
+#if ENABLED(ENDSTOP_TRIGGER_CAPTURE)
+  void endstop_ISR() {
+    stepper.capture_edge();
+    endstops.update();
+    stepper.capture_release();
+  }
+#else
+  void endstop_ISR() { endstops.update(); }
+#endif
+
+// The group of the endstop pins to attach, the same for all the HALs
+constexpr pin_t endstop_interrupt_pins[] = {
+  #if HAS_X_MIN
+    X_MIN_PIN,
+  #endif
+  #if HAS_X_MAX
+    X_MAX_PIN,
+  #endif
+  #if HAS_X2_MIN
+    X2_MIN_PIN,
+  #endif
+  #if HAS_X2_MAX
+    X2_MAX_PIN,
+  #endif
+  #if HAS_Y_MIN
+    Y_MIN_PIN,
+  #endif
+  #if HAS_Y_MAX
+    Y_MAX_PIN,
+  #endif
+  #if HAS_Y2_MIN
+    Y2_MIN_PIN,
+  #endif
+  #if HAS_Y2_MAX
+    Y2_MAX_PIN,
+  #endif
+  #if HAS_Z_MIN
+    Z_MIN_PIN,
+  #endif
+  #if HAS_Z_MAX
+    Z_MAX_PIN,
+  #endif
+  #if HAS_Z2_MIN
+    Z2_MIN_PIN,
+  #endif
+  #if HAS_Z2_MAX
+    Z2_MAX_PIN,
+  #endif
+  #if HAS_Z3_MIN
+    Z3_MIN_PIN,
+  #endif
+  #if HAS_Z3_MAX
+    Z3_MAX_PIN,
+  #endif
+  #if HAS_Z_PROBE_PIN
+    Z_PROBE_PIN,
+  #endif
+  NoPin
+};
+
+/**
+ * Check the interrupt line of each pin of the group, given by the HAL (-1 for none).
+ * A pin without a line, or two pins on the same line, where only one of them
+ * can raise the interrupt, can't be attached: the endstops are then polled.
+ */
+template<typename LineFunc>
+bool endstop_group_lines_free(LineFunc line_of) {
+  uint32_t used = 0;
+  for (const pin_t pin : endstop_interrupt_pins) {
+    if (pin == NoPin) break;
+    const int8_t line = line_of(pin);
+    if (!WITHIN(line, 0, 31) || TEST32(used, line)) return false;
+    SBI32(used, line);
+  }
+  return true;
+}
+
+// Attach endstop_ISR to all the pins of the group
+template<typename AttachFunc>
+void endstop_group_attach(AttachFunc attach) {
+  for (const pin_t pin : endstop_interrupt_pins) {
+    if (pin == NoPin) break;
+    attach(pin);
+  }
+}
 
 #if ENABLED(__AVR__)
   #include "../HAL_AVR/endstop_interrupts.h"
 #elif ENABLED(ARDUINO_ARCH_SAM)
   #include "../HAL_DUE/endstop_interrupts.h"
+#elif ENABLED(ARDUINO_ARCH_SAMD)
+  #include "../HAL_SAMD/endstop_interrupts.h"
 #elif ENABLED(ARDUINO_ARCH_STM32)
   #include "../HAL_STM32/endstop_interrupts.h"
+#elif ENABLED(ARDUINO_ARCH_NATIVE)
+  #include "../HAL_NATIVE/endstop_interrupts.h"
 #else
   #error "Unsupported Platform!"
 #endif
@@ -45,6 +45,7 @@ class Host_Action {
     static void resumed()                   { print_action(PSTR("resumed")); }
     static void cancel()                    { print_action(PSTR("cancel")); }
     static void power_off()                 { print_action(PSTR("poweroff")); }
+    static void expose(const bool on)       { print_action(on ? PSTR("expose on") : PSTR("expose off")); }
 
     static void filrunout(const uint8_t t);
 
@@ -27,6 +27,10 @@
   #define EEPROM_SIZE 4096
 #endif
 
+#if HAS_EEPROM_PAGED
+  #include "eeprom_page_cache.h"
+#endif
+
 class MemoryStore {
 
   public: /** Constructor */
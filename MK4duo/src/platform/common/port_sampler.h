@@ -0,0 +1,94 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * port_sampler.h
+ *
+ * Groups a set of input pins by GPIO port when they are added, then
+ * samples each port with a single register read and builds a bit field
+ * of the pin states with the masks of the pins of that port.
+ *
+ * The pins of a group are kept contiguous, so sample() costs one read
+ * for each port plus a test for each pin.
+ */
+
+template<uint8_t PINS>
+class PortSampler {
+
+  private: /** Private Parameters */
+
+    port_input_t  port[PINS];       // Input register of each group
+    uint8_t       group_end[PINS];  // First pin after each group
+    port_mask_t   pin_mask[PINS];   // Pins sorted by group
+    uint8_t       pin_bit[PINS];
+    uint8_t       groups, pins;
+    uint16_t      bits;             // All the bits set by sample()
+
+  public: /** Public Function */
+
+    void reset() { groups = pins = 0; bits = 0; }
+
+    /**
+     * Add a pin, its state goes in the bit of the sampled field
+     */
+    void add(const port_input_t reg, const port_mask_t mask, const uint8_t bit) {
+      if (pins >= PINS || TEST(bits, bit)) return;
+
+      uint8_t g = 0;
+      while (g < groups && port[g] != reg) g++;
+      if (g == groups) {
+        port[g] = reg;
+        group_end[g] = pins;
+        groups++;
+      }
+
+      // Make room at the end of the group
+      const uint8_t pos = group_end[g];
+      for (uint8_t p = pins; p > pos; p--) {
+        pin_mask[p] = pin_mask[p - 1];
+        pin_bit[p] = pin_bit[p - 1];
+      }
+      pin_mask[pos] = mask;
+      pin_bit[pos] = bit;
+      for (uint8_t i = g; i < groups; i++) group_end[i]++;
+      pins++;
+      SBI(bits, bit);
+    }
+
+    uint16_t used() const { return bits; }
+
+    /**
+     * One read for each port, a bit set for each pin high
+     */
+    uint16_t sample() const {
+      uint16_t state = 0;
+      uint8_t p = 0;
+      for (uint8_t g = 0; g < groups; g++) {
+        const port_mask_t value = *port[g];
+        for (; p < group_end[g]; p++)
+          if (value & pin_mask[p]) SBI(state, pin_bit[p]);
+      }
+      return state;
+    }
+
+};
@@ -73,6 +73,11 @@ constexpr bool
     #if ENABLED(SERIAL_STATS_MAX_RX_QUEUED)
       || true
     #endif
+  ),
+  bSERIAL_RX_DMA = (false
+    #if ENABLED(SERIAL_RX_DMA)
+      || true
+    #endif
   );
 
 template <uint8_t serial>
@@ -86,6 +91,7 @@ struct MK4duoSerialHostCfg {
   static constexpr bool RX_OVERRUNS       = bSERIAL_STATS_RX_BUFFER_OVERRUNS;
   static constexpr bool RX_FRAMING_ERRORS = bSERIAL_STATS_RX_FRAMING_ERRORS;
   static constexpr bool MAX_RX_QUEUED     = bSERIAL_STATS_MAX_RX_QUEUED;
+  static constexpr bool RX_DMA            = bSERIAL_RX_DMA;
 };
 
 template <uint8_t serial>
@@ -99,4 +105,5 @@ struct MK4duoSerialCfg {
   static constexpr bool RX_OVERRUNS       = false;
   static constexpr bool RX_FRAMING_ERRORS = false;
   static constexpr bool MAX_RX_QUEUED     = false;
+  static constexpr bool RX_DMA            = false;
 };
@@ -78,6 +78,12 @@
 #elif ENABLED(ARDUINO_ARCH_STM32)
   #define SHARED_SERVOS false
   #include "../../HAL_STM32/servotimers.h"
+#elif ENABLED(ARDUINO_ARCH_SAMD)
+  #define SHARED_SERVOS false
+  #include "../../HAL_SAMD/servotimers.h"
+#elif ENABLED(ARDUINO_ARCH_NATIVE)
+  #define SHARED_SERVOS false
+  #include "../../HAL_NATIVE/servotimers.h"
 #else
   #error "Unsupported Platform!"
 #endif
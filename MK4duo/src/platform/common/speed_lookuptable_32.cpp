@@ -0,0 +1,45 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * speed_lookuptable_32.cpp
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(CPU_32_BIT)
+
+#define _LUT1(I)    speed_lut_interval(I)
+#define _LUT4(I)    _LUT1(I), _LUT1((I) + 1), _LUT1((I) + 2), _LUT1((I) + 3)
+#define _LUT16(I)   _LUT4(I), _LUT4((I) + 4), _LUT4((I) + 8), _LUT4((I) + 12)
+#define _LUT64(I)   _LUT16(I), _LUT16((I) + 16), _LUT16((I) + 32), _LUT16((I) + 48)
+#define _LUT256(I)  _LUT64(I), _LUT64((I) + 64), _LUT64((I) + 128), _LUT64((I) + 192)
+
+static_assert(SPEED_LUT_SIZE == 513, "speed_lookuptable_32 initializer assumes 16 octaves of 32 segments.");
+
+const uint32_t speed_lookuptable_32[SPEED_LUT_SIZE] = {
+  _LUT256(0), _LUT256(256), _LUT1(512)
+};
+
+#endif // ENABLED(CPU_32_BIT)
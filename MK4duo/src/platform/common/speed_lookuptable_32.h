@@ -0,0 +1,77 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * speed_lookuptable_32.h
+ *
+ * Step rate to timer interval lookup for 32 bit platforms.
+ *
+ * The table is generated by the compiler from STEPPER_TIMER_RATE.
+ * Every octave of step rate, from 2^SPEED_LUT_MIN_SHIFT up, is split in
+ * SPEED_LUT_SEGMENTS segments and the interval is linearly interpolated
+ * between the segment ends. Max error is about 0.02%, always on the slow side.
+ *
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(CPU_32_BIT)
+
+#define SPEED_LUT_SEGMENTS_SHIFT  5
+#define SPEED_LUT_SEGMENTS        _BV(SPEED_LUT_SEGMENTS_SHIFT)
+#define SPEED_LUT_MIN_SHIFT       SPEED_LUT_SEGMENTS_SHIFT
+#define SPEED_LUT_OCTAVES         16
+#define SPEED_LUT_SIZE            ((SPEED_LUT_OCTAVES) * (SPEED_LUT_SEGMENTS) + 1)
+#define SPEED_LUT_MIN_RATE        _BV(SPEED_LUT_MIN_SHIFT)
+#define SPEED_LUT_MAX_RATE        (uint32_t(SPEED_LUT_SEGMENTS) << (SPEED_LUT_OCTAVES))
+
+// Step rate at the start of the table entry
+constexpr uint32_t speed_lut_rate(const uint32_t i) {
+  return (uint32_t(SPEED_LUT_SEGMENTS) + (i & (SPEED_LUT_SEGMENTS - 1))) << (i >> SPEED_LUT_SEGMENTS_SHIFT);
+}
+
+// Timer interval at the start of the table entry
+constexpr uint32_t speed_lut_interval(const uint32_t i) {
+  return uint32_t(STEPPER_TIMER_RATE) / speed_lut_rate(i);
+}
+
+extern const uint32_t speed_lookuptable_32[SPEED_LUT_SIZE];
+
+/**
+ * Timer interval for the step rate, without a divide.
+ * Out of table rates fall back to the division.
+ */
+FORCE_INLINE static uint32_t speed_lookup_32(const uint32_t step_rate) {
+  if (step_rate < SPEED_LUT_MIN_RATE || step_rate >= SPEED_LUT_MAX_RATE)
+    return uint32_t(STEPPER_TIMER_RATE) / step_rate;
+
+  // Octave of the step rate, its segment and the position inside the segment
+  const uint8_t   octave  = (31 - __builtin_clz(step_rate)) - SPEED_LUT_MIN_SHIFT;
+  const uint32_t  idx     = (uint32_t(octave) << SPEED_LUT_SEGMENTS_SHIFT) + ((step_rate >> octave) & (SPEED_LUT_SEGMENTS - 1)),
+                  frac    = step_rate & (_BV(octave) - 1),
+                  base    = speed_lookuptable_32[idx],
+                  gain    = base - speed_lookuptable_32[idx + 1];
+
+  return base - ((gain * frac) >> octave);
+}
+
+#endif // ENABLED(CPU_32_BIT)
@@ -29,6 +29,7 @@
  *    ARDUINO_ARCH_SAM  : For Arduino Due and other boards based on Atmel SAM3X8E
  *    ARDUINO_ARCH_SAMD : For Arduino Due and other boards based on Atmel SAMD21J18
  *    STM32             : For Arduino STM32 and otherboards based on STM32xx ARM-Cortex M3
+ *    ARDUINO_ARCH_NATIVE : For the host build of the benchmarks (buildroot/bin/build_native)
  *
  */
 
@@ -58,6 +59,17 @@
   #define MK_MAIN_LOOP false
   #include "HAL_STM32/spi_pins.h"
   #include "HAL_STM32/HAL.h"
+#elif ENABLED(ARDUINO_ARCH_NATIVE)
+  #define CPU_32_BIT
+  #define MK_MAIN_LOOP false
+  #include "HAL_NATIVE/spi_pins.h"
+  #include "HAL_NATIVE/HAL.h"
 #else
   #error "Unsupported Platform!"
 #endif
+
+#if ENABLED(CPU_32_BIT)
+  #include "common/speed_lookuptable_32.h"
+#endif
+
+#include "common/port_sampler.h"
@@ -0,0 +1,531 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * SdioSAM3X.cpp
+ *
+ * SdioCard on the HSMCI of the SAM3X, 4 bit bus, polled transfers.
+ * HSMCI pins: MCCK PA19, MCCDA PA20, MCDA0-3 PA21-PA24 (peripheral A).
+ */
+#include "../../../../MK4duo.h"
+#if ENABLED(SD_SDIO) && (defined(__SAM3X8E__) || defined(__SAM3X8H__))
+#include "SdioCard.h"
+//==============================================================================
+const uint32_t CMD8_RETRIES = 10;
+const uint32_t BUSY_TIMEOUT_MICROS = 500000;
+const uint32_t DATA_TIMEOUT_MICROS = 250000;
+const uint32_t INIT_KHZ = 400;
+
+const uint32_t HSMCI_PINS = PIO_PA19A_MCCK | PIO_PA20A_MCCDA | PIO_PA21A_MCDA0 |
+                            PIO_PA22A_MCDA1 | PIO_PA23A_MCDA2 | PIO_PA24A_MCDA3;
+
+const uint32_t HSMCI_SR_CMD_ERROR = HSMCI_SR_RINDE | HSMCI_SR_RDIRE |
+                                    HSMCI_SR_RCRCE | HSMCI_SR_RENDE |
+                                    HSMCI_SR_RTOE | HSMCI_SR_CSTOE;
+
+const uint32_t HSMCI_SR_DATA_ERROR = HSMCI_SR_DCRCE | HSMCI_SR_DTOE |
+                                     HSMCI_SR_OVRE | HSMCI_SR_UNRE;
+//==============================================================================
+const uint32_t CMD_RESP_NONE = HSMCI_CMDR_RSPTYP_NORESP;
+const uint32_t CMD_RESP_R1   = HSMCI_CMDR_RSPTYP_48_BIT | HSMCI_CMDR_MAXLAT;
+const uint32_t CMD_RESP_R1b  = HSMCI_CMDR_RSPTYP_R1B | HSMCI_CMDR_MAXLAT;
+const uint32_t CMD_RESP_R2   = HSMCI_CMDR_RSPTYP_136_BIT | HSMCI_CMDR_MAXLAT;
+const uint32_t CMD_RESP_R3   = HSMCI_CMDR_RSPTYP_48_BIT | HSMCI_CMDR_OPDCMD;
+const uint32_t CMD_RESP_R6   = CMD_RESP_R1;
+const uint32_t CMD_RESP_R7   = CMD_RESP_R1;
+
+const uint32_t DATA_READ_SINGLE   = HSMCI_CMDR_TRCMD_START_DATA | HSMCI_CMDR_TRDIR_READ |
+                                    HSMCI_CMDR_TRTYP_SINGLE;
+const uint32_t DATA_READ_MULTI    = HSMCI_CMDR_TRCMD_START_DATA | HSMCI_CMDR_TRDIR_READ |
+                                    HSMCI_CMDR_TRTYP_MULTIPLE;
+const uint32_t DATA_WRITE_SINGLE  = HSMCI_CMDR_TRCMD_START_DATA | HSMCI_CMDR_TRDIR_WRITE |
+                                    HSMCI_CMDR_TRTYP_SINGLE;
+const uint32_t DATA_WRITE_MULTI   = HSMCI_CMDR_TRCMD_START_DATA | HSMCI_CMDR_TRDIR_WRITE |
+                                    HSMCI_CMDR_TRTYP_MULTIPLE;
+
+const uint32_t ACMD6_CMDR  = HSMCI_CMDR_CMDNB(ACMD6) | CMD_RESP_R1;
+const uint32_t ACMD41_CMDR = HSMCI_CMDR_CMDNB(ACMD41) | CMD_RESP_R3;
+const uint32_t CMD0_CMDR   = HSMCI_CMDR_CMDNB(CMD0) | CMD_RESP_NONE | HSMCI_CMDR_OPDCMD;
+const uint32_t CMD2_CMDR   = HSMCI_CMDR_CMDNB(CMD2) | CMD_RESP_R2 | HSMCI_CMDR_OPDCMD;
+const uint32_t CMD3_CMDR   = HSMCI_CMDR_CMDNB(CMD3) | CMD_RESP_R6 | HSMCI_CMDR_OPDCMD;
+const uint32_t CMD7_CMDR   = HSMCI_CMDR_CMDNB(CMD7) | CMD_RESP_R1b;
+const uint32_t CMD8_CMDR   = HSMCI_CMDR_CMDNB(CMD8) | CMD_RESP_R7 | HSMCI_CMDR_OPDCMD;
+const uint32_t CMD9_CMDR   = HSMCI_CMDR_CMDNB(CMD9) | CMD_RESP_R2;
+const uint32_t CMD10_CMDR  = HSMCI_CMDR_CMDNB(CMD10) | CMD_RESP_R2;
+const uint32_t CMD12_CMDR  = HSMCI_CMDR_CMDNB(CMD12) | CMD_RESP_R1b |
+                             HSMCI_CMDR_TRCMD_STOP_DATA;
+const uint32_t CMD13_CMDR  = HSMCI_CMDR_CMDNB(CMD13) | CMD_RESP_R1;
+const uint32_t CMD17_CMDR  = HSMCI_CMDR_CMDNB(CMD17) | CMD_RESP_R1 | DATA_READ_SINGLE;
+const uint32_t CMD18_CMDR  = HSMCI_CMDR_CMDNB(CMD18) | CMD_RESP_R1 | DATA_READ_MULTI;
+const uint32_t CMD24_CMDR  = HSMCI_CMDR_CMDNB(CMD24) | CMD_RESP_R1 | DATA_WRITE_SINGLE;
+const uint32_t CMD25_CMDR  = HSMCI_CMDR_CMDNB(CMD25) | CMD_RESP_R1 | DATA_WRITE_MULTI;
+const uint32_t CMD32_CMDR  = HSMCI_CMDR_CMDNB(CMD32) | CMD_RESP_R1;
+const uint32_t CMD33_CMDR  = HSMCI_CMDR_CMDNB(CMD33) | CMD_RESP_R1;
+const uint32_t CMD38_CMDR  = HSMCI_CMDR_CMDNB(CMD38) | CMD_RESP_R1b;
+const uint32_t CMD55_CMDR  = HSMCI_CMDR_CMDNB(CMD55) | CMD_RESP_R1;
+//==============================================================================
+static bool m_initDone = false;
+static bool m_version2;
+static bool m_highCapacity;
+static uint8_t m_errorCode = SD_CARD_ERROR_INIT_NOT_CALLED;
+static uint32_t m_errorLine = 0;
+static uint32_t m_rca;
+static uint32_t m_status;
+static uint32_t m_sdClkKhz = 0;
+static uint32_t m_ocr;
+static uint32_t m_blockCount;   // Blocks left of a readStart() or writeStart()
+static cid_t m_cid;
+static csd_t m_csd;
+//==============================================================================
+// Error function and macro.
+#define sdError(code) setSdErrorCode(code, __LINE__)
+inline bool setSdErrorCode(uint8_t code, uint32_t line) {
+  m_errorCode = code;
+  m_errorLine = line;
+  return false;  // setSdErrorCode
+}
+//==============================================================================
+// Static functions.
+static bool waitStatus(uint32_t mask, uint32_t timeout) {
+  uint32_t m = micros();
+  while (!((m_status = HSMCI->HSMCI_SR) & mask)) {
+    if ((micros() - m) > timeout) return false;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+static bool cardCommand(uint32_t cmdr, uint32_t arg) {
+  if (!waitStatus(HSMCI_SR_CMDRDY, BUSY_TIMEOUT_MICROS)) {
+    return false;  // Caller will set errorCode.
+  }
+  HSMCI->HSMCI_ARGR = arg;
+  HSMCI->HSMCI_CMDR = cmdr;
+  if (!waitStatus(HSMCI_SR_CMDRDY, BUSY_TIMEOUT_MICROS)) {
+    return false;
+  }
+  // R3 has no CRC, R1b holds the data lines until the card is ready
+  uint32_t error = HSMCI_SR_CMD_ERROR;
+  if ((cmdr & HSMCI_CMDR_RSPTYP_Msk) == HSMCI_CMDR_RSPTYP_48_BIT && (cmdr & HSMCI_CMDR_OPDCMD)) {
+    error &= ~HSMCI_SR_RCRCE;
+  }
+  if (m_status & error) {
+    return false;
+  }
+  if ((cmdr & HSMCI_CMDR_RSPTYP_Msk) == HSMCI_CMDR_RSPTYP_R1B) {
+    return waitStatus(HSMCI_SR_NOTBUSY, BUSY_TIMEOUT_MICROS);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+static bool cardAcmd(uint32_t rca, uint32_t cmdr, uint32_t arg) {
+  return cardCommand(CMD55_CMDR, rca) && cardCommand(cmdr, arg);
+}
+//------------------------------------------------------------------------------
+static bool isBusyCMD13() {
+  if (!cardCommand(CMD13_CMDR, m_rca)) {
+    // Caller will timeout.
+    return true;
+  }
+  return !(HSMCI->HSMCI_RSPR[0] & CARD_STATUS_READY_FOR_DATA);
+}
+//------------------------------------------------------------------------------
+static bool waitReady() {
+  uint32_t m = micros();
+  while (isBusyCMD13()) {
+    if ((micros() - m) > BUSY_TIMEOUT_MICROS) return false;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+// R2 comes first word first, each word MSB first as the bytes of cid_t and csd_t
+static bool readReg16(uint32_t cmdr, void* data) {
+  uint8_t* d = reinterpret_cast<uint8_t*>(data);
+  if (!cardCommand(cmdr, m_rca)) {
+    return false;  // Caller will set errorCode.
+  }
+  for (uint8_t w = 0; w < 4; w++) {
+    const uint32_t r = HSMCI->HSMCI_RSPR[w];
+    for (uint8_t b = 0; b < 4; b++) d[4*w + b] = r >> (24 - 8*b);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+static void setSdclk(uint32_t kHzMax) {
+  // MCCK = MCK / (2 * (CLKDIV + 1))
+  uint32_t div = (VARIANT_MCK / 1000 + 2 * kHzMax - 1) / (2 * kHzMax);
+  div = div ? div - 1 : 0;
+  if (div > 255) div = 255;
+  m_sdClkKhz = VARIANT_MCK / 1000 / (2 * (div + 1));
+  HSMCI->HSMCI_MR = (HSMCI->HSMCI_MR & ~HSMCI_MR_CLKDIV_Msk) | HSMCI_MR_CLKDIV(div);
+}
+//------------------------------------------------------------------------------
+static void initHSMCI() {
+  PIOA->PIO_PDR = HSMCI_PINS;
+  PIOA->PIO_ABSR &= ~HSMCI_PINS;
+  PIOA->PIO_PUER = HSMCI_PINS & ~PIO_PA19A_MCCK;
+  pmc_enable_periph_clk(ID_HSMCI);
+
+  HSMCI->HSMCI_CR = HSMCI_CR_SWRST;
+  HSMCI->HSMCI_CR = HSMCI_CR_MCIDIS | HSMCI_CR_PWSDIS;
+  HSMCI->HSMCI_IDR = 0xFFFFFFFF;
+  HSMCI->HSMCI_DTOR = HSMCI_DTOR_DTOCYC(0xF) | HSMCI_DTOR_DTOMUL_1048576;
+  HSMCI->HSMCI_CSTOR = HSMCI_CSTOR_CSTOCYC(0xF) | HSMCI_CSTOR_CSTOMUL_1048576;
+  HSMCI->HSMCI_CFG = HSMCI_CFG_FIFOMODE | HSMCI_CFG_FERRCTRL;
+  HSMCI->HSMCI_MR = HSMCI_MR_PWSDIV(7) | HSMCI_MR_RDPROOF | HSMCI_MR_WRPROOF;
+  HSMCI->HSMCI_SDCR = HSMCI_SDCR_SDCSEL_SLOTA | HSMCI_SDCR_SDCBUS_1;
+  setSdclk(INIT_KHZ);
+  HSMCI->HSMCI_CR = HSMCI_CR_MCIEN | HSMCI_CR_PWSDIS;
+
+  // 74 clocks for the card power up
+  HSMCI->HSMCI_ARGR = 0;
+  HSMCI->HSMCI_CMDR = HSMCI_CMDR_SPCMD_INIT | HSMCI_CMDR_OPDCMD;
+  waitStatus(HSMCI_SR_CMDRDY, BUSY_TIMEOUT_MICROS);
+}
+//------------------------------------------------------------------------------
+static bool transferStart(uint32_t cmdr, uint32_t lba, uint32_t count) {
+  if (!waitReady()) {
+    return sdError(SD_CARD_ERROR_CMD13);
+  }
+  HSMCI->HSMCI_BLKR = HSMCI_BLKR_BCNT(count) | HSMCI_BLKR_BLKLEN(512);
+  m_blockCount = count;
+  return cardCommand(cmdr, m_highCapacity ? lba : 512*lba);
+}
+//------------------------------------------------------------------------------
+static bool transferStop() {
+  if (!waitStatus(HSMCI_SR_XFRDONE, DATA_TIMEOUT_MICROS)) {
+    return sdError(SD_CARD_ERROR_STOP_TRAN);
+  }
+  if (!cardCommand(CMD12_CMDR, 0)) {
+    return sdError(SD_CARD_ERROR_CMD12);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+static bool readWords(uint32_t* p32) {
+  for (uint32_t i = 0; i < 512/4; i++) {
+    if (!waitStatus(HSMCI_SR_RXRDY | HSMCI_SR_DATA_ERROR, DATA_TIMEOUT_MICROS)
+      || (m_status & HSMCI_SR_DATA_ERROR)) {
+      return sdError(SD_CARD_ERROR_READ);
+    }
+    p32[i] = HSMCI->HSMCI_RDR;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+static bool writeWords(const uint32_t* p32) {
+  for (uint32_t i = 0; i < 512/4; i++) {
+    if (!waitStatus(HSMCI_SR_TXRDY | HSMCI_SR_DATA_ERROR, DATA_TIMEOUT_MICROS)
+      || (m_status & HSMCI_SR_DATA_ERROR)) {
+      return sdError(SD_CARD_ERROR_WRITE);
+    }
+    HSMCI->HSMCI_TDR = p32[i];
+  }
+  if (!waitStatus(HSMCI_SR_BLKE | HSMCI_SR_DATA_ERROR, DATA_TIMEOUT_MICROS)
+    || (m_status & HSMCI_SR_DATA_ERROR)) {
+    return sdError(SD_CARD_ERROR_WRITE);
+  }
+  return true;
+}
+//==============================================================================
+bool SdioCard::begin() {
+  m_initDone = false;
+  m_errorCode = SD_CARD_ERROR_NONE;
+  m_highCapacity = false;
+  m_version2 = false;
+  m_rca = 0;
+
+  // initialize controller.
+  initHSMCI();
+
+  if (!cardCommand(CMD0_CMDR, 0)) {
+    return sdError(SD_CARD_ERROR_CMD0);
+  }
+  // Try several times for case of reset delay.
+  for (uint32_t i = 0; i < CMD8_RETRIES; i++) {
+    if (cardCommand(CMD8_CMDR, 0X1AA)) {
+      if ((HSMCI->HSMCI_RSPR[0] & 0xFFF) != 0X1AA) {
+        return sdError(SD_CARD_ERROR_CMD8);
+      }
+      m_version2 = true;
+      break;
+    }
+  }
+  const uint32_t arg = m_version2 ? 0X40300000 : 0x00300000;
+  uint32_t m = micros();
+  do {
+    if (!cardAcmd(0, ACMD41_CMDR, arg) ||
+       ((micros() - m) > BUSY_TIMEOUT_MICROS)) {
+      return sdError(SD_CARD_ERROR_ACMD41);
+    }
+  } while ((HSMCI->HSMCI_RSPR[0] & 0x80000000) == 0);
+
+  m_ocr = HSMCI->HSMCI_RSPR[0];
+  if (m_ocr & 0x40000000) {
+    // Is high capacity.
+    m_highCapacity = true;
+  }
+  if (!cardCommand(CMD2_CMDR, 0)) {
+    return sdError(SD_CARD_ERROR_CMD2);
+  }
+  if (!cardCommand(CMD3_CMDR, 0)) {
+    return sdError(SD_CARD_ERROR_CMD3);
+  }
+  m_rca = HSMCI->HSMCI_RSPR[0] & 0xFFFF0000;
+
+  if (!readReg16(CMD9_CMDR, &m_csd)) {
+    return sdError(SD_CARD_ERROR_CMD9);
+  }
+  if (!readReg16(CMD10_CMDR, &m_cid)) {
+    return sdError(SD_CARD_ERROR_CMD10);
+  }
+  if (!cardCommand(CMD7_CMDR, m_rca)) {
+    return sdError(SD_CARD_ERROR_CMD7);
+  }
+  // Set card to bus width four.
+  if (!cardAcmd(m_rca, ACMD6_CMDR, 2)) {
+    return sdError(SD_CARD_ERROR_ACMD6);
+  }
+  // Set HSMCI to bus width four.
+  HSMCI->HSMCI_SDCR = HSMCI_SDCR_SDCSEL_SLOTA | HSMCI_SDCR_SDCBUS_4;
+
+  // Set the HSMCI clock frequency.
+  setSdclk(SD_SDIO_CLOCK);
+
+  m_initDone = true;
+  return true;
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::cardCapacity() {
+  return sdCardCapacity(&m_csd);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::erase(uint32_t firstBlock, uint32_t lastBlock) {
+  // check for single block erase
+  if (!m_csd.v1.erase_blk_en) {
+    // erase size mask
+    uint8_t m = (m_csd.v1.sector_size_high << 1) | m_csd.v1.sector_size_low;
+    if ((firstBlock & m) != 0 || ((lastBlock + 1) & m) != 0) {
+      // error card can't erase specified area
+      return sdError(SD_CARD_ERROR_ERASE_SINGLE_BLOCK);
+    }
+  }
+  if (!m_highCapacity) {
+    firstBlock <<= 9;
+    lastBlock <<= 9;
+  }
+  if (!cardCommand(CMD32_CMDR, firstBlock)) {
+    return sdError(SD_CARD_ERROR_CMD32);
+  }
+  if (!cardCommand(CMD33_CMDR, lastBlock)) {
+     return sdError(SD_CARD_ERROR_CMD33);
+  }
+  if (!cardCommand(CMD38_CMDR, 0)) {
+    return sdError(SD_CARD_ERROR_CMD38);
+  }
+  if (!waitReady()) {
+    return sdError(SD_CARD_ERROR_ERASE_TIMEOUT);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+uint8_t SdioCard::errorCode() {
+  return m_errorCode;
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::errorData() {
+  return m_status;
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::errorLine() {
+  return m_errorLine;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::isBusy() {
+  return m_initDone && isBusyCMD13();
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::kHzSdClk() {
+  return m_sdClkKhz;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readBlock(uint32_t lba, uint8_t* buf) {
+  uint32_t aligned[512/4];
+  uint32_t* ptr = (uint32_t)buf & 3 ? aligned : reinterpret_cast<uint32_t*>(buf);
+
+  if (!transferStart(CMD17_CMDR, lba, 1)) {
+    return sdError(SD_CARD_ERROR_CMD17);
+  }
+  if (!readWords(ptr) || !waitStatus(HSMCI_SR_XFRDONE, DATA_TIMEOUT_MICROS)) {
+    return sdError(SD_CARD_ERROR_READ);
+  }
+  if (ptr == aligned) {
+    memcpy(buf, aligned, 512);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readBlocks(uint32_t lba, uint8_t* buf, size_t n) {
+  if (n == 1 || ((uint32_t)buf & 3)) {
+    for (size_t i = 0; i < n; i++, lba++, buf += 512) {
+      if (!readBlock(lba, buf)) {
+        return false;  // readBlock will set errorCode.
+      }
+    }
+    return true;
+  }
+  if (!readStart(lba, n)) {
+    return false;
+  }
+  for (size_t i = 0; i < n; i++, buf += 512) {
+    if (!readData(buf)) {
+      return false;
+    }
+  }
+  return readStop();
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readCID(void* cid) {
+  memcpy(cid, &m_cid, 16);
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readCSD(void* csd) {
+  memcpy(csd, &m_csd, 16);
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readData(uint8_t *dst) {
+  if (!m_blockCount) {
+    return sdError(SD_CARD_ERROR_READ);
+  }
+  uint32_t aligned[512/4];
+  uint32_t* ptr = (uint32_t)dst & 3 ? aligned : reinterpret_cast<uint32_t*>(dst);
+  if (!readWords(ptr)) {
+    return false;
+  }
+  if (ptr == aligned) {
+    memcpy(dst, aligned, 512);
+  }
+  m_blockCount--;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readOCR(uint32_t* ocr) {
+  *ocr = m_ocr;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readStart(uint32_t lba) {
+  // The HSMCI needs the block count of a multiple block transfer.
+  return sdError(SD_CARD_ERROR_FUNCTION_NOT_SUPPORTED);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readStart(uint32_t lba, uint32_t count) {
+  if (count == 0 || count > 0XFFFF) {
+    return sdError(SD_CARD_ERROR_READ_START);
+  }
+  if (!transferStart(CMD18_CMDR, lba, count)) {
+    return sdError(SD_CARD_ERROR_CMD18);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readStop() {
+  return transferStop();
+}
+//------------------------------------------------------------------------------
+bool SdioCard::syncBlocks() {
+  return true;
+}
+//------------------------------------------------------------------------------
+uint8_t SdioCard::type() {
+  return  m_version2 ? m_highCapacity ?
+          SD_CARD_TYPE_SDHC : SD_CARD_TYPE_SD2 : SD_CARD_TYPE_SD1;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeBlock(uint32_t lba, const uint8_t* buf) {
+  uint32_t aligned[512/4];
+  const uint32_t* ptr = reinterpret_cast<const uint32_t*>(buf);
+  if (3 & (uint32_t)buf) {
+    memcpy(aligned, buf, 512);
+    ptr = aligned;
+  }
+  if (!transferStart(CMD24_CMDR, lba, 1)) {
+    return sdError(SD_CARD_ERROR_CMD24);
+  }
+  if (!writeWords(ptr) || !waitStatus(HSMCI_SR_NOTBUSY, BUSY_TIMEOUT_MICROS)) {
+    return sdError(SD_CARD_ERROR_WRITE_TIMEOUT);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeBlocks(uint32_t lba, const uint8_t* buf, size_t n) {
+  if (n == 1) {
+    return writeBlock(lba, buf);
+  }
+  if (!writeStart(lba, n)) {
+    return false;
+  }
+  for (size_t i = 0; i < n; i++, buf += 512) {
+    if (!writeData(buf)) {
+      return false;
+    }
+  }
+  return writeStop();
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeData(const uint8_t* src) {
+  if (!m_blockCount) {
+    return sdError(SD_CARD_ERROR_WRITE);
+  }
+  uint32_t aligned[512/4];
+  const uint32_t* ptr = reinterpret_cast<const uint32_t*>(src);
+  if (3 & (uint32_t)src) {
+    memcpy(aligned, src, 512);
+    ptr = aligned;
+  }
+  if (!writeWords(ptr)) {
+    return false;
+  }
+  m_blockCount--;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeStart(uint32_t lba) {
+  // The HSMCI needs the block count of a multiple block transfer.
+  return sdError(SD_CARD_ERROR_FUNCTION_NOT_SUPPORTED);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeStart(uint32_t lba, uint32_t count) {
+  if (count == 0 || count > 0XFFFF) {
+    return sdError(SD_CARD_ERROR_WRITE_START);
+  }
+  if (!transferStart(CMD25_CMDR, lba, count)) {
+    return sdError(SD_CARD_ERROR_CMD25);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeStop() {
+  return transferStop() && waitStatus(HSMCI_SR_NOTBUSY, BUSY_TIMEOUT_MICROS);
+}
+#endif  // SD_SDIO && (__SAM3X8E__ || __SAM3X8H__)
@@ -0,0 +1,329 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * SdioSTM32.cpp
+ *
+ * SdioCard on the SDIO of the STM32 F4 or the SDMMC1 of the STM32 F7,
+ * 4 bit bus, with the HAL SD driver of the core in polling mode.
+ * Pins: CK PC12, CMD PD2, D0-D3 PC8-PC11.
+ * The core needs HAL_SD_MODULE_ENABLED, set in hal_conf_extra.h.
+ */
+#include "../../../../MK4duo.h"
+#if ENABLED(SD_SDIO) && ENABLED(ARDUINO_ARCH_STM32) && (defined(STM32F4xx) || defined(STM32F7xx))
+#include "SdioCard.h"
+
+#if DISABLED(HAL_SD_MODULE_ENABLED)
+  #error "SD_SDIO needs HAL_SD_MODULE_ENABLED in hal_conf_extra.h"
+#endif
+
+#if defined(STM32F7xx)
+  #define SD_INSTANCE             SDMMC1
+  #define SD_GPIO_AF              GPIO_AF12_SDMMC1
+  #define SD_CLK_ENABLE()         __HAL_RCC_SDMMC1_CLK_ENABLE()
+  #define SD_FORCE_RESET()        __HAL_RCC_SDMMC1_FORCE_RESET()
+  #define SD_RELEASE_RESET()      __HAL_RCC_SDMMC1_RELEASE_RESET()
+  #define SD_CLOCK_EDGE_RISING    SDMMC_CLOCK_EDGE_RISING
+  #define SD_CLOCK_BYPASS_DISABLE SDMMC_CLOCK_BYPASS_DISABLE
+  #define SD_CLOCK_POWER_SAVE_OFF SDMMC_CLOCK_POWER_SAVE_DISABLE
+  #define SD_BUS_WIDE_1B          SDMMC_BUS_WIDE_1B
+  #define SD_BUS_WIDE_4B          SDMMC_BUS_WIDE_4B
+  #define SD_HW_FLOW_DISABLE      SDMMC_HARDWARE_FLOW_CONTROL_DISABLE
+#else
+  #define SD_INSTANCE             SDIO
+  #define SD_GPIO_AF              GPIO_AF12_SDIO
+  #define SD_CLK_ENABLE()         __HAL_RCC_SDIO_CLK_ENABLE()
+  #define SD_FORCE_RESET()        __HAL_RCC_SDIO_FORCE_RESET()
+  #define SD_RELEASE_RESET()      __HAL_RCC_SDIO_RELEASE_RESET()
+  #define SD_CLOCK_EDGE_RISING    SDIO_CLOCK_EDGE_RISING
+  #define SD_CLOCK_BYPASS_DISABLE SDIO_CLOCK_BYPASS_DISABLE
+  #define SD_CLOCK_POWER_SAVE_OFF SDIO_CLOCK_POWER_SAVE_DISABLE
+  #define SD_BUS_WIDE_1B          SDIO_BUS_WIDE_1B
+  #define SD_BUS_WIDE_4B          SDIO_BUS_WIDE_4B
+  #define SD_HW_FLOW_DISABLE      SDIO_HARDWARE_FLOW_CONTROL_DISABLE
+#endif
+//==============================================================================
+const uint32_t SD_KERNEL_KHZ = 48000;   // SDIO kernel clock from the 48 MHz PLL output
+const uint32_t DATA_TIMEOUT_MS = 500;
+//==============================================================================
+static SD_HandleTypeDef hsd;
+static bool m_initDone = false;
+static uint8_t m_errorCode = SD_CARD_ERROR_INIT_NOT_CALLED;
+static uint32_t m_errorLine = 0;
+static uint32_t m_sdClkKhz = 0;
+static uint32_t m_lba;          // Next block of a readStart() or writeStart()
+static uint32_t m_blockCount;   // Blocks left of a readStart() or writeStart()
+static cid_t m_cid;
+static csd_t m_csd;
+//==============================================================================
+// Error function and macro.
+#define sdError(code) setSdErrorCode(code, __LINE__)
+inline bool setSdErrorCode(uint8_t code, uint32_t line) {
+  m_errorCode = code;
+  m_errorLine = line;
+  return false;  // setSdErrorCode
+}
+//==============================================================================
+// HAL callback of HAL_SD_Init(), pins and clock of the peripheral.
+extern "C" void HAL_SD_MspInit(SD_HandleTypeDef* h) {
+  UNUSED(h);
+  GPIO_InitTypeDef gpio;
+  __HAL_RCC_GPIOC_CLK_ENABLE();
+  __HAL_RCC_GPIOD_CLK_ENABLE();
+  SD_CLK_ENABLE();
+  SD_FORCE_RESET();
+  SD_RELEASE_RESET();
+
+  gpio.Mode = GPIO_MODE_AF_PP;
+  gpio.Pull = GPIO_PULLUP;
+  gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  gpio.Alternate = SD_GPIO_AF;
+  gpio.Pin = GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10 | GPIO_PIN_11;
+  HAL_GPIO_Init(GPIOC, &gpio);
+  gpio.Pull = GPIO_NOPULL;
+  gpio.Pin = GPIO_PIN_12;
+  HAL_GPIO_Init(GPIOC, &gpio);
+  gpio.Pull = GPIO_PULLUP;
+  gpio.Pin = GPIO_PIN_2;
+  HAL_GPIO_Init(GPIOD, &gpio);
+}
+//==============================================================================
+// Static functions.
+// CID and CSD come as words, the first one the MSB, as the bytes of cid_t and csd_t
+static void regToBytes(const uint32_t* reg, void* data) {
+  uint8_t* d = reinterpret_cast<uint8_t*>(data);
+  for (uint8_t w = 0; w < 4; w++)
+    for (uint8_t b = 0; b < 4; b++) d[4*w + b] = reg[w] >> (24 - 8*b);
+}
+//------------------------------------------------------------------------------
+static bool waitReady() {
+  const uint32_t m = millis();
+  while (HAL_SD_GetCardState(&hsd) != HAL_SD_CARD_TRANSFER) {
+    if ((millis() - m) > DATA_TIMEOUT_MS) return false;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+// The HAL reads and writes by 32 bit words
+static bool rdBlocks(uint32_t lba, uint8_t* buf, size_t n) {
+  if (!waitReady()) {
+    return sdError(SD_CARD_ERROR_CMD13);
+  }
+  if (HAL_SD_ReadBlocks(&hsd, buf, lba, n, DATA_TIMEOUT_MS * n) != HAL_OK) {
+    return sdError(n > 1 ? SD_CARD_ERROR_CMD18 : SD_CARD_ERROR_CMD17);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+static bool wrBlocks(uint32_t lba, const uint8_t* buf, size_t n) {
+  if (!waitReady()) {
+    return sdError(SD_CARD_ERROR_CMD13);
+  }
+  if (HAL_SD_WriteBlocks(&hsd, const_cast<uint8_t*>(buf), lba, n, DATA_TIMEOUT_MS * n) != HAL_OK) {
+    return sdError(n > 1 ? SD_CARD_ERROR_CMD25 : SD_CARD_ERROR_CMD24);
+  }
+  return waitReady() || sdError(SD_CARD_ERROR_WRITE_TIMEOUT);
+}
+//==============================================================================
+bool SdioCard::begin() {
+  m_initDone = false;
+  m_errorCode = SD_CARD_ERROR_NONE;
+
+  // Card identification at 400 kHz and 1 bit, then 4 bit and the data clock
+  hsd.Instance = SD_INSTANCE;
+  hsd.Init.ClockEdge = SD_CLOCK_EDGE_RISING;
+  hsd.Init.ClockBypass = SD_CLOCK_BYPASS_DISABLE;
+  hsd.Init.ClockPowerSave = SD_CLOCK_POWER_SAVE_OFF;
+  hsd.Init.BusWide = SD_BUS_WIDE_1B;
+  hsd.Init.HardwareFlowControl = SD_HW_FLOW_DISABLE;
+  hsd.Init.ClockDiv = SD_KERNEL_KHZ / 400 - 2;
+
+  if (HAL_SD_Init(&hsd) != HAL_OK) {
+    return sdError(SD_CARD_ERROR_CMD0);
+  }
+  if (HAL_SD_ConfigWideBusOperation(&hsd, SD_BUS_WIDE_4B) != HAL_OK) {
+    return sdError(SD_CARD_ERROR_ACMD6);
+  }
+
+  // SDIO_CK = kernel clock / (ClockDiv + 2)
+  uint32_t div = (SD_KERNEL_KHZ + SD_SDIO_CLOCK - 1) / (SD_SDIO_CLOCK);
+  div = div > 2 ? div - 2 : 0;
+  m_sdClkKhz = SD_KERNEL_KHZ / (div + 2);
+  MODIFY_REG(SD_INSTANCE->CLKCR, 0xFF, div);
+
+  regToBytes(hsd.CSD, &m_csd);
+  regToBytes(hsd.CID, &m_cid);
+
+  m_initDone = true;
+  return true;
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::cardCapacity() {
+  return sdCardCapacity(&m_csd);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::erase(uint32_t firstBlock, uint32_t lastBlock) {
+  if (HAL_SD_Erase(&hsd, firstBlock, lastBlock) != HAL_OK) {
+    return sdError(SD_CARD_ERROR_ERASE);
+  }
+  return waitReady() || sdError(SD_CARD_ERROR_ERASE_TIMEOUT);
+}
+//------------------------------------------------------------------------------
+uint8_t SdioCard::errorCode() {
+  return m_errorCode;
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::errorData() {
+  return hsd.ErrorCode;
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::errorLine() {
+  return m_errorLine;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::isBusy() {
+  return m_initDone && HAL_SD_GetCardState(&hsd) != HAL_SD_CARD_TRANSFER;
+}
+//------------------------------------------------------------------------------
+uint32_t SdioCard::kHzSdClk() {
+  return m_sdClkKhz;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readBlock(uint32_t lba, uint8_t* buf) {
+  uint32_t aligned[512/4];
+  uint8_t* ptr = (uint32_t)buf & 3 ? reinterpret_cast<uint8_t*>(aligned) : buf;
+  if (!rdBlocks(lba, ptr, 1)) {
+    return false;
+  }
+  if (ptr != buf) {
+    memcpy(buf, aligned, 512);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readBlocks(uint32_t lba, uint8_t* buf, size_t n) {
+  if ((uint32_t)buf & 3) {
+    for (size_t i = 0; i < n; i++, lba++, buf += 512) {
+      if (!readBlock(lba, buf)) {
+        return false;  // readBlock will set errorCode.
+      }
+    }
+    return true;
+  }
+  return rdBlocks(lba, buf, n);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readCID(void* cid) {
+  memcpy(cid, &m_cid, 16);
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readCSD(void* csd) {
+  memcpy(csd, &m_csd, 16);
+  return true;
+}
+//------------------------------------------------------------------------------
+// The HAL has no open ended transfer, each block of a sequence is one transfer.
+bool SdioCard::readData(uint8_t *dst) {
+  if (!m_blockCount) {
+    return sdError(SD_CARD_ERROR_READ);
+  }
+  m_blockCount--;
+  return readBlock(m_lba++, dst);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readOCR(uint32_t* ocr) {
+  // The HAL keeps only the capacity bit of the OCR.
+  *ocr = hsd.SdCard.CardType == CARD_SDHC_SDXC ? 0XC0000000 : 0X80000000;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readStart(uint32_t lba) {
+  return readStart(lba, 0XFFFFFFFF);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readStart(uint32_t lba, uint32_t count) {
+  m_lba = lba;
+  m_blockCount = count;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::readStop() {
+  m_blockCount = 0;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::syncBlocks() {
+  return true;
+}
+//------------------------------------------------------------------------------
+uint8_t SdioCard::type() {
+  return  hsd.SdCard.CardVersion == CARD_V2_X ?
+          hsd.SdCard.CardType == CARD_SDHC_SDXC ?
+          SD_CARD_TYPE_SDHC : SD_CARD_TYPE_SD2 : SD_CARD_TYPE_SD1;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeBlock(uint32_t lba, const uint8_t* buf) {
+  uint32_t aligned[512/4];
+  const uint8_t* ptr = buf;
+  if (3 & (uint32_t)buf) {
+    memcpy(aligned, buf, 512);
+    ptr = reinterpret_cast<const uint8_t*>(aligned);
+  }
+  return wrBlocks(lba, ptr, 1);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeBlocks(uint32_t lba, const uint8_t* buf, size_t n) {
+  if (3 & (uint32_t)buf) {
+    for (size_t i = 0; i < n; i++, lba++, buf += 512) {
+      if (!writeBlock(lba, buf)) {
+        return false;  // writeBlock will set errorCode.
+      }
+    }
+    return true;
+  }
+  return wrBlocks(lba, buf, n);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeData(const uint8_t* src) {
+  if (!m_blockCount) {
+    return sdError(SD_CARD_ERROR_WRITE);
+  }
+  m_blockCount--;
+  return writeBlock(m_lba++, src);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeStart(uint32_t lba) {
+  return writeStart(lba, 0XFFFFFFFF);
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeStart(uint32_t lba, uint32_t count) {
+  m_lba = lba;
+  m_blockCount = count;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdioCard::writeStop() {
+  m_blockCount = 0;
+  return true;
+}
+#endif  // SD_SDIO && ARDUINO_ARCH_STM32 && (STM32F4xx || STM32F7xx)
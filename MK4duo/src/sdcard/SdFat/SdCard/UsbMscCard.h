@@ -0,0 +1,72 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * UsbMscCard.h
+ *
+ * A USB flash drive (mass storage, Bulk Only, SCSI) on the USB host of the MCU,
+ * seen by SdFat as a card. UsbMscSAM3X.cpp and UsbMscSTM32.cpp.
+ */
+#ifndef UsbMscCard_h
+#define UsbMscCard_h
+#include "../SysCall.h"
+#include "../BlockDriver.h"
+#include "SdInfo.h"
+/**
+ * \class UsbMscCard
+ * \brief Raw block access to a USB flash drive, 512 byte blocks.
+ */
+class UsbMscCard : public BaseBlockDriver {
+ public:
+  /** Check the drive for a mount.
+   * \return true if a drive is enumerated and ready.
+   */
+  bool begin();
+  /** Run the USB host: enumeration, attach and detach. From the idle loop. */
+  void task();
+  /** \return true if a drive is enumerated and ready. */
+  bool isReady();
+  /** \return The number of 512 byte blocks of the drive or zero. */
+  uint32_t cardSize();
+  /** \return code for the last error. See SdInfo.h for a list of error codes. */
+  uint8_t errorCode();
+  /** \return error data for last error. */
+  uint32_t errorData();
+  /** \return SDHC, the drive takes block addresses. */
+  uint8_t type() { return SD_CARD_TYPE_SDHC; }
+  /** A drive has no CID and CSD registers. \return false. */
+  bool readCID(void* cid) { (void)cid; return false; }
+  bool readCSD(void* csd) { (void)csd; return false; }
+  bool readBlock(uint32_t lba, uint8_t* dst) { return readBlocks(lba, dst, 1); }
+  bool readBlocks(uint32_t lba, uint8_t* dst, size_t nb);
+  /** \return true, the drive writes each command to the end. */
+  bool syncBlocks() { return true; }
+  bool writeBlock(uint32_t lba, const uint8_t* src) { return writeBlocks(lba, src, 1); }
+  bool writeBlocks(uint32_t lba, const uint8_t* src, size_t nb);
+  /** Multi block write, one block at a time, for the formatter. */
+  bool writeStart(uint32_t lba, uint32_t count) { (void)count; m_lba = lba; return true; }
+  bool writeData(const uint8_t* src) { return writeBlock(m_lba++, src); }
+  bool writeStop() { return true; }
+ private:
+  uint32_t m_lba;
+};
+#endif  // UsbMscCard_h
@@ -0,0 +1,310 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * UsbMscSAM3X.cpp
+ *
+ * UsbMscCard on the native USB port of the DUE, host mode, with the USBHost
+ * library of the core: a Bulk Only mass storage driver with the SCSI commands
+ * TEST UNIT READY, READ CAPACITY (10), READ (10) and WRITE (10).
+ * The port gives no VBUS, the drive needs 5V on the connector.
+ */
+#include "../../../../MK4duo.h"
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT) && (defined(__SAM3X8E__) || defined(__SAM3X8H__))
+#include "UsbMscCard.h"
+
+#include <Usb.h>
+#include <confdescparser.h>
+
+//==============================================================================
+const uint32_t  MSC_CBW_SIGNATURE = 0x43425355;
+const uint32_t  MSC_CSW_SIGNATURE = 0x53425355;
+const uint8_t   MSC_BLOCKS_MAX    = 8;      // Blocks of a READ (10) or WRITE (10)
+const uint32_t  MSC_READY_MS      = 500;    // TEST UNIT READY period until ready
+
+const uint8_t   SCSI_TEST_UNIT_READY  = 0x00,
+                SCSI_READ_CAPACITY_10 = 0x25,
+                SCSI_READ_10          = 0x28,
+                SCSI_WRITE_10         = 0x2A;
+
+struct __attribute__((packed)) msc_cbw_t {
+  uint32_t  signature, tag, length;
+  uint8_t   flags, lun, cb_length, cb[16];
+};
+
+struct __attribute__((packed)) msc_csw_t {
+  uint32_t  signature, tag, residue;
+  uint8_t   status;
+};
+//==============================================================================
+// Error function and macro.
+static uint8_t m_errorCode = SD_CARD_ERROR_INIT_NOT_CALLED;
+static uint32_t m_errorLine = 0;
+#define sdError(code) setSdErrorCode(code, __LINE__)
+inline bool setSdErrorCode(uint8_t code, uint32_t line) {
+  m_errorCode = code;
+  m_errorLine = line;
+  return false;
+}
+//==============================================================================
+/**
+ * The driver of the drive for the USBHost, interface 08 (mass storage),
+ * subclass 06 (SCSI), protocol 50 (Bulk Only) and the two bulk endpoints.
+ */
+class MscBulkOnly : public USBDeviceConfig, public UsbConfigXtracter {
+
+  public: /** Constructor */
+
+    MscBulkOnly(USBHost *p) : pUsb(p) {
+      Release();
+      pUsb->RegisterDeviceClass(this);
+    }
+
+  public: /** Public Parameters */
+
+    uint32_t  blocks;
+    bool      ready;
+
+  private: /** Private Parameters */
+
+    static const uint8_t epBulkIn   = 1,
+                         epBulkOut  = 2;
+
+    USBHost   *pUsb;
+    EpInfo    epInfo[3];
+    uint32_t  bAddress, bConfNum, bNumEP, tag;
+    millis_l  ready_ms;
+
+  public: /** Public Function */
+
+    uint32_t Init(uint32_t parent, uint32_t port, uint32_t lowspeed) override;
+    uint32_t Release() override;
+    uint32_t Poll() override;
+    uint32_t GetAddress() override { return bAddress; }
+
+    void EndpointXtract(uint32_t conf, uint32_t iface, uint32_t alt, uint32_t proto, const USB_ENDPOINT_DESCRIPTOR *pep) override;
+
+    bool transfer(const uint8_t *cb, const uint8_t cb_length, uint8_t *data, const uint32_t length, const bool in);
+
+  private: /** Private Function */
+
+    bool test_ready();
+    bool read_capacity();
+
+};
+
+uint32_t MscBulkOnly::Init(uint32_t parent, uint32_t port, uint32_t lowspeed) {
+  uint8_t buf[sizeof(USB_DEVICE_DESCRIPTOR)];
+  AddressPool &addrPool = pUsb->GetAddressPool();
+
+  if (bAddress) return USB_ERROR_CLASS_INSTANCE_ALREADY_IN_USE;
+
+  UsbDevice *p = addrPool.GetUsbDevicePtr(0);
+  if (!p) return USB_ERROR_ADDRESS_NOT_FOUND_IN_POOL;
+  if (!p->epinfo) return USB_ERROR_EPINFO_IS_NULL;
+
+  // Device descriptor on the address 0
+  EpInfo *oldep_ptr = p->epinfo;
+  p->epinfo = epInfo;
+  p->lowspeed = lowspeed;
+  uint32_t rcode = pUsb->getDevDescr(0, 0, sizeof(USB_DEVICE_DESCRIPTOR), buf);
+  p->epinfo = oldep_ptr;
+  if (rcode) return rcode;
+
+  bAddress = addrPool.AllocAddress(parent, false, port);
+  if (!bAddress) return USB_ERROR_OUT_OF_ADDRESS_SPACE_IN_POOL;
+
+  epInfo[0].maxPktSize = ((USB_DEVICE_DESCRIPTOR*)buf)->bMaxPacketSize0;
+  rcode = pUsb->setAddr(0, 0, bAddress);
+  if (rcode) {
+    p->lowspeed = false;
+    addrPool.FreeAddress(bAddress);
+    bAddress = 0;
+    return rcode;
+  }
+  p->lowspeed = false;
+
+  p = addrPool.GetUsbDevicePtr(bAddress);
+  if (!p) return USB_ERROR_ADDRESS_NOT_FOUND_IN_POOL;
+  p->lowspeed = lowspeed;
+
+  rcode = pUsb->setEpInfoEntry(bAddress, 1, epInfo);
+  if (rcode) { Release(); return rcode; }
+
+  // The endpoints from the configurations
+  const uint8_t num_of_conf = ((USB_DEVICE_DESCRIPTOR*)buf)->bNumConfigurations;
+  for (uint8_t i = 0; i < num_of_conf && bNumEP < 3; i++) {
+    ConfigDescParser<0x08, 0x06, 0x50, CP_MASK_COMPARE_ALL> confDescrParser(this);
+    rcode = pUsb->getConfDescr(bAddress, 0, i, &confDescrParser);
+  }
+  if (bNumEP < 3) { Release(); return USB_DEV_CONFIG_ERROR_DEVICE_NOT_SUPPORTED; }
+
+  rcode = pUsb->setEpInfoEntry(bAddress, bNumEP, epInfo);
+  if (!rcode) rcode = pUsb->setConf(bAddress, 0, bConfNum);
+  if (rcode) { Release(); return rcode; }
+
+  ready_ms = millis();
+  return 0;
+}
+
+uint32_t MscBulkOnly::Release() {
+  if (bAddress) pUsb->GetAddressPool().FreeAddress(bAddress);
+  for (uint8_t i = 0; i < 3; i++) {
+    epInfo[i].deviceEpNum = 0;
+    epInfo[i].hostPipeNum = 0;
+    epInfo[i].maxPktSize  = i ? 0 : 8;
+    epInfo[i].epAttribs   = 0;
+    epInfo[i].bmNakPower  = USB_NAK_MAX_POWER;
+  }
+  bAddress = bConfNum = tag = blocks = 0;
+  bNumEP = 1;
+  ready = false;
+  return 0;
+}
+
+// Until the drive is ready, TEST UNIT READY and READ CAPACITY (10) every MSC_READY_MS
+uint32_t MscBulkOnly::Poll() {
+  if (!bAddress || ready || millis() - ready_ms < MSC_READY_MS) return 0;
+  ready_ms = millis();
+  ready = test_ready() && read_capacity();
+  return 0;
+}
+
+void MscBulkOnly::EndpointXtract(uint32_t conf, uint32_t iface, uint32_t alt, uint32_t proto, const USB_ENDPOINT_DESCRIPTOR *pep) {
+  UNUSED(iface); UNUSED(alt); UNUSED(proto);
+  if (bNumEP > 1 && conf != bConfNum) return;
+  if ((pep->bmAttributes & 0x03) != USB_TRANSFER_TYPE_BULK) return;
+
+  const bool in = TEST(pep->bEndpointAddress, 7);
+  const uint8_t index = in ? epBulkIn : epBulkOut;
+  if (epInfo[index].deviceEpNum) return;
+
+  bConfNum = conf;
+  epInfo[index].deviceEpNum = pep->bEndpointAddress & 0x0F;
+  epInfo[index].maxPktSize  = (uint8_t)pep->wMaxPacketSize;
+  epInfo[index].hostPipeNum = UHD_Pipe_Alloc(bAddress, epInfo[index].deviceEpNum, UOTGHS_HSTPIPCFG_PTYPE_BLK,
+                                in ? UOTGHS_HSTPIPCFG_PTOKEN_IN : UOTGHS_HSTPIPCFG_PTOKEN_OUT,
+                                epInfo[index].maxPktSize, 0, UOTGHS_HSTPIPCFG_PBK_1_BANK);
+  bNumEP++;
+}
+
+// One command: CBW, data stage and CSW
+bool MscBulkOnly::transfer(const uint8_t *cb, const uint8_t cb_length, uint8_t *data, const uint32_t length, const bool in) {
+  msc_cbw_t cbw;
+  msc_csw_t csw;
+
+  ZERO(cbw.cb);
+  cbw.signature = MSC_CBW_SIGNATURE;
+  cbw.tag       = ++tag;
+  cbw.length    = length;
+  cbw.flags     = in ? 0x80 : 0x00;
+  cbw.lun       = 0;
+  cbw.cb_length = cb_length;
+  memcpy(cbw.cb, cb, cb_length);
+
+  if (pUsb->outTransfer(bAddress, epInfo[epBulkOut].deviceEpNum, sizeof(cbw), (uint8_t*)&cbw)) return false;
+
+  if (length) {
+    if (in) {
+      uint32_t read = length;
+      if (pUsb->inTransfer(bAddress, epInfo[epBulkIn].deviceEpNum, &read, data) || read != length) return false;
+    }
+    else if (pUsb->outTransfer(bAddress, epInfo[epBulkOut].deviceEpNum, length, data)) return false;
+  }
+
+  uint32_t read = sizeof(csw);
+  if (pUsb->inTransfer(bAddress, epInfo[epBulkIn].deviceEpNum, &read, (uint8_t*)&csw) || read != sizeof(csw)) return false;
+
+  return csw.signature == MSC_CSW_SIGNATURE && csw.tag == cbw.tag && csw.status == 0;
+}
+
+bool MscBulkOnly::test_ready() {
+  const uint8_t cb[6] = { SCSI_TEST_UNIT_READY, 0, 0, 0, 0, 0 };
+  return transfer(cb, sizeof(cb), nullptr, 0, true);
+}
+
+bool MscBulkOnly::read_capacity() {
+  const uint8_t cb[10] = { SCSI_READ_CAPACITY_10, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  uint8_t data[8];
+  if (!transfer(cb, sizeof(cb), data, sizeof(data), true)) return false;
+  // Big endian, the last block and the block size: only 512 byte blocks
+  const uint32_t last = (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | data[3],
+                 size = (uint32_t(data[4]) << 24) | (uint32_t(data[5]) << 16) | (uint32_t(data[6]) << 8) | data[7];
+  if (size != 512) return false;
+  blocks = last + 1;
+  return true;
+}
+//==============================================================================
+static USBHost usbHost;
+static MscBulkOnly msc(&usbHost);
+//------------------------------------------------------------------------------
+// READ (10) or WRITE (10) of blocks, MSC_BLOCKS_MAX at a time
+static bool rwBlocks(const uint8_t op, uint32_t lba, uint8_t* buf, size_t nb) {
+  while (nb) {
+    const uint8_t n = MIN(nb, MSC_BLOCKS_MAX);
+    const uint8_t cb[10] = { op, 0, uint8_t(lba >> 24), uint8_t(lba >> 16), uint8_t(lba >> 8), uint8_t(lba), 0, 0, n, 0 };
+    if (!msc.transfer(cb, sizeof(cb), buf, uint32_t(n) * 512, op == SCSI_READ_10)) return false;
+    lba += n;
+    buf += uint32_t(n) * 512;
+    nb -= n;
+  }
+  return true;
+}
+//==============================================================================
+bool UsbMscCard::begin() {
+  m_errorCode = SD_CARD_ERROR_NONE;
+  if (!isReady()) return sdError(SD_CARD_ERROR_CMD0);
+  return true;
+}
+//------------------------------------------------------------------------------
+void UsbMscCard::task() {
+  usbHost.Task();
+}
+//------------------------------------------------------------------------------
+bool UsbMscCard::isReady() {
+  return usbHost.getUsbTaskState() == USB_STATE_RUNNING && msc.ready;
+}
+//------------------------------------------------------------------------------
+uint32_t UsbMscCard::cardSize() {
+  return isReady() ? msc.blocks : 0;
+}
+//------------------------------------------------------------------------------
+uint8_t UsbMscCard::errorCode() {
+  return m_errorCode;
+}
+//------------------------------------------------------------------------------
+uint32_t UsbMscCard::errorData() {
+  return m_errorLine;
+}
+//------------------------------------------------------------------------------
+bool UsbMscCard::readBlocks(uint32_t lba, uint8_t* dst, size_t nb) {
+  if (!isReady() || !rwBlocks(SCSI_READ_10, lba, dst, nb))
+    return sdError(SD_CARD_ERROR_READ);
+  return true;
+}
+//------------------------------------------------------------------------------
+bool UsbMscCard::writeBlocks(uint32_t lba, const uint8_t* src, size_t nb) {
+  if (!isReady() || !rwBlocks(SCSI_WRITE_10, lba, (uint8_t*)src, nb))
+    return sdError(SD_CARD_ERROR_WRITE);
+  return true;
+}
+#endif  // USB_FLASH_DRIVE_SUPPORT && (__SAM3X8E__ || __SAM3X8H__)
@@ -0,0 +1,129 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (c) 2020 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * UsbMscSTM32.cpp
+ *
+ * UsbMscCard on the USB OTG FS of the STM32 (PA11 DM, PA12 DP), host mode,
+ * with the MSC class of the STM32 USB Host Library, in polling mode.
+ * The core needs the host middleware, build with -DUSBHOST.
+ */
+#include "../../../../MK4duo.h"
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT) && ENABLED(ARDUINO_ARCH_STM32)
+#include "UsbMscCard.h"
+
+#if DISABLED(USBHOST)
+  #error "USB_FLASH_DRIVE_SUPPORT needs the USB Host Library of the core, build with -DUSBHOST"
+#endif
+
+#include "usbh_core.h"
+#include "usbh_msc.h"
+
+//==============================================================================
+const uint8_t   MSC_LUN           = 0;
+const uint32_t  MSC_TIMEOUT_MS    = 1000;
+//==============================================================================
+static USBH_HandleTypeDef hUsbHost;
+static bool     m_initDone  = false;
+static volatile bool m_classActive = false;
+static uint8_t  m_errorCode = SD_CARD_ERROR_INIT_NOT_CALLED;
+static uint32_t m_errorLine = 0;
+//==============================================================================
+// Error function and macro.
+#define sdError(code) setSdErrorCode(code, __LINE__)
+inline bool setSdErrorCode(uint8_t code, uint32_t line) {
+  m_errorCode = code;
+  m_errorLine = line;
+  return false;
+}
+//==============================================================================
+static void usbUserProcess(USBH_HandleTypeDef *phost, uint8_t id) {
+  UNUSED(phost);
+  switch (id) {
+    case HOST_USER_CLASS_ACTIVE:  m_classActive = true;  break;
+    case HOST_USER_DISCONNECTION: m_classActive = false; break;
+    default: break;
+  }
+}
+//------------------------------------------------------------------------------
+// The MSC class runs its requests in USBH_Process, wait for the end of one.
+static bool waitLUN() {
+  const uint32_t start = millis();
+  while (USBH_MSC_IsReady(&hUsbHost) == 0) {
+    USBH_Process(&hUsbHost);
+    if (!m_classActive || millis() - start > MSC_TIMEOUT_MS) return false;
+  }
+  return true;
+}
+//==============================================================================
+bool UsbMscCard::begin() {
+  m_errorCode = SD_CARD_ERROR_NONE;
+  if (!isReady()) return sdError(SD_CARD_ERROR_CMD0);
+  return true;
+}
+//------------------------------------------------------------------------------
+void UsbMscCard::task() {
+  if (!m_initDone) {
+    if (USBH_Init(&hUsbHost, usbUserProcess, HOST_FS) != USBH_OK) return;
+    USBH_RegisterClass(&hUsbHost, USBH_MSC_CLASS);
+    USBH_Start(&hUsbHost);
+    m_initDone = true;
+  }
+  USBH_Process(&hUsbHost);
+}
+//------------------------------------------------------------------------------
+bool UsbMscCard::isReady() {
+  return m_initDone && m_classActive && USBH_MSC_UnitIsReady(&hUsbHost, MSC_LUN);
+}
+//------------------------------------------------------------------------------
+uint32_t UsbMscCard::cardSize() {
+  MSC_LUNTypeDef info;
+  if (!isReady() || USBH_MSC_GetLUNInfo(&hUsbHost, MSC_LUN, &info) != USBH_OK) return 0;
+  if (info.capacity.block_size != 512) return 0;
+  return info.capacity.block_nbr;
+}
+//------------------------------------------------------------------------------
+uint8_t UsbMscCard::errorCode() {
+  return m_errorCode;
+}
+//------------------------------------------------------------------------------
+uint32_t UsbMscCard::errorData() {
+  return m_errorLine;
+}
+//------------------------------------------------------------------------------
+bool UsbMscCard::readBlocks(uint32_t lba, uint8_t* dst, size_t nb) {
+  if (!isReady() || !waitLUN())
+    return sdError(SD_CARD_ERROR_READ_TIMEOUT);
+  if (USBH_MSC_Read(&hUsbHost, MSC_LUN, lba, dst, nb) != USBH_OK)
+    return sdError(SD_CARD_ERROR_READ);
+  return true;
+}
+//------------------------------------------------------------------------------
+bool UsbMscCard::writeBlocks(uint32_t lba, const uint8_t* src, size_t nb) {
+  if (!isReady() || !waitLUN())
+    return sdError(SD_CARD_ERROR_WRITE_TIMEOUT);
+  if (USBH_MSC_Write(&hUsbHost, MSC_LUN, lba, (uint8_t*)src, nb) != USBH_OK)
+    return sdError(SD_CARD_ERROR_WRITE);
+  return true;
+}
+
+#endif  // USB_FLASH_DRIVE_SUPPORT && ARDUINO_ARCH_STM32
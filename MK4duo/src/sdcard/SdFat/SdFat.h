@@ -32,6 +32,7 @@
 #include "BlockDriver.h"
 #include "FatLib/FatLib.h"
 #include "SdCard/SdioCard.h"
+#include "SdCard/UsbMscCard.h"
 #if INCLUDE_SDIOS
 #include "sdios.h"
 #endif  // INCLUDE_SDIOS
@@ -332,6 +333,34 @@ class SdFatSdioEX : public SdFileSystem<SdioCardEX> {
 #endif  // ENABLE_SDIOEX_CLASS || defined(DOXYGEN)
 #endif  // ENABLE_SDIO_CLASS || defined(DOXYGEN)
 //=============================================================================
+#if ENABLE_USB_MSC_CLASS
+/**
+ * \class SdFatUsb
+ * \brief SdFat class on a USB flash drive.
+ */
+class SdFatUsb : public SdFileSystem<UsbMscCard> {
+ public:
+  /** Initialize the drive and file system.
+   * \return true for success else false.
+   */
+  bool begin() {
+    return m_card.begin() && SdFileSystem::begin();
+  }
+  /** Initialize the drive for diagnostic use only.
+   * \return true for success else false.
+   */
+  bool cardBegin() {
+    return m_card.begin();
+  }
+  /** Initialize file system for diagnostic use only.
+   * \return true for success else false.
+   */
+  bool fsBegin() {
+    return SdFileSystem::begin();
+  }
+};
+#endif  // ENABLE_USB_MSC_CLASS
+//=============================================================================
 #if ENABLE_SOFTWARE_SPI_CLASS || defined(DOXYGEN)
 /**
  * \class SdFatSoftSpi
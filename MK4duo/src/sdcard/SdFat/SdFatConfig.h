@@ -202,9 +202,21 @@
 #if defined(__MK64FX512__) || defined(__MK66FX1M0__)
 #define ENABLE_SDIO_CLASS 1
 #define ENABLE_SDIOEX_CLASS 1
+#elif defined(SD_SDIO) && (defined(__SAM3X8E__) || defined(__SAM3X8H__)\
+  || defined(STM32F4xx) || defined(STM32F7xx))
+/** MK4duo: SdioSAM3X.cpp and SdioSTM32.cpp */
+#define ENABLE_SDIO_CLASS 1
 #else  // ENABLE_SDIO_CLASS
 #define ENABLE_SDIO_CLASS 0
 #endif  // ENABLE_SDIO_CLASS
+//-----------------------------------------------------------------------------
+/** MK4duo: USB flash drive on the USB host, UsbMscSAM3X.cpp and UsbMscSTM32.cpp */
+#if defined(USB_FLASH_DRIVE_SUPPORT) && (defined(__SAM3X8E__) || defined(__SAM3X8H__)\
+  || defined(ARDUINO_ARCH_STM32))
+#define ENABLE_USB_MSC_CLASS 1
+#else  // ENABLE_USB_MSC_CLASS
+#define ENABLE_USB_MSC_CLASS 0
+#endif  // ENABLE_USB_MSC_CLASS
 //------------------------------------------------------------------------------
 /**
  * Determine the default SPI configuration.
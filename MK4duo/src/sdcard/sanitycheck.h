@@ -36,6 +36,58 @@
   #if DISABLED(SD_FINISHED_RELEASECOMMAND)
     #error "DEPENDENCY ERROR: Missing setting SD_FINISHED_RELEASECOMMAND."
   #endif
+  #if ENABLED(SD_SDIO)
+    #if DISABLED(ARDUINO_ARCH_SAM) && !(ENABLED(ARDUINO_ARCH_STM32) && (ENABLED(STM32F4xx) || ENABLED(STM32F7xx)))
+      #error "DEPENDENCY ERROR: SD_SDIO is only available on SAM3X (Arduino DUE) and STM32 F4 or F7."
+    #elif DISABLED(SD_SDIO_CLOCK) || !WITHIN(SD_SDIO_CLOCK, 400, 50000)
+      #error "DEPENDENCY ERROR: SD_SDIO_CLOCK must be from 400 to 50000 kHz."
+    #elif ENABLED(USB_FLASH_DRIVE_SUPPORT)
+      #error "DEPENDENCY ERROR: SD_SDIO requires SDSUPPORT."
+    #endif
+  #endif
+  #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+    #if DISABLED(ARDUINO_ARCH_SAM) && DISABLED(ARDUINO_ARCH_STM32)
+      #error "DEPENDENCY ERROR: USB_FLASH_DRIVE_SUPPORT is only available on SAM3X (Arduino DUE) and STM32."
+    #elif SERIAL_PORT_1 == -1 || (ENABLED(SERIAL_PORT_2) && SERIAL_PORT_2 == -1)
+      #error "DEPENDENCY ERROR: USB_FLASH_DRIVE_SUPPORT takes the native USB, SERIAL_PORT_1 and SERIAL_PORT_2 must be a UART."
+    #endif
+  #endif
+  #if ENABLED(SD_READ_AHEAD) && !WITHIN(SD_READ_AHEAD_BLOCKS, 2, 64)
+    #error "DEPENDENCY ERROR: SD_READ_AHEAD_BLOCKS must be from 2 to 64."
+  #endif
+  #if ENABLED(SD_DIR_INDEX) && !WITHIN(SD_DIR_INDEX, 16, 1024)
+    #error "DEPENDENCY ERROR: SD_DIR_INDEX must be from 16 to 1024."
+  #endif
+  #if ENABLED(JSON_OUTPUT)
+    #if DISABLED(JSON_SCAN_CACHE)
+      #error "DEPENDENCY ERROR: Missing setting JSON_SCAN_CACHE."
+    #elif !WITHIN(JSON_SCAN_CACHE, 0, 16)
+      #error "DEPENDENCY ERROR: JSON_SCAN_CACHE must be from 0 to 16."
+    #endif
+  #endif
+  #if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_KEYS)
+    #if DISABLED(SDSORT_KEY_LENGTH)
+      #error "DEPENDENCY ERROR: Missing setting SDSORT_KEY_LENGTH."
+    #elif !WITHIN(SDSORT_KEY_LENGTH, 4, 32)
+      #error "DEPENDENCY ERROR: SDSORT_KEY_LENGTH must be from 4 to 32."
+    #endif
+  #endif
+  #if ENABLED(SD_UPLOAD_BLOCKS) && !WITHIN(SD_UPLOAD_BLOCKS, 1, 64)
+    #error "DEPENDENCY ERROR: SD_UPLOAD_BLOCKS must be from 1 to 64."
+  #endif
+  #if ENABLED(SD_WRITE_BEHIND) && !WITHIN(SD_WRITE_BEHIND_BYTES, 64, 4096)
+    #error "DEPENDENCY ERROR: SD_WRITE_BEHIND_BYTES must be from 64 to 4096."
+  #endif
+  #if ENABLED(SD_READ_CONTIGUOUS) && DISABLED(SD_READ_AHEAD)
+    #error "DEPENDENCY ERROR: SD_READ_CONTIGUOUS requires SD_READ_AHEAD."
+  #endif
+  #if ENABLED(SD_READ_LINES) && DISABLED(SD_READ_AHEAD)
+    #error "DEPENDENCY ERROR: SD_READ_LINES requires SD_READ_AHEAD."
+  #endif
+#elif ENABLED(PRINT_TIME_ESTIMATION)
+  #error "DEPENDENCY ERROR: You have to enable SDSUPPORT || USB_FLASH_DRIVE_SUPPORT to use PRINT_TIME_ESTIMATION."
+#elif ENABLED(SD_COMPILED_JOB)
+  #error "DEPENDENCY ERROR: You have to enable SDSUPPORT || USB_FLASH_DRIVE_SUPPORT to use SD_COMPILED_JOB."
 #elif ENABLED(EEPROM_SETTINGS) && ENABLED(EEPROM_SD)
   #error "DEPENDENCY ERROR: You have to enable SDSUPPORT || USB_FLASH_DRIVE_SUPPORT to use EEPROM_SD."
 #endif
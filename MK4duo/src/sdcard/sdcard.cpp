@@ -30,7 +30,7 @@ SDCard card;
 /** Public Parameters */
 flagcard_t  SDCard::flag;
 
-SdFat       SDCard::fat;
+sd_fat_t    SDCard::fat;
 SdFile      SDCard::gcode_file,
             SDCard::root,
             SDCard::workDir,
@@ -41,11 +41,35 @@ int SDCard::autostart_index = -1;
 uint32_t  SDCard::fileSize  = 0,
           SDCard::sdpos     = 0;
 
+#if ENABLED(SD_READ_AHEAD)
+  uint8_t   SDCard::read_ahead_buffer[SD_LINE_PAD + SD_READ_AHEAD_BLOCKS * 512] __attribute__((aligned(4)));
+  uint32_t  SDCard::read_ahead_pos    = 0;
+  uint16_t  SDCard::read_ahead_index  = 0,
+            SDCard::read_ahead_count  = 0;
+  #if ENABLED(SD_READ_CONTIGUOUS)
+    uint32_t SDCard::contiguous_block = 0;
+  #endif
+#endif
+
 float SDCard::objectHeight      = 0.0,
       SDCard::firstlayerHeight  = 0.0,
       SDCard::layerHeight       = 0.0,
       SDCard::filamentNeeded    = 0.0;
 
+#if ENABLED(PRINT_TIME_ESTIMATION)
+  uint32_t SDCard::estimated_time = 0;
+
+  // The printer state before an estimate, restored at its end
+  static struct {
+    xyze_pos_t    position;
+    home_flag_t   home_flag;
+    feedrate_t    feedrate_mm_s;
+    int16_t       feedrate_percentage;
+    uint8_t       axis_relative_modes,
+                  debug_flags;
+  } estimate_saved;
+#endif
+
 char  SDCard::fileName[LONG_FILENAME_LENGTH*SD_MAX_FOLDER_DEPTH+SD_MAX_FOLDER_DEPTH+1],
       SDCard::tempLongFilename[LONG_FILENAME_LENGTH+1],
       SDCard::generatedBy[GENBY_SIZE];
@@ -62,6 +86,39 @@ uint16_t  SDCard::workDirDepth  = 0,
 
 LsActionEnum SDCard::lsAction   = LS_Count;
 
+#if ENABLED(JSON_OUTPUT)
+  SdFile                SDCard::scan_file;
+  GcodeScanEnum         SDCard::scan_phase      = SCAN_IDLE;
+  uint16_t              SDCard::scan_pos        = 0;
+  uint8_t               SDCard::scan_found      = 0;
+  SDCard::gcode_info_t  SDCard::scan_key;
+  #if JSON_SCAN_CACHE > 0
+    SDCard::gcode_info_t  SDCard::info_cache[JSON_SCAN_CACHE];
+    uint8_t               SDCard::info_cache_next = 0;
+  #endif
+#endif
+
+#if ENABLED(SD_WRITE_BEHIND)
+  uint8_t       SDCard::write_pending     = 0;
+  #if HAS_EEPROM_SD
+    uint16_t    SDCard::eeprom_write_pos  = 0;
+  #endif
+#endif
+
+#if ENABLED(SD_UPLOAD_BLOCKS)
+  uint8_t       SDCard::upload_buffer[SD_UPLOAD_BLOCKS * 512] __attribute__((aligned(4)));
+  uint16_t      SDCard::upload_count  = 0,
+                SDCard::upload_crc    = 0;
+  uint32_t      SDCard::upload_block  = 0,
+                SDCard::upload_left   = 0;
+  short_timer_t SDCard::upload_timer;
+#endif
+
+#if ENABLED(SD_DIR_INDEX)
+  SDCard::dir_entry_t SDCard::dir_index[SD_DIR_INDEX];
+  bool                SDCard::dir_index_valid   = false;
+#endif
+
 // Sort files and folders alphabetically.
 #if ENABLED(SDCARD_SORT_ALPHA)
   uint16_t SDCard::sort_count = 0;
@@ -71,8 +128,15 @@ LsActionEnum SDCard::lsAction   = LS_Count;
     //static bool sort_reverse;      // Flag to enable / disable reverse sorting
   #endif
 
+  #if ENABLED(SDSORT_KEYS)
+    SDCard::sort_key_t  SDCard::sort_keys[SDSORT_LIMIT],
+                        SDCard::sort_bound;
+    uint16_t            SDCard::sort_first      = 0,
+                        SDCard::sort_key_count  = 0;
+    bool                SDCard::sort_forward    = true,
+                        SDCard::sort_bounded    = false;
   // By default the sort index is static
-  #if ENABLED(SDSORT_DYNAMIC_RAM)
+  #elif ENABLED(SDSORT_DYNAMIC_RAM)
     uint8_t *SDCard::sort_order;
   #else
     uint8_t SDCard::sort_order[SDSORT_LIMIT];
@@ -107,7 +171,7 @@ LsActionEnum SDCard::lsAction   = LS_Count;
 
 #if ENABLED(ADVANCED_SD_COMMAND)
 
-  Sd2Card   SDCard::sd;
+  sd_card_t SDCard::sd;
 
   uint32_t  SDCard::cardSizeBlocks,
             SDCard::cardCapacityMB;
@@ -141,11 +205,15 @@ void SDCard::mount() {
 
   if (root.isOpen()) root.close();
 
-  if (!fat.begin(SS_PIN, SPI_SPEED)
-    #if ENABLED(LCD_SDSS) && (LCD_SDSS != SS_PIN)
-      && !fat.begin(LCD_SDSS, SPI_SPEED)
-    #endif
-  ) {
+  #if ENABLED(SD_SDIO) || ENABLED(USB_FLASH_DRIVE_SUPPORT)
+    if (!fat.begin()) {
+  #else
+    if (!fat.begin(SS_PIN, SPI_SPEED)
+      #if ENABLED(LCD_SDSS) && (LCD_SDSS != SS_PIN)
+        && !fat.begin(LCD_SDSS, SPI_SPEED)
+      #endif
+    ) {
+  #endif
     SERIAL_LM(ER, MSG_HOST_SD_INIT_FAIL);
     if (fat.card()->errorCode()) {
       SERIAL_MV("SD initialization failed.\n"
@@ -188,7 +256,37 @@ void SDCard::mount() {
   lcdui.refresh();
 }
 
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+
+  // The USB host, and the mount on the plug of the drive
+  void SDCard::usb_task() {
+    static bool was_ready = false;
+    fat.card()->task();
+    const bool ready = fat.card()->isReady();
+    if (ready == was_ready) return;
+    was_ready = ready;
+    if (ready)
+      mount();
+    else if (isMounted()) {
+      if (isPrinting()) setAbortSDprinting(true);
+      unmount();
+    }
+  }
+
+#endif
+
 void SDCard::unmount() {
+  #if ENABLED(SD_WRITE_BEHIND)
+    if (isMounted()) write_behind_flush();
+  #endif
+  dir_index_flush();
+  #if ENABLED(JSON_OUTPUT)
+    scan_file.close();
+    scan_phase = SCAN_IDLE;
+    #if JSON_SCAN_CACHE > 0
+      ZERO(info_cache);   // Another card can have the same clusters
+    #endif
+  #endif
   setMounted(false);
   setPrinting(false);
 }
@@ -212,6 +310,16 @@ void SDCard::getfilename(uint16_t nr, PGM_P const match/*=nullptr*/) {
       return;
     }
   #endif // SDSORT_CACHE_NAMES
+  #if ENABLED(SD_DIR_INDEX)
+    // The entry nr or the first with the name, as lsDive
+    if (!dir_index_valid) dir_index_build();
+    const uint16_t count = MIN(nrFiles, uint16_t(SD_DIR_INDEX));
+    const uint8_t hash = match ? name_hash(match) : 0;
+    for (uint16_t i = 0; i < count; i++) {
+      const bool matched = match != nullptr && dir_index[i].hash == hash;
+      if ((i == nr || matched) && dir_index_name(i) && (i == nr || strcasecmp(match, fileName) == 0)) return;
+    }
+  #endif
   lsAction = LS_GetFilename;
   nrFile_index = nr;
   lsDive(workDir, match);
@@ -255,6 +363,9 @@ void SDCard::openAndPrintFile(const char * const path) {
 void SDCard::stop_print() {
   setPrinting(false);
   if (isFileOpen()) gcode_file.close();
+  #if ENABLED(PRINT_TIME_ESTIMATION)
+    if (planner.time_warp) estimate_done(false);
+  #endif
 }
 
 void SDCard::write_command(char* buf) {
@@ -270,7 +381,20 @@ void SDCard::write_command(char* buf) {
   end[1] = '\r';
   end[2] = '\n';
   end[3] = '\0';
-  gcode_file.write(begin);
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    // In the buffer, written by whole buffers
+    uint16_t len = end + 3 - begin;
+    while (len) {
+      const uint16_t n = MIN(len, uint16_t(sizeof(upload_buffer) - upload_count));
+      memcpy(upload_buffer + upload_count, begin, n);
+      upload_count += n;
+      begin += n;
+      len -= n;
+      if (upload_count == sizeof(upload_buffer) && !upload_flush()) break;
+    }
+  #else
+    gcode_file.write(begin);
+  #endif
   if (gcode_file.getWriteError()) {
     SERIAL_LM(ER, MSG_HOST_SD_ERR_WRITE_TO_FILE);
   }
@@ -289,6 +413,10 @@ void SDCard::startWrite(const char * const path, const bool silent/*=false*/) {
   if (!isMounted()) return;
 
   fat.chdir();
+  dir_index_flush();
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    upload_count = 0;
+  #endif
   if (gcode_file.open(path, FILE_WRITE)) {
     setSaving(true);
     #if ENABLED(EMERGENCY_PARSER)
@@ -306,6 +434,7 @@ void SDCard::deleteFile(const char * const path) {
   if (!isMounted()) return;
   setPrinting(false);
   gcode_file.close();
+  dir_index_flush();
   if (fat.remove(path)) {
     SERIAL_EMT(MSG_HOST_SD_FILE_DELETED, path);
   }
@@ -323,8 +452,12 @@ void SDCard::deleteFile(const char * const path) {
 }
 
 void SDCard::finishWrite() {
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    upload_flush();
+  #endif
   gcode_file.sync();
   gcode_file.close();
+  dir_index_flush();
   setSaving(false);
   SERIAL_EM(MSG_HOST_SD_FILE_SAVED);
 }
@@ -333,6 +466,7 @@ void SDCard::makeDirectory(const char * const path) {
   if (!isMounted()) return;
   setPrinting(false);
   gcode_file.close();
+  dir_index_flush();
   if (fat.mkdir(path)) {
     SERIAL_EM(MSG_HOST_SD_DIRECTORY_CREATED);
   }
@@ -342,6 +476,9 @@ void SDCard::makeDirectory(const char * const path) {
 }
 
 void SDCard::closeFile() {
+  #if ENABLED(SD_UPLOAD_BLOCKS)
+    if (isSaving()) upload_flush();
+  #endif
   gcode_file.sync();
   gcode_file.close();
   setSaving(false);
@@ -355,6 +492,13 @@ void SDCard::printingHasFinished() {
   gcode_file.close();
   setPrinting(false);
 
+  #if ENABLED(PRINT_TIME_ESTIMATION)
+    if (planner.time_warp) {
+      estimate_done(true);
+      return;
+    }
+  #endif
+
   #if HAS_SD_RESTART
     restart.purge_job();
   #endif
@@ -380,6 +524,64 @@ void SDCard::printingHasFinished() {
 
 }
 
+#if ENABLED(PRINT_TIME_ESTIMATION)
+
+  /**
+   * Run a file as a print in simulation, with the moves planned and timed
+   * by the planner time warp, as fast as the file is read and parsed
+   */
+  void SDCard::estimateFile(const char * const path) {
+    if (isPrinting() || print_job_counter.isRunning() || planner.time_warp) {
+      SERIAL_LM(ER, "Print time estimate not possible while printing");
+      return;
+    }
+
+    planner.synchronize();
+    if (!selectFile(path, true)) {
+      openFailed(path);
+      return;
+    }
+
+    estimate_saved.position             = mechanics.position;
+    estimate_saved.home_flag            = mechanics.home_flag;
+    estimate_saved.feedrate_mm_s        = mechanics.feedrate_mm_s;
+    estimate_saved.feedrate_percentage  = mechanics.feedrate_percentage;
+    estimate_saved.axis_relative_modes  = mechanics.axis_relative_modes;
+    estimate_saved.debug_flags          = printer.debug_flag.all;
+
+    // The flag, not setDebugLevel, so the heaters are left as they are
+    printer.debug_flag.simulation = true;
+    planner.time_warp_start();
+
+    estimated_time = 0;
+    SERIAL_LMT(ECHO, "Print time estimate of ", path);
+    startFileprint();
+  }
+
+  void SDCard::estimate_done(const bool report) {
+    const uint32_t time = planner.time_warp_stop();
+
+    printer.debug_flag.all          = estimate_saved.debug_flags;
+    mechanics.home_flag             = estimate_saved.home_flag;
+    mechanics.feedrate_mm_s         = estimate_saved.feedrate_mm_s;
+    mechanics.feedrate_percentage   = estimate_saved.feedrate_percentage;
+    mechanics.axis_relative_modes   = estimate_saved.axis_relative_modes;
+    mechanics.position              = estimate_saved.position;
+    mechanics.sync_plan_position();
+
+    if (report) {
+      estimated_time = time;
+      char buffer[22];
+      duration_t(time).toString(buffer);
+      SERIAL_LMT(ECHO, "Print time estimate: ", buffer);
+      SERIAL_LMV(ECHO, "Print time estimate seconds: ", time);
+    }
+    else
+      SERIAL_LM(ECHO, "Print time estimate aborted");
+  }
+
+#endif // PRINT_TIME_ESTIMATION
+
 void SDCard::chdir(const char * const relpath) {
   SdFile newDir;
   SdFile *parent = workDir.isOpen() ? &workDir : &root;
@@ -389,6 +591,7 @@ void SDCard::chdir(const char * const relpath) {
   }
   else {
     workDir = newDir;
+    dir_index_flush();
     flag.WorkdirIsRoot = false;
     if (workDirDepth < SD_MAX_FOLDER_DEPTH)
       workDirParents[workDirDepth++] = workDir;
@@ -433,6 +636,7 @@ void SDCard::checkautostart() {
 
 void SDCard::setroot() {
   workDir = root;
+  dir_index_flush();
   flag.WorkdirIsRoot = true;
   #if ENABLED(SDCARD_SORT_ALPHA)
     presort();
@@ -471,6 +675,14 @@ bool SDCard::selectFile(const char * const path, const bool silent/*=false*/) {
 
     fileSize = gcode_file.fileSize();
     sdpos = 0;
+    #if ENABLED(SD_READ_AHEAD)
+      read_ahead_reset(0);
+    #endif
+    #if ENABLED(SD_READ_CONTIGUOUS)
+      // One walk of the cluster chain here, none while printing
+      uint32_t end_block;
+      if (!gcode_file.contiguousRange(&contiguous_block, &end_block)) contiguous_block = 0;
+    #endif
 
     if (!silent) {
       SERIAL_MT(MSG_HOST_SD_FILE_OPENED, fname);
@@ -482,7 +694,7 @@ bool SDCard::selectFile(const char * const path, const bool silent/*=false*/) {
     strncpy(fileName, path, strlen(path));
 
     #if ENABLED(JSON_OUTPUT)
-      parsejson(gcode_file);
+      scan_start(path);
     #endif
 
     return true;
@@ -496,6 +708,7 @@ bool SDCard::selectFile(const char * const path, const bool silent/*=false*/) {
 int8_t SDCard::updir() {
   if (workDirDepth > 0) {                                               // At least 1 dir has been saved
     workDir = --workDirDepth ? workDirParents[workDirDepth - 1] : root; // Use parent, or root if none
+    dir_index_flush();
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -505,9 +718,13 @@ int8_t SDCard::updir() {
 }
 
 uint16_t SDCard::getnrfilenames() {
-  lsAction = LS_Count;
-  nrFiles = 0;
-  lsDive(workDir);
+  #if ENABLED(SD_DIR_INDEX)
+    if (!dir_index_valid) dir_index_build();
+  #else
+    lsAction = LS_Count;
+    nrFiles = 0;
+    lsDive(workDir);
+  #endif
   return nrFiles;
 }
 
@@ -529,6 +746,7 @@ uint16_t SDCard::get_num_Files() {
 
     if (!isMounted() || restart.job_file.isOpen()) return;
 
+    if (!read) dir_index_flush();
     if (!restart.job_file.open(fat.vwd(), restart_file_name, read ? O_READ : (O_RDWR | O_CREAT | O_SYNC)))
       openFailed(restart_file_name);
     else if (!read) {
@@ -538,6 +756,7 @@ uint16_t SDCard::get_num_Files() {
 
   void SDCard::delete_restart_file() {
     if (exist_restart_file()) {
+      dir_index_flush();
       restart.job_file.remove(fat.vwd(), restart_file_name);
       if (printer.debugFeature()) {
         DEBUG_SM(DEB, " File restart delete");
@@ -552,6 +771,75 @@ uint16_t SDCard::get_num_Files() {
     return exist;
   }
 
+  #if ENABLED(SD_RESTART_RAW_SLOTS)
+
+    /**
+     * First block of the contiguous restart file, 0 if there is none.
+     * With create a new file is made, with all the blocks cleared.
+     */
+    uint32_t SDCard::restart_raw_block(const bool create) {
+
+      if (!isMounted()) return 0;
+
+      SdFile &job_file = restart.job_file;
+      if (job_file.isOpen()) job_file.close();
+
+      uint32_t bgn_block = 0, end_block = 0;
+      bool ok = job_file.open(fat.vwd(), restart_file_name, O_READ)
+             && job_file.contiguousRange(&bgn_block, &end_block)
+             && end_block - bgn_block + 1 >= SD_RESTART_RAW_SLOTS;
+      job_file.close();
+
+      if (!ok && create) {
+        delete_restart_file();
+        dir_index_flush();
+        ok = job_file.createContiguous(fat.vwd(), restart_file_name, (SD_RESTART_RAW_SLOTS) * 512UL)
+          && job_file.contiguousRange(&bgn_block, &end_block);
+        job_file.close();
+        if (ok) {
+          cache_t * const cache = fat.vol()->cacheClear();
+          ok = cache != nullptr;
+          if (ok) memset(cache->data, 0, sizeof(cache->data));
+          for (uint8_t s = 0; ok && s < SD_RESTART_RAW_SLOTS; s++)
+            ok = fat.card()->writeBlock(bgn_block + s, cache->data);
+        }
+        if (!ok) openFailed(restart_file_name);
+      }
+
+      return ok ? bgn_block : 0;
+    }
+
+  #endif
+
+#endif
+
+#if ENABLED(SD_JOB_QUEUE)
+
+  constexpr char  jobqueue_file_name[9] = "jobqueue",
+                  jobqueue_temp_name[13] = "jobqueue.new";
+
+  bool SDCard::open_jobqueue_file(SdFile &file, const oflag_t oflag, const bool temp/*=false*/) {
+    if (!isMounted() || file.isOpen()) return false;
+    if (oflag != O_READ) dir_index_flush();
+    return file.open(fat.vwd(), temp ? jobqueue_temp_name : jobqueue_file_name, oflag);
+  }
+
+  // The copy written by a remove takes the place of the queue file
+  void SDCard::replace_jobqueue_file() {
+    SdFile file;
+    dir_index_flush();
+    SdFile::remove(fat.vwd(), jobqueue_file_name);
+    if (file.open(fat.vwd(), jobqueue_temp_name, O_RDWR)) {
+      if (!file.rename(fat.vwd(), jobqueue_file_name)) openFailed(jobqueue_file_name);
+      file.close();
+    }
+  }
+
+  void SDCard::delete_jobqueue_file() {
+    dir_index_flush();
+    SdFile::remove(fat.vwd(), jobqueue_file_name);
+  }
+
 #endif
 
 #if HAS_EEPROM_SD
@@ -570,6 +858,12 @@ uint16_t SDCard::get_num_Files() {
       return;
     }
 
+    #if ENABLED(SD_WRITE_BEHIND)
+      write_behind(WB_EEPROM);
+      return;
+    #endif
+
+    dir_index_flush();
     if (!eeprom_file.open(EEPROM_FILE_NAME, O_RDWR | O_CREAT | O_SYNC) ||
         !eeprom_file.seekSet(0) ||
         !eeprom_file.write(memorystore.eeprom_data, EEPROM_SIZE) == EEPROM_SIZE
@@ -580,20 +874,158 @@ uint16_t SDCard::get_num_Files() {
 
 #endif
 
+#if ENABLED(SD_WRITE_BEHIND)
+
+  /**
+   * One step of the pending writes for each call: the restart job,
+   * or SD_WRITE_BEHIND_BYTES of the eeprom.bin, in the same open file.
+   */
+  void SDCard::write_behind_spin() {
+    if (!isMounted()
+      #if ENABLED(SD_UPLOAD_BLOCKS)
+        || isUploading()
+      #endif
+    ) {
+      write_pending = 0;
+      return;
+    }
+
+    #if HAS_SD_RESTART
+      if (write_pending & WB_RESTART) {
+        write_behind_cancel(WB_RESTART);
+        restart.write_job();
+        return;
+      }
+    #endif
+
+    #if HAS_EEPROM_SD
+      if (write_pending & WB_EEPROM) {
+        bool ok = true;
+        if (!eeprom_write_pos) {
+          dir_index_flush();
+          eeprom_file.close();
+          ok = eeprom_file.open(EEPROM_FILE_NAME, O_RDWR | O_CREAT) && eeprom_file.seekSet(0);
+        }
+        const uint16_t n = MIN(uint16_t(SD_WRITE_BEHIND_BYTES), uint16_t(EEPROM_SIZE - eeprom_write_pos));
+        if (ok) ok = eeprom_file.write(memorystore.eeprom_data + eeprom_write_pos, n) == n;
+        eeprom_write_pos += n;
+        if (!ok || eeprom_write_pos >= EEPROM_SIZE) {
+          if (!eeprom_file.close()) ok = false;
+          if (!ok) SERIAL_LM(ER, "Could not write eeprom to sd card");
+          write_behind_cancel(WB_EEPROM);
+          eeprom_write_pos = 0;
+        }
+        return;
+      }
+    #endif
+
+    write_pending = 0;
+  }
+
+#endif
+
 #if ENABLED(SDCARD_SORT_ALPHA)
 
   /**
    * Get the name of a file in the current directory by sort-index
    */
   void SDCard::getfilename_sorted(const uint16_t nr) {
-    getfilename(
-      #if ENABLED(SDSORT_GCODE)
-        sort_alpha &&
-      #endif
-      (nr < sort_count) ? sort_order[nr] : nr
-    );
+    #if ENABLED(SDSORT_KEYS)
+      if (
+        #if ENABLED(SDSORT_GCODE)
+          sort_alpha &&
+        #endif
+        nr < sort_count
+      ) {
+        // Move the window on nr
+        while (nr < sort_first && sort_keys_pass(false)) { /* nada */ }
+        while (nr >= sort_first + sort_key_count && sort_keys_pass(true)) { /* nada */ }
+        if (nr >= sort_first && nr < sort_first + sort_key_count && entry_name(sort_keys[nr - sort_first].pos)) return;
+        flush_presort();  // The folder has changed, unsorted up to the next presort
+      }
+      getfilename(nr);
+    #else
+      getfilename(
+        #if ENABLED(SDSORT_GCODE)
+          sort_alpha &&
+        #endif
+        (nr < sort_count) ? sort_order[nr] : nr
+      );
+    #endif
   }
 
+  #if ENABLED(SDSORT_KEYS)
+
+    /**
+     * Order of two keys as the sort of the names: folders, prefix, then the position
+     */
+    int8_t SDCard::sort_key_cmp(const sort_key_t &a, const sort_key_t &b) {
+      #if HAS_FOLDER_SORTING
+        #if ENABLED(SDSORT_GCODE)
+          const int fs = sort_folders;
+        #else
+          constexpr int fs = FOLDER_SORTING;
+        #endif
+        if (fs && a.dir != b.dir) return (fs > 0) == a.dir ? 1 : -1;
+      #endif
+      const int c = strncasecmp(a.name, b.name, SDSORT_KEY_LENGTH);
+      if (c) return c > 0 ? 1 : -1;
+      return a.pos > b.pos ? 1 : a.pos < b.pos ? -1 : 0;
+    }
+
+    /**
+     * A key of the folder walk, kept if it is in the window of the pass:
+     * the first SDSORT_LIMIT after sort_bound going forward, the last before it going back.
+     */
+    void SDCard::sort_key_add(const sort_key_t &key) {
+      if (sort_bounded) {
+        const int8_t c = sort_key_cmp(key, sort_bound);
+        if (sort_forward ? c <= 0 : c >= 0) return;
+      }
+      uint16_t n = sort_key_count;
+      if (n == SDSORT_LIMIT) {
+        if (sort_forward) {
+          if (sort_key_cmp(key, sort_keys[n - 1]) >= 0) return;
+          n--;                                            // Drop the last
+        }
+        else {
+          if (sort_key_cmp(key, sort_keys[0]) <= 0) return;
+          memmove(&sort_keys[0], &sort_keys[1], --n * sizeof(sort_key_t)); // Drop the first
+        }
+      }
+      // Insertion in the sorted window
+      uint16_t i = n;
+      for (; i > 0 && sort_key_cmp(sort_keys[i - 1], key) > 0; i--) sort_keys[i] = sort_keys[i - 1];
+      sort_keys[i] = key;
+      sort_key_count = n + 1;
+    }
+
+    /**
+     * One walk of workDir for the window after (forward) or before the current one
+     */
+    bool SDCard::sort_keys_pass(const bool forward) {
+      if (forward) {
+        sort_bounded = sort_key_count > 0;
+        if (sort_bounded) sort_bound = sort_keys[sort_key_count - 1];
+        sort_first += sort_key_count;
+      }
+      else {
+        sort_bounded = true;
+        sort_bound = sort_keys[0];
+      }
+      sort_forward = forward;
+      sort_key_count = 0;
+      lsAction = LS_SortKeys;
+      lsDive(workDir);
+      if (!forward) {
+        if (sort_key_count > sort_first) sort_key_count = 0;
+        sort_first -= sort_key_count;
+      }
+      return sort_key_count > 0;
+    }
+
+  #endif // SDSORT_KEYS
+
   /**
    * Read all the files and produce a sort key
    *
@@ -614,6 +1046,13 @@ uint16_t SDCard::get_num_Files() {
 
     // If there are files, sort up to the limit
     uint16_t fileCnt = getnrfilenames();
+
+    #if ENABLED(SDSORT_KEYS)
+      // All the folder is sorted, the first window now
+      sort_first = sort_key_count = 0;
+      if (fileCnt > 0 && sort_keys_pass(true)) sort_count = fileCnt;
+    #else
+
     if (fileCnt > 0) {
 
       // Never sort more than the max allowed
@@ -777,6 +1216,8 @@ uint16_t SDCard::get_num_Files() {
 
       sort_count = fileCnt;
     }
+
+    #endif // !SDSORT_KEYS
   }
 
   void SDCard::flush_presort() {
@@ -796,7 +1237,11 @@ uint16_t SDCard::get_num_Files() {
 
     card.unmount();
 
-    if (!sd.begin(SS_PIN, SPI_SPEED)) {
+    #if ENABLED(SD_SDIO) || ENABLED(USB_FLASH_DRIVE_SUPPORT)
+      if (!sd.begin()) {
+    #else
+      if (!sd.begin(SS_PIN, SPI_SPEED)) {
+    #endif
       SERIAL_LM(ER, "SD initialization failure!");
       return;
     }
@@ -862,10 +1307,325 @@ uint16_t SDCard::get_num_Files() {
 #endif
 
 /** Private Function */
+#if ENABLED(SD_UPLOAD_BLOCKS)
+
+  /**
+   * M28 B<size>: the file is allocated contiguous, then the next size bytes
+   * of the serial go in it by whole blocks, with no FAT or directory update.
+   */
+  void SDCard::startUpload(const char * const path, const uint32_t size) {
+    if (!isMounted()) return;
+
+    fat.chdir();
+    dir_index_flush();
+    gcode_file.close();
+    if (fat.exists(path)) fat.remove(path);
+
+    uint32_t end_block;
+    if (!gcode_file.createContiguous(fat.vwd(), path, size)
+      || !gcode_file.contiguousRange(&upload_block, &end_block)
+      || !fat.vol()->cacheClear()   // No stale copy of the blocks in the cache
+    ) {
+      gcode_file.close();
+      openFailed(path);
+      return;
+    }
+
+    upload_left = size;
+    upload_count = upload_crc = 0;
+    upload_timer.start();
+    #if ENABLED(EMERGENCY_PARSER)
+      emergency_parser.disable();
+    #endif
+    SERIAL_EMT(MSG_HOST_SD_WRITE_TO_FILE, path);
+    lcdui.set_status(path);
+  }
+
+  bool SDCard::upload_put(const uint8_t c) {
+    upload_buffer[upload_count++] = c;
+    upload_timer.start();
+    if (--upload_left && upload_count < sizeof(upload_buffer)) return true;
+
+    if (!upload_flush()) {
+      abortUpload();
+      return false;
+    }
+    if (upload_left) return true;
+
+    gcode_file.close();
+    SERIAL_EMV(MSG_HOST_SD_FILE_SAVED " crc16:", upload_crc);
+    #if ENABLED(EMERGENCY_PARSER)
+      emergency_parser.enable();
+    #endif
+    return true;
+  }
+
+  void SDCard::upload_check_timeout() {
+    if (!upload_timer.expired((SD_UPLOAD_TIMEOUT) * 1000UL)) return;
+    SERIAL_LMV(ER, "Upload timeout, bytes missing:", upload_left);
+    abortUpload();
+  }
+
+  void SDCard::abortUpload() {
+    gcode_file.remove();
+    upload_left = upload_count = 0;
+    upload_block = 0;   // A next M28 writes by the file again
+    #if ENABLED(EMERGENCY_PARSER)
+      emergency_parser.enable();
+    #endif
+  }
+
+  /**
+   * Write the buffer: raw blocks for a binary upload, else one
+   * FatFile::write() that moves the whole blocks with a multi block write
+   */
+  bool SDCard::upload_flush() {
+    if (!upload_count) return true;
+    bool ok;
+    if (upload_block) {
+      crc16(&upload_crc, upload_buffer, upload_count);
+      const uint8_t blocks = (upload_count + 511) >> 9;
+      memset(upload_buffer + upload_count, 0, blocks * 512 - upload_count);
+      ok = fat.card()->writeBlocks(upload_block, upload_buffer, blocks);
+      upload_block = upload_left ? upload_block + blocks : 0;
+    }
+    else
+      ok = gcode_file.write(upload_buffer, upload_count) == upload_count;
+    upload_count = 0;
+    if (!ok) SERIAL_LM(ER, MSG_HOST_SD_ERR_WRITE_TO_FILE);
+    return ok;
+  }
+
+#endif
+
 void SDCard::openFailed(const char * const path) {
   SERIAL_LMT(ER, MSG_HOST_SD_OPEN_FILE_FAIL, path);
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Refill the read ahead buffer from the current position of gcode_file.
+   * After a seek the first read stops at a block boundary, so all the
+   * following ones are whole aligned blocks and FatFile::read() moves
+   * them with a multi block read straight into the buffer.
+   */
+  bool SDCard::read_ahead() {
+    read_ahead_pos += read_ahead_count;
+    read_ahead_index = 0;
+    #if ENABLED(SD_READ_CONTIGUOUS)
+      // A contiguous file at a block boundary, one multi block read from the card
+      if (contiguous_block && !(read_ahead_pos & 0x1FF)) {
+        read_ahead_count = 0;
+        if (read_ahead_pos >= fileSize) return false;
+        const uint32_t left = fileSize - read_ahead_pos;
+        const uint8_t blocks = MIN(uint32_t(SD_READ_AHEAD_BLOCKS), (left + 511) >> 9);
+        if (!fat.card()->readBlocks(contiguous_block + (read_ahead_pos >> 9), read_ahead_data, blocks)) return false;
+        read_ahead_count = MIN(left, uint32_t(blocks) * 512);
+        return true;
+      }
+    #endif
+    const int n = gcode_file.read(read_ahead_data, SD_READ_AHEAD_BLOCKS * 512 - (read_ahead_pos & 0x1FF));
+    read_ahead_count = n > 0 ? n : 0;
+    return read_ahead_count > 0;
+  }
+
+#endif
+
+#if ENABLED(SD_READ_LINES)
+
+  /**
+   * Get the next command of the printed file, terminated in place in the buffer.
+   * A command ends at '\n' '\r', or at '#' ':' outside a comment, the terminator goes in term
+   * and sdpos is left on it, as get() does. From ';' to the end of the line is skipped and
+   * text beyond MAX_CMD_SIZE - 1 is dropped. A line cut by the end of the buffer is moved
+   * in the room ahead of the blocks before the refill.
+   * At the end of the file return the last text, with term 0, or nullptr on a read error.
+   */
+  char* SDCard::get_line(char &term) {
+
+    uint8_t *start = read_ahead_data + read_ahead_index,
+            *cut = nullptr;   // Start of the comment, if any
+    bool full = false;        // Text dropped by a refill, as get_sdcard() a ';' from there is not a comment
+
+    for (;;) {
+
+      uint8_t *p = read_ahead_data + read_ahead_index;
+      const uint8_t * const end = read_ahead_data + read_ahead_count;
+
+      for (; p < end; p++) {
+        const char c = *p;
+        if (c == '\n' || c == '\r') break;
+        if (cut) continue;
+        if (c == '#' || c == ':') break;
+        if (c == ';' && !full && p - start < MAX_CMD_SIZE - 1) cut = p;
+      }
+
+      if (p < end) {
+        term = *p;
+        read_ahead_index = p - read_ahead_data + 1;
+        sdpos = read_ahead_pos + (p - read_ahead_data);
+        if (!cut) cut = p;
+        if (cut - start > MAX_CMD_SIZE - 1) cut = start + MAX_CMD_SIZE - 1;
+        *cut = '\0';
+        return (char*)start;
+      }
+
+      // Move the text of the line just ahead of the blocks, then refill
+      const bool comment = cut != nullptr;
+      const uint16_t len = MIN((comment ? cut : end) - start, MAX_CMD_SIZE - 1);
+      if (!comment && end - start > MAX_CMD_SIZE - 1) full = true;
+      memmove(read_ahead_data - len, start, len);
+      start = read_ahead_data - len;
+      cut = comment ? read_ahead_data : nullptr;
+
+      if (!read_ahead()) {
+        sdpos = read_ahead_pos;
+        if (!eof()) return nullptr;
+        term = '\0';
+        *read_ahead_data = '\0';
+        return (char*)start;
+      }
+    }
+  }
+
+#endif
+
+#if ENABLED(SD_COMPILED_JOB)
+
+  /**
+   * Read the rest of a compact command of a compiled job, the sync byte was just read.
+   * The record goes in cmd as the queue keeps it and sdpos is left on its last byte.
+   * Return false on a read error or a bad code.
+   */
+  bool SDCard::get_compact(char * const cmd) {
+    cmd[0] = BINARY_GCODE_SYNC;
+    int16_t n = get();
+    if (!WITHIN(n, 0, BINARY_GCODE_MAX_CODE)) return false;
+    cmd[1] = n;
+    if ((n = get()) < 0) return false;
+    cmd[2] = n;
+    const uint8_t size = BinaryGcode::compact_size(n);
+    for (uint8_t i = 3; i < size; i++) {
+      if ((n = get()) < 0) return false;
+      cmd[i] = n;
+    }
+    return true;
+  }
+
+#endif
+
+#if ENABLED(ABL_PRINT_AREA)
+
+  typedef struct {
+    float x, y, z, e, layer_z;
+    bool  relative, relative_e, found;
+    xy_pos_t lf, rb;
+  } area_scan_t;
+
+  static bool area_scan_value(const char * const line, const char code, float &value) {
+    for (const char *p = line; *p; p++)
+      if (*p == code && (p == line || p[-1] == ' ')) {
+        value = strtof(p + 1, nullptr);
+        return true;
+      }
+    return false;
+  }
+
+  static void area_scan_add(area_scan_t &s, const float x, const float y) {
+    if (!s.found) { s.lf.set(x, y); s.rb.set(x, y); s.found = true; return; }
+    NOMORE(s.lf.x, x); NOMORE(s.lf.y, y);
+    NOLESS(s.rb.x, x); NOLESS(s.rb.y, y);
+  }
+
+  // Return true at the first extrusion over the first layer
+  static bool area_scan_line(area_scan_t &s, const char *line) {
+    while (*line == ' ') line++;
+    if (*line == 'N') { while (*line && *line != ' ') line++; while (*line == ' ') line++; }
+
+    const char code = *line;
+    if (code != 'G' && code != 'M') return false;
+    const int num = atoi(line + 1);
+
+    if (code == 'M') {
+      if (num == 82) s.relative_e = false;
+      else if (num == 83) s.relative_e = true;
+      return false;
+    }
+
+    float v;
+    switch (num) {
+      case 90: s.relative = s.relative_e = false; break;
+      case 91: s.relative = s.relative_e = true; break;
+      case 92: if (area_scan_value(line, 'E', v)) s.e = v; break;
+      case 0: case 1: case 2: case 3: {
+        float x = s.x, y = s.y, z = s.z;
+        if (area_scan_value(line, 'X', v)) x = s.relative ? x + v : v;
+        if (area_scan_value(line, 'Y', v)) y = s.relative ? y + v : v;
+        if (area_scan_value(line, 'Z', v)) z = s.relative ? z + v : v;
+        bool extrude = false;
+        if (area_scan_value(line, 'E', v)) {
+          extrude = s.relative_e ? v > 0 : v > s.e;
+          if (!s.relative_e) s.e = v;
+        }
+        if (extrude && num && !isnan(x) && !isnan(y) && !isnan(z)) {
+          if (isnan(s.layer_z)) s.layer_z = z;
+          else if (z > s.layer_z + 0.01f) return true;
+          if (!isnan(s.x) && !isnan(s.y)) area_scan_add(s, s.x, s.y);
+          area_scan_add(s, x, y);
+        }
+        s.x = x; s.y = y; s.z = z;
+      } break;
+    }
+    return false;
+  }
+
+  /**
+   * The XY area of the extrusions of the first layer ahead of the print position,
+   * the arcs by their end points. The scan stops at the first extrusion over the
+   * first layer or after ABL_PRINT_AREA_SCAN bytes, the file position is restored.
+   * Return false if no extrusion is found.
+   */
+  bool SDCard::first_layer_area(xy_pos_t &lf, xy_pos_t &rb) {
+    if (!isFileOpen()) return false;
+
+    const uint32_t saved_pos = gcode_file.curPosition();
+    if (!gcode_file.seekSet(sdpos)) return false;
+
+    area_scan_t s;
+    s.x = s.y = s.z = s.layer_z = NAN;
+    s.e = 0;
+    s.relative = s.relative_e = s.found = false;
+
+    char buf[64], line[96];
+    uint8_t len = 0;
+    bool comment = false, done = false;
+
+    for (uint32_t scanned = 0; !done && scanned < ABL_PRINT_AREA_SCAN;) {
+      const int16_t n = gcode_file.read(buf, sizeof(buf));
+      if (n <= 0) break;
+      scanned += n;
+      for (int16_t i = 0; i < n && !done; i++) {
+        const char c = buf[i];
+        if (c == '\n' || c == '\r') {
+          line[len] = '\0';
+          if (len) done = area_scan_line(s, line);
+          len = 0;
+          comment = false;
+        }
+        else if (c == ';') comment = true;
+        else if (!comment && len < sizeof(line) - 1) line[len++] = c;
+      }
+    }
+
+    gcode_file.seekSet(saved_pos);
+
+    if (s.found) { lf = s.lf; rb = s.rb; }
+    return s.found;
+  }
+
+#endif
+
 /**
  * Dive into a folder and recurse depth-first to perform a pre-set operation lsAction:
  *   LS_Count       - Add +1 to nrFiles for every file within the parent
@@ -875,10 +1635,15 @@ void SDCard::lsDive(SdFile parent, PGM_P const match/*=NULL*/) {
   //dir_t* p = NULL;
   SdFile file;
   parent.rewind();
-  uint8_t cnt = 0;
+  uint16_t cnt = 0;
 
   // Read the next entry from a directory
-  while (file.openNext(&parent, O_READ)) {
+  for (;;) {
+    #if ENABLED(SD_DIR_INDEX) || (ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_KEYS))
+      const uint32_t entry_pos = parent.curPosition();
+    #endif
+    if (!file.openNext(&parent, O_READ)) break;
+
     file.getName(tempLongFilename, LONG_FILENAME_LENGTH);
 
     if (workDirDepth >= SD_MAX_FOLDER_DEPTH && strcmp(tempLongFilename, "..") == 0) {
@@ -916,11 +1681,77 @@ void SDCard::lsDive(SdFile parent, PGM_P const match/*=NULL*/) {
         cnt++;
         file.close();
         break;
+      #if ENABLED(SD_DIR_INDEX)
+        case LS_Index:
+          if (nrFiles < SD_DIR_INDEX) {
+            dir_index[nrFiles].pos = entry_pos >> 5;
+            dir_index[nrFiles].hash = name_hash(tempLongFilename);
+          }
+          nrFiles++;
+          file.close();
+          break;
+      #endif
+      #if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_KEYS)
+        case LS_SortKeys: {
+          sort_key_t key;
+          strncpy(key.name, tempLongFilename, SDSORT_KEY_LENGTH);
+          key.pos = entry_pos >> 5;
+          key.dir = file.isSubDir();
+          sort_key_add(key);
+          file.close();
+        } break;
+      #endif
+      default: break;
     }
 
   } // while readDir
 }
 
+#if ENABLED(SD_DIR_INDEX)
+
+  uint8_t SDCard::name_hash(const char *name) {
+    uint8_t hash = 0;
+    while (*name) hash = hash * 31 + tolower(*name++);
+    return hash;
+  }
+
+  /**
+   * One walk of workDir for the count, the positions and the name hashes
+   */
+  void SDCard::dir_index_build() {
+    lsAction = LS_Index;
+    nrFiles = 0;
+    lsDive(workDir);
+    dir_index_valid = true;
+  }
+
+  /**
+   * The name of the entry i of the index in fileName, from one entry read
+   */
+  bool SDCard::dir_index_name(const uint16_t i) {
+    if (entry_name(dir_index[i].pos)) return true;
+    dir_index_valid = false;
+    return false;
+  }
+
+#endif
+
+#if ENABLED(SD_DIR_INDEX) || (ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_KEYS))
+
+  /**
+   * The name of the entry at pos (position in workDir / 32) in fileName
+   */
+  bool SDCard::entry_name(const uint16_t pos) {
+    SdFile dir = workDir, file;
+    if (!dir.seekSet(uint32_t(pos) << 5) || !file.openNext(&dir, O_READ)) return false;
+    file.getName(fileName, LONG_FILENAME_LENGTH);
+    setFilenameIsDir(file.isSubDir());
+    file.close();
+    return true;
+  }
+
+#endif
+
 // --------------------------------------------------------------- //
 // Code that gets gcode information is adapted from RepRapFirmware //
 // Originally licenced under GPL                                   //
@@ -928,16 +1759,13 @@ void SDCard::lsDive(SdFile parent, PGM_P const match/*=NULL*/) {
 // Source: https://github.com/dcnewman/RepRapFirmware              //
 // Copy date: 27 FEB 2016                                          //
 // --------------------------------------------------------------- //
-void SDCard::parsejson(SdFile &parser_file) {
-  fileSize = parser_file.fileSize();
-  filamentNeeded    = 0.0;
-  objectHeight      = 0.0;
-  firstlayerHeight  = 0.0;
-  layerHeight       = 0.0;
-
-  if (!parser_file.isOpen()) return;
+#if ENABLED(JSON_OUTPUT)
 
-  bool genByFound = false, firstlayerHeightFound = false, layerHeightFound = false, filamentNeedFound = false;
+  #define SCAN_GENBY        _BV(0)
+  #define SCAN_FIRST_LAYER  _BV(1)
+  #define SCAN_LAYER        _BV(2)
+  #define SCAN_FILAMENT     _BV(3)
+  #define SCAN_HEADER       (SCAN_GENBY | SCAN_LAYER | SCAN_FILAMENT)
 
   #if ENABLED(__AVR__)
     #define GCI_BUF_SIZE 120
@@ -945,38 +1773,104 @@ void SDCard::parsejson(SdFile &parser_file) {
     #define GCI_BUF_SIZE 1024
   #endif
 
-  // READ 4KB FROM THE BEGINNING
-  char buf[GCI_BUF_SIZE];
-  for (int i = 0; i < 4096; i += GCI_BUF_SIZE - 50) {
-    if(!parser_file.seekSet(i)) break;
-    parser_file.read(buf, GCI_BUF_SIZE);
-    if (!genByFound && findGeneratedBy(buf, generatedBy)) genByFound = true;
-    if (!firstlayerHeightFound && findFirstLayerHeight(buf, firstlayerHeight)) firstlayerHeightFound = true;
-    if (!layerHeightFound && findLayerHeight(buf, layerHeight)) layerHeightFound = true;
-    if (!filamentNeedFound && findFilamentNeed(buf, filamentNeeded)) filamentNeedFound = true;
-    if(genByFound && layerHeightFound && filamentNeedFound) goto get_objectHeight;
-  }
-
-  // READ 4KB FROM END
-  for (int i = 0; i < 4096; i += GCI_BUF_SIZE - 50) {
-    if(!parser_file.seekEnd(-4096 + i)) break;
-    parser_file.read(buf, GCI_BUF_SIZE);
-    if (!genByFound && findGeneratedBy(buf, generatedBy)) genByFound = true;
-    if (!firstlayerHeightFound && findFirstLayerHeight(buf, firstlayerHeight)) firstlayerHeightFound = true;
-    if (!layerHeightFound && findLayerHeight(buf, layerHeight)) layerHeightFound = true;
-    if (!filamentNeedFound && findFilamentNeed(buf, filamentNeeded)) filamentNeedFound = true;
-    if(genByFound && layerHeightFound && filamentNeedFound) goto get_objectHeight;
-  }
-
-  get_objectHeight:
-  // MOVE FROM END UP IN 1KB BLOCKS UP TO 30KB
-  for (int i = GCI_BUF_SIZE; i < 30000; i += GCI_BUF_SIZE - 50) {
-    if(!parser_file.seekEnd(-i)) break;
-    parser_file.read(buf, GCI_BUF_SIZE);
-    if (findTotalHeight(buf, objectHeight)) break;
-  }
-  parser_file.rewind();
-}
+  /**
+   * The gcode info of the selected file, from the cache or with a scan in idle time
+   */
+  void SDCard::scan_start(const char * const path) {
+    scan_file.close();
+    scan_phase        = SCAN_IDLE;
+    filamentNeeded    = 0.0;
+    objectHeight      = 0.0;
+    firstlayerHeight  = 0.0;
+    layerHeight       = 0.0;
+    strcpy_P(generatedBy, PSTR("Unknown"));
+
+    dir_t entry;
+    if (!fileSize || !gcode_file.dirEntry(&entry)) return;
+    scan_key.cluster  = uint32_t(entry.firstClusterHigh) << 16 | entry.firstClusterLow;
+    scan_key.size     = fileSize;
+    scan_key.date     = uint32_t(entry.lastWriteDate) << 16 | entry.lastWriteTime;
+
+    #if JSON_SCAN_CACHE > 0
+      for (uint8_t i = 0; i < JSON_SCAN_CACHE; i++) {
+        const gcode_info_t &info = info_cache[i];
+        if (info.cluster == scan_key.cluster && info.size == scan_key.size && info.date == scan_key.date) {
+          objectHeight      = info.objectHeight;
+          firstlayerHeight  = info.firstlayerHeight;
+          layerHeight       = info.layerHeight;
+          filamentNeeded    = info.filamentNeeded;
+          strcpy(generatedBy, info.generatedBy);
+          return;
+        }
+      }
+    #endif
+
+    if (!scan_file.open(&workDir, path, O_READ)) return;
+    scan_phase = SCAN_HEAD;
+    scan_pos = 0;
+    scan_found = 0;
+  }
+
+  /**
+   * One block of the scan: 4KB from the beginning, 4KB from the end,
+   * then up from the end in 1KB blocks up to 30KB for the height.
+   */
+  void SDCard::scan_spin() {
+    char buf[GCI_BUF_SIZE];
+    bool read = false;
+
+    switch (scan_phase) {
+      case SCAN_HEAD:
+      case SCAN_TAIL:
+        read = scan_pos < 4096 && (scan_phase == SCAN_HEAD ? scan_file.seekSet(scan_pos) : scan_file.seekEnd(-4096 + int32_t(scan_pos)));
+        if (read && scan_file.read(buf, GCI_BUF_SIZE - 1) > 0) {
+          buf[GCI_BUF_SIZE - 1] = '\0';
+          if (!(scan_found & SCAN_GENBY) && findGeneratedBy(buf, generatedBy)) scan_found |= SCAN_GENBY;
+          if (!(scan_found & SCAN_FIRST_LAYER) && findFirstLayerHeight(buf, firstlayerHeight)) scan_found |= SCAN_FIRST_LAYER;
+          if (!(scan_found & SCAN_LAYER) && findLayerHeight(buf, layerHeight)) scan_found |= SCAN_LAYER;
+          if (!(scan_found & SCAN_FILAMENT) && findFilamentNeed(buf, filamentNeeded)) scan_found |= SCAN_FILAMENT;
+          scan_pos += GCI_BUF_SIZE - 50;
+          if ((scan_found & SCAN_HEADER) != SCAN_HEADER) break;
+        }
+        else if (scan_phase == SCAN_HEAD) {
+          scan_phase = SCAN_TAIL;
+          scan_pos = 0;
+          break;
+        }
+        scan_phase = SCAN_HEIGHT;
+        scan_pos = GCI_BUF_SIZE;
+        break;
+
+      case SCAN_HEIGHT:
+        read = scan_pos < 30000 && scan_file.seekEnd(-int32_t(scan_pos));
+        if (read && scan_file.read(buf, GCI_BUF_SIZE - 1) > 0) {
+          buf[GCI_BUF_SIZE - 1] = '\0';
+          scan_pos += GCI_BUF_SIZE - 50;
+          if (!findTotalHeight(buf, objectHeight)) break;
+        }
+        scan_end();
+        break;
+
+      default: break;
+    }
+  }
+
+  void SDCard::scan_end() {
+    scan_file.close();
+    scan_phase = SCAN_IDLE;
+    #if JSON_SCAN_CACHE > 0
+      gcode_info_t &info = info_cache[info_cache_next];
+      info = scan_key;
+      info.objectHeight     = objectHeight;
+      info.firstlayerHeight = firstlayerHeight;
+      info.layerHeight      = layerHeight;
+      info.filamentNeeded   = filamentNeeded;
+      strcpy(info.generatedBy, generatedBy);
+      if (++info_cache_next >= JSON_SCAN_CACHE) info_cache_next = 0;
+    #endif
+  }
+
+#endif // JSON_OUTPUT
 
 bool SDCard::findGeneratedBy(char* buf, char* genBy) {
   // Slic3r & S3D
@@ -25,6 +25,17 @@
 
 #include "SdFat/SdFat.h"
 
+#if ENABLED(SD_SDIO)
+  typedef SdFatSdio sd_fat_t;
+  typedef SdioCard  sd_card_t;
+#elif ENABLED(USB_FLASH_DRIVE_SUPPORT)
+  typedef SdFatUsb  sd_fat_t;
+  typedef UsbMscCard sd_card_t;
+#else
+  typedef SdFat     sd_fat_t;
+  typedef Sd2Card   sd_card_t;
+#endif
+
 union flagcard_t {
   uint8_t all;
   struct {
@@ -50,7 +61,7 @@ class SDCard {
 
     static flagcard_t flag;
 
-    static SdFat      fat;
+    static sd_fat_t   fat;
     static SdFile     gcode_file,
                       root,
                       workDir,
@@ -66,6 +77,10 @@ class SDCard {
                   layerHeight,
                   filamentNeeded;
 
+    #if ENABLED(PRINT_TIME_ESTIMATION)
+      static uint32_t estimated_time;   // Seconds of the last estimated file, 0 = none
+    #endif
+
     static char fileName[LONG_FILENAME_LENGTH*SD_MAX_FOLDER_DEPTH+SD_MAX_FOLDER_DEPTH+1],
                 tempLongFilename[LONG_FILENAME_LENGTH+1],
                 generatedBy[GENBY_SIZE];
@@ -74,6 +89,58 @@ class SDCard {
 
     static uint16_t nrFile_index;
 
+    #if ENABLED(SD_READ_AHEAD)
+      // With SD_READ_LINES the blocks are preceded by room for the start of a line cut by the refill
+      #if ENABLED(SD_READ_LINES)
+        #define SD_LINE_PAD ((MAX_CMD_SIZE + 3) & ~3)
+      #else
+        #define SD_LINE_PAD 0
+      #endif
+      #define read_ahead_data (read_ahead_buffer + SD_LINE_PAD)
+      // Next blocks of gcode_file, read_ahead_pos is the file position of the first byte
+      static uint8_t  read_ahead_buffer[SD_LINE_PAD + SD_READ_AHEAD_BLOCKS * 512];
+      static uint32_t read_ahead_pos;
+      static uint16_t read_ahead_index,
+                      read_ahead_count;
+      #if ENABLED(SD_READ_CONTIGUOUS)
+        static uint32_t contiguous_block;   // First block of a contiguous gcode_file, 0 = not contiguous
+      #endif
+    #endif
+
+    #if ENABLED(JSON_OUTPUT)
+      // The gcode info of a file, keyed by first cluster, size and date of the entry
+      struct gcode_info_t {
+        uint32_t  cluster, size, date;
+        float     objectHeight, firstlayerHeight, layerHeight, filamentNeeded;
+        char      generatedBy[GENBY_SIZE];
+      };
+      static SdFile         scan_file;        // Own handle, the print can read gcode_file meanwhile
+      static GcodeScanEnum  scan_phase;
+      static uint16_t       scan_pos;
+      static uint8_t        scan_found;       // Bits of the info found
+      static gcode_info_t   scan_key;
+      #if JSON_SCAN_CACHE > 0
+        static gcode_info_t info_cache[JSON_SCAN_CACHE];
+        static uint8_t      info_cache_next;
+      #endif
+    #endif
+
+    #if ENABLED(SD_WRITE_BEHIND)
+      static uint8_t      write_pending;    // WriteBehindEnum bits
+      #if HAS_EEPROM_SD
+        static uint16_t   eeprom_write_pos;
+      #endif
+    #endif
+
+    #if ENABLED(SD_UPLOAD_BLOCKS)
+      static uint8_t      upload_buffer[SD_UPLOAD_BLOCKS * 512];
+      static uint16_t     upload_count,   // Bytes in the buffer
+                          upload_crc;     // crc16 of a binary upload
+      static uint32_t     upload_block,   // Next block of a binary upload, in its contiguous file
+                          upload_left;    // Bytes still to get of a binary upload
+      static short_timer_t upload_timer;
+    #endif
+
     #if HAS_EEPROM_SD
       #define EEPROM_FILE_NAME "eeprom.bin"
       static SdFile eeprom_file;
@@ -83,6 +150,15 @@ class SDCard {
                         nrFiles;          // counter for the files in the current directory and recycled as position counter for getting the nrFiles'th name in the directory.
     static LsActionEnum lsAction;         // stored for recursion.
 
+    #if ENABLED(SD_DIR_INDEX)
+      struct dir_entry_t {
+        uint16_t  pos;                    // Position in workDir / 32 of the entry
+        uint8_t   hash;                   // Hash of the name, no case
+      };
+      static dir_entry_t  dir_index[SD_DIR_INDEX];
+      static bool         dir_index_valid;
+    #endif
+
     // Sort files and folders alphabetically.
     #if ENABLED(SDCARD_SORT_ALPHA)
       static uint16_t sort_count;         // Count of sorted items in the current directory
@@ -92,8 +168,20 @@ class SDCard {
         //static bool sort_reverse;       // Flag to enable / disable reverse sorting
       #endif
 
+      #if ENABLED(SDSORT_KEYS)
+        struct sort_key_t {
+          char      name[SDSORT_KEY_LENGTH];  // Prefix of the name, not terminated when full
+          uint16_t  pos;                      // Position in workDir / 32 of the entry
+          bool      dir;
+        };
+        static sort_key_t sort_keys[SDSORT_LIMIT],  // The window of the sorted list
+                          sort_bound;               // The pass takes only the keys after (or before) this
+        static uint16_t   sort_first,               // Sorted position of sort_keys[0]
+                          sort_key_count;
+        static bool       sort_forward,
+                          sort_bounded;
       // By default the sort index is static
-      #if ENABLED(SDSORT_DYNAMIC_RAM)
+      #elif ENABLED(SDSORT_DYNAMIC_RAM)
         static uint8_t *sort_order;
       #else
         static uint8_t sort_order[SDSORT_LIMIT];
@@ -134,7 +222,7 @@ class SDCard {
 
     #if ENABLED(ADVANCED_SD_COMMAND)
 
-      static Sd2Card  sd;
+      static sd_card_t sd;
 
       static uint32_t cardSizeBlocks,
                       cardCapacityMB;
@@ -184,6 +272,24 @@ class SDCard {
     static void makeDirectory(const char * const path);
     static void closeFile();
     static void printingHasFinished();
+
+    #if ENABLED(PRINT_TIME_ESTIMATION)
+      static void estimateFile(const char * const path);
+      static void estimate_done(const bool report);
+    #endif
+
+    #if ENABLED(SD_UPLOAD_BLOCKS)
+      static void startUpload(const char * const path, const uint32_t size);
+      static bool upload_put(const uint8_t c);  // false if the upload failed, the file is removed
+      static void upload_check_timeout();
+      static void abortUpload();
+      static inline bool isUploading() { return upload_left > 0; }
+      static inline uint16_t upload_checksum() { return upload_crc; }
+    #endif
+
+    #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+      static void usb_task();
+    #endif
     static void chdir(const char * const relpath);
     static void reset_default();
     static void beginautostart();
@@ -203,6 +309,15 @@ class SDCard {
       static void open_restart_file(const bool read);
       static void delete_restart_file();
       static bool exist_restart_file();
+      #if ENABLED(SD_RESTART_RAW_SLOTS)
+        static uint32_t restart_raw_block(const bool create);
+      #endif
+    #endif
+
+    #if ENABLED(SD_JOB_QUEUE)
+      static bool open_jobqueue_file(SdFile &file, const oflag_t oflag, const bool temp=false);
+      static void replace_jobqueue_file();
+      static void delete_jobqueue_file();
     #endif
 
     #if HAS_EEPROM_SD
@@ -210,6 +325,24 @@ class SDCard {
       static void write_eeprom();
     #endif
 
+    #if ENABLED(JSON_OUTPUT)
+      static inline bool scan_pending() { return scan_phase != SCAN_IDLE; }
+      static void scan_spin();
+    #endif
+
+    #if ENABLED(SD_WRITE_BEHIND)
+      static inline void write_behind(const WriteBehindEnum job) {
+        #if HAS_EEPROM_SD
+          if (job == WB_EEPROM) eeprom_write_pos = 0;  // From the start with the new data
+        #endif
+        write_pending |= job;
+      }
+      static inline void write_behind_cancel(const WriteBehindEnum job) { write_pending &= ~job; }
+      static inline bool write_behind_pending() { return write_pending; }
+      static void write_behind_spin();
+      static inline void write_behind_flush() { while (write_pending) write_behind_spin(); }
+    #endif
+
     #if ENABLED(SDCARD_SORT_ALPHA)
       static void presort();
       static void getfilename_sorted(const uint16_t nr);
@@ -249,15 +382,48 @@ class SDCard {
     static inline void pauseSDPrint() { setPrinting(false); }
     static inline bool isFileOpen()   { return isMounted() && gcode_file.isOpen(); }
     static inline bool isPaused()     { return isFileOpen() && !isPrinting(); }
-    static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); }
     static inline uint32_t getIndex() { return sdpos; }
     static inline bool eof() { return sdpos >= fileSize; }
-    static inline int16_t get() { sdpos = gcode_file.curPosition(); return (int16_t)gcode_file.read(); }
+    #if ENABLED(SD_READ_AHEAD)
+      static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); read_ahead_reset(sdpos); }
+      static inline int16_t get() {
+        if (read_ahead_index >= read_ahead_count && !read_ahead()) {
+          sdpos = read_ahead_pos;
+          return -1;
+        }
+        sdpos = read_ahead_pos + read_ahead_index;
+        return read_ahead_data[read_ahead_index++];
+      }
+      static inline int16_t peek() {
+        if (read_ahead_index >= read_ahead_count && !read_ahead()) return -1;
+        return read_ahead_data[read_ahead_index];
+      }
+      // The bytes read from the card and not taken by get() yet
+      static inline const char* read_ahead_unread(uint16_t &count) {
+        count = read_ahead_count - read_ahead_index;
+        return (const char*)(read_ahead_data + read_ahead_index);
+      }
+    #else
+      static inline void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); }
+      static inline int16_t get() { sdpos = gcode_file.curPosition(); return (int16_t)gcode_file.read(); }
+    #endif
     static inline uint8_t percentDone() { return (isFileOpen() && fileSize) ? sdpos / ((fileSize + 99) / 100) : 0; }
     static inline void getWorkDirName() { workDir.getName(fileName, LONG_FILENAME_LENGTH); }
     static inline size_t read(void* buf, uint16_t nbyte) { return gcode_file.isOpen() ? gcode_file.read(buf, nbyte) : -1; }
     static inline size_t write(void* buf, uint16_t nbyte) { return gcode_file.isOpen() ? gcode_file.write(buf, nbyte) : -1; }
 
+    #if ENABLED(SD_READ_LINES)
+      static char* get_line(char &term);
+    #endif
+
+    #if ENABLED(SD_COMPILED_JOB)
+      static bool get_compact(char * const cmd);
+    #endif
+
+    #if ENABLED(ABL_PRINT_AREA)
+      static bool first_layer_area(xy_pos_t &lf, xy_pos_t &rb);
+    #endif
+
     #if ENABLED(ADVANCED_SD_COMMAND)
       // Format SD Card
       static void formatSD();
@@ -269,8 +435,40 @@ class SDCard {
 
     static void openFailed(const char * const path);
 
+    #if ENABLED(SD_READ_AHEAD)
+      static bool read_ahead();
+      static inline void read_ahead_reset(const uint32_t pos) { read_ahead_pos = pos; read_ahead_index = read_ahead_count = 0; }
+    #endif
+
     static void lsDive(SdFile parent, PGM_P const match = NULL);
-    static void parsejson(SdFile &parser_file);
+
+    #if ENABLED(SD_UPLOAD_BLOCKS)
+      static bool upload_flush();
+    #endif
+
+    static inline void dir_index_flush() {
+      #if ENABLED(SD_DIR_INDEX)
+        dir_index_valid = false;
+      #endif
+    }
+
+    #if ENABLED(SD_DIR_INDEX) || (ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_KEYS))
+      static bool entry_name(const uint16_t pos);
+    #endif
+    #if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_KEYS)
+      static int8_t sort_key_cmp(const sort_key_t &a, const sort_key_t &b);
+      static void sort_key_add(const sort_key_t &key);
+      static bool sort_keys_pass(const bool forward);
+    #endif
+    #if ENABLED(SD_DIR_INDEX)
+      static uint8_t name_hash(const char *name);
+      static void dir_index_build();
+      static bool dir_index_name(const uint16_t i);
+    #endif
+    #if ENABLED(JSON_OUTPUT)
+      static void scan_start(const char * const path);
+      static void scan_end();
+    #endif
     static bool findGeneratedBy(char* buf, char* genBy);
     static bool findFirstLayerHeight(char* buf, float &firstlayerHeight);
     static bool findLayerHeight(char* buf, float &layerHeight);
@@ -337,7 +535,9 @@ extern SDCard card;
 #define IS_SD_FILE_OPEN() card.isFileOpen()
 #define IS_SD_MOUNTED()   card.isMounted()
 
-#if PIN_EXISTS(SD_DETECT)
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+  #define IS_SD_INSERTED()  card.fat.card()->isReady()
+#elif PIN_EXISTS(SD_DETECT)
   #if ENABLED(SD_DETECT_INVERTED)
     #define IS_SD_INSERTED()  READ(SD_DETECT_PIN)
   #else
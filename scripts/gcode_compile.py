@@ -0,0 +1,74 @@
+#!/usr/bin/python3
+
+# This file is for preprocessing gcode for SD_COMPILED_JOB of MK4duo
+# G0 G1 G2 G3 lines with only X Y Z E F I J R are written as compact records,
+# the floats the firmware parser would read, all the other lines are kept as text.
+# Comments and empty lines are removed.
+# the new file will be created in the same folder.
+# Record: 0xA5, code (0-3), mask (bit 0 X ... bit 7 R), float32 little endian for each bit set
+# see MK4duo/src/commands/binary_gcode.h
+
+import struct
+import sys
+
+# your gcode-file/folder
+folder = './'
+my_file = 'test.gcode'
+
+if len(sys.argv) > 1:
+    folder = ''
+    my_file = sys.argv[1]
+
+# input filename
+input_file = folder + my_file
+# output filename
+output_file = input_file.rsplit('.', 1)[0] + '.gcb'
+
+sync = 0xA5
+fields = 'XYZEFIJR'
+
+lines_text = 0
+lines_compact = 0
+
+
+# return the record for a motion line, None if it has to stay text
+def compile_line(line):
+    words = line.split()
+    if words[0] not in ('G0', 'G1', 'G2', 'G3'):
+        return None
+    code = int(words[0][1])
+    mask = 0
+    values = {}
+    for word in words[1:]:
+        f = fields.find(word[0])
+        if f < 0 or f in values:
+            return None
+        try:
+            values[f] = float(word[1:])
+        except ValueError:
+            return None
+        mask |= 1 << f
+    record = bytes((sync, code, mask))
+    for f in sorted(values):
+        record += struct.pack('<f', values[f])
+    return record
+
+
+with open(input_file, 'r') as f_in, open(output_file, 'wb') as f_out:
+    for line in f_in:
+        line = line.split(';', 1)[0].strip()
+        if not line:
+            continue
+        record = compile_line(line.upper())
+        if record is None:
+            f_out.write((line + '\n').encode('ascii'))
+            lines_text += 1
+        else:
+            f_out.write(record)
+            lines_compact += 1
+    # Text end, so the last command is always followed by a line end
+    f_out.write(b'\n')
+
+print('Text lines:', lines_text)
+print('Compact records:', lines_compact)
+print('Written:', output_file)